@@ -18,6 +18,7 @@
 #define IGNITION_MATH_ANGLE_HH_
 
 #include <iostream>
+#include <type_traits>
 #include <ignition/math/Helpers.hh>
 #include <ignition/math/config.hh>
 
@@ -47,7 +48,9 @@ namespace ignition
     /// \brief An angle and related functions.
     class IGNITION_MATH_VISIBLE Angle
     {
-      /// \brief math::Angle(0)
+      /// \brief math::Angle(0). The constants of Angle are initialized at
+      /// compile time, but cannot be used in constant expressions since
+      /// they are defined in the library.
       public: static const Angle Zero;
 
       /// \brief math::Angle(IGN_PI)
@@ -60,89 +63,150 @@ namespace ignition
       public: static const Angle TwoPi;
 
       /// \brief Constructor
-      public: Angle();
+      public: constexpr Angle()
+      : value(0)
+      {
+      }
 
       /// \brief Conversion Constructor
       /// \param[in] _radian Radians
       // cppcheck-suppress noExplicitConstructor
-      public: Angle(const double _radian);
+      public: constexpr Angle(const double _radian)
+      : value(_radian)
+      {
+      }
 
       /// \brief Copy constructor
       /// \param[in] _angle Angle to copy
+#ifdef IGNITION_MATH_POD_TYPES
+      public: Angle(const Angle &_angle) = default;
+#else
       public: Angle(const Angle &_angle);
+#endif
 
       /// \brief Destructor
+#ifdef IGNITION_MATH_POD_TYPES
+      public: ~Angle() = default;
+#else
       public: virtual ~Angle();
+#endif
 
       /// \brief Set the value from an angle in radians
       /// \param[in] _radian Radian value
-      public: void Radian(double _radian);
+      public: IGN_MATH_POD_CONSTEXPR void Radian(double _radian)
+      {
+        this->value = _radian;
+      }
 
       /// \brief Set the value from an angle in degrees
       /// \param[in] _degree Degree value
-      public: void Degree(double _degree);
+      public: IGN_MATH_POD_CONSTEXPR void Degree(double _degree)
+      {
+        this->value = _degree * IGN_PI / 180.0;
+      }
 
       /// \brief Get the angle in radians
       /// \return double containing the angle's radian value
-      public: double Radian() const;
+      public: constexpr double Radian() const
+      {
+        return this->value;
+      }
 
       /// \brief Get the angle in degrees
       /// \return double containing the angle's degree value
-      public: double Degree() const;
+      public: constexpr double Degree() const
+      {
+        return this->value * 180.0 / IGN_PI;
+      }
 
       /// \brief Normalize the angle in the range -Pi to Pi
       public: void Normalize();
 
       /// \brief Return the angle's radian value
       /// \return double containing the angle's radian value
-      public: double operator()() const;
+      public: constexpr double operator()() const
+      {
+        return this->value;
+      }
 
       /// \brief Dereference operator
       /// \return Double containing the angle's radian value
-      public: inline double operator*() const
-              {
-                return value;
-              }
+      public: constexpr double operator*() const
+      {
+        return this->value;
+      }
 
       /// \brief Substraction, result = this - _angle
       /// \param[in] _angle Angle for substraction
       /// \return the new angle
-      public: Angle operator-(const Angle &_angle) const;
+      public: IGN_MATH_POD_CONSTEXPR Angle operator-(
+                  const Angle &_angle) const
+      {
+        return Angle(this->value - _angle.value);
+      }
 
       /// \brief Addition operator, result = this + _angle
       /// \param[in] _angle Angle for addition
       /// \return the new angle
-      public: Angle operator+(const Angle &_angle) const;
+      public: IGN_MATH_POD_CONSTEXPR Angle operator+(
+                  const Angle &_angle) const
+      {
+        return Angle(this->value + _angle.value);
+      }
 
       /// \brief Multiplication operator, result = this * _angle
       /// \param[in] _angle Angle for multiplication
       /// \return the new angle
-      public: Angle operator*(const Angle &_angle) const;
+      public: IGN_MATH_POD_CONSTEXPR Angle operator*(
+                  const Angle &_angle) const
+      {
+        return Angle(this->value * _angle.value);
+      }
 
       /// \brief Division, result = this / _angle
       /// \param[in] _angle Angle for division
       /// \return the new angle
-      public: Angle operator/(const Angle &_angle) const;
+      public: IGN_MATH_POD_CONSTEXPR Angle operator/(
+                  const Angle &_angle) const
+      {
+        return Angle(this->value / _angle.value);
+      }
 
       /// \brief Subtraction set, this = this - _angle
       /// \param[in] _angle Angle for subtraction
       /// \return angle
-      public: Angle operator-=(const Angle &_angle);
+      public: IGN_MATH_POD_CONSTEXPR Angle operator-=(const Angle &_angle)
+      {
+        this->value -= _angle.value;
+        return *this;
+      }
 
       /// \brief Addition set, this = this + _angle
       /// \param[in] _angle Angle for addition
       /// \return angle
-      public: Angle operator+=(const Angle &_angle);
+      public: IGN_MATH_POD_CONSTEXPR Angle operator+=(const Angle &_angle)
+      {
+        this->value += _angle.value;
+        return *this;
+      }
 
       /// \brief Multiplication set, this = this * _angle
       /// \param[in] _angle Angle for multiplication
       /// \return angle
-      public: Angle operator*=(const Angle &_angle);
+      public: IGN_MATH_POD_CONSTEXPR Angle operator*=(const Angle &_angle)
+      {
+        this->value *= _angle.value;
+        return *this;
+      }
 
       /// \brief Division set, this = this / _angle
       /// \param[in] _angle Angle for division
       /// \return angle
-      public: Angle operator/=(const Angle &_angle);
+      public: IGN_MATH_POD_CONSTEXPR Angle operator/=(const Angle &_angle)
+      {
+        this->value /= _angle.value;
+        return *this;
+      }
 
       /// \brief Equality operator, result = this == _angle
       /// \param[in] _angle Angle to check for equality
@@ -157,7 +221,10 @@ namespace ignition
       /// \brief Less than operator
       /// \param[in] _angle Angle to check
       /// \return true if this < _angle
-      public: bool operator<(const Angle &_angle) const;
+      public: constexpr bool operator<(const Angle &_angle) const
+      {
+        return this->value < _angle.value;
+      }
 
       /// \brief Less or equal operator
       /// \param[in] _angle Angle to check
@@ -167,7 +234,10 @@ namespace ignition
       /// \brief Greater than operator
       /// \param[in] _angle Angle to check
       /// \return true if this > _angle
-      public: bool operator>(const Angle &_angle) const;
+      public: constexpr bool operator>(const Angle &_angle) const
+      {
+        return this->value > _angle.value;
+      }
 
       /// \brief Greater or equal operator
       /// \param[in] _angle Angle to check
@@ -201,6 +271,15 @@ namespace ignition
       /// The angle in radians
       private: double value;
     };
+
+#ifdef IGNITION_MATH_POD_TYPES
+    static_assert(sizeof(Angle) == sizeof(double),
+        "Angle must have the memory layout of a double");
+    static_assert(std::is_standard_layout<Angle>::value,
+        "Angle must be standard-layout");
+    static_assert(std::is_trivially_copyable<Angle>::value,
+        "Angle must be trivially copyable");
+#endif
     }
   }
 }
@@ -25,6 +25,7 @@
 #include <ignition/math/MassMatrix3.hh>
 #include <ignition/math/Material.hh>
 #include <ignition/math/Vector3.hh>
+#include <ignition/math/Vector3View.hh>
 
 namespace ignition
 {
@@ -97,6 +98,18 @@ namespace ignition
       /// \param[in]  _box AxisAlignedBox to add to this box
       public: void Merge(const AxisAlignedBox &_box);
 
+      /// \brief Grow this box to contain a set of points read from an
+      /// external buffer. Merging points into a default constructed box
+      /// gives the bounding box of the points.
+      /// \param[in] _points View of the points to add to this box.
+      public: void Merge(const Vector3View<double> &_points);
+
+      /// \brief Grow this box to contain a set of points read from an
+      /// external buffer of floats.
+      /// \param[in] _points View of the points to add to this box.
+      /// \sa Merge(const Vector3View<double> &)
+      public: void Merge(const Vector3View<float> &_points);
+
       /// \brief Assignment operator. Set this box to the parameter
       /// \param[in]  _b AxisAlignedBox to copy
       /// \return The new box.
@@ -0,0 +1,150 @@
+/*
+ * Copyright (C) 2018 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef IGNITION_MATH_BOXPACKET_HH_
+#define IGNITION_MATH_BOXPACKET_HH_
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include <ignition/math/AxisAlignedBox.hh>
+#include <ignition/math/Export.hh>
+#include <ignition/math/Vector3.hh>
+#include <ignition/math/config.hh>
+
+namespace ignition
+{
+  namespace math
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace IGNITION_MATH_VERSION_NAMESPACE {
+    //
+    // Forward declare private data
+    class BoxPacketPrivate;
+
+    /// \class BoxPacket BoxPacket.hh ignition/math/BoxPacket.hh
+    /// \brief A set of axis aligned boxes tested together against a ray.
+    ///
+    /// The corners of the boxes are stored as a structure of arrays so
+    /// that several boxes are tested at once with the SIMD instructions
+    /// selected by SimdDispatch. The inverse direction of the ray is
+    /// computed once per query. The results are those of
+    /// AxisAlignedBox::IntersectDist(), up to rounding.
+    class IGNITION_MATH_VISIBLE BoxPacket
+    {
+      /// \brief Default constructor. The packet is empty.
+      public: BoxPacket();
+
+      /// \brief Constructor from a set of boxes.
+      /// \param[in] _boxes The boxes.
+      public: explicit BoxPacket(const std::vector<AxisAlignedBox> &_boxes);
+
+      /// \brief Copy constructor.
+      /// \param[in] _packet Packet to copy.
+      public: BoxPacket(const BoxPacket &_packet);
+
+      /// \brief Destructor.
+      public: ~BoxPacket();
+
+      /// \brief Assignment operator.
+      /// \param[in] _packet Packet to copy.
+      /// \return Reference to this packet.
+      public: BoxPacket &operator=(const BoxPacket &_packet);
+
+      /// \brief Get the number of boxes.
+      /// \return Number of boxes.
+      public: std::size_t Size() const;
+
+      /// \brief Check if the packet has no boxes.
+      /// \return True if Size() is zero.
+      public: bool Empty() const;
+
+      /// \brief Remove all the boxes.
+      public: void Clear();
+
+      /// \brief Reserve memory for a number of boxes.
+      /// \param[in] _size Number of boxes.
+      public: void Reserve(const std::size_t _size);
+
+      /// \brief Add a box.
+      /// \param[in] _box The box.
+      public: void PushBack(const AxisAlignedBox &_box);
+
+      /// \brief Replace the boxes.
+      /// \param[in] _boxes The boxes.
+      public: void Assign(const std::vector<AxisAlignedBox> &_boxes);
+
+      /// \brief Get a box.
+      /// \param[in] _index Index of the box, less than Size().
+      /// \return A copy of the box.
+      public: AxisAlignedBox operator[](const std::size_t _index) const;
+
+      /// \brief Get one component of the minimum corners.
+      /// \param[in] _axis 0 for x, 1 for y or 2 for z.
+      /// \return Pointer to Size() values, aligned for SIMD access.
+      public: const double *Min(const int _axis) const;
+
+      /// \brief Get one component of the maximum corners.
+      /// \param[in] _axis 0 for x, 1 for y or 2 for z.
+      /// \return Pointer to Size() values, aligned for SIMD access.
+      public: const double *Max(const int _axis) const;
+
+      /// \brief Intersect a ray with all the boxes.
+      /// \param[in] _origin Origin of the ray.
+      /// \param[in] _dir Direction of the ray. This ray will be normalized.
+      /// Must not be zero.
+      /// \param[in] _min Minimum allowed distance.
+      /// \param[in] _max Maximum allowed distance.
+      /// \param[out] _hits Whether the ray hits each box. Resized to
+      /// Size().
+      /// \param[out] _dists Distance from _origin + _min * _dir to each
+      /// box, as returned by AxisAlignedBox::IntersectDist(). It is zero
+      /// for the boxes that are missed. Resized to Size().
+      /// \return Number of boxes hit by the ray.
+      public: std::size_t Intersect(const Vector3d &_origin,
+                  const Vector3d &_dir, const double _min, const double _max,
+                  std::vector<bool> &_hits, std::vector<double> &_dists) const;
+
+      /// \brief Check which boxes are hit by a ray.
+      /// \param[in] _origin Origin of the ray.
+      /// \param[in] _dir Direction of the ray. This ray will be normalized.
+      /// Must not be zero.
+      /// \param[in] _min Minimum allowed distance.
+      /// \param[in] _max Maximum allowed distance.
+      /// \param[out] _hits Whether the ray hits each box. Resized to
+      /// Size().
+      /// \return Number of boxes hit by the ray.
+      public: std::size_t IntersectCheck(const Vector3d &_origin,
+                  const Vector3d &_dir, const double _min, const double _max,
+                  std::vector<bool> &_hits) const;
+
+#ifdef _WIN32
+// Disable warning C4251 which is triggered by
+// std::unique_ptr
+#pragma warning(push)
+#pragma warning(disable: 4251)
+#endif
+      /// \brief Private data pointer.
+      private: std::unique_ptr<BoxPacketPrivate> dataPtr;
+#ifdef _WIN32
+#pragma warning(pop)
+#endif
+    };
+    }
+  }
+}
+#endif
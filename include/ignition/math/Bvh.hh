@@ -0,0 +1,153 @@
+/*
+ * Copyright (C) 2018 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef IGNITION_MATH_BVH_HH_
+#define IGNITION_MATH_BVH_HH_
+
+#include <cstddef>
+#include <memory>
+#include <tuple>
+#include <vector>
+
+#include <ignition/math/AxisAlignedBox.hh>
+#include <ignition/math/Export.hh>
+#include <ignition/math/Vector3.hh>
+#include <ignition/math/config.hh>
+
+namespace ignition
+{
+  namespace math
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace IGNITION_MATH_VERSION_NAMESPACE {
+    //
+    // Forward declare private data
+    class BvhPrivate;
+
+    /// \class Bvh Bvh.hh ignition/math/Bvh.hh
+    /// \brief A bounding volume hierarchy over a set of axis aligned
+    /// boxes, used to find the boxes hit by a ray or overlapping a box
+    /// without testing every box.
+    ///
+    /// The hierarchy is built with the surface area heuristic evaluated
+    /// on bins, and stored as a flat array of nodes in depth-first order.
+    /// Queries return the index of the boxes in the vector given to
+    /// Build(). The rays are described as in
+    /// AxisAlignedBox::Intersect(const Vector3d &, const Vector3d &,
+    /// const double, const double) const, and return the same distances.
+    class IGNITION_MATH_VISIBLE Bvh
+    {
+      /// \brief Default constructor. The hierarchy is empty.
+      public: Bvh();
+
+      /// \brief Constructor that builds the hierarchy of a set of boxes.
+      /// \param[in] _boxes The boxes.
+      public: explicit Bvh(const std::vector<AxisAlignedBox> &_boxes);
+
+      /// \brief Copy constructor.
+      /// \param[in] _bvh Hierarchy to copy.
+      public: Bvh(const Bvh &_bvh);
+
+      /// \brief Destructor.
+      public: ~Bvh();
+
+      /// \brief Assignment operator.
+      /// \param[in] _bvh Hierarchy to copy.
+      /// \return Reference to this hierarchy.
+      public: Bvh &operator=(const Bvh &_bvh);
+
+      /// \brief Build the hierarchy of a set of boxes, replacing the
+      /// previous content. Empty boxes, such as default constructed ones,
+      /// are never returned by the queries.
+      /// \param[in] _boxes The boxes.
+      public: void Build(const std::vector<AxisAlignedBox> &_boxes);
+
+      /// \brief Get the number of boxes given to Build().
+      /// \return Number of boxes.
+      public: std::size_t Size() const;
+
+      /// \brief Get the number of nodes of the hierarchy.
+      /// \return Number of nodes, 0 if the hierarchy is empty.
+      public: std::size_t NodeCount() const;
+
+      /// \brief Get the box that contains all the boxes.
+      /// \return The bounding box, a default constructed box if the
+      /// hierarchy is empty.
+      public: AxisAlignedBox Bounds() const;
+
+      /// \brief Find the box closest to the origin of a ray.
+      /// \param[in] _origin Origin of the ray.
+      /// \param[in] _dir Direction of the ray. This ray will be normalized.
+      /// \param[in] _min Minimum allowed distance.
+      /// \param[in] _max Maximum allowed distance.
+      /// \return A boolean, double, std::size_t tuple. The boolean value is
+      /// true if the ray hits a box. The double is the distance from
+      /// _origin + _min * _dir to the closest hit, as returned by
+      /// AxisAlignedBox::IntersectDist(). The std::size_t is the index of
+      /// the closest box. The double and std::size_t values are zero when
+      /// the boolean value is false.
+      public: std::tuple<bool, double, std::size_t> Intersect(
+                  const Vector3d &_origin, const Vector3d &_dir,
+                  const double _min, const double _max) const;
+
+      /// \brief Check if a ray hits any box. This is faster than
+      /// Intersect() since the search stops at the first hit.
+      /// \param[in] _origin Origin of the ray.
+      /// \param[in] _dir Direction of the ray. This ray will be normalized.
+      /// \param[in] _min Minimum allowed distance.
+      /// \param[in] _max Maximum allowed distance.
+      /// \return True if the ray hits at least one box.
+      public: bool IntersectCheck(const Vector3d &_origin,
+                  const Vector3d &_dir, const double _min,
+                  const double _max) const;
+
+      /// \brief Find all the boxes hit by a ray.
+      /// \param[in] _origin Origin of the ray.
+      /// \param[in] _dir Direction of the ray. This ray will be normalized.
+      /// \param[in] _min Minimum allowed distance.
+      /// \param[in] _max Maximum allowed distance.
+      /// \param[out] _indices Indices of the boxes hit by the ray, in no
+      /// particular order. The vector is cleared first.
+      /// \return True if the ray hits at least one box.
+      public: bool IntersectAll(const Vector3d &_origin,
+                  const Vector3d &_dir, const double _min, const double _max,
+                  std::vector<std::size_t> &_indices) const;
+
+      /// \brief Find all the boxes that intersect a box, as defined by
+      /// AxisAlignedBox::Intersects().
+      /// \param[in] _box The box to test.
+      /// \param[out] _indices Indices of the boxes that intersect _box, in
+      /// no particular order. The vector is cleared first.
+      /// \return True if at least one box intersects _box.
+      public: bool Overlap(const AxisAlignedBox &_box,
+                  std::vector<std::size_t> &_indices) const;
+
+#ifdef _WIN32
+// Disable warning C4251 which is triggered by
+// std::unique_ptr
+#pragma warning(push)
+#pragma warning(disable: 4251)
+#endif
+      /// \brief Private data pointer.
+      private: std::unique_ptr<BvhPrivate> dataPtr;
+#ifdef _WIN32
+#pragma warning(pop)
+#endif
+    };
+    }
+  }
+}
+#endif
@@ -0,0 +1,157 @@
+/*
+ * Copyright (C) 2018 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef IGNITION_MATH_CONVEXHULL_HH_
+#define IGNITION_MATH_CONVEXHULL_HH_
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include <ignition/math/Export.hh>
+#include <ignition/math/Vector3.hh>
+#include <ignition/math/Vector3View.hh>
+#include <ignition/math/config.hh>
+
+namespace ignition
+{
+  namespace math
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace IGNITION_MATH_VERSION_NAMESPACE {
+    //
+    // Forward declare private data
+    class ConvexHullPrivate;
+
+    /// \class ConvexHull ConvexHull.hh ignition/math/ConvexHull.hh
+    /// \brief The convex hull of a set of 3D points, as indexed triangles,
+    /// computed with the Quickhull algorithm. It can be used to build the
+    /// convex collision shape of a mesh.
+    ///
+    /// The triangles are stored in a pool of faces linked by their half
+    /// edges, which is kept between two builds, so that building the hulls
+    /// of many meshes with the same object does not allocate memory for
+    /// each face. BuildMany() builds independent hulls in several threads.
+    ///
+    /// Points closer to the hull than a tolerance proportional to the
+    /// extent of the set are considered inside it, so that points on the
+    /// faces of a box, for example, do not become vertices. Points with a
+    /// NaN or infinite coordinate are ignored.
+    class IGNITION_MATH_VISIBLE ConvexHull
+    {
+      /// \brief Default constructor. The hull is empty.
+      public: ConvexHull();
+
+      /// \brief Copy constructor.
+      /// \param[in] _hull Hull to copy.
+      public: ConvexHull(const ConvexHull &_hull);
+
+      /// \brief Destructor.
+      public: ~ConvexHull();
+
+      /// \brief Assignment operator.
+      /// \param[in] _hull Hull to copy.
+      /// \return Reference to this hull.
+      public: ConvexHull &operator=(const ConvexHull &_hull);
+
+      /// \brief Build the hull of a set of points, replacing the previous
+      /// content.
+      /// \param[in] _points The points, at most 2^32 - 1 of them.
+      /// \param[in] _maxVertices Largest number of vertices of the hull, 0
+      /// for no limit. With a limit, the point furthest from the current
+      /// hull is added first, which gives a simplified hull contained in
+      /// the exact one. Values from 1 to 4 give a tetrahedron.
+      /// \return False if the points do not span a volume, such as when
+      /// there are fewer than four of them or they all lie in a plane, in
+      /// which case the hull is empty.
+      public: bool Build(const std::vector<Vector3d> &_points,
+                  const std::size_t _maxVertices = 0);
+
+      /// \brief Build the hull of a set of points stored in an external
+      /// buffer, replacing the previous content.
+      /// \param[in] _points View of the points, at most 2^32 - 1 of them.
+      /// \param[in] _maxVertices Largest number of vertices of the hull, 0
+      /// for no limit.
+      /// \return False if the points do not span a volume, in which case
+      /// the hull is empty.
+      /// \sa Build(const std::vector<Vector3d> &, const std::size_t)
+      public: bool Build(const Vector3View<double> &_points,
+                  const std::size_t _maxVertices = 0);
+
+      /// \brief Build the hulls of several sets of points at once. Each
+      /// thread reuses the same pools for all the sets it builds.
+      /// \param[in] _pointSets The sets of points.
+      /// \param[out] _hulls Hull of each set, resized to the number of
+      /// sets.
+      /// \param[in] _maxVertices Largest number of vertices of each hull, 0
+      /// for no limit.
+      /// \param[in] _threadCount Number of threads, 0 for the number of
+      /// hardware threads.
+      /// \return Number of sets whose hull is not empty.
+      /// \sa Build(const std::vector<Vector3d> &, const std::size_t)
+      public: static std::size_t BuildMany(
+                  const std::vector<std::vector<Vector3d>> &_pointSets,
+                  std::vector<ConvexHull> &_hulls,
+                  const std::size_t _maxVertices = 0,
+                  const unsigned int _threadCount = 0);
+
+      /// \brief Build the hulls of several sets of points stored in
+      /// external buffers at once.
+      /// \param[in] _pointSets Views of the sets of points.
+      /// \param[out] _hulls Hull of each set, resized to the number of
+      /// sets.
+      /// \param[in] _maxVertices Largest number of vertices of each hull, 0
+      /// for no limit.
+      /// \param[in] _threadCount Number of threads, 0 for the number of
+      /// hardware threads.
+      /// \return Number of sets whose hull is not empty.
+      public: static std::size_t BuildMany(
+                  const std::vector<Vector3View<double>> &_pointSets,
+                  std::vector<ConvexHull> &_hulls,
+                  const std::size_t _maxVertices = 0,
+                  const unsigned int _threadCount = 0);
+
+      /// \brief Get the number of triangles.
+      /// \return Number of triangles, 0 if the hull is empty.
+      public: std::size_t TriangleCount() const;
+
+      /// \brief Get the triangles.
+      /// \return Indices in the points given to Build() of the corners of
+      /// the triangles, three per triangle. The corners are in
+      /// counter-clockwise order seen from outside the hull.
+      public: const std::vector<unsigned int> &Indices() const;
+
+      /// \brief Get the vertices.
+      /// \return Indices in the points given to Build() of the vertices of
+      /// the hull, sorted.
+      public: const std::vector<unsigned int> &Vertices() const;
+
+#ifdef _WIN32
+// Disable warning C4251 which is triggered by
+// std::unique_ptr
+#pragma warning(push)
+#pragma warning(disable: 4251)
+#endif
+      /// \brief Private data pointer.
+      private: std::unique_ptr<ConvexHullPrivate> dataPtr;
+#ifdef _WIN32
+#pragma warning(pop)
+#endif
+    };
+    }
+  }
+}
+#endif
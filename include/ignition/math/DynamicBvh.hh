@@ -0,0 +1,214 @@
+/*
+ * Copyright (C) 2018 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef IGNITION_MATH_DYNAMICBVH_HH_
+#define IGNITION_MATH_DYNAMICBVH_HH_
+
+#include <cstddef>
+#include <memory>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <ignition/math/AxisAlignedBox.hh>
+#include <ignition/math/Export.hh>
+#include <ignition/math/Vector3.hh>
+#include <ignition/math/config.hh>
+
+namespace ignition
+{
+  namespace math
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace IGNITION_MATH_VERSION_NAMESPACE {
+    //
+    // Forward declare private data
+    class DynamicBvhPrivate;
+
+    /// \class DynamicBvh DynamicBvh.hh ignition/math/DynamicBvh.hh
+    /// \brief A bounding volume hierarchy over a set of axis aligned
+    /// boxes that move, used as the broadphase of a simulation to find the
+    /// pairs of boxes that overlap.
+    ///
+    /// Each box is stored in a leaf with a fat box, enlarged by a margin
+    /// and by the displacement given to Update(). A box that moves inside
+    /// its fat box does not change the tree. Otherwise its leaf is removed
+    /// and inserted again at the place of lowest surface area cost, the
+    /// bounds of the nodes above the old and new places are refit, and
+    /// the tree is kept balanced by rotations on the way up.
+    ///
+    /// The tree keeps the pairs of boxes whose fat boxes overlap, and
+    /// UpdatePairs() reports the pairs that appeared or disappeared since
+    /// its previous call, testing only the boxes whose fat box changed.
+    ///
+    /// Boxes are identified by the id returned by Insert(), which may be
+    /// reused after Remove(). The ray and box queries use the boxes given
+    /// to Insert() and Update(), not the fat boxes, and return the same
+    /// results as Bvh.
+    class IGNITION_MATH_VISIBLE DynamicBvh
+    {
+      /// \brief Constructor.
+      /// \param[in] _margin Distance by which the fat boxes are larger
+      /// than the boxes along each axis. Negative values are replaced by
+      /// zero.
+      public: explicit DynamicBvh(const double _margin = 0.1);
+
+      /// \brief Copy constructor.
+      /// \param[in] _bvh Hierarchy to copy.
+      public: DynamicBvh(const DynamicBvh &_bvh);
+
+      /// \brief Destructor.
+      public: ~DynamicBvh();
+
+      /// \brief Assignment operator.
+      /// \param[in] _bvh Hierarchy to copy.
+      /// \return Reference to this hierarchy.
+      public: DynamicBvh &operator=(const DynamicBvh &_bvh);
+
+      /// \brief Get the margin of the fat boxes.
+      /// \return The margin.
+      public: double Margin() const;
+
+      /// \brief Add a box. Empty boxes, such as default constructed ones,
+      /// are stored but never returned by the queries nor paired.
+      /// \param[in] _box The box.
+      /// \return Id of the box.
+      public: std::size_t Insert(const AxisAlignedBox &_box);
+
+      /// \brief Remove a box. The pairs of the box are reported as removed
+      /// by the next call to UpdatePairs().
+      /// \param[in] _id Id of the box.
+      /// \return False if _id is not the id of a box of the hierarchy.
+      public: bool Remove(const std::size_t _id);
+
+      /// \brief Move or resize a box.
+      /// \param[in] _id Id of the box.
+      /// \param[in] _box New value of the box.
+      /// \param[in] _displacement Expected displacement of the box until
+      /// its next update. The fat box is extended in this direction so
+      /// that boxes moving steadily change the tree less often.
+      /// \return False if _id is not the id of a box of the hierarchy.
+      public: bool Update(const std::size_t _id, const AxisAlignedBox &_box,
+                  const Vector3d &_displacement = Vector3d::Zero);
+
+      /// \brief Find the pairs of boxes whose fat boxes started or stopped
+      /// overlapping since the previous call. Only the boxes inserted or
+      /// whose fat box changed are tested.
+      /// \param[out] _added Pairs of ids of the boxes that started
+      /// overlapping, the smallest id first, sorted. The vector is cleared
+      /// first.
+      /// \param[out] _removed Pairs of ids of the boxes that stopped
+      /// overlapping or were removed, the smallest id first, sorted. The
+      /// vector is cleared first.
+      /// \return True if at least one pair was added or removed.
+      public: bool UpdatePairs(
+                  std::vector<std::pair<std::size_t, std::size_t>> &_added,
+                  std::vector<std::pair<std::size_t, std::size_t>> &_removed);
+
+      /// \brief Get the pairs of boxes whose fat boxes overlap, as of the
+      /// last call to UpdatePairs().
+      /// \param[out] _pairs Pairs of ids, the smallest id first, sorted.
+      /// The vector is cleared first.
+      public: void Pairs(
+                  std::vector<std::pair<std::size_t, std::size_t>> &_pairs)
+                  const;
+
+      /// \brief Remove all the boxes and pairs, without reporting them.
+      public: void Clear();
+
+      /// \brief Get the number of boxes.
+      /// \return Number of boxes.
+      public: std::size_t Size() const;
+
+      /// \brief Get the number of nodes of the hierarchy.
+      /// \return Number of nodes, 0 if the hierarchy is empty.
+      public: std::size_t NodeCount() const;
+
+      /// \brief Get the height of the hierarchy.
+      /// \return Number of levels below the root, 0 if there is at most
+      /// one box.
+      public: int Height() const;
+
+      /// \brief Check if an id is the id of a box of the hierarchy.
+      /// \param[in] _id Id to check.
+      /// \return True if the hierarchy has a box with this id.
+      public: bool Has(const std::size_t _id) const;
+
+      /// \brief Get a box.
+      /// \param[in] _id Id of the box.
+      /// \return The box, a default constructed box if _id is not the id
+      /// of a box of the hierarchy.
+      public: AxisAlignedBox Box(const std::size_t _id) const;
+
+      /// \brief Get the fat box of a box.
+      /// \param[in] _id Id of the box.
+      /// \return The fat box, a default constructed box if _id is not the
+      /// id of a box of the hierarchy.
+      public: AxisAlignedBox FatBox(const std::size_t _id) const;
+
+      /// \brief Find the box closest to the origin of a ray.
+      /// \param[in] _origin Origin of the ray.
+      /// \param[in] _dir Direction of the ray. This ray will be normalized.
+      /// \param[in] _min Minimum allowed distance.
+      /// \param[in] _max Maximum allowed distance.
+      /// \return A boolean, double, std::size_t tuple. The boolean value is
+      /// true if the ray hits a box. The double is the distance from
+      /// _origin + _min * _dir to the closest hit, as returned by
+      /// AxisAlignedBox::IntersectDist(). The std::size_t is the id of
+      /// the closest box, the smallest one if several boxes are hit at
+      /// this distance. The double and std::size_t values are zero when
+      /// the boolean value is false.
+      public: std::tuple<bool, double, std::size_t> Intersect(
+                  const Vector3d &_origin, const Vector3d &_dir,
+                  const double _min, const double _max) const;
+
+      /// \brief Find all the boxes hit by a ray.
+      /// \param[in] _origin Origin of the ray.
+      /// \param[in] _dir Direction of the ray. This ray will be normalized.
+      /// \param[in] _min Minimum allowed distance.
+      /// \param[in] _max Maximum allowed distance.
+      /// \param[out] _ids Ids of the boxes hit by the ray, in no
+      /// particular order. The vector is cleared first.
+      /// \return True if the ray hits at least one box.
+      public: bool IntersectAll(const Vector3d &_origin,
+                  const Vector3d &_dir, const double _min, const double _max,
+                  std::vector<std::size_t> &_ids) const;
+
+      /// \brief Find all the boxes that intersect a box, as defined by
+      /// AxisAlignedBox::Intersects().
+      /// \param[in] _box The box to test.
+      /// \param[out] _ids Ids of the boxes that intersect _box, in no
+      /// particular order. The vector is cleared first.
+      /// \return True if at least one box intersects _box.
+      public: bool Overlap(const AxisAlignedBox &_box,
+                  std::vector<std::size_t> &_ids) const;
+
+#ifdef _WIN32
+// Disable warning C4251 which is triggered by
+// std::unique_ptr
+#pragma warning(push)
+#pragma warning(disable: 4251)
+#endif
+      /// \brief Private data pointer.
+      private: std::unique_ptr<DynamicBvhPrivate> dataPtr;
+#ifdef _WIN32
+#pragma warning(pop)
+#endif
+    };
+    }
+  }
+}
+#endif
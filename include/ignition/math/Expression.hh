@@ -0,0 +1,788 @@
+/*
+ * Copyright (C) 2018 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef IGNITION_MATH_EXPRESSION_HH_
+#define IGNITION_MATH_EXPRESSION_HH_
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+#include <ignition/math/Matrix3.hh>
+#include <ignition/math/Matrix4.hh>
+#include <ignition/math/Vector3.hh>
+#include <ignition/math/Vector4.hh>
+#include <ignition/math/config.hh>
+
+namespace ignition
+{
+  namespace math
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace IGNITION_MATH_VERSION_NAMESPACE {
+    /// \brief Expression templates for Vector3, Vector4, Matrix3 and
+    /// Matrix4.
+    ///
+    /// The operators of the math types return a new object for each
+    /// operation, so that `a + b * s - c.Cross(d)` creates three
+    /// temporaries. The functions of this namespace instead build a
+    /// lightweight expression object that is evaluated in a single pass
+    /// by Eval, without intermediate vectors or matrices:
+    ///
+    /// \code
+    /// using namespace ignition::math;
+    /// Vector3d v = expr::Eval(expr::Ref(a) + b * s -
+    ///     expr::Cross(c, d));
+    /// \endcode
+    ///
+    /// An operator applies as soon as one of its operands is an
+    /// expression, plain Vector3, Vector4, Matrix3 and Matrix4 operands are
+    /// wrapped automatically. In the example above `b * s` is a plain
+    /// product since neither operand is an expression.
+    ///
+    /// Each element is computed with the same order of operations as the
+    /// operators of the math types. The compiler may still contract the
+    /// multiplications and additions of a product into fused multiply-adds
+    /// in one form and not in the other, so with non-integer values the
+    /// results can differ by rounding.
+    ///
+    /// Expressions keep references to the objects they use, they must be
+    /// evaluated before these objects go out of scope, usually in the same
+    /// statement. Cross and matrix products read each element of their
+    /// operands several times, when an operand is itself a large
+    /// expression it can be faster to Eval it first.
+    namespace expr
+    {
+      /// \brief Shape and element access of the types that can be used as
+      /// leaves of an expression. The generic version is for types that
+      /// can't.
+      template<typename V>
+      struct Traits
+      {
+        /// \brief True if V can be used in an expression
+        static const bool IsTerminal = false;
+      };
+
+      /// \brief Traits of Vector3, a 3x1 column vector
+      template<typename T>
+      struct Traits<Vector3<T>>
+      {
+        /// \brief True if V can be used in an expression
+        static const bool IsTerminal = true;
+
+        /// \brief Element type
+        typedef T Scalar;
+
+        /// \brief Number of rows
+        static const std::size_t Rows = 3;
+
+        /// \brief Number of columns
+        static const std::size_t Cols = 1;
+
+        /// \brief Get an element.
+        /// \tparam I Row-major index of the element.
+        /// \param[in] _v Vector to read.
+        /// \return The element.
+        template<std::size_t I>
+        static T Get(const Vector3<T> &_v)
+        {
+          return _v[I];
+        }
+      };
+
+      /// \brief Traits of Vector4, a 4x1 column vector
+      template<typename T>
+      struct Traits<Vector4<T>>
+      {
+        /// \brief True if V can be used in an expression
+        static const bool IsTerminal = true;
+
+        /// \brief Element type
+        typedef T Scalar;
+
+        /// \brief Number of rows
+        static const std::size_t Rows = 4;
+
+        /// \brief Number of columns
+        static const std::size_t Cols = 1;
+
+        /// \brief Get an element.
+        /// \tparam I Row-major index of the element.
+        /// \param[in] _v Vector to read.
+        /// \return The element.
+        template<std::size_t I>
+        static T Get(const Vector4<T> &_v)
+        {
+          return _v[I];
+        }
+      };
+
+      /// \brief Traits of Matrix3
+      template<typename T>
+      struct Traits<Matrix3<T>>
+      {
+        /// \brief True if V can be used in an expression
+        static const bool IsTerminal = true;
+
+        /// \brief Element type
+        typedef T Scalar;
+
+        /// \brief Number of rows
+        static const std::size_t Rows = 3;
+
+        /// \brief Number of columns
+        static const std::size_t Cols = 3;
+
+        /// \brief Get an element.
+        /// \tparam I Row-major index of the element.
+        /// \param[in] _m Matrix to read.
+        /// \return The element.
+        template<std::size_t I>
+        static T Get(const Matrix3<T> &_m)
+        {
+          return _m(I / 3, I % 3);
+        }
+      };
+
+      /// \brief Traits of Matrix4
+      template<typename T>
+      struct Traits<Matrix4<T>>
+      {
+        /// \brief True if V can be used in an expression
+        static const bool IsTerminal = true;
+
+        /// \brief Element type
+        typedef T Scalar;
+
+        /// \brief Number of rows
+        static const std::size_t Rows = 4;
+
+        /// \brief Number of columns
+        static const std::size_t Cols = 4;
+
+        /// \brief Get an element.
+        /// \tparam I Row-major index of the element.
+        /// \param[in] _m Matrix to read.
+        /// \return The element.
+        template<std::size_t I>
+        static T Get(const Matrix4<T> &_m)
+        {
+          return _m(I / 4, I % 4);
+        }
+      };
+
+      /// \brief Math type produced by the evaluation of an expression with
+      /// the given element type and shape.
+      template<typename T, std::size_t R, std::size_t C>
+      struct Result;
+
+      /// \brief An expression with 3 rows evaluates to a Vector3
+      template<typename T>
+      struct Result<T, 3, 1>
+      {
+        /// \brief Result type
+        typedef Vector3<T> Type;
+      };
+
+      /// \brief An expression with 4 rows evaluates to a Vector4
+      template<typename T>
+      struct Result<T, 4, 1>
+      {
+        /// \brief Result type
+        typedef Vector4<T> Type;
+      };
+
+      /// \brief A 3x3 expression evaluates to a Matrix3
+      template<typename T>
+      struct Result<T, 3, 3>
+      {
+        /// \brief Result type
+        typedef Matrix3<T> Type;
+      };
+
+      /// \brief A 4x4 expression evaluates to a Matrix4
+      template<typename T>
+      struct Result<T, 4, 4>
+      {
+        /// \brief Result type
+        typedef Matrix4<T> Type;
+      };
+
+      /// \brief Base class of all expressions.
+      ///
+      /// An expression E provides a Scalar typedef, Rows and Cols
+      /// constants and a `template<std::size_t I> Scalar Coeff() const`
+      /// function that computes the element of row-major index I.
+      /// \tparam E The derived expression type.
+      template<typename E>
+      class Expression
+      {
+        /// \brief Get the derived expression.
+        /// \return This expression as its derived type.
+        public: const E &Derived() const
+        {
+          return static_cast<const E &>(*this);
+        }
+      };
+
+      /// \brief True if A is an expression
+      template<typename A>
+      struct IsExpression : std::is_base_of<Expression<A>, A>
+      {
+      };
+
+      /// \brief Leaf of an expression, a reference to a vector or matrix.
+      /// \tparam V Vector3, Vector4, Matrix3 or Matrix4.
+      template<typename V>
+      class Terminal : public Expression<Terminal<V>>
+      {
+        /// \brief Element type
+        public: typedef typename Traits<V>::Scalar Scalar;
+
+        /// \brief Number of rows
+        public: static const std::size_t Rows = Traits<V>::Rows;
+
+        /// \brief Number of columns
+        public: static const std::size_t Cols = Traits<V>::Cols;
+
+        /// \brief Constructor.
+        /// \param[in] _value Vector or matrix, it must outlive this
+        /// object.
+        public: explicit Terminal(const V &_value)
+          : value(_value)
+        {
+        }
+
+        /// \brief Get an element.
+        /// \tparam I Row-major index of the element.
+        /// \return The element.
+        public: template<std::size_t I>
+        Scalar Coeff() const
+        {
+          return Traits<V>::template Get<I>(this->value);
+        }
+
+        /// \brief Referenced vector or matrix
+        private: const V &value;
+      };
+
+      /// \brief Conversion of an operator argument to an expression.
+      /// Expressions are used as they are, the math types are wrapped in a
+      /// Terminal.
+      template<typename A, bool = IsExpression<A>::value>
+      struct Operand
+      {
+        /// \brief Expression type
+        typedef A Type;
+
+        /// \brief Get the expression of an argument.
+        /// \param[in] _a Operator argument.
+        /// \return The expression.
+        static const A &Make(const A &_a)
+        {
+          return _a;
+        }
+      };
+
+      /// \brief Conversion of a vector or matrix argument to a Terminal.
+      template<typename A>
+      struct Operand<A, false>
+      {
+        /// \brief Expression type
+        typedef Terminal<A> Type;
+
+        /// \brief Get the expression of an argument.
+        /// \param[in] _a Operator argument.
+        /// \return The expression.
+        static Type Make(const A &_a)
+        {
+          return Type(_a);
+        }
+      };
+
+      /// \brief Defined as R if one of L and R is an expression and the
+      /// other one is an expression or a vector or matrix. Used to enable
+      /// the binary operators of this namespace only for expressions, so
+      /// that the operators of the math types are not affected.
+      template<typename L, typename R, typename Ret>
+      using EnableBinary = typename std::enable_if<
+        (IsExpression<L>::value || IsExpression<R>::value) &&
+        (IsExpression<L>::value || Traits<L>::IsTerminal) &&
+        (IsExpression<R>::value || Traits<R>::IsTerminal), Ret>::type;
+
+      /// \brief Defined as Ret if A is an expression or a vector or
+      /// matrix.
+      template<typename A, typename Ret>
+      using EnableUnary = typename std::enable_if<
+        IsExpression<A>::value || Traits<A>::IsTerminal, Ret>::type;
+
+      /// \brief Element-wise sum or difference of two expressions.
+      /// \tparam L Left operand.
+      /// \tparam R Right operand.
+      /// \tparam Subtract True for L - R, false for L + R.
+      template<typename L, typename R, bool Subtract>
+      class Sum : public Expression<Sum<L, R, Subtract>>
+      {
+        static_assert(L::Rows == R::Rows && L::Cols == R::Cols,
+            "Operands of + and - must have the same shape");
+        static_assert(std::is_same<typename L::Scalar,
+            typename R::Scalar>::value,
+            "Operands of + and - must have the same element type");
+
+        /// \brief Element type
+        public: typedef typename L::Scalar Scalar;
+
+        /// \brief Number of rows
+        public: static const std::size_t Rows = L::Rows;
+
+        /// \brief Number of columns
+        public: static const std::size_t Cols = L::Cols;
+
+        /// \brief Constructor.
+        /// \param[in] _l Left operand.
+        /// \param[in] _r Right operand.
+        public: Sum(const L &_l, const R &_r)
+          : l(_l), r(_r)
+        {
+        }
+
+        /// \brief Get an element.
+        /// \tparam I Row-major index of the element.
+        /// \return The element.
+        public: template<std::size_t I>
+        Scalar Coeff() const
+        {
+          return Subtract ?
+            this->l.template Coeff<I>() - this->r.template Coeff<I>() :
+            this->l.template Coeff<I>() + this->r.template Coeff<I>();
+        }
+
+        /// \brief Left operand
+        private: L l;
+
+        /// \brief Right operand
+        private: R r;
+      };
+
+      /// \brief Product or quotient of an expression and a scalar.
+      /// \tparam E Expression.
+      /// \tparam Divide True for E / s, false for E * s.
+      template<typename E, bool Divide>
+      class Scale : public Expression<Scale<E, Divide>>
+      {
+        /// \brief Element type
+        public: typedef typename E::Scalar Scalar;
+
+        /// \brief Number of rows
+        public: static const std::size_t Rows = E::Rows;
+
+        /// \brief Number of columns
+        public: static const std::size_t Cols = E::Cols;
+
+        /// \brief Constructor.
+        /// \param[in] _e Expression to scale.
+        /// \param[in] _s Scale factor or divisor.
+        public: Scale(const E &_e, const Scalar _s)
+          : e(_e), s(_s)
+        {
+        }
+
+        /// \brief Get an element.
+        /// \tparam I Row-major index of the element.
+        /// \return The element.
+        public: template<std::size_t I>
+        Scalar Coeff() const
+        {
+          return Divide ? this->e.template Coeff<I>() / this->s :
+                          this->e.template Coeff<I>() * this->s;
+        }
+
+        /// \brief Scaled expression
+        private: E e;
+
+        /// \brief Scale factor or divisor
+        private: Scalar s;
+      };
+
+      /// \brief Negation of an expression.
+      /// \tparam E Expression.
+      template<typename E>
+      class Negate : public Expression<Negate<E>>
+      {
+        /// \brief Element type
+        public: typedef typename E::Scalar Scalar;
+
+        /// \brief Number of rows
+        public: static const std::size_t Rows = E::Rows;
+
+        /// \brief Number of columns
+        public: static const std::size_t Cols = E::Cols;
+
+        /// \brief Constructor.
+        /// \param[in] _e Expression to negate.
+        public: explicit Negate(const E &_e)
+          : e(_e)
+        {
+        }
+
+        /// \brief Get an element.
+        /// \tparam I Row-major index of the element.
+        /// \return The element.
+        public: template<std::size_t I>
+        Scalar Coeff() const
+        {
+          return -this->e.template Coeff<I>();
+        }
+
+        /// \brief Negated expression
+        private: E e;
+      };
+
+      /// \brief Cross product of two 3D vector expressions, with the same
+      /// operation order as Vector3::Cross.
+      /// \tparam L Left operand.
+      /// \tparam R Right operand.
+      template<typename L, typename R>
+      class CrossProduct : public Expression<CrossProduct<L, R>>
+      {
+        static_assert(L::Rows == 3 && L::Cols == 1 &&
+            R::Rows == 3 && R::Cols == 1,
+            "Operands of Cross must be 3D vectors");
+        static_assert(std::is_same<typename L::Scalar,
+            typename R::Scalar>::value,
+            "Operands of Cross must have the same element type");
+
+        /// \brief Element type
+        public: typedef typename L::Scalar Scalar;
+
+        /// \brief Number of rows
+        public: static const std::size_t Rows = 3;
+
+        /// \brief Number of columns
+        public: static const std::size_t Cols = 1;
+
+        /// \brief Constructor.
+        /// \param[in] _l Left operand.
+        /// \param[in] _r Right operand.
+        public: CrossProduct(const L &_l, const R &_r)
+          : l(_l), r(_r)
+        {
+        }
+
+        /// \brief Get an element.
+        /// \tparam I Index of the element.
+        /// \return The element.
+        public: template<std::size_t I>
+        Scalar Coeff() const
+        {
+          return
+            this->l.template Coeff<(I + 1) % 3>() *
+            this->r.template Coeff<(I + 2) % 3>() -
+            this->l.template Coeff<(I + 2) % 3>() *
+            this->r.template Coeff<(I + 1) % 3>();
+        }
+
+        /// \brief Left operand
+        private: L l;
+
+        /// \brief Right operand
+        private: R r;
+      };
+
+      /// \brief Sum of the products of a row of L and a column of R,
+      /// accumulated from left to right like the operators of the math
+      /// types.
+      /// \tparam K Index of the next term.
+      /// \tparam N Number of terms.
+      template<std::size_t K, std::size_t N>
+      struct RowColumnSum
+      {
+        /// \brief Add the remaining terms to a partial sum.
+        /// \tparam Row Row of L.
+        /// \tparam Col Column of R.
+        /// \param[in] _l Left operand.
+        /// \param[in] _r Right operand.
+        /// \param[in] _sum Sum of the first K terms.
+        /// \return The full sum.
+        template<std::size_t Row, std::size_t Col, typename L, typename R>
+        static typename L::Scalar Run(const L &_l, const R &_r,
+            const typename L::Scalar _sum)
+        {
+          return RowColumnSum<K + 1, N>::template Run<Row, Col>(_l, _r,
+              _sum + _l.template Coeff<Row * N + K>() *
+                     _r.template Coeff<K * R::Cols + Col>());
+        }
+      };
+
+      /// \brief End of the recursion of RowColumnSum.
+      template<std::size_t N>
+      struct RowColumnSum<N, N>
+      {
+        /// \brief Return the sum.
+        /// \param[in] _sum Sum of all the terms.
+        /// \return _sum
+        template<std::size_t Row, std::size_t Col, typename L, typename R>
+        static typename L::Scalar Run(const L &, const R &,
+            const typename L::Scalar _sum)
+        {
+          return _sum;
+        }
+      };
+
+      /// \brief Sum of the element-wise products of two expressions of the
+      /// same shape, accumulated from left to right.
+      /// \tparam K Index of the next term.
+      /// \tparam N Number of terms.
+      template<std::size_t K, std::size_t N>
+      struct ElementSum
+      {
+        /// \brief Add the remaining terms to a partial sum.
+        /// \param[in] _l Left operand.
+        /// \param[in] _r Right operand.
+        /// \param[in] _sum Sum of the first K terms.
+        /// \return The full sum.
+        template<typename L, typename R>
+        static typename L::Scalar Run(const L &_l, const R &_r,
+            const typename L::Scalar _sum)
+        {
+          return ElementSum<K + 1, N>::Run(_l, _r,
+              _sum + _l.template Coeff<K>() * _r.template Coeff<K>());
+        }
+      };
+
+      /// \brief End of the recursion of ElementSum.
+      template<std::size_t N>
+      struct ElementSum<N, N>
+      {
+        /// \brief Return the sum.
+        /// \param[in] _sum Sum of all the terms.
+        /// \return _sum
+        template<typename L, typename R>
+        static typename L::Scalar Run(const L &, const R &,
+            const typename L::Scalar _sum)
+        {
+          return _sum;
+        }
+      };
+
+      /// \brief Matrix product of two expressions, for example a matrix
+      /// times a vector.
+      /// \tparam L Left operand.
+      /// \tparam R Right operand.
+      template<typename L, typename R>
+      class Product : public Expression<Product<L, R>>
+      {
+        static_assert(L::Cols == R::Rows,
+            "Operands of a matrix product must have compatible shapes");
+        static_assert(std::is_same<typename L::Scalar,
+            typename R::Scalar>::value,
+            "Operands of a matrix product must have the same element type");
+
+        /// \brief Element type
+        public: typedef typename L::Scalar Scalar;
+
+        /// \brief Number of rows
+        public: static const std::size_t Rows = L::Rows;
+
+        /// \brief Number of columns
+        public: static const std::size_t Cols = R::Cols;
+
+        /// \brief Constructor.
+        /// \param[in] _l Left operand.
+        /// \param[in] _r Right operand.
+        public: Product(const L &_l, const R &_r)
+          : l(_l), r(_r)
+        {
+        }
+
+        /// \brief Get an element.
+        /// \tparam I Row-major index of the element.
+        /// \return The element.
+        public: template<std::size_t I>
+        Scalar Coeff() const
+        {
+          return RowColumnSum<1, L::Cols>::template Run<I / Cols, I % Cols>(
+              this->l, this->r,
+              this->l.template Coeff<(I / Cols) * L::Cols>() *
+              this->r.template Coeff<I % Cols>());
+        }
+
+        /// \brief Left operand
+        private: L l;
+
+        /// \brief Right operand
+        private: R r;
+      };
+
+      /// \brief Start an expression from a vector or matrix.
+      /// \param[in] _v Vector3, Vector4, Matrix3 or Matrix4. It must
+      /// outlive the expression.
+      /// \return Expression that refers to _v.
+      template<typename V>
+      EnableUnary<V, Terminal<V>> Ref(const V &_v)
+      {
+        static_assert(Traits<V>::IsTerminal,
+            "Ref accepts Vector3, Vector4, Matrix3 and Matrix4");
+        return Terminal<V>(_v);
+      }
+
+      /// \brief Element-wise sum.
+      /// \param[in] _l Left operand.
+      /// \param[in] _r Right operand.
+      /// \return Expression of _l + _r.
+      template<typename L, typename R>
+      EnableBinary<L, R, Sum<typename Operand<L>::Type,
+        typename Operand<R>::Type, false>>
+      operator+(const L &_l, const R &_r)
+      {
+        return Sum<typename Operand<L>::Type, typename Operand<R>::Type,
+          false>(Operand<L>::Make(_l), Operand<R>::Make(_r));
+      }
+
+      /// \brief Element-wise difference.
+      /// \param[in] _l Left operand.
+      /// \param[in] _r Right operand.
+      /// \return Expression of _l - _r.
+      template<typename L, typename R>
+      EnableBinary<L, R, Sum<typename Operand<L>::Type,
+        typename Operand<R>::Type, true>>
+      operator-(const L &_l, const R &_r)
+      {
+        return Sum<typename Operand<L>::Type, typename Operand<R>::Type,
+          true>(Operand<L>::Make(_l), Operand<R>::Make(_r));
+      }
+
+      /// \brief Negation.
+      /// \param[in] _e Expression to negate.
+      /// \return Expression of -_e.
+      template<typename E>
+      Negate<E> operator-(const Expression<E> &_e)
+      {
+        return Negate<E>(_e.Derived());
+      }
+
+      /// \brief Product of an expression and a scalar.
+      /// \param[in] _e Expression.
+      /// \param[in] _s Scalar.
+      /// \return Expression of _e * _s.
+      template<typename E, typename S>
+      typename std::enable_if<std::is_arithmetic<S>::value,
+        Scale<E, false>>::type
+      operator*(const Expression<E> &_e, const S _s)
+      {
+        return Scale<E, false>(_e.Derived(),
+            static_cast<typename E::Scalar>(_s));
+      }
+
+      /// \brief Product of a scalar and an expression.
+      /// \param[in] _s Scalar.
+      /// \param[in] _e Expression.
+      /// \return Expression of _s * _e.
+      template<typename E, typename S>
+      typename std::enable_if<std::is_arithmetic<S>::value,
+        Scale<E, false>>::type
+      operator*(const S _s, const Expression<E> &_e)
+      {
+        return Scale<E, false>(_e.Derived(),
+            static_cast<typename E::Scalar>(_s));
+      }
+
+      /// \brief Quotient of an expression and a scalar.
+      /// \param[in] _e Expression.
+      /// \param[in] _s Divisor.
+      /// \return Expression of _e / _s.
+      template<typename E, typename S>
+      typename std::enable_if<std::is_arithmetic<S>::value,
+        Scale<E, true>>::type
+      operator/(const Expression<E> &_e, const S _s)
+      {
+        return Scale<E, true>(_e.Derived(),
+            static_cast<typename E::Scalar>(_s));
+      }
+
+      /// \brief Matrix product, such as a matrix times a vector.
+      /// \param[in] _l Left operand.
+      /// \param[in] _r Right operand.
+      /// \return Expression of _l * _r.
+      template<typename L, typename R>
+      EnableBinary<L, R, Product<typename Operand<L>::Type,
+        typename Operand<R>::Type>>
+      operator*(const L &_l, const R &_r)
+      {
+        return Product<typename Operand<L>::Type, typename Operand<R>::Type>(
+            Operand<L>::Make(_l), Operand<R>::Make(_r));
+      }
+
+      /// \brief Cross product of two 3D vectors.
+      /// \param[in] _l Left operand, an expression or a Vector3.
+      /// \param[in] _r Right operand, an expression or a Vector3.
+      /// \return Expression of _l x _r.
+      template<typename L, typename R>
+      EnableUnary<L, EnableUnary<R, CrossProduct<typename Operand<L>::Type,
+        typename Operand<R>::Type>>>
+      Cross(const L &_l, const R &_r)
+      {
+        return CrossProduct<typename Operand<L>::Type,
+          typename Operand<R>::Type>(Operand<L>::Make(_l),
+            Operand<R>::Make(_r));
+      }
+
+      /// \brief Sum of the element-wise products of two expressions. The
+      /// operands are not evaluated into temporaries.
+      /// \param[in] _l Left operand, an expression, vector or matrix.
+      /// \param[in] _r Right operand, an expression, vector or matrix.
+      /// \return The dot product of _l and _r.
+      template<typename L, typename R>
+      EnableUnary<L, EnableUnary<R, typename Operand<L>::Type::Scalar>>
+      Dot(const L &_l, const R &_r)
+      {
+        typedef typename Operand<L>::Type LE;
+        typedef typename Operand<R>::Type RE;
+        static_assert(LE::Rows == RE::Rows && LE::Cols == RE::Cols,
+            "Operands of Dot must have the same shape");
+
+        const LE &l = Operand<L>::Make(_l);
+        const RE &r = Operand<R>::Make(_r);
+        return ElementSum<1, LE::Rows * LE::Cols>::Run(l, r,
+            l.template Coeff<0>() * r.template Coeff<0>());
+      }
+
+      /// \brief Construct the result of an expression from its elements.
+      /// \param[in] _e Expression to evaluate.
+      /// \return The vector or matrix computed by _e.
+      template<typename E, std::size_t... I>
+      typename Result<typename E::Scalar, E::Rows, E::Cols>::Type
+      EvalElements(const E &_e, std::index_sequence<I...>)
+      {
+        return typename Result<typename E::Scalar, E::Rows, E::Cols>::Type(
+            _e.template Coeff<I>()...);
+      }
+
+      /// \brief Evaluate an expression in a single pass.
+      /// \param[in] _e Expression to evaluate.
+      /// \return The Vector3, Vector4, Matrix3 or Matrix4 computed by _e.
+      template<typename E>
+      typename Result<typename E::Scalar, E::Rows, E::Cols>::Type
+      Eval(const Expression<E> &_e)
+      {
+        return EvalElements(_e.Derived(),
+            std::make_index_sequence<E::Rows * E::Cols>());
+      }
+    }
+    }
+  }
+}
+#endif
@@ -17,8 +17,11 @@
 #ifndef IGNITION_MATH_FRUSTUM_HH_
 #define IGNITION_MATH_FRUSTUM_HH_
 
+#include <vector>
+
 #include <ignition/math/Angle.hh>
 #include <ignition/math/AxisAlignedBox.hh>
+#include <ignition/math/BoxPacket.hh>
 #include <ignition/math/Plane.hh>
 #include <ignition/math/Pose3.hh>
 #include <ignition/math/config.hh>
@@ -35,6 +38,11 @@ namespace ignition
 
     /// \brief Mathematical representation of a frustum and related functions.
     /// This is also known as a view frustum.
+    ///
+    /// The planes, corners and edges of the frustum are computed when they
+    /// are first used after a property changed, so setting several
+    /// properties in a row costs one computation. They are kept in the
+    /// frame of the frustum as well, and a change of pose only moves them.
     class IGNITION_MATH_VISIBLE Frustum
     {
       /// \brief Planes that define the boundaries of the frustum.
@@ -158,6 +166,37 @@ namespace ignition
       /// \return True if the point is inside the pyramid frustum.
       public: bool Contains(const Vector3d &_p) const;
 
+      /// \brief Check which boxes of a packet lie inside the pyramid
+      /// frustum. The boxes are tested against the planes with SIMD
+      /// instructions, and each box gets the same result as
+      /// Contains(const AxisAlignedBox &).
+      /// \param[in] _boxes Boxes to check.
+      /// \param[out] _visible Whether each box is inside the pyramid
+      /// frustum. Resized to the number of boxes.
+      /// \return Number of boxes inside the pyramid frustum.
+      public: std::size_t Contains(const BoxPacket &_boxes,
+                                   std::vector<bool> &_visible) const;
+
+      /// \brief Check which boxes of a packet lie inside the pyramid
+      /// frustum, testing only some of the planes. This is used to cull a
+      /// hierarchy of boxes: the planes crossed by a box are the only ones
+      /// that need to be tested for the boxes it contains.
+      /// \param[in] _boxes Boxes to check.
+      /// \param[in] _planes Planes to test, bit i being set for the
+      /// plane FrustumPlane(i). 0x3f tests all the planes. The boxes must
+      /// be on the positive side of the other planes.
+      /// \param[out] _visible Whether each box is inside the pyramid
+      /// frustum. Resized to the number of boxes.
+      /// \param[out] _crossed The planes of _planes crossed by each box,
+      /// with the same bits as _planes. It is zero for the boxes that are
+      /// entirely inside the frustum and for those that are not visible.
+      /// Resized to the number of boxes.
+      /// \return Number of boxes inside the pyramid frustum.
+      public: std::size_t Contains(const BoxPacket &_boxes,
+                                   const unsigned int _planes,
+                                   std::vector<bool> &_visible,
+                                   std::vector<unsigned int> &_crossed) const;
+
       /// \brief Get the pose of the frustum
       /// \return Pose of the frustum
       /// \sa SetPose
@@ -173,10 +212,6 @@ namespace ignition
       /// \return The new frustum.
       public: Frustum &operator=(const Frustum &_f);
 
-      /// \brief Compute the planes of the frustum. This is called whenever
-      /// a property of the frustum is changed.
-      private: void ComputePlanes();
-
       /// \internal
       /// \brief Private data pointer
       private: FrustumPrivate *dataPtr;
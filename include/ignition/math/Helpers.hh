@@ -30,6 +30,21 @@
 #include <ignition/math/config.hh>
 #include "ignition/math/Export.hh"
 
+/// \brief constexpr specifier for the functions that return Angle, Vector2,
+/// Vector3 or Matrix3 by value, and for the definitions of their constants.
+/// These types have virtual destructors unless IGNITION_MATH_POD_TYPES is
+/// set, so they are literal types, and can be used in constant expressions,
+/// only in that case. A function, template or not, that returns a
+/// non-literal type cannot be constexpr. Their constructors are always
+/// constexpr, so that their constants are initialized at compile time in
+/// both cases. Quaternion has no virtual destructor in either case, so the
+/// functions that return a Quaternion are plain constexpr.
+#ifdef IGNITION_MATH_POD_TYPES
+#define IGN_MATH_POD_CONSTEXPR constexpr
+#else
+#define IGN_MATH_POD_CONSTEXPR
+#endif
+
 /// \brief The default tolerance value used by MassMatrix3::IsValid(),
 /// MassMatrix3::IsPositive(), and MassMatrix3::ValidMoments()
 template <typename T>
@@ -399,7 +414,7 @@ namespace ignition
     /// \param[in] _min minimum
     /// \param[in] _max maximum
     template<typename T>
-    inline T clamp(T _v, T _min, T _max)
+    constexpr T clamp(T _v, T _min, T _max)
     {
       return std::max(std::min(_v, _max), _min);
     }
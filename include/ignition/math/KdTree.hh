@@ -0,0 +1,149 @@
+/*
+ * Copyright (C) 2018 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef IGNITION_MATH_KDTREE_HH_
+#define IGNITION_MATH_KDTREE_HH_
+
+#include <cstddef>
+#include <memory>
+#include <tuple>
+#include <vector>
+
+#include <ignition/math/Export.hh>
+#include <ignition/math/Vector3.hh>
+#include <ignition/math/Vector3View.hh>
+#include <ignition/math/config.hh>
+
+namespace ignition
+{
+  namespace math
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace IGNITION_MATH_VERSION_NAMESPACE {
+    //
+    // Forward declare private data
+    class KdTreePrivate;
+
+    /// \class KdTree KdTree.hh ignition/math/KdTree.hh
+    /// \brief A k-d tree over a static set of points, used to find the
+    /// points nearest to a position or within a radius without testing
+    /// every point.
+    ///
+    /// The tree is implicit: the points are reordered so that each node is
+    /// a range of the point array, split at its middle element along the
+    /// axis of largest extent, and only the split axis of each node is
+    /// stored. Ranges of a few points are leaves. Queries return the index
+    /// of the points in the vector given to Build(), and can run in several
+    /// threads at once. Points at a NaN distance from the query position,
+    /// such as points with a NaN coordinate, are never returned, and points
+    /// at an infinite distance come after all the others, like in
+    /// SpatialHashGrid. Use SpatialHashGrid for points that move.
+    class IGNITION_MATH_VISIBLE KdTree
+    {
+      /// \brief Default constructor. The tree is empty.
+      public: KdTree();
+
+      /// \brief Constructor that builds the tree of a set of points.
+      /// \param[in] _points The points.
+      public: explicit KdTree(const std::vector<Vector3d> &_points);
+
+      /// \brief Copy constructor.
+      /// \param[in] _tree Tree to copy.
+      public: KdTree(const KdTree &_tree);
+
+      /// \brief Destructor.
+      public: ~KdTree();
+
+      /// \brief Assignment operator.
+      /// \param[in] _tree Tree to copy.
+      /// \return Reference to this tree.
+      public: KdTree &operator=(const KdTree &_tree);
+
+      /// \brief Build the tree of a set of points, replacing the previous
+      /// content. The tree is the same for any number of threads.
+      /// \param[in] _points The points.
+      /// \param[in] _threadCount Number of threads used to build the
+      /// subtrees, 0 for the number of hardware threads.
+      public: void Build(const std::vector<Vector3d> &_points,
+                  const unsigned int _threadCount = 1);
+
+      /// \brief Build the tree of a set of points stored in an external
+      /// buffer, replacing the previous content. The points are copied.
+      /// \param[in] _points View of the points.
+      /// \param[in] _threadCount Number of threads used to build the
+      /// subtrees, 0 for the number of hardware threads.
+      public: void Build(const Vector3View<double> &_points,
+                  const unsigned int _threadCount = 1);
+
+      /// \brief Get the number of points.
+      /// \return Number of points.
+      public: std::size_t Size() const;
+
+      /// \brief Find the point closest to a position.
+      /// \param[in] _point The position.
+      /// \return A boolean, double, std::size_t tuple. The boolean value is
+      /// false if no point was found, such as when the tree is empty or
+      /// _point has a NaN coordinate. The double is the distance to the
+      /// closest point, and the std::size_t its index. If several points
+      /// are at the same distance, the smallest index is returned. The
+      /// double and std::size_t values are zero when the boolean value is
+      /// false.
+      public: std::tuple<bool, double, std::size_t> Closest(
+                  const Vector3d &_point) const;
+
+      /// \brief Find the points closest to a position.
+      /// \param[in] _point The position.
+      /// \param[in] _k Number of points to find.
+      /// \param[out] _indices Indices of the min(_k, Size()) closest
+      /// points, sorted by increasing distance. Points at the same distance
+      /// are sorted by index. The points at a NaN distance are skipped.
+      /// The vector is cleared first.
+      /// \param[in] _epsilon Tolerance of an approximate search, which
+      /// skips the parts of the tree that cannot hold points closer than
+      /// the distance of the i-th point found divided by (1 + _epsilon).
+      /// The distance of the i-th point returned is then at most
+      /// (1 + _epsilon) times that of the exact i-th closest point. Zero
+      /// gives the exact result.
+      /// \return True if at least one point was found.
+      public: bool Nearest(const Vector3d &_point, const std::size_t _k,
+                  std::vector<std::size_t> &_indices,
+                  const double _epsilon = 0) const;
+
+      /// \brief Find all the points within a distance of a position.
+      /// \param[in] _center The position.
+      /// \param[in] _radius Maximum distance, inclusive.
+      /// \param[out] _indices Indices of the points, in no particular
+      /// order. The vector is cleared first.
+      /// \return True if at least one point is within _radius.
+      public: bool InRadius(const Vector3d &_center, const double _radius,
+                  std::vector<std::size_t> &_indices) const;
+
+#ifdef _WIN32
+// Disable warning C4251 which is triggered by
+// std::unique_ptr
+#pragma warning(push)
+#pragma warning(disable: 4251)
+#endif
+      /// \brief Private data pointer.
+      private: std::unique_ptr<KdTreePrivate> dataPtr;
+#ifdef _WIN32
+#pragma warning(pop)
+#endif
+    };
+    }
+  }
+}
+#endif
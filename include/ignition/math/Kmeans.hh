@@ -19,6 +19,7 @@
 
 #include <vector>
 #include <ignition/math/Vector3.hh>
+#include <ignition/math/Vector3View.hh>
 #include <ignition/math/Helpers.hh>
 #include <ignition/math/config.hh>
 
@@ -43,6 +44,11 @@ namespace ignition
       /// \param[in] _obs Set of observations to cluster.
       public: explicit Kmeans(const std::vector<Vector3d> &_obs);
 
+      /// \brief Constructor from observations stored in an external
+      /// buffer. The observations are copied.
+      /// \param[in] _obs View of the observations to cluster.
+      public: explicit Kmeans(const Vector3View<double> &_obs);
+
       /// \brief Destructor.
       public: virtual ~Kmeans();
 
@@ -55,11 +61,23 @@ namespace ignition
       /// \return True if the vector is not empty or false otherwise.
       public: bool Observations(const std::vector<Vector3d> &_obs);
 
+      /// \brief Set the observations to cluster from an external buffer.
+      /// The observations are copied.
+      /// \param[in] _obs View of the new observations.
+      /// \return True if the view is not empty or false otherwise.
+      public: bool Observations(const Vector3View<double> &_obs);
+
       /// \brief Add observations to the cluster.
       /// \param[in] _obs Vector of observations.
       /// \return True if the _obs vector is not empty or false otherwise.
       public: bool AppendObservations(const std::vector<Vector3d> &_obs);
 
+      /// \brief Add observations stored in an external buffer to the
+      /// cluster. The observations are copied.
+      /// \param[in] _obs View of the observations.
+      /// \return True if the view is not empty or false otherwise.
+      public: bool AppendObservations(const Vector3View<double> &_obs);
+
       /// \brief Executes the k-means algorithm.
       /// \param[in] _k Number of partitions to cluster.
       /// \param[out] _centroids Vector of centroids. Each element contains the
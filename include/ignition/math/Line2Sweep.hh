@@ -0,0 +1,115 @@
+/*
+ * Copyright (C) 2018 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef IGNITION_MATH_LINE2SWEEP_HH_
+#define IGNITION_MATH_LINE2SWEEP_HH_
+
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include <ignition/math/Export.hh>
+#include <ignition/math/Line2.hh>
+#include <ignition/math/config.hh>
+
+namespace ignition
+{
+  namespace math
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace IGNITION_MATH_VERSION_NAMESPACE {
+    //
+    // Forward declare private data
+    class Line2SweepPrivate;
+
+    /// \class Line2Sweep Line2Sweep.hh ignition/math/Line2Sweep.hh
+    /// \brief Find all the intersections among a set of 2D line segments
+    /// with a sweep line, as in the Bentley-Ottmann algorithm, in
+    /// O((n + k) log n) time for n segments and k intersecting pairs,
+    /// instead of testing every pair with Line2::Intersect().
+    ///
+    /// Segments that touch, such as a segment ending on another one, and
+    /// segments that share an end point intersect. Collinear segments that
+    /// overlap are reported once, with the part they share. Segments may
+    /// have a zero length, and any number of segments may go through the
+    /// same point.
+    ///
+    /// Crossing points are computed in double precision. Points closer
+    /// than 1e-10 times the largest coordinate of the segments are merged,
+    /// so that the segments going through a crossing are grouped even if
+    /// the crossing is computed slightly differently for each pair.
+    class IGNITION_MATH_VISIBLE Line2Sweep
+    {
+      /// \brief Constructor.
+      public: Line2Sweep();
+
+      /// \brief Copy constructor.
+      /// \param[in] _sweep Object to copy.
+      public: Line2Sweep(const Line2Sweep &_sweep);
+
+      /// \brief Destructor.
+      public: ~Line2Sweep();
+
+      /// \brief Assignment operator.
+      /// \param[in] _sweep Object to copy.
+      /// \return Reference to this object.
+      public: Line2Sweep &operator=(const Line2Sweep &_sweep);
+
+      /// \brief Find the intersecting pairs of segments. The memory used
+      /// by the sweep is kept to be reused by the next call.
+      /// \param[in] _lines The segments, at most 2^32 - 1 of them.
+      /// \param[out] _pairs Indices in _lines of the two segments of each
+      /// intersection, smallest first, in the order of the sweep. Its
+      /// previous content is discarded.
+      /// \param[out] _shared Part shared by the segments of each pair.
+      /// Both of its points are the intersection point, except for
+      /// collinear segments that overlap, where they are the ends of the
+      /// overlap. Its previous content is discarded.
+      /// \return True if at least one pair of segments intersects.
+      public: bool Intersect(const std::vector<Line2d> &_lines,
+                  std::vector<std::pair<std::size_t, std::size_t>> &_pairs,
+                  std::vector<Line2d> &_shared);
+
+      /// \brief Find the intersecting pairs of segments.
+      /// \param[in] _lines The segments, at most 2^32 - 1 of them.
+      /// \param[out] _pairs Indices in _lines of the two segments of each
+      /// intersection, smallest first, in the order of the sweep. Its
+      /// previous content is discarded.
+      /// \param[out] _points Intersection point of each pair. For
+      /// collinear segments that overlap, this is the end of the overlap
+      /// with the smallest x, then y. Its previous content is discarded.
+      /// \return True if at least one pair of segments intersects.
+      public: bool Intersect(const std::vector<Line2d> &_lines,
+                  std::vector<std::pair<std::size_t, std::size_t>> &_pairs,
+                  std::vector<Vector2d> &_points);
+
+#ifdef _WIN32
+// Disable warning C4251 which is triggered by
+// std::unique_ptr
+#pragma warning(push)
+#pragma warning(disable: 4251)
+#endif
+      /// \brief Private data pointer.
+      private: std::unique_ptr<Line2SweepPrivate> dataPtr;
+#ifdef _WIN32
+#pragma warning(pop)
+#endif
+    };
+    }
+  }
+}
+#endif
@@ -18,7 +18,9 @@
 #define IGNITION_MATH_LINE3_HH_
 
 #include <algorithm>
+#include <vector>
 #include <ignition/math/Vector3.hh>
+#include <ignition/math/Vector3Array.hh>
 #include <ignition/math/config.hh>
 
 namespace ignition
@@ -228,6 +230,49 @@ namespace ignition
         return true;
       }
 
+      /// \brief Get the closest points between many pairs of segments.
+      /// Segment i of the first set goes from _startA[i] to _endA[i], and
+      /// is paired with segment i of the second set, from _startB[i] to
+      /// _endB[i].
+      ///
+      /// The result is the exact minimum over both segments. It matches
+      /// Distance() when the closest points are inside the segments, and
+      /// may be closer otherwise, since Distance() does not update the
+      /// point of this line after clamping the point of _line. Parallel
+      /// and zero length segments are handled without an epsilon, and the
+      /// float and double versions of this function process several pairs
+      /// at once with SIMD instructions.
+      /// \param[in] _startA Start points of the first segments.
+      /// \param[in] _endA End points of the first segments.
+      /// \param[in] _startB Start points of the second segments.
+      /// \param[in] _endB End points of the second segments.
+      /// \param[out] _pointsA Closest points on the first segments,
+      /// resized to the number of pairs.
+      /// \param[out] _pointsB Closest points on the second segments,
+      /// resized to the number of pairs.
+      /// \param[out] _sqDist Squared distances between the closest points,
+      /// resized to the number of pairs.
+      /// \return False if the four sets of points do not have the same
+      /// size, in which case the outputs are not changed.
+      public: static bool ClosestPoints(const Vector3Array<T> &_startA,
+                  const Vector3Array<T> &_endA,
+                  const Vector3Array<T> &_startB,
+                  const Vector3Array<T> &_endB, Vector3Array<T> &_pointsA,
+                  Vector3Array<T> &_pointsB, std::vector<T> &_sqDist)
+      {
+        const std::size_t n = _startA.Size();
+        if (_endA.Size() != n || _startB.Size() != n || _endB.Size() != n)
+          return false;
+
+        _pointsA.Resize(n);
+        _pointsB.Resize(n);
+        _sqDist.resize(n);
+        detail::Vector3ArrayKernels<T>::SegmentClosestPoints(
+            _startA.Data(), _endA.Data(), _startB.Data(), _endB.Data(),
+            _pointsA.Data(), _pointsB.Data(), _sqDist.data(), n);
+        return true;
+      }
+
       /// \brief Check if this line intersects the given line segment.
       /// \param[in] _line The line to check for intersection.
       /// \param[in] _epsilon The error bounds within which the intersection
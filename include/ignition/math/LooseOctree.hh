@@ -0,0 +1,209 @@
+/*
+ * Copyright (C) 2018 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef IGNITION_MATH_LOOSEOCTREE_HH_
+#define IGNITION_MATH_LOOSEOCTREE_HH_
+
+#include <cstddef>
+#include <memory>
+#include <tuple>
+#include <vector>
+
+#include <ignition/math/AxisAlignedBox.hh>
+#include <ignition/math/Export.hh>
+#include <ignition/math/Frustum.hh>
+#include <ignition/math/Vector3.hh>
+#include <ignition/math/config.hh>
+
+namespace ignition
+{
+  namespace math
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace IGNITION_MATH_VERSION_NAMESPACE {
+    //
+    // Forward declare private data
+    class LooseOctreePrivate;
+
+    /// \class LooseOctree LooseOctree.hh ignition/math/LooseOctree.hh
+    /// \brief A loose octree over a set of axis aligned boxes that move,
+    /// used to find the boxes hit by a ray, overlapping a box or visible
+    /// in a frustum without testing every box.
+    ///
+    /// The tree divides a cubic region. Each node is a cell of the region
+    /// whose bounds are enlarged to twice its size, so a box is stored in
+    /// the deepest node at least as large as the box, chosen by the center
+    /// of the box, without being split. Inserting, moving and removing a
+    /// box only visit the nodes on the path from the root to this node,
+    /// and moving a box within the enlarged bounds of its node does not
+    /// touch the tree at all. Boxes outside the region are kept in the
+    /// root. Nodes and boxes are recycled through free lists, so once the
+    /// tree has reached its largest size, updates do not allocate memory.
+    ///
+    /// Boxes are identified by the id returned by Insert(), which may be
+    /// reused after Remove(). The rays are described as in
+    /// AxisAlignedBox::Intersect(const Vector3d &, const Vector3d &,
+    /// const double, const double) const, and the queries return the same
+    /// results as Bvh.
+    class IGNITION_MATH_VISIBLE LooseOctree
+    {
+      /// \brief Constructor.
+      /// \param[in] _region Region divided by the tree. The tree uses the
+      /// smallest cube centered on _region that contains it. A unit cube
+      /// centered on the origin is used if _region is empty.
+      /// \param[in] _maxDepth Maximum depth of the nodes, at most 16.
+      public: explicit LooseOctree(const AxisAlignedBox &_region,
+                  const unsigned int _maxDepth = 8);
+
+      /// \brief Copy constructor.
+      /// \param[in] _tree Tree to copy.
+      public: LooseOctree(const LooseOctree &_tree);
+
+      /// \brief Destructor.
+      public: ~LooseOctree();
+
+      /// \brief Assignment operator.
+      /// \param[in] _tree Tree to copy.
+      /// \return Reference to this tree.
+      public: LooseOctree &operator=(const LooseOctree &_tree);
+
+      /// \brief Get the region divided by the tree.
+      /// \return The cube divided by the tree.
+      public: AxisAlignedBox Region() const;
+
+      /// \brief Get the maximum depth of the nodes.
+      /// \return The maximum depth.
+      public: unsigned int MaxDepth() const;
+
+      /// \brief Reserve memory for a number of boxes, so that inserting
+      /// them does not allocate memory for the boxes.
+      /// \param[in] _size Number of boxes.
+      public: void Reserve(const std::size_t _size);
+
+      /// \brief Add a box to the tree. Empty boxes, such as default
+      /// constructed ones, are stored but never returned by the queries.
+      /// \param[in] _box The box.
+      /// \return Id of the box.
+      public: std::size_t Insert(const AxisAlignedBox &_box);
+
+      /// \brief Remove a box from the tree.
+      /// \param[in] _id Id of the box.
+      /// \return False if _id is not the id of a box of the tree.
+      public: bool Remove(const std::size_t _id);
+
+      /// \brief Move or resize a box.
+      /// \param[in] _id Id of the box.
+      /// \param[in] _box New value of the box.
+      /// \return False if _id is not the id of a box of the tree.
+      public: bool Update(const std::size_t _id, const AxisAlignedBox &_box);
+
+      /// \brief Remove all the boxes.
+      public: void Clear();
+
+      /// \brief Get the number of boxes.
+      /// \return Number of boxes.
+      public: std::size_t Size() const;
+
+      /// \brief Get the number of nodes of the tree.
+      /// \return Number of nodes, at least 1 for the root.
+      public: std::size_t NodeCount() const;
+
+      /// \brief Check if an id is the id of a box of the tree.
+      /// \param[in] _id Id to check.
+      /// \return True if the tree has a box with this id.
+      public: bool Has(const std::size_t _id) const;
+
+      /// \brief Get a box.
+      /// \param[in] _id Id of the box.
+      /// \return The box, a default constructed box if _id is not the id
+      /// of a box of the tree.
+      public: AxisAlignedBox Box(const std::size_t _id) const;
+
+      /// \brief Find the box closest to the origin of a ray.
+      /// \param[in] _origin Origin of the ray.
+      /// \param[in] _dir Direction of the ray. This ray will be normalized.
+      /// \param[in] _min Minimum allowed distance.
+      /// \param[in] _max Maximum allowed distance.
+      /// \return A boolean, double, std::size_t tuple. The boolean value is
+      /// true if the ray hits a box. The double is the distance from
+      /// _origin + _min * _dir to the closest hit, as returned by
+      /// AxisAlignedBox::IntersectDist(). The std::size_t is the id of
+      /// the closest box, the smallest one if several boxes are hit at
+      /// this distance. The double and std::size_t values are zero when
+      /// the boolean value is false.
+      public: std::tuple<bool, double, std::size_t> Intersect(
+                  const Vector3d &_origin, const Vector3d &_dir,
+                  const double _min, const double _max) const;
+
+      /// \brief Check if a ray hits any box. This is faster than
+      /// Intersect() since the search stops at the first hit.
+      /// \param[in] _origin Origin of the ray.
+      /// \param[in] _dir Direction of the ray. This ray will be normalized.
+      /// \param[in] _min Minimum allowed distance.
+      /// \param[in] _max Maximum allowed distance.
+      /// \return True if the ray hits at least one box.
+      public: bool IntersectCheck(const Vector3d &_origin,
+                  const Vector3d &_dir, const double _min,
+                  const double _max) const;
+
+      /// \brief Find all the boxes hit by a ray.
+      /// \param[in] _origin Origin of the ray.
+      /// \param[in] _dir Direction of the ray. This ray will be normalized.
+      /// \param[in] _min Minimum allowed distance.
+      /// \param[in] _max Maximum allowed distance.
+      /// \param[out] _ids Ids of the boxes hit by the ray, in no
+      /// particular order. The vector is cleared first.
+      /// \return True if the ray hits at least one box.
+      public: bool IntersectAll(const Vector3d &_origin,
+                  const Vector3d &_dir, const double _min, const double _max,
+                  std::vector<std::size_t> &_ids) const;
+
+      /// \brief Find all the boxes that intersect a box, as defined by
+      /// AxisAlignedBox::Intersects().
+      /// \param[in] _box The box to test.
+      /// \param[out] _ids Ids of the boxes that intersect _box, in no
+      /// particular order. The vector is cleared first.
+      /// \return True if at least one box intersects _box.
+      public: bool Overlap(const AxisAlignedBox &_box,
+                  std::vector<std::size_t> &_ids) const;
+
+      /// \brief Find all the boxes inside a frustum, as defined by
+      /// Frustum::Contains(const AxisAlignedBox &) const. The nodes are
+      /// culled against the planes of the frustum, and only the planes
+      /// crossed by a node are tested for the boxes it contains.
+      /// \param[in] _frustum The frustum.
+      /// \param[out] _ids Ids of the boxes inside _frustum, in no
+      /// particular order. The vector is cleared first.
+      /// \return True if at least one box is inside _frustum.
+      public: bool Visible(const Frustum &_frustum,
+                  std::vector<std::size_t> &_ids) const;
+
+#ifdef _WIN32
+// Disable warning C4251 which is triggered by
+// std::unique_ptr
+#pragma warning(push)
+#pragma warning(disable: 4251)
+#endif
+      /// \brief Private data pointer.
+      private: std::unique_ptr<LooseOctreePrivate> dataPtr;
+#ifdef _WIN32
+#pragma warning(pop)
+#endif
+    };
+    }
+  }
+}
+#endif
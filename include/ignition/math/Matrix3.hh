@@ -19,6 +19,7 @@
 
 #include <algorithm>
 #include <cstring>
+#include <type_traits>
 #include <utility>
 #include <ignition/math/Helpers.hh>
 #include <ignition/math/Vector3.hh>
@@ -46,17 +47,14 @@ namespace ignition
       public: static const Matrix3<T> Zero;
 
       /// \brief Constructor
-      public: Matrix3()
+      public: constexpr Matrix3()
+      : data{{0, 0, 0}, {0, 0, 0}, {0, 0, 0}}
       {
-        std::memset(this->data, 0, sizeof(this->data[0][0])*9);
       }
 
       /// \brief Copy constructor
       /// \param _m Matrix to copy
-      public: Matrix3(const Matrix3<T> &_m)
-      {
-        std::memcpy(this->data, _m.data, sizeof(this->data[0][0])*9);
-      }
+      public: Matrix3(const Matrix3<T> &_m) = default;
 
       /// \brief Constructor
       /// \param[in] _v00 Row 0, Col 0 value
@@ -68,19 +66,11 @@ namespace ignition
       /// \param[in] _v20 Row 2, Col 0 value
       /// \param[in] _v21 Row 2, Col 1 value
       /// \param[in] _v22 Row 2, Col 2 value
-      public: Matrix3(T _v00, T _v01, T _v02,
-                      T _v10, T _v11, T _v12,
-                      T _v20, T _v21, T _v22)
+      public: constexpr Matrix3(T _v00, T _v01, T _v02,
+                                T _v10, T _v11, T _v12,
+                                T _v20, T _v21, T _v22)
+      : data{{_v00, _v01, _v02}, {_v10, _v11, _v12}, {_v20, _v21, _v22}}
       {
-        this->data[0][0] = _v00;
-        this->data[0][1] = _v01;
-        this->data[0][2] = _v02;
-        this->data[1][0] = _v10;
-        this->data[1][1] = _v11;
-        this->data[1][2] = _v12;
-        this->data[2][0] = _v20;
-        this->data[2][1] = _v21;
-        this->data[2][2] = _v22;
       }
 
       /// \brief Construct Matrix3 from a quaternion.
@@ -101,7 +91,11 @@ namespace ignition
       }
 
       /// \brief Desctructor
+#ifdef IGNITION_MATH_POD_TYPES
+      public: ~Matrix3() = default;
+#else
       public: virtual ~Matrix3() {}
+#endif
 
       /// \brief Set values
       /// \param[in] _v00 Row 0, Col 0 value
@@ -113,9 +107,9 @@ namespace ignition
       /// \param[in] _v20 Row 2, Col 0 value
       /// \param[in] _v21 Row 2, Col 1 value
       /// \param[in] _v22 Row 2, Col 2 value
-      public: void Set(T _v00, T _v01, T _v02,
-                       T _v10, T _v11, T _v12,
-                       T _v20, T _v21, T _v22)
+      public: constexpr void Set(T _v00, T _v01, T _v02,
+                                 T _v10, T _v11, T _v12,
+                                 T _v20, T _v21, T _v22)
       {
         this->data[0][0] = _v00;
         this->data[0][1] = _v01;
@@ -222,14 +216,11 @@ namespace ignition
       /// \brief Equal operator. this = _mat
       /// \param _mat Incoming matrix
       /// \return itself
-      public: Matrix3<T> &operator=(const Matrix3<T> &_mat)
-      {
-        memcpy(this->data, _mat.data, sizeof(this->data[0][0])*9);
-        return *this;
-      }
+      public: Matrix3<T> &operator=(const Matrix3<T> &_mat) = default;
 
       /// \brief returns the element wise difference of two matrices
-      public: Matrix3<T> operator-(const Matrix3<T> &_m) const
+      public: IGN_MATH_POD_CONSTEXPR Matrix3<T> operator-(
+                  const Matrix3<T> &_m) const
       {
         return Matrix3<T>(
             this->data[0][0] - _m(0, 0),
@@ -244,7 +235,8 @@ namespace ignition
       }
 
       /// \brief returns the element wise sum of two matrices
-      public: Matrix3<T> operator+(const Matrix3<T> &_m) const
+      public: IGN_MATH_POD_CONSTEXPR Matrix3<T> operator+(
+                  const Matrix3<T> &_m) const
       {
         return Matrix3<T>(
             this->data[0][0]+_m(0, 0),
@@ -259,7 +251,7 @@ namespace ignition
       }
 
       /// \brief returns the element wise scalar multiplication
-      public: Matrix3<T> operator*(const T &_s) const
+      public: IGN_MATH_POD_CONSTEXPR Matrix3<T> operator*(const T &_s) const
       {
         return Matrix3<T>(
           _s * this->data[0][0], _s * this->data[0][1], _s * this->data[0][2],
@@ -270,7 +262,8 @@ namespace ignition
       /// \brief Matrix multiplication operator
       /// \param[in] _m Matrix3<T> to multiply
       /// \return product of this * _m
-      public: Matrix3<T> operator*(const Matrix3<T> &_m) const
+      public: IGN_MATH_POD_CONSTEXPR Matrix3<T> operator*(
+                  const Matrix3<T> &_m) const
       {
         return Matrix3<T>(
             // first row
@@ -317,7 +310,8 @@ namespace ignition
       /// treated like a column vector.
       /// \param _vec Vector3
       /// \return Resulting vector from multiplication
-      public: Vector3<T> operator*(const Vector3<T> &_vec) const
+      public: IGN_MATH_POD_CONSTEXPR Vector3<T> operator*(
+                  const Vector3<T> &_vec) const
       {
         return Vector3<T>(
             this->data[0][0]*_vec.X() + this->data[0][1]*_vec.Y() +
@@ -332,7 +326,8 @@ namespace ignition
       /// \param[in] _s Scaling factor.
       /// \param[in] _m Input matrix.
       /// \return A scaled matrix.
-      public: friend inline Matrix3<T> operator*(T _s, const Matrix3<T> &_m)
+      public: friend IGN_MATH_POD_CONSTEXPR Matrix3<T> operator*(
+                  T _s, const Matrix3<T> &_m)
       {
         return _m * _s;
       }
@@ -343,8 +338,8 @@ namespace ignition
       /// \param[in] _v Input vector.
       /// \param[in] _m Input matrix.
       /// \return The product vector.
-      public: friend inline Vector3<T> operator*(const Vector3<T> &_v,
-                                                 const Matrix3<T> &_m)
+      public: friend IGN_MATH_POD_CONSTEXPR Vector3<T> operator*(
+                  const Vector3<T> &_v, const Matrix3<T> &_m)
       {
         return Vector3<T>(
             _m(0, 0)*_v.X() + _m(1, 0)*_v.Y() + _m(2, 0)*_v.Z(),
@@ -398,7 +393,7 @@ namespace ignition
       /// \param[in] _row row index. _row is clamped to the range [0,2]
       /// \param[in] _col column index. _col is clamped to the range [0,2]
       /// \return a pointer to the row
-      public: inline const T &operator()(size_t _row, size_t _col) const
+      public: constexpr const T &operator()(size_t _row, size_t _col) const
       {
         return this->data[clamp(_row, IGN_ZERO_SIZE_T, IGN_TWO_SIZE_T)]
                          [clamp(_col, IGN_ZERO_SIZE_T, IGN_TWO_SIZE_T)];
@@ -408,7 +403,7 @@ namespace ignition
       /// \param[in] _row row index. _row is clamped to the range [0,2]
       /// \param[in] _col column index. _col is clamped to the range [0,2]
       /// \return a pointer to the row
-      public: inline T &operator()(size_t _row, size_t _col)
+      public: constexpr T &operator()(size_t _row, size_t _col)
       {
         return this->data[clamp(_row, IGN_ZERO_SIZE_T, IGN_TWO_SIZE_T)]
                          [clamp(_col, IGN_ZERO_SIZE_T, IGN_TWO_SIZE_T)];
@@ -416,7 +411,7 @@ namespace ignition
 
       /// \brief Return the determinant of the matrix
       /// \return Determinant of this matrix.
-      public: T Determinant() const
+      public: constexpr T Determinant() const
       {
         T t0 = this->data[2][2]*this->data[1][1]
              - this->data[2][1]*this->data[1][2];
@@ -434,7 +429,7 @@ namespace ignition
 
       /// \brief Return the inverse matrix
       /// \return Inverse of this matrix.
-      public: Matrix3<T> Inverse() const
+      public: IGN_MATH_POD_CONSTEXPR Matrix3<T> Inverse() const
       {
         T t0 = this->data[2][2]*this->data[1][1] -
                     this->data[2][1]*this->data[1][2];
@@ -477,7 +472,7 @@ namespace ignition
 
       /// \brief Return the transpose of this matrix
       /// \return Transpose of this matrix.
-      public: Matrix3<T> Transposed() const
+      public: IGN_MATH_POD_CONSTEXPR Matrix3<T> Transposed() const
       {
         return Matrix3<T>(
           this->data[0][0], this->data[1][0], this->data[2][0],
@@ -529,13 +524,13 @@ namespace ignition
     };
 
     template<typename T>
-    const Matrix3<T> Matrix3<T>::Identity(
+    IGN_MATH_POD_CONSTEXPR const Matrix3<T> Matrix3<T>::Identity(
         1, 0, 0,
         0, 1, 0,
         0, 0, 1);
 
     template<typename T>
-    const Matrix3<T> Matrix3<T>::Zero(
+    IGN_MATH_POD_CONSTEXPR const Matrix3<T> Matrix3<T>::Zero(
         0, 0, 0,
         0, 0, 0,
         0, 0, 0);
@@ -543,6 +538,21 @@ namespace ignition
     typedef Matrix3<int> Matrix3i;
     typedef Matrix3<double> Matrix3d;
     typedef Matrix3<float> Matrix3f;
+
+#ifdef IGNITION_MATH_POD_TYPES
+    static_assert(sizeof(Matrix3d) == 9 * sizeof(double),
+        "Matrix3d must have the memory layout of double[9]");
+    static_assert(std::is_standard_layout<Matrix3d>::value,
+        "Matrix3d must be standard-layout");
+    static_assert(std::is_trivially_copyable<Matrix3d>::value,
+        "Matrix3d must be trivially copyable");
+    static_assert(sizeof(Matrix3f) == 9 * sizeof(float),
+        "Matrix3f must have the memory layout of float[9]");
+    static_assert(std::is_standard_layout<Matrix3f>::value,
+        "Matrix3f must be standard-layout");
+    static_assert(std::is_trivially_copyable<Matrix3f>::value,
+        "Matrix3f must be trivially copyable");
+#endif
     }
   }
 }
@@ -18,12 +18,17 @@
 #define IGNITION_MATH_MATRIX4_HH_
 
 #include <algorithm>
+#include <cstddef>
+#include <type_traits>
 #include <utility>
+#include <vector>
+#include <ignition/math/Export.hh>
 #include <ignition/math/Helpers.hh>
 #include <ignition/math/Matrix3.hh>
 #include <ignition/math/Vector3.hh>
 #include <ignition/math/Pose3.hh>
 #include <ignition/math/config.hh>
+#include <ignition/math/detail/Soa.hh>
 
 namespace ignition
 {
@@ -31,7 +36,300 @@ namespace ignition
   {
     // Inline bracket to help doxygen filtering.
     inline namespace IGNITION_MATH_VERSION_NAMESPACE {
-    //
+    namespace detail
+    {
+      /// \brief Portable scalar implementation of the Matrix4 kernels.
+      /// Matrices are passed as arrays of 4 rows of 4 values. Output
+      /// matrices must not overlap the input matrices.
+      template<typename T>
+      class Matrix4ScalarKernels
+      {
+        /// \brief _out = _a * _b
+        /// \param[in] _a Left hand side matrix.
+        /// \param[in] _b Right hand side matrix.
+        /// \param[out] _out Product.
+        public: static void Multiply(const T _a[4][4], const T _b[4][4],
+                    T _out[4][4])
+        {
+          for (int i = 0; i < 4; ++i)
+          {
+            for (int j = 0; j < 4; ++j)
+            {
+              _out[i][j] = _a[i][0] * _b[0][j] + _a[i][1] * _b[1][j] +
+                           _a[i][2] * _b[2][j] + _a[i][3] * _b[3][j];
+            }
+          }
+        }
+
+        /// \brief Inverse of a matrix, computed from its cofactors.
+        /// \param[in] _m Matrix to invert.
+        /// \param[out] _out Inverse of _m.
+        public: static void Inverse(const T _m[4][4], T _out[4][4])
+        {
+          T v0, v1, v2, v3, v4, v5, t00, t10, t20, t30;
+
+          v0 = _m[2][0]*_m[3][1] -
+            _m[2][1]*_m[3][0];
+          v1 = _m[2][0]*_m[3][2] -
+            _m[2][2]*_m[3][0];
+          v2 = _m[2][0]*_m[3][3] -
+            _m[2][3]*_m[3][0];
+          v3 = _m[2][1]*_m[3][2] -
+            _m[2][2]*_m[3][1];
+          v4 = _m[2][1]*_m[3][3] -
+            _m[2][3]*_m[3][1];
+          v5 = _m[2][2]*_m[3][3] -
+            _m[2][3]*_m[3][2];
+
+          t00 = +(v5*_m[1][1] -
+              v4*_m[1][2] + v3*_m[1][3]);
+          t10 = -(v5*_m[1][0] -
+              v2*_m[1][2] + v1*_m[1][3]);
+          t20 = +(v4*_m[1][0] -
+              v2*_m[1][1] + v0*_m[1][3]);
+          t30 = -(v3*_m[1][0] -
+              v1*_m[1][1] + v0*_m[1][2]);
+
+          T invDet = 1 / (t00 * _m[0][0] + t10 * _m[0][1] +
+              t20 * _m[0][2] + t30 * _m[0][3]);
+
+          _out[0][0] = t00 * invDet;
+          _out[1][0] = t10 * invDet;
+          _out[2][0] = t20 * invDet;
+          _out[3][0] = t30 * invDet;
+
+          _out[0][1] = -(v5*_m[0][1] -
+              v4*_m[0][2] + v3*_m[0][3]) * invDet;
+          _out[1][1] = +(v5*_m[0][0] -
+              v2*_m[0][2] + v1*_m[0][3]) * invDet;
+          _out[2][1] = -(v4*_m[0][0] -
+              v2*_m[0][1] + v0*_m[0][3]) * invDet;
+          _out[3][1] = +(v3*_m[0][0] -
+              v1*_m[0][1] + v0*_m[0][2]) * invDet;
+
+          v0 = _m[1][0]*_m[3][1] -
+            _m[1][1]*_m[3][0];
+          v1 = _m[1][0]*_m[3][2] -
+            _m[1][2]*_m[3][0];
+          v2 = _m[1][0]*_m[3][3] -
+            _m[1][3]*_m[3][0];
+          v3 = _m[1][1]*_m[3][2] -
+            _m[1][2]*_m[3][1];
+          v4 = _m[1][1]*_m[3][3] -
+            _m[1][3]*_m[3][1];
+          v5 = _m[1][2]*_m[3][3] -
+            _m[1][3]*_m[3][2];
+
+          _out[0][2] = +(v5*_m[0][1] -
+              v4*_m[0][2] + v3*_m[0][3]) * invDet;
+          _out[1][2] = -(v5*_m[0][0] -
+              v2*_m[0][2] + v1*_m[0][3]) * invDet;
+          _out[2][2] = +(v4*_m[0][0] -
+              v2*_m[0][1] + v0*_m[0][3]) * invDet;
+          _out[3][2] = -(v3*_m[0][0] -
+              v1*_m[0][1] + v0*_m[0][2]) * invDet;
+
+          v0 = _m[2][1]*_m[1][0] -
+            _m[2][0]*_m[1][1];
+          v1 = _m[2][2]*_m[1][0] -
+            _m[2][0]*_m[1][2];
+          v2 = _m[2][3]*_m[1][0] -
+            _m[2][0]*_m[1][3];
+          v3 = _m[2][2]*_m[1][1] -
+            _m[2][1]*_m[1][2];
+          v4 = _m[2][3]*_m[1][1] -
+            _m[2][1]*_m[1][3];
+          v5 = _m[2][3]*_m[1][2] -
+            _m[2][2]*_m[1][3];
+
+          _out[0][3] = -(v5*_m[0][1] -
+              v4*_m[0][2] + v3*_m[0][3]) * invDet;
+          _out[1][3] = +(v5*_m[0][0] -
+              v2*_m[0][2] + v1*_m[0][3]) * invDet;
+          _out[2][3] = -(v4*_m[0][0] -
+              v2*_m[0][1] + v0*_m[0][3]) * invDet;
+          _out[3][3] = +(v3*_m[0][0] -
+              v1*_m[0][1] + v0*_m[0][2]) * invDet;
+        }
+
+        /// \brief Inverse of an affine matrix. The bottom row of _m is
+        /// assumed to be (0, 0, 0, 1) and is not read. This is Inverse()
+        /// without the terms that are zero for affine matrices, so the
+        /// result compares equal to that of Inverse() for affine matrices.
+        /// Only zeros can differ, by their sign.
+        /// \param[in] _m Affine matrix to invert.
+        /// \param[out] _out Inverse of _m.
+        public: static void InverseAffine(const T _m[4][4], T _out[4][4])
+        {
+          const T t00 = +(_m[2][2]*_m[1][1] - _m[2][1]*_m[1][2]);
+          const T t10 = -(_m[2][2]*_m[1][0] - _m[2][0]*_m[1][2]);
+          const T t20 = +(_m[2][1]*_m[1][0] - _m[2][0]*_m[1][1]);
+
+          const T invDet = 1 / (t00 * _m[0][0] + t10 * _m[0][1] +
+              t20 * _m[0][2]);
+
+          _out[0][0] = t00 * invDet;
+          _out[1][0] = t10 * invDet;
+          _out[2][0] = t20 * invDet;
+
+          _out[0][1] = -(_m[2][2]*_m[0][1] - _m[2][1]*_m[0][2]) * invDet;
+          _out[1][1] = +(_m[2][2]*_m[0][0] - _m[2][0]*_m[0][2]) * invDet;
+          _out[2][1] = -(_m[2][1]*_m[0][0] - _m[2][0]*_m[0][1]) * invDet;
+
+          _out[0][2] = +(_m[1][2]*_m[0][1] - _m[1][1]*_m[0][2]) * invDet;
+          _out[1][2] = -(_m[1][2]*_m[0][0] - _m[1][0]*_m[0][2]) * invDet;
+          _out[2][2] = +(_m[1][1]*_m[0][0] - _m[1][0]*_m[0][1]) * invDet;
+
+          const T v0 = _m[2][1]*_m[1][0] - _m[2][0]*_m[1][1];
+          const T v1 = _m[2][2]*_m[1][0] - _m[2][0]*_m[1][2];
+          const T v2 = _m[2][3]*_m[1][0] - _m[2][0]*_m[1][3];
+          const T v3 = _m[2][2]*_m[1][1] - _m[2][1]*_m[1][2];
+          const T v4 = _m[2][3]*_m[1][1] - _m[2][1]*_m[1][3];
+          const T v5 = _m[2][3]*_m[1][2] - _m[2][2]*_m[1][3];
+
+          _out[0][3] = -(v5*_m[0][1] -
+              v4*_m[0][2] + v3*_m[0][3]) * invDet;
+          _out[1][3] = +(v5*_m[0][0] -
+              v2*_m[0][2] + v1*_m[0][3]) * invDet;
+          _out[2][3] = -(v4*_m[0][0] -
+              v2*_m[0][1] + v0*_m[0][3]) * invDet;
+
+          _out[3][0] = 0;
+          _out[3][1] = 0;
+          _out[3][2] = 0;
+          // Computed like Inverse() does, it can differ from 1 by rounding
+          _out[3][3] = +(v3*_m[0][0] -
+              v1*_m[0][1] + v0*_m[0][2]) * invDet;
+        }
+
+        /// \brief Inverse of a rigid transform, i.e. an affine matrix whose
+        /// upper left 3x3 block is a rotation. The rotation is transposed
+        /// and the translation is rotated back and negated. The bottom row
+        /// of _m is assumed to be (0, 0, 0, 1) and is not read.
+        /// \param[in] _m Rigid transform to invert.
+        /// \param[out] _out Inverse of _m.
+        public: static void InverseRigid(const T _m[4][4], T _out[4][4])
+        {
+          for (int i = 0; i < 3; ++i)
+          {
+            _out[i][0] = _m[0][i];
+            _out[i][1] = _m[1][i];
+            _out[i][2] = _m[2][i];
+            _out[i][3] = -(_m[0][i] * _m[0][3] + _m[1][i] * _m[1][3] +
+                           _m[2][i] * _m[2][3]);
+          }
+          _out[3][0] = 0;
+          _out[3][1] = 0;
+          _out[3][2] = 0;
+          _out[3][3] = 1;
+        }
+
+        /// \brief _out[i] = _m * _in[i], with the convention of
+        /// Matrix4::operator*(const Vector3<T>&): the bottom row of _m is
+        /// ignored.
+        /// \param[in] _m Transformation matrix.
+        /// \param[in] _in Points to transform.
+        /// \param[out] _out Transformed points. It may be the same as _in.
+        /// \param[in] _n Number of points.
+        public: static void TransformPoints(const T _m[4][4],
+                    ConstSoa3<T> _in, Soa3<T> _out, const std::size_t _n)
+        {
+          for (std::size_t i = 0; i < _n; ++i)
+          {
+            const T x = _in.x[i];
+            const T y = _in.y[i];
+            const T z = _in.z[i];
+            _out.x[i] = _m[0][0]*x + _m[0][1]*y + _m[0][2]*z + _m[0][3];
+            _out.y[i] = _m[1][0]*x + _m[1][1]*y + _m[1][2]*z + _m[1][3];
+            _out.z[i] = _m[2][0]*x + _m[2][1]*y + _m[2][2]*z + _m[2][3];
+          }
+        }
+
+        /// \brief _out[i] = _a * _b[i] for a set of matrices, each
+        /// computed with Multiply().
+        /// \param[in] _a Left hand side matrix. It may be one of the
+        /// output matrices.
+        /// \param[in] _b First value of the first right hand side matrix.
+        /// \param[out] _out First value of the first product. It may be
+        /// _b.
+        /// \param[in] _stride Number of values from the first value of a
+        /// matrix of _b or _out to that of the next one.
+        /// \param[in] _n Number of matrices.
+        public: static void MultiplyBatch(const T _a[4][4], const T *_b,
+                    T *_out, const std::size_t _stride, const std::size_t _n)
+        {
+          T a[4][4];
+          std::copy(&_a[0][0], &_a[0][0] + 16, &a[0][0]);
+          for (std::size_t i = 0; i < _n; ++i)
+          {
+            T r[4][4];
+            Multiply(a, reinterpret_cast<const T (*)[4]>(_b + i * _stride),
+                r);
+            std::copy(&r[0][0], &r[0][0] + 16, _out + i * _stride);
+          }
+        }
+
+        /// \brief _out[i] = inverse of _m[i] for a set of matrices, each
+        /// computed with Inverse().
+        /// \param[in] _m First value of the first matrix to invert.
+        /// \param[out] _out First value of the first inverse. It may be
+        /// _m.
+        /// \param[in] _stride Number of values from the first value of a
+        /// matrix of _m or _out to that of the next one.
+        /// \param[in] _n Number of matrices.
+        public: static void InverseBatch(const T *_m, T *_out,
+                    const std::size_t _stride, const std::size_t _n)
+        {
+          for (std::size_t i = 0; i < _n; ++i)
+          {
+            T r[4][4];
+            Inverse(reinterpret_cast<const T (*)[4]>(_m + i * _stride), r);
+            std::copy(&r[0][0], &r[0][0] + 16, _out + i * _stride);
+          }
+        }
+      };
+
+      /// \brief Batch kernels used by Matrix4. This generic version is
+      /// the scalar implementation. The float and double specializations
+      /// are compiled into the library, and select at runtime the SIMD
+      /// implementation that matches the instruction sets supported by the
+      /// CPU. Their results match the scalar implementation up to floating
+      /// point rounding. The functions of Matrix4 that work on a single
+      /// matrix use Matrix4ScalarKernels, which the compiler can inline.
+      template<typename T>
+      class Matrix4Kernels : public Matrix4ScalarKernels<T>
+      {
+      };
+
+      /// \brief Matrix4Kernels specialization for float.
+      template<>
+      class IGNITION_MATH_VISIBLE Matrix4Kernels<float>
+      {
+        public: static void MultiplyBatch(const float _a[4][4],
+                    const float *_b, float *_out, const std::size_t _stride,
+                    const std::size_t _n);
+        public: static void InverseBatch(const float *_m, float *_out,
+                    const std::size_t _stride, const std::size_t _n);
+        public: static void TransformPoints(const float _m[4][4],
+                    ConstSoa3<float> _in, Soa3<float> _out,
+                    const std::size_t _n);
+      };
+
+      /// \brief Matrix4Kernels specialization for double.
+      template<>
+      class IGNITION_MATH_VISIBLE Matrix4Kernels<double>
+      {
+        public: static void MultiplyBatch(const double _a[4][4],
+                    const double *_b, double *_out,
+                    const std::size_t _stride, const std::size_t _n);
+        public: static void InverseBatch(const double *_m, double *_out,
+                    const std::size_t _stride, const std::size_t _n);
+        public: static void TransformPoints(const double _m[4][4],
+                    ConstSoa3<double> _in, Soa3<double> _out,
+                    const std::size_t _n);
+      };
+    }
+
     /// \class Matrix4 Matrix4.hh ignition/math/Matrix4.hh
     /// \brief A 4x4 matrix class
     template<typename T>
@@ -51,10 +349,7 @@ namespace ignition
 
       /// \brief Copy constructor
       /// \param _m Matrix to copy
-      public: Matrix4(const Matrix4<T> &_m)
-      {
-        memcpy(this->data, _m.data, sizeof(this->data[0][0])*16);
-      }
+      public: Matrix4(const Matrix4<T> &_m) = default;
 
       /// \brief Constructor
       /// \param[in] _v00 Row 0, Col 0 value
@@ -116,7 +411,11 @@ namespace ignition
       }
 
       /// \brief Destructor
+#ifdef IGNITION_MATH_POD_TYPES
+      public: ~Matrix4() = default;
+#else
       public: virtual ~Matrix4() {}
+#endif
 
       /// \brief Change the values
       /// \param[in] _v00 Row 0, Col 0 value
@@ -480,92 +779,62 @@ namespace ignition
       /// \return Inverse of this matrix.
       public: Matrix4<T> Inverse() const
       {
-        T v0, v1, v2, v3, v4, v5, t00, t10, t20, t30;
         Matrix4<T> r;
+        detail::Matrix4ScalarKernels<T>::Inverse(this->data, r.data);
+        return r;
+      }
+
+      /// \brief Invert a set of matrices. The float and double versions
+      /// of this function use SIMD instructions selected at runtime, and
+      /// their results match Inverse() up to floating point rounding.
+      /// \param[in] _in Pointer to the first of _count matrices.
+      /// \param[out] _out Pointer to the first of _count inverses. It can
+      /// be equal to _in to invert the matrices in place.
+      /// \param[in] _count Number of matrices.
+      public: static void Inverse(const Matrix4<T> *_in, Matrix4<T> *_out,
+                  const std::size_t _count)
+      {
+        if (_count == 0)
+          return;
+        detail::Matrix4Kernels<T>::InverseBatch(_in[0].data[0],
+            _out[0].data[0], Stride(), _count);
+      }
+
+      /// \brief Invert a set of matrices.
+      /// \param[in] _in Input matrices.
+      /// \param[out] _out Inverses. It is resized to the size of _in, and
+      /// can be the same vector as _in.
+      /// \sa Inverse(const Matrix4<T> *, Matrix4<T> *, const std::size_t)
+      public: static void Inverse(const std::vector<Matrix4<T>> &_in,
+                  std::vector<Matrix4<T>> &_out)
+      {
+        _out.resize(_in.size());
+        Inverse(_in.data(), _out.data(), _in.size());
+      }
 
-        v0 = this->data[2][0]*this->data[3][1] -
-          this->data[2][1]*this->data[3][0];
-        v1 = this->data[2][0]*this->data[3][2] -
-          this->data[2][2]*this->data[3][0];
-        v2 = this->data[2][0]*this->data[3][3] -
-          this->data[2][3]*this->data[3][0];
-        v3 = this->data[2][1]*this->data[3][2] -
-          this->data[2][2]*this->data[3][1];
-        v4 = this->data[2][1]*this->data[3][3] -
-          this->data[2][3]*this->data[3][1];
-        v5 = this->data[2][2]*this->data[3][3] -
-          this->data[2][3]*this->data[3][2];
-
-        t00 = +(v5*this->data[1][1] -
-            v4*this->data[1][2] + v3*this->data[1][3]);
-        t10 = -(v5*this->data[1][0] -
-            v2*this->data[1][2] + v1*this->data[1][3]);
-        t20 = +(v4*this->data[1][0] -
-            v2*this->data[1][1] + v0*this->data[1][3]);
-        t30 = -(v3*this->data[1][0] -
-            v1*this->data[1][1] + v0*this->data[1][2]);
-
-        T invDet = 1 / (t00 * this->data[0][0] + t10 * this->data[0][1] +
-            t20 * this->data[0][2] + t30 * this->data[0][3]);
-
-        r(0, 0) = t00 * invDet;
-        r(1, 0) = t10 * invDet;
-        r(2, 0) = t20 * invDet;
-        r(3, 0) = t30 * invDet;
-
-        r(0, 1) = -(v5*this->data[0][1] -
-            v4*this->data[0][2] + v3*this->data[0][3]) * invDet;
-        r(1, 1) = +(v5*this->data[0][0] -
-            v2*this->data[0][2] + v1*this->data[0][3]) * invDet;
-        r(2, 1) = -(v4*this->data[0][0] -
-            v2*this->data[0][1] + v0*this->data[0][3]) * invDet;
-        r(3, 1) = +(v3*this->data[0][0] -
-            v1*this->data[0][1] + v0*this->data[0][2]) * invDet;
-
-        v0 = this->data[1][0]*this->data[3][1] -
-          this->data[1][1]*this->data[3][0];
-        v1 = this->data[1][0]*this->data[3][2] -
-          this->data[1][2]*this->data[3][0];
-        v2 = this->data[1][0]*this->data[3][3] -
-          this->data[1][3]*this->data[3][0];
-        v3 = this->data[1][1]*this->data[3][2] -
-          this->data[1][2]*this->data[3][1];
-        v4 = this->data[1][1]*this->data[3][3] -
-          this->data[1][3]*this->data[3][1];
-        v5 = this->data[1][2]*this->data[3][3] -
-          this->data[1][3]*this->data[3][2];
-
-        r(0, 2) = +(v5*this->data[0][1] -
-            v4*this->data[0][2] + v3*this->data[0][3]) * invDet;
-        r(1, 2) = -(v5*this->data[0][0] -
-            v2*this->data[0][2] + v1*this->data[0][3]) * invDet;
-        r(2, 2) = +(v4*this->data[0][0] -
-            v2*this->data[0][1] + v0*this->data[0][3]) * invDet;
-        r(3, 2) = -(v3*this->data[0][0] -
-            v1*this->data[0][1] + v0*this->data[0][2]) * invDet;
-
-        v0 = this->data[2][1]*this->data[1][0] -
-          this->data[2][0]*this->data[1][1];
-        v1 = this->data[2][2]*this->data[1][0] -
-          this->data[2][0]*this->data[1][2];
-        v2 = this->data[2][3]*this->data[1][0] -
-          this->data[2][0]*this->data[1][3];
-        v3 = this->data[2][2]*this->data[1][1] -
-          this->data[2][1]*this->data[1][2];
-        v4 = this->data[2][3]*this->data[1][1] -
-          this->data[2][1]*this->data[1][3];
-        v5 = this->data[2][3]*this->data[1][2] -
-          this->data[2][2]*this->data[1][3];
-
-        r(0, 3) = -(v5*this->data[0][1] -
-            v4*this->data[0][2] + v3*this->data[0][3]) * invDet;
-        r(1, 3) = +(v5*this->data[0][0] -
-            v2*this->data[0][2] + v1*this->data[0][3]) * invDet;
-        r(2, 3) = -(v4*this->data[0][0] -
-            v2*this->data[0][1] + v0*this->data[0][3]) * invDet;
-        r(3, 3) = +(v3*this->data[0][0] -
-            v1*this->data[0][1] + v0*this->data[0][2]) * invDet;
+      /// \brief Return the inverse of an affine matrix. The bottom row is
+      /// assumed to be (0, 0, 0, 1) and is not read, and the terms of
+      /// Inverse() that are zero for affine matrices are skipped. When this
+      /// matrix is affine, the result compares equal to that of Inverse().
+      /// \return Inverse of this matrix.
+      /// \sa IsAffine()
+      public: Matrix4<T> InverseAffine() const
+      {
+        Matrix4<T> r;
+        detail::Matrix4ScalarKernels<T>::InverseAffine(this->data, r.data);
+        return r;
+      }
 
+      /// \brief Return the inverse of a rigid transform, such as a matrix
+      /// constructed from a Pose3. The rotation is transposed and the
+      /// translation negated, which is faster than InverseAffine() and
+      /// exact for the rotation. The upper left 3x3 block must be a
+      /// rotation matrix, and the bottom row is assumed to be (0, 0, 0, 1).
+      /// \return Inverse of this matrix.
+      public: Matrix4<T> InverseRigid() const
+      {
+        Matrix4<T> r;
+        detail::Matrix4ScalarKernels<T>::InverseRigid(this->data, r.data);
         return r;
       }
 
@@ -594,11 +863,7 @@ namespace ignition
       /// \brief Equal operator. this = _mat
       /// \param _mat Incoming matrix
       /// \return itself
-      public: Matrix4<T> &operator=(const Matrix4<T> &_mat)
-      {
-        memcpy(this->data, _mat.data, sizeof(this->data[0][0])*16);
-        return *this;
-      }
+      public: Matrix4<T> &operator=(const Matrix4<T> &_mat) = default;
 
       /// \brief Equal operator for 3x3 matrix
       /// \param _mat Incoming matrix
@@ -717,6 +982,37 @@ namespace ignition
           this->data[3][3] * _m2(3, 3));
       }
 
+      /// \brief Multiply this matrix by a set of matrices: _out[i] is
+      /// (*this) * _in[i]. The float and double versions of this function
+      /// use SIMD instructions selected at runtime, and their results
+      /// match operator* up to floating point rounding.
+      /// \param[in] _in Pointer to the first of _count matrices.
+      /// \param[out] _out Pointer to the first of _count products. It can
+      /// be equal to _in to multiply the matrices in place, and can hold
+      /// this matrix.
+      /// \param[in] _count Number of matrices.
+      public: void Multiply(const Matrix4<T> *_in, Matrix4<T> *_out,
+                  const std::size_t _count) const
+      {
+        if (_count == 0)
+          return;
+        detail::Matrix4Kernels<T>::MultiplyBatch(this->data,
+            _in[0].data[0], _out[0].data[0], Stride(), _count);
+      }
+
+      /// \brief Multiply this matrix by a set of matrices.
+      /// \param[in] _in Input matrices.
+      /// \param[out] _out Products. It is resized to the size of _in, and
+      /// can be the same vector as _in.
+      /// \sa Multiply(const Matrix4<T> *, Matrix4<T> *, const std::size_t)
+      /// const
+      public: void Multiply(const std::vector<Matrix4<T>> &_in,
+                  std::vector<Matrix4<T>> &_out) const
+      {
+        _out.resize(_in.size());
+        this->Multiply(_in.data(), _out.data(), _in.size());
+      }
+
       /// \brief Multiplication operator
       /// \param _vec Vector3
       /// \return Resulting vector from multiplication
@@ -731,6 +1027,32 @@ namespace ignition
             this->data[2][2]*_vec.Z() + this->data[2][3]);
       }
 
+      /// \brief Transform a set of points. Each result is equal to
+      /// operator*(const Vector3<T>&) applied to the matching input point.
+      /// \param[in] _in Pointer to the first of _count input points.
+      /// \param[out] _out Pointer to the first of _count output points.
+      /// It can be equal to _in to transform the points in place.
+      /// \param[in] _count Number of points.
+      public: void TransformPoints(const Vector3<T> *_in, Vector3<T> *_out,
+                  const std::size_t _count) const
+      {
+        for (std::size_t i = 0; i < _count; ++i)
+          _out[i] = (*this) * _in[i];
+      }
+
+      /// \brief Transform a set of points.
+      /// \param[in] _in Input points.
+      /// \param[out] _out Transformed points. It is resized to the size of
+      /// _in, and can be the same vector as _in.
+      /// \sa TransformPoints(const Vector3<T> *, Vector3<T> *,
+      /// const std::size_t) const
+      public: void TransformPoints(const std::vector<Vector3<T>> &_in,
+                  std::vector<Vector3<T>> &_out) const
+      {
+        _out.resize(_in.size());
+        this->TransformPoints(_in.data(), _out.data(), _in.size());
+      }
+
       /// \brief Get the value at the specified row, column index
       /// \param[in] _col The column index. Index values are clamped to a
       /// range of [0, 3].
@@ -900,6 +1222,16 @@ namespace ignition
                   0,      0,         0,        1);
       }
 
+      /// \brief Get the number of values from the first value of a matrix
+      /// in an array of matrices to that of the next matrix.
+      /// \return The stride, used by the batch kernels.
+      private: static std::size_t Stride()
+      {
+        static_assert(sizeof(Matrix4<T>) % sizeof(T) == 0,
+            "The size of Matrix4 must be a multiple of that of its values");
+        return sizeof(Matrix4<T>) / sizeof(T);
+      }
+
       /// \brief The 4x4 matrix
       private: T data[4][4];
     };
@@ -921,6 +1253,21 @@ namespace ignition
     typedef Matrix4<int> Matrix4i;
     typedef Matrix4<double> Matrix4d;
     typedef Matrix4<float> Matrix4f;
+
+#ifdef IGNITION_MATH_POD_TYPES
+    static_assert(sizeof(Matrix4d) == 16 * sizeof(double),
+        "Matrix4d must have the memory layout of double[16]");
+    static_assert(std::is_standard_layout<Matrix4d>::value,
+        "Matrix4d must be standard-layout");
+    static_assert(std::is_trivially_copyable<Matrix4d>::value,
+        "Matrix4d must be trivially copyable");
+    static_assert(sizeof(Matrix4f) == 16 * sizeof(float),
+        "Matrix4f must have the memory layout of float[16]");
+    static_assert(std::is_standard_layout<Matrix4f>::value,
+        "Matrix4f must be standard-layout");
+    static_assert(std::is_trivially_copyable<Matrix4f>::value,
+        "Matrix4f must be trivially copyable");
+#endif
     }
   }
 }
@@ -0,0 +1,121 @@
+/*
+ * Copyright (C) 2018 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef IGNITION_MATH_ORIENTEDBOXPACKET_HH_
+#define IGNITION_MATH_ORIENTEDBOXPACKET_HH_
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include <ignition/math/Export.hh>
+#include <ignition/math/OrientedBox.hh>
+#include <ignition/math/config.hh>
+
+namespace ignition
+{
+  namespace math
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace IGNITION_MATH_VERSION_NAMESPACE {
+    //
+    // Forward declare private data
+    class OrientedBoxPacketPrivate;
+
+    /// \class OrientedBoxPacket OrientedBoxPacket.hh
+    /// ignition/math/OrientedBoxPacket.hh
+    /// \brief A set of oriented boxes tested together against another
+    /// oriented box.
+    ///
+    /// The centers, axes and half sizes of the boxes are computed once when
+    /// they are added, and stored as a structure of arrays so that several
+    /// boxes are tested at once with the SIMD instructions selected by
+    /// SimdDispatch. The results are those of OrientedBox::Intersects().
+    /// The materials of the boxes are not stored.
+    class IGNITION_MATH_VISIBLE OrientedBoxPacket
+    {
+      /// \brief Default constructor. The packet is empty.
+      public: OrientedBoxPacket();
+
+      /// \brief Constructor from a set of boxes.
+      /// \param[in] _boxes The boxes.
+      public: explicit OrientedBoxPacket(
+                  const std::vector<OrientedBoxd> &_boxes);
+
+      /// \brief Copy constructor.
+      /// \param[in] _packet Packet to copy.
+      public: OrientedBoxPacket(const OrientedBoxPacket &_packet);
+
+      /// \brief Destructor.
+      public: ~OrientedBoxPacket();
+
+      /// \brief Assignment operator.
+      /// \param[in] _packet Packet to copy.
+      /// \return Reference to this packet.
+      public: OrientedBoxPacket &operator=(const OrientedBoxPacket &_packet);
+
+      /// \brief Get the number of boxes.
+      /// \return Number of boxes.
+      public: std::size_t Size() const;
+
+      /// \brief Check if the packet has no boxes.
+      /// \return True if Size() is zero.
+      public: bool Empty() const;
+
+      /// \brief Remove all the boxes.
+      public: void Clear();
+
+      /// \brief Reserve memory for a number of boxes.
+      /// \param[in] _size Number of boxes.
+      public: void Reserve(const std::size_t _size);
+
+      /// \brief Add a box.
+      /// \param[in] _box The box.
+      public: void PushBack(const OrientedBoxd &_box);
+
+      /// \brief Replace the boxes.
+      /// \param[in] _boxes The boxes.
+      public: void Assign(const std::vector<OrientedBoxd> &_boxes);
+
+      /// \brief Get a box.
+      /// \param[in] _index Index of the box, less than Size().
+      /// \return A copy of the box, with the default material.
+      public: OrientedBoxd operator[](const std::size_t _index) const;
+
+      /// \brief Check which boxes overlap another box.
+      /// \param[in] _box The other box.
+      /// \param[out] _hits Whether each box overlaps _box, as returned by
+      /// OrientedBox::Intersects(). Resized to Size().
+      /// \return Number of boxes that overlap _box.
+      public: std::size_t Intersects(const OrientedBoxd &_box,
+                  std::vector<bool> &_hits) const;
+
+#ifdef _WIN32
+// Disable warning C4251 which is triggered by
+// std::unique_ptr
+#pragma warning(push)
+#pragma warning(disable: 4251)
+#endif
+      /// \brief Private data pointer.
+      private: std::unique_ptr<OrientedBoxPacketPrivate> dataPtr;
+#ifdef _WIN32
+#pragma warning(pop)
+#endif
+    };
+    }
+  }
+}
+#endif
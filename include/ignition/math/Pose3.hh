@@ -17,8 +17,13 @@
 #ifndef IGNITION_MATH_POSE_HH_
 #define IGNITION_MATH_POSE_HH_
 
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+#include <ignition/math/Matrix3.hh>
 #include <ignition/math/Quaternion.hh>
 #include <ignition/math/Vector3.hh>
+#include <ignition/math/Vector3View.hh>
 #include <ignition/math/config.hh>
 
 namespace ignition
@@ -76,15 +81,14 @@ namespace ignition
 
       /// \brief Copy constructor
       /// \param[in] _pose Pose3<T> to copy
-      public: Pose3(const Pose3<T> &_pose)
-      : p(_pose.p), q(_pose.q)
-      {
-      }
+      public: Pose3(const Pose3<T> &_pose) = default;
 
       /// \brief Destructor
-      public: virtual ~Pose3()
-      {
-      }
+#ifdef IGNITION_MATH_POD_TYPES
+      public: ~Pose3() = default;
+#else
+      public: virtual ~Pose3() {}
+#endif
 
       /// \brief Set the pose from a Vector3 and a Quaternion<T>
       /// \param[in] _pos The position.
@@ -223,12 +227,7 @@ namespace ignition
 
       /// \brief Equal operator
       /// \param[in] _pose Pose3<T> to copy
-      public: Pose3<T> &operator=(const Pose3<T> &_pose)
-      {
-        this->p = _pose.p;
-        this->q = _pose.q;
-        return *this;
-      }
+      public: Pose3<T> &operator=(const Pose3<T> &_pose) = default;
 
       /// \brief Add one point to a vector: result = this + pos
       /// \param[in] _pos Position to add to this pose
@@ -275,6 +274,100 @@ namespace ignition
         return Vector3<T>(tmp.X(), tmp.Y(), tmp.Z());
       }
 
+      /// \brief Transform a set of points expressed in the frame of this
+      /// pose to the frame in which this pose is expressed. Each result is
+      /// equal to CoordPositionAdd() applied to the matching input point,
+      /// but the rotation matrix is computed only once for the whole set.
+      /// \param[in] _in Pointer to the first of _count input points.
+      /// \param[out] _out Pointer to the first of _count output points.
+      /// It can be equal to _in to transform the points in place.
+      /// \param[in] _count Number of points.
+      public: void TransformPoints(const Vector3<T> *_in, Vector3<T> *_out,
+                  const std::size_t _count) const
+      {
+        const Matrix3<T> rot(this->q);
+        for (std::size_t i = 0; i < _count; ++i)
+          _out[i] = rot * _in[i] + this->p;
+      }
+
+      /// \brief Transform a set of points expressed in the frame of this
+      /// pose to the frame in which this pose is expressed.
+      /// \param[in] _in Input points.
+      /// \param[out] _out Transformed points. It is resized to the size of
+      /// _in, and can be the same vector as _in.
+      /// \sa TransformPoints(const Vector3<T> *, Vector3<T> *,
+      /// const std::size_t) const
+      public: void TransformPoints(const std::vector<Vector3<T>> &_in,
+                  std::vector<Vector3<T>> &_out) const
+      {
+        _out.resize(_in.size());
+        this->TransformPoints(_in.data(), _out.data(), _in.size());
+      }
+
+      /// \brief Transform a set of points expressed in the frame in which
+      /// this pose is expressed to the frame of this pose. This is the
+      /// inverse of TransformPoints(). The rotation matrix is computed only
+      /// once for the whole set.
+      /// \param[in] _in Pointer to the first of _count input points.
+      /// \param[out] _out Pointer to the first of _count output points.
+      /// It can be equal to _in to transform the points in place.
+      /// \param[in] _count Number of points.
+      public: void InverseTransformPoints(const Vector3<T> *_in,
+                  Vector3<T> *_out, const std::size_t _count) const
+      {
+        const Matrix3<T> rot = Matrix3<T>(this->q).Transposed();
+        for (std::size_t i = 0; i < _count; ++i)
+          _out[i] = rot * (_in[i] - this->p);
+      }
+
+      /// \brief Transform a set of points expressed in the frame in which
+      /// this pose is expressed to the frame of this pose.
+      /// \param[in] _in Input points.
+      /// \param[out] _out Transformed points. It is resized to the size of
+      /// _in, and can be the same vector as _in.
+      /// \sa InverseTransformPoints(const Vector3<T> *, Vector3<T> *,
+      /// const std::size_t) const
+      public: void InverseTransformPoints(const std::vector<Vector3<T>> &_in,
+                  std::vector<Vector3<T>> &_out) const
+      {
+        _out.resize(_in.size());
+        this->InverseTransformPoints(_in.data(), _out.data(), _in.size());
+      }
+
+      /// \brief Transform a set of points, read from an external buffer,
+      /// expressed in the frame of this pose to the frame in which this
+      /// pose is expressed.
+      /// \param[in] _in View of the input points.
+      /// \param[out] _out Transformed points. It is resized to the size of
+      /// _in.
+      /// \sa TransformPoints(const Vector3<T> *, Vector3<T> *,
+      /// const std::size_t) const
+      public: void TransformPoints(const Vector3View<T> &_in,
+                  std::vector<Vector3<T>> &_out) const
+      {
+        const Matrix3<T> rot(this->q);
+        _out.resize(_in.Size());
+        for (std::size_t i = 0; i < _in.Size(); ++i)
+          _out[i] = rot * _in[i] + this->p;
+      }
+
+      /// \brief Transform a set of points, read from an external buffer,
+      /// expressed in the frame in which this pose is expressed to the
+      /// frame of this pose.
+      /// \param[in] _in View of the input points.
+      /// \param[out] _out Transformed points. It is resized to the size of
+      /// _in.
+      /// \sa InverseTransformPoints(const Vector3<T> *, Vector3<T> *,
+      /// const std::size_t) const
+      public: void InverseTransformPoints(const Vector3View<T> &_in,
+                  std::vector<Vector3<T>> &_out) const
+      {
+        const Matrix3<T> rot = Matrix3<T>(this->q).Transposed();
+        _out.resize(_in.Size());
+        for (std::size_t i = 0; i < _in.Size(); ++i)
+          _out[i] = rot * (_in[i] - this->p);
+      }
+
       /// \brief Add one rotation to another: result =  this->q + rot
       /// \param[in] _rot Rotation to add
       /// \return The resulting rotation
@@ -410,6 +503,21 @@ namespace ignition
     typedef Pose3<int> Pose3i;
     typedef Pose3<double> Pose3d;
     typedef Pose3<float> Pose3f;
+
+#ifdef IGNITION_MATH_POD_TYPES
+    static_assert(sizeof(Pose3d) == 7 * sizeof(double),
+        "Pose3d must have the memory layout of double[7]");
+    static_assert(std::is_standard_layout<Pose3d>::value,
+        "Pose3d must be standard-layout");
+    static_assert(std::is_trivially_copyable<Pose3d>::value,
+        "Pose3d must be trivially copyable");
+    static_assert(sizeof(Pose3f) == 7 * sizeof(float),
+        "Pose3f must have the memory layout of float[7]");
+    static_assert(std::is_standard_layout<Pose3f>::value,
+        "Pose3f must be standard-layout");
+    static_assert(std::is_trivially_copyable<Pose3f>::value,
+        "Pose3f must be trivially copyable");
+#endif
     }
   }
 }
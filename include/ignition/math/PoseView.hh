@@ -0,0 +1,157 @@
+/*
+ * Copyright (C) 2018 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef IGNITION_MATH_POSEVIEW_HH_
+#define IGNITION_MATH_POSEVIEW_HH_
+
+#include <cstddef>
+#include <vector>
+
+#include <ignition/math/Matrix3.hh>
+#include <ignition/math/Pose3.hh>
+#include <ignition/math/Vector3View.hh>
+#include <ignition/math/config.hh>
+
+namespace ignition
+{
+  namespace math
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace IGNITION_MATH_VERSION_NAMESPACE {
+    /// \class PoseView PoseView.hh ignition/math/PoseView.hh
+    /// \brief A read-only view of a buffer of poses as a sequence of
+    /// Pose3. The view does not own or copy the buffer, which must outlive
+    /// it.
+    ///
+    /// Each pose is stored as 7 consecutive values x, y, z, qw, qx, qy, qz,
+    /// the order of the arguments of the Pose3 constructor. The distance
+    /// between two consecutive poses is given by a stride, in number of
+    /// values of type T.
+    template<typename T>
+    class PoseView
+    {
+      /// \brief Default constructor. The view is empty.
+      public: PoseView() = default;
+
+      /// \brief Constructor.
+      /// \param[in] _data Pointer to the x value of the first pose.
+      /// \param[in] _size Number of poses.
+      /// \param[in] _stride Number of values of type T between the x
+      /// values of two consecutive poses, at least 7.
+      public: PoseView(const T *_data, const std::size_t _size,
+                  const std::size_t _stride = 7)
+      : data(_data), size(_size), stride(_stride)
+      {
+      }
+
+      /// \brief Get the number of poses.
+      /// \return Number of poses in the view.
+      public: std::size_t Size() const
+      {
+        return this->size;
+      }
+
+      /// \brief Get whether the view is empty.
+      /// \return True if the view contains no poses.
+      public: bool Empty() const
+      {
+        return this->size == 0;
+      }
+
+      /// \brief Get the stride.
+      /// \return Number of values of type T between two consecutive poses.
+      public: std::size_t Stride() const
+      {
+        return this->stride;
+      }
+
+      /// \brief Get the viewed buffer.
+      /// \return Pointer to the x value of the first pose.
+      public: const T *Data() const
+      {
+        return this->data;
+      }
+
+      /// \brief Get a pose. No bounds checking is performed.
+      /// \param[in] _index Index of the pose.
+      /// \return Copy of the pose at _index.
+      public: Pose3<T> operator[](const std::size_t _index) const
+      {
+        const T *v = this->data + _index * this->stride;
+        return Pose3<T>(v[0], v[1], v[2], v[3], v[4], v[5], v[6]);
+      }
+
+      /// \brief Get the position of a pose. No bounds checking is
+      /// performed.
+      /// \param[in] _index Index of the pose.
+      /// \return Position of the pose at _index.
+      public: Vector3<T> Pos(const std::size_t _index) const
+      {
+        const T *v = this->data + _index * this->stride;
+        return Vector3<T>(v[0], v[1], v[2]);
+      }
+
+      /// \brief Get the orientation of a pose. No bounds checking is
+      /// performed.
+      /// \param[in] _index Index of the pose.
+      /// \return Orientation of the pose at _index.
+      public: Quaternion<T> Rot(const std::size_t _index) const
+      {
+        const T *v = this->data + _index * this->stride;
+        return Quaternion<T>(v[3], v[4], v[5], v[6]);
+      }
+
+      /// \brief Get the positions of the poses as a view.
+      /// \return View of the positions.
+      public: Vector3View<T> Positions() const
+      {
+        return Vector3View<T>(this->data, this->size, this->stride);
+      }
+
+      /// \brief Transform the poses, expressed in the frame of a pose, to
+      /// the frame in which that pose is expressed. Each result is equal to
+      /// (*this)[i] + _pose, but the rotation matrix of _pose is computed
+      /// only once for the whole set.
+      /// \param[in] _pose The pose.
+      /// \param[out] _result Transformed poses. It is resized to Size().
+      public: void Transform(const Pose3<T> &_pose,
+                  std::vector<Pose3<T>> &_result) const
+      {
+        const Matrix3<T> rot(_pose.Rot());
+        _result.resize(this->size);
+        for (std::size_t i = 0; i < this->size; ++i)
+        {
+          _result[i].Set(rot * this->Pos(i) + _pose.Pos(),
+              _pose.Rot() * this->Rot(i));
+        }
+      }
+
+      /// \brief Pointer to the x value of the first pose
+      private: const T *data = nullptr;
+
+      /// \brief Number of poses
+      private: std::size_t size = 0;
+
+      /// \brief Distance between two consecutive poses
+      private: std::size_t stride = 7;
+    };
+
+    typedef PoseView<double> PoseViewd;
+    typedef PoseView<float> PoseViewf;
+    }
+  }
+}
+#endif
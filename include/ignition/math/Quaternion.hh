@@ -17,6 +17,7 @@
 #ifndef IGNITION_MATH_QUATERNION_HH_
 #define IGNITION_MATH_QUATERNION_HH_
 
+#include <type_traits>
 #include <ignition/math/Helpers.hh>
 #include <ignition/math/Angle.hh>
 #include <ignition/math/Vector3.hh>
@@ -44,7 +45,7 @@ namespace ignition
       public: static const Quaternion Zero;
 
       /// \brief Default Constructor
-      public: Quaternion()
+      public: constexpr Quaternion()
       : qw(1), qx(0), qy(0), qz(0)
       {
         // quaternion not normalized, because that breaks
@@ -56,7 +57,8 @@ namespace ignition
       /// \param[in] _x X param
       /// \param[in] _y Y param
       /// \param[in] _z Z param
-      public: Quaternion(const T &_w, const T &_x, const T &_y, const T &_z)
+      public: constexpr Quaternion(const T &_w, const T &_x, const T &_y,
+                  const T &_z)
       : qw(_w), qx(_x), qy(_y), qz(_z)
       {}
 
@@ -94,28 +96,14 @@ namespace ignition
 
       /// \brief Copy constructor
       /// \param[in] _qt Quaternion<T> to copy
-      public: Quaternion(const Quaternion<T> &_qt)
-      {
-        this->qw = _qt.qw;
-        this->qx = _qt.qx;
-        this->qy = _qt.qy;
-        this->qz = _qt.qz;
-      }
+      public: Quaternion(const Quaternion<T> &_qt) = default;
 
       /// \brief Destructor
-      public: ~Quaternion() {}
+      public: ~Quaternion() = default;
 
       /// \brief Equal operator
       /// \param[in] _qt Quaternion<T> to copy
-      public: Quaternion<T> &operator=(const Quaternion<T> &_qt)
-      {
-        this->qw = _qt.qw;
-        this->qx = _qt.qx;
-        this->qy = _qt.qy;
-        this->qz = _qt.qz;
-
-        return *this;
-      }
+      public: Quaternion<T> &operator=(const Quaternion<T> &_qt) = default;
 
       /// \brief Invert the quaternion
       public: void Invert()
@@ -288,7 +276,7 @@ namespace ignition
       /// \param[in] _x x
       /// \param[in] _y y
       /// \param[in] _z z
-      public: void Set(T _w, T _x, T _y, T _z)
+      public: constexpr void Set(T _w, T _x, T _y, T _z)
       {
         this->qw = _w;
         this->qx = _x;
@@ -599,7 +587,8 @@ namespace ignition
       /// \brief Addition operator
       /// \param[in] _qt quaternion for addition
       /// \return this quaternion + _qt
-      public: Quaternion<T> operator+(const Quaternion<T> &_qt) const
+      public: constexpr Quaternion<T> operator+(
+                  const Quaternion<T> &_qt) const
       {
         Quaternion<T> result(this->qw + _qt.qw, this->qx + _qt.qx,
                              this->qy + _qt.qy, this->qz + _qt.qz);
@@ -609,7 +598,8 @@ namespace ignition
       /// \brief Addition operator
       /// \param[in] _qt quaternion for addition
       /// \return this quaternion + qt
-      public: Quaternion<T> operator+=(const Quaternion<T> &_qt)
+      public: constexpr Quaternion<T> operator+=(
+                  const Quaternion<T> &_qt)
       {
         *this = *this + _qt;
 
@@ -619,7 +609,8 @@ namespace ignition
       /// \brief Subtraction operator
       /// \param[in] _qt quaternion to subtract
       /// \return this quaternion - _qt
-      public: Quaternion<T> operator-(const Quaternion<T> &_qt) const
+      public: constexpr Quaternion<T> operator-(
+                  const Quaternion<T> &_qt) const
       {
         Quaternion<T> result(this->qw - _qt.qw, this->qx - _qt.qx,
                        this->qy - _qt.qy, this->qz - _qt.qz);
@@ -629,7 +620,8 @@ namespace ignition
       /// \brief Subtraction operator
       /// \param[in] _qt Quaternion<T> for subtraction
       /// \return This quaternion - qt
-      public: Quaternion<T> operator-=(const Quaternion<T> &_qt)
+      public: constexpr Quaternion<T> operator-=(
+                  const Quaternion<T> &_qt)
       {
         *this = *this - _qt;
         return *this;
@@ -638,7 +630,8 @@ namespace ignition
       /// \brief Multiplication operator
       /// \param[in] _q Quaternion<T> for multiplication
       /// \return This quaternion multiplied by the parameter
-      public: inline Quaternion<T> operator*(const Quaternion<T> &_q) const
+      public: constexpr Quaternion<T> operator*(
+                  const Quaternion<T> &_q) const
               {
                 return Quaternion<T>(
                   this->qw*_q.qw-this->qx*_q.qx-this->qy*_q.qy-this->qz*_q.qz,
@@ -650,7 +643,7 @@ namespace ignition
       /// \brief Multiplication operator by a scalar.
       /// \param[in] _f factor
       /// \return quaternion multiplied by the scalar
-      public: Quaternion<T> operator*(const T &_f) const
+      public: constexpr Quaternion<T> operator*(const T &_f) const
       {
         return Quaternion<T>(this->qw*_f, this->qx*_f,
                              this->qy*_f, this->qz*_f);
@@ -659,7 +652,8 @@ namespace ignition
       /// \brief Multiplication operator
       /// \param[in] _qt Quaternion<T> for multiplication
       /// \return This quaternion multiplied by the parameter
-      public: Quaternion<T> operator*=(const Quaternion<T> &qt)
+      public: constexpr Quaternion<T> operator*=(
+                  const Quaternion<T> &qt)
       {
         *this = *this * qt;
         return *this;
@@ -668,7 +662,8 @@ namespace ignition
       /// \brief Vector3 multiplication operator
       /// \param[in] _v vector to multiply
       /// \return The result of the vector multiplication
-      public: Vector3<T> operator*(const Vector3<T> &_v) const
+      public: IGN_MATH_POD_CONSTEXPR Vector3<T> operator*(
+                  const Vector3<T> &_v) const
       {
         Vector3<T> uv, uuv;
         Vector3<T> qvec(this->qx, this->qy, this->qz);
@@ -704,7 +699,7 @@ namespace ignition
 
       /// \brief Unary minus operator
       /// \return negates each component of the quaternion
-      public: Quaternion<T> operator-() const
+      public: constexpr Quaternion<T> operator-() const
       {
         return Quaternion<T>(-this->qw, -this->qx, -this->qy, -this->qz);
       }
@@ -831,7 +826,7 @@ namespace ignition
       /// \brief Dot product
       /// \param[in] _q the other quaternion
       /// \return the product
-      public: T Dot(const Quaternion<T> &_q) const
+      public: constexpr T Dot(const Quaternion<T> &_q) const
       {
         return this->qw*_q.qw + this->qx * _q.qx +
                this->qy*_q.qy + this->qz*_q.qz;
@@ -946,28 +941,28 @@ namespace ignition
 
       /// \brief Get the w component.
       /// \return The w quaternion component.
-      public: inline const T &W() const
+      public: constexpr const T &W() const
       {
         return this->qw;
       }
 
       /// \brief Get the x component.
       /// \return The x quaternion component.
-      public: inline const T &X() const
+      public: constexpr const T &X() const
       {
         return this->qx;
       }
 
       /// \brief Get the y component.
       /// \return The y quaternion component.
-      public: inline const T &Y() const
+      public: constexpr const T &Y() const
       {
         return this->qy;
       }
 
       /// \brief Get the z component.
       /// \return The z quaternion component.
-      public: inline const T &Z() const
+      public: constexpr const T &Z() const
       {
         return this->qz;
       }
@@ -975,56 +970,56 @@ namespace ignition
 
       /// \brief Get a mutable w component.
       /// \return The w quaternion component.
-      public: inline T &W()
+      public: constexpr T &W()
       {
         return this->qw;
       }
 
       /// \brief Get a mutable x component.
       /// \return The x quaternion component.
-      public: inline T &X()
+      public: constexpr T &X()
       {
         return this->qx;
       }
 
       /// \brief Get a mutable y component.
       /// \return The y quaternion component.
-      public: inline T &Y()
+      public: constexpr T &Y()
       {
         return this->qy;
       }
 
       /// \brief Get a mutable z component.
       /// \return The z quaternion component.
-      public: inline T &Z()
+      public: constexpr T &Z()
       {
         return this->qz;
       }
 
       /// \brief Set the x component.
       /// \param[in] _v The new value for the x quaternion component.
-      public: inline void X(T _v)
+      public: constexpr void X(T _v)
       {
         this->qx = _v;
       }
 
       /// \brief Set the y component.
       /// \param[in] _v The new value for the y quaternion component.
-      public: inline void Y(T _v)
+      public: constexpr void Y(T _v)
       {
         this->qy = _v;
       }
 
       /// \brief Set the z component.
       /// \param[in] _v The new value for the z quaternion component.
-      public: inline void Z(T _v)
+      public: constexpr void Z(T _v)
       {
         this->qz = _v;
       }
 
       /// \brief Set the w component.
       /// \param[in] _v The new value for the w quaternion component.
-      public: inline void W(T _v)
+      public: constexpr void W(T _v)
       {
         this->qw = _v;
       }
@@ -1073,14 +1068,29 @@ namespace ignition
       private: T qz;
     };
 
-    template<typename T> const Quaternion<T>
+    template<typename T> constexpr const Quaternion<T>
       Quaternion<T>::Identity(1, 0, 0, 0);
 
-    template<typename T> const Quaternion<T>
+    template<typename T> constexpr const Quaternion<T>
       Quaternion<T>::Zero(0, 0, 0, 0);
 
     typedef Quaternion<double> Quaterniond;
     typedef Quaternion<float> Quaternionf;
+
+#ifdef IGNITION_MATH_POD_TYPES
+    static_assert(sizeof(Quaterniond) == 4 * sizeof(double),
+        "Quaterniond must have the memory layout of double[4]");
+    static_assert(std::is_standard_layout<Quaterniond>::value,
+        "Quaterniond must be standard-layout");
+    static_assert(std::is_trivially_copyable<Quaterniond>::value,
+        "Quaterniond must be trivially copyable");
+    static_assert(sizeof(Quaternionf) == 4 * sizeof(float),
+        "Quaternionf must have the memory layout of float[4]");
+    static_assert(std::is_standard_layout<Quaternionf>::value,
+        "Quaternionf must be standard-layout");
+    static_assert(std::is_trivially_copyable<Quaternionf>::value,
+        "Quaternionf must be trivially copyable");
+#endif
     typedef Quaternion<int> Quaternioni;
     }
   }
@@ -0,0 +1,685 @@
+/*
+ * Copyright (C) 2018 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef IGNITION_MATH_QUATERNIONARRAY_HH_
+#define IGNITION_MATH_QUATERNIONARRAY_HH_
+
+#include <cstddef>
+#include <vector>
+
+#include <ignition/math/Export.hh>
+#include <ignition/math/Quaternion.hh>
+#include <ignition/math/Vector3Array.hh>
+#include <ignition/math/config.hh>
+#include <ignition/math/detail/AlignedAllocator.hh>
+#include <ignition/math/detail/Soa.hh>
+
+namespace ignition
+{
+  namespace math
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace IGNITION_MATH_VERSION_NAMESPACE {
+    namespace detail
+    {
+      /// \brief Batch kernels used by QuaternionArray. This generic version
+      /// calls the scalar Quaternion functions on each element. The float
+      /// and double specializations are compiled into the library and use
+      /// SIMD instructions when they are available.
+      ///
+      /// Output arrays may be the same as input arrays, but must not
+      /// partially overlap them.
+      template<typename T>
+      class QuaternionArrayKernels
+      {
+        /// \brief _out[i] = _a[i] * _b[i]
+        /// \param[in] _a First operand.
+        /// \param[in] _b Second operand.
+        /// \param[out] _out Result.
+        /// \param[in] _n Number of quaternions.
+        public: static void Multiply(ConstSoa4<T> _a, ConstSoa4<T> _b,
+                    Soa4<T> _out, const std::size_t _n)
+        {
+          for (std::size_t i = 0; i < _n; ++i)
+            Store(_out, i, Load(_a, i) * Load(_b, i));
+        }
+
+        /// \brief _out[i] = _a[i] * _q
+        /// \param[in] _a First operand.
+        /// \param[in] _q Second operand, used for every element.
+        /// \param[out] _out Result.
+        /// \param[in] _n Number of quaternions.
+        public: static void Multiply(ConstSoa4<T> _a, const Quaternion<T> &_q,
+                    Soa4<T> _out, const std::size_t _n)
+        {
+          for (std::size_t i = 0; i < _n; ++i)
+            Store(_out, i, Load(_a, i) * _q);
+        }
+
+        /// \brief _out[i] = _a[i].Normalized(). As with
+        /// Quaternion::Normalize(), quaternions with a length equal to zero
+        /// are replaced by the identity.
+        /// \param[in] _a Input quaternions.
+        /// \param[out] _out Result.
+        /// \param[in] _n Number of quaternions.
+        public: static void Normalize(ConstSoa4<T> _a, Soa4<T> _out,
+                    const std::size_t _n)
+        {
+          for (std::size_t i = 0; i < _n; ++i)
+          {
+            Quaternion<T> q = Load(_a, i);
+            q.Normalize();
+            Store(_out, i, q);
+          }
+        }
+
+        /// \brief _out[i] = _q[i].RotateVector(_v[i])
+        /// \param[in] _q Rotations.
+        /// \param[in] _v Vectors to rotate.
+        /// \param[out] _out Rotated vectors.
+        /// \param[in] _n Number of quaternions and vectors.
+        public: static void RotateVector(ConstSoa4<T> _q, ConstSoa3<T> _v,
+                    Soa3<T> _out, const std::size_t _n)
+        {
+          for (std::size_t i = 0; i < _n; ++i)
+          {
+            const Vector3<T> r = Load(_q, i).RotateVector(
+                Vector3<T>(_v.x[i], _v.y[i], _v.z[i]));
+            _out.x[i] = r.X();
+            _out.y[i] = r.Y();
+            _out.z[i] = r.Z();
+          }
+        }
+
+        /// \brief _out[i] = _q[i].RotateVectorReverse(_v[i])
+        /// \param[in] _q Rotations.
+        /// \param[in] _v Vectors to rotate.
+        /// \param[out] _out Rotated vectors.
+        /// \param[in] _n Number of quaternions and vectors.
+        public: static void RotateVectorReverse(ConstSoa4<T> _q,
+                    ConstSoa3<T> _v, Soa3<T> _out, const std::size_t _n)
+        {
+          for (std::size_t i = 0; i < _n; ++i)
+          {
+            const Vector3<T> r = Load(_q, i).RotateVectorReverse(
+                Vector3<T>(_v.x[i], _v.y[i], _v.z[i]));
+            _out.x[i] = r.X();
+            _out.y[i] = r.Y();
+            _out.z[i] = r.Z();
+          }
+        }
+
+        /// \brief Normalized linear interpolation:
+        /// _out[i] = (_a[i] * (1 - t) + _b[i] * t).Normalized(), which is
+        /// the fallback used by Quaternion::Slerp() for nearly equal
+        /// quaternions.
+        /// \param[in] _a Start quaternions.
+        /// \param[in] _b End quaternions.
+        /// \param[in] _t Interpolation parameters, in [0, 1].
+        /// \param[in] _tStride Distance between two consecutive
+        /// interpolation parameters in _t. Use 0 to interpolate every
+        /// element with _t[0].
+        /// \param[in] _shortestPath When true, _b[i] is negated if its dot
+        /// product with _a[i] is negative.
+        /// \param[out] _out Result.
+        /// \param[in] _n Number of quaternions.
+        public: static void Nlerp(ConstSoa4<T> _a, ConstSoa4<T> _b,
+                    const T *_t, const std::size_t _tStride,
+                    const bool _shortestPath, Soa4<T> _out,
+                    const std::size_t _n)
+        {
+          for (std::size_t i = 0; i < _n; ++i)
+          {
+            const T t = _t[i * _tStride];
+            const Quaternion<T> a = Load(_a, i);
+            Quaternion<T> b = Load(_b, i);
+            if (_shortestPath && a.Dot(b) < 0)
+              b = -b;
+            Quaternion<T> q = a * (1 - t) + b * t;
+            q.Normalize();
+            Store(_out, i, q);
+          }
+        }
+
+        /// \brief Spherical linear interpolation:
+        /// _out[i] = Quaternion::Slerp(t, _a[i], _b[i], _shortestPath)
+        /// \param[in] _a Start quaternions.
+        /// \param[in] _b End quaternions.
+        /// \param[in] _t Interpolation parameters, in [0, 1].
+        /// \param[in] _tStride Distance between two consecutive
+        /// interpolation parameters in _t. Use 0 to interpolate every
+        /// element with _t[0].
+        /// \param[in] _shortestPath Passed to Quaternion::Slerp().
+        /// \param[out] _out Result.
+        /// \param[in] _n Number of quaternions.
+        public: static void Slerp(ConstSoa4<T> _a, ConstSoa4<T> _b,
+                    const T *_t, const std::size_t _tStride,
+                    const bool _shortestPath, Soa4<T> _out,
+                    const std::size_t _n)
+        {
+          for (std::size_t i = 0; i < _n; ++i)
+          {
+            Store(_out, i, Quaternion<T>::Slerp(_t[i * _tStride],
+                  Load(_a, i), Load(_b, i), _shortestPath));
+          }
+        }
+
+        /// \brief Read one quaternion.
+        /// \param[in] _a Quaternion arrays.
+        /// \param[in] _i Index of the quaternion.
+        /// \return The quaternion at _i.
+        private: static Quaternion<T> Load(ConstSoa4<T> _a,
+                     const std::size_t _i)
+        {
+          return Quaternion<T>(_a.w[_i], _a.x[_i], _a.y[_i], _a.z[_i]);
+        }
+
+        /// \brief Write one quaternion.
+        /// \param[in] _a Quaternion arrays.
+        /// \param[in] _i Index of the quaternion.
+        /// \param[in] _q Value to write.
+        private: static void Store(Soa4<T> _a, const std::size_t _i,
+                     const Quaternion<T> &_q)
+        {
+          _a.w[_i] = _q.W();
+          _a.x[_i] = _q.X();
+          _a.y[_i] = _q.Y();
+          _a.z[_i] = _q.Z();
+        }
+      };
+
+      /// \brief QuaternionArrayKernels specialization for float,
+      /// implemented in the library with SIMD instructions.
+      template<>
+      class IGNITION_MATH_VISIBLE QuaternionArrayKernels<float>
+      {
+        public: static void Multiply(ConstSoa4<float> _a,
+                    ConstSoa4<float> _b, Soa4<float> _out,
+                    const std::size_t _n);
+        public: static void Multiply(ConstSoa4<float> _a,
+                    const Quaternion<float> &_q, Soa4<float> _out,
+                    const std::size_t _n);
+        public: static void Normalize(ConstSoa4<float> _a,
+                    Soa4<float> _out, const std::size_t _n);
+        public: static void RotateVector(ConstSoa4<float> _q,
+                    ConstSoa3<float> _v, Soa3<float> _out,
+                    const std::size_t _n);
+        public: static void RotateVectorReverse(ConstSoa4<float> _q,
+                    ConstSoa3<float> _v, Soa3<float> _out,
+                    const std::size_t _n);
+        public: static void Nlerp(ConstSoa4<float> _a, ConstSoa4<float> _b,
+                    const float *_t, const std::size_t _tStride,
+                    const bool _shortestPath, Soa4<float> _out,
+                    const std::size_t _n);
+        public: static void Slerp(ConstSoa4<float> _a, ConstSoa4<float> _b,
+                    const float *_t, const std::size_t _tStride,
+                    const bool _shortestPath, Soa4<float> _out,
+                    const std::size_t _n);
+      };
+
+      /// \brief QuaternionArrayKernels specialization for double,
+      /// implemented in the library with SIMD instructions.
+      template<>
+      class IGNITION_MATH_VISIBLE QuaternionArrayKernels<double>
+      {
+        public: static void Multiply(ConstSoa4<double> _a,
+                    ConstSoa4<double> _b, Soa4<double> _out,
+                    const std::size_t _n);
+        public: static void Multiply(ConstSoa4<double> _a,
+                    const Quaternion<double> &_q, Soa4<double> _out,
+                    const std::size_t _n);
+        public: static void Normalize(ConstSoa4<double> _a,
+                    Soa4<double> _out, const std::size_t _n);
+        public: static void RotateVector(ConstSoa4<double> _q,
+                    ConstSoa3<double> _v, Soa3<double> _out,
+                    const std::size_t _n);
+        public: static void RotateVectorReverse(ConstSoa4<double> _q,
+                    ConstSoa3<double> _v, Soa3<double> _out,
+                    const std::size_t _n);
+        public: static void Nlerp(ConstSoa4<double> _a,
+                    ConstSoa4<double> _b, const double *_t,
+                    const std::size_t _tStride, const bool _shortestPath,
+                    Soa4<double> _out, const std::size_t _n);
+        public: static void Slerp(ConstSoa4<double> _a,
+                    ConstSoa4<double> _b, const double *_t,
+                    const std::size_t _tStride, const bool _shortestPath,
+                    Soa4<double> _out, const std::size_t _n);
+      };
+    }
+
+    /// \class QuaternionArray QuaternionArray.hh
+    /// ignition/math/QuaternionArray.hh
+    /// \brief A set of quaternions stored as a structure of arrays: the w,
+    /// x, y and z values are kept in four separate, aligned arrays. This
+    /// layout allows the batch functions of this class to process many
+    /// orientations at once with SIMD instructions.
+    ///
+    /// The batch functions are equivalent to calling the matching
+    /// Quaternion function on each element. For float and double they are
+    /// evaluated with a different sequence of operations, so results are
+    /// not bit-identical to the scalar ones. For unit quaternions and
+    /// interpolation parameters in [0, 1], every component of the result
+    /// is within 1e-12 (double) or 1e-5 (float) of the scalar result.
+    /// Slerp() evaluates sine and arc tangent with polynomials instead of
+    /// the standard library; this is included in the bound above.
+    ///
+    /// The bound does not hold for Slerp() and Nlerp() of nearly opposite
+    /// quaternions (dot product below -0.99) when _shortestPath is false.
+    /// Quaternion::Slerp() switches to a linear interpolation that is
+    /// ill-conditioned there, so neither result is reliable.
+    template<typename T>
+    class QuaternionArray
+    {
+      /// \brief Type of the aligned storage of each component
+      public: typedef std::vector<T, detail::AlignedAllocator<T>> Storage;
+
+      /// \brief Default constructor. The array is empty.
+      public: QuaternionArray() = default;
+
+      /// \brief Constructor.
+      /// \param[in] _size Number of quaternions, all initialized to the
+      /// identity.
+      public: explicit QuaternionArray(const std::size_t _size)
+      : ws(_size, static_cast<T>(1)), xs(_size), ys(_size), zs(_size)
+      {
+      }
+
+      /// \brief Construct from an array of Quaternion.
+      /// \param[in] _quats Quaternions to copy.
+      public: explicit QuaternionArray(
+                  const std::vector<Quaternion<T>> &_quats)
+      {
+        this->Assign(_quats);
+      }
+
+      /// \brief Get the number of quaternions.
+      /// \return Number of quaternions in the array.
+      public: std::size_t Size() const
+      {
+        return this->ws.size();
+      }
+
+      /// \brief Get whether the array is empty.
+      /// \return True if the array contains no quaternions.
+      public: bool Empty() const
+      {
+        return this->ws.empty();
+      }
+
+      /// \brief Resize the array. New quaternions are initialized to the
+      /// identity.
+      /// \param[in] _size New number of quaternions.
+      public: void Resize(const std::size_t _size)
+      {
+        this->ws.resize(_size, static_cast<T>(1));
+        this->xs.resize(_size);
+        this->ys.resize(_size);
+        this->zs.resize(_size);
+      }
+
+      /// \brief Reserve storage for a number of quaternions.
+      /// \param[in] _size Number of quaternions to reserve storage for.
+      public: void Reserve(const std::size_t _size)
+      {
+        this->ws.reserve(_size);
+        this->xs.reserve(_size);
+        this->ys.reserve(_size);
+        this->zs.reserve(_size);
+      }
+
+      /// \brief Remove all quaternions.
+      public: void Clear()
+      {
+        this->ws.clear();
+        this->xs.clear();
+        this->ys.clear();
+        this->zs.clear();
+      }
+
+      /// \brief Append a quaternion to the end of the array.
+      /// \param[in] _q Quaternion to append.
+      public: void PushBack(const Quaternion<T> &_q)
+      {
+        this->ws.push_back(_q.W());
+        this->xs.push_back(_q.X());
+        this->ys.push_back(_q.Y());
+        this->zs.push_back(_q.Z());
+      }
+
+      /// \brief Get a quaternion. No bounds checking is performed.
+      /// \param[in] _index Index of the quaternion.
+      /// \return Copy of the quaternion at _index.
+      public: Quaternion<T> operator[](const std::size_t _index) const
+      {
+        return Quaternion<T>(this->ws[_index], this->xs[_index],
+                             this->ys[_index], this->zs[_index]);
+      }
+
+      /// \brief Set a quaternion. No bounds checking is performed.
+      /// \param[in] _index Index of the quaternion.
+      /// \param[in] _q New value of the quaternion.
+      public: void Set(const std::size_t _index, const Quaternion<T> &_q)
+      {
+        this->ws[_index] = _q.W();
+        this->xs[_index] = _q.X();
+        this->ys[_index] = _q.Y();
+        this->zs[_index] = _q.Z();
+      }
+
+      /// \brief Replace the content of this array by a copy of an array
+      /// of Quaternion.
+      /// \param[in] _quats Quaternions to copy.
+      public: void Assign(const std::vector<Quaternion<T>> &_quats)
+      {
+        this->Resize(_quats.size());
+        for (std::size_t i = 0; i < _quats.size(); ++i)
+          this->Set(i, _quats[i]);
+      }
+
+      /// \brief Copy the content of this array to an array of Quaternion.
+      /// \param[out] _quats Destination array. It is resized to Size().
+      public: void ToVector(std::vector<Quaternion<T>> &_quats) const
+      {
+        _quats.resize(this->Size());
+        for (std::size_t i = 0; i < _quats.size(); ++i)
+          _quats[i].Set(this->ws[i], this->xs[i], this->ys[i], this->zs[i]);
+      }
+
+      /// \brief Copy the content of this array to an array of Quaternion.
+      /// \return Array of Quaternion with the same content as this array.
+      public: std::vector<Quaternion<T>> ToVector() const
+      {
+        std::vector<Quaternion<T>> result;
+        this->ToVector(result);
+        return result;
+      }
+
+      /// \brief Get the array of w values.
+      /// \return Pointer to Size() w values, aligned for SIMD access.
+      public: const T *W() const
+      {
+        return this->ws.data();
+      }
+
+      /// \brief Get the array of x values.
+      /// \return Pointer to Size() x values, aligned for SIMD access.
+      public: const T *X() const
+      {
+        return this->xs.data();
+      }
+
+      /// \brief Get the array of y values.
+      /// \return Pointer to Size() y values, aligned for SIMD access.
+      public: const T *Y() const
+      {
+        return this->ys.data();
+      }
+
+      /// \brief Get the array of z values.
+      /// \return Pointer to Size() z values, aligned for SIMD access.
+      public: const T *Z() const
+      {
+        return this->zs.data();
+      }
+
+      /// \brief Get a mutable array of w values.
+      /// \return Pointer to Size() w values, aligned for SIMD access.
+      public: T *W()
+      {
+        return this->ws.data();
+      }
+
+      /// \brief Get a mutable array of x values.
+      /// \return Pointer to Size() x values, aligned for SIMD access.
+      public: T *X()
+      {
+        return this->xs.data();
+      }
+
+      /// \brief Get a mutable array of y values.
+      /// \return Pointer to Size() y values, aligned for SIMD access.
+      public: T *Y()
+      {
+        return this->ys.data();
+      }
+
+      /// \brief Get a mutable array of z values.
+      /// \return Pointer to Size() z values, aligned for SIMD access.
+      public: T *Z()
+      {
+        return this->zs.data();
+      }
+
+      /// \brief Multiply each element by the matching element of another
+      /// array: _result[i] = (*this)[i] * _other[i].
+      /// \param[in] _other Right hand side operands. It must have the same
+      /// size as this array.
+      /// \param[out] _result Products. It is resized to Size(), and may be
+      /// this array or _other.
+      /// \return False if the sizes of the arrays differ.
+      public: bool Multiply(const QuaternionArray<T> &_other,
+                            QuaternionArray<T> &_result) const
+      {
+        if (_other.Size() != this->Size())
+          return false;
+
+        _result.Resize(this->Size());
+        detail::QuaternionArrayKernels<T>::Multiply(
+            this->Data(), _other.Data(), _result.Data(), this->Size());
+        return true;
+      }
+
+      /// \brief Multiply each element by a quaternion:
+      /// _result[i] = (*this)[i] * _q.
+      /// \param[in] _q Right hand side operand.
+      /// \param[out] _result Products. It is resized to Size(), and may be
+      /// this array.
+      public: void Multiply(const Quaternion<T> &_q,
+                            QuaternionArray<T> &_result) const
+      {
+        _result.Resize(this->Size());
+        detail::QuaternionArrayKernels<T>::Multiply(
+            this->Data(), _q, _result.Data(), this->Size());
+      }
+
+      /// \brief Normalize each element. As with Quaternion::Normalize(),
+      /// elements with a length of zero are set to the identity.
+      public: void Normalize()
+      {
+        detail::QuaternionArrayKernels<T>::Normalize(
+            this->Data(), this->Data(), this->Size());
+      }
+
+      /// \brief Rotate each vector of an array by the matching element of
+      /// this array, as Quaternion::RotateVector() does.
+      /// \param[in] _vec Vectors to rotate. It must have the same size as
+      /// this array.
+      /// \param[out] _result Rotated vectors. It is resized to Size(), and
+      /// may be _vec.
+      /// \return False if the sizes of the arrays differ.
+      public: bool RotateVector(const Vector3Array<T> &_vec,
+                                Vector3Array<T> &_result) const
+      {
+        if (_vec.Size() != this->Size())
+          return false;
+
+        _result.Resize(this->Size());
+        detail::QuaternionArrayKernels<T>::RotateVector(
+            this->Data(), _vec.Data(), _result.Data(), this->Size());
+        return true;
+      }
+
+      /// \brief Rotate each vector of an array by the inverse of the
+      /// matching element of this array, as
+      /// Quaternion::RotateVectorReverse() does.
+      /// \param[in] _vec Vectors to rotate. It must have the same size as
+      /// this array.
+      /// \param[out] _result Rotated vectors. It is resized to Size(), and
+      /// may be _vec.
+      /// \return False if the sizes of the arrays differ.
+      public: bool RotateVectorReverse(const Vector3Array<T> &_vec,
+                                       Vector3Array<T> &_result) const
+      {
+        if (_vec.Size() != this->Size())
+          return false;
+
+        _result.Resize(this->Size());
+        detail::QuaternionArrayKernels<T>::RotateVectorReverse(
+            this->Data(), _vec.Data(), _result.Data(), this->Size());
+        return true;
+      }
+
+      /// \brief Normalized linear interpolation between each element and
+      /// the matching element of another array. This is cheaper than
+      /// Slerp(), but does not interpolate at constant angular velocity.
+      /// \param[in] _other End quaternions. It must have the same size as
+      /// this array.
+      /// \param[in] _t Interpolation parameter in [0, 1], used for every
+      /// element.
+      /// \param[out] _result Interpolated quaternions. It is resized to
+      /// Size(), and may be this array or _other.
+      /// \param[in] _shortestPath When true, interpolate along the shortest
+      /// path, as Quaternion::Slerp() does.
+      /// \return False if the sizes of the arrays differ.
+      public: bool Nlerp(const QuaternionArray<T> &_other, const T _t,
+                         QuaternionArray<T> &_result,
+                         const bool _shortestPath = false) const
+      {
+        if (_other.Size() != this->Size())
+          return false;
+
+        _result.Resize(this->Size());
+        detail::QuaternionArrayKernels<T>::Nlerp(this->Data(),
+            _other.Data(), &_t, 0, _shortestPath, _result.Data(),
+            this->Size());
+        return true;
+      }
+
+      /// \brief Normalized linear interpolation between each element and
+      /// the matching element of another array, with one interpolation
+      /// parameter per element.
+      /// \param[in] _other End quaternions. It must have the same size as
+      /// this array.
+      /// \param[in] _t Interpolation parameters in [0, 1]. It must have the
+      /// same size as this array.
+      /// \param[out] _result Interpolated quaternions. It is resized to
+      /// Size(), and may be this array or _other.
+      /// \param[in] _shortestPath When true, interpolate along the shortest
+      /// path, as Quaternion::Slerp() does.
+      /// \return False if the sizes of the arrays differ.
+      public: bool Nlerp(const QuaternionArray<T> &_other,
+                         const std::vector<T> &_t,
+                         QuaternionArray<T> &_result,
+                         const bool _shortestPath = false) const
+      {
+        if (_other.Size() != this->Size() || _t.size() != this->Size())
+          return false;
+
+        _result.Resize(this->Size());
+        detail::QuaternionArrayKernels<T>::Nlerp(this->Data(),
+            _other.Data(), _t.data(), 1, _shortestPath, _result.Data(),
+            this->Size());
+        return true;
+      }
+
+      /// \brief Spherical linear interpolation between each element and
+      /// the matching element of another array, as Quaternion::Slerp()
+      /// does.
+      /// \param[in] _other End quaternions. It must have the same size as
+      /// this array.
+      /// \param[in] _t Interpolation parameter in [0, 1], used for every
+      /// element.
+      /// \param[out] _result Interpolated quaternions. It is resized to
+      /// Size(), and may be this array or _other.
+      /// \param[in] _shortestPath When true, interpolate along the shortest
+      /// path.
+      /// \return False if the sizes of the arrays differ.
+      public: bool Slerp(const QuaternionArray<T> &_other, const T _t,
+                         QuaternionArray<T> &_result,
+                         const bool _shortestPath = false) const
+      {
+        if (_other.Size() != this->Size())
+          return false;
+
+        _result.Resize(this->Size());
+        detail::QuaternionArrayKernels<T>::Slerp(this->Data(),
+            _other.Data(), &_t, 0, _shortestPath, _result.Data(),
+            this->Size());
+        return true;
+      }
+
+      /// \brief Spherical linear interpolation between each element and
+      /// the matching element of another array, with one interpolation
+      /// parameter per element.
+      /// \param[in] _other End quaternions. It must have the same size as
+      /// this array.
+      /// \param[in] _t Interpolation parameters in [0, 1]. It must have the
+      /// same size as this array.
+      /// \param[out] _result Interpolated quaternions. It is resized to
+      /// Size(), and may be this array or _other.
+      /// \param[in] _shortestPath When true, interpolate along the shortest
+      /// path.
+      /// \return False if the sizes of the arrays differ.
+      public: bool Slerp(const QuaternionArray<T> &_other,
+                         const std::vector<T> &_t,
+                         QuaternionArray<T> &_result,
+                         const bool _shortestPath = false) const
+      {
+        if (_other.Size() != this->Size() || _t.size() != this->Size())
+          return false;
+
+        _result.Resize(this->Size());
+        detail::QuaternionArrayKernels<T>::Slerp(this->Data(),
+            _other.Data(), _t.data(), 1, _shortestPath, _result.Data(),
+            this->Size());
+        return true;
+      }
+
+      /// \brief Get read-only pointers to the component arrays.
+      /// \return The component arrays.
+      public: detail::ConstSoa4<T> Data() const
+      {
+        return {this->ws.data(), this->xs.data(), this->ys.data(),
+                this->zs.data()};
+      }
+
+      /// \brief Get mutable pointers to the component arrays.
+      /// \return The component arrays.
+      public: detail::Soa4<T> Data()
+      {
+        return {this->ws.data(), this->xs.data(), this->ys.data(),
+                this->zs.data()};
+      }
+
+      /// \brief The w values
+      private: Storage ws;
+
+      /// \brief The x values
+      private: Storage xs;
+
+      /// \brief The y values
+      private: Storage ys;
+
+      /// \brief The z values
+      private: Storage zs;
+    };
+
+    typedef QuaternionArray<double> QuaternionArrayd;
+    typedef QuaternionArray<float> QuaternionArrayf;
+    }
+  }
+}
+#endif
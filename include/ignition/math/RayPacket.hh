@@ -0,0 +1,164 @@
+/*
+ * Copyright (C) 2018 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef IGNITION_MATH_RAYPACKET_HH_
+#define IGNITION_MATH_RAYPACKET_HH_
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include <ignition/math/AxisAlignedBox.hh>
+#include <ignition/math/Export.hh>
+#include <ignition/math/Vector3.hh>
+#include <ignition/math/config.hh>
+
+namespace ignition
+{
+  namespace math
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace IGNITION_MATH_VERSION_NAMESPACE {
+    //
+    // Forward declare private data
+    class RayPacketPrivate;
+
+    /// \class RayPacket RayPacket.hh ignition/math/RayPacket.hh
+    /// \brief A set of rays tested together against axis aligned boxes,
+    /// such as the rays of one sweep of a range sensor.
+    ///
+    /// The rays are described as in AxisAlignedBox::Intersect(
+    /// const Vector3d &, const Vector3d &, const double, const double)
+    /// const. Their inverse directions are computed once when they are
+    /// added, and they are stored as a structure of arrays so that
+    /// several rays are tested at once with the SIMD instructions
+    /// selected by SimdDispatch. The results are those of
+    /// AxisAlignedBox::IntersectDist(), up to rounding.
+    ///
+    /// Rays with a zero direction are not supported.
+    class IGNITION_MATH_VISIBLE RayPacket
+    {
+      /// \brief Default constructor. The packet is empty.
+      public: RayPacket();
+
+      /// \brief Constructor from rays sharing the same distance range.
+      /// \param[in] _origins Origins of the rays.
+      /// \param[in] _dirs Directions of the rays, normalized here. Must
+      /// have the same size as _origins.
+      /// \param[in] _min Minimum allowed distance.
+      /// \param[in] _max Maximum allowed distance.
+      public: RayPacket(const std::vector<Vector3d> &_origins,
+                  const std::vector<Vector3d> &_dirs, const double _min,
+                  const double _max);
+
+      /// \brief Copy constructor.
+      /// \param[in] _packet Packet to copy.
+      public: RayPacket(const RayPacket &_packet);
+
+      /// \brief Destructor.
+      public: ~RayPacket();
+
+      /// \brief Assignment operator.
+      /// \param[in] _packet Packet to copy.
+      /// \return Reference to this packet.
+      public: RayPacket &operator=(const RayPacket &_packet);
+
+      /// \brief Get the number of rays.
+      /// \return Number of rays.
+      public: std::size_t Size() const;
+
+      /// \brief Check if the packet has no rays.
+      /// \return True if Size() is zero.
+      public: bool Empty() const;
+
+      /// \brief Remove all the rays.
+      public: void Clear();
+
+      /// \brief Reserve memory for a number of rays.
+      /// \param[in] _size Number of rays.
+      public: void Reserve(const std::size_t _size);
+
+      /// \brief Add a ray.
+      /// \param[in] _origin Origin of the ray.
+      /// \param[in] _dir Direction of the ray, normalized here.
+      /// \param[in] _min Minimum allowed distance.
+      /// \param[in] _max Maximum allowed distance.
+      public: void PushBack(const Vector3d &_origin, const Vector3d &_dir,
+                  const double _min, const double _max);
+
+      /// \brief Replace the rays.
+      /// \param[in] _origins Origins of the rays.
+      /// \param[in] _dirs Directions of the rays, normalized here.
+      /// \param[in] _min Minimum allowed distance.
+      /// \param[in] _max Maximum allowed distance.
+      /// \return False if _origins and _dirs have different sizes, in
+      /// which case the packet is not changed.
+      public: bool Assign(const std::vector<Vector3d> &_origins,
+                  const std::vector<Vector3d> &_dirs, const double _min,
+                  const double _max);
+
+      /// \brief Get the start of a ray, which is its origin moved by the
+      /// minimum distance along its direction.
+      /// \param[in] _index Index of the ray, less than Size().
+      /// \return Start of the ray.
+      public: Vector3d Start(const std::size_t _index) const;
+
+      /// \brief Get the normalized direction of a ray.
+      /// \param[in] _index Index of the ray, less than Size().
+      /// \return Direction of the ray.
+      public: Vector3d Direction(const std::size_t _index) const;
+
+      /// \brief Get the length of a ray, which is its maximum minus its
+      /// minimum distance.
+      /// \param[in] _index Index of the ray, less than Size().
+      /// \return Length of the ray.
+      public: double Length(const std::size_t _index) const;
+
+      /// \brief Intersect all the rays with a box.
+      /// \param[in] _box The box.
+      /// \param[out] _hits Whether each ray hits the box. Resized to
+      /// Size().
+      /// \param[out] _dists Distance from the start of each ray to the
+      /// box, as returned by AxisAlignedBox::IntersectDist(). It is zero
+      /// for the rays that miss the box. Resized to Size().
+      /// \return Number of rays that hit the box.
+      public: std::size_t Intersect(const AxisAlignedBox &_box,
+                  std::vector<bool> &_hits, std::vector<double> &_dists) const;
+
+      /// \brief Check which rays hit a box.
+      /// \param[in] _box The box.
+      /// \param[out] _hits Whether each ray hits the box. Resized to
+      /// Size().
+      /// \return Number of rays that hit the box.
+      public: std::size_t IntersectCheck(const AxisAlignedBox &_box,
+                  std::vector<bool> &_hits) const;
+
+#ifdef _WIN32
+// Disable warning C4251 which is triggered by
+// std::unique_ptr
+#pragma warning(push)
+#pragma warning(disable: 4251)
+#endif
+      /// \brief Private data pointer.
+      private: std::unique_ptr<RayPacketPrivate> dataPtr;
+#ifdef _WIN32
+#pragma warning(pop)
+#endif
+    };
+    }
+  }
+}
+#endif
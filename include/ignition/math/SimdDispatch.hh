@@ -0,0 +1,90 @@
+/*
+ * Copyright (C) 2018 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef IGNITION_MATH_SIMDDISPATCH_HH_
+#define IGNITION_MATH_SIMDDISPATCH_HH_
+
+#include <string>
+
+#include <ignition/math/Export.hh>
+#include <ignition/math/config.hh>
+
+namespace ignition
+{
+  namespace math
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace IGNITION_MATH_VERSION_NAMESPACE {
+    /// \enum SimdLevel
+    /// \brief Instruction sets used by the batch functions of the library,
+    /// such as those of Vector3Array, QuaternionArray and Matrix4. Each
+    /// level also uses the instructions of the lower levels.
+    enum class SimdLevel
+    {
+      /// \brief Portable C++ code
+      SCALAR = 0,
+
+      /// \brief SSE2
+      SSE2 = 1,
+
+      /// \brief SSE4.1 and SSE4.2
+      SSE4_2 = 2,
+
+      /// \brief AVX2 and FMA
+      AVX2 = 3,
+
+      /// \brief AVX-512F
+      AVX512 = 4
+    };
+
+    /// \class SimdDispatch SimdDispatch.hh ignition/math/SimdDispatch.hh
+    /// \brief Selection of the instruction set used by the batch functions.
+    ///
+    /// The batch kernels are compiled for several instruction sets, and
+    /// the highest level supported by the CPU is selected the first time
+    /// a batch function is used. Setting the IGN_MATH_SIMD_LEVEL
+    /// environment variable to "scalar", "sse2", "sse4.2", "avx2" or
+    /// "avx512" selects a lower level instead, which is useful to test or
+    /// compare the kernels.
+    class IGNITION_MATH_VISIBLE SimdDispatch
+    {
+      /// \brief Get the highest level supported by both the CPU and the
+      /// build of the library.
+      /// \return The highest supported level.
+      public: static SimdLevel SupportedLevel();
+
+      /// \brief Get the level used by the batch functions.
+      /// \return The active level.
+      public: static SimdLevel ActiveLevel();
+
+      /// \brief Change the level used by the batch functions. This can be
+      /// called at any time, batch functions that are running in other
+      /// threads finish with the previous level.
+      /// \param[in] _level New level.
+      /// \return False if _level is higher than SupportedLevel(), in which
+      /// case the active level is not changed.
+      public: static bool SetActiveLevel(const SimdLevel _level);
+
+      /// \brief Get the name of a level, as used by the
+      /// IGN_MATH_SIMD_LEVEL environment variable.
+      /// \param[in] _level The level.
+      /// \return Name of the level, such as "avx2".
+      public: static std::string LevelName(const SimdLevel _level);
+    };
+    }
+  }
+}
+#endif
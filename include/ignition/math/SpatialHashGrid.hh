@@ -0,0 +1,174 @@
+/*
+ * Copyright (C) 2018 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef IGNITION_MATH_SPATIALHASHGRID_HH_
+#define IGNITION_MATH_SPATIALHASHGRID_HH_
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include <ignition/math/Export.hh>
+#include <ignition/math/Vector3.hh>
+#include <ignition/math/Vector3View.hh>
+#include <ignition/math/config.hh>
+
+namespace ignition
+{
+  namespace math
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace IGNITION_MATH_VERSION_NAMESPACE {
+    //
+    // Forward declare private data
+    class SpatialHashGridPrivate;
+
+    /// \class SpatialHashGrid SpatialHashGrid.hh
+    /// ignition/math/SpatialHashGrid.hh
+    /// \brief A uniform grid over a set of points, used to find the points
+    /// within a radius or the nearest points of a position without testing
+    /// every point.
+    ///
+    /// The space is divided into cubic cells, and the cells are hashed
+    /// into a table with about one bucket per point, so that the memory
+    /// used does not depend on the extent of the points. The points are
+    /// stored sorted by bucket in a single array, and each bucket is a
+    /// range of this array: building the grid is a counting sort and
+    /// needs no allocation per cell. Queries return the index of the
+    /// points in the vector given to Build(). Points at a NaN distance
+    /// from the query position, such as points with a NaN coordinate, are
+    /// never returned, and points at an infinite distance come after all
+    /// the others, like in KdTree.
+    ///
+    /// The queries are fastest when the cell size is close to the radius
+    /// of the radius queries, or to the distance of the k-th nearest
+    /// point for the nearest point queries.
+    class IGNITION_MATH_VISIBLE SpatialHashGrid
+    {
+      /// \brief Default constructor. The grid is empty and its cell size
+      /// is 1.
+      public: SpatialHashGrid();
+
+      /// \brief Constructor that sets the cell size.
+      /// \param[in] _cellSize Size of the cells. A cell size of 1 is used
+      /// if it is not a positive finite number.
+      public: explicit SpatialHashGrid(const double _cellSize);
+
+      /// \brief Constructor that builds the grid of a set of points.
+      /// \param[in] _points The points.
+      /// \param[in] _cellSize Size of the cells. A cell size of 1 is used
+      /// if it is not a positive finite number.
+      public: SpatialHashGrid(const std::vector<Vector3d> &_points,
+                  const double _cellSize);
+
+      /// \brief Copy constructor.
+      /// \param[in] _grid Grid to copy.
+      public: SpatialHashGrid(const SpatialHashGrid &_grid);
+
+      /// \brief Destructor.
+      public: ~SpatialHashGrid();
+
+      /// \brief Assignment operator.
+      /// \param[in] _grid Grid to copy.
+      /// \return Reference to this grid.
+      public: SpatialHashGrid &operator=(const SpatialHashGrid &_grid);
+
+      /// \brief Get the size of the cells.
+      /// \return The cell size.
+      public: double CellSize() const;
+
+      /// \brief Set the size of the cells, and rebuild the grid with the
+      /// current points.
+      /// \param[in] _cellSize Size of the cells.
+      /// \return False if _cellSize is not a positive finite number, in
+      /// which case the grid is not changed.
+      public: bool SetCellSize(const double _cellSize);
+
+      /// \brief Build the grid of a set of points, replacing the previous
+      /// content.
+      /// \param[in] _points The points.
+      public: void Build(const std::vector<Vector3d> &_points);
+
+      /// \brief Build the grid of a set of points stored in an external
+      /// buffer, replacing the previous content. The points are copied.
+      /// \param[in] _points View of the points.
+      public: void Build(const Vector3View<double> &_points);
+
+      /// \brief Move the points of the grid. This is faster than Build()
+      /// when few points change cells: the memory is reused, and the
+      /// points are only sorted again if at least one of them changed
+      /// bucket. If the number of points differs from Size(), the grid is
+      /// built again.
+      /// \param[in] _points New positions of the points, in the order
+      /// given to Build().
+      /// \return Number of points that changed bucket.
+      public: std::size_t Update(const std::vector<Vector3d> &_points);
+
+      /// \brief Move the points of the grid, with positions stored in an
+      /// external buffer.
+      /// \param[in] _points View of the new positions of the points.
+      /// \return Number of points that changed bucket.
+      /// \sa Update(const std::vector<Vector3d> &)
+      public: std::size_t Update(const Vector3View<double> &_points);
+
+      /// \brief Get the number of points.
+      /// \return Number of points.
+      public: std::size_t Size() const;
+
+      /// \brief Get the position of a point.
+      /// \param[in] _index Index of the point, in the order given to
+      /// Build().
+      /// \return The position of the point, or Vector3d::Zero if _index is
+      /// out of range.
+      public: Vector3d Point(const std::size_t _index) const;
+
+      /// \brief Find all the points within a distance of a position.
+      /// \param[in] _center The position.
+      /// \param[in] _radius Maximum distance, inclusive.
+      /// \param[out] _indices Indices of the points, in no particular
+      /// order. The vector is cleared first.
+      /// \return True if at least one point is within _radius.
+      public: bool InRadius(const Vector3d &_center, const double _radius,
+                  std::vector<std::size_t> &_indices) const;
+
+      /// \brief Find the points closest to a position.
+      /// \param[in] _point The position.
+      /// \param[in] _k Number of points to find.
+      /// \param[out] _indices Indices of the min(_k, Size()) closest
+      /// points, sorted by increasing distance. Points at the same distance
+      /// are sorted by index. The points at a NaN distance are skipped.
+      /// The vector is cleared first.
+      /// \return True if at least one point was found, false if the grid
+      /// is empty, _k is zero or _point has a NaN coordinate.
+      public: bool Nearest(const Vector3d &_point, const std::size_t _k,
+                  std::vector<std::size_t> &_indices) const;
+
+#ifdef _WIN32
+// Disable warning C4251 which is triggered by
+// std::unique_ptr
+#pragma warning(push)
+#pragma warning(disable: 4251)
+#endif
+      /// \brief Private data pointer.
+      private: std::unique_ptr<SpatialHashGridPrivate> dataPtr;
+#ifdef _WIN32
+#pragma warning(pop)
+#endif
+    };
+    }
+  }
+}
+#endif
@@ -0,0 +1,169 @@
+/*
+ * Copyright (C) 2018 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef IGNITION_MATH_SWEEPANDPRUNE_HH_
+#define IGNITION_MATH_SWEEPANDPRUNE_HH_
+
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include <ignition/math/AxisAlignedBox.hh>
+#include <ignition/math/Export.hh>
+#include <ignition/math/config.hh>
+
+namespace ignition
+{
+  namespace math
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace IGNITION_MATH_VERSION_NAMESPACE {
+    //
+    // Forward declare private data
+    class SweepAndPrunePrivate;
+
+    /// \class SweepAndPrune SweepAndPrune.hh ignition/math/SweepAndPrune.hh
+    /// \brief Sweep and prune over a set of axis aligned boxes that move,
+    /// used as the broadphase of a simulation to find the pairs of boxes
+    /// that intersect, as defined by AxisAlignedBox::Intersects().
+    ///
+    /// The minimum and maximum of each box along an axis are kept in an
+    /// array of endpoints sorted by insertion sort, which only does a few
+    /// swaps when the boxes move a little between two calls to
+    /// UpdatePairs(). This makes the cost predictable when the motion is
+    /// coherent, but large moves are slower than with DynamicBvh.
+    ///
+    /// With one axis, the pairs are found by sweeping the sorted endpoints
+    /// and testing the boxes that overlap along the axis. With three axes,
+    /// each swap of a minimum and a maximum endpoint is the only event
+    /// that can change whether two boxes intersect, so only these pairs
+    /// are tested. This is faster when many boxes overlap along every
+    /// single axis, such as boxes resting on a floor, at the cost of three
+    /// sorted arrays.
+    ///
+    /// Boxes are identified by the id returned by Insert(), which may be
+    /// reused after Remove() and UpdatePairs().
+    class IGNITION_MATH_VISIBLE SweepAndPrune
+    {
+      /// \brief Constructor.
+      /// \param[in] _multiAxis True to sort the endpoints along the three
+      /// axes, false to sort them along one axis.
+      public: explicit SweepAndPrune(const bool _multiAxis = false);
+
+      /// \brief Copy constructor.
+      /// \param[in] _sap Object to copy.
+      public: SweepAndPrune(const SweepAndPrune &_sap);
+
+      /// \brief Destructor.
+      public: ~SweepAndPrune();
+
+      /// \brief Assignment operator.
+      /// \param[in] _sap Object to copy.
+      /// \return Reference to this object.
+      public: SweepAndPrune &operator=(const SweepAndPrune &_sap);
+
+      /// \brief Check if the endpoints are sorted along the three axes.
+      /// \return True in multi-axis mode.
+      public: bool MultiAxis() const;
+
+      /// \brief Get the axis along which the endpoints are sorted in
+      /// single axis mode.
+      /// \return 0, 1 or 2 for x, y or z.
+      public: int SortAxis() const;
+
+      /// \brief Set the axis along which the endpoints are sorted in
+      /// single axis mode. The best axis is the one along which the boxes
+      /// overlap the least, such as the direction of a conveyor. The
+      /// endpoints are sorted again by the next call to UpdatePairs().
+      /// \param[in] _axis 0, 1 or 2 for x, y or z.
+      /// \return False if _axis is not a valid axis.
+      public: bool SetSortAxis(const int _axis);
+
+      /// \brief Add a box. Empty boxes, such as default constructed ones,
+      /// are stored but never paired.
+      /// \param[in] _box The box.
+      /// \return Id of the box.
+      public: std::size_t Insert(const AxisAlignedBox &_box);
+
+      /// \brief Remove a box. Its pairs are reported as removed by the
+      /// next call to UpdatePairs(), and its id is reused after that.
+      /// \param[in] _id Id of the box.
+      /// \return False if _id is not the id of a box.
+      public: bool Remove(const std::size_t _id);
+
+      /// \brief Move or resize a box. The endpoints are sorted by the
+      /// next call to UpdatePairs().
+      /// \param[in] _id Id of the box.
+      /// \param[in] _box New value of the box.
+      /// \return False if _id is not the id of a box.
+      public: bool Update(const std::size_t _id, const AxisAlignedBox &_box);
+
+      /// \brief Sort the endpoints and find the pairs of boxes that
+      /// started or stopped intersecting since the previous call.
+      /// \param[out] _added Pairs of ids of the boxes that started
+      /// intersecting, the smallest id first, sorted. The vector is
+      /// cleared first.
+      /// \param[out] _removed Pairs of ids of the boxes that stopped
+      /// intersecting or were removed, the smallest id first, sorted. The
+      /// vector is cleared first.
+      /// \return True if at least one pair was added or removed.
+      public: bool UpdatePairs(
+                  std::vector<std::pair<std::size_t, std::size_t>> &_added,
+                  std::vector<std::pair<std::size_t, std::size_t>> &_removed);
+
+      /// \brief Get the pairs of boxes that intersect, as of the last
+      /// call to UpdatePairs().
+      /// \param[out] _pairs Pairs of ids, the smallest id first, sorted.
+      /// The vector is cleared first.
+      public: void Pairs(
+                  std::vector<std::pair<std::size_t, std::size_t>> &_pairs)
+                  const;
+
+      /// \brief Remove all the boxes and pairs, without reporting them.
+      public: void Clear();
+
+      /// \brief Get the number of boxes.
+      /// \return Number of boxes.
+      public: std::size_t Size() const;
+
+      /// \brief Check if an id is the id of a box.
+      /// \param[in] _id Id to check.
+      /// \return True if there is a box with this id.
+      public: bool Has(const std::size_t _id) const;
+
+      /// \brief Get a box.
+      /// \param[in] _id Id of the box.
+      /// \return The box, a default constructed box if _id is not the id
+      /// of a box.
+      public: AxisAlignedBox Box(const std::size_t _id) const;
+
+#ifdef _WIN32
+// Disable warning C4251 which is triggered by
+// std::unique_ptr
+#pragma warning(push)
+#pragma warning(disable: 4251)
+#endif
+      /// \brief Private data pointer.
+      private: std::unique_ptr<SweepAndPrunePrivate> dataPtr;
+#ifdef _WIN32
+#pragma warning(pop)
+#endif
+    };
+    }
+  }
+}
+#endif
@@ -0,0 +1,179 @@
+/*
+ * Copyright (C) 2018 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef IGNITION_MATH_TRIANGLEMESH_HH_
+#define IGNITION_MATH_TRIANGLEMESH_HH_
+
+#include <cstddef>
+#include <memory>
+#include <tuple>
+#include <vector>
+
+#include <ignition/math/AxisAlignedBox.hh>
+#include <ignition/math/Export.hh>
+#include <ignition/math/RayPacket.hh>
+#include <ignition/math/Triangle3.hh>
+#include <ignition/math/Vector3.hh>
+#include <ignition/math/config.hh>
+
+namespace ignition
+{
+  namespace math
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace IGNITION_MATH_VERSION_NAMESPACE {
+    //
+    // Forward declare private data
+    class TriangleMeshPrivate;
+
+    /// \class TriangleMesh TriangleMesh.hh ignition/math/TriangleMesh.hh
+    /// \brief An indexed triangle mesh prepared for ray casting, such as
+    /// the collision mesh of a model seen by a range sensor.
+    ///
+    /// The triangles are sorted into a bounding volume hierarchy when the
+    /// mesh is built, as in Bvh. The triangles of each leaf are tested
+    /// together with the SIMD instructions selected by SimdDispatch,
+    /// using a watertight test: a ray that crosses an edge or a vertex
+    /// shared by several triangles hits at least one of them.
+    ///
+    /// The rays are described as in AxisAlignedBox::Intersect(
+    /// const Vector3d &, const Vector3d &, const double, const double)
+    /// const, and the distances are measured from _origin + _min * _dir.
+    class IGNITION_MATH_VISIBLE TriangleMesh
+    {
+      /// \brief Default constructor. The mesh is empty.
+      public: TriangleMesh();
+
+      /// \brief Constructor from vertices and triangle indices.
+      /// \param[in] _vertices Vertices of the mesh.
+      /// \param[in] _indices Indices in _vertices of the corners of the
+      /// triangles, three per triangle.
+      /// \sa Build(const std::vector<Vector3d> &,
+      /// const std::vector<unsigned int> &)
+      public: TriangleMesh(const std::vector<Vector3d> &_vertices,
+                  const std::vector<unsigned int> &_indices);
+
+      /// \brief Constructor from triangles.
+      /// \param[in] _triangles The triangles.
+      public: explicit TriangleMesh(const std::vector<Triangle3d> &_triangles);
+
+      /// \brief Copy constructor.
+      /// \param[in] _mesh Mesh to copy.
+      public: TriangleMesh(const TriangleMesh &_mesh);
+
+      /// \brief Destructor.
+      public: ~TriangleMesh();
+
+      /// \brief Assignment operator.
+      /// \param[in] _mesh Mesh to copy.
+      /// \return Reference to this mesh.
+      public: TriangleMesh &operator=(const TriangleMesh &_mesh);
+
+      /// \brief Build the mesh from vertices and triangle indices,
+      /// replacing the previous content.
+      /// \param[in] _vertices Vertices of the mesh.
+      /// \param[in] _indices Indices in _vertices of the corners of the
+      /// triangles, three per triangle.
+      /// \return False if the size of _indices is not a multiple of three
+      /// or if an index is out of range, in which case the mesh is empty.
+      public: bool Build(const std::vector<Vector3d> &_vertices,
+                  const std::vector<unsigned int> &_indices);
+
+      /// \brief Build the mesh from triangles, replacing the previous
+      /// content.
+      /// \param[in] _triangles The triangles.
+      public: void Build(const std::vector<Triangle3d> &_triangles);
+
+      /// \brief Get the number of triangles.
+      /// \return Number of triangles.
+      public: std::size_t TriangleCount() const;
+
+      /// \brief Get a triangle.
+      /// \param[in] _index Index of the triangle, less than
+      /// TriangleCount().
+      /// \return The triangle.
+      public: Triangle3d Triangle(const std::size_t _index) const;
+
+      /// \brief Get the box that contains all the triangles.
+      /// \return The bounding box, a default constructed box if the mesh
+      /// is empty.
+      public: AxisAlignedBox Bounds() const;
+
+      /// \brief Find the triangle closest to the origin of a ray.
+      /// \param[in] _origin Origin of the ray.
+      /// \param[in] _dir Direction of the ray. This ray will be normalized.
+      /// \param[in] _min Minimum allowed distance.
+      /// \param[in] _max Maximum allowed distance.
+      /// \return A boolean, double, std::size_t tuple. The boolean value is
+      /// true if the ray hits a triangle. The double is the distance from
+      /// _origin + _min * _dir to the closest hit, and the std::size_t is
+      /// the index of the closest triangle. The double and std::size_t
+      /// values are zero when the boolean value is false.
+      public: std::tuple<bool, double, std::size_t> Intersect(
+                  const Vector3d &_origin, const Vector3d &_dir,
+                  const double _min, const double _max) const;
+
+      /// \brief Check if a ray hits any triangle, such as for line of
+      /// sight checks. This is faster than Intersect() since the search
+      /// stops at the first hit.
+      /// \param[in] _origin Origin of the ray.
+      /// \param[in] _dir Direction of the ray. This ray will be normalized.
+      /// \param[in] _min Minimum allowed distance.
+      /// \param[in] _max Maximum allowed distance.
+      /// \return True if the ray hits at least one triangle.
+      public: bool IntersectCheck(const Vector3d &_origin,
+                  const Vector3d &_dir, const double _min,
+                  const double _max) const;
+
+      /// \brief Find the closest triangle hit by each ray of a packet.
+      /// \param[in] _rays The rays.
+      /// \param[out] _hits Whether each ray hits a triangle. Resized to
+      /// the size of _rays.
+      /// \param[out] _dists Distance from the start of each ray to the
+      /// closest hit, zero for the rays that miss the mesh. Resized to the
+      /// size of _rays.
+      /// \param[out] _triangles Index of the closest triangle hit by each
+      /// ray, zero for the rays that miss the mesh. Resized to the size of
+      /// _rays.
+      /// \return Number of rays that hit the mesh.
+      public: std::size_t Intersect(const RayPacket &_rays,
+                  std::vector<bool> &_hits, std::vector<double> &_dists,
+                  std::vector<std::size_t> &_triangles) const;
+
+      /// \brief Check which rays of a packet hit the mesh.
+      /// \param[in] _rays The rays.
+      /// \param[out] _hits Whether each ray hits a triangle. Resized to
+      /// the size of _rays.
+      /// \return Number of rays that hit the mesh.
+      public: std::size_t IntersectCheck(const RayPacket &_rays,
+                  std::vector<bool> &_hits) const;
+
+#ifdef _WIN32
+// Disable warning C4251 which is triggered by
+// std::unique_ptr
+#pragma warning(push)
+#pragma warning(disable: 4251)
+#endif
+      /// \brief Private data pointer.
+      private: std::unique_ptr<TriangleMeshPrivate> dataPtr;
+#ifdef _WIN32
+#pragma warning(pop)
+#endif
+    };
+    }
+  }
+}
+#endif
@@ -17,6 +17,7 @@
 #ifndef IGNITION_MATH_VECTOR2_HH_
 #define IGNITION_MATH_VECTOR2_HH_
 
+#include <type_traits>
 #include <ignition/math/Helpers.hh>
 #include <ignition/math/config.hh>
 
@@ -39,31 +40,29 @@ namespace ignition
       public: static const Vector2<T> One;
 
       /// \brief Default Constructor
-      public: Vector2()
+      public: constexpr Vector2()
+      : data{0, 0}
       {
-        this->data[0] = 0;
-        this->data[1] = 0;
       }
 
       /// \brief Constructor
       /// \param[in] _x value along x
       /// \param[in] _y value along y
-      public: Vector2(const T &_x, const T &_y)
+      public: constexpr Vector2(const T &_x, const T &_y)
+      : data{_x, _y}
       {
-        this->data[0] = _x;
-        this->data[1] = _y;
       }
 
       /// \brief Copy constructor
       /// \param[in] _v the value
-      public: Vector2(const Vector2<T> &_v)
-      {
-        this->data[0] = _v[0];
-        this->data[1] = _v[1];
-      }
+      public: Vector2(const Vector2<T> &_v) = default;
 
       /// \brief Destructor
+#ifdef IGNITION_MATH_POD_TYPES
+      public: ~Vector2() = default;
+#else
       public: virtual ~Vector2() {}
+#endif
 
       /// \brief Calc distance to the given point
       /// \param[in] _pt The point to measure to
@@ -104,7 +103,7 @@ namespace ignition
       /// \brief Set the contents of the vector
       /// \param[in] _x value along x
       /// \param[in] _y value along y
-      public: void Set(T _x, T _y)
+      public: constexpr void Set(T _x, T _y)
       {
         this->data[0] = _x;
         this->data[1] = _y;
@@ -113,7 +112,7 @@ namespace ignition
       /// \brief Get the dot product of this vector and _v
       /// \param[in] _v the vector
       /// \return The dot product
-      public: T Dot(const Vector2<T> &_v) const
+      public: constexpr T Dot(const Vector2<T> &_v) const
       {
         return (this->data[0] * _v[0]) + (this->data[1] * _v[1]);
       }
@@ -121,18 +120,12 @@ namespace ignition
       /// \brief Assignment operator
       /// \param[in] _v a value for x and y element
       /// \return this
-      public: Vector2 &operator=(const Vector2 &_v)
-      {
-        this->data[0] = _v[0];
-        this->data[1] = _v[1];
-
-        return *this;
-      }
+      public: Vector2 &operator=(const Vector2 &_v) = default;
 
       /// \brief Assignment operator
       /// \param[in] _v the value for x and y element
       /// \return this
-      public: const Vector2 &operator=(T _v)
+      public: constexpr const Vector2 &operator=(T _v)
       {
         this->data[0] = _v;
         this->data[1] = _v;
@@ -143,7 +136,7 @@ namespace ignition
       /// \brief Addition operator
       /// \param[in] _v vector to add
       /// \return sum vector
-      public: Vector2 operator+(const Vector2 &_v) const
+      public: IGN_MATH_POD_CONSTEXPR Vector2 operator+(const Vector2 &_v) const
       {
         return Vector2(this->data[0] + _v[0], this->data[1] + _v[1]);
       }
@@ -151,7 +144,7 @@ namespace ignition
       /// \brief Addition assignment operator
       /// \param[in] _v the vector to add
       // \return this
-      public: const Vector2 &operator+=(const Vector2 &_v)
+      public: constexpr const Vector2 &operator+=(const Vector2 &_v)
       {
         this->data[0] += _v[0];
         this->data[1] += _v[1];
@@ -162,7 +155,7 @@ namespace ignition
       /// \brief Addition operators
       /// \param[in] _s the scalar addend
       /// \return sum vector
-      public: inline Vector2<T> operator+(const T _s) const
+      public: IGN_MATH_POD_CONSTEXPR Vector2<T> operator+(const T _s) const
       {
         return Vector2<T>(this->data[0] + _s,
                           this->data[1] + _s);
@@ -172,8 +165,8 @@ namespace ignition
       /// \param[in] _s the scalar addend
       /// \param[in] _v input vector
       /// \return sum vector
-      public: friend inline Vector2<T> operator+(const T _s,
-                                                 const Vector2<T> &_v)
+      public: friend IGN_MATH_POD_CONSTEXPR Vector2<T> operator+(
+                  const T _s, const Vector2<T> &_v)
       {
         return _v + _s;
       }
@@ -181,7 +174,7 @@ namespace ignition
       /// \brief Addition assignment operator
       /// \param[in] _s scalar addend
       /// \return this
-      public: const Vector2<T> &operator+=(const T _s)
+      public: constexpr const Vector2<T> &operator+=(const T _s)
       {
         this->data[0] += _s;
         this->data[1] += _s;
@@ -191,7 +184,7 @@ namespace ignition
 
       /// \brief Negation operator
       /// \return negative of this vector
-      public: inline Vector2 operator-() const
+      public: IGN_MATH_POD_CONSTEXPR Vector2 operator-() const
       {
         return Vector2(-this->data[0], -this->data[1]);
       }
@@ -199,7 +192,7 @@ namespace ignition
       /// \brief Subtraction operator
       /// \param[in] _v the vector to substract
       /// \return the subtracted vector
-      public: Vector2 operator-(const Vector2 &_v) const
+      public: IGN_MATH_POD_CONSTEXPR Vector2 operator-(const Vector2 &_v) const
       {
         return Vector2(this->data[0] - _v[0], this->data[1] - _v[1]);
       }
@@ -207,7 +200,7 @@ namespace ignition
       /// \brief Subtraction assignment operator
       /// \param[in] _v the vector to substract
       /// \return this
-      public: const Vector2 &operator-=(const Vector2 &_v)
+      public: constexpr const Vector2 &operator-=(const Vector2 &_v)
       {
         this->data[0] -= _v[0];
         this->data[1] -= _v[1];
@@ -218,7 +211,7 @@ namespace ignition
       /// \brief Subtraction operators
       /// \param[in] _s the scalar subtrahend
       /// \return difference vector
-      public: inline Vector2<T> operator-(const T _s) const
+      public: IGN_MATH_POD_CONSTEXPR Vector2<T> operator-(const T _s) const
       {
         return Vector2<T>(this->data[0] - _s,
                           this->data[1] - _s);
@@ -228,8 +221,8 @@ namespace ignition
       /// \param[in] _s the scalar minuend
       /// \param[in] _v vector subtrahend
       /// \return difference vector
-      public: friend inline Vector2<T> operator-(const T _s,
-                                                 const Vector2<T> &_v)
+      public: friend IGN_MATH_POD_CONSTEXPR Vector2<T> operator-(
+                  const T _s, const Vector2<T> &_v)
       {
         return {_s - _v.X(), _s - _v.Y()};
       }
@@ -237,7 +230,7 @@ namespace ignition
       /// \brief Subtraction assignment operator
       /// \param[in] _s scalar subtrahend
       /// \return this
-      public: const Vector2<T> &operator-=(T _s)
+      public: constexpr const Vector2<T> &operator-=(T _s)
       {
         this->data[0] -= _s;
         this->data[1] -= _s;
@@ -249,7 +242,8 @@ namespace ignition
       /// \remarks this is an element wise division
       /// \param[in] _v a vector
       /// \result a result
-      public: const Vector2 operator/(const Vector2 &_v) const
+      public: IGN_MATH_POD_CONSTEXPR const Vector2 operator/(
+                  const Vector2 &_v) const
       {
         return Vector2(this->data[0] / _v[0], this->data[1] / _v[1]);
       }
@@ -258,7 +252,7 @@ namespace ignition
       /// \remarks this is an element wise division
       /// \param[in] _v a vector
       /// \return this
-      public: const Vector2 &operator/=(const Vector2 &_v)
+      public: constexpr const Vector2 &operator/=(const Vector2 &_v)
       {
         this->data[0] /= _v[0];
         this->data[1] /= _v[1];
@@ -269,7 +263,7 @@ namespace ignition
       /// \brief Division operator
       /// \param[in] _v the value
       /// \return a vector
-      public: const Vector2 operator/(T _v) const
+      public: IGN_MATH_POD_CONSTEXPR const Vector2 operator/(T _v) const
       {
         return Vector2(this->data[0] / _v, this->data[1] / _v);
       }
@@ -277,7 +271,7 @@ namespace ignition
       /// \brief Division operator
       /// \param[in] _v the divisor
       /// \return a vector
-      public: const Vector2 &operator/=(T _v)
+      public: constexpr const Vector2 &operator/=(T _v)
       {
         this->data[0] /= _v;
         this->data[1] /= _v;
@@ -288,7 +282,8 @@ namespace ignition
       /// \brief Multiplication operators
       /// \param[in] _v the vector
       /// \return the result
-      public: const Vector2 operator*(const Vector2 &_v) const
+      public: IGN_MATH_POD_CONSTEXPR const Vector2 operator*(
+                  const Vector2 &_v) const
       {
         return Vector2(this->data[0] * _v[0], this->data[1] * _v[1]);
       }
@@ -297,7 +292,7 @@ namespace ignition
       /// \remarks this is an element wise multiplication
       /// \param[in] _v the vector
       /// \return this
-      public: const Vector2 &operator*=(const Vector2 &_v)
+      public: constexpr const Vector2 &operator*=(const Vector2 &_v)
       {
         this->data[0] *= _v[0];
         this->data[1] *= _v[1];
@@ -308,7 +303,7 @@ namespace ignition
       /// \brief Multiplication operators
       /// \param[in] _v the scaling factor
       /// \return a scaled vector
-      public: const Vector2 operator*(T _v) const
+      public: IGN_MATH_POD_CONSTEXPR const Vector2 operator*(T _v) const
       {
         return Vector2(this->data[0] * _v, this->data[1] * _v);
       }
@@ -317,8 +312,8 @@ namespace ignition
       /// \param[in] _s the scaling factor
       /// \param[in] _v the vector to scale
       /// \return a scaled vector
-      public: friend inline const Vector2 operator*(const T _s,
-                                                    const Vector2 &_v)
+      public: friend IGN_MATH_POD_CONSTEXPR const Vector2 operator*(
+                  const T _s, const Vector2 &_v)
       {
         return Vector2(_v * _s);
       }
@@ -326,7 +321,7 @@ namespace ignition
       /// \brief Multiplication assignment operator
       /// \param[in] _v the scaling factor
       /// \return a scaled vector
-      public: const Vector2 &operator*=(T _v)
+      public: constexpr const Vector2 &operator*=(T _v)
       {
         this->data[0] *= _v;
         this->data[1] *= _v;
@@ -374,7 +369,7 @@ namespace ignition
       /// \brief Array subscript operator
       /// \param[in] _index The index, where 0 == x and 1 == y.
       /// The index is clamped to the range [0,1].
-      public: T &operator[](const std::size_t _index)
+      public: constexpr T &operator[](const std::size_t _index)
       {
         return this->data[clamp(_index, IGN_ZERO_SIZE_T, IGN_ONE_SIZE_T)];
       }
@@ -382,49 +377,49 @@ namespace ignition
       /// \brief Const-qualified array subscript operator
       /// \param[in] _index The index, where 0 == x and 1 == y.
       /// The index is clamped to the range [0,1].
-      public: T operator[](const std::size_t _index) const
+      public: constexpr T operator[](const std::size_t _index) const
       {
         return this->data[clamp(_index, IGN_ZERO_SIZE_T, IGN_ONE_SIZE_T)];
       }
 
       /// \brief Return the x value.
       /// \return Value of the X component.
-      public: inline T X() const
+      public: constexpr T X() const
       {
         return this->data[0];
       }
 
       /// \brief Return the y value.
       /// \return Value of the Y component.
-      public: inline T Y() const
+      public: constexpr T Y() const
       {
         return this->data[1];
       }
 
       /// \brief Return a mutable x value.
       /// \return Value of the X component.
-      public: inline T &X()
+      public: constexpr T &X()
       {
         return this->data[0];
       }
 
       /// \brief Return a mutable y value.
       /// \return Value of the Y component.
-      public: inline T &Y()
+      public: constexpr T &Y()
       {
         return this->data[1];
       }
 
       /// \brief Set the x value.
       /// \param[in] _v Value for the x component.
-      public: inline void X(const T &_v)
+      public: constexpr void X(const T &_v)
       {
         this->data[0] = _v;
       }
 
       /// \brief Set the y value.
       /// \param[in] _v Value for the y component.
-      public: inline void Y(const T &_v)
+      public: constexpr void Y(const T &_v)
       {
         this->data[1] = _v;
       }
@@ -444,7 +439,7 @@ namespace ignition
       /// \param[in] _pt Vector to compare.
       /// \return True if this vector's first or second value is less than
       /// the given vector's first or second value.
-      public: bool operator<(const Vector2<T> &_pt) const
+      public: constexpr bool operator<(const Vector2<T> &_pt) const
       {
         return this->data[0] < _pt[0] || this->data[1] < _pt[1];
       }
@@ -469,14 +464,29 @@ namespace ignition
     };
 
     template<typename T>
-    const Vector2<T> Vector2<T>::Zero(0, 0);
+    IGN_MATH_POD_CONSTEXPR const Vector2<T> Vector2<T>::Zero(0, 0);
 
     template<typename T>
-    const Vector2<T> Vector2<T>::One(1, 1);
+    IGN_MATH_POD_CONSTEXPR const Vector2<T> Vector2<T>::One(1, 1);
 
     typedef Vector2<int> Vector2i;
     typedef Vector2<double> Vector2d;
     typedef Vector2<float> Vector2f;
+
+#ifdef IGNITION_MATH_POD_TYPES
+    static_assert(sizeof(Vector2d) == 2 * sizeof(double),
+        "Vector2d must have the memory layout of double[2]");
+    static_assert(std::is_standard_layout<Vector2d>::value,
+        "Vector2d must be standard-layout");
+    static_assert(std::is_trivially_copyable<Vector2d>::value,
+        "Vector2d must be trivially copyable");
+    static_assert(sizeof(Vector2f) == 2 * sizeof(float),
+        "Vector2f must have the memory layout of float[2]");
+    static_assert(std::is_standard_layout<Vector2f>::value,
+        "Vector2f must be standard-layout");
+    static_assert(std::is_trivially_copyable<Vector2f>::value,
+        "Vector2f must be trivially copyable");
+#endif
     }
   }
 }
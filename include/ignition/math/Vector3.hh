@@ -21,6 +21,7 @@
 #include <fstream>
 #include <cmath>
 #include <algorithm>
+#include <type_traits>
 
 #include <ignition/math/Helpers.hh>
 #include <ignition/math/config.hh>
@@ -55,39 +56,34 @@ namespace ignition
       public: static const Vector3 UnitZ;
 
       /// \brief Constructor
-      public: Vector3()
+      public: constexpr Vector3()
+      : data{0, 0, 0}
       {
-        this->data[0] = 0;
-        this->data[1] = 0;
-        this->data[2] = 0;
       }
 
       /// \brief Constructor
       /// \param[in] _x value along x
       /// \param[in] _y value along y
       /// \param[in] _z value along z
-      public: Vector3(const T &_x, const T &_y, const T &_z)
+      public: constexpr Vector3(const T &_x, const T &_y, const T &_z)
+      : data{_x, _y, _z}
       {
-        this->data[0] = _x;
-        this->data[1] = _y;
-        this->data[2] = _z;
       }
 
       /// \brief Copy constructor
       /// \param[in] _v a vector
-      public: Vector3(const Vector3<T> &_v)
-      {
-        this->data[0] = _v[0];
-        this->data[1] = _v[1];
-        this->data[2] = _v[2];
-      }
+      public: Vector3(const Vector3<T> &_v) = default;
 
       /// \brief Destructor
+#ifdef IGNITION_MATH_POD_TYPES
+      public: ~Vector3() = default;
+#else
       public: virtual ~Vector3() {}
+#endif
 
       /// \brief Return the sum of the values
       /// \return the sum
-      public: T Sum() const
+      public: constexpr T Sum() const
       {
         return this->data[0] + this->data[1] + this->data[2];
       }
@@ -176,7 +172,7 @@ namespace ignition
       /// \param[in] _x value along x
       /// \param[in] _y value along y
       /// \param[in] _z value aling z
-      public: inline void Set(T _x = 0, T _y = 0, T _z = 0)
+      public: constexpr void Set(T _x = 0, T _y = 0, T _z = 0)
       {
         this->data[0] = _x;
         this->data[1] = _y;
@@ -186,7 +182,7 @@ namespace ignition
       /// \brief Return the cross product of this vector with another vector.
       /// \param[in] _v a vector
       /// \return the cross product
-      public: Vector3 Cross(const Vector3<T> &_v) const
+      public: IGN_MATH_POD_CONSTEXPR Vector3 Cross(const Vector3<T> &_v) const
       {
         return Vector3(this->data[1] * _v[2] - this->data[2] * _v[1],
                        this->data[2] * _v[0] - this->data[0] * _v[2],
@@ -196,7 +192,7 @@ namespace ignition
       /// \brief Return the dot product of this vector and another vector
       /// \param[in] _v the vector
       /// \return the dot product
-      public: T Dot(const Vector3<T> &_v) const
+      public: constexpr T Dot(const Vector3<T> &_v) const
       {
         return this->data[0] * _v[0] +
                this->data[1] * _v[1] +
@@ -272,7 +268,7 @@ namespace ignition
       /// \brief Set this vector's components to the maximum of itself and the
       ///        passed in vector
       /// \param[in] _v the maximum clamping vector
-      public: void Max(const Vector3<T> &_v)
+      public: constexpr void Max(const Vector3<T> &_v)
       {
         if (_v[0] > this->data[0])
           this->data[0] = _v[0];
@@ -285,7 +281,7 @@ namespace ignition
       /// \brief Set this vector's components to the minimum of itself and the
       ///        passed in vector
       /// \param[in] _v the minimum clamping vector
-      public: void Min(const Vector3<T> &_v)
+      public: constexpr void Min(const Vector3<T> &_v)
       {
         if (_v[0] < this->data[0])
           this->data[0] = _v[0];
@@ -297,14 +293,14 @@ namespace ignition
 
       /// \brief Get the maximum value in the vector
       /// \return the maximum element
-      public: T Max() const
+      public: constexpr T Max() const
       {
         return std::max(std::max(this->data[0], this->data[1]), this->data[2]);
       }
 
       /// \brief Get the minimum value in the vector
       /// \return the minimum element
-      public: T Min() const
+      public: constexpr T Min() const
       {
         return std::min(std::min(this->data[0], this->data[1]), this->data[2]);
       }
@@ -312,19 +308,12 @@ namespace ignition
       /// \brief Assignment operator
       /// \param[in] _v a new value
       /// \return this
-      public: Vector3 &operator=(const Vector3<T> &_v)
-      {
-        this->data[0] = _v[0];
-        this->data[1] = _v[1];
-        this->data[2] = _v[2];
-
-        return *this;
-      }
+      public: Vector3 &operator=(const Vector3<T> &_v) = default;
 
       /// \brief Assignment operator
       /// \param[in] _value assigned to all elements
       /// \return this
-      public: Vector3 &operator=(T _v)
+      public: constexpr Vector3 &operator=(T _v)
       {
         this->data[0] = _v;
         this->data[1] = _v;
@@ -336,7 +325,8 @@ namespace ignition
       /// \brief Addition operator
       /// \param[in] _v vector to add
       /// \return the sum vector
-      public: Vector3 operator+(const Vector3<T> &_v) const
+      public: IGN_MATH_POD_CONSTEXPR Vector3 operator+(
+                  const Vector3<T> &_v) const
       {
         return Vector3(this->data[0] + _v[0],
                        this->data[1] + _v[1],
@@ -346,7 +336,7 @@ namespace ignition
       /// \brief Addition assignment operator
       /// \param[in] _v vector to add
       /// \return the sum vector
-      public: const Vector3 &operator+=(const Vector3<T> &_v)
+      public: constexpr const Vector3 &operator+=(const Vector3<T> &_v)
       {
         this->data[0] += _v[0];
         this->data[1] += _v[1];
@@ -358,7 +348,7 @@ namespace ignition
       /// \brief Addition operators
       /// \param[in] _s the scalar addend
       /// \return sum vector
-      public: inline Vector3<T> operator+(const T _s) const
+      public: IGN_MATH_POD_CONSTEXPR Vector3<T> operator+(const T _s) const
       {
         return Vector3<T>(this->data[0] + _s,
                           this->data[1] + _s,
@@ -369,8 +359,8 @@ namespace ignition
       /// \param[in] _s the scalar addend
       /// \param[in] _v input vector
       /// \return sum vector
-      public: friend inline Vector3<T> operator+(const T _s,
-                                                 const Vector3<T> &_v)
+      public: friend IGN_MATH_POD_CONSTEXPR Vector3<T> operator+(
+                  const T _s, const Vector3<T> &_v)
       {
         return {_v.X() + _s, _v.Y() + _s, _v.Z() + _s};
       }
@@ -378,7 +368,7 @@ namespace ignition
       /// \brief Addition assignment operator
       /// \param[in] _s scalar addend
       /// \return this
-      public: const Vector3<T> &operator+=(const T _s)
+      public: constexpr const Vector3<T> &operator+=(const T _s)
       {
         this->data[0] += _s;
         this->data[1] += _s;
@@ -389,7 +379,7 @@ namespace ignition
 
       /// \brief Negation operator
       /// \return negative of this vector
-      public: inline Vector3 operator-() const
+      public: IGN_MATH_POD_CONSTEXPR Vector3 operator-() const
       {
         return Vector3(-this->data[0], -this->data[1], -this->data[2]);
       }
@@ -397,7 +387,8 @@ namespace ignition
       /// \brief Subtraction operators
       /// \param[in] _pt a vector to substract
       /// \return a vector after the substraction
-      public: inline Vector3<T> operator-(const Vector3<T> &_pt) const
+      public: IGN_MATH_POD_CONSTEXPR Vector3<T> operator-(
+                  const Vector3<T> &_pt) const
       {
         return Vector3(this->data[0] - _pt[0],
                        this->data[1] - _pt[1],
@@ -407,7 +398,7 @@ namespace ignition
       /// \brief Subtraction assignment operators
       /// \param[in] _pt subtrahend
       /// \return a vector after the substraction
-      public: const Vector3<T> &operator-=(const Vector3<T> &_pt)
+      public: constexpr const Vector3<T> &operator-=(const Vector3<T> &_pt)
       {
         this->data[0] -= _pt[0];
         this->data[1] -= _pt[1];
@@ -419,7 +410,7 @@ namespace ignition
       /// \brief Subtraction operators
       /// \param[in] _s the scalar subtrahend
       /// \return difference vector
-      public: inline Vector3<T> operator-(const T _s) const
+      public: IGN_MATH_POD_CONSTEXPR Vector3<T> operator-(const T _s) const
       {
         return Vector3<T>(this->data[0] - _s,
                           this->data[1] - _s,
@@ -430,8 +421,8 @@ namespace ignition
       /// \param[in] _s the scalar minuend
       /// \param[in] _v vector subtrahend
       /// \return difference vector
-      public: friend inline Vector3<T> operator-(const T _s,
-                                                 const Vector3<T> &_v)
+      public: friend IGN_MATH_POD_CONSTEXPR Vector3<T> operator-(
+                  const T _s, const Vector3<T> &_v)
       {
         return {_s - _v.X(), _s - _v.Y(), _s - _v.Z()};
       }
@@ -439,7 +430,7 @@ namespace ignition
       /// \brief Subtraction assignment operator
       /// \param[in] _s scalar subtrahend
       /// \return this
-      public: const Vector3<T> &operator-=(const T _s)
+      public: constexpr const Vector3<T> &operator-=(const T _s)
       {
         this->data[0] -= _s;
         this->data[1] -= _s;
@@ -452,7 +443,8 @@ namespace ignition
       /// \remarks this is an element wise division
       /// \param[in] _pt the vector divisor
       /// \return a vector
-      public: const Vector3<T> operator/(const Vector3<T> &_pt) const
+      public: IGN_MATH_POD_CONSTEXPR const Vector3<T> operator/(
+                  const Vector3<T> &_pt) const
       {
         return Vector3(this->data[0] / _pt[0],
                        this->data[1] / _pt[1],
@@ -463,7 +455,7 @@ namespace ignition
       /// \remarks this is an element wise division
       /// \param[in] _pt the vector divisor
       /// \return a vector
-      public: const Vector3<T> &operator/=(const Vector3<T> &_pt)
+      public: constexpr const Vector3<T> &operator/=(const Vector3<T> &_pt)
       {
         this->data[0] /= _pt[0];
         this->data[1] /= _pt[1];
@@ -476,7 +468,7 @@ namespace ignition
       /// \remarks this is an element wise division
       /// \param[in] _v the divisor
       /// \return a vector
-      public: const Vector3<T> operator/(T _v) const
+      public: IGN_MATH_POD_CONSTEXPR const Vector3<T> operator/(T _v) const
       {
         return Vector3(this->data[0] / _v,
                        this->data[1] / _v,
@@ -487,7 +479,7 @@ namespace ignition
       /// \remarks this is an element wise division
       /// \param[in] _v the divisor
       /// \return this
-      public: const Vector3<T> &operator/=(T _v)
+      public: constexpr const Vector3<T> &operator/=(T _v)
       {
         this->data[0] /= _v;
         this->data[1] /= _v;
@@ -500,7 +492,8 @@ namespace ignition
       /// \remarks this is an element wise multiplication, not a cross product
       /// \param[in] _p multiplier operator
       /// \return a vector
-      public: Vector3<T> operator*(const Vector3<T> &_p) const
+      public: IGN_MATH_POD_CONSTEXPR Vector3<T> operator*(
+                  const Vector3<T> &_p) const
       {
         return Vector3(this->data[0] * _p[0],
                        this->data[1] * _p[1],
@@ -511,7 +504,7 @@ namespace ignition
       /// \remarks this is an element wise multiplication, not a cross product
       /// \param[in] _v a vector
       /// \return this
-      public: const Vector3<T> &operator*=(const Vector3<T> &_v)
+      public: constexpr const Vector3<T> &operator*=(const Vector3<T> &_v)
       {
         this->data[0] *= _v[0];
         this->data[1] *= _v[1];
@@ -523,7 +516,7 @@ namespace ignition
       /// \brief Multiplication operators
       /// \param[in] _s the scaling factor
       /// \return a scaled vector
-      public: inline Vector3<T> operator*(T _s) const
+      public: IGN_MATH_POD_CONSTEXPR Vector3<T> operator*(T _s) const
       {
         return Vector3<T>(this->data[0] * _s,
                           this->data[1] * _s,
@@ -534,7 +527,8 @@ namespace ignition
       /// \param[in] _s the scaling factor
       /// \param[in] _v input vector
       /// \return a scaled vector
-      public: friend inline Vector3<T> operator*(T _s, const Vector3<T> &_v)
+      public: friend IGN_MATH_POD_CONSTEXPR Vector3<T> operator*(
+                  T _s, const Vector3<T> &_v)
       {
         return {_v.X() * _s, _v.Y() * _s, _v.Z() * _s};
       }
@@ -542,7 +536,7 @@ namespace ignition
       /// \brief Multiplication operator
       /// \param[in] _v scaling factor
       /// \return this
-      public: const Vector3<T> &operator*=(T _v)
+      public: constexpr const Vector3<T> &operator*=(T _v)
       {
         this->data[0] *= _v;
         this->data[1] *= _v;
@@ -609,7 +603,7 @@ namespace ignition
       /// \param[in] _index The index, where 0 == x, 1 == y, 2 == z.
       /// The index is clamped to the range [0,2].
       /// \return The value.
-      public: T &operator[](const std::size_t _index)
+      public: constexpr T &operator[](const std::size_t _index)
       {
         return this->data[clamp(_index, IGN_ZERO_SIZE_T, IGN_TWO_SIZE_T)];
       }
@@ -618,7 +612,7 @@ namespace ignition
       /// \param[in] _index The index, where 0 == x, 1 == y, 2 == z.
       /// The index is clamped to the range [0,2].
       /// \return The value.
-      public: T operator[](const std::size_t _index) const
+      public: constexpr T operator[](const std::size_t _index) const
       {
         return this->data[clamp(_index, IGN_ZERO_SIZE_T, IGN_TWO_SIZE_T)];
       }
@@ -645,63 +639,63 @@ namespace ignition
 
       /// \brief Get the x value.
       /// \return The x component of the vector
-      public: inline T X() const
+      public: constexpr T X() const
       {
         return this->data[0];
       }
 
       /// \brief Get the y value.
       /// \return The y component of the vector
-      public: inline T Y() const
+      public: constexpr T Y() const
       {
         return this->data[1];
       }
 
       /// \brief Get the z value.
       /// \return The z component of the vector
-      public: inline T Z() const
+      public: constexpr T Z() const
       {
         return this->data[2];
       }
 
       /// \brief Get a mutable reference to the x value.
       /// \return The x component of the vector
-      public: inline T &X()
+      public: constexpr T &X()
       {
         return this->data[0];
       }
 
       /// \brief Get a mutable reference to the y value.
       /// \return The y component of the vector
-      public: inline T &Y()
+      public: constexpr T &Y()
       {
         return this->data[1];
       }
 
       /// \brief Get a mutable reference to the z value.
       /// \return The z component of the vector
-      public: inline T &Z()
+      public: constexpr T &Z()
       {
         return this->data[2];
       }
 
       /// \brief Set the x value.
       /// \param[in] _v Value for the x component.
-      public: inline void X(const T &_v)
+      public: constexpr void X(const T &_v)
       {
         this->data[0] = _v;
       }
 
       /// \brief Set the y value.
       /// \param[in] _v Value for the y component.
-      public: inline void Y(const T &_v)
+      public: constexpr void Y(const T &_v)
       {
         this->data[1] = _v;
       }
 
       /// \brief Set the z value.
       /// \param[in] _v Value for the z component.
-      public: inline void Z(const T &_v)
+      public: constexpr void Z(const T &_v)
       {
         this->data[2] = _v;
       }
@@ -710,7 +704,7 @@ namespace ignition
       /// \param[in] _pt Vector to compare.
       /// \return True if this vector's X(), Y(), or Z() value is less
       /// than the given vector's corresponding values.
-      public: bool operator<(const Vector3<T> &_pt) const
+      public: constexpr bool operator<(const Vector3<T> &_pt) const
       {
         return this->data[0] < _pt[0] || this->data[1] < _pt[1] ||
                this->data[2] < _pt[2];
@@ -747,15 +741,35 @@ namespace ignition
       private: T data[3];
     };
 
-    template<typename T> const Vector3<T> Vector3<T>::Zero(0, 0, 0);
-    template<typename T> const Vector3<T> Vector3<T>::One(1, 1, 1);
-    template<typename T> const Vector3<T> Vector3<T>::UnitX(1, 0, 0);
-    template<typename T> const Vector3<T> Vector3<T>::UnitY(0, 1, 0);
-    template<typename T> const Vector3<T> Vector3<T>::UnitZ(0, 0, 1);
+    template<typename T>
+    IGN_MATH_POD_CONSTEXPR const Vector3<T> Vector3<T>::Zero(0, 0, 0);
+    template<typename T>
+    IGN_MATH_POD_CONSTEXPR const Vector3<T> Vector3<T>::One(1, 1, 1);
+    template<typename T>
+    IGN_MATH_POD_CONSTEXPR const Vector3<T> Vector3<T>::UnitX(1, 0, 0);
+    template<typename T>
+    IGN_MATH_POD_CONSTEXPR const Vector3<T> Vector3<T>::UnitY(0, 1, 0);
+    template<typename T>
+    IGN_MATH_POD_CONSTEXPR const Vector3<T> Vector3<T>::UnitZ(0, 0, 1);
 
     typedef Vector3<int> Vector3i;
     typedef Vector3<double> Vector3d;
     typedef Vector3<float> Vector3f;
+
+#ifdef IGNITION_MATH_POD_TYPES
+    static_assert(sizeof(Vector3d) == 3 * sizeof(double),
+        "Vector3d must have the memory layout of double[3]");
+    static_assert(std::is_standard_layout<Vector3d>::value,
+        "Vector3d must be standard-layout");
+    static_assert(std::is_trivially_copyable<Vector3d>::value,
+        "Vector3d must be trivially copyable");
+    static_assert(sizeof(Vector3f) == 3 * sizeof(float),
+        "Vector3f must have the memory layout of float[3]");
+    static_assert(std::is_standard_layout<Vector3f>::value,
+        "Vector3f must be standard-layout");
+    static_assert(std::is_trivially_copyable<Vector3f>::value,
+        "Vector3f must be trivially copyable");
+#endif
     }
   }
 }
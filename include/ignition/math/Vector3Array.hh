@@ -0,0 +1,832 @@
+/*
+ * Copyright (C) 2018 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef IGNITION_MATH_VECTOR3ARRAY_HH_
+#define IGNITION_MATH_VECTOR3ARRAY_HH_
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+#include <ignition/math/Export.hh>
+#include <ignition/math/Helpers.hh>
+#include <ignition/math/Matrix3.hh>
+#include <ignition/math/Matrix4.hh>
+#include <ignition/math/Pose3.hh>
+#include <ignition/math/Vector3.hh>
+#include <ignition/math/Vector3View.hh>
+#include <ignition/math/config.hh>
+#include <ignition/math/detail/AlignedAllocator.hh>
+#include <ignition/math/detail/Soa.hh>
+
+namespace ignition
+{
+  namespace math
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace IGNITION_MATH_VERSION_NAMESPACE {
+    namespace detail
+    {
+      /// \brief Batch kernels used by Vector3Array. This generic version
+      /// is a plain scalar implementation. The float and double
+      /// specializations are compiled into the library and use SIMD
+      /// instructions when they are available.
+      ///
+      /// Unless otherwise noted, output arrays may be the same as input
+      /// arrays, but must not partially overlap them.
+      template<typename T>
+      class Vector3ArrayKernels
+      {
+        /// \brief _out = _a + _b
+        /// \param[in] _a First operand.
+        /// \param[in] _b Second operand.
+        /// \param[out] _out Result.
+        /// \param[in] _n Number of vectors.
+        public: static void Add(ConstSoa3<T> _a, ConstSoa3<T> _b,
+                    Soa3<T> _out, const std::size_t _n)
+        {
+          for (std::size_t i = 0; i < _n; ++i)
+          {
+            _out.x[i] = _a.x[i] + _b.x[i];
+            _out.y[i] = _a.y[i] + _b.y[i];
+            _out.z[i] = _a.z[i] + _b.z[i];
+          }
+        }
+
+        /// \brief _out = _a + _v
+        /// \param[in] _a First operand.
+        /// \param[in] _v Vector added to every element of _a.
+        /// \param[out] _out Result.
+        /// \param[in] _n Number of vectors.
+        public: static void Add(ConstSoa3<T> _a, const Vector3<T> &_v,
+                    Soa3<T> _out, const std::size_t _n)
+        {
+          for (std::size_t i = 0; i < _n; ++i)
+          {
+            _out.x[i] = _a.x[i] + _v.X();
+            _out.y[i] = _a.y[i] + _v.Y();
+            _out.z[i] = _a.z[i] + _v.Z();
+          }
+        }
+
+        /// \brief _out = _a * _s
+        /// \param[in] _a Vectors to scale.
+        /// \param[in] _s Scale factor.
+        /// \param[out] _out Result.
+        /// \param[in] _n Number of vectors.
+        public: static void Scale(ConstSoa3<T> _a, const T _s,
+                    Soa3<T> _out, const std::size_t _n)
+        {
+          for (std::size_t i = 0; i < _n; ++i)
+          {
+            _out.x[i] = _a.x[i] * _s;
+            _out.y[i] = _a.y[i] * _s;
+            _out.z[i] = _a.z[i] * _s;
+          }
+        }
+
+        /// \brief _out[i] = _a[i].Dot(_b[i])
+        /// \param[in] _a First operand.
+        /// \param[in] _b Second operand.
+        /// \param[out] _out Result, one value per vector.
+        /// \param[in] _n Number of vectors.
+        public: static void Dot(ConstSoa3<T> _a, ConstSoa3<T> _b,
+                    T *_out, const std::size_t _n)
+        {
+          for (std::size_t i = 0; i < _n; ++i)
+            _out[i] = _a.x[i] * _b.x[i] + _a.y[i] * _b.y[i] + _a.z[i] * _b.z[i];
+        }
+
+        /// \brief _out[i] = _a[i].Dot(_v)
+        /// \param[in] _a First operand.
+        /// \param[in] _v Second operand.
+        /// \param[out] _out Result, one value per vector.
+        /// \param[in] _n Number of vectors.
+        public: static void Dot(ConstSoa3<T> _a, const Vector3<T> &_v,
+                    T *_out, const std::size_t _n)
+        {
+          for (std::size_t i = 0; i < _n; ++i)
+          {
+            _out[i] = _a.x[i] * _v.X() + _a.y[i] * _v.Y() +
+                      _a.z[i] * _v.Z();
+          }
+        }
+
+        /// \brief _out[i] = _a[i].Cross(_b[i])
+        /// \param[in] _a First operand.
+        /// \param[in] _b Second operand.
+        /// \param[out] _out Result.
+        /// \param[in] _n Number of vectors.
+        public: static void Cross(ConstSoa3<T> _a, ConstSoa3<T> _b,
+                    Soa3<T> _out, const std::size_t _n)
+        {
+          for (std::size_t i = 0; i < _n; ++i)
+          {
+            const T x = _a.y[i] * _b.z[i] - _a.z[i] * _b.y[i];
+            const T y = _a.z[i] * _b.x[i] - _a.x[i] * _b.z[i];
+            const T z = _a.x[i] * _b.y[i] - _a.y[i] * _b.x[i];
+            _out.x[i] = x;
+            _out.y[i] = y;
+            _out.z[i] = z;
+          }
+        }
+
+        /// \brief _out[i] = _a[i].Length()
+        /// \param[in] _a Input vectors.
+        /// \param[out] _out Result, one value per vector.
+        /// \param[in] _n Number of vectors.
+        public: static void Length(ConstSoa3<T> _a, T *_out,
+                    const std::size_t _n)
+        {
+          for (std::size_t i = 0; i < _n; ++i)
+          {
+            _out[i] = static_cast<T>(std::sqrt(
+                  _a.x[i] * _a.x[i] + _a.y[i] * _a.y[i] + _a.z[i] * _a.z[i]));
+          }
+        }
+
+        /// \brief _out[i] = _a[i].Normalized(). As with
+        /// Vector3::Normalize(), vectors with a length equal to zero are
+        /// left unchanged.
+        /// \param[in] _a Input vectors.
+        /// \param[out] _out Result.
+        /// \param[in] _n Number of vectors.
+        public: static void Normalize(ConstSoa3<T> _a, Soa3<T> _out,
+                    const std::size_t _n)
+        {
+          for (std::size_t i = 0; i < _n; ++i)
+          {
+            const T d = static_cast<T>(std::sqrt(
+                  _a.x[i] * _a.x[i] + _a.y[i] * _a.y[i] + _a.z[i] * _a.z[i]));
+            if (!equal<T>(d, static_cast<T>(0.0)))
+            {
+              _out.x[i] = _a.x[i] / d;
+              _out.y[i] = _a.y[i] / d;
+              _out.z[i] = _a.z[i] / d;
+            }
+            else
+            {
+              _out.x[i] = _a.x[i];
+              _out.y[i] = _a.y[i];
+              _out.z[i] = _a.z[i];
+            }
+          }
+        }
+
+        /// \brief _out[i] = _a[i].Distance(_pt)
+        /// \param[in] _a Input vectors.
+        /// \param[in] _pt Point to measure the distance to.
+        /// \param[out] _out Result, one value per vector.
+        /// \param[in] _n Number of vectors.
+        public: static void Distance(ConstSoa3<T> _a, const Vector3<T> &_pt,
+                    T *_out, const std::size_t _n)
+        {
+          for (std::size_t i = 0; i < _n; ++i)
+          {
+            const T dx = _a.x[i] - _pt.X();
+            const T dy = _a.y[i] - _pt.Y();
+            const T dz = _a.z[i] - _pt.Z();
+            _out[i] = static_cast<T>(std::sqrt(dx * dx + dy * dy + dz * dz));
+          }
+        }
+
+        /// \brief _out[i] = _rot * (_a[i] + _pre) + _post. This is the rigid
+        /// transform used by Vector3Array::Transform and
+        /// Vector3Array::InverseTransform.
+        /// \param[in] _a Input vectors.
+        /// \param[in] _rot Rotation matrix.
+        /// \param[in] _pre Offset added before the rotation.
+        /// \param[in] _post Offset added after the rotation.
+        /// \param[out] _out Result.
+        /// \param[in] _n Number of vectors.
+        public: static void Transform(ConstSoa3<T> _a, const Matrix3<T> &_rot,
+                    const Vector3<T> &_pre, const Vector3<T> &_post,
+                    Soa3<T> _out, const std::size_t _n)
+        {
+          for (std::size_t i = 0; i < _n; ++i)
+          {
+            const T x = _a.x[i] + _pre.X();
+            const T y = _a.y[i] + _pre.Y();
+            const T z = _a.z[i] + _pre.Z();
+            _out.x[i] = _rot(0, 0) * x + _rot(0, 1) * y + _rot(0, 2) * z +
+                        _post.X();
+            _out.y[i] = _rot(1, 0) * x + _rot(1, 1) * y + _rot(1, 2) * z +
+                        _post.Y();
+            _out.z[i] = _rot(2, 0) * x + _rot(2, 1) * y + _rot(2, 2) * z +
+                        _post.Z();
+          }
+        }
+
+        /// \brief Compute the component-wise minimum and maximum of a set
+        /// of vectors.
+        /// \param[in] _a Input vectors.
+        /// \param[in] _n Number of vectors, must be greater than zero.
+        /// \param[out] _min Component-wise minimum.
+        /// \param[out] _max Component-wise maximum.
+        public: static void MinMax(ConstSoa3<T> _a, const std::size_t _n,
+                    Vector3<T> &_min, Vector3<T> &_max)
+        {
+          _min.Set(_a.x[0], _a.y[0], _a.z[0]);
+          _max = _min;
+          for (std::size_t i = 1; i < _n; ++i)
+          {
+            _min.Set(std::min(_min.X(), _a.x[i]),
+                     std::min(_min.Y(), _a.y[i]),
+                     std::min(_min.Z(), _a.z[i]));
+            _max.Set(std::max(_max.X(), _a.x[i]),
+                     std::max(_max.Y(), _a.y[i]),
+                     std::max(_max.Z(), _a.z[i]));
+          }
+        }
+
+        /// \brief Check which vectors lie inside a box centered on the
+        /// origin after a rigid transform: _inside[i] is 1 if each
+        /// component of _rot * (_a[i] + _pre) lies in [-_half, _half], 0
+        /// otherwise. This is the test used by OrientedBox::Contains.
+        /// \param[in] _a Input vectors.
+        /// \param[in] _rot Rotation matrix.
+        /// \param[in] _pre Offset added before the rotation.
+        /// \param[in] _half Half size of the box.
+        /// \param[out] _inside Result, one value per vector.
+        /// \param[in] _n Number of vectors.
+        public: static void InBox(ConstSoa3<T> _a, const Matrix3<T> &_rot,
+                    const Vector3<T> &_pre, const Vector3<T> &_half,
+                    T *_inside, const std::size_t _n)
+        {
+          for (std::size_t i = 0; i < _n; ++i)
+          {
+            const Vector3<T> p = _rot * Vector3<T>(
+                _a.x[i] + _pre.X(), _a.y[i] + _pre.Y(), _a.z[i] + _pre.Z());
+            _inside[i] = (std::abs(p.X()) <= _half.X() &&
+                          std::abs(p.Y()) <= _half.Y() &&
+                          std::abs(p.Z()) <= _half.Z()) ? 1 : 0;
+          }
+        }
+
+        /// \brief Closest points between pairs of segments: segment i of
+        /// the first set goes from _startA[i] to _endA[i], and segment i of
+        /// the second set from _startB[i] to _endB[i]. This is the exact
+        /// minimum, found as in Line3::Distance() but with the parameter
+        /// of the first segment computed again when the parameter of the
+        /// second one is clamped. Segments may have a zero length. This is
+        /// the computation used by Line3::ClosestPoints().
+        /// \param[in] _startA Start points of the first segments.
+        /// \param[in] _endA End points of the first segments.
+        /// \param[in] _startB Start points of the second segments.
+        /// \param[in] _endB End points of the second segments.
+        /// \param[out] _pointA Closest points on the first segments.
+        /// \param[out] _pointB Closest points on the second segments.
+        /// \param[out] _sqDist Squared distances between the closest
+        /// points.
+        /// \param[in] _n Number of pairs of segments.
+        public: static void SegmentClosestPoints(ConstSoa3<T> _startA,
+                    ConstSoa3<T> _endA, ConstSoa3<T> _startB,
+                    ConstSoa3<T> _endB, Soa3<T> _pointA, Soa3<T> _pointB,
+                    T *_sqDist, const std::size_t _n)
+        {
+          for (std::size_t i = 0; i < _n; ++i)
+          {
+            const Vector3<T> p1(_startA.x[i], _startA.y[i], _startA.z[i]);
+            const Vector3<T> p2(_startB.x[i], _startB.y[i], _startB.z[i]);
+            const Vector3<T> d1 =
+              Vector3<T>(_endA.x[i], _endA.y[i], _endA.z[i]) - p1;
+            const Vector3<T> d2 =
+              Vector3<T>(_endB.x[i], _endB.y[i], _endB.z[i]) - p2;
+            const Vector3<T> r = p1 - p2;
+            const T a = d1.Dot(d1);
+            const T b = d1.Dot(d2);
+            const T c = d1.Dot(r);
+            const T e = d2.Dot(d2);
+            const T f = d2.Dot(r);
+
+            // a * e - b * b written as a squared cross product, which
+            // keeps its accuracy when the segments are almost parallel
+            const Vector3<T> normal = d1.Cross(d2);
+            const T denom = normal.Dot(normal);
+            T s = denom > 0 ?
+              clamp(normal.Dot(d2.Cross(r)) / denom, T(0), T(1)) : T(0);
+            const T tRaw = e > 0 ? (b * s + f) / e : T(0);
+            const bool tClamped = tRaw < 0 || tRaw > 1;
+            const T t = clamp(tRaw, T(0), T(1));
+            if (e <= 0 || tClamped)
+              s = a > 0 ? clamp((b * t - c) / a, T(0), T(1)) : T(0);
+
+            const Vector3<T> pa = p1 + d1 * s;
+            const Vector3<T> pb = p2 + d2 * t;
+            _pointA.x[i] = pa.X();
+            _pointA.y[i] = pa.Y();
+            _pointA.z[i] = pa.Z();
+            _pointB.x[i] = pb.X();
+            _pointB.y[i] = pb.Y();
+            _pointB.z[i] = pb.Z();
+            _sqDist[i] = (pa - pb).SquaredLength();
+          }
+        }
+      };
+
+      /// \brief Vector3ArrayKernels specialization for float, implemented
+      /// in the library with SIMD instructions.
+      template<>
+      class IGNITION_MATH_VISIBLE Vector3ArrayKernels<float>
+      {
+        public: static void Add(ConstSoa3<float> _a, ConstSoa3<float> _b,
+                    Soa3<float> _out, const std::size_t _n);
+        public: static void Add(ConstSoa3<float> _a,
+                    const Vector3<float> &_v, Soa3<float> _out,
+                    const std::size_t _n);
+        public: static void Scale(ConstSoa3<float> _a, const float _s,
+                    Soa3<float> _out, const std::size_t _n);
+        public: static void Dot(ConstSoa3<float> _a, ConstSoa3<float> _b,
+                    float *_out, const std::size_t _n);
+        public: static void Dot(ConstSoa3<float> _a,
+                    const Vector3<float> &_v, float *_out,
+                    const std::size_t _n);
+        public: static void Cross(ConstSoa3<float> _a, ConstSoa3<float> _b,
+                    Soa3<float> _out, const std::size_t _n);
+        public: static void Length(ConstSoa3<float> _a, float *_out,
+                    const std::size_t _n);
+        public: static void Normalize(ConstSoa3<float> _a,
+                    Soa3<float> _out, const std::size_t _n);
+        public: static void Distance(ConstSoa3<float> _a,
+                    const Vector3<float> &_pt, float *_out,
+                    const std::size_t _n);
+        public: static void Transform(ConstSoa3<float> _a,
+                    const Matrix3<float> &_rot, const Vector3<float> &_pre,
+                    const Vector3<float> &_post, Soa3<float> _out,
+                    const std::size_t _n);
+        public: static void MinMax(ConstSoa3<float> _a,
+                    const std::size_t _n,
+                    Vector3<float> &_min, Vector3<float> &_max);
+        public: static void InBox(ConstSoa3<float> _a,
+                    const Matrix3<float> &_rot, const Vector3<float> &_pre,
+                    const Vector3<float> &_half, float *_inside,
+                    const std::size_t _n);
+        public: static void SegmentClosestPoints(ConstSoa3<float> _startA,
+                    ConstSoa3<float> _endA, ConstSoa3<float> _startB,
+                    ConstSoa3<float> _endB, Soa3<float> _pointA,
+                    Soa3<float> _pointB, float *_sqDist, const std::size_t _n);
+      };
+
+      /// \brief Vector3ArrayKernels specialization for double, implemented
+      /// in the library with SIMD instructions.
+      template<>
+      class IGNITION_MATH_VISIBLE Vector3ArrayKernels<double>
+      {
+        public: static void Add(ConstSoa3<double> _a, ConstSoa3<double> _b,
+                    Soa3<double> _out, const std::size_t _n);
+        public: static void Add(ConstSoa3<double> _a,
+                    const Vector3<double> &_v, Soa3<double> _out,
+                    const std::size_t _n);
+        public: static void Scale(ConstSoa3<double> _a, const double _s,
+                    Soa3<double> _out, const std::size_t _n);
+        public: static void Dot(ConstSoa3<double> _a, ConstSoa3<double> _b,
+                    double *_out, const std::size_t _n);
+        public: static void Dot(ConstSoa3<double> _a,
+                    const Vector3<double> &_v, double *_out,
+                    const std::size_t _n);
+        public: static void Cross(ConstSoa3<double> _a,
+                    ConstSoa3<double> _b, Soa3<double> _out,
+                    const std::size_t _n);
+        public: static void Length(ConstSoa3<double> _a, double *_out,
+                    const std::size_t _n);
+        public: static void Normalize(ConstSoa3<double> _a,
+                    Soa3<double> _out, const std::size_t _n);
+        public: static void Distance(ConstSoa3<double> _a,
+                    const Vector3<double> &_pt, double *_out,
+                    const std::size_t _n);
+        public: static void Transform(ConstSoa3<double> _a,
+                    const Matrix3<double> &_rot, const Vector3<double> &_pre,
+                    const Vector3<double> &_post, Soa3<double> _out,
+                    const std::size_t _n);
+        public: static void MinMax(ConstSoa3<double> _a,
+                    const std::size_t _n,
+                    Vector3<double> &_min, Vector3<double> &_max);
+        public: static void InBox(ConstSoa3<double> _a,
+                    const Matrix3<double> &_rot, const Vector3<double> &_pre,
+                    const Vector3<double> &_half, double *_inside,
+                    const std::size_t _n);
+        public: static void SegmentClosestPoints(ConstSoa3<double> _startA,
+                    ConstSoa3<double> _endA, ConstSoa3<double> _startB,
+                    ConstSoa3<double> _endB, Soa3<double> _pointA,
+                    Soa3<double> _pointB, double *_sqDist,
+                    const std::size_t _n);
+      };
+    }
+
+    /// \class Vector3Array Vector3Array.hh ignition/math/Vector3Array.hh
+    /// \brief A set of 3D vectors stored as a structure of arrays: the x,
+    /// y and z values are kept in three separate, aligned arrays. This
+    /// layout allows the batch functions of this class to process many
+    /// vectors at once with SIMD instructions.
+    ///
+    /// The batch functions are equivalent to calling the matching
+    /// Vector3 function on each element.
+    template<typename T>
+    class Vector3Array
+    {
+      /// \brief Type of the aligned storage of each component
+      public: typedef std::vector<T, detail::AlignedAllocator<T>> Storage;
+
+      /// \brief Default constructor. The array is empty.
+      public: Vector3Array() = default;
+
+      /// \brief Constructor.
+      /// \param[in] _size Number of vectors, all initialized to zero.
+      public: explicit Vector3Array(const std::size_t _size)
+      : xs(_size), ys(_size), zs(_size)
+      {
+      }
+
+      /// \brief Construct from an array of Vector3.
+      /// \param[in] _points Vectors to copy.
+      public: explicit Vector3Array(const std::vector<Vector3<T>> &_points)
+      {
+        this->Assign(_points);
+      }
+
+      /// \brief Construct from a view of an external buffer.
+      /// \param[in] _points Vectors to copy.
+      public: explicit Vector3Array(const Vector3View<T> &_points)
+      {
+        this->Assign(_points);
+      }
+
+      /// \brief Get the number of vectors.
+      /// \return Number of vectors in the array.
+      public: std::size_t Size() const
+      {
+        return this->xs.size();
+      }
+
+      /// \brief Get whether the array is empty.
+      /// \return True if the array contains no vectors.
+      public: bool Empty() const
+      {
+        return this->xs.empty();
+      }
+
+      /// \brief Resize the array. New vectors are initialized to zero.
+      /// \param[in] _size New number of vectors.
+      public: void Resize(const std::size_t _size)
+      {
+        this->xs.resize(_size);
+        this->ys.resize(_size);
+        this->zs.resize(_size);
+      }
+
+      /// \brief Reserve storage for a number of vectors.
+      /// \param[in] _size Number of vectors to reserve storage for.
+      public: void Reserve(const std::size_t _size)
+      {
+        this->xs.reserve(_size);
+        this->ys.reserve(_size);
+        this->zs.reserve(_size);
+      }
+
+      /// \brief Remove all vectors.
+      public: void Clear()
+      {
+        this->xs.clear();
+        this->ys.clear();
+        this->zs.clear();
+      }
+
+      /// \brief Append a vector to the end of the array.
+      /// \param[in] _v Vector to append.
+      public: void PushBack(const Vector3<T> &_v)
+      {
+        this->xs.push_back(_v.X());
+        this->ys.push_back(_v.Y());
+        this->zs.push_back(_v.Z());
+      }
+
+      /// \brief Get a vector. No bounds checking is performed.
+      /// \param[in] _index Index of the vector.
+      /// \return Copy of the vector at _index.
+      public: Vector3<T> operator[](const std::size_t _index) const
+      {
+        return Vector3<T>(this->xs[_index], this->ys[_index],
+                          this->zs[_index]);
+      }
+
+      /// \brief Set a vector. No bounds checking is performed.
+      /// \param[in] _index Index of the vector.
+      /// \param[in] _v New value of the vector.
+      public: void Set(const std::size_t _index, const Vector3<T> &_v)
+      {
+        this->xs[_index] = _v.X();
+        this->ys[_index] = _v.Y();
+        this->zs[_index] = _v.Z();
+      }
+
+      /// \brief Replace the content of this array by a copy of an array
+      /// of Vector3.
+      /// \param[in] _points Vectors to copy.
+      public: void Assign(const std::vector<Vector3<T>> &_points)
+      {
+        this->Resize(_points.size());
+        for (std::size_t i = 0; i < _points.size(); ++i)
+        {
+          this->xs[i] = _points[i].X();
+          this->ys[i] = _points[i].Y();
+          this->zs[i] = _points[i].Z();
+        }
+      }
+
+      /// \brief Replace the content of this array by a copy of the vectors
+      /// of an external buffer.
+      /// \param[in] _points View of the vectors to copy.
+      public: void Assign(const Vector3View<T> &_points)
+      {
+        this->Resize(_points.Size());
+        const T *v = _points.Data();
+        for (std::size_t i = 0; i < _points.Size(); ++i, v += _points.Stride())
+        {
+          this->xs[i] = v[0];
+          this->ys[i] = v[1];
+          this->zs[i] = v[2];
+        }
+      }
+
+      /// \brief Copy the content of this array to an array of Vector3.
+      /// \param[out] _points Destination array. It is resized to Size().
+      public: void ToVector(std::vector<Vector3<T>> &_points) const
+      {
+        _points.resize(this->Size());
+        for (std::size_t i = 0; i < _points.size(); ++i)
+          _points[i].Set(this->xs[i], this->ys[i], this->zs[i]);
+      }
+
+      /// \brief Copy the content of this array to an array of Vector3.
+      /// \return Array of Vector3 with the same content as this array.
+      public: std::vector<Vector3<T>> ToVector() const
+      {
+        std::vector<Vector3<T>> result;
+        this->ToVector(result);
+        return result;
+      }
+
+      /// \brief Get the array of x values.
+      /// \return Pointer to Size() x values, aligned for SIMD access.
+      public: const T *X() const
+      {
+        return this->xs.data();
+      }
+
+      /// \brief Get the array of y values.
+      /// \return Pointer to Size() y values, aligned for SIMD access.
+      public: const T *Y() const
+      {
+        return this->ys.data();
+      }
+
+      /// \brief Get the array of z values.
+      /// \return Pointer to Size() z values, aligned for SIMD access.
+      public: const T *Z() const
+      {
+        return this->zs.data();
+      }
+
+      /// \brief Get a mutable array of x values.
+      /// \return Pointer to Size() x values, aligned for SIMD access.
+      public: T *X()
+      {
+        return this->xs.data();
+      }
+
+      /// \brief Get a mutable array of y values.
+      /// \return Pointer to Size() y values, aligned for SIMD access.
+      public: T *Y()
+      {
+        return this->ys.data();
+      }
+
+      /// \brief Get a mutable array of z values.
+      /// \return Pointer to Size() z values, aligned for SIMD access.
+      public: T *Z()
+      {
+        return this->zs.data();
+      }
+
+      /// \brief Add another array to this one, element by element.
+      /// \param[in] _other Array to add. It must have the same size as
+      /// this array.
+      /// \return False if the sizes of the arrays differ, in which case
+      /// this array is not modified.
+      public: bool Add(const Vector3Array<T> &_other)
+      {
+        if (_other.Size() != this->Size())
+          return false;
+
+        detail::Vector3ArrayKernels<T>::Add(
+            this->Data(), _other.Data(), this->Data(), this->Size());
+        return true;
+      }
+
+      /// \brief Add a vector to every element of this array.
+      /// \param[in] _v Vector to add.
+      public: void Add(const Vector3<T> &_v)
+      {
+        detail::Vector3ArrayKernels<T>::Add(
+            this->Data(), _v, this->Data(), this->Size());
+      }
+
+      /// \brief Multiply every element of this array by a scalar.
+      /// \param[in] _s Scale factor.
+      public: void Scale(const T _s)
+      {
+        detail::Vector3ArrayKernels<T>::Scale(
+            this->Data(), _s, this->Data(), this->Size());
+      }
+
+      /// \brief Compute the dot product of each element with the matching
+      /// element of another array.
+      /// \param[in] _other Other array. It must have the same size as
+      /// this array.
+      /// \param[out] _result Dot products. It is resized to Size().
+      /// \return False if the sizes of the arrays differ.
+      public: bool Dot(const Vector3Array<T> &_other,
+                       std::vector<T> &_result) const
+      {
+        if (_other.Size() != this->Size())
+          return false;
+
+        _result.resize(this->Size());
+        detail::Vector3ArrayKernels<T>::Dot(
+            this->Data(), _other.Data(), _result.data(), this->Size());
+        return true;
+      }
+
+      /// \brief Compute the dot product of each element with a vector.
+      /// \param[in] _v The vector.
+      /// \param[out] _result Dot products. It is resized to Size().
+      public: void Dot(const Vector3<T> &_v, std::vector<T> &_result) const
+      {
+        _result.resize(this->Size());
+        detail::Vector3ArrayKernels<T>::Dot(
+            this->Data(), _v, _result.data(), this->Size());
+      }
+
+      /// \brief Compute the cross product of each element with the
+      /// matching element of another array.
+      /// \param[in] _other Other array. It must have the same size as
+      /// this array.
+      /// \param[out] _result Cross products. It is resized to Size(), and
+      /// may be this array or _other.
+      /// \return False if the sizes of the arrays differ.
+      public: bool Cross(const Vector3Array<T> &_other,
+                         Vector3Array<T> &_result) const
+      {
+        if (_other.Size() != this->Size())
+          return false;
+
+        _result.Resize(this->Size());
+        detail::Vector3ArrayKernels<T>::Cross(
+            this->Data(), _other.Data(), _result.Data(), this->Size());
+        return true;
+      }
+
+      /// \brief Compute the length of each element.
+      /// \param[out] _result Lengths. It is resized to Size().
+      public: void Length(std::vector<T> &_result) const
+      {
+        _result.resize(this->Size());
+        detail::Vector3ArrayKernels<T>::Length(
+            this->Data(), _result.data(), this->Size());
+      }
+
+      /// \brief Normalize each element. As with Vector3::Normalize(),
+      /// elements with a length of zero are left unchanged.
+      public: void Normalize()
+      {
+        detail::Vector3ArrayKernels<T>::Normalize(
+            this->Data(), this->Data(), this->Size());
+      }
+
+      /// \brief Compute the distance from each element to a point.
+      /// \param[in] _pt The point.
+      /// \param[out] _result Distances. It is resized to Size().
+      public: void Distance(const Vector3<T> &_pt,
+                            std::vector<T> &_result) const
+      {
+        _result.resize(this->Size());
+        detail::Vector3ArrayKernels<T>::Distance(
+            this->Data(), _pt, _result.data(), this->Size());
+      }
+
+      /// \brief Transform each element, expressed in the frame of a pose,
+      /// to the frame in which the pose is expressed. Each result is equal
+      /// to Pose3::CoordPositionAdd() applied to the matching element, but
+      /// the rotation matrix is computed only once.
+      /// \param[in] _pose The pose.
+      /// \param[out] _result Transformed points. It is resized to Size(),
+      /// and may be this array.
+      /// \sa Pose3::TransformPoints
+      public: void Transform(const Pose3<T> &_pose,
+                             Vector3Array<T> &_result) const
+      {
+        _result.Resize(this->Size());
+        detail::Vector3ArrayKernels<T>::Transform(this->Data(),
+            Matrix3<T>(_pose.Rot()), Vector3<T>::Zero, _pose.Pos(),
+            _result.Data(), this->Size());
+      }
+
+      /// \brief Transform each element, expressed in the frame in which a
+      /// pose is expressed, to the frame of the pose. This is the inverse
+      /// of Transform().
+      /// \param[in] _pose The pose.
+      /// \param[out] _result Transformed points. It is resized to Size(),
+      /// and may be this array.
+      /// \sa Pose3::InverseTransformPoints
+      public: void InverseTransform(const Pose3<T> &_pose,
+                                    Vector3Array<T> &_result) const
+      {
+        _result.Resize(this->Size());
+        detail::Vector3ArrayKernels<T>::Transform(this->Data(),
+            Matrix3<T>(_pose.Rot()).Transposed(), -_pose.Pos(),
+            Vector3<T>::Zero, _result.Data(), this->Size());
+      }
+
+      /// \brief Transform each element by a matrix. Each result is equal
+      /// to Matrix4::operator*(const Vector3<T>&) applied to the matching
+      /// element, which ignores the bottom row of the matrix. The float and
+      /// double versions of this function use SIMD instructions selected at
+      /// runtime.
+      /// \param[in] _mat Transformation matrix.
+      /// \param[out] _result Transformed points. It is resized to Size(),
+      /// and may be this array.
+      /// \sa Matrix4::TransformPoints
+      public: void Transform(const Matrix4<T> &_mat,
+                             Vector3Array<T> &_result) const
+      {
+        T mat[4][4];
+        for (int i = 0; i < 4; ++i)
+        {
+          for (int j = 0; j < 4; ++j)
+            mat[i][j] = _mat(i, j);
+        }
+        _result.Resize(this->Size());
+        detail::Matrix4Kernels<T>::TransformPoints(mat, this->Data(),
+            _result.Data(), this->Size());
+      }
+
+      /// \brief Compute the component-wise minimum and maximum of all
+      /// elements, which are the corners of their bounding box.
+      /// \param[out] _min Component-wise minimum.
+      /// \param[out] _max Component-wise maximum.
+      /// \return False if the array is empty, in which case _min and _max
+      /// are not modified.
+      public: bool MinMax(Vector3<T> &_min, Vector3<T> &_max) const
+      {
+        if (this->Empty())
+          return false;
+
+        detail::Vector3ArrayKernels<T>::MinMax(
+            this->Data(), this->Size(), _min, _max);
+        return true;
+      }
+
+      /// \brief Get read-only pointers to the component arrays.
+      /// \return The component arrays.
+      public: detail::ConstSoa3<T> Data() const
+      {
+        return {this->xs.data(), this->ys.data(), this->zs.data()};
+      }
+
+      /// \brief Get mutable pointers to the component arrays.
+      /// \return The component arrays.
+      public: detail::Soa3<T> Data()
+      {
+        return {this->xs.data(), this->ys.data(), this->zs.data()};
+      }
+
+      /// \brief The x values
+      private: Storage xs;
+
+      /// \brief The y values
+      private: Storage ys;
+
+      /// \brief The z values
+      private: Storage zs;
+    };
+
+    typedef Vector3Array<double> Vector3Arrayd;
+    typedef Vector3Array<float> Vector3Arrayf;
+    }
+  }
+}
+#endif
@@ -0,0 +1,110 @@
+/*
+ * Copyright (C) 2018 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef IGNITION_MATH_VECTOR3VIEW_HH_
+#define IGNITION_MATH_VECTOR3VIEW_HH_
+
+#include <cstddef>
+
+#include <ignition/math/Vector3.hh>
+#include <ignition/math/config.hh>
+
+namespace ignition
+{
+  namespace math
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace IGNITION_MATH_VERSION_NAMESPACE {
+    /// \class Vector3View Vector3View.hh ignition/math/Vector3View.hh
+    /// \brief A read-only view of a buffer of interleaved x, y, z values
+    /// as a sequence of Vector3. The view does not own or copy the buffer,
+    /// which must outlive it.
+    ///
+    /// The distance between two consecutive vectors is given by a stride,
+    /// in number of values of type T. The default stride of 3 describes a
+    /// packed x, y, z buffer, a larger stride skips the additional fields
+    /// of each point, such as the intensity of a point cloud.
+    template<typename T>
+    class Vector3View
+    {
+      /// \brief Default constructor. The view is empty.
+      public: Vector3View() = default;
+
+      /// \brief Constructor.
+      /// \param[in] _data Pointer to the x value of the first vector.
+      /// \param[in] _size Number of vectors.
+      /// \param[in] _stride Number of values of type T between the x
+      /// values of two consecutive vectors, at least 3.
+      public: Vector3View(const T *_data, const std::size_t _size,
+                  const std::size_t _stride = 3)
+      : data(_data), size(_size), stride(_stride)
+      {
+      }
+
+      /// \brief Get the number of vectors.
+      /// \return Number of vectors in the view.
+      public: std::size_t Size() const
+      {
+        return this->size;
+      }
+
+      /// \brief Get whether the view is empty.
+      /// \return True if the view contains no vectors.
+      public: bool Empty() const
+      {
+        return this->size == 0;
+      }
+
+      /// \brief Get the stride.
+      /// \return Number of values of type T between two consecutive
+      /// vectors.
+      public: std::size_t Stride() const
+      {
+        return this->stride;
+      }
+
+      /// \brief Get the viewed buffer.
+      /// \return Pointer to the x value of the first vector.
+      public: const T *Data() const
+      {
+        return this->data;
+      }
+
+      /// \brief Get a vector. No bounds checking is performed.
+      /// \param[in] _index Index of the vector.
+      /// \return Copy of the vector at _index.
+      public: Vector3<T> operator[](const std::size_t _index) const
+      {
+        const T *v = this->data + _index * this->stride;
+        return Vector3<T>(v[0], v[1], v[2]);
+      }
+
+      /// \brief Pointer to the x value of the first vector
+      private: const T *data = nullptr;
+
+      /// \brief Number of vectors
+      private: std::size_t size = 0;
+
+      /// \brief Distance between two consecutive vectors
+      private: std::size_t stride = 3;
+    };
+
+    typedef Vector3View<double> Vector3Viewd;
+    typedef Vector3View<float> Vector3Viewf;
+    }
+  }
+}
+#endif
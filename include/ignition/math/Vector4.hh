@@ -17,6 +17,7 @@
 #ifndef IGNITION_MATH_VECTOR4_HH_
 #define IGNITION_MATH_VECTOR4_HH_
 
+#include <type_traits>
 #include <ignition/math/Matrix4.hh>
 #include <ignition/math/Helpers.hh>
 #include <ignition/math/config.hh>
@@ -60,16 +61,14 @@ namespace ignition
 
       /// \brief Copy constructor
       /// \param[in] _v vector
-      public: Vector4(const Vector4<T> &_v)
-      {
-        this->data[0] = _v[0];
-        this->data[1] = _v[1];
-        this->data[2] = _v[2];
-        this->data[3] = _v[3];
-      }
+      public: Vector4(const Vector4<T> &_v) = default;
 
       /// \brief Destructor
+#ifdef IGNITION_MATH_POD_TYPES
+      public: ~Vector4() = default;
+#else
       public: virtual ~Vector4() {}
+#endif
 
       /// \brief Calc distance to the given point
       /// \param[in] _pt the point
@@ -129,15 +128,7 @@ namespace ignition
       /// \brief Assignment operator
       /// \param[in] _v the vector
       /// \return a reference to this vector
-      public: Vector4<T> &operator=(const Vector4<T> &_v)
-      {
-        this->data[0] = _v[0];
-        this->data[1] = _v[1];
-        this->data[2] = _v[2];
-        this->data[3] = _v[3];
-
-        return *this;
-      }
+      public: Vector4<T> &operator=(const Vector4<T> &_v) = default;
 
       /// \brief Assignment operator
       /// \param[in] _value
@@ -588,6 +579,21 @@ namespace ignition
     typedef Vector4<int> Vector4i;
     typedef Vector4<double> Vector4d;
     typedef Vector4<float> Vector4f;
+
+#ifdef IGNITION_MATH_POD_TYPES
+    static_assert(sizeof(Vector4d) == 4 * sizeof(double),
+        "Vector4d must have the memory layout of double[4]");
+    static_assert(std::is_standard_layout<Vector4d>::value,
+        "Vector4d must be standard-layout");
+    static_assert(std::is_trivially_copyable<Vector4d>::value,
+        "Vector4d must be trivially copyable");
+    static_assert(sizeof(Vector4f) == 4 * sizeof(float),
+        "Vector4f must have the memory layout of float[4]");
+    static_assert(std::is_standard_layout<Vector4f>::value,
+        "Vector4f must be standard-layout");
+    static_assert(std::is_trivially_copyable<Vector4f>::value,
+        "Vector4f must be trivially copyable");
+#endif
     }
   }
 }
@@ -0,0 +1,128 @@
+/*
+ * Copyright (C) 2018 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef IGNITION_MATH_DETAIL_ALIGNEDALLOCATOR_HH_
+#define IGNITION_MATH_DETAIL_ALIGNEDALLOCATOR_HH_
+
+#include <cstddef>
+#include <cstdlib>
+#include <limits>
+#include <new>
+
+#ifdef _WIN32
+#include <malloc.h>
+#endif
+
+#include <ignition/math/config.hh>
+
+namespace ignition
+{
+  namespace math
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace IGNITION_MATH_VERSION_NAMESPACE {
+    namespace detail
+    {
+      /// \brief Alignment, in bytes, used for the storage of batch
+      /// containers. It is large enough for the widest SIMD registers
+      /// used by the library.
+      static const std::size_t IGN_SIMD_ALIGNMENT = 64u;
+
+      /// \brief Standard allocator that returns memory aligned to
+      /// Align bytes. It is used to store the arrays of batch
+      /// containers such as Vector3Array.
+      template<typename T, std::size_t Align = IGN_SIMD_ALIGNMENT>
+      class AlignedAllocator
+      {
+        /// \brief Type of the allocated elements
+        public: typedef T value_type;
+
+        /// \brief Rebind this allocator to another element type
+        public: template<typename U>
+                struct rebind
+                {
+                  /// \brief The rebound allocator type
+                  typedef AlignedAllocator<U, Align> other;
+                };
+
+        /// \brief Default constructor
+        public: AlignedAllocator() = default;
+
+        /// \brief Converting constructor
+        public: template<typename U>
+                AlignedAllocator(const AlignedAllocator<U, Align> &)
+                {
+                }
+
+        /// \brief Allocate aligned storage for _n elements.
+        /// \param[in] _n Number of elements.
+        /// \return Pointer to the aligned storage.
+        /// \throws std::bad_alloc if the allocation failed.
+        public: T *allocate(const std::size_t _n)
+        {
+          if (_n == 0)
+            return nullptr;
+
+          if (_n > std::numeric_limits<std::size_t>::max() / sizeof(T))
+            throw std::bad_alloc();
+
+          void *ptr = nullptr;
+#ifdef _WIN32
+          ptr = _aligned_malloc(_n * sizeof(T), Align);
+#else
+          if (posix_memalign(&ptr, Align, _n * sizeof(T)) != 0)
+            ptr = nullptr;
+#endif
+          if (!ptr)
+            throw std::bad_alloc();
+
+          return static_cast<T *>(ptr);
+        }
+
+        /// \brief Release storage obtained from allocate().
+        /// \param[in] _ptr Pointer returned by allocate().
+        public: void deallocate(T *_ptr, const std::size_t)
+        {
+#ifdef _WIN32
+          _aligned_free(_ptr);
+#else
+          free(_ptr);
+#endif
+        }
+      };
+
+      /// \brief All aligned allocators with the same alignment are
+      /// interchangeable.
+      template<typename T, typename U, std::size_t Align>
+      bool operator==(const AlignedAllocator<T, Align> &,
+                      const AlignedAllocator<U, Align> &)
+      {
+        return true;
+      }
+
+      /// \brief All aligned allocators with the same alignment are
+      /// interchangeable.
+      template<typename T, typename U, std::size_t Align>
+      bool operator!=(const AlignedAllocator<T, Align> &,
+                      const AlignedAllocator<U, Align> &)
+      {
+        return false;
+      }
+    }
+    }
+  }
+}
+#endif
@@ -0,0 +1,111 @@
+/*
+ * Copyright (C) 2018 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef IGNITION_MATH_DETAIL_SOA_HH_
+#define IGNITION_MATH_DETAIL_SOA_HH_
+
+#include <ignition/math/config.hh>
+
+namespace ignition
+{
+  namespace math
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace IGNITION_MATH_VERSION_NAMESPACE {
+    namespace detail
+    {
+      /// \brief Read-only pointers to the x, y and z arrays of a
+      /// structure-of-arrays set of 3D vectors.
+      template<typename T>
+      struct ConstSoa3
+      {
+        /// \brief Array of x values
+        const T *x;
+
+        /// \brief Array of y values
+        const T *y;
+
+        /// \brief Array of z values
+        const T *z;
+      };
+
+      /// \brief Mutable pointers to the x, y and z arrays of a
+      /// structure-of-arrays set of 3D vectors.
+      template<typename T>
+      struct Soa3
+      {
+        /// \brief Conversion to read-only pointers
+        operator ConstSoa3<T>() const
+        {
+          return {this->x, this->y, this->z};
+        }
+
+        /// \brief Array of x values
+        T *x;
+
+        /// \brief Array of y values
+        T *y;
+
+        /// \brief Array of z values
+        T *z;
+      };
+
+      /// \brief Read-only pointers to the w, x, y and z arrays of a
+      /// structure-of-arrays set of quaternions.
+      template<typename T>
+      struct ConstSoa4
+      {
+        /// \brief Array of w values
+        const T *w;
+
+        /// \brief Array of x values
+        const T *x;
+
+        /// \brief Array of y values
+        const T *y;
+
+        /// \brief Array of z values
+        const T *z;
+      };
+
+      /// \brief Mutable pointers to the w, x, y and z arrays of a
+      /// structure-of-arrays set of quaternions.
+      template<typename T>
+      struct Soa4
+      {
+        /// \brief Conversion to read-only pointers
+        operator ConstSoa4<T>() const
+        {
+          return {this->w, this->x, this->y, this->z};
+        }
+
+        /// \brief Array of w values
+        T *w;
+
+        /// \brief Array of x values
+        T *x;
+
+        /// \brief Array of y values
+        T *y;
+
+        /// \brief Array of z values
+        T *z;
+      };
+    }
+    }
+  }
+}
+#endif
@@ -19,23 +19,12 @@
 
 using namespace ignition::math;
 
-const Angle Angle::Zero = Angle(0);
-const Angle Angle::Pi = Angle(IGN_PI);
-const Angle Angle::HalfPi = Angle(IGN_PI_2);
-const Angle Angle::TwoPi = Angle(IGN_PI * 2.0);
-
-//////////////////////////////////////////////////
-Angle::Angle()
-{
-  this->value = 0;
-}
-
-//////////////////////////////////////////////////
-Angle::Angle(const double _radian)
-{
-  this->value = _radian;
-}
+const Angle Angle::Zero(0);
+const Angle Angle::Pi(IGN_PI);
+const Angle Angle::HalfPi(IGN_PI_2);
+const Angle Angle::TwoPi(IGN_PI * 2.0);
 
+#ifndef IGNITION_MATH_POD_TYPES
 //////////////////////////////////////////////////
 Angle::Angle(const Angle &_angle)
 {
@@ -46,30 +35,7 @@ Angle::Angle(const Angle &_angle)
 Angle::~Angle()
 {
 }
-
-//////////////////////////////////////////////////
-void Angle::Radian(double _radian)
-{
-  this->value = _radian;
-}
-
-//////////////////////////////////////////////////
-void Angle::Degree(double _degree)
-{
-  this->value = _degree * IGN_PI / 180.0;
-}
-
-//////////////////////////////////////////////////
-double Angle::Radian() const
-{
-  return this->value;
-}
-
-//////////////////////////////////////////////////
-double Angle::Degree() const
-{
-  return this->value * 180.0 / IGN_PI;
-}
+#endif
 
 //////////////////////////////////////////////////
 void Angle::Normalize()
@@ -77,58 +43,6 @@ void Angle::Normalize()
   this->value = atan2(sin(this->value), cos(this->value));
 }
 
-//////////////////////////////////////////////////
-Angle Angle::operator-(const Angle &angle) const
-{
-  return Angle(this->value - angle.value);
-}
-
-//////////////////////////////////////////////////
-Angle Angle::operator+(const Angle &angle) const
-{
-  return Angle(this->value + angle.value);
-}
-
-//////////////////////////////////////////////////
-Angle Angle::operator*(const Angle &angle) const
-{
-  return Angle(this->value * angle.value);
-}
-
-//////////////////////////////////////////////////
-Angle Angle::operator/(const Angle &angle) const
-{
-  return Angle(this->value / angle.value);
-}
-
-//////////////////////////////////////////////////
-Angle Angle::operator-=(const Angle &angle)
-{
-  this->value -= angle.value;
-  return *this;
-}
-
-//////////////////////////////////////////////////
-Angle Angle::operator+=(const Angle &angle)
-{
-  this->value += angle.value;
-  return *this;
-}
-
-//////////////////////////////////////////////////
-Angle Angle::operator*=(const Angle &angle)
-{
-  this->value *= angle.value;
-  return *this;
-}
-
-//////////////////////////////////////////////////
-Angle Angle::operator/=(const Angle &angle)
-{
-  this->value /= angle.value;
-  return *this;
-}
-
 //////////////////////////////////////////////////
 bool Angle::operator==(const Angle &angle) const
 {
@@ -141,32 +55,15 @@ bool Angle::operator!=(const Angle &angle) const
   return !(*this == angle);
 }
 
-//////////////////////////////////////////////////
-bool Angle::operator<(const Angle &angle) const
-{
-  return this->value < angle.value;
-}
-
 //////////////////////////////////////////////////
 bool Angle::operator<=(const Angle &angle) const
 {
   return this->value < angle.value || equal(this->value, angle.value);
 }
 
-//////////////////////////////////////////////////
-bool Angle::operator>(const Angle &angle) const
-{
-  return this->value > angle.value;
-}
-
 //////////////////////////////////////////////////
 bool Angle::operator>=(const Angle &angle) const
 {
   return this->value > angle.value || equal(this->value, angle.value);
 }
 
-//////////////////////////////////////////////////
-double Angle::operator()() const
-{
-  return this->value;
-}
@@ -123,3 +123,19 @@ TEST(AngleTest, OperatorStreamOut)
   stream << a;
   EXPECT_EQ(stream.str(), "0.1");
 }
+
+/////////////////////////////////////////////////
+TEST(AngleTest, Constexpr)
+{
+  const math::Angle angle(IGN_PI);
+  const double degree = angle.Degree();
+  EXPECT_DOUBLE_EQ(degree, 180.0);
+  EXPECT_TRUE(math::Angle::Zero < angle);
+  EXPECT_DOUBLE_EQ(*math::Angle::HalfPi, IGN_PI_2);
+
+#ifdef IGNITION_MATH_POD_TYPES
+  constexpr math::Angle sum = math::Angle(IGN_PI) + math::Angle(1.0);
+  static_assert(!(sum.Radian() < IGN_PI + 1.0) &&
+      !(IGN_PI + 1.0 < sum.Radian()), "");
+#endif
+}
@@ -14,6 +14,7 @@
  * limitations under the License.
  *
 */
+#include <algorithm>
 #include <cmath>
 #include <ignition/math/AxisAlignedBox.hh>
 
@@ -30,6 +31,34 @@ class ignition::math::AxisAlignedBoxPrivate
   public: Vector3d max = Vector3d(LOW_D, LOW_D, LOW_D);
 };
 
+namespace
+{
+  //////////////////////////////////////////////////
+  /// \brief Grow the corners _min and _max to contain a set of points.
+  /// \param[in] _points The points.
+  /// \param[in,out] _min Minimum corner.
+  /// \param[in,out] _max Maximum corner.
+  template<typename T>
+  void MergePoints(const Vector3View<T> &_points, Vector3d &_min,
+      Vector3d &_max)
+  {
+    double minX = _min.X(), minY = _min.Y(), minZ = _min.Z();
+    double maxX = _max.X(), maxY = _max.Y(), maxZ = _max.Z();
+    const T *v = _points.Data();
+    for (std::size_t i = 0; i < _points.Size(); ++i, v += _points.Stride())
+    {
+      minX = std::min(minX, static_cast<double>(v[0]));
+      minY = std::min(minY, static_cast<double>(v[1]));
+      minZ = std::min(minZ, static_cast<double>(v[2]));
+      maxX = std::max(maxX, static_cast<double>(v[0]));
+      maxY = std::max(maxY, static_cast<double>(v[1]));
+      maxZ = std::max(maxZ, static_cast<double>(v[2]));
+    }
+    _min.Set(minX, minY, minZ);
+    _max.Set(maxX, maxY, maxZ);
+  }
+}  // namespace
+
 //////////////////////////////////////////////////
 AxisAlignedBox::AxisAlignedBox()
 : dataPtr(new AxisAlignedBoxPrivate)
@@ -114,6 +143,18 @@ void AxisAlignedBox::Merge(const AxisAlignedBox &_box)
   this->dataPtr->max.Max(_box.dataPtr->max);
 }
 
+//////////////////////////////////////////////////
+void AxisAlignedBox::Merge(const Vector3View<double> &_points)
+{
+  MergePoints(_points, this->dataPtr->min, this->dataPtr->max);
+}
+
+//////////////////////////////////////////////////
+void AxisAlignedBox::Merge(const Vector3View<float> &_points)
+{
+  MergePoints(_points, this->dataPtr->min, this->dataPtr->max);
+}
+
 //////////////////////////////////////////////////
 AxisAlignedBox &AxisAlignedBox::operator =(const AxisAlignedBox &_b)
 {
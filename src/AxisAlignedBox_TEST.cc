@@ -172,6 +172,33 @@ TEST(AxisAlignedBoxTest, MergeEmpty)
   EXPECT_DOUBLE_EQ(box1.Max().Z(), LOW_D);
 }
 
+/////////////////////////////////////////////////
+TEST(AxisAlignedBoxTest, MergePoints)
+{
+  const double points[] = {1, -2, 3, 0, -4, 5, 0.5, 2, -1};
+
+  AxisAlignedBox box;
+  box.Merge(Vector3Viewd(points, 3));
+  EXPECT_EQ(Vector3d(0, -4, -1), box.Min());
+  EXPECT_EQ(Vector3d(1, 2, 5), box.Max());
+
+  // Points inside the box do not change it
+  box.Merge(Vector3Viewd(points + 3, 1));
+  EXPECT_EQ(Vector3d(0, -4, -1), box.Min());
+  EXPECT_EQ(Vector3d(1, 2, 5), box.Max());
+
+  // Float buffer, with a stride of 4
+  const float floats[] = {10, 0, 0, -1, 0, 0, -10, -1};
+  box.Merge(Vector3Viewf(floats, 2, 4));
+  EXPECT_EQ(Vector3d(0, -4, -10), box.Min());
+  EXPECT_EQ(Vector3d(10, 2, 5), box.Max());
+
+  // An empty view leaves the box unchanged
+  AxisAlignedBox empty;
+  empty.Merge(Vector3Viewd());
+  EXPECT_EQ(AxisAlignedBox(), empty);
+}
+
 /////////////////////////////////////////////////
 TEST(AxisAlignedBoxTest, DefaultConstructor)
 {
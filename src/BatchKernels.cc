@@ -0,0 +1,131 @@
+/*
+ * Copyright (C) 2018 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include "ignition/math/SimdDispatch.hh"
+#include "BatchKernelsImpl.hh"
+
+using namespace ignition;
+using namespace math;
+
+namespace target = simd::IGNITION_MATH_SIMD_TARGET;
+
+namespace
+{
+  /// \brief Number of values of SimdLevel
+  const int kLevelCount = static_cast<int>(SimdLevel::AVX512) + 1;
+
+  //////////////////////////////////////////////////
+  /// \brief Build the table of each level. Levels without their own
+  /// kernels, or that are not supported, use those of the level below.
+  /// \param[in] _tables Output tables, indexed by SimdLevel.
+  template<typename T>
+  void FillTables(simd::BatchKernelTable<T> *_tables)
+  {
+    const simd::BatchKernelTable<T> *levels[kLevelCount] =
+    {
+      simd::BatchKernelsScalar<T>(),
+      simd::BatchKernelsSse2<T>(),
+      simd::BatchKernelsSse42<T>(),
+      simd::BatchKernelsAvx2<T>(),
+      simd::BatchKernelsAvx512<T>()
+    };
+    const int supported = static_cast<int>(SimdDispatch::SupportedLevel());
+    _tables[0] = *levels[0];
+    for (int i = 1; i < kLevelCount; ++i)
+    {
+      _tables[i] = levels[i] && i <= supported ? *levels[i] :
+        _tables[i - 1];
+    }
+  }
+
+  //////////////////////////////////////////////////
+  /// \brief Get the table of the active level. The tables of all levels
+  /// are built on first use, so that changing the level is cheap.
+  /// \return The active table.
+  template<typename T>
+  const simd::BatchKernelTable<T> &ActiveTable()
+  {
+    struct Tables
+    {
+      Tables() { FillTables<T>(this->level); }
+      simd::BatchKernelTable<T> level[kLevelCount];
+    };
+    static const Tables tables;
+    return tables.level[static_cast<int>(SimdDispatch::ActiveLevel())];
+  }
+}  // namespace
+
+//////////////////////////////////////////////////
+template<>
+const simd::BatchKernelTable<float> *simd::BatchKernelsScalar<float>()
+{
+  static constexpr BatchKernelTable<float> table =
+    target::MakeBatchKernelTable<float,
+        target::ScalarPack<float>>();
+  return &table;
+}
+
+//////////////////////////////////////////////////
+template<>
+const simd::BatchKernelTable<double> *simd::BatchKernelsScalar<double>()
+{
+  static constexpr BatchKernelTable<double> table =
+    target::MakeBatchKernelTable<double,
+        target::ScalarPack<double>>();
+  return &table;
+}
+
+//////////////////////////////////////////////////
+template<>
+const simd::BatchKernelTable<float> *simd::BatchKernelsSse2<float>()
+{
+#ifdef IGNITION_MATH_SIMD_SSE2
+  static constexpr BatchKernelTable<float> table =
+    target::MakeBatchKernelTable<float,
+        target::Sse2Pack<float>>();
+  return &table;
+#else
+  return nullptr;
+#endif
+}
+
+//////////////////////////////////////////////////
+template<>
+const simd::BatchKernelTable<double> *simd::BatchKernelsSse2<double>()
+{
+#ifdef IGNITION_MATH_SIMD_SSE2
+  static constexpr BatchKernelTable<double> table =
+    target::MakeBatchKernelTable<double,
+        target::Sse2Pack<double>>();
+  return &table;
+#else
+  return nullptr;
+#endif
+}
+
+//////////////////////////////////////////////////
+template<>
+const simd::BatchKernelTable<float> &simd::BatchKernels<float>()
+{
+  return ActiveTable<float>();
+}
+
+//////////////////////////////////////////////////
+template<>
+const simd::BatchKernelTable<double> &simd::BatchKernels<double>()
+{
+  return ActiveTable<double>();
+}
@@ -0,0 +1,239 @@
+/*
+ * Copyright (C) 2018 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef IGNITION_MATH_BATCHKERNELS_HH_
+#define IGNITION_MATH_BATCHKERNELS_HH_
+
+#include <cstddef>
+
+#include <ignition/math/config.hh>
+#include <ignition/math/detail/Soa.hh>
+
+// This header is included by translation units compiled with instruction
+// sets that are not always available at runtime. Like Matrix4Kernels.hh,
+// it must not bring in inline functions that these units would call, so
+// vectors, quaternions and matrices are passed as plain arrays.
+
+namespace ignition
+{
+  namespace math
+  {
+    inline namespace IGNITION_MATH_VERSION_NAMESPACE
+    {
+    namespace simd
+    {
+    /// \internal
+    /// \brief Batch kernels of Vector3Array, QuaternionArray, RayPacket,
+    /// BoxPacket, TriangleMesh, Frustum, OrientedBoxPacket and Line3
+    /// compiled for one instruction set. See
+    /// Vector3ArrayKernels and QuaternionArrayKernels for the description
+    /// of the vector and quaternion kernels.
+    template<typename T>
+    struct BatchKernelTable
+    {
+      /// \brief _out = _a + _b
+      void (*add)(detail::ConstSoa3<T> _a, detail::ConstSoa3<T> _b,
+          detail::Soa3<T> _out, std::size_t _n);
+
+      /// \brief _out = _a + _v, with _v given as x, y, z
+      void (*addVector)(detail::ConstSoa3<T> _a, const T *_v,
+          detail::Soa3<T> _out, std::size_t _n);
+
+      /// \brief _out = _a * _s
+      void (*scale)(detail::ConstSoa3<T> _a, T _s, detail::Soa3<T> _out,
+          std::size_t _n);
+
+      /// \brief _out[i] = _a[i].Dot(_b[i])
+      void (*dot)(detail::ConstSoa3<T> _a, detail::ConstSoa3<T> _b,
+          T *_out, std::size_t _n);
+
+      /// \brief _out[i] = _a[i].Dot(_v), with _v given as x, y, z
+      void (*dotVector)(detail::ConstSoa3<T> _a, const T *_v, T *_out,
+          std::size_t _n);
+
+      /// \brief _out[i] = _a[i].Cross(_b[i])
+      void (*cross)(detail::ConstSoa3<T> _a, detail::ConstSoa3<T> _b,
+          detail::Soa3<T> _out, std::size_t _n);
+
+      /// \brief _out[i] = _a[i].Length()
+      void (*length)(detail::ConstSoa3<T> _a, T *_out, std::size_t _n);
+
+      /// \brief _out[i] = _a[i].Normalized()
+      void (*normalize)(detail::ConstSoa3<T> _a, detail::Soa3<T> _out,
+          std::size_t _n);
+
+      /// \brief _out[i] = _a[i].Distance(_pt), with _pt given as x, y, z
+      void (*distance)(detail::ConstSoa3<T> _a, const T *_pt, T *_out,
+          std::size_t _n);
+
+      /// \brief _out[i] = _rot * (_a[i] + _pre) + _post, with _rot given
+      /// as 9 values in row-major order
+      void (*transform)(detail::ConstSoa3<T> _a, const T *_rot,
+          const T *_pre, const T *_post, detail::Soa3<T> _out,
+          std::size_t _n);
+
+      /// \brief Component-wise minimum and maximum of _n > 0 vectors
+      void (*minMax)(detail::ConstSoa3<T> _a, std::size_t _n, T *_min,
+          T *_max);
+
+      /// \brief _out = _a * _b, for quaternions
+      void (*quaternionMultiply)(detail::ConstSoa4<T> _a,
+          detail::ConstSoa4<T> _b, detail::Soa4<T> _out, std::size_t _n);
+
+      /// \brief _out = _a * _q, with _q given as w, x, y, z
+      void (*quaternionMultiplyOne)(detail::ConstSoa4<T> _a, const T *_q,
+          detail::Soa4<T> _out, std::size_t _n);
+
+      /// \brief _out[i] = _a[i].Normalized()
+      void (*quaternionNormalize)(detail::ConstSoa4<T> _a,
+          detail::Soa4<T> _out, std::size_t _n);
+
+      /// \brief Rotate the vectors _v by _q (_sign = 1) or by its inverse
+      /// (_sign = -1)
+      void (*quaternionRotate)(detail::ConstSoa4<T> _q,
+          detail::ConstSoa3<T> _v, detail::Soa3<T> _out, T _sign,
+          std::size_t _n);
+
+      /// \brief Normalized linear interpolation. _t holds one value, or
+      /// one value per quaternion if _tStride is not zero.
+      void (*quaternionNlerp)(detail::ConstSoa4<T> _a,
+          detail::ConstSoa4<T> _b, const T *_t, std::size_t _tStride,
+          bool _shortestPath, detail::Soa4<T> _out, std::size_t _n);
+
+      /// \brief Spherical linear interpolation, with the same arguments as
+      /// quaternionNlerp
+      void (*quaternionSlerp)(detail::ConstSoa4<T> _a,
+          detail::ConstSoa4<T> _b, const T *_t, std::size_t _tStride,
+          bool _shortestPath, detail::Soa4<T> _out, std::size_t _n);
+
+      /// \brief Slab test of _n rays against one box. Ray i starts at
+      /// _start[i], has the inverse unit direction _invDir[i] and the
+      /// length _length[i]. _box holds the minimum then the maximum
+      /// corner. _dist[i] is the distance from the start to the entry
+      /// point, or -1 if the ray misses the box.
+      void (*rayBox)(detail::ConstSoa3<T> _start,
+          detail::ConstSoa3<T> _invDir, const T *_length, const T *_box,
+          T *_dist, std::size_t _n);
+
+      /// \brief Slab test of one ray against _n boxes with corners _min[i]
+      /// and _max[i], with the same ray description and results as rayBox.
+      void (*boxRay)(detail::ConstSoa3<T> _min, detail::ConstSoa3<T> _max,
+          const T *_start, const T *_invDir, T _length, T *_dist,
+          std::size_t _n);
+
+      /// \brief Watertight test of one ray against _n triangles with
+      /// corners _a[i], _b[i] and _c[i]. The components of the corners and
+      /// of _origin are permuted so that z is the largest component of the
+      /// ray direction, and _shear holds the shear and scale constants of
+      /// the ray. _dist[i] is the distance from _origin to the hit, or -1
+      /// if the ray misses the triangle or the distance is not in
+      /// [_tMin, _tMax].
+      void (*rayTriangle)(detail::ConstSoa3<T> _a, detail::ConstSoa3<T> _b,
+          detail::ConstSoa3<T> _c, const T *_origin, const T *_shear,
+          T _tMin, T _tMax, T *_dist, std::size_t _n);
+
+      /// \brief Side of _n boxes with corners _min[i] and _max[i] against
+      /// _count planes, computed like Plane::Side. _planes holds the normal
+      /// and the offset of each plane, and _bits the value that marks each
+      /// plane in _code. _code[i] is -1 if box i is on the negative side of
+      /// a plane, otherwise the sum of the bits of the planes it crosses.
+      void (*planesBox)(detail::ConstSoa3<T> _min, detail::ConstSoa3<T> _max,
+          const T *_planes, const T *_bits, std::size_t _count, T *_code,
+          std::size_t _n);
+
+      /// \brief Separating axis test of one oriented box against _n
+      /// others, with the operations of OrientedBox::Intersects. Box i has
+      /// the center _center[i], the axes _axisX[i], _axisY[i] and
+      /// _axisZ[i], and the half size _half[i]. _box holds the center, the
+      /// rotation matrix in row-major order and the half size of the single
+      /// box. _hit[i] is 1 if the boxes overlap, 0 otherwise.
+      void (*orientedBoxes)(detail::ConstSoa3<T> _center,
+          detail::ConstSoa3<T> _axisX, detail::ConstSoa3<T> _axisY,
+          detail::ConstSoa3<T> _axisZ, detail::ConstSoa3<T> _half,
+          const T *_box, T *_hit, std::size_t _n);
+
+      /// \brief _inside[i] = 1 if each component of _rot * (_a[i] + _pre)
+      /// lies in [-_half, _half], 0 otherwise, with _rot given as 9 values
+      /// in row-major order
+      void (*pointsInBox)(detail::ConstSoa3<T> _a, const T *_rot,
+          const T *_pre, const T *_half, T *_inside, std::size_t _n);
+
+      /// \brief Closest points _pointA[i] and _pointB[i] between the
+      /// segments from _startA[i] to _endA[i] and from _startB[i] to
+      /// _endB[i], and their squared distance _sqDist[i]
+      void (*segments)(detail::ConstSoa3<T> _startA,
+          detail::ConstSoa3<T> _endA, detail::ConstSoa3<T> _startB,
+          detail::ConstSoa3<T> _endB, detail::Soa3<T> _pointA,
+          detail::Soa3<T> _pointB, T *_sqDist, std::size_t _n);
+    };
+
+    /// \internal
+    /// \brief Get the portable kernels.
+    /// \return The kernels, never null.
+    template<typename T>
+    const BatchKernelTable<T> *BatchKernelsScalar();
+
+    /// \internal
+    /// \brief Get the kernels compiled for SSE2.
+    /// \return The kernels, or nullptr if the library was built without
+    /// them.
+    template<typename T>
+    const BatchKernelTable<T> *BatchKernelsSse2();
+
+    /// \internal
+    /// \brief Get the kernels compiled for SSE4.2.
+    /// \return The kernels, or nullptr if the library was built without
+    /// them.
+    template<typename T>
+    const BatchKernelTable<T> *BatchKernelsSse42();
+
+    /// \internal
+    /// \brief Get the kernels compiled for AVX2 and FMA.
+    /// \return The kernels, or nullptr if the library was built without
+    /// them.
+    template<typename T>
+    const BatchKernelTable<T> *BatchKernelsAvx2();
+
+    /// \internal
+    /// \brief Get the kernels compiled for AVX-512F.
+    /// \return The kernels, or nullptr if the library was built without
+    /// them.
+    template<typename T>
+    const BatchKernelTable<T> *BatchKernelsAvx512();
+
+    /// \internal
+    /// \brief Get the kernels of the level selected by SimdDispatch.
+    /// \return The active kernels.
+    template<typename T>
+    const BatchKernelTable<T> &BatchKernels();
+
+    template<> const BatchKernelTable<float> *BatchKernelsScalar<float>();
+    template<> const BatchKernelTable<double> *BatchKernelsScalar<double>();
+    template<> const BatchKernelTable<float> *BatchKernelsSse2<float>();
+    template<> const BatchKernelTable<double> *BatchKernelsSse2<double>();
+    template<> const BatchKernelTable<float> *BatchKernelsSse42<float>();
+    template<> const BatchKernelTable<double> *BatchKernelsSse42<double>();
+    template<> const BatchKernelTable<float> *BatchKernelsAvx2<float>();
+    template<> const BatchKernelTable<double> *BatchKernelsAvx2<double>();
+    template<> const BatchKernelTable<float> *BatchKernelsAvx512<float>();
+    template<> const BatchKernelTable<double> *BatchKernelsAvx512<double>();
+    template<> const BatchKernelTable<float> &BatchKernels<float>();
+    template<> const BatchKernelTable<double> &BatchKernels<double>();
+    }
+    }
+  }
+}
+#endif
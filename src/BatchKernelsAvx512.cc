@@ -0,0 +1,54 @@
+/*
+ * Copyright (C) 2018 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+// This file is compiled with AVX-512F enabled. Its kernels are only used
+// when SimdDispatch selects SimdLevel::AVX512.
+#define IGNITION_MATH_SIMD_TARGET avx512
+
+#include "BatchKernelsImpl.hh"
+
+using namespace ignition;
+using namespace math;
+
+namespace target = simd::IGNITION_MATH_SIMD_TARGET;
+
+//////////////////////////////////////////////////
+template<>
+const simd::BatchKernelTable<float> *simd::BatchKernelsAvx512<float>()
+{
+#ifdef IGNITION_MATH_SIMD_AVX512
+  static constexpr BatchKernelTable<float> table =
+    target::MakeBatchKernelTable<float,
+        target::Avx512Pack<float>>();
+  return &table;
+#else
+  return nullptr;
+#endif
+}
+
+//////////////////////////////////////////////////
+template<>
+const simd::BatchKernelTable<double> *simd::BatchKernelsAvx512<double>()
+{
+#ifdef IGNITION_MATH_SIMD_AVX512
+  static constexpr BatchKernelTable<double> table =
+    target::MakeBatchKernelTable<double,
+        target::Avx512Pack<double>>();
+  return &table;
+#else
+  return nullptr;
+#endif
+}
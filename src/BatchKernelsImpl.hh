@@ -0,0 +1,1124 @@
+/*
+ * Copyright (C) 2018 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef IGNITION_MATH_BATCHKERNELSIMPL_HH_
+#define IGNITION_MATH_BATCHKERNELSIMPL_HH_
+
+#include <cstddef>
+#include <limits>
+#include <type_traits>
+
+#include "BatchKernels.hh"
+#include "SimdPack.hh"
+
+// Implementation of the batch kernels, included once by each translation
+// unit that builds a BatchKernelTable. Everything is placed in the
+// namespace of the instruction set selected by IGNITION_MATH_SIMD_TARGET,
+// so that the copies compiled with different flags never get merged by
+// the linker.
+
+namespace ignition
+{
+  namespace math
+  {
+    inline namespace IGNITION_MATH_VERSION_NAMESPACE
+    {
+    namespace simd
+    {
+    namespace IGNITION_MATH_SIMD_TARGET
+    {
+  using detail::ConstSoa3;
+  using detail::ConstSoa4;
+  using detail::Soa3;
+  using detail::Soa4;
+
+  /// \brief Pi, IGN_PI is not used to keep Helpers.hh out of the
+  /// instruction set specific translation units.
+  const double kPi = 3.14159265358979323846;
+
+  //////////////////////////////////////////////////
+  template<typename T, typename Wide>
+  void AddImpl(ConstSoa3<T> _a, ConstSoa3<T> _b, Soa3<T> _out,
+      const std::size_t _n)
+  {
+    ForEach<T, Wide>(_n, [&](auto _p, const std::size_t _i)
+    {
+      typedef decltype(_p) P;
+      P::Store(_out.x + _i, P::Add(P::Load(_a.x + _i), P::Load(_b.x + _i)));
+      P::Store(_out.y + _i, P::Add(P::Load(_a.y + _i), P::Load(_b.y + _i)));
+      P::Store(_out.z + _i, P::Add(P::Load(_a.z + _i), P::Load(_b.z + _i)));
+    });
+  }
+
+  //////////////////////////////////////////////////
+  template<typename T, typename Wide>
+  void AddVectorImpl(ConstSoa3<T> _a, const T *_v, Soa3<T> _out,
+      const std::size_t _n)
+  {
+    ForEach<T, Wide>(_n, [&](auto _p, const std::size_t _i)
+    {
+      typedef decltype(_p) P;
+      P::Store(_out.x + _i, P::Add(P::Load(_a.x + _i), P::Set1(_v[0])));
+      P::Store(_out.y + _i, P::Add(P::Load(_a.y + _i), P::Set1(_v[1])));
+      P::Store(_out.z + _i, P::Add(P::Load(_a.z + _i), P::Set1(_v[2])));
+    });
+  }
+
+  //////////////////////////////////////////////////
+  template<typename T, typename Wide>
+  void ScaleImpl(ConstSoa3<T> _a, const T _s, Soa3<T> _out,
+      const std::size_t _n)
+  {
+    ForEach<T, Wide>(_n, [&](auto _p, const std::size_t _i)
+    {
+      typedef decltype(_p) P;
+      const auto s = P::Set1(_s);
+      P::Store(_out.x + _i, P::Mul(P::Load(_a.x + _i), s));
+      P::Store(_out.y + _i, P::Mul(P::Load(_a.y + _i), s));
+      P::Store(_out.z + _i, P::Mul(P::Load(_a.z + _i), s));
+    });
+  }
+
+  //////////////////////////////////////////////////
+  template<typename T, typename Wide>
+  void DotImpl(ConstSoa3<T> _a, ConstSoa3<T> _b, T *_out,
+      const std::size_t _n)
+  {
+    ForEach<T, Wide>(_n, [&](auto _p, const std::size_t _i)
+    {
+      typedef decltype(_p) P;
+      const auto x = P::Mul(P::Load(_a.x + _i), P::Load(_b.x + _i));
+      const auto y = P::Mul(P::Load(_a.y + _i), P::Load(_b.y + _i));
+      const auto z = P::Mul(P::Load(_a.z + _i), P::Load(_b.z + _i));
+      P::Store(_out + _i, P::Add(P::Add(x, y), z));
+    });
+  }
+
+  //////////////////////////////////////////////////
+  template<typename T, typename Wide>
+  void DotVectorImpl(ConstSoa3<T> _a, const T *_v, T *_out,
+      const std::size_t _n)
+  {
+    ForEach<T, Wide>(_n, [&](auto _p, const std::size_t _i)
+    {
+      typedef decltype(_p) P;
+      const auto x = P::Mul(P::Load(_a.x + _i), P::Set1(_v[0]));
+      const auto y = P::Mul(P::Load(_a.y + _i), P::Set1(_v[1]));
+      const auto z = P::Mul(P::Load(_a.z + _i), P::Set1(_v[2]));
+      P::Store(_out + _i, P::Add(P::Add(x, y), z));
+    });
+  }
+
+  //////////////////////////////////////////////////
+  template<typename T, typename Wide>
+  void CrossImpl(ConstSoa3<T> _a, ConstSoa3<T> _b, Soa3<T> _out,
+      const std::size_t _n)
+  {
+    ForEach<T, Wide>(_n, [&](auto _p, const std::size_t _i)
+    {
+      typedef decltype(_p) P;
+      const auto ax = P::Load(_a.x + _i);
+      const auto ay = P::Load(_a.y + _i);
+      const auto az = P::Load(_a.z + _i);
+      const auto bx = P::Load(_b.x + _i);
+      const auto by = P::Load(_b.y + _i);
+      const auto bz = P::Load(_b.z + _i);
+      P::Store(_out.x + _i, P::Sub(P::Mul(ay, bz), P::Mul(az, by)));
+      P::Store(_out.y + _i, P::Sub(P::Mul(az, bx), P::Mul(ax, bz)));
+      P::Store(_out.z + _i, P::Sub(P::Mul(ax, by), P::Mul(ay, bx)));
+    });
+  }
+
+  //////////////////////////////////////////////////
+  template<typename T, typename Wide>
+  void LengthImpl(ConstSoa3<T> _a, T *_out, const std::size_t _n)
+  {
+    ForEach<T, Wide>(_n, [&](auto _p, const std::size_t _i)
+    {
+      typedef decltype(_p) P;
+      const auto x = P::Load(_a.x + _i);
+      const auto y = P::Load(_a.y + _i);
+      const auto z = P::Load(_a.z + _i);
+      P::Store(_out + _i, P::Sqrt(
+            P::Add(P::Add(P::Mul(x, x), P::Mul(y, y)), P::Mul(z, z))));
+    });
+  }
+
+  //////////////////////////////////////////////////
+  template<typename T, typename Wide>
+  void NormalizeImpl(ConstSoa3<T> _a, Soa3<T> _out, const std::size_t _n)
+  {
+    // Same tolerance as the equal() test of Vector3::Normalize()
+    const T tol = static_cast<T>(1e-6);
+    ForEach<T, Wide>(_n, [&](auto _p, const std::size_t _i)
+    {
+      typedef decltype(_p) P;
+      const auto x = P::Load(_a.x + _i);
+      const auto y = P::Load(_a.y + _i);
+      const auto z = P::Load(_a.z + _i);
+      const auto d = P::Sqrt(
+          P::Add(P::Add(P::Mul(x, x), P::Mul(y, y)), P::Mul(z, z)));
+      const auto valid = P::Gt(d, P::Set1(tol));
+      P::Store(_out.x + _i, P::Select(valid, P::Div(x, d), x));
+      P::Store(_out.y + _i, P::Select(valid, P::Div(y, d), y));
+      P::Store(_out.z + _i, P::Select(valid, P::Div(z, d), z));
+    });
+  }
+
+  //////////////////////////////////////////////////
+  template<typename T, typename Wide>
+  void DistanceImpl(ConstSoa3<T> _a, const T *_pt, T *_out,
+      const std::size_t _n)
+  {
+    ForEach<T, Wide>(_n, [&](auto _p, const std::size_t _i)
+    {
+      typedef decltype(_p) P;
+      const auto dx = P::Sub(P::Load(_a.x + _i), P::Set1(_pt[0]));
+      const auto dy = P::Sub(P::Load(_a.y + _i), P::Set1(_pt[1]));
+      const auto dz = P::Sub(P::Load(_a.z + _i), P::Set1(_pt[2]));
+      P::Store(_out + _i, P::Sqrt(
+            P::Add(P::Add(P::Mul(dx, dx), P::Mul(dy, dy)), P::Mul(dz, dz))));
+    });
+  }
+
+  //////////////////////////////////////////////////
+  template<typename T, typename Wide>
+  void TransformImpl(ConstSoa3<T> _a, const T *_rot, const T *_pre,
+      const T *_post, Soa3<T> _out, const std::size_t _n)
+  {
+    // Local copies, so that the compiler knows the output stores cannot
+    // modify them and keeps them in registers.
+    const T r[9] = {_rot[0], _rot[1], _rot[2],
+                    _rot[3], _rot[4], _rot[5],
+                    _rot[6], _rot[7], _rot[8]};
+    const T pre[3] = {_pre[0], _pre[1], _pre[2]};
+    const T post[3] = {_post[0], _post[1], _post[2]};
+
+    ForEach<T, Wide>(_n, [&](auto _p, const std::size_t _i)
+    {
+      typedef decltype(_p) P;
+      const auto x = P::Add(P::Load(_a.x + _i), P::Set1(pre[0]));
+      const auto y = P::Add(P::Load(_a.y + _i), P::Set1(pre[1]));
+      const auto z = P::Add(P::Load(_a.z + _i), P::Set1(pre[2]));
+      P::Store(_out.x + _i, P::Add(P::Add(P::Add(
+                P::Mul(P::Set1(r[0]), x),
+                P::Mul(P::Set1(r[1]), y)),
+                P::Mul(P::Set1(r[2]), z)), P::Set1(post[0])));
+      P::Store(_out.y + _i, P::Add(P::Add(P::Add(
+                P::Mul(P::Set1(r[3]), x),
+                P::Mul(P::Set1(r[4]), y)),
+                P::Mul(P::Set1(r[5]), z)), P::Set1(post[1])));
+      P::Store(_out.z + _i, P::Add(P::Add(P::Add(
+                P::Mul(P::Set1(r[6]), x),
+                P::Mul(P::Set1(r[7]), y)),
+                P::Mul(P::Set1(r[8]), z)), P::Set1(post[2])));
+    });
+  }
+
+  //////////////////////////////////////////////////
+  template<typename T, typename Wide>
+  void MinMaxImpl(ConstSoa3<T> _a, const std::size_t _n, T *_min,
+      T *_max)
+  {
+    typedef Wide P;
+
+    T minX = _a.x[0], minY = _a.y[0], minZ = _a.z[0];
+    T maxX = _a.x[0], maxY = _a.y[0], maxZ = _a.z[0];
+
+    std::size_t i = 0;
+    if (_n >= P::Width)
+    {
+      auto vMinX = P::Load(_a.x), vMaxX = vMinX;
+      auto vMinY = P::Load(_a.y), vMaxY = vMinY;
+      auto vMinZ = P::Load(_a.z), vMaxZ = vMinZ;
+      for (i = P::Width; i + P::Width <= _n; i += P::Width)
+      {
+        const auto x = P::Load(_a.x + i);
+        const auto y = P::Load(_a.y + i);
+        const auto z = P::Load(_a.z + i);
+        vMinX = P::Min(vMinX, x);
+        vMaxX = P::Max(vMaxX, x);
+        vMinY = P::Min(vMinY, y);
+        vMaxY = P::Max(vMaxY, y);
+        vMinZ = P::Min(vMinZ, z);
+        vMaxZ = P::Max(vMaxZ, z);
+      }
+      minX = P::ReduceMin(vMinX);
+      minY = P::ReduceMin(vMinY);
+      minZ = P::ReduceMin(vMinZ);
+      maxX = P::ReduceMax(vMaxX);
+      maxY = P::ReduceMax(vMaxY);
+      maxZ = P::ReduceMax(vMaxZ);
+    }
+
+    for (; i < _n; ++i)
+    {
+      minX = ScalarPack<T>::Min(minX, _a.x[i]);
+      minY = ScalarPack<T>::Min(minY, _a.y[i]);
+      minZ = ScalarPack<T>::Min(minZ, _a.z[i]);
+      maxX = ScalarPack<T>::Max(maxX, _a.x[i]);
+      maxY = ScalarPack<T>::Max(maxY, _a.y[i]);
+      maxZ = ScalarPack<T>::Max(maxZ, _a.z[i]);
+    }
+
+    _min[0] = minX;
+    _min[1] = minY;
+    _min[2] = minZ;
+    _max[0] = maxX;
+    _max[1] = maxY;
+    _max[2] = maxZ;
+  }
+
+  //////////////////////////////////////////////////
+  /// \brief Taylor coefficients of sin(x) / x, as a polynomial in x^2
+  const double kSinCoeffs[] =
+  {
+    1.0,
+    -1.0 / 6.0,
+    1.0 / 120.0,
+    -1.0 / 5040.0,
+    1.0 / 362880.0,
+    -1.0 / 39916800.0,
+    1.0 / 6227020800.0,
+    -1.0 / 1307674368000.0,
+    1.0 / 355687428096000.0,
+    -1.0 / 121645100408832000.0,
+    1.0 / 51090942171709440000.0
+  };
+
+  /// \brief Taylor coefficients of atan(x) / x, as a polynomial in x^2
+  const double kAtanCoeffs[] =
+  {
+    1.0, -1.0 / 3.0, 1.0 / 5.0, -1.0 / 7.0, 1.0 / 9.0, -1.0 / 11.0,
+    1.0 / 13.0, -1.0 / 15.0, 1.0 / 17.0, -1.0 / 19.0, 1.0 / 21.0,
+    -1.0 / 23.0
+  };
+
+  //////////////////////////////////////////////////
+  /// \brief Evaluate _x * (c[0] + c[1] x^2 + ... + c[_count-1] x^(2n)).
+  template<typename T, typename P>
+  typename P::Reg OddPolynomial(const double *_coeffs, const int _count,
+      const typename P::Reg _x)
+  {
+    const auto x2 = P::Mul(_x, _x);
+    auto r = P::Set1(static_cast<T>(_coeffs[_count - 1]));
+    for (int k = _count - 2; k >= 0; --k)
+      r = P::Add(P::Mul(r, x2), P::Set1(static_cast<T>(_coeffs[k])));
+    return P::Mul(_x, r);
+  }
+
+  //////////////////////////////////////////////////
+  /// \brief Sine of angles in [0, pi]. The angle is first reduced to
+  /// [0, pi/2], where the truncated Taylor series is accurate to the
+  /// precision of T.
+  template<typename T, typename P>
+  typename P::Reg SinPositive(const typename P::Reg _x)
+  {
+    const int count = std::is_same<T, float>::value ? 6 : 11;
+    const auto x = P::Min(_x, P::Sub(P::Set1(static_cast<T>(kPi)), _x));
+    return OddPolynomial<T, P>(kSinCoeffs, count, x);
+  }
+
+  //////////////////////////////////////////////////
+  /// \brief atan2(_s, _c) for _s >= 0 and _c >= 0. Two half angle
+  /// reductions bring the tangent below tan(pi/16), where the truncated
+  /// Taylor series of atan is accurate to the precision of T.
+  template<typename T, typename P>
+  typename P::Reg AtanFirstQuadrant(const typename P::Reg _s,
+      const typename P::Reg _c)
+  {
+    const int count = std::is_same<T, float>::value ? 6 : 12;
+    const auto one = P::Set1(static_cast<T>(1));
+
+    // tan(a/2) = sin(a) / (1 + cos(a)), then
+    // tan(a/4) = h / (1 + sqrt(1 + h^2)) and so on.
+    auto h = P::Div(_s, P::Add(one, _c));
+    h = P::Div(h, P::Add(one, P::Sqrt(P::Add(one, P::Mul(h, h)))));
+    h = P::Div(h, P::Add(one, P::Sqrt(P::Add(one, P::Mul(h, h)))));
+    return P::Mul(P::Set1(static_cast<T>(8)),
+        OddPolynomial<T, P>(kAtanCoeffs, count, h));
+  }
+
+  //////////////////////////////////////////////////
+  /// \brief Normalize quaternions in place, replacing the ones with a
+  /// length of zero by the identity as Quaternion::Normalize() does.
+  template<typename T, typename P>
+  void Normalize4(typename P::Reg &_w, typename P::Reg &_x,
+      typename P::Reg &_y, typename P::Reg &_z)
+  {
+    const auto s = P::Sqrt(P::Add(P::Add(P::Mul(_w, _w), P::Mul(_x, _x)),
+          P::Add(P::Mul(_y, _y), P::Mul(_z, _z))));
+    // Same tolerance as the equal() test of Quaternion::Normalize()
+    const auto valid = P::Gt(s, P::Set1(static_cast<T>(1e-6)));
+    const auto zero = P::Set1(static_cast<T>(0));
+    _w = P::Select(valid, P::Div(_w, s), P::Set1(static_cast<T>(1)));
+    _x = P::Select(valid, P::Div(_x, s), zero);
+    _y = P::Select(valid, P::Div(_y, s), zero);
+    _z = P::Select(valid, P::Div(_z, s), zero);
+  }
+
+  //////////////////////////////////////////////////
+  template<typename T, typename P>
+  void StoreQuaternion(Soa4<T> _out, const std::size_t _i,
+      const typename P::Reg _w, const typename P::Reg _x,
+      const typename P::Reg _y, const typename P::Reg _z)
+  {
+    P::Store(_out.w + _i, _w);
+    P::Store(_out.x + _i, _x);
+    P::Store(_out.y + _i, _y);
+    P::Store(_out.z + _i, _z);
+  }
+
+  //////////////////////////////////////////////////
+  /// \brief Hamilton product, with the same expressions as
+  /// Quaternion::operator*.
+  template<typename T, typename P>
+  void MultiplyPack(Soa4<T> _out, const std::size_t _i,
+      const typename P::Reg _aw, const typename P::Reg _ax,
+      const typename P::Reg _ay, const typename P::Reg _az,
+      const typename P::Reg _bw, const typename P::Reg _bx,
+      const typename P::Reg _by, const typename P::Reg _bz)
+  {
+    const auto w = P::Sub(P::Sub(P::Sub(P::Mul(_aw, _bw),
+            P::Mul(_ax, _bx)), P::Mul(_ay, _by)), P::Mul(_az, _bz));
+    const auto x = P::Sub(P::Add(P::Add(P::Mul(_aw, _bx),
+            P::Mul(_ax, _bw)), P::Mul(_ay, _bz)), P::Mul(_az, _by));
+    const auto y = P::Add(P::Add(P::Sub(P::Mul(_aw, _by),
+            P::Mul(_ax, _bz)), P::Mul(_ay, _bw)), P::Mul(_az, _bx));
+    const auto z = P::Add(P::Sub(P::Add(P::Mul(_aw, _bz),
+            P::Mul(_ax, _by)), P::Mul(_ay, _bx)), P::Mul(_az, _bw));
+    StoreQuaternion<T, P>(_out, _i, w, x, y, z);
+  }
+
+  //////////////////////////////////////////////////
+  template<typename T, typename Wide>
+  void QuaternionMultiplyImpl(ConstSoa4<T> _a, ConstSoa4<T> _b,
+      Soa4<T> _out,
+      const std::size_t _n)
+  {
+    ForEach<T, Wide>(_n, [&](auto _p, const std::size_t _i)
+    {
+      typedef decltype(_p) P;
+      MultiplyPack<T, P>(_out, _i,
+          P::Load(_a.w + _i), P::Load(_a.x + _i),
+          P::Load(_a.y + _i), P::Load(_a.z + _i),
+          P::Load(_b.w + _i), P::Load(_b.x + _i),
+          P::Load(_b.y + _i), P::Load(_b.z + _i));
+    });
+  }
+
+  //////////////////////////////////////////////////
+  template<typename T, typename Wide>
+  void QuaternionMultiplyOneImpl(ConstSoa4<T> _a, const T *_q,
+      Soa4<T> _out, const std::size_t _n)
+  {
+    // Local copy, so that the compiler knows the output stores cannot
+    // modify it.
+    const T q[4] = {_q[0], _q[1], _q[2], _q[3]};
+    ForEach<T, Wide>(_n, [&](auto _p, const std::size_t _i)
+    {
+      typedef decltype(_p) P;
+      MultiplyPack<T, P>(_out, _i,
+          P::Load(_a.w + _i), P::Load(_a.x + _i),
+          P::Load(_a.y + _i), P::Load(_a.z + _i),
+          P::Set1(q[0]), P::Set1(q[1]), P::Set1(q[2]), P::Set1(q[3]));
+    });
+  }
+
+  //////////////////////////////////////////////////
+  template<typename T, typename Wide>
+  void QuaternionNormalizeImpl(ConstSoa4<T> _a, Soa4<T> _out,
+      const std::size_t _n)
+  {
+    ForEach<T, Wide>(_n, [&](auto _p, const std::size_t _i)
+    {
+      typedef decltype(_p) P;
+      auto w = P::Load(_a.w + _i);
+      auto x = P::Load(_a.x + _i);
+      auto y = P::Load(_a.y + _i);
+      auto z = P::Load(_a.z + _i);
+      Normalize4<T, P>(w, x, y, z);
+      StoreQuaternion<T, P>(_out, _i, w, x, y, z);
+    });
+  }
+
+  //////////////////////////////////////////////////
+  /// \brief Rotate vectors by q (_sign = 1) or by its inverse (_sign = -1).
+  /// Instead of the two quaternion products of Quaternion::RotateVector(),
+  /// this uses v' = v + 2 / |q|^2 * (w (u x v) + u x (u x v)), where u is
+  /// the vector part of q. Quaternions of length zero have no inverse, and
+  /// reproduce the output of the scalar functions in that case.
+  template<typename T, typename Wide>
+  void QuaternionRotateImpl(ConstSoa4<T> _q, ConstSoa3<T> _v,
+      Soa3<T> _out, const T _sign, const std::size_t _n)
+  {
+    ForEach<T, Wide>(_n, [&](auto _p, const std::size_t _i)
+    {
+      typedef decltype(_p) P;
+      const auto w = P::Load(_q.w + _i);
+      const auto ux = P::Load(_q.x + _i);
+      const auto uy = P::Load(_q.y + _i);
+      const auto uz = P::Load(_q.z + _i);
+      const auto vx = P::Load(_v.x + _i);
+      const auto vy = P::Load(_v.y + _i);
+      const auto vz = P::Load(_v.z + _i);
+
+      const auto sign = P::Set1(_sign);
+      const auto ws = P::Mul(w, sign);
+      const auto cx = P::Sub(P::Mul(uy, vz), P::Mul(uz, vy));
+      const auto cy = P::Sub(P::Mul(uz, vx), P::Mul(ux, vz));
+      const auto cz = P::Sub(P::Mul(ux, vy), P::Mul(uy, vx));
+      const auto ccx = P::Sub(P::Mul(uy, cz), P::Mul(uz, cy));
+      const auto ccy = P::Sub(P::Mul(uz, cx), P::Mul(ux, cz));
+      const auto ccz = P::Sub(P::Mul(ux, cy), P::Mul(uy, cx));
+
+      const auto s = P::Add(P::Add(P::Mul(w, w), P::Mul(ux, ux)),
+          P::Add(P::Mul(uy, uy), P::Mul(uz, uz)));
+      // Same tolerance as the equal() test of Quaternion::Inverse()
+      const auto valid = P::Gt(s, P::Set1(static_cast<T>(1e-6)));
+      const auto f = P::Div(P::Set1(static_cast<T>(2)), s);
+
+      P::Store(_out.x + _i, P::Select(valid,
+            P::Add(vx, P::Mul(f, P::Add(P::Mul(ws, cx), ccx))),
+            P::Add(P::Mul(w, vx), P::Mul(sign, cx))));
+      P::Store(_out.y + _i, P::Select(valid,
+            P::Add(vy, P::Mul(f, P::Add(P::Mul(ws, cy), ccy))),
+            P::Add(P::Mul(w, vy), P::Mul(sign, cy))));
+      P::Store(_out.z + _i, P::Select(valid,
+            P::Add(vz, P::Mul(f, P::Add(P::Mul(ws, cz), ccz))),
+            P::Add(P::Mul(w, vz), P::Mul(sign, cz))));
+    });
+  }
+
+  //////////////////////////////////////////////////
+  /// \brief Shared implementation of Nlerp and Slerp. Slerp lanes fall
+  /// back to Nlerp when the quaternions are nearly parallel, with the same
+  /// threshold as Quaternion::Slerp().
+  template<typename T, typename Wide, bool Spherical>
+  void QuaternionInterpolateImpl(ConstSoa4<T> _a, ConstSoa4<T> _b,
+      const T *_t, const std::size_t _tStride, const bool _shortestPath,
+      Soa4<T> _out, const std::size_t _n)
+  {
+    ForEach<T, Wide>(_n, [&](auto _p, const std::size_t _i)
+    {
+      typedef decltype(_p) P;
+      const auto zero = P::Set1(static_cast<T>(0));
+      const auto one = P::Set1(static_cast<T>(1));
+
+      const auto t = P::Min(P::Max(_tStride == 0 ?
+            P::Set1(_t[0]) : P::Load(_t + _i), zero), one);
+      const auto aw = P::Load(_a.w + _i);
+      const auto ax = P::Load(_a.x + _i);
+      const auto ay = P::Load(_a.y + _i);
+      const auto az = P::Load(_a.z + _i);
+      auto bw = P::Load(_b.w + _i);
+      auto bx = P::Load(_b.x + _i);
+      auto by = P::Load(_b.y + _i);
+      auto bz = P::Load(_b.z + _i);
+
+      auto c = P::Add(P::Add(P::Mul(aw, bw), P::Mul(ax, bx)),
+          P::Add(P::Mul(ay, by), P::Mul(az, bz)));
+      if (_shortestPath)
+      {
+        const auto sign = P::Select(P::Gt(zero, c),
+            P::Set1(static_cast<T>(-1)), one);
+        c = P::Mul(c, sign);
+        bw = P::Mul(bw, sign);
+        bx = P::Mul(bx, sign);
+        by = P::Mul(by, sign);
+        bz = P::Mul(bz, sign);
+      }
+
+      const auto ct = P::Sub(one, t);
+      auto w = P::Add(P::Mul(aw, ct), P::Mul(bw, t));
+      auto x = P::Add(P::Mul(ax, ct), P::Mul(bx, t));
+      auto y = P::Add(P::Mul(ay, ct), P::Mul(by, t));
+      auto z = P::Add(P::Mul(az, ct), P::Mul(bz, t));
+      Normalize4<T, P>(w, x, y, z);
+
+      if (Spherical)
+      {
+        const auto negative = P::Gt(zero, c);
+        const auto absC = P::Select(negative, P::Sub(zero, c), c);
+        const auto useSlerp = P::Gt(
+            P::Set1(static_cast<T>(1 - 1e-03)), absC);
+
+        // Angle in [0, pi], from the first quadrant angle of |c|.
+        const auto s = P::Sqrt(P::Sub(one, P::Mul(c, c)));
+        const auto a = AtanFirstQuadrant<T, P>(s, absC);
+        const auto angle = P::Select(negative,
+            P::Sub(P::Set1(static_cast<T>(kPi)), a), a);
+
+        const auto invSin = P::Div(one, s);
+        const auto c0 = P::Mul(SinPositive<T, P>(P::Mul(ct, angle)), invSin);
+        const auto c1 = P::Mul(SinPositive<T, P>(P::Mul(t, angle)), invSin);
+
+        w = P::Select(useSlerp, P::Add(P::Mul(aw, c0), P::Mul(bw, c1)), w);
+        x = P::Select(useSlerp, P::Add(P::Mul(ax, c0), P::Mul(bx, c1)), x);
+        y = P::Select(useSlerp, P::Add(P::Mul(ay, c0), P::Mul(by, c1)), y);
+        z = P::Select(useSlerp, P::Add(P::Mul(az, c0), P::Mul(bz, c1)), z);
+      }
+
+      StoreQuaternion<T, P>(_out, _i, w, x, y, z);
+    });
+  }
+
+  //////////////////////////////////////////////////
+  /// \brief Clip the distances along rays to the slab of one axis.
+  ///
+  /// The inverse direction is infinite for rays parallel to the slab.
+  /// The distances to the planes of the slab are moved away from zero by
+  /// the smallest normal value, towards the outside of the slab, so that
+  /// they are never multiplied by infinity when the ray lies on a plane.
+  /// Such rays are then inside the slab, as in AxisAlignedBox::ClipLine.
+  /// The offset has no effect on other distances.
+  /// \param[in] _lo Minimum of the slab.
+  /// \param[in] _hi Maximum of the slab.
+  /// \param[in] _start Start of the rays.
+  /// \param[in] _invDir Inverse direction of the rays.
+  /// \param[in,out] _near Distance at which the rays enter the box.
+  /// \param[in,out] _far Distance at which the rays leave the box.
+  template<typename T, typename P, typename Reg>
+  void ClipSlab(const Reg _lo, const Reg _hi, const Reg _start,
+      const Reg _invDir, Reg &_near, Reg &_far)
+  {
+    constexpr T tiny = std::numeric_limits<T>::min();
+    const auto t1 = P::Mul(
+        P::Sub(P::Sub(_lo, _start), P::Set1(tiny)), _invDir);
+    const auto t2 = P::Mul(
+        P::Add(P::Sub(_hi, _start), P::Set1(tiny)), _invDir);
+    _near = P::Max(_near, P::Min(t1, t2));
+    _far = P::Min(_far, P::Max(t1, t2));
+  }
+
+  //////////////////////////////////////////////////
+  template<typename T, typename Wide>
+  void RayBoxImpl(ConstSoa3<T> _start, ConstSoa3<T> _invDir,
+      const T *_length, const T *_box, T *_dist, const std::size_t _n)
+  {
+    ForEach<T, Wide>(_n, [&](auto _p, const std::size_t _i)
+    {
+      typedef decltype(_p) P;
+      auto tNear = P::Set1(0);
+      auto tFar = P::Load(_length + _i);
+      ClipSlab<T, P>(P::Set1(_box[0]), P::Set1(_box[3]),
+          P::Load(_start.x + _i), P::Load(_invDir.x + _i), tNear, tFar);
+      ClipSlab<T, P>(P::Set1(_box[1]), P::Set1(_box[4]),
+          P::Load(_start.y + _i), P::Load(_invDir.y + _i), tNear, tFar);
+      ClipSlab<T, P>(P::Set1(_box[2]), P::Set1(_box[5]),
+          P::Load(_start.z + _i), P::Load(_invDir.z + _i), tNear, tFar);
+      P::Store(_dist + _i, P::Select(P::Gt(tNear, tFar), P::Set1(-1), tNear));
+    });
+  }
+
+  //////////////////////////////////////////////////
+  template<typename T, typename Wide>
+  void BoxRayImpl(ConstSoa3<T> _min, ConstSoa3<T> _max, const T *_start,
+      const T *_invDir, const T _length, T *_dist, const std::size_t _n)
+  {
+    ForEach<T, Wide>(_n, [&](auto _p, const std::size_t _i)
+    {
+      typedef decltype(_p) P;
+      auto tNear = P::Set1(0);
+      auto tFar = P::Set1(_length);
+      ClipSlab<T, P>(P::Load(_min.x + _i), P::Load(_max.x + _i),
+          P::Set1(_start[0]), P::Set1(_invDir[0]), tNear, tFar);
+      ClipSlab<T, P>(P::Load(_min.y + _i), P::Load(_max.y + _i),
+          P::Set1(_start[1]), P::Set1(_invDir[1]), tNear, tFar);
+      ClipSlab<T, P>(P::Load(_min.z + _i), P::Load(_max.z + _i),
+          P::Set1(_start[2]), P::Set1(_invDir[2]), tNear, tFar);
+      P::Store(_dist + _i, P::Select(P::Gt(tNear, tFar), P::Set1(-1), tNear));
+    });
+  }
+
+  //////////////////////////////////////////////////
+  // Watertight ray-triangle intersection of Woop, Benthin and Wald. The
+  // triangle is moved to the ray origin and sheared so that the ray
+  // becomes the z axis, then the barycentric coordinates are given by 2D
+  // edge functions. Rays through a shared edge or vertex see consistent
+  // edge functions, and hit at least one of the triangles.
+  template<typename T, typename Wide>
+  void RayTriangleImpl(ConstSoa3<T> _a, ConstSoa3<T> _b, ConstSoa3<T> _c,
+      const T *_origin, const T *_shear, const T _tMin, const T _tMax,
+      T *_dist, const std::size_t _n)
+  {
+    ForEach<T, Wide>(_n, [&](auto _p, const std::size_t _i)
+    {
+      typedef decltype(_p) P;
+      const auto zero = P::Set1(0);
+      const auto ox = P::Set1(_origin[0]);
+      const auto oy = P::Set1(_origin[1]);
+      const auto oz = P::Set1(_origin[2]);
+      const auto sx = P::Set1(_shear[0]);
+      const auto sy = P::Set1(_shear[1]);
+
+      const auto az = P::Sub(P::Load(_a.z + _i), oz);
+      const auto bz = P::Sub(P::Load(_b.z + _i), oz);
+      const auto cz = P::Sub(P::Load(_c.z + _i), oz);
+      const auto ax = P::Sub(P::Sub(P::Load(_a.x + _i), ox), P::Mul(sx, az));
+      const auto ay = P::Sub(P::Sub(P::Load(_a.y + _i), oy), P::Mul(sy, az));
+      const auto bx = P::Sub(P::Sub(P::Load(_b.x + _i), ox), P::Mul(sx, bz));
+      const auto by = P::Sub(P::Sub(P::Load(_b.y + _i), oy), P::Mul(sy, bz));
+      const auto cx = P::Sub(P::Sub(P::Load(_c.x + _i), ox), P::Mul(sx, cz));
+      const auto cy = P::Sub(P::Sub(P::Load(_c.y + _i), oy), P::Mul(sy, cz));
+
+      const auto u = P::Sub(P::Mul(cx, by), P::Mul(cy, bx));
+      const auto v = P::Sub(P::Mul(ax, cy), P::Mul(ay, cx));
+      const auto w = P::Sub(P::Mul(bx, ay), P::Mul(by, ax));
+      const auto det = P::Add(P::Add(u, v), w);
+      const auto t = P::Div(P::Mul(P::Set1(_shear[2]), P::Add(P::Add(
+          P::Mul(u, az), P::Mul(v, bz)), P::Mul(w, cz))), det);
+
+      // Negative if the edge functions have different signs
+      const auto mixed = P::Select(P::Gt(P::Max(P::Max(u, v), w), zero),
+          P::Min(P::Min(u, v), w), zero);
+      const auto miss = P::Set1(-1);
+      auto r = P::Select(P::Gt(zero, mixed), miss, t);
+      r = P::Select(P::Gt(P::Set1(_tMin), t), miss, r);
+      r = P::Select(P::Gt(t, P::Set1(_tMax)), miss, r);
+      // Coplanar rays and degenerate triangles, t is not a number
+      r = P::Select(P::Gt(P::Max(det, P::Sub(zero, det)), zero), r, miss);
+      P::Store(_dist + _i, r);
+    });
+  }
+
+  //////////////////////////////////////////////////
+  //////////////////////////////////////////////////
+  // Same operations as Plane::Side(AxisAlignedBox): the distance of the
+  // center is compared to the projected half size, which is the distance
+  // between the center and the p-vertex or n-vertex of the box.
+  template<typename T, typename Wide>
+  void PlanesBoxImpl(ConstSoa3<T> _min, ConstSoa3<T> _max, const T *_planes,
+      const T *_bits, const std::size_t _count, T *_code,
+      const std::size_t _n)
+  {
+    ForEach<T, Wide>(_n, [&](auto _p, const std::size_t _i)
+    {
+      typedef decltype(_p) P;
+      const auto zero = P::Set1(0);
+      const auto half = P::Set1(0.5);
+      const auto minX = P::Load(_min.x + _i);
+      const auto minY = P::Load(_min.y + _i);
+      const auto minZ = P::Load(_min.z + _i);
+      const auto maxX = P::Load(_max.x + _i);
+      const auto maxY = P::Load(_max.y + _i);
+      const auto maxZ = P::Load(_max.z + _i);
+      const auto cx = P::Add(P::Mul(half, minX), P::Mul(half, maxX));
+      const auto cy = P::Add(P::Mul(half, minY), P::Mul(half, maxY));
+      const auto cz = P::Add(P::Mul(half, minZ), P::Mul(half, maxZ));
+      const auto hx = P::Mul(P::Max(P::Sub(maxX, minX), zero), half);
+      const auto hy = P::Mul(P::Max(P::Sub(maxY, minY), zero), half);
+      const auto hz = P::Mul(P::Max(P::Sub(maxZ, minZ), zero), half);
+
+      auto outside = zero;
+      auto crossed = zero;
+      for (std::size_t k = 0; k < _count; ++k)
+      {
+        const T *plane = _planes + 4 * k;
+        const auto dist = P::Sub(P::Add(P::Add(
+            P::Mul(P::Set1(plane[0]), cx), P::Mul(P::Set1(plane[1]), cy)),
+            P::Mul(P::Set1(plane[2]), cz)), P::Set1(plane[3]));
+        const T absX = plane[0] < 0 ? -plane[0] : plane[0];
+        const T absY = plane[1] < 0 ? -plane[1] : plane[1];
+        const T absZ = plane[2] < 0 ? -plane[2] : plane[2];
+        const auto extent = P::Add(P::Add(P::Mul(P::Set1(absX), hx),
+            P::Mul(P::Set1(absY), hy)), P::Mul(P::Set1(absZ), hz));
+        const auto negative = P::Gt(P::Sub(zero, extent), dist);
+        outside = P::Select(negative, P::Set1(1), outside);
+        crossed = P::Add(crossed, P::Select(negative, zero,
+            P::Select(P::Gt(dist, extent), zero, P::Set1(_bits[k]))));
+      }
+      P::Store(_code + _i, P::Select(P::Gt(outside, zero), P::Set1(-1),
+          crossed));
+    });
+  }
+
+  //////////////////////////////////////////////////
+  // Separating axis test of Gottschalk, as written in Real-Time Collision
+  // Detection. The boxes are expressed in the frame of the single box. The
+  // lanes that find a separating axis are marked, and the test stops when
+  // all the lanes are marked.
+  template<typename T, typename Wide>
+  void OrientedBoxesImpl(ConstSoa3<T> _center, ConstSoa3<T> _axisX,
+      ConstSoa3<T> _axisY, ConstSoa3<T> _axisZ, ConstSoa3<T> _half,
+      const T *_box, T *_hit, const std::size_t _n)
+  {
+    const T epsilon = static_cast<T>(1e-6);
+    const T *centerA = _box;
+    const T *rotA = _box + 3;
+    const T *halfA = _box + 12;
+    const T *axesB[3][3] = {
+      {_axisX.x, _axisY.x, _axisZ.x},
+      {_axisX.y, _axisY.y, _axisZ.y},
+      {_axisX.z, _axisY.z, _axisZ.z}};
+
+    ForEach<T, Wide>(_n, [&](auto _p, const std::size_t _i)
+    {
+      typedef decltype(_p) P;
+      typedef decltype(P::Set1(0)) Reg;
+      const auto zero = P::Set1(0);
+
+      Reg rotB[3][3];
+      for (int i = 0; i < 3; ++i)
+      {
+        for (int k = 0; k < 3; ++k)
+          rotB[i][k] = P::Load(axesB[i][k] + _i);
+      }
+      const Reg diff[3] = {
+        P::Sub(P::Load(_center.x + _i), P::Set1(centerA[0])),
+        P::Sub(P::Load(_center.y + _i), P::Set1(centerA[1])),
+        P::Sub(P::Load(_center.z + _i), P::Set1(centerA[2]))};
+      const Reg halfB[3] = {P::Load(_half.x + _i), P::Load(_half.y + _i),
+        P::Load(_half.z + _i)};
+
+      Reg rot[3][3];
+      Reg absRot[3][3];
+      Reg t[3];
+      for (int j = 0; j < 3; ++j)
+      {
+        t[j] = P::Add(P::Add(P::Mul(diff[0], P::Set1(rotA[j])),
+            P::Mul(diff[1], P::Set1(rotA[3 + j]))),
+            P::Mul(diff[2], P::Set1(rotA[6 + j])));
+        for (int k = 0; k < 3; ++k)
+        {
+          rot[j][k] = P::Add(P::Add(P::Mul(P::Set1(rotA[j]), rotB[0][k]),
+              P::Mul(P::Set1(rotA[3 + j]), rotB[1][k])),
+              P::Mul(P::Set1(rotA[6 + j]), rotB[2][k]));
+          absRot[j][k] = P::Add(P::Max(rot[j][k], P::Sub(zero, rot[j][k])),
+              P::Set1(epsilon));
+        }
+      }
+
+      auto separated = zero;
+      auto test = [&](const Reg _dist, const Reg _ra, const Reg _rb)
+      {
+        separated = P::Select(P::Gt(P::Max(_dist, P::Sub(zero, _dist)),
+            P::Add(_ra, _rb)), P::Set1(1), separated);
+      };
+
+      // Axes of the single box
+      for (int j = 0; j < 3; ++j)
+      {
+        test(t[j], P::Set1(halfA[j]), P::Add(P::Add(
+            P::Mul(halfB[0], absRot[j][0]), P::Mul(halfB[1], absRot[j][1])),
+            P::Mul(halfB[2], absRot[j][2])));
+      }
+
+      // Leave as soon as all the lanes are separated
+      const auto allSeparated = [&]()
+      {
+        if (P::ReduceMin(separated) > 0)
+        {
+          P::Store(_hit + _i, zero);
+          return true;
+        }
+        return false;
+      };
+      if (allSeparated())
+        return;
+
+      // Axes of the other boxes
+      for (int k = 0; k < 3; ++k)
+      {
+        const auto ra = P::Add(P::Add(
+            P::Mul(P::Set1(halfA[0]), absRot[0][k]),
+            P::Mul(P::Set1(halfA[1]), absRot[1][k])),
+            P::Mul(P::Set1(halfA[2]), absRot[2][k]));
+        const auto dist = P::Add(P::Add(P::Mul(t[0], rot[0][k]),
+            P::Mul(t[1], rot[1][k])), P::Mul(t[2], rot[2][k]));
+        test(dist, ra, halfB[k]);
+      }
+      if (allSeparated())
+        return;
+
+      // Cross products of the axes
+      for (int j = 0; j < 3; ++j)
+      {
+        const int j1 = (j + 1) % 3;
+        const int j2 = (j + 2) % 3;
+        for (int k = 0; k < 3; ++k)
+        {
+          const int k1 = (k + 1) % 3;
+          const int k2 = (k + 2) % 3;
+          const auto ra = P::Add(P::Mul(P::Set1(halfA[j1]), absRot[j2][k]),
+              P::Mul(P::Set1(halfA[j2]), absRot[j1][k]));
+          const auto rb = P::Add(P::Mul(halfB[k1], absRot[j][k2]),
+              P::Mul(halfB[k2], absRot[j][k1]));
+          const auto dist = P::Sub(P::Mul(t[j2], rot[j1][k]),
+              P::Mul(t[j1], rot[j2][k]));
+          test(dist, ra, rb);
+        }
+      }
+
+      P::Store(_hit + _i, P::Select(P::Gt(separated, zero), zero,
+          P::Set1(1)));
+    });
+  }
+
+  //////////////////////////////////////////////////
+  template<typename T, typename Wide>
+  void PointsInBoxImpl(ConstSoa3<T> _a, const T *_rot, const T *_pre,
+      const T *_half, T *_inside, const std::size_t _n)
+  {
+    const T r[9] = {_rot[0], _rot[1], _rot[2],
+                    _rot[3], _rot[4], _rot[5],
+                    _rot[6], _rot[7], _rot[8]};
+    const T pre[3] = {_pre[0], _pre[1], _pre[2]};
+    const T half[3] = {_half[0], _half[1], _half[2]};
+
+    ForEach<T, Wide>(_n, [&](auto _p, const std::size_t _i)
+    {
+      typedef decltype(_p) P;
+      const auto zero = P::Set1(0);
+      const auto x = P::Add(P::Load(_a.x + _i), P::Set1(pre[0]));
+      const auto y = P::Add(P::Load(_a.y + _i), P::Set1(pre[1]));
+      const auto z = P::Add(P::Load(_a.z + _i), P::Set1(pre[2]));
+      const auto bx = P::Add(P::Add(P::Mul(P::Set1(r[0]), x),
+            P::Mul(P::Set1(r[1]), y)), P::Mul(P::Set1(r[2]), z));
+      const auto by = P::Add(P::Add(P::Mul(P::Set1(r[3]), x),
+            P::Mul(P::Set1(r[4]), y)), P::Mul(P::Set1(r[5]), z));
+      const auto bz = P::Add(P::Add(P::Mul(P::Set1(r[6]), x),
+            P::Mul(P::Set1(r[7]), y)), P::Mul(P::Set1(r[8]), z));
+
+      // Absolute values, the negation is exact
+      const auto ax = P::Max(bx, P::Sub(zero, bx));
+      const auto ay = P::Max(by, P::Sub(zero, by));
+      const auto az = P::Max(bz, P::Sub(zero, bz));
+      P::Store(_inside + _i,
+          P::Select(P::Gt(ax, P::Set1(half[0])), zero,
+          P::Select(P::Gt(ay, P::Set1(half[1])), zero,
+          P::Select(P::Gt(az, P::Set1(half[2])), zero, P::Set1(1)))));
+    });
+  }
+
+  //////////////////////////////////////////////////
+  // Same operations as Vector3ArrayKernels::SegmentClosestPoints, with the
+  // branches replaced by selections. The divisors are kept above the
+  // smallest normal number, so that the discarded quotients of degenerate
+  // segments are never NaN.
+  template<typename T, typename Wide>
+  void SegmentsImpl(ConstSoa3<T> _startA, ConstSoa3<T> _endA,
+      ConstSoa3<T> _startB, ConstSoa3<T> _endB, Soa3<T> _pointA,
+      Soa3<T> _pointB, T *_sqDist, const std::size_t _n)
+  {
+    constexpr T tiny = std::numeric_limits<T>::min();
+
+    ForEach<T, Wide>(_n, [&](auto _p, const std::size_t _i)
+    {
+      typedef decltype(_p) P;
+      typedef decltype(P::Set1(0)) Reg;
+      const auto zero = P::Set1(0);
+      const auto one = P::Set1(1);
+      const auto p1x = P::Load(_startA.x + _i);
+      const auto p1y = P::Load(_startA.y + _i);
+      const auto p1z = P::Load(_startA.z + _i);
+      const auto p2x = P::Load(_startB.x + _i);
+      const auto p2y = P::Load(_startB.y + _i);
+      const auto p2z = P::Load(_startB.z + _i);
+      const auto d1x = P::Sub(P::Load(_endA.x + _i), p1x);
+      const auto d1y = P::Sub(P::Load(_endA.y + _i), p1y);
+      const auto d1z = P::Sub(P::Load(_endA.z + _i), p1z);
+      const auto d2x = P::Sub(P::Load(_endB.x + _i), p2x);
+      const auto d2y = P::Sub(P::Load(_endB.y + _i), p2y);
+      const auto d2z = P::Sub(P::Load(_endB.z + _i), p2z);
+      const auto rx = P::Sub(p1x, p2x);
+      const auto ry = P::Sub(p1y, p2y);
+      const auto rz = P::Sub(p1z, p2z);
+
+      auto dot = [](const Reg _ax, const Reg _ay, const Reg _az,
+          const Reg _bx, const Reg _by, const Reg _bz)
+      {
+        return P::Add(P::Add(P::Mul(_ax, _bx), P::Mul(_ay, _by)),
+            P::Mul(_az, _bz));
+      };
+      const auto a = dot(d1x, d1y, d1z, d1x, d1y, d1z);
+      const auto b = dot(d1x, d1y, d1z, d2x, d2y, d2z);
+      const auto c = dot(d1x, d1y, d1z, rx, ry, rz);
+      const auto e = dot(d2x, d2y, d2z, d2x, d2y, d2z);
+      const auto f = dot(d2x, d2y, d2z, rx, ry, rz);
+
+      // normal = d1 x d2 and m = d2 x r
+      const auto nx = P::Sub(P::Mul(d1y, d2z), P::Mul(d1z, d2y));
+      const auto ny = P::Sub(P::Mul(d1z, d2x), P::Mul(d1x, d2z));
+      const auto nz = P::Sub(P::Mul(d1x, d2y), P::Mul(d1y, d2x));
+      const auto mx = P::Sub(P::Mul(d2y, rz), P::Mul(d2z, ry));
+      const auto my = P::Sub(P::Mul(d2z, rx), P::Mul(d2x, rz));
+      const auto mz = P::Sub(P::Mul(d2x, ry), P::Mul(d2y, rx));
+      const auto denom = dot(nx, ny, nz, nx, ny, nz);
+
+      auto unit = [&](const Reg _v)
+      {
+        return P::Min(P::Max(_v, zero), one);
+      };
+      auto s = P::Select(P::Gt(denom, zero), unit(P::Div(
+              dot(nx, ny, nz, mx, my, mz), P::Max(denom, P::Set1(tiny)))),
+          zero);
+      const auto tRaw = P::Select(P::Gt(e, zero),
+          P::Div(P::Add(P::Mul(b, s), f), P::Max(e, P::Set1(tiny))), zero);
+      const auto t = unit(tRaw);
+      const auto sClamped = P::Select(P::Gt(a, zero),
+          unit(P::Div(P::Sub(P::Mul(b, t), c), P::Max(a, P::Set1(tiny)))),
+          zero);
+      s = P::Select(P::Gt(tRaw, one), sClamped,
+          P::Select(P::Gt(zero, tRaw), sClamped,
+          P::Select(P::Gt(e, zero), s, sClamped)));
+
+      const auto ax = P::Add(p1x, P::Mul(d1x, s));
+      const auto ay = P::Add(p1y, P::Mul(d1y, s));
+      const auto az = P::Add(p1z, P::Mul(d1z, s));
+      const auto bx = P::Add(p2x, P::Mul(d2x, t));
+      const auto by = P::Add(p2y, P::Mul(d2y, t));
+      const auto bz = P::Add(p2z, P::Mul(d2z, t));
+      P::Store(_pointA.x + _i, ax);
+      P::Store(_pointA.y + _i, ay);
+      P::Store(_pointA.z + _i, az);
+      P::Store(_pointB.x + _i, bx);
+      P::Store(_pointB.y + _i, by);
+      P::Store(_pointB.z + _i, bz);
+      const auto dx = P::Sub(ax, bx);
+      const auto dy = P::Sub(ay, by);
+      const auto dz = P::Sub(az, bz);
+      P::Store(_sqDist + _i, dot(dx, dy, dz, dx, dy, dz));
+    });
+  }
+
+  //////////////////////////////////////////////////
+  // Same operations as SegmentsImpl, one pair at a time. Without SIMD
+  // registers to share them, computing every quotient like SegmentsImpl
+  // costs more than it saves, so degenerate segments branch here. The
+  // clamps are random for close segments, and are done by indexing so that
+  // they are not compiled to branches that would often be mispredicted.
+  template<typename T>
+  void SegmentsScalarImpl(ConstSoa3<T> _startA, ConstSoa3<T> _endA,
+      ConstSoa3<T> _startB, ConstSoa3<T> _endB, Soa3<T> _pointA,
+      Soa3<T> _pointB, T *_sqDist, const std::size_t _n)
+  {
+    auto unit = [](const T _v)
+    {
+      const T bounds[3] = {0, _v, 1};
+      return bounds[(_v >= 0) + (_v > 1)];
+    };
+
+    for (std::size_t i = 0; i < _n; ++i)
+    {
+      const T p1x = _startA.x[i];
+      const T p1y = _startA.y[i];
+      const T p1z = _startA.z[i];
+      const T p2x = _startB.x[i];
+      const T p2y = _startB.y[i];
+      const T p2z = _startB.z[i];
+      const T d1x = _endA.x[i] - p1x;
+      const T d1y = _endA.y[i] - p1y;
+      const T d1z = _endA.z[i] - p1z;
+      const T d2x = _endB.x[i] - p2x;
+      const T d2y = _endB.y[i] - p2y;
+      const T d2z = _endB.z[i] - p2z;
+      const T rx = p1x - p2x;
+      const T ry = p1y - p2y;
+      const T rz = p1z - p2z;
+
+      const T a = d1x * d1x + d1y * d1y + d1z * d1z;
+      const T b = d1x * d2x + d1y * d2y + d1z * d2z;
+      const T c = d1x * rx + d1y * ry + d1z * rz;
+      const T e = d2x * d2x + d2y * d2y + d2z * d2z;
+      const T f = d2x * rx + d2y * ry + d2z * rz;
+
+      T s = 0;
+      T t = 0;
+      bool clamped = true;
+      if (e > 0)
+      {
+        // normal = d1 x d2 and m = d2 x r
+        const T nx = d1y * d2z - d1z * d2y;
+        const T ny = d1z * d2x - d1x * d2z;
+        const T nz = d1x * d2y - d1y * d2x;
+        const T denom = nx * nx + ny * ny + nz * nz;
+        if (denom > 0)
+        {
+          const T mx = d2y * rz - d2z * ry;
+          const T my = d2z * rx - d2x * rz;
+          const T mz = d2x * ry - d2y * rx;
+          s = unit((nx * mx + ny * my + nz * mz) / denom);
+        }
+        const T tRaw = (b * s + f) / e;
+        t = unit(tRaw);
+        clamped = (tRaw > 1) | (tRaw < 0);
+      }
+
+      // s is recomputed from t when t was clamped.
+      const T choices[2] = {s, a > 0 ? unit((b * t - c) / a) : T(0)};
+      s = choices[clamped];
+
+      const T ax = p1x + d1x * s;
+      const T ay = p1y + d1y * s;
+      const T az = p1z + d1z * s;
+      const T bx = p2x + d2x * t;
+      const T by = p2y + d2y * t;
+      const T bz = p2z + d2z * t;
+      _pointA.x[i] = ax;
+      _pointA.y[i] = ay;
+      _pointA.z[i] = az;
+      _pointB.x[i] = bx;
+      _pointB.y[i] = by;
+      _pointB.z[i] = bz;
+      const T dx = ax - bx;
+      const T dy = ay - by;
+      const T dz = az - bz;
+      _sqDist[i] = dx * dx + dy * dy + dz * dz;
+    }
+  }
+
+  /// \brief Build the table of kernels using the packs Wide. This is a
+  /// constant expression, so that no code compiled for the instruction
+  /// set runs before the CPU is known to support it.
+  /// \return The kernel table.
+  template<typename T, typename Wide>
+  constexpr BatchKernelTable<T> MakeBatchKernelTable()
+  {
+    BatchKernelTable<T> table{};
+    table.add = AddImpl<T, Wide>;
+    table.addVector = AddVectorImpl<T, Wide>;
+    table.scale = ScaleImpl<T, Wide>;
+    table.dot = DotImpl<T, Wide>;
+    table.dotVector = DotVectorImpl<T, Wide>;
+    table.cross = CrossImpl<T, Wide>;
+    table.length = LengthImpl<T, Wide>;
+    table.normalize = NormalizeImpl<T, Wide>;
+    table.distance = DistanceImpl<T, Wide>;
+    table.transform = TransformImpl<T, Wide>;
+    table.minMax = MinMaxImpl<T, Wide>;
+    table.quaternionMultiply = QuaternionMultiplyImpl<T, Wide>;
+    table.quaternionMultiplyOne = QuaternionMultiplyOneImpl<T, Wide>;
+    table.quaternionNormalize = QuaternionNormalizeImpl<T, Wide>;
+    table.quaternionRotate = QuaternionRotateImpl<T, Wide>;
+    table.quaternionNlerp = QuaternionInterpolateImpl<T, Wide, false>;
+    table.quaternionSlerp = QuaternionInterpolateImpl<T, Wide, true>;
+    table.rayBox = RayBoxImpl<T, Wide>;
+    table.boxRay = BoxRayImpl<T, Wide>;
+    table.rayTriangle = RayTriangleImpl<T, Wide>;
+    table.planesBox = PlanesBoxImpl<T, Wide>;
+    table.orientedBoxes = OrientedBoxesImpl<T, Wide>;
+    table.pointsInBox = PointsInBoxImpl<T, Wide>;
+    table.segments = std::is_same<Wide, ScalarPack<T>>::value ?
+      SegmentsScalarImpl<T> : SegmentsImpl<T, Wide>;
+    return table;
+  }
+    }
+    }
+    }
+  }
+}
+#endif
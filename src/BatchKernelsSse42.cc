@@ -0,0 +1,56 @@
+/*
+ * Copyright (C) 2018 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+// This file is compiled with SSE4.2 enabled. Its kernels are only used
+// when SimdDispatch selects SimdLevel::SSE4_2 or a higher level without
+// kernels of its own. Compilers without a SSE4.2 option, such as MSVC,
+// build no kernels here and the SSE2 kernels are used instead.
+#define IGNITION_MATH_SIMD_TARGET sse42
+
+#include "BatchKernelsImpl.hh"
+
+using namespace ignition;
+using namespace math;
+
+namespace target = simd::IGNITION_MATH_SIMD_TARGET;
+
+//////////////////////////////////////////////////
+template<>
+const simd::BatchKernelTable<float> *simd::BatchKernelsSse42<float>()
+{
+#ifdef IGNITION_MATH_SIMD_SSE4
+  static constexpr BatchKernelTable<float> table =
+    target::MakeBatchKernelTable<float,
+        target::Sse2Pack<float>>();
+  return &table;
+#else
+  return nullptr;
+#endif
+}
+
+//////////////////////////////////////////////////
+template<>
+const simd::BatchKernelTable<double> *simd::BatchKernelsSse42<double>()
+{
+#ifdef IGNITION_MATH_SIMD_SSE4
+  static constexpr BatchKernelTable<double> table =
+    target::MakeBatchKernelTable<double,
+        target::Sse2Pack<double>>();
+  return &table;
+#else
+  return nullptr;
+#endif
+}
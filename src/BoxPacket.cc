@@ -0,0 +1,184 @@
+/*
+ * Copyright (C) 2018 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include "ignition/math/BoxPacket.hh"
+#include "ignition/math/detail/AlignedAllocator.hh"
+#include "BatchKernels.hh"
+
+using namespace ignition;
+using namespace math;
+
+// Private data for BoxPacket class
+class ignition::math::BoxPacketPrivate
+{
+  /// \brief Storage of one component of the corners
+  public: typedef std::vector<double, detail::AlignedAllocator<double>>
+          Storage;
+
+  /// \brief Minimum corners of the boxes
+  public: Storage min[3];
+
+  /// \brief Maximum corners of the boxes
+  public: Storage max[3];
+};
+
+//////////////////////////////////////////////////
+BoxPacket::BoxPacket()
+: dataPtr(new BoxPacketPrivate)
+{
+}
+
+//////////////////////////////////////////////////
+BoxPacket::BoxPacket(const std::vector<AxisAlignedBox> &_boxes)
+: dataPtr(new BoxPacketPrivate)
+{
+  this->Assign(_boxes);
+}
+
+//////////////////////////////////////////////////
+BoxPacket::BoxPacket(const BoxPacket &_packet)
+: dataPtr(new BoxPacketPrivate(*_packet.dataPtr))
+{
+}
+
+//////////////////////////////////////////////////
+BoxPacket::~BoxPacket()
+{
+}
+
+//////////////////////////////////////////////////
+BoxPacket &BoxPacket::operator=(const BoxPacket &_packet)
+{
+  *this->dataPtr = *_packet.dataPtr;
+  return *this;
+}
+
+//////////////////////////////////////////////////
+std::size_t BoxPacket::Size() const
+{
+  return this->dataPtr->min[0].size();
+}
+
+//////////////////////////////////////////////////
+bool BoxPacket::Empty() const
+{
+  return this->dataPtr->min[0].empty();
+}
+
+//////////////////////////////////////////////////
+void BoxPacket::Clear()
+{
+  for (int a = 0; a < 3; ++a)
+  {
+    this->dataPtr->min[a].clear();
+    this->dataPtr->max[a].clear();
+  }
+}
+
+//////////////////////////////////////////////////
+void BoxPacket::Reserve(const std::size_t _size)
+{
+  for (int a = 0; a < 3; ++a)
+  {
+    this->dataPtr->min[a].reserve(_size);
+    this->dataPtr->max[a].reserve(_size);
+  }
+}
+
+//////////////////////////////////////////////////
+void BoxPacket::PushBack(const AxisAlignedBox &_box)
+{
+  for (int a = 0; a < 3; ++a)
+  {
+    this->dataPtr->min[a].push_back(_box.Min()[a]);
+    this->dataPtr->max[a].push_back(_box.Max()[a]);
+  }
+}
+
+//////////////////////////////////////////////////
+void BoxPacket::Assign(const std::vector<AxisAlignedBox> &_boxes)
+{
+  this->Clear();
+  this->Reserve(_boxes.size());
+  for (const auto &box : _boxes)
+    this->PushBack(box);
+}
+
+//////////////////////////////////////////////////
+AxisAlignedBox BoxPacket::operator[](const std::size_t _index) const
+{
+  AxisAlignedBox box;
+  box.Min().Set(this->dataPtr->min[0][_index],
+      this->dataPtr->min[1][_index], this->dataPtr->min[2][_index]);
+  box.Max().Set(this->dataPtr->max[0][_index],
+      this->dataPtr->max[1][_index], this->dataPtr->max[2][_index]);
+  return box;
+}
+
+//////////////////////////////////////////////////
+const double *BoxPacket::Min(const int _axis) const
+{
+  return this->dataPtr->min[_axis].data();
+}
+
+//////////////////////////////////////////////////
+const double *BoxPacket::Max(const int _axis) const
+{
+  return this->dataPtr->max[_axis].data();
+}
+
+//////////////////////////////////////////////////
+std::size_t BoxPacket::Intersect(const Vector3d &_origin,
+    const Vector3d &_dir, const double _min, const double _max,
+    std::vector<bool> &_hits, std::vector<double> &_dists) const
+{
+  // Same start point as AxisAlignedBox::Intersect
+  const Vector3d dir = _dir.Normalized();
+  const Vector3d startPoint = _origin + dir * _min;
+  const double start[3] = {startPoint.X(), startPoint.Y(), startPoint.Z()};
+  // Infinite for the axes parallel to the ray, see RayPacket
+  const double invDir[3] = {1 / dir.X(), 1 / dir.Y(), 1 / dir.Z()};
+
+  const std::size_t n = this->Size();
+  _dists.resize(n);
+  simd::BatchKernels<double>().boxRay(
+      {this->dataPtr->min[0].data(), this->dataPtr->min[1].data(),
+       this->dataPtr->min[2].data()},
+      {this->dataPtr->max[0].data(), this->dataPtr->max[1].data(),
+       this->dataPtr->max[2].data()},
+      start, invDir, _max - _min, _dists.data(), n);
+
+  std::size_t count = 0;
+  _hits.resize(n);
+  for (std::size_t i = 0; i < n; ++i)
+  {
+    _hits[i] = _dists[i] >= 0;
+    if (_hits[i])
+      ++count;
+    else
+      _dists[i] = 0;
+  }
+  return count;
+}
+
+//////////////////////////////////////////////////
+std::size_t BoxPacket::IntersectCheck(const Vector3d &_origin,
+    const Vector3d &_dir, const double _min, const double _max,
+    std::vector<bool> &_hits) const
+{
+  std::vector<double> dists;
+  return this->Intersect(_origin, _dir, _min, _max, _hits, dists);
+}
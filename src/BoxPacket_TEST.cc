@@ -0,0 +1,143 @@
+/*
+ * Copyright (C) 2018 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <tuple>
+#include <vector>
+
+#include "ignition/math/BoxPacket.hh"
+#include "ignition/math/Rand.hh"
+
+using namespace ignition;
+
+/////////////////////////////////////////////////
+TEST(BoxPacketTest, Construction)
+{
+  math::BoxPacket packet;
+  EXPECT_TRUE(packet.Empty());
+  EXPECT_EQ(packet.Size(), 0u);
+
+  std::vector<bool> hits;
+  std::vector<double> dists;
+  EXPECT_EQ(packet.Intersect(math::Vector3d::Zero, math::Vector3d::UnitX,
+        0, 10, hits, dists), 0u);
+  EXPECT_TRUE(hits.empty());
+
+  const math::AxisAlignedBox box1(math::Vector3d(1, 2, 3),
+      math::Vector3d(4, 5, 6));
+  const math::AxisAlignedBox box2(math::Vector3d(-1, -2, -3),
+      math::Vector3d(0, 0, 0));
+  packet.PushBack(box1);
+  EXPECT_EQ(packet.Size(), 1u);
+  EXPECT_EQ(packet[0], box1);
+
+  math::BoxPacket packet2({box1, box2});
+  EXPECT_EQ(packet2.Size(), 2u);
+  EXPECT_EQ(packet2[1], box2);
+
+  math::BoxPacket packet3(packet2);
+  EXPECT_EQ(packet3[0], box1);
+  packet3 = packet;
+  EXPECT_EQ(packet3.Size(), 1u);
+
+  packet3.Assign({box2, box2, box1});
+  EXPECT_EQ(packet3.Size(), 3u);
+  EXPECT_EQ(packet3[2], box1);
+
+  packet3.Clear();
+  EXPECT_TRUE(packet3.Empty());
+}
+
+/////////////////////////////////////////////////
+TEST(BoxPacketTest, Intersect)
+{
+  const math::BoxPacket packet({
+      math::AxisAlignedBox(math::Vector3d(1, -1, -1), math::Vector3d(2, 1, 1)),
+      math::AxisAlignedBox(math::Vector3d(3, 1, -1), math::Vector3d(4, 2, 1)),
+      math::AxisAlignedBox(math::Vector3d(5, 0, -1), math::Vector3d(6, 1, 1)),
+      math::AxisAlignedBox(math::Vector3d(-2, -1, -1),
+          math::Vector3d(-1, 1, 1)),
+      math::AxisAlignedBox(math::Vector3d(20, -1, -1),
+          math::Vector3d(21, 1, 1))});
+
+  std::vector<bool> hits;
+  std::vector<double> dists;
+  // The ray lies on a face of the third box, and starts at distance 0.5
+  EXPECT_EQ(packet.Intersect(math::Vector3d::Zero, math::Vector3d(2, 0, 0),
+        0.5, 10, hits, dists), 2u);
+
+  const std::vector<bool> expectedHits = {true, false, true, false, false};
+  const std::vector<double> expectedDists = {0.5, 0, 4.5, 0, 0};
+  ASSERT_EQ(hits.size(), packet.Size());
+  for (std::size_t i = 0; i < packet.Size(); ++i)
+  {
+    EXPECT_EQ(hits[i], expectedHits[i]) << i;
+    EXPECT_NEAR(dists[i], expectedDists[i], 1e-12) << i;
+  }
+
+  std::vector<bool> checks;
+  EXPECT_EQ(packet.IntersectCheck(math::Vector3d::Zero,
+        math::Vector3d(2, 0, 0), 0.5, 10, checks), 2u);
+  EXPECT_EQ(checks, hits);
+}
+
+/////////////////////////////////////////////////
+TEST(BoxPacketTest, MatchesAxisAlignedBox)
+{
+  math::Rand::Seed(7);
+  std::vector<math::AxisAlignedBox> boxes;
+  for (int b = 0; b < 53; ++b)
+  {
+    const math::Vector3d corner(math::Rand::DblUniform(-3, 3),
+        math::Rand::DblUniform(-3, 3), math::Rand::DblUniform(-3, 3));
+    boxes.push_back(math::AxisAlignedBox(corner, corner + math::Vector3d(
+          math::Rand::DblUniform(0.1, 3), math::Rand::DblUniform(0.1, 3),
+          math::Rand::DblUniform(0.1, 3))));
+  }
+  const math::BoxPacket packet(boxes);
+
+  std::vector<bool> hits;
+  std::vector<double> dists;
+  int hitCount = 0;
+  for (int i = 0; i < 100; ++i)
+  {
+    const math::Vector3d origin(math::Rand::DblUniform(-5, 5),
+        math::Rand::DblUniform(-5, 5), math::Rand::DblUniform(-5, 5));
+    math::Vector3d dir(math::Rand::DblUniform(-1, 1),
+        math::Rand::DblUniform(-1, 1), math::Rand::DblUniform(-1, 1));
+    if (i % 4 == 0)
+      dir.Y(0);
+
+    const std::size_t count = packet.Intersect(origin, dir, 0.25, 9, hits,
+        dists);
+    std::size_t expectedCount = 0;
+    for (std::size_t b = 0; b < boxes.size(); ++b)
+    {
+      bool hit;
+      double dist;
+      std::tie(hit, dist) = boxes[b].IntersectDist(origin, dir, 0.25, 9);
+      EXPECT_EQ(hits[b], hit) << i << " " << b;
+      EXPECT_NEAR(dists[b], dist, 1e-9) << i << " " << b;
+      if (hit)
+        ++expectedCount;
+    }
+    EXPECT_EQ(count, expectedCount);
+    hitCount += static_cast<int>(count);
+  }
+  EXPECT_GT(hitCount, 0);
+}
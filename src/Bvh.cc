@@ -0,0 +1,232 @@
+/*
+ * Copyright (C) 2018 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include "ignition/math/Bvh.hh"
+#include "BvhBuilder.hh"
+
+using namespace ignition;
+using namespace math;
+using namespace detail;
+
+/// \brief Private data for Bvh
+class ignition::math::BvhPrivate
+{
+  /// \brief Nodes in depth-first order
+  public: std::vector<BvhNode> nodes;
+
+  /// \brief Bounds of the boxes, in the order of the leaves
+  public: std::vector<BvhBounds> boxes;
+
+  /// \brief Index in the input vector of each element of boxes
+  public: std::vector<std::size_t> indices;
+
+  /// \brief Number of boxes given to Build()
+  public: std::size_t size = 0;
+};
+
+//////////////////////////////////////////////////
+Bvh::Bvh()
+: dataPtr(new BvhPrivate)
+{
+}
+
+//////////////////////////////////////////////////
+Bvh::Bvh(const std::vector<AxisAlignedBox> &_boxes)
+: dataPtr(new BvhPrivate)
+{
+  this->Build(_boxes);
+}
+
+//////////////////////////////////////////////////
+Bvh::Bvh(const Bvh &_bvh)
+: dataPtr(new BvhPrivate(*_bvh.dataPtr))
+{
+}
+
+//////////////////////////////////////////////////
+Bvh::~Bvh()
+{
+}
+
+//////////////////////////////////////////////////
+Bvh &Bvh::operator=(const Bvh &_bvh)
+{
+  *this->dataPtr = *_bvh.dataPtr;
+  return *this;
+}
+
+//////////////////////////////////////////////////
+void Bvh::Build(const std::vector<AxisAlignedBox> &_boxes)
+{
+  this->dataPtr->nodes.clear();
+  this->dataPtr->boxes.clear();
+  this->dataPtr->indices.clear();
+  this->dataPtr->size = _boxes.size();
+
+  std::vector<BvhBuildBox> boxes;
+  boxes.reserve(_boxes.size());
+  for (std::size_t i = 0; i < _boxes.size(); ++i)
+  {
+    const Vector3d &min = _boxes[i].Min();
+    const Vector3d &max = _boxes[i].Max();
+    if (min.X() > max.X() || min.Y() > max.Y() || min.Z() > max.Z())
+      continue;
+
+    BvhBuildBox b;
+    for (int a = 0; a < 3; ++a)
+    {
+      b.bounds.min[a] = min[a];
+      b.bounds.max[a] = max[a];
+      b.centroid[a] = 0.5 * (min[a] + max[a]);
+    }
+    b.index = i;
+    boxes.push_back(b);
+  }
+
+  if (boxes.empty())
+    return;
+
+  BvhBuilder::Build(boxes, this->dataPtr->nodes);
+
+  this->dataPtr->boxes.reserve(boxes.size());
+  this->dataPtr->indices.reserve(boxes.size());
+  for (const BvhBuildBox &b : boxes)
+  {
+    this->dataPtr->boxes.push_back(b.bounds);
+    this->dataPtr->indices.push_back(b.index);
+  }
+}
+
+//////////////////////////////////////////////////
+std::size_t Bvh::Size() const
+{
+  return this->dataPtr->size;
+}
+
+//////////////////////////////////////////////////
+std::size_t Bvh::NodeCount() const
+{
+  return this->dataPtr->nodes.size();
+}
+
+//////////////////////////////////////////////////
+AxisAlignedBox Bvh::Bounds() const
+{
+  if (this->dataPtr->nodes.empty())
+    return AxisAlignedBox();
+
+  const auto &b = this->dataPtr->nodes[0].bounds;
+  return AxisAlignedBox(Vector3d(b.min[0], b.min[1], b.min[2]),
+                        Vector3d(b.max[0], b.max[1], b.max[2]));
+}
+
+//////////////////////////////////////////////////
+std::tuple<bool, double, std::size_t> Bvh::Intersect(
+    const Vector3d &_origin, const Vector3d &_dir, const double _min,
+    const double _max) const
+{
+  const BvhRay ray(_origin, _dir, _min, _max);
+  const BvhPrivate &d = *this->dataPtr;
+
+  double best = _max;
+  std::size_t bestIndex = 0;
+  bool hit = false;
+  BvhTraverseNearest(d.nodes, ray, best,
+      [&](const uint32_t _first, const uint32_t _count)
+      {
+        double t;
+        for (uint32_t i = _first; i < _first + _count; ++i)
+        {
+          if (!ray.Hit(d.boxes[i], best, t))
+            continue;
+          if (!hit || t < best || (!(best < t) && d.indices[i] < bestIndex))
+          {
+            hit = true;
+            best = t;
+            bestIndex = d.indices[i];
+          }
+        }
+      });
+
+  if (!hit)
+    return std::make_tuple(false, 0.0, std::size_t(0));
+  return std::make_tuple(true, best - _min, bestIndex);
+}
+
+//////////////////////////////////////////////////
+bool Bvh::IntersectCheck(const Vector3d &_origin, const Vector3d &_dir,
+    const double _min, const double _max) const
+{
+  const BvhRay ray(_origin, _dir, _min, _max);
+  bool hit = false;
+  double t;
+  BvhTraverse(this->dataPtr->nodes,
+      [&](const BvhBounds &_b) {return ray.HitNode(_b, ray.tMax, t);},
+      [&](const uint32_t _first, const uint32_t _count)
+      {
+        for (uint32_t i = _first; i < _first + _count && !hit; ++i)
+          hit = ray.Hit(this->dataPtr->boxes[i], ray.tMax, t);
+        return !hit;
+      });
+  return hit;
+}
+
+//////////////////////////////////////////////////
+bool Bvh::IntersectAll(const Vector3d &_origin, const Vector3d &_dir,
+    const double _min, const double _max,
+    std::vector<std::size_t> &_indices) const
+{
+  _indices.clear();
+  const BvhRay ray(_origin, _dir, _min, _max);
+  double t;
+  BvhTraverse(this->dataPtr->nodes,
+      [&](const BvhBounds &_b) {return ray.HitNode(_b, ray.tMax, t);},
+      [&](const uint32_t _first, const uint32_t _count)
+      {
+        for (uint32_t i = _first; i < _first + _count; ++i)
+        {
+          if (ray.Hit(this->dataPtr->boxes[i], ray.tMax, t))
+            _indices.push_back(this->dataPtr->indices[i]);
+        }
+        return true;
+      });
+  return !_indices.empty();
+}
+
+//////////////////////////////////////////////////
+bool Bvh::Overlap(const AxisAlignedBox &_box,
+    std::vector<std::size_t> &_indices) const
+{
+  _indices.clear();
+  BvhBounds box;
+  for (int a = 0; a < 3; ++a)
+  {
+    box.min[a] = _box.Min()[a];
+    box.max[a] = _box.Max()[a];
+  }
+  BvhTraverse(this->dataPtr->nodes,
+      [&](const BvhBounds &_b) {return box.Intersects(_b);},
+      [&](const uint32_t _first, const uint32_t _count)
+      {
+        for (uint32_t i = _first; i < _first + _count; ++i)
+        {
+          if (box.Intersects(this->dataPtr->boxes[i]))
+            _indices.push_back(this->dataPtr->indices[i]);
+        }
+        return true;
+      });
+  return !_indices.empty();
+}
@@ -0,0 +1,177 @@
+/*
+ * Copyright (C) 2018 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include "BvhBuilder.hh"
+
+using namespace ignition;
+using namespace math;
+using namespace detail;
+
+namespace
+{
+  /// \brief Number of bins used to evaluate the surface area heuristic
+  const std::size_t kBinCount = 16;
+
+  /// \brief Nodes with at most this number of primitives are always leaves
+  const std::size_t kMinLeafSize = 2;
+
+  /// \brief Nodes with more primitives than this are always split
+  const std::size_t kMaxLeafSize = 8;
+
+  /// \brief Depth after which nodes are split at the median, so that the
+  /// depth of the tree, and the traversal stack, remain bounded.
+  const int kMaxSahDepth = 64;
+
+  //////////////////////////////////////////////////
+  /// \brief Turn a node into a leaf.
+  /// \param[in,out] _node The node.
+  /// \param[in] _first Index of the first primitive of the leaf.
+  /// \param[in] _count Number of primitives of the leaf.
+  void MakeLeaf(BvhNode &_node, const std::size_t _first,
+      const std::size_t _count)
+  {
+    _node.offset = static_cast<uint32_t>(_first);
+    _node.count = static_cast<uint32_t>(_count);
+  }
+}  // namespace
+
+//////////////////////////////////////////////////
+void BvhBuilder::Build(std::vector<BvhBuildBox> &_boxes,
+    std::vector<BvhNode> &_nodes)
+{
+  _nodes.clear();
+  _nodes.reserve(2 * _boxes.size());
+  BuildNode(_boxes, 0, _boxes.size(), 0, _nodes);
+}
+
+//////////////////////////////////////////////////
+void BvhBuilder::BuildNode(std::vector<BvhBuildBox> &_boxes,
+    const std::size_t _begin, const std::size_t _end, const int _depth,
+    std::vector<BvhNode> &_nodes)
+{
+  const std::size_t nodeIndex = _nodes.size();
+  _nodes.emplace_back();
+
+  BvhBounds bounds, centroids;
+  for (std::size_t i = _begin; i < _end; ++i)
+  {
+    bounds.Grow(_boxes[i].bounds);
+    centroids.Grow(_boxes[i].centroid);
+  }
+  _nodes[nodeIndex].bounds = bounds;
+
+  const std::size_t count = _end - _begin;
+  int axis = 0;
+  for (int a = 1; a < 3; ++a)
+  {
+    if (centroids.max[a] - centroids.min[a] >
+        centroids.max[axis] - centroids.min[axis])
+    {
+      axis = a;
+    }
+  }
+  const double cMin = centroids.min[axis];
+  const double extent = centroids.max[axis] - cMin;
+
+  if (count <= kMinLeafSize || (extent <= 0 && count <= kMaxLeafSize))
+  {
+    MakeLeaf(_nodes[nodeIndex], _begin, count);
+    return;
+  }
+
+  std::size_t mid = _begin;
+  if (extent > 0 && _depth < kMaxSahDepth)
+  {
+    // Bin the centroids, and find the split with the lowest cost
+    const double scale = kBinCount / extent;
+    auto binOf = [&](const BvhBuildBox &_b)
+    {
+      return std::min(kBinCount - 1,
+          static_cast<std::size_t>((_b.centroid[axis] - cMin) * scale));
+    };
+
+    std::size_t binCounts[kBinCount] = {0};
+    BvhBounds binBounds[kBinCount];
+    for (std::size_t i = _begin; i < _end; ++i)
+    {
+      const std::size_t bin = binOf(_boxes[i]);
+      ++binCounts[bin];
+      binBounds[bin].Grow(_boxes[i].bounds);
+    }
+
+    // Cost of the boxes right of each split, swept from the right
+    double rightCost[kBinCount];
+    BvhBounds rightBounds;
+    std::size_t rightCount = 0;
+    for (std::size_t b = kBinCount - 1; b > 0; --b)
+    {
+      rightBounds.Grow(binBounds[b]);
+      rightCount += binCounts[b];
+      rightCost[b] = rightBounds.HalfArea() * rightCount;
+    }
+
+    // Split between bin bestSplit - 1 and bestSplit
+    std::size_t bestSplit = 0;
+    double bestCost = std::numeric_limits<double>::max();
+    BvhBounds leftBounds;
+    std::size_t leftCount = 0;
+    for (std::size_t b = 1; b < kBinCount; ++b)
+    {
+      leftBounds.Grow(binBounds[b - 1]);
+      leftCount += binCounts[b - 1];
+      if (leftCount == 0 || leftCount == count)
+        continue;
+      const double cost = leftBounds.HalfArea() * leftCount + rightCost[b];
+      if (cost < bestCost)
+      {
+        bestCost = cost;
+        bestSplit = b;
+      }
+    }
+
+    // Keep a leaf if splitting does not reduce the cost
+    if (count <= kMaxLeafSize && bestCost >= bounds.HalfArea() * count)
+    {
+      MakeLeaf(_nodes[nodeIndex], _begin, count);
+      return;
+    }
+
+    if (bestSplit > 0)
+    {
+      mid = std::partition(_boxes.begin() + _begin, _boxes.begin() + _end,
+          [&](const BvhBuildBox &_b) {return binOf(_b) < bestSplit;}) -
+        _boxes.begin();
+    }
+  }
+
+  // Median split, for deep subtrees and boxes with the same centroid
+  if (mid == _begin || mid == _end)
+  {
+    mid = _begin + count / 2;
+    std::nth_element(_boxes.begin() + _begin, _boxes.begin() + mid,
+        _boxes.begin() + _end,
+        [axis](const BvhBuildBox &_a, const BvhBuildBox &_b)
+        {
+          return _a.centroid[axis] < _b.centroid[axis];
+        });
+  }
+
+  BuildNode(_boxes, _begin, mid, _depth + 1, _nodes);
+  const std::size_t right = _nodes.size();
+  BuildNode(_boxes, mid, _end, _depth + 1, _nodes);
+  _nodes[nodeIndex].offset = static_cast<uint32_t>(right);
+  _nodes[nodeIndex].count = 0;
+}
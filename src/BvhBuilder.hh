@@ -0,0 +1,376 @@
+/*
+ * Copyright (C) 2018 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef IGNITION_MATH_BVHBUILDER_HH_
+#define IGNITION_MATH_BVHBUILDER_HH_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include <ignition/math/Vector3.hh>
+#include <ignition/math/config.hh>
+
+// Bounding volume hierarchy shared by Bvh and TriangleMesh. The tree is
+// built over the bounds of the primitives and stored as a flat array of
+// nodes in depth-first order. The primitives themselves are stored by the
+// users of the tree, in the order of the leaves.
+
+namespace ignition
+{
+  namespace math
+  {
+    inline namespace IGNITION_MATH_VERSION_NAMESPACE
+    {
+    namespace detail
+    {
+    /// \internal
+    /// \brief Size of the traversal stack, larger than the depth of any
+    /// tree built by BvhBuilder.
+    const int kBvhStackSize = 128;
+
+    /// \internal
+    /// \brief Bounds of a node or a primitive, as plain arrays.
+    struct BvhBounds
+    {
+      /// \brief Minimum corner
+      double min[3] = {std::numeric_limits<double>::max(),
+                       std::numeric_limits<double>::max(),
+                       std::numeric_limits<double>::max()};
+
+      /// \brief Maximum corner
+      double max[3] = {std::numeric_limits<double>::lowest(),
+                       std::numeric_limits<double>::lowest(),
+                       std::numeric_limits<double>::lowest()};
+
+      /// \brief Grow the bounds to contain other bounds.
+      /// \param[in] _b Bounds to contain.
+      void Grow(const BvhBounds &_b)
+      {
+        for (int a = 0; a < 3; ++a)
+        {
+          this->min[a] = std::min(this->min[a], _b.min[a]);
+          this->max[a] = std::max(this->max[a], _b.max[a]);
+        }
+      }
+
+      /// \brief Grow the bounds to contain a point.
+      /// \param[in] _p Point to contain.
+      void Grow(const double *_p)
+      {
+        for (int a = 0; a < 3; ++a)
+        {
+          this->min[a] = std::min(this->min[a], _p[a]);
+          this->max[a] = std::max(this->max[a], _p[a]);
+        }
+      }
+
+      /// \brief Half of the surface area, zero for empty bounds.
+      /// \return The half area.
+      double HalfArea() const
+      {
+        const double dx = this->max[0] - this->min[0];
+        const double dy = this->max[1] - this->min[1];
+        const double dz = this->max[2] - this->min[2];
+        if (dx < 0 || dy < 0 || dz < 0)
+          return 0;
+        return dx * dy + dy * dz + dz * dx;
+      }
+
+      /// \brief Check whether these bounds intersect others, with the
+      /// rule of AxisAlignedBox::Intersects().
+      /// \param[in] _b Other bounds.
+      /// \return True if the bounds intersect.
+      bool Intersects(const BvhBounds &_b) const
+      {
+        return this->max[0] >= _b.min[0] && this->min[0] <= _b.max[0] &&
+               this->max[1] >= _b.min[1] && this->min[1] <= _b.max[1] &&
+               this->max[2] >= _b.min[2] && this->min[2] <= _b.max[2];
+      }
+    };
+
+    /// \internal
+    /// \brief A primitive being sorted into the tree.
+    struct BvhBuildBox
+    {
+      /// \brief Bounds of the primitive
+      BvhBounds bounds;
+
+      /// \brief Center of the bounds
+      double centroid[3];
+
+      /// \brief Index of the primitive in the input of the user
+      std::size_t index;
+    };
+
+    /// \internal
+    /// \brief A node of the flattened tree. The left child of an inner
+    /// node is the next node in the array.
+    struct BvhNode
+    {
+      /// \brief Bounds of all the primitives below the node
+      BvhBounds bounds;
+
+      /// \brief Index of the right child for inner nodes, index of the
+      /// first primitive for leaves.
+      uint32_t offset;
+
+      /// \brief Number of primitives of a leaf, 0 for inner nodes
+      uint32_t count;
+    };
+
+    /// \internal
+    /// \brief A ray, prepared for the slab test.
+    struct BvhRay
+    {
+      /// \brief Origin
+      double origin[3];
+
+      /// \brief Normalized direction
+      double dir[3];
+
+      /// \brief Inverse of the normalized direction
+      double invDir[3];
+
+      /// \brief Whether the direction is zero along each axis
+      bool parallel[3];
+
+      /// \brief Minimum distance along the ray
+      double tMin;
+
+      /// \brief Maximum distance along the ray
+      double tMax;
+
+      /// \brief Constructor.
+      /// \param[in] _origin Origin of the ray.
+      /// \param[in] _dir Direction of the ray, normalized here.
+      /// \param[in] _min Minimum distance.
+      /// \param[in] _max Maximum distance.
+      BvhRay(const Vector3d &_origin, const Vector3d &_dir,
+          const double _min, const double _max)
+      : tMin(_min), tMax(_max)
+      {
+        const Vector3d dirNorm = _dir.Normalized();
+        for (int a = 0; a < 3; ++a)
+        {
+          this->origin[a] = _origin[a];
+          this->dir[a] = dirNorm[a];
+          this->parallel[a] = !(dirNorm[a] < 0) && !(dirNorm[a] > 0);
+          this->invDir[a] = this->parallel[a] ? 0 : 1 / dirNorm[a];
+        }
+      }
+
+      /// \brief Slab test of the ray against bounds. The result is exact
+      /// for the bounds of primitives, but rounding can miss bounds that
+      /// have no thickness, see HitNode().
+      /// \param[in] _b The bounds.
+      /// \param[in] _tFar Maximum distance of interest, at most tMax.
+      /// \param[out] _tEntry Distance at which the ray enters the bounds,
+      /// at least tMin.
+      /// \return True if the ray hits the bounds between tMin and _tFar.
+      bool Hit(const BvhBounds &_b, const double _tFar, double &_tEntry) const
+      {
+        double t0 = this->tMin;
+        double t1 = _tFar;
+        for (int a = 0; a < 3; ++a)
+        {
+          if (this->parallel[a])
+          {
+            if (this->origin[a] < _b.min[a] || this->origin[a] > _b.max[a])
+              return false;
+            continue;
+          }
+          double tNear = (_b.min[a] - this->origin[a]) * this->invDir[a];
+          double tFar = (_b.max[a] - this->origin[a]) * this->invDir[a];
+          if (tNear > tFar)
+            std::swap(tNear, tFar);
+          t0 = std::max(t0, tNear);
+          t1 = std::min(t1, tFar);
+          if (t0 > t1)
+            return false;
+        }
+        _tEntry = t0;
+        return true;
+      }
+
+      /// \brief Conservative slab test of the ray against the bounds of a
+      /// node. The exit distances are enlarged by the rounding error of
+      /// their computation, so that rays hitting a primitive never miss
+      /// the nodes above it, even when the primitive lies on a face of
+      /// the node, as flat triangles often do.
+      /// \param[in] _b The bounds.
+      /// \param[in] _tFar Maximum distance of interest, at most tMax.
+      /// \param[out] _tEntry Distance at which the ray enters the bounds,
+      /// at least tMin.
+      /// \return True if the ray may hit the bounds between tMin and
+      /// _tFar.
+      bool HitNode(const BvhBounds &_b, const double _tFar,
+          double &_tEntry) const
+      {
+        // 1 + 2 gamma(3), with gamma(n) = n eps / (1 - n eps), as in
+        // "Robust BVH ray traversal" by T. Ize.
+        const double eps = std::numeric_limits<double>::epsilon() * 0.5;
+        const double scale = 1 + 2 * (3 * eps / (1 - 3 * eps));
+
+        double t0 = this->tMin;
+        double t1 = _tFar;
+        for (int a = 0; a < 3; ++a)
+        {
+          if (this->parallel[a])
+          {
+            if (this->origin[a] < _b.min[a] || this->origin[a] > _b.max[a])
+              return false;
+            continue;
+          }
+          double tNear = (_b.min[a] - this->origin[a]) * this->invDir[a];
+          double tFar = (_b.max[a] - this->origin[a]) * this->invDir[a];
+          if (tNear > tFar)
+            std::swap(tNear, tFar);
+          t0 = std::max(t0, tNear);
+          t1 = std::min(t1, tFar * scale);
+          if (t0 > t1)
+            return false;
+        }
+        _tEntry = t0;
+        return true;
+      }
+    };
+
+    /// \internal
+    /// \brief Builder of the tree, with the surface area heuristic
+    /// evaluated on bins.
+    class BvhBuilder
+    {
+      /// \brief Build the tree of a set of primitives.
+      /// \param[in,out] _boxes Bounds of the primitives, sorted in the
+      /// order of the leaves on return. Must not be empty.
+      /// \param[out] _nodes Nodes of the tree, replaced.
+      public: static void Build(std::vector<BvhBuildBox> &_boxes,
+                  std::vector<BvhNode> &_nodes);
+
+      /// \brief Build the subtree of the primitives in [_begin, _end).
+      /// \param[in,out] _boxes Primitives to sort into the tree.
+      /// \param[in] _begin First primitive of the subtree.
+      /// \param[in] _end One past the last primitive of the subtree.
+      /// \param[in] _depth Depth of the subtree root.
+      /// \param[in,out] _nodes Nodes of the tree.
+      private: static void BuildNode(std::vector<BvhBuildBox> &_boxes,
+                   const std::size_t _begin, const std::size_t _end,
+                   const int _depth, std::vector<BvhNode> &_nodes);
+    };
+
+    /// \internal
+    /// \brief Visit the leaves whose bounds pass a test.
+    /// \param[in] _nodes Nodes of the tree.
+    /// \param[in] _nodeTest Callable taking the bounds of a node, and
+    /// returning whether to visit it.
+    /// \param[in] _leafVisit Callable taking the position of the first
+    /// primitive of a leaf and the number of primitives, and returning
+    /// false to stop the traversal.
+    template<typename NodeTest, typename LeafVisit>
+    void BvhTraverse(const std::vector<BvhNode> &_nodes, NodeTest _nodeTest,
+        LeafVisit _leafVisit)
+    {
+      if (_nodes.empty())
+        return;
+
+      uint32_t stack[kBvhStackSize];
+      int top = 0;
+      stack[top++] = 0;
+      while (top > 0)
+      {
+        const uint32_t nodeIndex = stack[--top];
+        const BvhNode &node = _nodes[nodeIndex];
+        if (!_nodeTest(node.bounds))
+          continue;
+
+        if (node.count > 0)
+        {
+          if (!_leafVisit(node.offset, node.count))
+            return;
+        }
+        else
+        {
+          stack[top++] = node.offset;
+          stack[top++] = nodeIndex + 1;
+        }
+      }
+    }
+
+    /// \internal
+    /// \brief Visit the leaves hit by a ray, nearest child first, and skip
+    /// the nodes farther than the closest hit found so far.
+    /// \param[in] _nodes Nodes of the tree.
+    /// \param[in] _ray The ray.
+    /// \param[in,out] _best Distance of the closest hit, initially the
+    /// maximum distance of interest.
+    /// \param[in] _leafVisit Callable taking the position of the first
+    /// primitive of a leaf and the number of primitives, which lowers
+    /// _best when it finds a closer hit.
+    template<typename LeafVisit>
+    void BvhTraverseNearest(const std::vector<BvhNode> &_nodes,
+        const BvhRay &_ray, double &_best, LeafVisit _leafVisit)
+    {
+      double t;
+      if (_nodes.empty() || !_ray.HitNode(_nodes[0].bounds, _best, t))
+        return;
+
+      uint32_t stack[kBvhStackSize];
+      double stackDist[kBvhStackSize];
+      int top = 0;
+      stack[top] = 0;
+      stackDist[top++] = t;
+
+      while (top > 0)
+      {
+        --top;
+        if (stackDist[top] > _best)
+          continue;
+        const uint32_t nodeIndex = stack[top];
+        const BvhNode &node = _nodes[nodeIndex];
+
+        if (node.count > 0)
+        {
+          _leafVisit(node.offset, node.count);
+          continue;
+        }
+
+        const uint32_t children[2] = {nodeIndex + 1, node.offset};
+        double dist[2];
+        const bool hits[2] =
+        {
+          _ray.HitNode(_nodes[children[0]].bounds, _best, dist[0]),
+          _ray.HitNode(_nodes[children[1]].bounds, _best, dist[1])
+        };
+        const int nearest = hits[0] && hits[1] && dist[1] < dist[0] ? 1 : 0;
+        const int order[2] = {1 - nearest, nearest};
+        for (const int c : order)
+        {
+          if (hits[c])
+          {
+            stack[top] = children[c];
+            stackDist[top++] = dist[c];
+          }
+        }
+      }
+    }
+    }
+    }
+  }
+}
+#endif
@@ -0,0 +1,243 @@
+/*
+ * Copyright (C) 2018 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <tuple>
+#include <vector>
+
+#include "ignition/math/Bvh.hh"
+#include "ignition/math/Rand.hh"
+
+using namespace ignition;
+
+/////////////////////////////////////////////////
+/// \brief Random boxes of size up to _size in a cube of side 100.
+std::vector<math::AxisAlignedBox> RandomBoxes(const std::size_t _n,
+    const double _size)
+{
+  std::vector<math::AxisAlignedBox> boxes;
+  for (std::size_t i = 0; i < _n; ++i)
+  {
+    const math::Vector3d min(math::Rand::DblUniform(-50, 50),
+        math::Rand::DblUniform(-50, 50), math::Rand::DblUniform(-50, 50));
+    const math::Vector3d size(math::Rand::DblUniform(0, _size),
+        math::Rand::DblUniform(0, _size), math::Rand::DblUniform(0, _size));
+    boxes.push_back(math::AxisAlignedBox(min, min + size));
+  }
+  return boxes;
+}
+
+/////////////////////////////////////////////////
+math::Vector3d RandomVector(const double _range)
+{
+  return math::Vector3d(math::Rand::DblUniform(-_range, _range),
+      math::Rand::DblUniform(-_range, _range),
+      math::Rand::DblUniform(-_range, _range));
+}
+
+/////////////////////////////////////////////////
+TEST(BvhTest, Empty)
+{
+  math::Bvh bvh;
+  EXPECT_EQ(0u, bvh.Size());
+  EXPECT_EQ(0u, bvh.NodeCount());
+  EXPECT_EQ(math::AxisAlignedBox(), bvh.Bounds());
+
+  const math::Vector3d origin(0, 0, 0);
+  const math::Vector3d dir(1, 0, 0);
+  EXPECT_FALSE(std::get<0>(bvh.Intersect(origin, dir, 0, 100)));
+  EXPECT_FALSE(bvh.IntersectCheck(origin, dir, 0, 100));
+  std::vector<std::size_t> hits = {1, 2};
+  EXPECT_FALSE(bvh.IntersectAll(origin, dir, 0, 100, hits));
+  EXPECT_TRUE(hits.empty());
+  EXPECT_FALSE(bvh.Overlap(math::AxisAlignedBox(origin, dir), hits));
+
+  // Empty boxes are ignored
+  bvh.Build({math::AxisAlignedBox()});
+  EXPECT_EQ(1u, bvh.Size());
+  EXPECT_EQ(0u, bvh.NodeCount());
+  EXPECT_FALSE(bvh.IntersectCheck(origin, dir, 0, 100));
+}
+
+/////////////////////////////////////////////////
+TEST(BvhTest, Simple)
+{
+  const std::vector<math::AxisAlignedBox> boxes =
+  {
+    math::AxisAlignedBox(math::Vector3d(4, -1, -1), math::Vector3d(6, 1, 1)),
+    math::AxisAlignedBox(math::Vector3d(1, -1, -1), math::Vector3d(2, 1, 1)),
+    math::AxisAlignedBox(math::Vector3d(1, 5, 5), math::Vector3d(2, 6, 6)),
+    math::AxisAlignedBox()
+  };
+  const math::Bvh bvh(boxes);
+  EXPECT_EQ(4u, bvh.Size());
+  EXPECT_LT(0u, bvh.NodeCount());
+  EXPECT_EQ(math::AxisAlignedBox(math::Vector3d(1, -1, -1),
+        math::Vector3d(6, 6, 6)), bvh.Bounds());
+
+  const math::Vector3d origin(0, 0, 0);
+  bool hit;
+  double dist;
+  std::size_t index;
+  std::tie(hit, dist, index) = bvh.Intersect(origin, {2, 0, 0}, 0, 100);
+  EXPECT_TRUE(hit);
+  EXPECT_DOUBLE_EQ(1.0, dist);
+  EXPECT_EQ(1u, index);
+
+  // The distance is measured from the minimum distance, like
+  // AxisAlignedBox::IntersectDist
+  std::tie(hit, dist, index) = bvh.Intersect(origin, {1, 0, 0}, 3, 100);
+  EXPECT_TRUE(hit);
+  EXPECT_DOUBLE_EQ(1.0, dist);
+  EXPECT_EQ(0u, index);
+  EXPECT_DOUBLE_EQ(1.0, std::get<1>(boxes[0].IntersectDist(origin,
+          {1, 0, 0}, 3, 100)));
+
+  // Starting inside a box
+  std::tie(hit, dist, index) = bvh.Intersect(origin, {1, 0, 0}, 1.5, 100);
+  EXPECT_TRUE(hit);
+  EXPECT_DOUBLE_EQ(0.0, dist);
+  EXPECT_EQ(1u, index);
+
+  // Maximum distance
+  EXPECT_FALSE(bvh.IntersectCheck(origin, {1, 0, 0}, 0, 0.5));
+  EXPECT_TRUE(bvh.IntersectCheck(origin, {1, 0, 0}, 0, 1.5));
+  EXPECT_FALSE(bvh.IntersectCheck(origin, {-1, 0, 0}, 0, 100));
+
+  std::vector<std::size_t> hits;
+  EXPECT_TRUE(bvh.IntersectAll(origin, {1, 0, 0}, 0, 100, hits));
+  std::sort(hits.begin(), hits.end());
+  EXPECT_EQ(std::vector<std::size_t>({0, 1}), hits);
+
+  // Ray parallel to an axis, inside the slab of the box
+  EXPECT_TRUE(bvh.IntersectAll({1.5, 5.5, 0}, {0, 0, 1}, 0, 100, hits));
+  EXPECT_EQ(std::vector<std::size_t>({2}), hits);
+
+  EXPECT_TRUE(bvh.Overlap(math::AxisAlignedBox(math::Vector3d(1.5, 0, 0),
+          math::Vector3d(5.5, 5.5, 5.5)), hits));
+  std::sort(hits.begin(), hits.end());
+  EXPECT_EQ(std::vector<std::size_t>({0, 1, 2}), hits);
+  EXPECT_FALSE(bvh.Overlap(math::AxisAlignedBox(math::Vector3d(10, 0, 0),
+          math::Vector3d(11, 1, 1)), hits));
+}
+
+/////////////////////////////////////////////////
+TEST(BvhTest, BruteForce)
+{
+  math::Rand::Seed(7);
+  const std::vector<math::AxisAlignedBox> boxes = RandomBoxes(2000, 3);
+  math::Bvh bvh(boxes);
+  EXPECT_EQ(boxes.size(), bvh.Size());
+
+  // A copy gives the same results
+  const math::Bvh copy(bvh);
+  bvh = math::Bvh();
+  EXPECT_EQ(0u, bvh.Size());
+  bvh = copy;
+
+  for (int r = 0; r < 200; ++r)
+  {
+    const math::Vector3d origin = RandomVector(60);
+    const math::Vector3d dir = RandomVector(1);
+    const double min = math::Rand::DblUniform(0, 10);
+    const double max = min + math::Rand::DblUniform(0, 150);
+
+    bool expectedHit = false;
+    double expectedDist = 0;
+    std::vector<std::size_t> expectedAll;
+    for (std::size_t i = 0; i < boxes.size(); ++i)
+    {
+      bool hit;
+      double dist;
+      std::tie(hit, dist) = boxes[i].IntersectDist(origin, dir, min, max);
+      if (!hit)
+        continue;
+      expectedAll.push_back(i);
+      if (!expectedHit || dist < expectedDist)
+        expectedDist = dist;
+      expectedHit = true;
+    }
+
+    bool hit;
+    double dist;
+    std::size_t index;
+    std::tie(hit, dist, index) = bvh.Intersect(origin, dir, min, max);
+    ASSERT_EQ(expectedHit, hit);
+    EXPECT_EQ(expectedHit, bvh.IntersectCheck(origin, dir, min, max));
+    if (hit)
+    {
+      EXPECT_NEAR(expectedDist, dist, 1e-9);
+      EXPECT_NEAR(expectedDist, std::get<1>(boxes[index].IntersectDist(
+            origin, dir, min, max)), 1e-9);
+    }
+
+    std::vector<std::size_t> all;
+    EXPECT_EQ(expectedHit, bvh.IntersectAll(origin, dir, min, max, all));
+    std::sort(all.begin(), all.end());
+    EXPECT_EQ(expectedAll, all);
+  }
+
+  for (int q = 0; q < 100; ++q)
+  {
+    const math::Vector3d min = RandomVector(55);
+    const math::AxisAlignedBox query(min, min + math::Vector3d(5, 8, 3));
+    std::vector<std::size_t> expected, overlap;
+    for (std::size_t i = 0; i < boxes.size(); ++i)
+    {
+      if (query.Intersects(boxes[i]))
+        expected.push_back(i);
+    }
+    EXPECT_EQ(!expected.empty(), bvh.Overlap(query, overlap));
+    std::sort(overlap.begin(), overlap.end());
+    EXPECT_EQ(expected, overlap);
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(BvhTest, Degenerate)
+{
+  // Many boxes with the same center, and boxes along a line with
+  // exponentially growing distances, which give unbalanced splits
+  std::vector<math::AxisAlignedBox> boxes;
+  for (int i = 0; i < 100; ++i)
+  {
+    boxes.push_back(math::AxisAlignedBox(math::Vector3d(-i, -i, -i),
+          math::Vector3d(i, i, i)));
+  }
+  double x = 1;
+  for (int i = 0; i < 300; ++i, x *= 1.1)
+  {
+    boxes.push_back(math::AxisAlignedBox(math::Vector3d(x, 0, 0),
+          math::Vector3d(x + 0.01, 0.01, 0.01)));
+  }
+  const math::Bvh bvh(boxes);
+
+  std::vector<std::size_t> hits;
+  EXPECT_TRUE(bvh.IntersectAll({-1000, 0.005, 0.005}, {1, 0, 0}, 0,
+        1e20, hits));
+  EXPECT_EQ(boxes.size() - 1, hits.size());
+
+  bool hit;
+  double dist;
+  std::size_t index;
+  std::tie(hit, dist, index) = bvh.Intersect({1e13, 0.005, 0.005},
+      {-1, 0, 0}, 0, 1e20);
+  EXPECT_TRUE(hit);
+  EXPECT_EQ(boxes.size() - 1, index);
+}
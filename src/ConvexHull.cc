@@ -0,0 +1,1248 @@
+/*
+ * Copyright (C) 2018 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <thread>
+
+#include "ignition/math/ConvexHull.hh"
+#include "ignition/math/Vector2.hh"
+
+using namespace ignition;
+using namespace math;
+
+namespace
+{
+  /// \brief Marks the end of a list, or no face or edge
+  const uint32_t kNone = std::numeric_limits<uint32_t>::max();
+
+  /// \brief Mark of a face of the hull
+  const uint8_t kAlive = 0;
+
+  /// \brief Mark of a face of the hull that is not convex with one of its
+  /// neighbors, during the second merge pass
+  const uint8_t kNonConvex = 1;
+
+  /// \brief Mark of a face that was removed from the hull
+  const uint8_t kDeleted = 2;
+
+  /// \brief A half edge, which goes from the vertex of the previous half
+  /// edge of its face to its own vertex
+  struct HalfEdge
+  {
+    /// \brief Point at the end of the half edge
+    uint32_t vertex;
+
+    /// \brief Face on the left of the half edge, seen from outside
+    uint32_t face;
+
+    /// \brief Next half edge of the face, counter-clockwise
+    uint32_t next;
+
+    /// \brief Previous half edge of the face
+    uint32_t prev;
+
+    /// \brief Opposite half edge, in the neighbor face
+    uint32_t twin;
+  };
+
+  /// \brief A convex polygon of the hull
+  struct Face
+  {
+    /// \brief Unit normal, pointing out of the hull
+    Vector3d normal;
+
+    /// \brief Average of the vertices
+    Vector3d centroid;
+
+    /// \brief Distance of the plane of the face from the origin
+    double offset;
+
+    /// \brief Twice the area of the face
+    double area;
+
+    /// \brief One of the half edges
+    uint32_t edge;
+
+    /// \brief First point of the outside set, the points in front of the
+    /// face that are assigned to it
+    uint32_t outside;
+
+    /// \brief kAlive, kNonConvex or kDeleted
+    uint8_t mark;
+  };
+
+  /// \brief An edge of the horizon, between the faces seen from the added
+  /// point and the other faces
+  struct HorizonEdge
+  {
+    /// \brief Start point of the half edge of the visible face
+    uint32_t tail;
+
+    /// \brief End point of the half edge of the visible face
+    uint32_t head;
+
+    /// \brief Half edge of the face that stays in the hull
+    uint32_t twin;
+  };
+
+  /// \brief State of a face during the search of the horizon
+  struct Visit
+  {
+    /// \brief Next half edge to cross
+    uint32_t edge;
+
+    /// \brief Half edge at which the search of the face ends
+    uint32_t stop;
+  };
+
+  /// \brief How a face is tested against its neighbors for merging
+  enum class MergeType
+  {
+    /// \brief Merge if the larger face is not convex with the smaller one
+    LARGER_FACE,
+
+    /// \brief Merge if either face is not convex with the other one
+    EITHER_FACE
+  };
+
+  //////////////////////////////////////////////////
+  /// \brief Get on which side of a line a point is.
+  /// \param[in] _a First point of the line.
+  /// \param[in] _b Second point of the line.
+  /// \param[in] _c The point.
+  /// \return Positive if _c is on the left of the line from _a to _b,
+  /// negative on the right, zero on the line.
+  double Turn(const Vector2d &_a, const Vector2d &_b, const Vector2d &_c)
+  {
+    return (_b.X() - _a.X()) * (_c.Y() - _a.Y()) -
+      (_b.Y() - _a.Y()) * (_c.X() - _a.X());
+  }
+
+  //////////////////////////////////////////////////
+  /// \brief Get the number of points of a set.
+  /// \param[in] _points The points.
+  /// \return Number of points.
+  std::size_t PointCount(const std::vector<Vector3d> &_points)
+  {
+    return _points.size();
+  }
+
+  //////////////////////////////////////////////////
+  /// \brief Get the number of points of a view.
+  /// \param[in] _points The points.
+  /// \return Number of points.
+  std::size_t PointCount(const Vector3View<double> &_points)
+  {
+    return _points.Size();
+  }
+}  // namespace
+
+// Private data for ConvexHull class
+class ignition::math::ConvexHullPrivate
+{
+  /// \brief Build the hull of a set of points.
+  /// \param[in] _points The points, a std::vector or a Vector3View.
+  /// \param[in] _maxVertices Largest number of vertices, 0 for no limit.
+  /// \return False if the points do not span a volume.
+  public: template<typename Points>
+          bool Build(const Points &_points, const std::size_t _maxVertices);
+
+  /// \brief Create the first tetrahedron and assign the other points to
+  /// its faces.
+  /// \return False if the points do not span a volume.
+  public: bool Simplex();
+
+  /// \brief Find the next point to add to the hull.
+  /// \param[in] _furthest True to return the point furthest from the hull,
+  /// false to return the furthest point of any face.
+  /// \param[out] _face Face of the point.
+  /// \return The point, kNone if no point is outside the hull.
+  public: uint32_t NextPoint(const bool _furthest, uint32_t &_face);
+
+  /// \brief Add a point to the hull.
+  /// \param[in] _point The point.
+  /// \param[in] _face Face whose outside set contains the point.
+  public: void AddPoint(const uint32_t _point, const uint32_t _face);
+
+  /// \brief Remove a face seen from the added point, and keep its
+  /// outside points.
+  /// \param[in] _face The face.
+  /// \param[in] _eye The added point, which is not kept.
+  public: void RemoveVisible(const uint32_t _face, const uint32_t _eye);
+
+  /// \brief Merge a face with the first neighbor that is not convex with
+  /// it.
+  /// \param[in] _face The face.
+  /// \param[in] _type How the faces are compared.
+  /// \return True if a neighbor was merged.
+  public: bool MergeAdjacent(const uint32_t _face, const MergeType _type);
+
+  /// \brief Merge the neighbor face across a half edge into a face.
+  /// \param[in] _face The face.
+  /// \param[in] _edge Half edge of _face.
+  public: void MergeFace(const uint32_t _face, const uint32_t _edge);
+
+  /// \brief Connect two half edges of a face that were separated by a
+  /// merge, removing the vertex between them if both border the same
+  /// face.
+  /// \param[in] _face The face.
+  /// \param[in] _prev First half edge.
+  /// \param[in] _edge Second half edge.
+  public: void Connect(const uint32_t _face, const uint32_t _prev,
+              const uint32_t _edge);
+
+  /// \brief Remove a face absorbed by a merge. Its outside points are
+  /// assigned again with those of the visible faces.
+  /// \param[in] _face The removed face.
+  public: void Discard(const uint32_t _face);
+
+  /// \brief Create a triangle.
+  /// \param[in] _a First corner.
+  /// \param[in] _b Second corner.
+  /// \param[in] _c Third corner.
+  /// \return Index of the face, whose edge goes from _a to _b.
+  public: uint32_t NewTriangle(const uint32_t _a, const uint32_t _b,
+              const uint32_t _c);
+
+  /// \brief Get a half edge from the pool.
+  /// \param[in] _vertex End point of the half edge.
+  /// \param[in] _face Face of the half edge.
+  /// \return Index of the half edge.
+  public: uint32_t NewEdge(const uint32_t _vertex, const uint32_t _face);
+
+  /// \brief Make two half edges opposite to each other.
+  /// \param[in] _a First half edge.
+  /// \param[in] _b Second half edge.
+  public: void Link(const uint32_t _a, const uint32_t _b)
+  {
+    this->edges[_a].twin = _b;
+    this->edges[_b].twin = _a;
+  }
+
+  /// \brief Get the face on the other side of a half edge.
+  /// \param[in] _edge The half edge.
+  /// \return The opposite face.
+  public: uint32_t Opposite(const uint32_t _edge) const
+  {
+    return this->edges[this->edges[_edge].twin].face;
+  }
+
+  /// \brief Compute the normal, centroid and area of a face.
+  /// \param[in] _face The face.
+  public: void UpdatePlane(const uint32_t _face);
+
+  /// \brief Get the signed distance of a position from the plane of a
+  /// face.
+  /// \param[in] _face The face.
+  /// \param[in] _pos The position.
+  /// \return Distance, positive in front of the face.
+  public: double Distance(const uint32_t _face, const Vector3d &_pos) const
+  {
+    const Face &face = this->faces[_face];
+    return face.normal.Dot(_pos) - face.offset;
+  }
+
+  /// \brief Get the distance of the centroid of the face across a half
+  /// edge from the plane of the face of the half edge.
+  /// \param[in] _edge The half edge.
+  /// \return Distance, positive if the faces are not convex.
+  public: double OppositeDistance(const uint32_t _edge) const
+  {
+    return this->Distance(this->edges[_edge].face,
+        this->faces[this->Opposite(_edge)].centroid);
+  }
+
+  /// \brief Add a point to the outside set of a face.
+  /// \param[in] _point The point.
+  /// \param[in] _face The face.
+  public: void AddOutside(const uint32_t _point, const uint32_t _face)
+  {
+    this->next[_point] = this->faces[_face].outside;
+    this->faces[_face].outside = _point;
+  }
+
+  /// \brief Copy the faces of the hull to the output, as triangles.
+  public: void Output();
+
+  /// \brief Add the triangles of a face to the output.
+  /// \param[in] _face The face.
+  public: void Triangulate(const Face &_face);
+
+  /// \brief Points without NaN or infinite coordinates
+  public: std::vector<Vector3d> points;
+
+  /// \brief Index in the input of each point
+  public: std::vector<uint32_t> index;
+
+  /// \brief Next point in the outside set of each point
+  public: std::vector<uint32_t> next;
+
+  /// \brief Pool of faces
+  public: std::vector<Face> faces;
+
+  /// \brief Pool of half edges
+  public: std::vector<HalfEdge> edges;
+
+  /// \brief Faces removed from the hull, reused first
+  public: std::vector<uint32_t> freeFaces;
+
+  /// \brief Half edges removed from the hull, reused first
+  public: std::vector<uint32_t> freeEdges;
+
+  /// \brief Faces that may have an outside set
+  public: std::vector<uint32_t> pending;
+
+  /// \brief Faces seen from the added point
+  public: std::vector<uint32_t> visible;
+
+  /// \brief Half edges of the faces seen from the added point
+  public: std::vector<uint32_t> visibleEdges;
+
+  /// \brief Horizon of the added point, as a loop of edges
+  public: std::vector<HorizonEdge> horizon;
+
+  /// \brief Faces created for the added point
+  public: std::vector<uint32_t> created;
+
+  /// \brief Points of the outside sets of the removed faces
+  public: std::vector<uint32_t> orphans;
+
+  /// \brief Stack of the search of the horizon
+  public: std::vector<Visit> stack;
+
+  /// \brief Distance below which a point is considered on a plane
+  public: double tolerance = 0;
+
+  /// \brief Points of the face being triangulated
+  public: std::vector<uint32_t> polygon;
+
+  /// \brief Coordinates of the polygon in its plane
+  public: std::vector<Vector2d> flat;
+
+  /// \brief Previous vertex of each vertex of the polygon left to
+  /// triangulate
+  public: std::vector<uint32_t> ringPrev;
+
+  /// \brief Next vertex of each vertex of the polygon left to triangulate
+  public: std::vector<uint32_t> ringNext;
+
+  /// \brief Whether each vertex of the polygon is not strictly convex
+  public: std::vector<char> reflex;
+
+  /// \brief Corners of the triangles, three per triangle
+  public: std::vector<unsigned int> indices;
+
+  /// \brief Vertices of the hull
+  public: std::vector<unsigned int> vertices;
+};
+
+//////////////////////////////////////////////////
+template<typename Points>
+bool ConvexHullPrivate::Build(const Points &_points,
+    const std::size_t _maxVertices)
+{
+  this->points.clear();
+  this->index.clear();
+  this->faces.clear();
+  this->edges.clear();
+  this->freeFaces.clear();
+  this->freeEdges.clear();
+  this->pending.clear();
+  this->indices.clear();
+  this->vertices.clear();
+
+  const std::size_t n = std::min(PointCount(_points),
+      static_cast<std::size_t>(kNone));
+  Vector3d extent;
+  for (std::size_t i = 0; i < n; ++i)
+  {
+    const Vector3d point = _points[i];
+    if (!point.IsFinite())
+      continue;
+    this->points.push_back(point);
+    this->index.push_back(static_cast<uint32_t>(i));
+    extent.Max(point.Abs());
+  }
+  this->next.assign(this->points.size(), kNone);
+
+  // Bound of the rounding errors of the distances, as in qhull
+  this->tolerance = 3 * std::numeric_limits<double>::epsilon() *
+    (extent.X() + extent.Y() + extent.Z());
+
+  if (this->points.size() < 4 || !this->Simplex())
+    return false;
+
+  std::size_t vertexCount = 4;
+  while (_maxVertices == 0 || vertexCount < _maxVertices)
+  {
+    uint32_t face;
+    const uint32_t point = this->NextPoint(_maxVertices != 0, face);
+    if (point == kNone)
+      break;
+    this->AddPoint(point, face);
+    ++vertexCount;
+  }
+
+  this->Output();
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool ConvexHullPrivate::Simplex()
+{
+  // Extreme points along each axis
+  uint32_t lowest[3] = {0, 0, 0};
+  uint32_t highest[3] = {0, 0, 0};
+  const uint32_t n = static_cast<uint32_t>(this->points.size());
+  for (uint32_t i = 1; i < n; ++i)
+  {
+    for (int a = 0; a < 3; ++a)
+    {
+      if (this->points[i][a] < this->points[lowest[a]][a])
+        lowest[a] = i;
+      if (this->points[i][a] > this->points[highest[a]][a])
+        highest[a] = i;
+    }
+  }
+
+  // The two extreme points that are the furthest apart
+  int axis = 0;
+  double spread = -1;
+  for (int a = 0; a < 3; ++a)
+  {
+    const double s = this->points[highest[a]][a] - this->points[lowest[a]][a];
+    if (s > spread)
+    {
+      spread = s;
+      axis = a;
+    }
+  }
+  if (spread <= this->tolerance)
+    return false;
+  const uint32_t v0 = lowest[axis];
+  uint32_t v1 = highest[axis];
+
+  // The point furthest from their line
+  const Vector3d &p0 = this->points[v0];
+  const Vector3d dir = (this->points[v1] - p0).Normalized();
+  uint32_t v2 = kNone;
+  double best = this->tolerance * this->tolerance;
+  for (uint32_t i = 0; i < n; ++i)
+  {
+    const double d = (this->points[i] - p0).Cross(dir).SquaredLength();
+    if (d > best)
+    {
+      best = d;
+      v2 = i;
+    }
+  }
+  if (v2 == kNone)
+    return false;
+
+  // The point furthest from their plane
+  Vector3d normal = (this->points[v1] - p0).Cross(this->points[v2] - p0);
+  normal /= normal.Length();
+  uint32_t v3 = kNone;
+  best = this->tolerance;
+  for (uint32_t i = 0; i < n; ++i)
+  {
+    const double d = std::abs(normal.Dot(this->points[i] - p0));
+    if (d > best)
+    {
+      best = d;
+      v3 = i;
+    }
+  }
+  if (v3 == kNone)
+    return false;
+
+  // The base faces away from the last point, and each side shares an
+  // edge with the base and two with the other sides
+  if (normal.Dot(this->points[v3] - p0) > 0)
+    std::swap(v1, v2);
+  const uint32_t corners[3] = {v0, v1, v2};
+  const uint32_t base = this->NewTriangle(v0, v1, v2);
+  uint32_t baseEdge = this->faces[base].edge;
+  uint32_t sides[3];
+  for (int k = 0; k < 3; ++k)
+  {
+    sides[k] = this->NewTriangle(corners[(k + 1) % 3], corners[k], v3);
+    this->Link(baseEdge, this->faces[sides[k]].edge);
+    baseEdge = this->edges[baseEdge].next;
+  }
+  for (int k = 0; k < 3; ++k)
+  {
+    const uint32_t edge = this->edges[this->faces[sides[k]].edge].next;
+    this->Link(edge, this->edges[this->faces[sides[(k + 2) % 3]].edge].prev);
+  }
+
+  this->pending = {base, sides[0], sides[1], sides[2]};
+  for (uint32_t i = 0; i < n; ++i)
+  {
+    if (i == v0 || i == v1 || i == v2 || i == v3)
+      continue;
+
+    uint32_t face = kNone;
+    double bestDist = this->tolerance;
+    for (const uint32_t f : this->pending)
+    {
+      const double d = this->Distance(f, this->points[i]);
+      if (d > bestDist)
+      {
+        bestDist = d;
+        face = f;
+      }
+    }
+    if (face != kNone)
+      this->AddOutside(i, face);
+  }
+  return true;
+}
+
+//////////////////////////////////////////////////
+uint32_t ConvexHullPrivate::NextPoint(const bool _furthest, uint32_t &_face)
+{
+  uint32_t result = kNone;
+  double best = this->tolerance;
+  _face = kNone;
+
+  if (_furthest)
+  {
+    for (uint32_t f = 0; f < this->faces.size(); ++f)
+    {
+      if (this->faces[f].mark == kDeleted)
+        continue;
+      for (uint32_t p = this->faces[f].outside; p != kNone; p = this->next[p])
+      {
+        const double d = this->Distance(f, this->points[p]);
+        if (d > best)
+        {
+          best = d;
+          result = p;
+          _face = f;
+        }
+      }
+    }
+    return result;
+  }
+
+  // Faces that were removed or reused since they were added are skipped
+  while (!this->pending.empty())
+  {
+    const uint32_t f = this->pending.back();
+    this->pending.pop_back();
+    if (this->faces[f].mark == kDeleted)
+      continue;
+
+    for (uint32_t p = this->faces[f].outside; p != kNone; p = this->next[p])
+    {
+      const double d = this->Distance(f, this->points[p]);
+      if (d > best)
+      {
+        best = d;
+        result = p;
+      }
+    }
+    if (result != kNone)
+    {
+      // The face is searched again after the point is added, if it is
+      // still in the hull
+      this->pending.push_back(f);
+      _face = f;
+      return result;
+    }
+
+    // A merge moved the face closer to its points
+    this->faces[f].outside = kNone;
+  }
+  return kNone;
+}
+
+//////////////////////////////////////////////////
+void ConvexHullPrivate::AddPoint(const uint32_t _point, const uint32_t _face)
+{
+  // Depth first search of the faces seen from the point, which gives the
+  // edges of the horizon in counter-clockwise order
+  const Vector3d &eye = this->points[_point];
+  this->visible.clear();
+  this->horizon.clear();
+  this->orphans.clear();
+  this->stack.clear();
+  this->RemoveVisible(_face, _point);
+  const uint32_t first = this->faces[_face].edge;
+  this->stack.push_back({first, first});
+  while (!this->stack.empty())
+  {
+    Visit &top = this->stack.back();
+    const uint32_t edge = top.edge;
+    top.edge = this->edges[edge].next;
+    if (top.edge == top.stop)
+      this->stack.pop_back();
+
+    const uint32_t twin = this->edges[edge].twin;
+    const uint32_t other = this->edges[twin].face;
+    if (this->faces[other].mark == kDeleted)
+      continue;
+
+    if (this->Distance(other, eye) > this->tolerance)
+    {
+      this->RemoveVisible(other, _point);
+      // Continue after the edge that was crossed
+      this->stack.push_back({this->edges[twin].next, twin});
+    }
+    else
+    {
+      this->horizon.push_back({this->edges[this->edges[edge].prev].vertex,
+          this->edges[edge].vertex, twin});
+    }
+  }
+
+  this->visibleEdges.clear();
+  for (const uint32_t f : this->visible)
+  {
+    const uint32_t start = this->faces[f].edge;
+    uint32_t edge = start;
+    do
+    {
+      this->visibleEdges.push_back(edge);
+      edge = this->edges[edge].next;
+    }
+    while (edge != start);
+  }
+
+  // Cone of triangles from the horizon to the point
+  this->created.clear();
+  for (const HorizonEdge &horizonEdge : this->horizon)
+  {
+    const uint32_t f = this->NewTriangle(horizonEdge.tail, horizonEdge.head,
+        _point);
+    this->Link(this->faces[f].edge, horizonEdge.twin);
+    this->created.push_back(f);
+  }
+  const std::size_t count = this->created.size();
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    const uint32_t edge = this->faces[this->created[i]].edge;
+    const uint32_t nextEdge = this->faces[this->created[(i + 1) % count]].edge;
+    this->Link(this->edges[edge].next, this->edges[nextEdge].prev);
+  }
+
+  this->freeFaces.insert(this->freeFaces.end(), this->visible.begin(),
+      this->visible.end());
+  this->freeEdges.insert(this->freeEdges.end(), this->visibleEdges.begin(),
+      this->visibleEdges.end());
+
+  // Merge the new faces that are not clearly convex with their neighbors,
+  // first as seen from the larger face, then from either face
+  for (const uint32_t f : this->created)
+  {
+    if (this->faces[f].mark == kAlive)
+    {
+      while (this->MergeAdjacent(f, MergeType::LARGER_FACE))
+      {
+      }
+    }
+  }
+  for (const uint32_t f : this->created)
+  {
+    if (this->faces[f].mark == kNonConvex)
+    {
+      this->faces[f].mark = kAlive;
+      while (this->MergeAdjacent(f, MergeType::EITHER_FACE))
+      {
+      }
+    }
+  }
+
+  // Points that are not in front of any new face are inside the hull
+  for (const uint32_t p : this->orphans)
+  {
+    uint32_t face = kNone;
+    double best = this->tolerance;
+    for (const uint32_t f : this->created)
+    {
+      if (this->faces[f].mark == kDeleted)
+        continue;
+      const double d = this->Distance(f, this->points[p]);
+      if (d > best)
+      {
+        best = d;
+        face = f;
+      }
+    }
+    if (face != kNone)
+      this->AddOutside(p, face);
+  }
+
+  for (const uint32_t f : this->created)
+  {
+    if (this->faces[f].mark != kDeleted && this->faces[f].outside != kNone)
+      this->pending.push_back(f);
+  }
+}
+
+//////////////////////////////////////////////////
+void ConvexHullPrivate::RemoveVisible(const uint32_t _face,
+    const uint32_t _eye)
+{
+  Face &face = this->faces[_face];
+  for (uint32_t p = face.outside; p != kNone; p = this->next[p])
+  {
+    if (p != _eye)
+      this->orphans.push_back(p);
+  }
+  face.outside = kNone;
+  face.mark = kDeleted;
+  this->visible.push_back(_face);
+}
+
+//////////////////////////////////////////////////
+bool ConvexHullPrivate::MergeAdjacent(const uint32_t _face,
+    const MergeType _type)
+{
+  bool convex = true;
+  const uint32_t start = this->faces[_face].edge;
+  uint32_t edge = start;
+  do
+  {
+    const uint32_t other = this->Opposite(edge);
+    bool merge = false;
+    if (_type == MergeType::EITHER_FACE)
+    {
+      merge = this->OppositeDistance(edge) > -this->tolerance ||
+        this->OppositeDistance(this->edges[edge].twin) > -this->tolerance;
+    }
+    else if (this->faces[_face].area > this->faces[other].area)
+    {
+      if (this->OppositeDistance(edge) > -this->tolerance)
+        merge = true;
+      else if (this->OppositeDistance(this->edges[edge].twin) >
+          -this->tolerance)
+        convex = false;
+    }
+    else
+    {
+      if (this->OppositeDistance(this->edges[edge].twin) > -this->tolerance)
+        merge = true;
+      else if (this->OppositeDistance(edge) > -this->tolerance)
+        convex = false;
+    }
+
+    if (merge)
+    {
+      this->MergeFace(_face, edge);
+      return true;
+    }
+    edge = this->edges[edge].next;
+  }
+  while (edge != start);
+
+  if (!convex)
+    this->faces[_face].mark = kNonConvex;
+  return false;
+}
+
+//////////////////////////////////////////////////
+void ConvexHullPrivate::MergeFace(const uint32_t _face, const uint32_t _edge)
+{
+  const uint32_t other = this->Opposite(_edge);
+  const uint32_t twin = this->edges[_edge].twin;
+
+  // Extend the shared part to all the consecutive edges between the faces
+  uint32_t prevEdge = this->edges[_edge].prev;
+  uint32_t nextEdge = this->edges[_edge].next;
+  uint32_t otherPrev = this->edges[twin].prev;
+  uint32_t otherNext = this->edges[twin].next;
+  while (this->Opposite(prevEdge) == other)
+  {
+    prevEdge = this->edges[prevEdge].prev;
+    otherNext = this->edges[otherNext].next;
+  }
+  while (this->Opposite(nextEdge) == other)
+  {
+    otherPrev = this->edges[otherPrev].prev;
+    nextEdge = this->edges[nextEdge].next;
+  }
+
+  for (uint32_t e = this->edges[prevEdge].next; e != nextEdge;
+       e = this->edges[e].next)
+  {
+    this->freeEdges.push_back(e);
+  }
+  for (uint32_t e = this->edges[otherPrev].next; e != otherNext;
+       e = this->edges[e].next)
+  {
+    this->freeEdges.push_back(e);
+  }
+  for (uint32_t e = otherNext; e != this->edges[otherPrev].next;
+       e = this->edges[e].next)
+  {
+    this->edges[e].face = _face;
+  }
+
+  this->faces[_face].edge = nextEdge;
+  this->Discard(other);
+
+  // Connecting two edges may remove the first one, so the ends of the
+  // shared part are connected in the order that keeps a single remaining
+  // edge of the other face until its last use
+  if (otherPrev == otherNext)
+  {
+    this->Connect(_face, prevEdge, otherNext);
+    this->Connect(_face, otherPrev, nextEdge);
+  }
+  else
+  {
+    this->Connect(_face, otherPrev, nextEdge);
+    this->Connect(_face, prevEdge, otherNext);
+  }
+
+  // Removing a triangle can leave two more consecutive edges along the
+  // same face
+  bool redundant = true;
+  while (redundant)
+  {
+    redundant = false;
+    const uint32_t start = this->faces[_face].edge;
+    uint32_t edge = start;
+    do
+    {
+      const uint32_t following = this->edges[edge].next;
+      if (this->Opposite(edge) == this->Opposite(following) &&
+          this->edges[this->edges[following].next].next != edge)
+      {
+        this->Connect(_face, edge, following);
+        redundant = true;
+        break;
+      }
+      edge = following;
+    }
+    while (edge != start);
+  }
+  this->UpdatePlane(_face);
+}
+
+//////////////////////////////////////////////////
+void ConvexHullPrivate::Connect(const uint32_t _face, const uint32_t _prev,
+    const uint32_t _edge)
+{
+  const uint32_t other = this->Opposite(_edge);
+  if (this->Opposite(_prev) != other)
+  {
+    this->edges[_prev].next = _edge;
+    this->edges[_edge].prev = _prev;
+    return;
+  }
+
+  // The vertex between the edges is redundant
+  if (this->faces[_face].edge == _prev)
+    this->faces[_face].edge = _edge;
+
+  const uint32_t twin = this->edges[_edge].twin;
+  uint32_t otherEdge;
+  if (this->edges[this->edges[this->edges[twin].next].next].next == twin)
+  {
+    // The neighbor is a triangle, whose third edge now faces _edge
+    otherEdge = this->edges[this->edges[twin].prev].twin;
+    this->freeEdges.push_back(this->edges[twin].prev);
+    this->freeEdges.push_back(this->edges[twin].next);
+    this->freeEdges.push_back(twin);
+    this->Discard(other);
+  }
+  else
+  {
+    otherEdge = this->edges[twin].next;
+    if (this->faces[other].edge == twin)
+      this->faces[other].edge = otherEdge;
+    this->edges[otherEdge].prev = this->edges[twin].prev;
+    this->edges[this->edges[otherEdge].prev].next = otherEdge;
+    this->freeEdges.push_back(twin);
+  }
+
+  this->freeEdges.push_back(_prev);
+  this->edges[_edge].prev = this->edges[_prev].prev;
+  this->edges[this->edges[_edge].prev].next = _edge;
+  this->Link(_edge, otherEdge);
+  if (this->faces[other].mark != kDeleted)
+    this->UpdatePlane(other);
+}
+
+//////////////////////////////////////////////////
+void ConvexHullPrivate::Discard(const uint32_t _face)
+{
+  Face &face = this->faces[_face];
+  for (uint32_t p = face.outside; p != kNone; p = this->next[p])
+    this->orphans.push_back(p);
+  face.outside = kNone;
+  face.mark = kDeleted;
+  this->freeFaces.push_back(_face);
+}
+
+//////////////////////////////////////////////////
+uint32_t ConvexHullPrivate::NewTriangle(const uint32_t _a, const uint32_t _b,
+    const uint32_t _c)
+{
+  uint32_t f;
+  if (this->freeFaces.empty())
+  {
+    f = static_cast<uint32_t>(this->faces.size());
+    this->faces.push_back(Face());
+  }
+  else
+  {
+    f = this->freeFaces.back();
+    this->freeFaces.pop_back();
+  }
+
+  const uint32_t ab = this->NewEdge(_b, f);
+  const uint32_t bc = this->NewEdge(_c, f);
+  const uint32_t ca = this->NewEdge(_a, f);
+  this->edges[ab].next = bc;
+  this->edges[bc].next = ca;
+  this->edges[ca].next = ab;
+  this->edges[ab].prev = ca;
+  this->edges[bc].prev = ab;
+  this->edges[ca].prev = bc;
+
+  Face &face = this->faces[f];
+  face.edge = ab;
+  face.outside = kNone;
+  face.mark = kAlive;
+  this->UpdatePlane(f);
+  return f;
+}
+
+//////////////////////////////////////////////////
+uint32_t ConvexHullPrivate::NewEdge(const uint32_t _vertex,
+    const uint32_t _face)
+{
+  uint32_t e;
+  if (this->freeEdges.empty())
+  {
+    e = static_cast<uint32_t>(this->edges.size());
+    this->edges.push_back(HalfEdge());
+  }
+  else
+  {
+    e = this->freeEdges.back();
+    this->freeEdges.pop_back();
+  }
+  this->edges[e].vertex = _vertex;
+  this->edges[e].face = _face;
+  this->edges[e].twin = kNone;
+  return e;
+}
+
+//////////////////////////////////////////////////
+void ConvexHullPrivate::UpdatePlane(const uint32_t _face)
+{
+  Face &face = this->faces[_face];
+  const uint32_t e0 = face.edge;
+  const Vector3d &p0 = this->points[this->edges[e0].vertex];
+  uint32_t e = this->edges[e0].next;
+  Vector3d d2 = this->points[this->edges[e].vertex] - p0;
+  Vector3d normal;
+  Vector3d sum = p0 + this->points[this->edges[e].vertex];
+  int count = 2;
+  for (e = this->edges[e].next; e != e0; e = this->edges[e].next)
+  {
+    const Vector3d &p = this->points[this->edges[e].vertex];
+    const Vector3d d1 = d2;
+    d2 = p - p0;
+    normal += d1.Cross(d2);
+    sum += p;
+    ++count;
+  }
+
+  face.area = normal.Length();
+  face.normal = face.area > 0 ? normal / face.area : normal;
+  face.centroid = sum / count;
+  face.offset = face.normal.Dot(face.centroid);
+}
+
+//////////////////////////////////////////////////
+void ConvexHullPrivate::Output()
+{
+  for (const Face &face : this->faces)
+  {
+    if (face.mark != kDeleted)
+      this->Triangulate(face);
+  }
+
+  this->vertices = this->indices;
+  std::sort(this->vertices.begin(), this->vertices.end());
+  this->vertices.erase(
+      std::unique(this->vertices.begin(), this->vertices.end()),
+      this->vertices.end());
+}
+
+//////////////////////////////////////////////////
+void ConvexHullPrivate::Triangulate(const Face &_face)
+{
+  this->polygon.clear();
+  uint32_t edge = _face.edge;
+  do
+  {
+    this->polygon.push_back(this->edges[edge].vertex);
+    edge = this->edges[edge].next;
+  }
+  while (edge != _face.edge);
+
+  const uint32_t k = static_cast<uint32_t>(this->polygon.size());
+  auto emit = [&](const uint32_t _a, const uint32_t _b, const uint32_t _c)
+  {
+    this->indices.push_back(this->index[this->polygon[_a]]);
+    this->indices.push_back(this->index[this->polygon[_b]]);
+    this->indices.push_back(this->index[this->polygon[_c]]);
+  };
+  if (k == 3)
+  {
+    emit(0, 1, 2);
+    return;
+  }
+
+  // Merged faces are only convex within the tolerance, so the polygon is
+  // cut into ears in its plane, seen from outside, instead of a fan
+  int axis = 0;
+  for (int a = 1; a < 3; ++a)
+  {
+    if (std::abs(_face.normal[a]) > std::abs(_face.normal[axis]))
+      axis = a;
+  }
+  int u = (axis + 1) % 3;
+  int v = (axis + 2) % 3;
+  if (_face.normal[axis] < 0)
+    std::swap(u, v);
+
+  this->flat.resize(k);
+  this->ringPrev.resize(k);
+  this->ringNext.resize(k);
+  this->reflex.resize(k);
+  for (uint32_t i = 0; i < k; ++i)
+  {
+    const Vector3d &p = this->points[this->polygon[i]];
+    this->flat[i].Set(p[u], p[v]);
+    this->ringPrev[i] = (i + k - 1) % k;
+    this->ringNext[i] = (i + 1) % k;
+  }
+
+  // Vertices that are not strictly convex can be inside an ear
+  uint32_t reflexCount = 0;
+  auto classify = [&](const uint32_t _i)
+  {
+    const bool r = Turn(this->flat[this->ringPrev[_i]], this->flat[_i],
+        this->flat[this->ringNext[_i]]) <= 0;
+    if (r && !this->reflex[_i])
+      ++reflexCount;
+    else if (!r && this->reflex[_i])
+      --reflexCount;
+    this->reflex[_i] = r;
+  };
+  for (uint32_t i = 0; i < k; ++i)
+  {
+    this->reflex[i] = false;
+    classify(i);
+  }
+
+  auto isEar = [&](const uint32_t _p, const uint32_t _i, const uint32_t _n)
+  {
+    if (this->reflex[_i])
+      return false;
+    if (reflexCount == 0)
+      return true;
+    const Vector2d &a = this->flat[_p];
+    const Vector2d &b = this->flat[_i];
+    const Vector2d &c = this->flat[_n];
+    for (uint32_t j = this->ringNext[_n]; j != _p; j = this->ringNext[j])
+    {
+      const Vector2d &q = this->flat[j];
+      if (this->reflex[j] && Turn(a, b, q) >= 0 && Turn(b, c, q) >= 0 &&
+          Turn(c, a, q) >= 0)
+      {
+        return false;
+      }
+    }
+    return true;
+  };
+
+  uint32_t remaining = k;
+  uint32_t i = 0;
+  uint32_t failures = 0;
+  while (remaining > 3 && failures < remaining)
+  {
+    const uint32_t p = this->ringPrev[i];
+    const uint32_t n = this->ringNext[i];
+    if (!isEar(p, i, n))
+    {
+      i = n;
+      ++failures;
+      continue;
+    }
+
+    emit(p, i, n);
+    this->ringNext[p] = n;
+    this->ringPrev[n] = p;
+    --remaining;
+    classify(p);
+    classify(n);
+    i = n;
+    failures = 0;
+  }
+
+  // A fan of what is left if no ear was found, due to rounding errors
+  for (uint32_t j = this->ringNext[i]; this->ringNext[j] != i;
+       j = this->ringNext[j])
+  {
+    emit(i, j, this->ringNext[j]);
+  }
+}
+
+namespace
+{
+  //////////////////////////////////////////////////
+  /// \brief Run a function for each set of points in several threads.
+  /// Each thread has its own builder.
+  /// \param[in] _count Number of sets.
+  /// \param[in] _threadCount Number of threads, 0 for the number of
+  /// hardware threads.
+  /// \param[in] _func Function called with a builder and the index of a
+  /// set, which returns true if the hull is not empty.
+  /// \return Number of sets for which _func returned true.
+  template<typename Func>
+  std::size_t ForEachSet(const std::size_t _count,
+      const unsigned int _threadCount, Func _func)
+  {
+    unsigned int threadCount = _threadCount;
+    if (threadCount == 0)
+      threadCount = std::max(std::thread::hardware_concurrency(), 1u);
+    threadCount = static_cast<unsigned int>(
+        std::min<std::size_t>(threadCount, std::max<std::size_t>(_count, 1)));
+
+    std::atomic<std::size_t> nextSet(0);
+    std::atomic<std::size_t> built(0);
+    auto work = [&]()
+    {
+      ConvexHullPrivate builder;
+      for (std::size_t i = nextSet++; i < _count; i = nextSet++)
+      {
+        if (_func(builder, i))
+          ++built;
+      }
+    };
+
+    std::vector<std::thread> threads;
+    for (unsigned int t = 1; t < threadCount; ++t)
+      threads.push_back(std::thread(work));
+    work();
+    for (std::thread &thread : threads)
+      thread.join();
+    return built;
+  }
+}  // namespace
+
+//////////////////////////////////////////////////
+ConvexHull::ConvexHull()
+: dataPtr(new ConvexHullPrivate)
+{
+}
+
+//////////////////////////////////////////////////
+ConvexHull::ConvexHull(const ConvexHull &_hull)
+: dataPtr(new ConvexHullPrivate(*_hull.dataPtr))
+{
+}
+
+//////////////////////////////////////////////////
+ConvexHull::~ConvexHull()
+{
+}
+
+//////////////////////////////////////////////////
+ConvexHull &ConvexHull::operator=(const ConvexHull &_hull)
+{
+  *this->dataPtr = *_hull.dataPtr;
+  return *this;
+}
+
+//////////////////////////////////////////////////
+bool ConvexHull::Build(const std::vector<Vector3d> &_points,
+    const std::size_t _maxVertices)
+{
+  return this->dataPtr->Build(_points, _maxVertices);
+}
+
+//////////////////////////////////////////////////
+bool ConvexHull::Build(const Vector3View<double> &_points,
+    const std::size_t _maxVertices)
+{
+  return this->dataPtr->Build(_points, _maxVertices);
+}
+
+//////////////////////////////////////////////////
+std::size_t ConvexHull::BuildMany(
+    const std::vector<std::vector<Vector3d>> &_pointSets,
+    std::vector<ConvexHull> &_hulls, const std::size_t _maxVertices,
+    const unsigned int _threadCount)
+{
+  _hulls.resize(_pointSets.size());
+  return ForEachSet(_pointSets.size(), _threadCount,
+      [&](ConvexHullPrivate &_builder, const std::size_t _i)
+      {
+        const bool result = _builder.Build(_pointSets[_i], _maxVertices);
+        _hulls[_i].dataPtr->indices = _builder.indices;
+        _hulls[_i].dataPtr->vertices = _builder.vertices;
+        return result;
+      });
+}
+
+//////////////////////////////////////////////////
+std::size_t ConvexHull::BuildMany(
+    const std::vector<Vector3View<double>> &_pointSets,
+    std::vector<ConvexHull> &_hulls, const std::size_t _maxVertices,
+    const unsigned int _threadCount)
+{
+  _hulls.resize(_pointSets.size());
+  return ForEachSet(_pointSets.size(), _threadCount,
+      [&](ConvexHullPrivate &_builder, const std::size_t _i)
+      {
+        const bool result = _builder.Build(_pointSets[_i], _maxVertices);
+        _hulls[_i].dataPtr->indices = _builder.indices;
+        _hulls[_i].dataPtr->vertices = _builder.vertices;
+        return result;
+      });
+}
+
+//////////////////////////////////////////////////
+std::size_t ConvexHull::TriangleCount() const
+{
+  return this->dataPtr->indices.size() / 3;
+}
+
+//////////////////////////////////////////////////
+const std::vector<unsigned int> &ConvexHull::Indices() const
+{
+  return this->dataPtr->indices;
+}
+
+//////////////////////////////////////////////////
+const std::vector<unsigned int> &ConvexHull::Vertices() const
+{
+  return this->dataPtr->vertices;
+}
@@ -0,0 +1,359 @@
+/*
+ * Copyright (C) 2018 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <limits>
+#include <map>
+#include <utility>
+#include <vector>
+
+#include "ignition/math/ConvexHull.hh"
+#include "ignition/math/Rand.hh"
+
+using namespace ignition;
+
+/////////////////////////////////////////////////
+/// \brief Check that a hull is a closed surface with outward triangles
+/// that contains all the points.
+/// \param[in] _points The points given to the hull.
+/// \param[in] _hull The hull.
+/// \param[in] _tolerance Largest distance of a point outside a face.
+void CheckHull(const std::vector<math::Vector3d> &_points,
+    const math::ConvexHull &_hull, const double _tolerance)
+{
+  const std::vector<unsigned int> &indices = _hull.Indices();
+  ASSERT_EQ(indices.size(), _hull.TriangleCount() * 3);
+  ASSERT_GE(_hull.TriangleCount(), 4u);
+
+  // Each edge is used once in each direction
+  std::map<std::pair<unsigned int, unsigned int>, int> edges;
+  for (std::size_t t = 0; t < indices.size(); t += 3)
+  {
+    for (std::size_t k = 0; k < 3; ++k)
+    {
+      const unsigned int a = indices[t + k];
+      const unsigned int b = indices[t + (k + 1) % 3];
+      ++edges[std::make_pair(a, b)];
+    }
+  }
+  for (const auto &edge : edges)
+  {
+    EXPECT_EQ(1, edge.second);
+    EXPECT_EQ(1u, edges.count(
+          std::make_pair(edge.first.second, edge.first.first)));
+  }
+
+  // Euler characteristic of a sphere
+  EXPECT_EQ(_hull.Vertices().size() + _hull.TriangleCount(),
+      edges.size() / 2 + 2);
+
+  for (std::size_t t = 0; t < indices.size(); t += 3)
+  {
+    const math::Vector3d &a = _points[indices[t]];
+    const math::Vector3d normal = (_points[indices[t + 1]] - a).Cross(
+        _points[indices[t + 2]] - a).Normalized();
+    for (const math::Vector3d &p : _points)
+    {
+      if (p.IsFinite())
+      {
+        EXPECT_LE(normal.Dot(p - a), _tolerance);
+      }
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+/// \brief Create random points in a sphere.
+/// \param[in] _count Number of points.
+/// \return The points.
+std::vector<math::Vector3d> Ball(const std::size_t _count)
+{
+  std::vector<math::Vector3d> points;
+  while (points.size() < _count)
+  {
+    const math::Vector3d p(math::Rand::DblUniform(-1, 1),
+        math::Rand::DblUniform(-1, 1), math::Rand::DblUniform(-1, 1));
+    if (p.SquaredLength() <= 1)
+      points.push_back(p);
+  }
+  return points;
+}
+
+/////////////////////////////////////////////////
+TEST(ConvexHullTest, Empty)
+{
+  math::ConvexHull hull;
+  EXPECT_EQ(0u, hull.TriangleCount());
+  EXPECT_TRUE(hull.Indices().empty());
+  EXPECT_TRUE(hull.Vertices().empty());
+
+  std::vector<math::Vector3d> points;
+  EXPECT_FALSE(hull.Build(points));
+
+  // Too few points
+  points = {math::Vector3d(0, 0, 0), math::Vector3d(1, 0, 0),
+    math::Vector3d(0, 1, 0)};
+  EXPECT_FALSE(hull.Build(points));
+  EXPECT_EQ(0u, hull.TriangleCount());
+
+  // Coincident, collinear and coplanar points
+  points.assign(10, math::Vector3d(1, 2, 3));
+  EXPECT_FALSE(hull.Build(points));
+  points.clear();
+  for (int i = 0; i < 10; ++i)
+    points.push_back(math::Vector3d(i, 2 * i, -i));
+  EXPECT_FALSE(hull.Build(points));
+  points.clear();
+  for (int i = 0; i < 10; ++i)
+  {
+    for (int j = 0; j < 10; ++j)
+      points.push_back(math::Vector3d(i, j, i + j));
+  }
+  EXPECT_FALSE(hull.Build(points));
+  EXPECT_EQ(0u, hull.TriangleCount());
+  EXPECT_TRUE(hull.Vertices().empty());
+}
+
+/////////////////////////////////////////////////
+TEST(ConvexHullTest, Tetrahedron)
+{
+  const double nan = std::numeric_limits<double>::quiet_NaN();
+  const std::vector<math::Vector3d> points = {
+    math::Vector3d(0, 0, 0), math::Vector3d(nan, 0, 0),
+    math::Vector3d(1, 0, 0), math::Vector3d(0, 1, 0),
+    math::Vector3d(0.1, 0.1, 0.1), math::Vector3d(0, 0, 1)};
+
+  math::ConvexHull hull;
+  EXPECT_TRUE(hull.Build(points));
+  EXPECT_EQ(4u, hull.TriangleCount());
+  EXPECT_EQ(std::vector<unsigned int>({0, 2, 3, 5}), hull.Vertices());
+  CheckHull(points, hull, 1e-12);
+
+  math::ConvexHull copy(hull);
+  EXPECT_EQ(hull.Indices(), copy.Indices());
+  math::ConvexHull assigned;
+  assigned = hull;
+  EXPECT_EQ(hull.Vertices(), assigned.Vertices());
+
+  EXPECT_FALSE(hull.Build(std::vector<math::Vector3d>()));
+  EXPECT_EQ(0u, hull.TriangleCount());
+  EXPECT_EQ(4u, copy.TriangleCount());
+}
+
+/////////////////////////////////////////////////
+TEST(ConvexHullTest, Box)
+{
+  // Grid of points on and inside a box. Only the corners are vertices,
+  // the points on the faces and edges are discarded.
+  std::vector<math::Vector3d> points;
+  for (int i = 0; i <= 10; ++i)
+  {
+    for (int j = 0; j <= 10; ++j)
+    {
+      for (int k = 0; k <= 10; ++k)
+        points.push_back(math::Vector3d(i * 0.3 - 1, j * 0.2 + 5, k * 0.1));
+    }
+  }
+
+  math::ConvexHull hull;
+  EXPECT_TRUE(hull.Build(points));
+  EXPECT_EQ(8u, hull.Vertices().size());
+  EXPECT_EQ(12u, hull.TriangleCount());
+  CheckHull(points, hull, 1e-12);
+  for (const unsigned int v : hull.Vertices())
+  {
+    const math::Vector3d &p = points[v];
+    EXPECT_TRUE(math::equal(p.X(), -1.0) || math::equal(p.X(), 2.0));
+    EXPECT_TRUE(math::equal(p.Y(), 5.0) || math::equal(p.Y(), 7.0));
+    EXPECT_TRUE(math::equal(p.Z(), 0.0) || math::equal(p.Z(), 1.0));
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(ConvexHullTest, Sphere)
+{
+  // All the points are vertices
+  math::Rand::Seed(1);
+  std::vector<math::Vector3d> points = Ball(2000);
+  for (math::Vector3d &p : points)
+    p = p.Normalized() * 100 + math::Vector3d(1000, -500, 20);
+
+  math::ConvexHull hull;
+  EXPECT_TRUE(hull.Build(points));
+  EXPECT_EQ(points.size(), hull.Vertices().size());
+  EXPECT_EQ(2 * points.size() - 4, hull.TriangleCount());
+  CheckHull(points, hull, 1e-9);
+}
+
+/////////////////////////////////////////////////
+TEST(ConvexHullTest, Random)
+{
+  math::Rand::Seed(2);
+  math::ConvexHull hull;
+  for (int trial = 0; trial < 40; ++trial)
+  {
+    std::vector<math::Vector3d> points = Ball(50 + trial * 50);
+
+    // Squash some sets, round others to create coplanar points, and move
+    // others to the faces of a box, with noise above the tolerance
+    for (std::size_t i = 0; i < points.size(); ++i)
+    {
+      math::Vector3d &p = points[i];
+      if (trial % 4 == 1)
+      {
+        p.Z() *= 1e-3;
+      }
+      else if (trial % 4 == 2)
+      {
+        p = (p * 4).Round();
+      }
+      else if (trial % 4 == 3)
+      {
+        p[i % 3] = p[i % 3] < 0 ? -1 : 1;
+        p += math::Vector3d(1, -1, 1) * math::Rand::DblUniform(-1e-13, 1e-13);
+      }
+    }
+
+    EXPECT_TRUE(hull.Build(points));
+    CheckHull(points, hull, 1e-9);
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(ConvexHullTest, BoxSurface)
+{
+  // Points exactly on the faces of a box, so that merging a face with a
+  // neighbor often leaves other faces to merge with it as well
+  math::Rand::Seed(6);
+  math::ConvexHull hull;
+  for (int trial = 0; trial < 200; ++trial)
+  {
+    std::vector<math::Vector3d> points = Ball(20 + (trial % 15) * 20);
+    for (std::size_t i = 0; i < points.size(); ++i)
+      points[i][i % 3] = points[i][i % 3] < 0 ? -1 : 1;
+
+    EXPECT_TRUE(hull.Build(points));
+    CheckHull(points, hull, 1e-9);
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(ConvexHullTest, MaxVertices)
+{
+  math::Rand::Seed(3);
+  const std::vector<math::Vector3d> points = Ball(5000);
+
+  math::ConvexHull full;
+  EXPECT_TRUE(full.Build(points));
+
+  math::ConvexHull hull;
+  for (std::size_t limit : {1u, 4u, 5u, 16u, 64u})
+  {
+    EXPECT_TRUE(hull.Build(points, limit));
+    EXPECT_GE(std::max<std::size_t>(limit, 4), hull.Vertices().size());
+    EXPECT_EQ(2 * hull.Vertices().size() - 4, hull.TriangleCount());
+
+    // The simplified hull is inside the exact one, its vertices are
+    // vertices of the exact hull
+    for (const unsigned int v : hull.Vertices())
+    {
+      EXPECT_TRUE(std::binary_search(full.Vertices().begin(),
+            full.Vertices().end(), v));
+    }
+  }
+
+  // A limit above the number of vertices gives the exact hull
+  EXPECT_TRUE(hull.Build(points, 100000));
+  EXPECT_EQ(full.Vertices(), hull.Vertices());
+  CheckHull(points, hull, 1e-9);
+}
+
+/////////////////////////////////////////////////
+TEST(ConvexHullTest, View)
+{
+  math::Rand::Seed(4);
+  const std::vector<math::Vector3d> points = Ball(500);
+
+  // Points with an additional value
+  std::vector<double> buffer;
+  for (const math::Vector3d &p : points)
+  {
+    buffer.push_back(p.X());
+    buffer.push_back(p.Y());
+    buffer.push_back(p.Z());
+    buffer.push_back(-1);
+  }
+  const math::Vector3Viewd view(buffer.data(), points.size(), 4);
+
+  math::ConvexHull fromVector, fromView;
+  EXPECT_TRUE(fromVector.Build(points));
+  EXPECT_TRUE(fromView.Build(view));
+  EXPECT_EQ(fromVector.Indices(), fromView.Indices());
+  EXPECT_EQ(fromVector.Vertices(), fromView.Vertices());
+}
+
+/////////////////////////////////////////////////
+TEST(ConvexHullTest, BuildMany)
+{
+  math::Rand::Seed(5);
+  std::vector<std::vector<math::Vector3d>> sets;
+  for (int i = 0; i < 50; ++i)
+    sets.push_back(Ball(static_cast<std::size_t>(i * 20)));
+  std::vector<std::vector<double>> buffers(sets.size());
+  std::vector<math::Vector3Viewd> views;
+  for (std::size_t i = 0; i < sets.size(); ++i)
+  {
+    for (const math::Vector3d &p : sets[i])
+    {
+      buffers[i].push_back(p.X());
+      buffers[i].push_back(p.Y());
+      buffers[i].push_back(p.Z());
+    }
+    views.push_back(math::Vector3Viewd(buffers[i].data(), sets[i].size()));
+  }
+
+  // The first set is empty
+  std::vector<math::ConvexHull> hulls;
+  for (unsigned int threads : {0u, 1u, 3u})
+  {
+    EXPECT_EQ(sets.size() - 1,
+        math::ConvexHull::BuildMany(sets, hulls, 0, threads));
+    ASSERT_EQ(sets.size(), hulls.size());
+    EXPECT_EQ(0u, hulls[0].TriangleCount());
+    for (std::size_t i = 0; i < sets.size(); ++i)
+    {
+      math::ConvexHull hull;
+      EXPECT_EQ(i > 0, hull.Build(sets[i]));
+      EXPECT_EQ(hull.Indices(), hulls[i].Indices());
+    }
+
+    EXPECT_EQ(sets.size() - 1,
+        math::ConvexHull::BuildMany(views, hulls, 12, threads));
+    for (std::size_t i = 1; i < sets.size(); ++i)
+    {
+      math::ConvexHull hull;
+      EXPECT_TRUE(hull.Build(sets[i], 12));
+      EXPECT_EQ(hull.Indices(), hulls[i].Indices());
+    }
+  }
+
+  EXPECT_EQ(0u, math::ConvexHull::BuildMany(
+        std::vector<std::vector<math::Vector3d>>(), hulls));
+  EXPECT_TRUE(hulls.empty());
+}
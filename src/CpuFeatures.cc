@@ -0,0 +1,130 @@
+/*
+ * Copyright (C) 2018 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#define IGNITION_MATH_CPUID_MSVC 1
+#elif defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <cpuid.h>
+#define IGNITION_MATH_CPUID_GNU 1
+#endif
+
+#include <cstdint>
+
+#include "CpuFeatures.hh"
+
+using namespace ignition;
+using namespace math;
+
+namespace
+{
+  /// \brief Values of the eax, ebx, ecx and edx registers
+  struct CpuidRegisters
+  {
+    unsigned int eax = 0;
+    unsigned int ebx = 0;
+    unsigned int ecx = 0;
+    unsigned int edx = 0;
+  };
+
+  //////////////////////////////////////////////////
+  /// \brief Execute the cpuid instruction.
+  /// \param[in] _leaf Value of eax.
+  /// \param[in] _subleaf Value of ecx.
+  /// \return The registers, all zero if the leaf is not supported.
+  CpuidRegisters Cpuid(const unsigned int _leaf, const unsigned int _subleaf)
+  {
+    CpuidRegisters r;
+#if defined(IGNITION_MATH_CPUID_GNU)
+    if (__get_cpuid_max(_leaf & 0x80000000u, nullptr) >= _leaf)
+      __cpuid_count(_leaf, _subleaf, r.eax, r.ebx, r.ecx, r.edx);
+#elif defined(IGNITION_MATH_CPUID_MSVC)
+    int regs[4];
+    __cpuid(regs, static_cast<int>(_leaf & 0x80000000u));
+    if (static_cast<unsigned int>(regs[0]) >= _leaf)
+    {
+      __cpuidex(regs, static_cast<int>(_leaf), static_cast<int>(_subleaf));
+      r.eax = static_cast<unsigned int>(regs[0]);
+      r.ebx = static_cast<unsigned int>(regs[1]);
+      r.ecx = static_cast<unsigned int>(regs[2]);
+      r.edx = static_cast<unsigned int>(regs[3]);
+    }
+#else
+    (void)_leaf;
+    (void)_subleaf;
+#endif
+    return r;
+  }
+
+  //////////////////////////////////////////////////
+  /// \brief Read the XCR0 register, which tells which register states
+  /// are saved by the operating system on context switches. Must only be
+  /// called if the OSXSAVE cpuid bit is set.
+  /// \return Value of XCR0.
+  uint64_t Xcr0()
+  {
+#if defined(IGNITION_MATH_CPUID_GNU)
+    unsigned int eax, edx;
+    __asm__ __volatile__("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+    return (static_cast<uint64_t>(edx) << 32) | eax;
+#elif defined(IGNITION_MATH_CPUID_MSVC)
+    return _xgetbv(0);
+#else
+    return 0;
+#endif
+  }
+
+  //////////////////////////////////////////////////
+  SimdLevel DetectLevel()
+  {
+    const CpuidRegisters leaf1 = Cpuid(1, 0);
+    if ((leaf1.edx & (1u << 26)) == 0)
+      return SimdLevel::SCALAR;
+
+    const bool sse41 = (leaf1.ecx & (1u << 19)) != 0;
+    const bool sse42 = (leaf1.ecx & (1u << 20)) != 0;
+    if (!sse41 || !sse42)
+      return SimdLevel::SSE2;
+
+    const bool fma = (leaf1.ecx & (1u << 12)) != 0;
+    const bool osxsave = (leaf1.ecx & (1u << 27)) != 0;
+    const bool avx = (leaf1.ecx & (1u << 28)) != 0;
+    if (!fma || !osxsave || !avx)
+      return SimdLevel::SSE4_2;
+
+    // The operating system must save the SSE and AVX registers
+    const uint64_t xcr0 = Xcr0();
+    if ((xcr0 & 0x6) != 0x6)
+      return SimdLevel::SSE4_2;
+
+    const CpuidRegisters leaf7 = Cpuid(7, 0);
+    if ((leaf7.ebx & (1u << 5)) == 0)
+      return SimdLevel::SSE4_2;
+
+    // AVX-512F, and the opmask and upper ZMM register states
+    if ((leaf7.ebx & (1u << 16)) == 0 || (xcr0 & 0xE6) != 0xE6)
+      return SimdLevel::AVX2;
+
+    return SimdLevel::AVX512;
+  }
+}  // namespace
+
+//////////////////////////////////////////////////
+SimdLevel simd::CpuSimdLevel()
+{
+  static const SimdLevel level = DetectLevel();
+  return level;
+}
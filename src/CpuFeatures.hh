@@ -0,0 +1,42 @@
+/*
+ * Copyright (C) 2018 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef IGNITION_MATH_CPUFEATURES_HH_
+#define IGNITION_MATH_CPUFEATURES_HH_
+
+#include <ignition/math/config.hh>
+#include <ignition/math/SimdDispatch.hh>
+
+namespace ignition
+{
+  namespace math
+  {
+    inline namespace IGNITION_MATH_VERSION_NAMESPACE
+    {
+    namespace simd
+    {
+    /// \internal
+    /// \brief Get the highest instruction set level supported by the CPU
+    /// and the operating system. The result is computed once with the
+    /// cpuid instruction, and is always SimdLevel::SCALAR on other
+    /// architectures than x86.
+    /// \return The highest level that can be used.
+    SimdLevel CpuSimdLevel();
+    }
+    }
+  }
+}
+#endif
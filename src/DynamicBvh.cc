@@ -0,0 +1,895 @@
+/*
+ * Copyright (C) 2018 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+
+#include "ignition/math/DynamicBvh.hh"
+#include "BvhBuilder.hh"
+
+using namespace ignition;
+using namespace math;
+using namespace detail;
+
+namespace
+{
+  /// \brief Marks the absence of a node or a box
+  const uint32_t kNone = std::numeric_limits<uint32_t>::max();
+
+  /// \brief A node of the tree
+  struct Node
+  {
+    /// \brief Fat box of a leaf, bounds of the fat boxes below an inner
+    /// node
+    BvhBounds bounds;
+
+    /// \brief Parent, kNone for the root. Next free node when the node
+    /// is in the free list.
+    uint32_t parent;
+
+    /// \brief Children of an inner node, kNone for a leaf
+    uint32_t children[2];
+
+    /// \brief Box of a leaf, kNone for an inner node
+    uint32_t object;
+
+    /// \brief Number of levels below the node, 0 for a leaf
+    int height;
+  };
+
+  /// \brief A box stored in the tree
+  struct Object
+  {
+    /// \brief Bounds of the box
+    BvhBounds box;
+
+    /// \brief Leaf of the box, kNone if the box is empty or unused
+    uint32_t leaf;
+
+    /// \brief Next free box when the box is unused
+    uint32_t nextFree;
+
+    /// \brief Whether the id is in use
+    bool used;
+
+    /// \brief Whether the fat box changed since the last UpdatePairs()
+    bool moved;
+  };
+
+  /// \brief A pair of ids as returned by UpdatePairs()
+  typedef std::pair<std::size_t, std::size_t> IdPair;
+
+  //////////////////////////////////////////////////
+  /// \brief Get the bounds of a box.
+  /// \param[in] _box The box.
+  /// \return The bounds.
+  BvhBounds ToBounds(const AxisAlignedBox &_box)
+  {
+    BvhBounds b;
+    for (int a = 0; a < 3; ++a)
+    {
+      b.min[a] = _box.Min()[a];
+      b.max[a] = _box.Max()[a];
+    }
+    return b;
+  }
+
+  //////////////////////////////////////////////////
+  /// \brief Get a box from bounds.
+  /// \param[in] _b The bounds.
+  /// \return The box.
+  AxisAlignedBox ToBox(const BvhBounds &_b)
+  {
+    return AxisAlignedBox(Vector3d(_b.min[0], _b.min[1], _b.min[2]),
+                          Vector3d(_b.max[0], _b.max[1], _b.max[2]));
+  }
+
+  //////////////////////////////////////////////////
+  /// \brief Check if bounds are empty.
+  /// \param[in] _b The bounds.
+  /// \return True if the minimum is larger than the maximum along an axis.
+  bool IsEmpty(const BvhBounds &_b)
+  {
+    return _b.min[0] > _b.max[0] || _b.min[1] > _b.max[1] ||
+           _b.min[2] > _b.max[2];
+  }
+
+  //////////////////////////////////////////////////
+  /// \brief Check if bounds contain others.
+  /// \param[in] _outer The containing bounds.
+  /// \param[in] _inner The contained bounds.
+  /// \return True if _inner lies inside _outer.
+  bool Encloses(const BvhBounds &_outer, const BvhBounds &_inner)
+  {
+    return _inner.min[0] >= _outer.min[0] && _inner.max[0] <= _outer.max[0] &&
+           _inner.min[1] >= _outer.min[1] && _inner.max[1] <= _outer.max[1] &&
+           _inner.min[2] >= _outer.min[2] && _inner.max[2] <= _outer.max[2];
+  }
+
+  //////////////////////////////////////////////////
+  /// \brief Get the union of two bounds.
+  /// \param[in] _a First bounds.
+  /// \param[in] _b Second bounds.
+  /// \return Bounds that contain _a and _b.
+  BvhBounds Union(const BvhBounds &_a, const BvhBounds &_b)
+  {
+    BvhBounds u = _a;
+    u.Grow(_b);
+    return u;
+  }
+
+  //////////////////////////////////////////////////
+  /// \brief Enlarge bounds.
+  /// \param[in] _b The bounds.
+  /// \param[in] _margin Distance added on each side.
+  /// \return The enlarged bounds.
+  BvhBounds Enlarge(const BvhBounds &_b, const double _margin)
+  {
+    BvhBounds e = _b;
+    for (int a = 0; a < 3; ++a)
+    {
+      e.min[a] -= _margin;
+      e.max[a] += _margin;
+    }
+    return e;
+  }
+
+  //////////////////////////////////////////////////
+  /// \brief Remove a value from a vector, without keeping the order.
+  /// \param[in,out] _v The vector.
+  /// \param[in] _value Value to remove.
+  void EraseUnordered(std::vector<uint32_t> &_v, const uint32_t _value)
+  {
+    auto it = std::find(_v.begin(), _v.end(), _value);
+    if (it != _v.end())
+    {
+      *it = _v.back();
+      _v.pop_back();
+    }
+  }
+
+  //////////////////////////////////////////////////
+  /// \brief Get a pair of ids, the smallest first.
+  /// \param[in] _a First id.
+  /// \param[in] _b Second id.
+  /// \return The pair.
+  IdPair MakePair(const uint32_t _a, const uint32_t _b)
+  {
+    return IdPair(std::min(_a, _b), std::max(_a, _b));
+  }
+}  // namespace
+
+/// \brief Private data for DynamicBvh
+class ignition::math::DynamicBvhPrivate
+{
+  /// \brief Get a node from the free list, or a new one.
+  /// \return Index of the node.
+  public: uint32_t NewNode();
+
+  /// \brief Put a node in the free list.
+  /// \param[in] _index Index of the node.
+  public: void FreeNode(const uint32_t _index);
+
+  /// \brief Insert a leaf at the place of lowest surface area cost.
+  /// \param[in] _leaf Index of the leaf, with its bounds set.
+  public: void InsertLeaf(const uint32_t _leaf);
+
+  /// \brief Remove a leaf from the tree, without freeing it.
+  /// \param[in] _leaf Index of the leaf.
+  public: void RemoveLeaf(const uint32_t _leaf);
+
+  /// \brief Refit the bounds and heights of the ancestors of a node, and
+  /// balance them on the way up.
+  /// \param[in] _index First node to refit.
+  public: void Refit(uint32_t _index);
+
+  /// \brief Rotate a node with one of its children if the heights of its
+  /// children differ by more than one.
+  /// \param[in] _a Index of the node.
+  /// \return Index of the node that took the place of _a.
+  public: uint32_t Balance(const uint32_t _a);
+
+  /// \brief Create the leaf of a box.
+  /// \param[in] _id Id of the box, not empty.
+  /// \param[in] _fat Fat box.
+  public: void AddLeaf(const uint32_t _id, const BvhBounds &_fat);
+
+  /// \brief Remove the pairs of a box, and report them as removed by the
+  /// next call to UpdatePairs().
+  /// \param[in] _id Id of the box.
+  public: void DropPairs(const uint32_t _id);
+
+  /// \brief Visit the leaves whose ancestors pass a test.
+  /// \param[in] _nodeTest Callable taking the bounds of a node and
+  /// returning whether to visit it.
+  /// \param[in] _leafVisit Callable taking the id of the box of a leaf
+  /// and returning false to stop the traversal.
+  public: template<typename NodeTest, typename LeafVisit>
+          void Traverse(NodeTest _nodeTest, LeafVisit _leafVisit) const;
+
+  /// \brief Nodes, including those of the free list
+  public: std::vector<Node> nodes;
+
+  /// \brief First node of the free list
+  public: uint32_t freeNode = kNone;
+
+  /// \brief Number of nodes in use
+  public: std::size_t nodeCount = 0;
+
+  /// \brief Root node, kNone if the tree is empty
+  public: uint32_t root = kNone;
+
+  /// \brief Boxes, including those of the free list
+  public: std::vector<Object> objects;
+
+  /// \brief First box of the free list
+  public: uint32_t freeObject = kNone;
+
+  /// \brief Number of boxes in use
+  public: std::size_t size = 0;
+
+  /// \brief Boxes paired with each box
+  public: std::vector<std::vector<uint32_t>> partners;
+
+  /// \brief Boxes whose fat box changed since the last UpdatePairs(),
+  /// possibly with duplicates
+  public: std::vector<uint32_t> moved;
+
+  /// \brief Pairs removed with their boxes since the last UpdatePairs()
+  public: std::vector<IdPair> removedPairs;
+
+  /// \brief Margin of the fat boxes
+  public: double margin = 0.1;
+};
+
+//////////////////////////////////////////////////
+uint32_t DynamicBvhPrivate::NewNode()
+{
+  uint32_t index = this->freeNode;
+  if (index != kNone)
+  {
+    this->freeNode = this->nodes[index].parent;
+  }
+  else
+  {
+    index = static_cast<uint32_t>(this->nodes.size());
+    this->nodes.emplace_back();
+  }
+  ++this->nodeCount;
+
+  Node &node = this->nodes[index];
+  node.parent = kNone;
+  node.children[0] = kNone;
+  node.children[1] = kNone;
+  node.object = kNone;
+  node.height = 0;
+  return index;
+}
+
+//////////////////////////////////////////////////
+void DynamicBvhPrivate::FreeNode(const uint32_t _index)
+{
+  this->nodes[_index].parent = this->freeNode;
+  this->nodes[_index].height = -1;
+  this->freeNode = _index;
+  --this->nodeCount;
+}
+
+//////////////////////////////////////////////////
+void DynamicBvhPrivate::InsertLeaf(const uint32_t _leaf)
+{
+  if (this->root == kNone)
+  {
+    this->root = _leaf;
+    this->nodes[_leaf].parent = kNone;
+    return;
+  }
+
+  // Descend to the sibling that increases the surface area of the tree
+  // the least, as in Box2D's b2DynamicTree. The cost of a child is the
+  // area added to it, plus the area that the leaf adds to all its
+  // ancestors.
+  const BvhBounds leafBounds = this->nodes[_leaf].bounds;
+  uint32_t index = this->root;
+  while (this->nodes[index].children[0] != kNone)
+  {
+    const Node &node = this->nodes[index];
+    const double area = node.bounds.HalfArea();
+    const double combinedArea = Union(node.bounds, leafBounds).HalfArea();
+
+    // Cost of making a new parent of this node and the leaf
+    const double cost = 2 * combinedArea;
+
+    // Minimum cost of pushing the leaf further down
+    const double inheritance = 2 * (combinedArea - area);
+
+    double childCost[2];
+    for (int c = 0; c < 2; ++c)
+    {
+      const Node &child = this->nodes[node.children[c]];
+      const double newArea = Union(leafBounds, child.bounds).HalfArea();
+      if (child.children[0] == kNone)
+        childCost[c] = newArea + inheritance;
+      else
+        childCost[c] = newArea - child.bounds.HalfArea() + inheritance;
+    }
+
+    if (cost < childCost[0] && cost < childCost[1])
+      break;
+    index = node.children[childCost[0] < childCost[1] ? 0 : 1];
+  }
+
+  const uint32_t sibling = index;
+  const uint32_t newParent = this->NewNode();
+  const uint32_t oldParent = this->nodes[sibling].parent;
+  Node &parent = this->nodes[newParent];
+  parent.parent = oldParent;
+  parent.bounds = Union(leafBounds, this->nodes[sibling].bounds);
+  parent.height = this->nodes[sibling].height + 1;
+  parent.children[0] = sibling;
+  parent.children[1] = _leaf;
+  this->nodes[sibling].parent = newParent;
+  this->nodes[_leaf].parent = newParent;
+
+  if (oldParent == kNone)
+  {
+    this->root = newParent;
+  }
+  else
+  {
+    Node &old = this->nodes[oldParent];
+    old.children[old.children[0] == sibling ? 0 : 1] = newParent;
+  }
+
+  this->Refit(oldParent);
+}
+
+//////////////////////////////////////////////////
+void DynamicBvhPrivate::RemoveLeaf(const uint32_t _leaf)
+{
+  if (_leaf == this->root)
+  {
+    this->root = kNone;
+    return;
+  }
+
+  const uint32_t parent = this->nodes[_leaf].parent;
+  const uint32_t grandParent = this->nodes[parent].parent;
+  const Node &parentNode = this->nodes[parent];
+  const uint32_t sibling =
+    parentNode.children[parentNode.children[0] == _leaf ? 1 : 0];
+
+  this->nodes[sibling].parent = grandParent;
+  if (grandParent == kNone)
+  {
+    this->root = sibling;
+  }
+  else
+  {
+    Node &grand = this->nodes[grandParent];
+    grand.children[grand.children[0] == parent ? 0 : 1] = sibling;
+  }
+  this->FreeNode(parent);
+  this->nodes[_leaf].parent = kNone;
+
+  this->Refit(grandParent);
+}
+
+//////////////////////////////////////////////////
+void DynamicBvhPrivate::Refit(uint32_t _index)
+{
+  while (_index != kNone)
+  {
+    _index = this->Balance(_index);
+    Node &node = this->nodes[_index];
+    const Node &child0 = this->nodes[node.children[0]];
+    const Node &child1 = this->nodes[node.children[1]];
+    node.height = 1 + std::max(child0.height, child1.height);
+    node.bounds = Union(child0.bounds, child1.bounds);
+    _index = node.parent;
+  }
+}
+
+//////////////////////////////////////////////////
+uint32_t DynamicBvhPrivate::Balance(const uint32_t _a)
+{
+  Node &a = this->nodes[_a];
+  if (a.children[0] == kNone || a.height < 2)
+    return _a;
+
+  // The taller child b takes the place of a, a takes the place of the
+  // taller child of b, and the shorter child of b moves under a
+  const int balance =
+    this->nodes[a.children[1]].height - this->nodes[a.children[0]].height;
+  if (balance >= -1 && balance <= 1)
+    return _a;
+
+  const int tall = balance > 1 ? 1 : 0;
+  const uint32_t bIndex = a.children[tall];
+  Node &b = this->nodes[bIndex];
+  const uint32_t cIndex = a.children[1 - tall];
+  const Node &c = this->nodes[cIndex];
+  const uint32_t dIndex = b.children[0];
+  const uint32_t eIndex = b.children[1];
+  const bool dTaller = this->nodes[dIndex].height > this->nodes[eIndex].height;
+  const uint32_t upIndex = dTaller ? dIndex : eIndex;
+  const uint32_t downIndex = dTaller ? eIndex : dIndex;
+  Node &up = this->nodes[upIndex];
+  Node &down = this->nodes[downIndex];
+
+  // b replaces a under the parent of a
+  b.parent = a.parent;
+  if (b.parent == kNone)
+  {
+    this->root = bIndex;
+  }
+  else
+  {
+    Node &parent = this->nodes[b.parent];
+    parent.children[parent.children[0] == _a ? 0 : 1] = bIndex;
+  }
+
+  b.children[0] = _a;
+  b.children[1] = upIndex;
+  a.parent = bIndex;
+  a.children[tall] = downIndex;
+  down.parent = _a;
+
+  a.bounds = Union(c.bounds, down.bounds);
+  a.height = 1 + std::max(c.height, down.height);
+  b.bounds = Union(a.bounds, up.bounds);
+  b.height = 1 + std::max(a.height, up.height);
+  return bIndex;
+}
+
+//////////////////////////////////////////////////
+void DynamicBvhPrivate::AddLeaf(const uint32_t _id, const BvhBounds &_fat)
+{
+  const uint32_t leaf = this->NewNode();
+  this->nodes[leaf].bounds = _fat;
+  this->nodes[leaf].object = _id;
+  this->objects[_id].leaf = leaf;
+  this->InsertLeaf(leaf);
+  if (!this->objects[_id].moved)
+  {
+    this->objects[_id].moved = true;
+    this->moved.push_back(_id);
+  }
+}
+
+//////////////////////////////////////////////////
+void DynamicBvhPrivate::DropPairs(const uint32_t _id)
+{
+  for (const uint32_t other : this->partners[_id])
+  {
+    EraseUnordered(this->partners[other], _id);
+    this->removedPairs.push_back(MakePair(_id, other));
+  }
+  this->partners[_id].clear();
+}
+
+//////////////////////////////////////////////////
+template<typename NodeTest, typename LeafVisit>
+void DynamicBvhPrivate::Traverse(NodeTest _nodeTest,
+    LeafVisit _leafVisit) const
+{
+  if (this->root == kNone)
+    return;
+
+  uint32_t stack[kBvhStackSize];
+  int top = 0;
+  stack[top++] = this->root;
+  while (top > 0)
+  {
+    const Node &node = this->nodes[stack[--top]];
+    if (!_nodeTest(node.bounds))
+      continue;
+
+    if (node.children[0] == kNone)
+    {
+      if (!_leafVisit(node.object))
+        return;
+    }
+    else
+    {
+      stack[top++] = node.children[0];
+      stack[top++] = node.children[1];
+    }
+  }
+}
+
+//////////////////////////////////////////////////
+DynamicBvh::DynamicBvh(const double _margin)
+: dataPtr(new DynamicBvhPrivate)
+{
+  this->dataPtr->margin = _margin > 0 ? _margin : 0;
+}
+
+//////////////////////////////////////////////////
+DynamicBvh::DynamicBvh(const DynamicBvh &_bvh)
+: dataPtr(new DynamicBvhPrivate(*_bvh.dataPtr))
+{
+}
+
+//////////////////////////////////////////////////
+DynamicBvh::~DynamicBvh()
+{
+}
+
+//////////////////////////////////////////////////
+DynamicBvh &DynamicBvh::operator=(const DynamicBvh &_bvh)
+{
+  *this->dataPtr = *_bvh.dataPtr;
+  return *this;
+}
+
+//////////////////////////////////////////////////
+double DynamicBvh::Margin() const
+{
+  return this->dataPtr->margin;
+}
+
+//////////////////////////////////////////////////
+std::size_t DynamicBvh::Insert(const AxisAlignedBox &_box)
+{
+  DynamicBvhPrivate &d = *this->dataPtr;
+  uint32_t id = d.freeObject;
+  if (id != kNone)
+  {
+    d.freeObject = d.objects[id].nextFree;
+  }
+  else
+  {
+    id = static_cast<uint32_t>(d.objects.size());
+    d.objects.emplace_back();
+    d.partners.emplace_back();
+  }
+  ++d.size;
+
+  Object &object = d.objects[id];
+  object.box = ToBounds(_box);
+  object.leaf = kNone;
+  object.nextFree = kNone;
+  object.used = true;
+  object.moved = false;
+  if (!IsEmpty(object.box))
+    d.AddLeaf(id, Enlarge(object.box, d.margin));
+  return id;
+}
+
+//////////////////////////////////////////////////
+bool DynamicBvh::Remove(const std::size_t _id)
+{
+  if (!this->Has(_id))
+    return false;
+
+  DynamicBvhPrivate &d = *this->dataPtr;
+  const uint32_t id = static_cast<uint32_t>(_id);
+  Object &object = d.objects[id];
+  if (object.leaf != kNone)
+  {
+    d.RemoveLeaf(object.leaf);
+    d.FreeNode(object.leaf);
+    object.leaf = kNone;
+  }
+  d.DropPairs(id);
+  object.used = false;
+  object.moved = false;
+  object.nextFree = d.freeObject;
+  d.freeObject = id;
+  --d.size;
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool DynamicBvh::Update(const std::size_t _id, const AxisAlignedBox &_box,
+    const Vector3d &_displacement)
+{
+  if (!this->Has(_id))
+    return false;
+
+  DynamicBvhPrivate &d = *this->dataPtr;
+  const uint32_t id = static_cast<uint32_t>(_id);
+  Object &object = d.objects[id];
+  object.box = ToBounds(_box);
+
+  if (IsEmpty(object.box))
+  {
+    if (object.leaf != kNone)
+    {
+      d.RemoveLeaf(object.leaf);
+      d.FreeNode(object.leaf);
+      object.leaf = kNone;
+      object.moved = false;
+      d.DropPairs(id);
+    }
+    return true;
+  }
+
+  BvhBounds fat = Enlarge(object.box, d.margin);
+  for (int a = 0; a < 3; ++a)
+  {
+    if (_displacement[a] < 0)
+      fat.min[a] += _displacement[a];
+    else
+      fat.max[a] += _displacement[a];
+  }
+
+  if (object.leaf == kNone)
+  {
+    d.AddLeaf(id, fat);
+    return true;
+  }
+
+  // Keep the fat box while it contains the box and is not much larger
+  // than needed
+  Node &leaf = d.nodes[object.leaf];
+  if (Encloses(leaf.bounds, object.box) &&
+      Encloses(Enlarge(fat, 4 * d.margin), leaf.bounds))
+  {
+    return true;
+  }
+
+  d.RemoveLeaf(object.leaf);
+  leaf.bounds = fat;
+  d.InsertLeaf(object.leaf);
+  if (!object.moved)
+  {
+    object.moved = true;
+    d.moved.push_back(id);
+  }
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool DynamicBvh::UpdatePairs(std::vector<IdPair> &_added,
+    std::vector<IdPair> &_removed)
+{
+  DynamicBvhPrivate &d = *this->dataPtr;
+  _added.clear();
+  _removed.swap(d.removedPairs);
+  d.removedPairs.clear();
+
+  // Boxes removed or emptied after they moved are still in the list, and
+  // their id may have been reused
+  auto end = std::remove_if(d.moved.begin(), d.moved.end(),
+      [&](const uint32_t _id) {return !d.objects[_id].moved;});
+  d.moved.erase(end, d.moved.end());
+  std::sort(d.moved.begin(), d.moved.end());
+  d.moved.erase(std::unique(d.moved.begin(), d.moved.end()), d.moved.end());
+
+  // Only the pairs of the boxes whose fat box changed can change
+  for (const uint32_t id : d.moved)
+  {
+    const BvhBounds &fat = d.nodes[d.objects[id].leaf].bounds;
+    std::vector<uint32_t> &partners = d.partners[id];
+    for (std::size_t i = 0; i < partners.size();)
+    {
+      const uint32_t other = partners[i];
+      if (fat.Intersects(d.nodes[d.objects[other].leaf].bounds))
+      {
+        ++i;
+        continue;
+      }
+      _removed.push_back(MakePair(id, other));
+      EraseUnordered(d.partners[other], id);
+      partners[i] = partners.back();
+      partners.pop_back();
+    }
+  }
+
+  for (const uint32_t id : d.moved)
+  {
+    const BvhBounds &fat = d.nodes[d.objects[id].leaf].bounds;
+    d.Traverse(
+        [&](const BvhBounds &_b) {return fat.Intersects(_b);},
+        [&](const uint32_t _other)
+        {
+          // A pair of two boxes that moved is found by the query of the
+          // box with the largest id
+          if (_other == id || (d.objects[_other].moved && _other > id))
+            return true;
+
+          std::vector<uint32_t> &partners = d.partners[id];
+          if (std::find(partners.begin(), partners.end(), _other) ==
+              partners.end())
+          {
+            partners.push_back(_other);
+            d.partners[_other].push_back(id);
+            _added.push_back(MakePair(id, _other));
+          }
+          return true;
+        });
+  }
+
+  for (const uint32_t id : d.moved)
+    d.objects[id].moved = false;
+  d.moved.clear();
+
+  std::sort(_added.begin(), _added.end());
+  std::sort(_removed.begin(), _removed.end());
+  return !_added.empty() || !_removed.empty();
+}
+
+//////////////////////////////////////////////////
+void DynamicBvh::Pairs(std::vector<IdPair> &_pairs) const
+{
+  _pairs.clear();
+  const DynamicBvhPrivate &d = *this->dataPtr;
+  for (uint32_t id = 0; id < d.partners.size(); ++id)
+  {
+    for (const uint32_t other : d.partners[id])
+    {
+      if (id < other)
+        _pairs.push_back(IdPair(id, other));
+    }
+  }
+  std::sort(_pairs.begin(), _pairs.end());
+}
+
+//////////////////////////////////////////////////
+void DynamicBvh::Clear()
+{
+  const double margin = this->dataPtr->margin;
+  *this->dataPtr = DynamicBvhPrivate();
+  this->dataPtr->margin = margin;
+}
+
+//////////////////////////////////////////////////
+std::size_t DynamicBvh::Size() const
+{
+  return this->dataPtr->size;
+}
+
+//////////////////////////////////////////////////
+std::size_t DynamicBvh::NodeCount() const
+{
+  return this->dataPtr->nodeCount;
+}
+
+//////////////////////////////////////////////////
+int DynamicBvh::Height() const
+{
+  const DynamicBvhPrivate &d = *this->dataPtr;
+  return d.root == kNone ? 0 : d.nodes[d.root].height;
+}
+
+//////////////////////////////////////////////////
+bool DynamicBvh::Has(const std::size_t _id) const
+{
+  return _id < this->dataPtr->objects.size() &&
+         this->dataPtr->objects[_id].used;
+}
+
+//////////////////////////////////////////////////
+AxisAlignedBox DynamicBvh::Box(const std::size_t _id) const
+{
+  if (!this->Has(_id) || this->dataPtr->objects[_id].leaf == kNone)
+    return AxisAlignedBox();
+  return ToBox(this->dataPtr->objects[_id].box);
+}
+
+//////////////////////////////////////////////////
+AxisAlignedBox DynamicBvh::FatBox(const std::size_t _id) const
+{
+  if (!this->Has(_id) || this->dataPtr->objects[_id].leaf == kNone)
+    return AxisAlignedBox();
+  const DynamicBvhPrivate &d = *this->dataPtr;
+  return ToBox(d.nodes[d.objects[_id].leaf].bounds);
+}
+
+//////////////////////////////////////////////////
+std::tuple<bool, double, std::size_t> DynamicBvh::Intersect(
+    const Vector3d &_origin, const Vector3d &_dir, const double _min,
+    const double _max) const
+{
+  const BvhRay ray(_origin, _dir, _min, _max);
+  const DynamicBvhPrivate &d = *this->dataPtr;
+
+  double best = _max;
+  uint32_t bestId = 0;
+  bool hit = false;
+  double t;
+  if (d.root == kNone || !ray.HitNode(d.nodes[d.root].bounds, best, t))
+    return std::make_tuple(false, 0.0, std::size_t(0));
+
+  // Nearest child first, skipping the nodes farther than the closest hit
+  uint32_t stack[kBvhStackSize];
+  double stackDist[kBvhStackSize];
+  int top = 0;
+  stack[top] = d.root;
+  stackDist[top++] = t;
+  while (top > 0)
+  {
+    --top;
+    if (stackDist[top] > best)
+      continue;
+    const Node &node = d.nodes[stack[top]];
+
+    if (node.children[0] == kNone)
+    {
+      const uint32_t id = node.object;
+      if (ray.Hit(d.objects[id].box, best, t) &&
+          (!hit || t < best || (!(best < t) && id < bestId)))
+      {
+        hit = true;
+        best = t;
+        bestId = id;
+      }
+      continue;
+    }
+
+    double dist[2];
+    const bool hits[2] =
+    {
+      ray.HitNode(d.nodes[node.children[0]].bounds, best, dist[0]),
+      ray.HitNode(d.nodes[node.children[1]].bounds, best, dist[1])
+    };
+    const int nearest = hits[0] && hits[1] && dist[1] < dist[0] ? 1 : 0;
+    const int order[2] = {1 - nearest, nearest};
+    for (const int c : order)
+    {
+      if (hits[c])
+      {
+        stack[top] = node.children[c];
+        stackDist[top++] = dist[c];
+      }
+    }
+  }
+
+  if (!hit)
+    return std::make_tuple(false, 0.0, std::size_t(0));
+  return std::make_tuple(true, best - _min, std::size_t(bestId));
+}
+
+//////////////////////////////////////////////////
+bool DynamicBvh::IntersectAll(const Vector3d &_origin, const Vector3d &_dir,
+    const double _min, const double _max,
+    std::vector<std::size_t> &_ids) const
+{
+  _ids.clear();
+  const BvhRay ray(_origin, _dir, _min, _max);
+  const DynamicBvhPrivate &d = *this->dataPtr;
+  double t;
+  d.Traverse(
+      [&](const BvhBounds &_b) {return ray.HitNode(_b, ray.tMax, t);},
+      [&](const uint32_t _id)
+      {
+        if (ray.Hit(d.objects[_id].box, ray.tMax, t))
+          _ids.push_back(_id);
+        return true;
+      });
+  return !_ids.empty();
+}
+
+//////////////////////////////////////////////////
+bool DynamicBvh::Overlap(const AxisAlignedBox &_box,
+    std::vector<std::size_t> &_ids) const
+{
+  _ids.clear();
+  const BvhBounds box = ToBounds(_box);
+  const DynamicBvhPrivate &d = *this->dataPtr;
+  d.Traverse(
+      [&](const BvhBounds &_b) {return box.Intersects(_b);},
+      [&](const uint32_t _id)
+      {
+        if (box.Intersects(d.objects[_id].box))
+          _ids.push_back(_id);
+        return true;
+      });
+  return !_ids.empty();
+}
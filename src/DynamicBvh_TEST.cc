@@ -0,0 +1,356 @@
+/*
+ * Copyright (C) 2018 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <set>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "ignition/math/Bvh.hh"
+#include "ignition/math/DynamicBvh.hh"
+#include "ignition/math/Rand.hh"
+
+using namespace ignition;
+
+/// \brief A pair of ids
+typedef std::pair<std::size_t, std::size_t> IdPair;
+
+/////////////////////////////////////////////////
+/// \brief Random box of size up to _size with its minimum corner in a
+/// cube of side 2 * _range.
+math::AxisAlignedBox RandomBox(const double _range, const double _size)
+{
+  const math::Vector3d min(math::Rand::DblUniform(-_range, _range),
+      math::Rand::DblUniform(-_range, _range),
+      math::Rand::DblUniform(-_range, _range));
+  const math::Vector3d size(math::Rand::DblUniform(0, _size),
+      math::Rand::DblUniform(0, _size), math::Rand::DblUniform(0, _size));
+  return math::AxisAlignedBox(min, min + size);
+}
+
+/////////////////////////////////////////////////
+math::Vector3d RandomVector(const double _range)
+{
+  return math::Vector3d(math::Rand::DblUniform(-_range, _range),
+      math::Rand::DblUniform(-_range, _range),
+      math::Rand::DblUniform(-_range, _range));
+}
+
+/////////////////////////////////////////////////
+/// \brief Pairs of overlapping fat boxes, found by testing all the pairs.
+std::vector<IdPair> BrutePairs(const math::DynamicBvh &_bvh,
+    const std::size_t _count)
+{
+  std::vector<IdPair> pairs;
+  for (std::size_t i = 0; i < _count; ++i)
+  {
+    for (std::size_t j = i + 1; j < _count; ++j)
+    {
+      if (_bvh.Has(i) && _bvh.Has(j) &&
+          _bvh.FatBox(i).Intersects(_bvh.FatBox(j)))
+      {
+        pairs.push_back(IdPair(i, j));
+      }
+    }
+  }
+  return pairs;
+}
+
+/////////////////////////////////////////////////
+TEST(DynamicBvhTest, Construct)
+{
+  math::DynamicBvh bvh;
+  EXPECT_DOUBLE_EQ(0.1, bvh.Margin());
+  EXPECT_EQ(0u, bvh.Size());
+  EXPECT_EQ(0u, bvh.NodeCount());
+  EXPECT_EQ(0, bvh.Height());
+  EXPECT_FALSE(bvh.Has(0));
+
+  math::DynamicBvh negative(-1);
+  EXPECT_DOUBLE_EQ(0, negative.Margin());
+
+  std::vector<std::size_t> ids;
+  EXPECT_FALSE(bvh.Overlap(math::AxisAlignedBox(-1, -1, -1, 1, 1, 1), ids));
+  EXPECT_FALSE(std::get<0>(bvh.Intersect(math::Vector3d::Zero,
+        math::Vector3d::UnitX, 0, 10)));
+
+  std::vector<IdPair> added, removed;
+  EXPECT_FALSE(bvh.UpdatePairs(added, removed));
+}
+
+/////////////////////////////////////////////////
+TEST(DynamicBvhTest, InsertRemove)
+{
+  math::DynamicBvh bvh(0.5);
+  const math::AxisAlignedBox a(0, 0, 0, 1, 1, 1);
+  const math::AxisAlignedBox b(3, 0, 0, 4, 1, 1);
+
+  EXPECT_EQ(0u, bvh.Insert(a));
+  EXPECT_EQ(1u, bvh.NodeCount());
+  EXPECT_EQ(1u, bvh.Insert(b));
+  EXPECT_EQ(2u, bvh.Size());
+  EXPECT_EQ(3u, bvh.NodeCount());
+  EXPECT_EQ(1, bvh.Height());
+  EXPECT_EQ(a, bvh.Box(0));
+  EXPECT_EQ(math::AxisAlignedBox(-0.5, -0.5, -0.5, 1.5, 1.5, 1.5),
+      bvh.FatBox(0));
+
+  // Empty boxes take an id but no leaf
+  EXPECT_EQ(2u, bvh.Insert(math::AxisAlignedBox()));
+  EXPECT_EQ(3u, bvh.Size());
+  EXPECT_EQ(3u, bvh.NodeCount());
+  EXPECT_TRUE(bvh.Has(2));
+  EXPECT_EQ(math::AxisAlignedBox(), bvh.Box(2));
+  EXPECT_EQ(math::AxisAlignedBox(), bvh.FatBox(2));
+  EXPECT_TRUE(bvh.Update(2, math::AxisAlignedBox(0, 0, 5, 1, 1, 6)));
+  EXPECT_EQ(5u, bvh.NodeCount());
+
+  EXPECT_TRUE(bvh.Remove(0));
+  EXPECT_FALSE(bvh.Remove(0));
+  EXPECT_FALSE(bvh.Update(0, a));
+  EXPECT_FALSE(bvh.Has(0));
+  EXPECT_FALSE(bvh.Remove(42));
+  EXPECT_EQ(math::AxisAlignedBox(), bvh.Box(0));
+  EXPECT_EQ(2u, bvh.Size());
+  EXPECT_EQ(3u, bvh.NodeCount());
+
+  // Removed ids are reused
+  EXPECT_EQ(0u, bvh.Insert(a));
+  EXPECT_EQ(3u, bvh.Size());
+
+  bvh.Clear();
+  EXPECT_EQ(0u, bvh.Size());
+  EXPECT_EQ(0u, bvh.NodeCount());
+  EXPECT_FALSE(bvh.Has(0));
+  EXPECT_DOUBLE_EQ(0.5, bvh.Margin());
+}
+
+/////////////////////////////////////////////////
+TEST(DynamicBvhTest, FatBoxes)
+{
+  math::DynamicBvh bvh(0.5);
+  const std::size_t id = bvh.Insert(math::AxisAlignedBox(0, 0, 0, 1, 1, 1));
+  bvh.Insert(math::AxisAlignedBox(5, 5, 5, 6, 6, 6));
+  const math::AxisAlignedBox fat = bvh.FatBox(id);
+
+  // Small moves keep the fat box
+  const math::AxisAlignedBox small(0.3, -0.2, 0.4, 1.3, 0.8, 1.4);
+  EXPECT_TRUE(bvh.Update(id, small));
+  EXPECT_EQ(small, bvh.Box(id));
+  EXPECT_EQ(fat, bvh.FatBox(id));
+
+  // Leaving the fat box makes a new one
+  const math::AxisAlignedBox moved(2, 0, 0, 3, 1, 1);
+  EXPECT_TRUE(bvh.Update(id, moved));
+  EXPECT_EQ(math::AxisAlignedBox(1.5, -0.5, -0.5, 3.5, 1.5, 1.5),
+      bvh.FatBox(id));
+
+  // The fat box is extended along the displacement
+  const math::AxisAlignedBox far(10, 0, 0, 11, 1, 1);
+  EXPECT_TRUE(bvh.Update(id, far, math::Vector3d(2, 0, -1)));
+  EXPECT_EQ(math::AxisAlignedBox(9.5, -0.5, -1.5, 13.5, 1.5, 1.5),
+      bvh.FatBox(id));
+
+  // A fat box much larger than needed is shrunk
+  const math::AxisAlignedBox farther(20, 0, 0, 21, 1, 1);
+  EXPECT_TRUE(bvh.Update(id, farther, math::Vector3d(30, 0, 0)));
+  EXPECT_EQ(math::AxisAlignedBox(19.5, -0.5, -0.5, 51.5, 1.5, 1.5),
+      bvh.FatBox(id));
+  EXPECT_TRUE(bvh.Update(id, farther));
+  EXPECT_EQ(math::AxisAlignedBox(19.5, -0.5, -0.5, 21.5, 1.5, 1.5),
+      bvh.FatBox(id));
+}
+
+/////////////////////////////////////////////////
+TEST(DynamicBvhTest, Pairs)
+{
+  math::DynamicBvh bvh(0.2);
+  std::vector<math::AxisAlignedBox> boxes;
+  for (int i = 0; i < 300; ++i)
+  {
+    boxes.push_back(RandomBox(20, 3));
+    bvh.Insert(boxes.back());
+  }
+
+  std::vector<IdPair> added, removed, pairs;
+  EXPECT_TRUE(bvh.UpdatePairs(added, removed));
+  EXPECT_TRUE(removed.empty());
+  EXPECT_EQ(BrutePairs(bvh, boxes.size()), added);
+  bvh.Pairs(pairs);
+  EXPECT_EQ(added, pairs);
+
+  // Nothing changes without updates
+  EXPECT_FALSE(bvh.UpdatePairs(added, removed));
+  EXPECT_TRUE(added.empty());
+
+  std::set<IdPair> known(pairs.begin(), pairs.end());
+  std::vector<math::Vector3d> vel;
+  for (std::size_t i = 0; i < boxes.size(); ++i)
+    vel.push_back(RandomVector(0.3));
+
+  for (int step = 0; step < 50; ++step)
+  {
+    for (std::size_t i = 0; i < boxes.size(); ++i)
+    {
+      if (!bvh.Has(i))
+        continue;
+      boxes[i] = math::AxisAlignedBox(boxes[i].Min() + vel[i],
+          boxes[i].Max() + vel[i]);
+      EXPECT_TRUE(bvh.Update(i, boxes[i], step % 2 == 0 ? vel[i] :
+            math::Vector3d::Zero));
+    }
+
+    // Remove and add some boxes
+    if (step % 10 == 5)
+    {
+      EXPECT_TRUE(bvh.Remove(step));
+      EXPECT_TRUE(bvh.Remove(step + 100));
+      EXPECT_EQ(static_cast<std::size_t>(step + 100),
+          bvh.Insert(RandomBox(20, 3)));
+      boxes[step + 100] = bvh.Box(step + 100);
+    }
+
+    bvh.UpdatePairs(added, removed);
+    for (const auto &p : removed)
+    {
+      EXPECT_LT(p.first, p.second);
+      EXPECT_EQ(1u, known.erase(p));
+    }
+    for (const auto &p : added)
+    {
+      EXPECT_LT(p.first, p.second);
+      EXPECT_TRUE(known.insert(p).second);
+    }
+
+    const std::vector<IdPair> expected = BrutePairs(bvh, boxes.size());
+    EXPECT_EQ(expected, std::vector<IdPair>(known.begin(), known.end()));
+    bvh.Pairs(pairs);
+    EXPECT_EQ(expected, pairs);
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(DynamicBvhTest, RemovedPairs)
+{
+  math::DynamicBvh bvh(0);
+  bvh.Insert(math::AxisAlignedBox(0, 0, 0, 2, 2, 2));
+  bvh.Insert(math::AxisAlignedBox(1, 1, 1, 3, 3, 3));
+  bvh.Insert(math::AxisAlignedBox(1.5, 1.5, 1.5, 4, 4, 4));
+
+  std::vector<IdPair> added, removed;
+  EXPECT_TRUE(bvh.UpdatePairs(added, removed));
+  EXPECT_EQ(std::vector<IdPair>({{0, 1}, {0, 2}, {1, 2}}), added);
+
+  EXPECT_TRUE(bvh.Remove(1));
+  EXPECT_TRUE(bvh.Update(2, math::AxisAlignedBox()));
+  EXPECT_TRUE(bvh.UpdatePairs(added, removed));
+  EXPECT_TRUE(added.empty());
+  EXPECT_EQ(std::vector<IdPair>({{0, 1}, {0, 2}, {1, 2}}), removed);
+
+  // A reused id is paired again
+  EXPECT_EQ(1u, bvh.Insert(math::AxisAlignedBox(1, 1, 1, 3, 3, 3)));
+  EXPECT_TRUE(bvh.UpdatePairs(added, removed));
+  EXPECT_EQ(std::vector<IdPair>({{0, 1}}), added);
+  EXPECT_TRUE(removed.empty());
+}
+
+/////////////////////////////////////////////////
+TEST(DynamicBvhTest, Queries)
+{
+  // The same boxes in a DynamicBvh and in a Bvh, ids and indices match
+  math::DynamicBvh dynamic;
+  std::vector<math::AxisAlignedBox> boxes;
+  for (int i = 0; i < 1000; ++i)
+  {
+    boxes.push_back(RandomBox(50, i % 10 == 0 ? 20 : 2));
+    dynamic.Insert(boxes.back());
+  }
+  for (std::size_t i = 0; i < boxes.size(); i += 3)
+  {
+    const math::Vector3d offset = RandomVector(5);
+    boxes[i] = math::AxisAlignedBox(boxes[i].Min() + offset,
+        boxes[i].Max() + offset);
+    dynamic.Update(i, boxes[i]);
+  }
+  const math::Bvh bvh(boxes);
+
+  std::vector<std::size_t> ids, indices;
+  for (int q = 0; q < 200; ++q)
+  {
+    const math::Vector3d origin = RandomVector(70);
+    const math::Vector3d dir = RandomVector(1);
+    const double min = q % 3 == 0 ? 5 : 0;
+    EXPECT_EQ(bvh.Intersect(origin, dir, min, 200),
+        dynamic.Intersect(origin, dir, min, 200));
+    EXPECT_EQ(bvh.IntersectAll(origin, dir, min, 200, indices),
+        dynamic.IntersectAll(origin, dir, min, 200, ids));
+    std::sort(indices.begin(), indices.end());
+    std::sort(ids.begin(), ids.end());
+    EXPECT_EQ(indices, ids);
+
+    const math::AxisAlignedBox query = RandomBox(60, 20);
+    EXPECT_EQ(bvh.Overlap(query, indices), dynamic.Overlap(query, ids));
+    std::sort(indices.begin(), indices.end());
+    std::sort(ids.begin(), ids.end());
+    EXPECT_EQ(indices, ids);
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(DynamicBvhTest, Balance)
+{
+  // Boxes inserted in order along a line would make a list without the
+  // rotations
+  math::DynamicBvh bvh(0);
+  for (int i = 0; i < 4096; ++i)
+    bvh.Insert(math::AxisAlignedBox(i, 0, 0, i + 0.5, 1, 1));
+  EXPECT_EQ(2u * 4096 - 1, bvh.NodeCount());
+  EXPECT_LE(bvh.Height(), 20);
+
+  std::vector<std::size_t> ids;
+  EXPECT_TRUE(bvh.Overlap(math::AxisAlignedBox(100.2, 0, 0, 102.2, 1, 1),
+        ids));
+  std::sort(ids.begin(), ids.end());
+  EXPECT_EQ(std::vector<std::size_t>({100, 101, 102}), ids);
+}
+
+/////////////////////////////////////////////////
+TEST(DynamicBvhTest, Copy)
+{
+  math::DynamicBvh bvh(0.3);
+  for (int i = 0; i < 100; ++i)
+    bvh.Insert(RandomBox(10, 2));
+  std::vector<IdPair> added, removed, pairs;
+  bvh.UpdatePairs(added, removed);
+
+  const math::DynamicBvh copy(bvh);
+  math::DynamicBvh assigned;
+  assigned = bvh;
+  bvh.Clear();
+
+  copy.Pairs(pairs);
+  EXPECT_EQ(added, pairs);
+  assigned.Pairs(pairs);
+  EXPECT_EQ(added, pairs);
+  EXPECT_EQ(100u, copy.Size());
+  EXPECT_DOUBLE_EQ(0.3, assigned.Margin());
+  EXPECT_EQ(copy.NodeCount(), assigned.NodeCount());
+  EXPECT_EQ(0u, bvh.Size());
+}
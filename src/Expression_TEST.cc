@@ -0,0 +1,161 @@
+/*
+ * Copyright (C) 2018 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <type_traits>
+
+#include "ignition/math/Expression.hh"
+#include "ignition/math/Rand.hh"
+
+using namespace ignition;
+
+/////////////////////////////////////////////////
+TEST(ExpressionTest, Vector3)
+{
+  const math::Vector3d a(1, 2, 3);
+  const math::Vector3d b(4, -5, 6);
+  const math::Vector3d c(7, 8, -9);
+  const math::Vector3d d(0.5, 0, 2);
+  const double s = 0.25;
+
+  // The expressions use the same operation order as the operators
+  const math::Vector3d v1 = math::expr::Eval(
+      math::expr::Ref(a) + b * s - math::expr::Cross(c, d));
+  const math::Vector3d v2 = a + b * s - c.Cross(d);
+  EXPECT_DOUBLE_EQ(v1.X(), v2.X());
+  EXPECT_DOUBLE_EQ(v1.Y(), v2.Y());
+  EXPECT_DOUBLE_EQ(v1.Z(), v2.Z());
+
+  EXPECT_EQ(math::expr::Eval(-math::expr::Ref(a) / 2.0),
+      math::Vector3d(-0.5, -1, -1.5));
+  EXPECT_EQ(math::expr::Eval(2 * math::expr::Ref(a) - a),
+      math::Vector3d(1, 2, 3));
+  EXPECT_EQ(math::expr::Eval(math::expr::Cross(
+      math::expr::Ref(a) + b, c)), (a + b).Cross(c));
+
+  EXPECT_DOUBLE_EQ(math::expr::Dot(a, b), a.Dot(b));
+  EXPECT_DOUBLE_EQ(math::expr::Dot(a, math::expr::Ref(b) - c),
+      a.Dot(b - c));
+}
+
+/////////////////////////////////////////////////
+TEST(ExpressionTest, Vector4)
+{
+  const math::Vector4f a(1, 2, 3, 4);
+  const math::Vector4f b(-1, 0.5f, 2, 8);
+
+  const math::Vector4f v = math::expr::Eval(
+      math::expr::Ref(a) * 2.0f - b / 4.0f);
+  EXPECT_EQ(v, a * 2.0f - b / 4.0f);
+  EXPECT_TRUE((std::is_same<decltype(v), const math::Vector4f>::value));
+  EXPECT_FLOAT_EQ(math::expr::Dot(a, b), 1 + 6 + 32 - 1);
+}
+
+/////////////////////////////////////////////////
+TEST(ExpressionTest, Matrix3)
+{
+  const math::Matrix3d m1(1, 2, 3, 4, 5, 6, 7, 8, 10);
+  const math::Matrix3d m2(0, 1, 0, -1, 0, 0, 0, 0, 1);
+  const math::Vector3d v(1, -2, 0.5);
+  const math::Vector3d t(10, 20, 30);
+
+  EXPECT_EQ(math::expr::Eval(math::expr::Ref(m1) * v + t), m1 * v + t);
+  EXPECT_EQ(math::expr::Eval(math::expr::Ref(m1) * m2 - m1 * 0.5),
+      m1 * m2 - m1 * 0.5);
+  EXPECT_EQ(math::expr::Eval(math::expr::Ref(m1) * m2 * v), m1 * m2 * v);
+
+  const math::Matrix3d sum = math::expr::Eval(math::expr::Ref(m1) + m2);
+  EXPECT_EQ(sum, m1 + m2);
+}
+
+/////////////////////////////////////////////////
+TEST(ExpressionTest, Matrix4)
+{
+  const math::Matrix4d m(
+      1, 2, 3, 4,
+      5, 6, 7, 8,
+      9, 10, 11, 12,
+      13, 14, 15, 17);
+  const math::Vector4d v(1, 2, 3, 4);
+
+  EXPECT_EQ(math::expr::Eval(math::expr::Ref(m) * v),
+      math::Vector4d(30, 70, 110, 154));
+
+  // Matrix4 has no element-wise operators
+  const math::Matrix4d product = m * m;
+  const math::Matrix4d diff = math::expr::Eval(math::expr::Ref(m) * m - m);
+  for (int i = 0; i < 4; ++i)
+  {
+    for (int j = 0; j < 4; ++j)
+      EXPECT_DOUBLE_EQ(diff(i, j), product(i, j) - m(i, j));
+  }
+
+  EXPECT_EQ(math::expr::Eval(
+      math::expr::Ref(m) * math::Matrix4d::Identity), m);
+}
+
+/////////////////////////////////////////////////
+template<typename T>
+math::Matrix4<T> RandomMatrix4()
+{
+  math::Matrix4<T> m;
+  for (int i = 0; i < 4; ++i)
+  {
+    for (int j = 0; j < 4; ++j)
+      m(i, j) = static_cast<T>(math::Rand::DblUniform(-10, 10));
+  }
+  return m;
+}
+
+/////////////////////////////////////////////////
+TEST(ExpressionTest, Matrix4Rounding)
+{
+  // With non-integer values the products are rounded, and the compiler may
+  // contract them into fused multiply-adds differently in the expression
+  // and in the operators, so the results are compared with a tolerance
+  math::Rand::Seed(3);
+  for (int n = 0; n < 100; ++n)
+  {
+    const math::Matrix4d a = RandomMatrix4<double>();
+    const math::Matrix4d b = RandomMatrix4<double>();
+    const math::Matrix4d c = RandomMatrix4<double>();
+    EXPECT_TRUE(math::expr::Eval(math::expr::Ref(a) * b).Equal(
+        a * b, 1e-12));
+    EXPECT_TRUE(math::expr::Eval(math::expr::Ref(a) * b * c).Equal(
+        a * b * c, 1e-10));
+
+    const math::Matrix4f af = RandomMatrix4<float>();
+    const math::Matrix4f bf = RandomMatrix4<float>();
+    EXPECT_TRUE(math::expr::Eval(math::expr::Ref(af) * bf).Equal(
+        af * bf, 1e-3f));
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(ExpressionTest, OperatorsUnchanged)
+{
+  // The expression operators only apply to expressions, operators on the
+  // math types keep returning the math types
+  const math::Vector3d a(1, 2, 3);
+  EXPECT_TRUE((std::is_same<decltype(a + a), math::Vector3d>::value));
+
+  using namespace math::expr;
+  EXPECT_TRUE((std::is_same<decltype(a * 2.0), math::Vector3d>::value));
+  EXPECT_FALSE((std::is_same<decltype(Ref(a) * 2.0),
+        math::Vector3d>::value));
+}
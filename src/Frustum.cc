@@ -14,16 +14,262 @@
  * limitations under the License.
  *
 */
+#include <algorithm>
 #include <cmath>
 
 #include "ignition/math/AxisAlignedBox.hh"
 #include "ignition/math/Frustum.hh"
 #include "ignition/math/Matrix4.hh"
+#include "BatchKernels.hh"
 #include "FrustumPrivate.hh"
 
 using namespace ignition;
 using namespace math;
 
+namespace
+{
+/// \brief Number of boxes given to the kernel at once
+const std::size_t kChunkSize = 256;
+
+/// \brief Indices in FrustumPrivate::points of the ends of each edge of
+/// the frustum.
+const int kEdges[12][2] = {
+  {0, 1}, {0, 2}, {0, 4}, {1, 3}, {1, 5}, {2, 3},
+  {2, 6}, {4, 5}, {4, 6}, {5, 7}, {6, 7}, {7, 3}};
+
+/////////////////////////////////////////////////
+/// \brief Check if a point is on the positive side of all the planes of a
+/// frustum.
+/// \param[in] _data Private data of the frustum.
+/// \param[in] _p Point to check.
+/// \return True if the point is inside the frustum.
+bool PointInside(const FrustumPrivate &_data, const Vector3d &_p)
+{
+  for (auto const &plane : _data.planes)
+  {
+    if (plane.Side(_p) == Planed::NEGATIVE_SIDE)
+      return false;
+  }
+  return true;
+}
+
+/////////////////////////////////////////////////
+/// \brief Exact check of a box that crosses several planes of a frustum.
+/// \param[in] _data Private data of the frustum.
+/// \param[in] _min Minimum corner of the box.
+/// \param[in] _max Maximum corner of the box.
+/// \return True if the box overlaps the frustum.
+bool Overlaps(const FrustumPrivate &_data, const Vector3d &_min,
+    const Vector3d &_max)
+{
+  // return true if any box point is inside the frustum
+  for (int p = 0; p < 8; ++p)
+  {
+    const double &x = (p & 4) ? _min.X() : _max.X();
+    const double &y = (p & 2) ? _min.Y() : _max.Y();
+    const double &z = (p & 1) ? _min.Z() : _max.Z();
+    if (PointInside(_data, Vector3d(x, y, z)))
+      return true;
+  }
+  // return true if any frustum point is inside the box
+  for (auto const &pt : _data.points)
+  {
+    if (pt.X() >= _min.X() && pt.X() <= _max.X() &&
+        pt.Y() >= _min.Y() && pt.Y() <= _max.Y() &&
+        pt.Z() >= _min.Z() && pt.Z() <= _max.Z())
+    {
+      return true;
+    }
+  }
+
+  // Return true if any edge of the frustum passes through the AABB
+  for (const auto &ends : kEdges)
+  {
+    const Vector3d &first = _data.points[ends[0]];
+    const Vector3d &second = _data.points[ends[1]];
+    // If the edge projected onto a world axis does not overlapp with the AABB
+    // then the edge could not be passing through the AABB.
+    if (first.X() < _min.X() && second.X() < _min.X())
+    {
+      // both frustum edge points are below AABB on x axis
+      continue;
+    }
+    else if (first.X() > _max.X() && second.X() > _max.X())
+    {
+      // both frustum edge points are above AABB on x axis
+      continue;
+    }
+    else if (first.Y() < _min.Y() && second.Y() < _min.Y())
+    {
+      // both frustum edge points are below AABB on y axis
+      continue;
+    }
+    else if (first.Y() > _max.Y() && second.Y() > _max.Y())
+    {
+      // both frustum edge points are above AABB on y axis
+      continue;
+    }
+    else if (first.Z() < _min.Z() && second.Z() < _min.Z())
+    {
+      // both frustum edge points are below AABB on z axis
+      continue;
+    }
+    else if (first.Z() > _max.Z() && second.Z() > _max.Z())
+    {
+      // both frustum edge points are above AABB on z axis
+      continue;
+    }
+    else
+    {
+      // TODO(anyone) prove or disprove that Frustum must penetrate AABB???
+      return true;
+    }
+  }
+  return false;
+}
+/////////////////////////////////////////////////
+/// \brief Compute the planes and corners of a frustum in its own frame,
+/// where it looks along the x axis with z up.
+/// \param[in,out] _data Private data of the frustum.
+void ComputeLocal(FrustumPrivate &_data)
+{
+  // Tangent of half the field of view.
+  double tanFOV2 = std::tan(_data.fov() * 0.5);
+
+  // Width of near plane
+  double nearWidth = 2.0 * tanFOV2 * _data.near;
+
+  // Height of near plane
+  double nearHeight = nearWidth / _data.aspectRatio;
+
+  // Width of far plane
+  double farWidth = 2.0 * tanFOV2 * _data.far;
+
+  // Height of far plane
+  double farHeight = farWidth / _data.aspectRatio;
+
+  // Up, right, and forward unit vectors.
+  const Vector3d forward = Vector3d::UnitX;
+  const Vector3d up = Vector3d::UnitZ;
+  const Vector3d right = -Vector3d::UnitY;
+
+  // Near plane center
+  Vector3d nearCenter = forward * _data.near;
+
+  // Far plane center
+  Vector3d farCenter = forward * _data.far;
+
+  // These four variables are here for convenience.
+  Vector3d upNearHeight2 = up * (nearHeight * 0.5);
+  Vector3d rightNearWidth2 = right * (nearWidth * 0.5);
+  Vector3d upFarHeight2 = up * (farHeight * 0.5);
+  Vector3d rightFarWidth2 = right * (farWidth * 0.5);
+
+  // Compute the vertices of the near plane
+  Vector3d nearTopLeft = nearCenter + upNearHeight2 - rightNearWidth2;
+  Vector3d nearTopRight = nearCenter + upNearHeight2 + rightNearWidth2;
+  Vector3d nearBottomLeft = nearCenter - upNearHeight2 - rightNearWidth2;
+  Vector3d nearBottomRight = nearCenter - upNearHeight2 + rightNearWidth2;
+
+  // Compute the vertices of the far plane
+  Vector3d farTopLeft = farCenter + upFarHeight2 - rightFarWidth2;
+  Vector3d farTopRight = farCenter + upFarHeight2 + rightFarWidth2;
+  Vector3d farBottomLeft = farCenter - upFarHeight2 - rightFarWidth2;
+  Vector3d farBottomRight = farCenter - upFarHeight2 + rightFarWidth2;
+
+  // Save these vertices
+  _data.localPoints[0] = nearTopLeft;
+  _data.localPoints[1] = nearTopRight;
+  _data.localPoints[2] = nearBottomLeft;
+  _data.localPoints[3] = nearBottomRight;
+  _data.localPoints[4] = farTopLeft;
+  _data.localPoints[5] = farTopRight;
+  _data.localPoints[6] = farBottomLeft;
+  _data.localPoints[7] = farBottomRight;
+
+  Vector3d leftCenter =
+    (farTopLeft + nearTopLeft + farBottomLeft + nearBottomLeft) / 4.0;
+
+  Vector3d rightCenter =
+    (farTopRight + nearTopRight + farBottomRight + nearBottomRight) / 4.0;
+
+  Vector3d topCenter =
+    (farTopRight + nearTopRight + farTopLeft + nearTopLeft) / 4.0;
+
+  Vector3d bottomCenter =
+    (farBottomRight + nearBottomRight + farBottomLeft + nearBottomLeft) / 4.0;
+
+  // Compute plane offsets
+  // Set the planes, where the first value is the plane normal and the
+  // second the plane offset
+  auto &planes = _data.localPlanes;
+  Vector3d norm = Vector3d::Normal(nearTopLeft, nearTopRight, nearBottomLeft);
+  planes[Frustum::FRUSTUM_PLANE_NEAR].Set(norm, nearCenter.Dot(norm));
+
+  norm = Vector3d::Normal(farTopRight, farTopLeft, farBottomLeft);
+  planes[Frustum::FRUSTUM_PLANE_FAR].Set(norm, farCenter.Dot(norm));
+
+  norm = Vector3d::Normal(farTopLeft, nearTopLeft, nearBottomLeft);
+  planes[Frustum::FRUSTUM_PLANE_LEFT].Set(norm, leftCenter.Dot(norm));
+
+  norm = Vector3d::Normal(nearTopRight, farTopRight, farBottomRight);
+  planes[Frustum::FRUSTUM_PLANE_RIGHT].Set(norm, rightCenter.Dot(norm));
+
+  norm = Vector3d::Normal(nearTopLeft, farTopLeft, nearTopRight);
+  planes[Frustum::FRUSTUM_PLANE_TOP].Set(norm, topCenter.Dot(norm));
+
+  norm = Vector3d::Normal(nearBottomLeft, nearBottomRight, farBottomRight);
+  planes[Frustum::FRUSTUM_PLANE_BOTTOM].Set(norm, bottomCenter.Dot(norm));
+}
+
+/////////////////////////////////////////////////
+/// \brief Compute the planes and corners of a frustum in the world
+/// frame. Only the local geometry that changed is computed again, a
+/// change of pose is a rigid transform of the local planes and corners.
+/// \param[in,out] _data Private data of the frustum.
+void ComputeWorld(FrustumPrivate &_data)
+{
+  if (_data.localDirty)
+  {
+    ComputeLocal(_data);
+    _data.localDirty = false;
+  }
+
+  const Quaterniond &rot = _data.pose.Rot();
+  const Vector3d &pos = _data.pose.Pos();
+  for (std::size_t i = 0; i < _data.points.size(); ++i)
+    _data.points[i] = pos + rot.RotateVector(_data.localPoints[i]);
+
+  // The offset of a plane grows by the distance that the pose moves it
+  // along its normal
+  for (std::size_t i = 0; i < _data.planes.size(); ++i)
+  {
+    const Planed &local = _data.localPlanes[i];
+    const Vector3d norm = rot.RotateVector(local.Normal());
+    _data.planes[i].Set(norm, local.Offset() + pos.Dot(norm));
+  }
+}
+
+/////////////////////////////////////////////////
+/// \brief Get the private data of a frustum, after computing its
+/// geometry if a property changed.
+/// \param[in,out] _data Private data of the frustum.
+/// \return _data, with up to date planes and points.
+const FrustumPrivate &Geometry(FrustumPrivate &_data)
+{
+  if (_data.dirty.load(std::memory_order_acquire))
+  {
+    std::lock_guard<std::mutex> lock(_data.mutex);
+    if (_data.dirty.load(std::memory_order_relaxed))
+    {
+      ComputeWorld(_data);
+      _data.dirty.store(false, std::memory_order_release);
+    }
+  }
+  return _data;
+}
+}  // namespace
+
 /////////////////////////////////////////////////
 Frustum::Frustum()
   : dataPtr(new FrustumPrivate(0, 1, IGN_DTOR(45), 1, Pose3d::Zero))
@@ -38,9 +284,9 @@ Frustum::Frustum(const double _near,
                  const Pose3d &_pose)
   : dataPtr(new FrustumPrivate(_near, _far, _fov, _aspectRatio, _pose))
 {
-  // Compute plane based on near distance, far distance, field of view,
-  // aspect ratio, and pose
-  this->ComputePlanes();
+  // The planes based on near distance, far distance, field of view,
+  // aspect ratio, and pose are computed when they are first used
+  this->dataPtr->dirty = true;
 }
 
 /////////////////////////////////////////////////
@@ -55,14 +301,13 @@ Frustum::Frustum(const Frustum &_p)
   : dataPtr(new FrustumPrivate(_p.Near(), _p.Far(), _p.FOV(),
         _p.AspectRatio(), _p.Pose()))
 {
-  for (int i = 0; i < 6; ++i)
-    this->dataPtr->planes[i] = _p.dataPtr->planes[i];
+  this->dataPtr->Copy(Geometry(*_p.dataPtr));
 }
 
 /////////////////////////////////////////////////
 Planed Frustum::Plane(const FrustumPlane _plane) const
 {
-  return this->dataPtr->planes[_plane];
+  return Geometry(*this->dataPtr).planes[_plane];
 }
 
 /////////////////////////////////////////////////
@@ -71,8 +316,9 @@ bool Frustum::Contains(const AxisAlignedBox &_b) const
   // This is a fast test used for culling.
   // If the box is on the negative side of a plane, then the box is not
   // visible.
+  const FrustumPrivate &data = Geometry(*this->dataPtr);
   int overlapping = 0;
-  for (auto const &plane : this->dataPtr->planes)
+  for (auto const &plane : data.planes)
   {
     auto const sign = plane.Side(_b);
     if (sign == Planed::NEGATIVE_SIDE)
@@ -83,68 +329,7 @@ bool Frustum::Contains(const AxisAlignedBox &_b) const
 
   // it is possible to be outside of frustum and overlapping multiple planes
   if (overlapping >= 2)
-  {
-    // return true if any box point is inside the frustum
-    auto const &min = _b.Min();
-    auto const &max = _b.Max();
-    for (int p = 0; p < 8; ++p)
-    {
-      const double &x = (p & 4) ? min.X() : max.X();
-      const double &y = (p & 2) ? min.Y() : max.Y();
-      const double &z = (p & 1) ? min.Z() : max.Z();
-      if (this->Contains(Vector3d(x, y, z)))
-        return true;
-    }
-    // return true if any frustum point is inside the box
-    for (auto const &pt : this->dataPtr->points)
-    {
-      if (_b.Contains(pt))
-        return true;
-    }
-
-    // Return true if any edge of the frustum passes through the AABB
-    for (const auto &edge : this->dataPtr->edges)
-    {
-      // If the edge projected onto a world axis does not overlapp with the AABB
-      // then the edge could not be passing through the AABB.
-      if (edge.first.X() < min.X() && edge.second.X() < min.X())
-      {
-        // both frustum edge points are below AABB on x axis
-        continue;
-      }
-      else if (edge.first.X() > max.X() && edge.second.X() > max.X())
-      {
-        // both frustum edge points are above AABB on x axis
-        continue;
-      }
-      else if (edge.first.Y() < min.Y() && edge.second.Y() < min.Y())
-      {
-        // both frustum edge points are below AABB on y axis
-        continue;
-      }
-      else if (edge.first.Y() > max.Y() && edge.second.Y() > max.Y())
-      {
-        // both frustum edge points are above AABB on y axis
-        continue;
-      }
-      else if (edge.first.Z() < min.Z() && edge.second.Z() < min.Z())
-      {
-        // both frustum edge points are below AABB on z axis
-        continue;
-      }
-      else if (edge.first.Z() > max.Z() && edge.second.Z() > max.Z())
-      {
-        // both frustum edge points are above AABB on z axis
-        continue;
-      }
-      else
-      {
-        // TODO(anyone) prove or disprove that Frustum must penetrate AABB???
-        return true;
-      }
-    }
-    return false;
-  }
+    return Overlaps(data, _b.Min(), _b.Max());
 
   return true;
 }
@@ -154,13 +339,85 @@ bool Frustum::Contains(const Vector3d &_p) const
 {
   // If the point is on the negative side of a plane, then the point is not
   // visible.
-  for (auto const &plane : this->dataPtr->planes)
+  return PointInside(Geometry(*this->dataPtr), _p);
+}
+
+/////////////////////////////////////////////////
+std::size_t Frustum::Contains(const BoxPacket &_boxes,
+    std::vector<bool> &_visible) const
+{
+  std::vector<unsigned int> crossed;
+  return this->Contains(_boxes, 0x3f, _visible, crossed);
+}
+
+/////////////////////////////////////////////////
+std::size_t Frustum::Contains(const BoxPacket &_boxes,
+    const unsigned int _planes, std::vector<bool> &_visible,
+    std::vector<unsigned int> &_crossed) const
+{
+  const std::size_t n = _boxes.Size();
+  _visible.assign(n, true);
+  _crossed.assign(n, 0);
+  const FrustumPrivate &data = Geometry(*this->dataPtr);
+
+  // Only the planes of the mask are given to the kernel
+  double planes[24];
+  double bits[6];
+  std::size_t count = 0;
+  for (unsigned int p = 0; p < 6; ++p)
   {
-    if (plane.Side(_p) == Planed::NEGATIVE_SIDE)
-      return false;
+    if (!(_planes & (1u << p)))
+      continue;
+    const Planed &plane = data.planes[p];
+    planes[4 * count] = plane.Normal().X();
+    planes[4 * count + 1] = plane.Normal().Y();
+    planes[4 * count + 2] = plane.Normal().Z();
+    planes[4 * count + 3] = plane.Offset();
+    bits[count] = 1u << p;
+    ++count;
   }
+  if (count == 0)
+    return n;
+
+  const auto &kernels = simd::BatchKernels<double>();
+  const detail::ConstSoa3<double> min =
+    {_boxes.Min(0), _boxes.Min(1), _boxes.Min(2)};
+  const detail::ConstSoa3<double> max =
+    {_boxes.Max(0), _boxes.Max(1), _boxes.Max(2)};
+
+  std::size_t visibleCount = 0;
+  double codes[kChunkSize];
+  for (std::size_t first = 0; first < n; first += kChunkSize)
+  {
+    const std::size_t size = std::min(kChunkSize, n - first);
+    kernels.planesBox({min.x + first, min.y + first, min.z + first},
+        {max.x + first, max.y + first, max.z + first}, planes, bits, count,
+        codes, size);
 
-  return true;
+    for (std::size_t i = 0; i < size; ++i)
+    {
+      const std::size_t index = first + i;
+      if (codes[i] < 0)
+      {
+        _visible[index] = false;
+        continue;
+      }
+
+      // Same refinement as Contains(const AxisAlignedBox &) for the
+      // boxes that cross several planes
+      const unsigned int crossed = static_cast<unsigned int>(codes[i]);
+      if ((crossed & (crossed - 1)) && !Overlaps(data,
+            Vector3d(min.x[index], min.y[index], min.z[index]),
+            Vector3d(max.x[index], max.y[index], max.z[index])))
+      {
+        _visible[index] = false;
+        continue;
+      }
+      _crossed[index] = crossed;
+      ++visibleCount;
+    }
+  }
+  return visibleCount;
 }
 
 /////////////////////////////////////////////////
@@ -173,7 +430,8 @@ double Frustum::Near() const
 void Frustum::SetNear(const double _near)
 {
   this->dataPtr->near = _near;
-  this->ComputePlanes();
+  this->dataPtr->localDirty = true;
+  this->dataPtr->dirty = true;
 }
 
 /////////////////////////////////////////////////
@@ -186,7 +444,8 @@ double Frustum::Far() const
 void Frustum::SetFar(const double _far)
 {
   this->dataPtr->far = _far;
-  this->ComputePlanes();
+  this->dataPtr->localDirty = true;
+  this->dataPtr->dirty = true;
 }
 
 /////////////////////////////////////////////////
@@ -199,7 +458,8 @@ Angle Frustum::FOV() const
 void Frustum::SetFOV(const Angle &_angle)
 {
   this->dataPtr->fov = _angle;
-  this->ComputePlanes();
+  this->dataPtr->localDirty = true;
+  this->dataPtr->dirty = true;
 }
 
 /////////////////////////////////////////////////
@@ -212,7 +472,7 @@ Pose3d Frustum::Pose() const
 void Frustum::SetPose(const Pose3d &_pose)
 {
   this->dataPtr->pose = _pose;
-  this->ComputePlanes();
+  this->dataPtr->dirty = true;
 }
 
 /////////////////////////////////////////////////
@@ -225,125 +485,14 @@ double Frustum::AspectRatio() const
 void Frustum::SetAspectRatio(const double _aspectRatio)
 {
   this->dataPtr->aspectRatio = _aspectRatio;
-  this->ComputePlanes();
-}
-
-/////////////////////////////////////////////////
-void Frustum::ComputePlanes()
-{
-  // Tangent of half the field of view.
-  double tanFOV2 = std::tan(this->dataPtr->fov() * 0.5);
-
-  // Width of near plane
-  double nearWidth = 2.0 * tanFOV2 * this->dataPtr->near;
-
-  // Height of near plane
-  double nearHeight = nearWidth / this->dataPtr->aspectRatio;
-
-  // Width of far plane
-  double farWidth = 2.0 * tanFOV2 * this->dataPtr->far;
-
-  // Height of far plane
-  double farHeight = farWidth / this->dataPtr->aspectRatio;
-
-  // Up, right, and forward unit vectors.
-  Vector3d forward = this->dataPtr->pose.Rot().RotateVector(Vector3d::UnitX);
-  Vector3d up = this->dataPtr->pose.Rot().RotateVector(Vector3d::UnitZ);
-  Vector3d right = this->dataPtr->pose.Rot().RotateVector(-Vector3d::UnitY);
-
-  // Near plane center
-  Vector3d nearCenter = this->dataPtr->pose.Pos() + forward *
-    this->dataPtr->near;
-
-  // Far plane center
-  Vector3d farCenter = this->dataPtr->pose.Pos() + forward *
-    this->dataPtr->far;
-
-  // These four variables are here for convenience.
-  Vector3d upNearHeight2 = up * (nearHeight * 0.5);
-  Vector3d rightNearWidth2 = right * (nearWidth * 0.5);
-  Vector3d upFarHeight2 = up * (farHeight * 0.5);
-  Vector3d rightFarWidth2 = right * (farWidth * 0.5);
-
-  // Compute the vertices of the near plane
-  Vector3d nearTopLeft = nearCenter + upNearHeight2 - rightNearWidth2;
-  Vector3d nearTopRight = nearCenter + upNearHeight2 + rightNearWidth2;
-  Vector3d nearBottomLeft = nearCenter - upNearHeight2 - rightNearWidth2;
-  Vector3d nearBottomRight = nearCenter - upNearHeight2 + rightNearWidth2;
-
-  // Compute the vertices of the far plane
-  Vector3d farTopLeft = farCenter + upFarHeight2 - rightFarWidth2;
-  Vector3d farTopRight = farCenter + upFarHeight2 + rightFarWidth2;
-  Vector3d farBottomLeft = farCenter - upFarHeight2 - rightFarWidth2;
-  Vector3d farBottomRight = farCenter - upFarHeight2 + rightFarWidth2;
-
-  // Save these vertices
-  this->dataPtr->points[0] = nearTopLeft;
-  this->dataPtr->points[1] = nearTopRight;
-  this->dataPtr->points[2] = nearBottomLeft;
-  this->dataPtr->points[3] = nearBottomRight;
-  this->dataPtr->points[4] = farTopLeft;
-  this->dataPtr->points[5] = farTopRight;
-  this->dataPtr->points[6] = farBottomLeft;
-  this->dataPtr->points[7] = farBottomRight;
-
-  // Save the edges
-  this->dataPtr->edges[0] = {nearTopLeft, nearTopRight};
-  this->dataPtr->edges[1] = {nearTopLeft, nearBottomLeft};
-  this->dataPtr->edges[2] = {nearTopLeft, farTopLeft};
-  this->dataPtr->edges[3] = {nearTopRight, nearBottomRight};
-  this->dataPtr->edges[4] = {nearTopRight, farTopRight};
-  this->dataPtr->edges[5] = {nearBottomLeft, nearBottomRight};
-  this->dataPtr->edges[6] = {nearBottomLeft, farBottomLeft};
-  this->dataPtr->edges[7] = {farTopLeft, farTopRight};
-  this->dataPtr->edges[8] = {farTopLeft, farBottomLeft};
-  this->dataPtr->edges[9] = {farTopRight, farBottomRight};
-  this->dataPtr->edges[10] = {farBottomLeft, farBottomRight};
-  this->dataPtr->edges[11] = {farBottomRight, nearBottomRight};
-
-  Vector3d leftCenter =
-    (farTopLeft + nearTopLeft + farBottomLeft + nearBottomLeft) / 4.0;
-
-  Vector3d rightCenter =
-    (farTopRight + nearTopRight + farBottomRight + nearBottomRight) / 4.0;
-
-  Vector3d topCenter =
-    (farTopRight + nearTopRight + farTopLeft + nearTopLeft) / 4.0;
-
-  Vector3d bottomCenter =
-    (farBottomRight + nearBottomRight + farBottomLeft + nearBottomLeft) / 4.0;
-
-  // Compute plane offsets
-  // Set the planes, where the first value is the plane normal and the
-  // second the plane offset
-  Vector3d norm = Vector3d::Normal(nearTopLeft, nearTopRight, nearBottomLeft);
-  this->dataPtr->planes[FRUSTUM_PLANE_NEAR].Set(norm, nearCenter.Dot(norm));
-
-  norm = Vector3d::Normal(farTopRight, farTopLeft, farBottomLeft);
-  this->dataPtr->planes[FRUSTUM_PLANE_FAR].Set(norm, farCenter.Dot(norm));
-
-  norm = Vector3d::Normal(farTopLeft, nearTopLeft, nearBottomLeft);
-  this->dataPtr->planes[FRUSTUM_PLANE_LEFT].Set(norm, leftCenter.Dot(norm));
-
-  norm = Vector3d::Normal(nearTopRight, farTopRight, farBottomRight);
-  this->dataPtr->planes[FRUSTUM_PLANE_RIGHT].Set(norm, rightCenter.Dot(norm));
-
-  norm = Vector3d::Normal(nearTopLeft, farTopLeft, nearTopRight);
-  this->dataPtr->planes[FRUSTUM_PLANE_TOP].Set(norm, topCenter.Dot(norm));
-
-  norm = Vector3d::Normal(nearBottomLeft, nearBottomRight, farBottomRight);
-  this->dataPtr->planes[FRUSTUM_PLANE_BOTTOM].Set(norm, bottomCenter.Dot(norm));
+  this->dataPtr->localDirty = true;
+  this->dataPtr->dirty = true;
 }
 
 //////////////////////////////////////////////////
 Frustum &Frustum::operator =(const Frustum &_f)
 {
-  this->dataPtr->near = _f.dataPtr->near;
-  this->dataPtr->far = _f.dataPtr->far;
-  this->dataPtr->fov = _f.dataPtr->fov;
-  this->dataPtr->aspectRatio = _f.dataPtr->aspectRatio;
-  this->dataPtr->pose = _f.dataPtr->pose;
-  this->ComputePlanes();
+  this->dataPtr->Copy(Geometry(*_f.dataPtr));
 
   return *this;
 }
@@ -18,7 +18,8 @@
 #define IGNITION_MATH_FRUSTUMPRIVATE_HH_
 
 #include <array>
-#include <utility>
+#include <atomic>
+#include <mutex>
 #include <ignition/math/Pose3.hh>
 #include <ignition/math/Angle.hh>
 #include <ignition/math/Plane.hh>
@@ -56,6 +57,24 @@ namespace ignition
               {
               }
 
+      /// \brief Copy the properties and the geometry of another frustum.
+      /// \param[in] _data Private data of the other frustum. Its geometry
+      /// must be up to date.
+      public: void Copy(const FrustumPrivate &_data)
+              {
+                this->near = _data.near;
+                this->far = _data.far;
+                this->fov = _data.fov;
+                this->aspectRatio = _data.aspectRatio;
+                this->pose = _data.pose;
+                this->localPlanes = _data.localPlanes;
+                this->localPoints = _data.localPoints;
+                this->planes = _data.planes;
+                this->points = _data.points;
+                this->localDirty = _data.localDirty;
+                this->dirty = false;
+              }
+
       /// \brief Near distance
       public: double near;
 
@@ -79,8 +98,25 @@ namespace ignition
       /// \brief Each corner of the frustum.
       public: std::array<Vector3d, 8> points;
 
-      /// \brief each edge of the frustum.
-      public: std::array<std::pair<Vector3d, Vector3d>, 12> edges;
+      /// \brief Each plane of the frustum in the frame of the frustum,
+      /// which only depends on near, far, fov and aspectRatio.
+      public: std::array<Planed, 6> localPlanes;
+
+      /// \brief Each corner of the frustum in the frame of the frustum.
+      public: std::array<Vector3d, 8> localPoints;
+
+      /// \brief True if near, far, fov or aspectRatio changed since
+      /// localPlanes and localPoints were computed.
+      public: bool localDirty = true;
+
+      /// \brief True if planes and points must be computed before
+      /// they are used. The setters only set this flag, so that the
+      /// geometry is computed once when several properties change.
+      public: std::atomic<bool> dirty{false};
+
+      /// \brief Mutex that protects the computation of the geometry by
+      /// const functions called from several threads.
+      public: std::mutex mutex;
     };
     }
   }
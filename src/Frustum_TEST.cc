@@ -17,8 +17,11 @@
 
 #include <gtest/gtest.h>
 
+#include <vector>
+
 #include "ignition/math/Helpers.hh"
 #include "ignition/math/Frustum.hh"
+#include "ignition/math/Rand.hh"
 
 using namespace ignition;
 using namespace math;
@@ -659,3 +662,193 @@ TEST(FrustumTest, AABBBFWall)
   EXPECT_TRUE(frustum.Contains(
         AxisAlignedBox(Vector3d(-10, -10, 1.95), Vector3d(10, 10, 2.05))));
 }
+
+//////////////////////////////////////////////////
+TEST(FrustumTest, ContainsBoxPacket)
+{
+  Frustum frustum(0.5, 8, IGN_DTOR(60), 1.5,
+      Pose3d(1, -2, 0.5, 0.1, -0.2, 0.7));
+
+  // Random boxes around the frustum, with some that are larger than it
+  Rand::Seed(7);
+  BoxPacket boxes;
+  for (int i = 0; i < 2000; ++i)
+  {
+    const Vector3d center(Rand::DblUniform(-8, 12),
+        Rand::DblUniform(-10, 10), Rand::DblUniform(-10, 10));
+    const double size = i % 50 == 0 ? 20 : Rand::DblUniform(0, 2);
+    const Vector3d half(size * Rand::DblUniform(0.1, 1),
+        size * Rand::DblUniform(0.1, 1), size * Rand::DblUniform(0.1, 1));
+    boxes.PushBack(AxisAlignedBox(center - half, center + half));
+  }
+  // Flat box and point
+  boxes.PushBack(AxisAlignedBox(Vector3d(3, -1, -1), Vector3d(3, 1, 1)));
+  boxes.PushBack(AxisAlignedBox(Vector3d(4, -1, 0), Vector3d(4, -1, 0)));
+
+  std::vector<bool> visible;
+  const std::size_t count = frustum.Contains(boxes, visible);
+  ASSERT_EQ(visible.size(), boxes.Size());
+
+  std::size_t expectedCount = 0;
+  for (std::size_t i = 0; i < boxes.Size(); ++i)
+  {
+    const bool expected = frustum.Contains(boxes[i]);
+    EXPECT_EQ(visible[i], expected) << i;
+    if (expected)
+      ++expectedCount;
+  }
+  EXPECT_EQ(count, expectedCount);
+  EXPECT_GT(count, 100u);
+  EXPECT_LT(count, boxes.Size() - 100);
+
+  // No plane to test
+  std::vector<unsigned int> crossed;
+  EXPECT_EQ(frustum.Contains(boxes, 0, visible, crossed), boxes.Size());
+  EXPECT_EQ(crossed, std::vector<unsigned int>(boxes.Size(), 0));
+
+  BoxPacket empty;
+  EXPECT_EQ(frustum.Contains(empty, visible), 0u);
+  EXPECT_TRUE(visible.empty());
+}
+
+//////////////////////////////////////////////////
+TEST(FrustumTest, ContainsBoxPacketHierarchy)
+{
+  Frustum frustum(0.5, 8, IGN_DTOR(60), 1.5,
+      Pose3d(1, -2, 0.5, 0.1, -0.2, 0.7));
+
+  // Coarse cells, each split into 8 children
+  BoxPacket parents;
+  for (int x = -4; x < 6; ++x)
+  {
+    for (int y = -5; y < 5; ++y)
+    {
+      for (int z = -5; z < 5; ++z)
+      {
+        const Vector3d min(x * 2, y * 2, z * 2);
+        parents.PushBack(AxisAlignedBox(min, min + Vector3d(2, 2, 2)));
+      }
+    }
+  }
+
+  std::vector<bool> parentVisible;
+  std::vector<unsigned int> parentCrossed;
+  frustum.Contains(parents, 0x3f, parentVisible, parentCrossed);
+
+  int inside = 0;
+  int partial = 0;
+  for (std::size_t p = 0; p < parents.Size(); ++p)
+  {
+    EXPECT_EQ(parentVisible[p], frustum.Contains(parents[p]));
+    if (!parentVisible[p])
+    {
+      EXPECT_EQ(parentCrossed[p], 0u);
+      continue;
+    }
+
+    const AxisAlignedBox parent = parents[p];
+    BoxPacket children;
+    for (int c = 0; c < 8; ++c)
+    {
+      const Vector3d min(parent.Min().X() + (c & 1),
+          parent.Min().Y() + ((c >> 1) & 1), parent.Min().Z() + (c >> 2));
+      children.PushBack(AxisAlignedBox(min, min + Vector3d(1, 1, 1)));
+    }
+
+    // Only the planes crossed by the parent are tested for the children
+    std::vector<bool> visible;
+    std::vector<unsigned int> crossed;
+    frustum.Contains(children, parentCrossed[p], visible, crossed);
+    for (std::size_t c = 0; c < children.Size(); ++c)
+    {
+      EXPECT_EQ(visible[c], frustum.Contains(children[c]));
+      EXPECT_EQ(crossed[c] & ~parentCrossed[p], 0u);
+    }
+
+    if (parentCrossed[p] == 0)
+    {
+      ++inside;
+      EXPECT_EQ(crossed, std::vector<unsigned int>(8, 0));
+    }
+    else
+    {
+      ++partial;
+    }
+  }
+  EXPECT_GT(inside, 0);
+  EXPECT_GT(partial, 0);
+}
+
+//////////////////////////////////////////////////
+TEST(FrustumTest, PoseUpdate)
+{
+  Frustum frustum(0.3, 12, IGN_DTOR(70), 1.6);
+
+  // Move a frustum many times and compare it with a new one
+  Rand::Seed(3);
+  for (int i = 0; i < 50; ++i)
+  {
+    const Pose3d pose(Rand::DblUniform(-5, 5), Rand::DblUniform(-5, 5),
+        Rand::DblUniform(-5, 5), Rand::DblUniform(-IGN_PI, IGN_PI),
+        Rand::DblUniform(-1.5, 1.5), Rand::DblUniform(-IGN_PI, IGN_PI));
+    frustum.SetPose(pose);
+    const Frustum expected(0.3, 12, IGN_DTOR(70), 1.6, pose);
+
+    for (int p = 0; p < 6; ++p)
+    {
+      const auto plane = static_cast<Frustum::FrustumPlane>(p);
+      EXPECT_EQ(frustum.Plane(plane).Normal(),
+          expected.Plane(plane).Normal());
+      EXPECT_NEAR(frustum.Plane(plane).Offset(),
+          expected.Plane(plane).Offset(), 1e-9);
+    }
+
+    const Vector3d center = pose.Pos() +
+      pose.Rot().RotateVector(Vector3d(6, 0, 0));
+    EXPECT_TRUE(frustum.Contains(center));
+    EXPECT_FALSE(frustum.Contains(pose.Pos() -
+          pose.Rot().RotateVector(Vector3d(1, 0, 0))));
+    const AxisAlignedBox box(center - Vector3d(9, 9, 9),
+        center + Vector3d(-6, -6, -6));
+    EXPECT_EQ(frustum.Contains(box), expected.Contains(box));
+  }
+}
+
+//////////////////////////////////////////////////
+TEST(FrustumTest, DeferredUpdate)
+{
+  // Several properties change before the planes are used
+  Frustum frustum;
+  frustum.SetNear(0.55);
+  frustum.SetFar(2.5);
+  frustum.SetFOV(1.05);
+  frustum.SetAspectRatio(1.8);
+  frustum.SetPose(Pose3d(0, 0, 2, 0, 0, 0));
+  frustum.SetPose(Pose3d(1, 0, 2, 0, 0, 0));
+
+  const Frustum expected(0.55, 2.5, 1.05, 1.8, Pose3d(1, 0, 2, 0, 0, 0));
+  for (int p = 0; p < 6; ++p)
+  {
+    const auto plane = static_cast<Frustum::FrustumPlane>(p);
+    EXPECT_EQ(frustum.Plane(plane).Normal(), expected.Plane(plane).Normal());
+    EXPECT_NEAR(frustum.Plane(plane).Offset(),
+        expected.Plane(plane).Offset(), 1e-12);
+  }
+
+  // The intrinsics change after a pose change
+  frustum.SetFar(10);
+  EXPECT_TRUE(frustum.Contains(Vector3d(9, 0, 2)));
+  frustum.SetPose(Pose3d(0, 0, 2, 0, 0, IGN_PI));
+  EXPECT_FALSE(frustum.Contains(Vector3d(9, 0, 2)));
+  EXPECT_TRUE(frustum.Contains(Vector3d(-9, 0, 2)));
+
+  // Copies get the corners and edges that Contains uses for boxes that
+  // cross several planes
+  const Frustum copy(frustum);
+  Frustum assigned;
+  assigned = frustum;
+  const AxisAlignedBox box(Vector3d(-6, -10, 2.5), Vector3d(-5, 10, 3));
+  EXPECT_TRUE(frustum.Contains(box));
+  EXPECT_TRUE(copy.Contains(box));
+  EXPECT_TRUE(assigned.Contains(box));
+}
@@ -0,0 +1,458 @@
+/*
+ * Copyright (C) 2018 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <thread>
+#include <utility>
+
+#include "ignition/math/KdTree.hh"
+
+using namespace ignition;
+using namespace math;
+
+namespace
+{
+  /// \brief Largest number of points of a leaf
+  const std::size_t kLeafSize = 8;
+
+  /// \brief Smallest number of points of a subtree built in another
+  /// thread
+  const std::size_t kMinThreadPoints = 1 << 15;
+
+  /// \brief A point and its index, sorted together during the build
+  struct Entry
+  {
+    /// \brief Position
+    Vector3d point;
+
+    /// \brief Index in the input
+    std::size_t index;
+  };
+
+  //////////////////////////////////////////////////
+  /// \brief Get the entries of a set of points.
+  /// \param[in] _points The points, a std::vector or a Vector3View.
+  /// \param[in] _n Number of points.
+  /// \return The entries, in the order of the points.
+  template<typename Points>
+  std::vector<Entry> MakeEntries(const Points &_points, const std::size_t _n)
+  {
+    std::vector<Entry> entries(_n);
+    for (std::size_t i = 0; i < _n; ++i)
+    {
+      entries[i].point = _points[i];
+      entries[i].index = i;
+    }
+    return entries;
+  }
+
+  /// \brief Squared distance and index of a point found by a query
+  typedef std::pair<double, std::size_t> Candidate;
+
+  //////////////////////////////////////////////////
+  /// \brief Closest point found so far.
+  class ClosestResult
+  {
+    /// \brief Squared distance beyond which subtrees are skipped.
+    /// \return The squared distance.
+    public: double Bound() const
+    {
+      return this->best.first;
+    }
+
+    /// \brief Consider a point.
+    /// \param[in] _dist2 Squared distance of the point.
+    /// \param[in] _index Index of the point.
+    public: void Add(const double _dist2, const std::size_t _index)
+    {
+      // Also skips NaN
+      if (!(_dist2 <= this->best.first))
+        return;
+      const Candidate c(_dist2, _index);
+      if (c < this->best)
+        this->best = c;
+    }
+
+    /// \brief The closest point
+    public: Candidate best = {std::numeric_limits<double>::infinity(),
+                              std::numeric_limits<std::size_t>::max()};
+  };
+
+  //////////////////////////////////////////////////
+  /// \brief Closest points found so far, as a max-heap.
+  class NearestResult
+  {
+    /// \brief Constructor.
+    /// \param[in] _k Number of points to keep.
+    /// \param[in] _heap Storage of the heap, which is cleared.
+    public: NearestResult(const std::size_t _k,
+                std::vector<Candidate> &_heap)
+      : k(_k), heap(_heap)
+    {
+      this->heap.clear();
+      this->heap.reserve(_k);
+    }
+
+    /// \brief Squared distance beyond which subtrees are skipped.
+    /// \return The squared distance.
+    public: double Bound() const
+    {
+      return this->heap.size() < this->k ?
+          std::numeric_limits<double>::infinity() : this->heap.front().first;
+    }
+
+    /// \brief Consider a point.
+    /// \param[in] _dist2 Squared distance of the point.
+    /// \param[in] _index Index of the point.
+    public: void Add(const double _dist2, const std::size_t _index)
+    {
+      // Also skips NaN
+      if (!(_dist2 <= this->Bound()))
+        return;
+      const Candidate c(_dist2, _index);
+      if (this->heap.size() < this->k)
+      {
+        this->heap.push_back(c);
+        std::push_heap(this->heap.begin(), this->heap.end());
+      }
+      else if (c < this->heap.front())
+      {
+        std::pop_heap(this->heap.begin(), this->heap.end());
+        this->heap.back() = c;
+        std::push_heap(this->heap.begin(), this->heap.end());
+      }
+    }
+
+    /// \brief Number of points to keep
+    private: const std::size_t k;
+
+    /// \brief The heap
+    private: std::vector<Candidate> &heap;
+  };
+
+  //////////////////////////////////////////////////
+  /// \brief Points found within a radius.
+  class RadiusResult
+  {
+    /// \brief Constructor.
+    /// \param[in] _radius2 Squared radius.
+    /// \param[in] _indices Indices of the points found.
+    public: RadiusResult(const double _radius2,
+                std::vector<std::size_t> &_indices)
+      : radius2(_radius2), indices(_indices)
+    {
+    }
+
+    /// \brief Squared distance beyond which subtrees are skipped.
+    /// \return The squared distance.
+    public: double Bound() const
+    {
+      return this->radius2;
+    }
+
+    /// \brief Consider a point.
+    /// \param[in] _dist2 Squared distance of the point.
+    /// \param[in] _index Index of the point.
+    public: void Add(const double _dist2, const std::size_t _index)
+    {
+      if (_dist2 <= this->radius2)
+        this->indices.push_back(_index);
+    }
+
+    /// \brief Squared radius
+    private: const double radius2;
+
+    /// \brief Indices of the points found
+    private: std::vector<std::size_t> &indices;
+  };
+}  // namespace
+
+/// \brief Private data for KdTree
+class ignition::math::KdTreePrivate
+{
+  /// \brief Build the tree.
+  /// \param[in] _entries The points and their indices, reordered in tree
+  /// order.
+  /// \param[in] _threadCount Number of threads to use, 0 for the number
+  /// of hardware threads.
+  public: void Build(std::vector<Entry> &_entries,
+              const unsigned int _threadCount);
+
+  /// \brief Build the subtree of a range of entries.
+  /// \param[in,out] _entries The entries, reordered in tree order.
+  /// \param[in] _lo First entry of the range.
+  /// \param[in] _hi End of the range.
+  /// \param[in] _threadCount Number of threads to use.
+  public: void Build(std::vector<Entry> &_entries, const std::size_t _lo,
+              const std::size_t _hi, const unsigned int _threadCount);
+
+  /// \brief Search a subtree.
+  /// \param[in] _lo First point of the subtree.
+  /// \param[in] _hi End of the subtree.
+  /// \param[in] _point Position searched.
+  /// \param[in] _dist2 Squared distance from _point to the cell of the
+  /// subtree.
+  /// \param[in,out] _offsets Distance from _point to the cell of the
+  /// subtree along each axis.
+  /// \param[in] _scale Factor applied to the distance of a cell before it
+  /// is compared to the bound of the result, (1 + epsilon)^2.
+  /// \param[in,out] _result The result, which provides Bound() and Add().
+  public: template<typename Result>
+  void Search(const std::size_t _lo, const std::size_t _hi,
+              const Vector3d &_point, const double _dist2, double *_offsets,
+              const double _scale, Result &_result) const;
+
+  /// \brief Positions of the points, in tree order
+  public: std::vector<Vector3d> points;
+
+  /// \brief Index in the input of each element of points
+  public: std::vector<std::size_t> indices;
+
+  /// \brief Split axis of the node whose middle element is at this
+  /// position
+  public: std::vector<std::uint8_t> axes;
+};
+
+//////////////////////////////////////////////////
+void KdTreePrivate::Build(std::vector<Entry> &_entries,
+    const unsigned int _threadCount)
+{
+  unsigned int threadCount = _threadCount;
+  if (threadCount == 0)
+    threadCount = std::max(std::thread::hardware_concurrency(), 1u);
+
+  this->axes.assign(_entries.size(), 0);
+  this->Build(_entries, 0, _entries.size(), threadCount);
+
+  this->points.resize(_entries.size());
+  this->indices.resize(_entries.size());
+  for (std::size_t i = 0; i < _entries.size(); ++i)
+  {
+    this->points[i] = _entries[i].point;
+    this->indices[i] = _entries[i].index;
+  }
+}
+
+//////////////////////////////////////////////////
+void KdTreePrivate::Build(std::vector<Entry> &_entries,
+    const std::size_t _lo, const std::size_t _hi,
+    const unsigned int _threadCount)
+{
+  if (_hi - _lo <= kLeafSize)
+    return;
+
+  // Split along the axis of largest extent
+  Vector3d min = _entries[_lo].point;
+  Vector3d max = min;
+  for (std::size_t i = _lo + 1; i < _hi; ++i)
+  {
+    min.Min(_entries[i].point);
+    max.Max(_entries[i].point);
+  }
+  const Vector3d extent = max - min;
+  std::uint8_t axis = 0;
+  if (extent.Y() > extent[axis])
+    axis = 1;
+  if (extent.Z() > extent[axis])
+    axis = 2;
+
+  // The index breaks the ties, so that the tree does not depend on the
+  // implementation of std::nth_element. NaN is placed after the numbers,
+  // which keeps the order strict.
+  const std::size_t mid = _lo + (_hi - _lo) / 2;
+  std::nth_element(_entries.begin() + _lo, _entries.begin() + mid,
+      _entries.begin() + _hi, [axis](const Entry &_a, const Entry &_b)
+      {
+        const double a = _a.point[axis];
+        const double b = _b.point[axis];
+        if (a < b)
+          return true;
+        if (b < a)
+          return false;
+        if (std::isnan(a) != std::isnan(b))
+          return std::isnan(b);
+        return _a.index < _b.index;
+      });
+  this->axes[mid] = axis;
+
+  if (_threadCount > 1 && _hi - _lo >= 2 * kMinThreadPoints)
+  {
+    const unsigned int half = _threadCount / 2;
+    std::thread left([&]()
+    {
+      this->Build(_entries, _lo, mid, half);
+    });
+    this->Build(_entries, mid + 1, _hi, _threadCount - half);
+    left.join();
+  }
+  else
+  {
+    this->Build(_entries, _lo, mid, 1);
+    this->Build(_entries, mid + 1, _hi, 1);
+  }
+}
+
+//////////////////////////////////////////////////
+template<typename Result>
+void KdTreePrivate::Search(const std::size_t _lo, const std::size_t _hi,
+    const Vector3d &_point, const double _dist2, double *_offsets,
+    const double _scale, Result &_result) const
+{
+  if (_hi - _lo <= kLeafSize)
+  {
+    for (std::size_t i = _lo; i < _hi; ++i)
+    {
+      _result.Add((this->points[i] - _point).SquaredLength(),
+          this->indices[i]);
+    }
+    return;
+  }
+
+  const std::size_t mid = _lo + (_hi - _lo) / 2;
+  const Vector3d &p = this->points[mid];
+  _result.Add((p - _point).SquaredLength(), this->indices[mid]);
+
+  // The points of the left subtree are not above the middle point along
+  // the split axis, those of the right subtree are not below it
+  const int axis = this->axes[mid];
+  const double diff = _point[axis] - p[axis];
+  std::size_t nearLo = _lo, nearHi = mid, farLo = mid + 1, farHi = _hi;
+  if (diff >= 0)
+  {
+    std::swap(nearLo, farLo);
+    std::swap(nearHi, farHi);
+  }
+  this->Search(nearLo, nearHi, _point, _dist2, _offsets, _scale, _result);
+
+  // Distance to the cell of the far subtree, computed incrementally as in
+  // Arya and Mount, Algorithms for Fast Vector Quantization
+  const double old = _offsets[axis];
+  const double farDist2 = _dist2 - old * old + diff * diff;
+  if (farDist2 * _scale > _result.Bound())
+    return;
+
+  _offsets[axis] = diff;
+  this->Search(farLo, farHi, _point, farDist2, _offsets, _scale, _result);
+  _offsets[axis] = old;
+}
+
+//////////////////////////////////////////////////
+KdTree::KdTree()
+: dataPtr(new KdTreePrivate)
+{
+}
+
+//////////////////////////////////////////////////
+KdTree::KdTree(const std::vector<Vector3d> &_points)
+: dataPtr(new KdTreePrivate)
+{
+  this->Build(_points);
+}
+
+//////////////////////////////////////////////////
+KdTree::KdTree(const KdTree &_tree)
+: dataPtr(new KdTreePrivate(*_tree.dataPtr))
+{
+}
+
+//////////////////////////////////////////////////
+KdTree::~KdTree()
+{
+}
+
+//////////////////////////////////////////////////
+KdTree &KdTree::operator=(const KdTree &_tree)
+{
+  *this->dataPtr = *_tree.dataPtr;
+  return *this;
+}
+
+//////////////////////////////////////////////////
+void KdTree::Build(const std::vector<Vector3d> &_points,
+    const unsigned int _threadCount)
+{
+  std::vector<Entry> entries = MakeEntries(_points, _points.size());
+  this->dataPtr->Build(entries, _threadCount);
+}
+
+//////////////////////////////////////////////////
+void KdTree::Build(const Vector3View<double> &_points,
+    const unsigned int _threadCount)
+{
+  std::vector<Entry> entries = MakeEntries(_points, _points.Size());
+  this->dataPtr->Build(entries, _threadCount);
+}
+
+//////////////////////////////////////////////////
+std::size_t KdTree::Size() const
+{
+  return this->dataPtr->points.size();
+}
+
+//////////////////////////////////////////////////
+std::tuple<bool, double, std::size_t> KdTree::Closest(
+    const Vector3d &_point) const
+{
+  ClosestResult result;
+  double offsets[3] = {0, 0, 0};
+  this->dataPtr->Search(0, this->dataPtr->points.size(), _point, 0, offsets,
+      1, result);
+  if (result.best.second == std::numeric_limits<std::size_t>::max())
+    return std::make_tuple(false, 0.0, 0);
+  return std::make_tuple(true, std::sqrt(result.best.first),
+      result.best.second);
+}
+
+//////////////////////////////////////////////////
+bool KdTree::Nearest(const Vector3d &_point, const std::size_t _k,
+    std::vector<std::size_t> &_indices, const double _epsilon) const
+{
+  _indices.clear();
+  if (this->dataPtr->points.empty() || _k == 0)
+    return false;
+
+  std::vector<Candidate> heap;
+  NearestResult result(std::min(_k, this->dataPtr->points.size()), heap);
+  const double scale = (1 + std::max(_epsilon, 0.0)) *
+                       (1 + std::max(_epsilon, 0.0));
+  double offsets[3] = {0, 0, 0};
+  this->dataPtr->Search(0, this->dataPtr->points.size(), _point, 0, offsets,
+      scale, result);
+
+  std::sort_heap(heap.begin(), heap.end());
+  _indices.reserve(heap.size());
+  for (const Candidate &c : heap)
+    _indices.push_back(c.second);
+  return !_indices.empty();
+}
+
+//////////////////////////////////////////////////
+bool KdTree::InRadius(const Vector3d &_center, const double _radius,
+    std::vector<std::size_t> &_indices) const
+{
+  _indices.clear();
+  if (this->dataPtr->points.empty() || !(_radius >= 0))
+    return false;
+
+  RadiusResult result(_radius * _radius, _indices);
+  double offsets[3] = {0, 0, 0};
+  this->dataPtr->Search(0, this->dataPtr->points.size(), _center, 0,
+      offsets, 1, result);
+  return !_indices.empty();
+}
@@ -0,0 +1,285 @@
+/*
+ * Copyright (C) 2018 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "ignition/math/KdTree.hh"
+#include "ignition/math/Rand.hh"
+
+using namespace ignition;
+
+/////////////////////////////////////////////////
+/// \brief Random points in a cube of side 2 * _range.
+std::vector<math::Vector3d> RandomPoints(const std::size_t _n,
+    const double _range)
+{
+  std::vector<math::Vector3d> points;
+  for (std::size_t i = 0; i < _n; ++i)
+  {
+    points.push_back(math::Vector3d(math::Rand::DblUniform(-_range, _range),
+        math::Rand::DblUniform(-_range, _range),
+        math::Rand::DblUniform(-_range, _range)));
+  }
+  return points;
+}
+
+/////////////////////////////////////////////////
+/// \brief Find the closest points by testing every point.
+std::vector<std::size_t> BruteNearest(
+    const std::vector<math::Vector3d> &_points, const math::Vector3d &_point,
+    const std::size_t _k)
+{
+  std::vector<std::pair<double, std::size_t>> all;
+  for (std::size_t i = 0; i < _points.size(); ++i)
+    all.push_back(std::make_pair((_points[i] - _point).SquaredLength(), i));
+  std::sort(all.begin(), all.end());
+
+  std::vector<std::size_t> indices;
+  for (std::size_t i = 0; i < std::min(_k, all.size()); ++i)
+    indices.push_back(all[i].second);
+  return indices;
+}
+
+/////////////////////////////////////////////////
+/// \brief Check the queries of a tree against the brute force versions.
+void CheckQueries(const math::KdTree &_tree,
+    const std::vector<math::Vector3d> &_points,
+    const std::vector<math::Vector3d> &_queries)
+{
+  std::vector<std::size_t> indices;
+  for (const math::Vector3d &q : _queries)
+  {
+    for (const double radius : {0.0, 0.3, 1.0, 4.0, 100.0})
+    {
+      std::vector<std::size_t> expected;
+      for (std::size_t i = 0; i < _points.size(); ++i)
+      {
+        if ((_points[i] - q).SquaredLength() <= radius * radius)
+          expected.push_back(i);
+      }
+      EXPECT_EQ(!expected.empty(), _tree.InRadius(q, radius, indices));
+      std::sort(indices.begin(), indices.end());
+      EXPECT_EQ(expected, indices) << q << " " << radius;
+    }
+
+    for (const std::size_t k : {1u, 5u, 40u, 2000u})
+    {
+      EXPECT_TRUE(_tree.Nearest(q, k, indices));
+      EXPECT_EQ(BruteNearest(_points, q, k), indices) << q << " " << k;
+    }
+
+    const auto closest = _tree.Closest(q);
+    const std::size_t expected = BruteNearest(_points, q, 1)[0];
+    EXPECT_TRUE(std::get<0>(closest));
+    EXPECT_DOUBLE_EQ(_points[expected].Distance(q), std::get<1>(closest));
+    EXPECT_EQ(expected, std::get<2>(closest));
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(KdTreeTest, Empty)
+{
+  math::KdTree tree;
+  EXPECT_EQ(0u, tree.Size());
+  EXPECT_FALSE(std::get<0>(tree.Closest(math::Vector3d::Zero)));
+
+  std::vector<std::size_t> indices = {1, 2};
+  EXPECT_FALSE(tree.Nearest(math::Vector3d::Zero, 3, indices));
+  EXPECT_TRUE(indices.empty());
+  indices = {1, 2};
+  EXPECT_FALSE(tree.InRadius(math::Vector3d::Zero, 10, indices));
+  EXPECT_TRUE(indices.empty());
+
+  tree.Build(std::vector<math::Vector3d>(), 4);
+  EXPECT_EQ(0u, tree.Size());
+}
+
+/////////////////////////////////////////////////
+TEST(KdTreeTest, Small)
+{
+  const std::vector<math::Vector3d> points = {
+    math::Vector3d(0, 0, 0), math::Vector3d(1, 0, 0),
+    math::Vector3d(0, 3, 0)};
+  const math::KdTree tree(points);
+  EXPECT_EQ(3u, tree.Size());
+
+  const auto closest = tree.Closest(math::Vector3d(0.9, 0.1, 0));
+  EXPECT_TRUE(std::get<0>(closest));
+  EXPECT_NEAR(std::sqrt(0.02), std::get<1>(closest), 1e-12);
+  EXPECT_EQ(1u, std::get<2>(closest));
+
+  std::vector<std::size_t> indices;
+  EXPECT_TRUE(tree.Nearest(math::Vector3d(0, 2, 0), 2, indices));
+  EXPECT_EQ(std::vector<std::size_t>({2, 0}), indices);
+  EXPECT_FALSE(tree.Nearest(math::Vector3d(0, 2, 0), 0, indices));
+  EXPECT_FALSE(tree.InRadius(math::Vector3d(5, 5, 5), 1, indices));
+  EXPECT_FALSE(tree.InRadius(math::Vector3d(0, 0, 0), -1, indices));
+}
+
+/////////////////////////////////////////////////
+TEST(KdTreeTest, Queries)
+{
+  math::Rand::Seed(7);
+  const std::vector<math::Vector3d> points = RandomPoints(1000, 5);
+  std::vector<math::Vector3d> queries = RandomPoints(20, 6);
+  queries.push_back(points[3]);
+  queries.push_back(math::Vector3d(1000, -500, 20));
+
+  const math::KdTree tree(points);
+  CheckQueries(tree, points, queries);
+}
+
+/////////////////////////////////////////////////
+TEST(KdTreeTest, Degenerate)
+{
+  // Points on a plane and on a line, and duplicated points
+  math::Rand::Seed(3);
+  std::vector<math::Vector3d> points;
+  for (const math::Vector3d &p : RandomPoints(300, 2))
+    points.push_back(math::Vector3d(p.X(), p.Y(), 1));
+  for (int i = 0; i < 100; ++i)
+    points.push_back(math::Vector3d(0.5 * (i % 10), 0, 0));
+
+  const math::KdTree tree(points);
+  CheckQueries(tree, points, {math::Vector3d(0, 0, 0),
+      math::Vector3d(1, 1, 1), math::Vector3d(2, 0, 0.1)});
+
+  // Ties are sorted by index
+  std::vector<std::size_t> indices;
+  EXPECT_TRUE(tree.Nearest(math::Vector3d(2, 0, 0), 3, indices));
+  EXPECT_EQ(std::vector<std::size_t>({304, 314, 324}), indices);
+}
+
+/////////////////////////////////////////////////
+TEST(KdTreeTest, Threads)
+{
+  math::Rand::Seed(5);
+  // Enough points for the subtrees to be built in other threads
+  const std::vector<math::Vector3d> points = RandomPoints(100000, 10);
+  const std::vector<math::Vector3d> queries = RandomPoints(20, 11);
+
+  math::KdTree serial;
+  serial.Build(points);
+  math::KdTree parallel;
+  parallel.Build(points, 4);
+  std::vector<double> buffer;
+  for (const math::Vector3d &p : points)
+    buffer.insert(buffer.end(), {p.X(), p.Y(), p.Z()});
+  math::KdTree hardware;
+  hardware.Build(math::Vector3Viewd(buffer.data(), points.size()), 0);
+  EXPECT_EQ(points.size(), parallel.Size());
+
+  // The trees are the same, even in the order of the radius results
+  std::vector<std::size_t> a, b, c;
+  for (const math::Vector3d &q : queries)
+  {
+    serial.InRadius(q, 1.5, a);
+    parallel.InRadius(q, 1.5, b);
+    hardware.InRadius(q, 1.5, c);
+    EXPECT_EQ(a, b);
+    EXPECT_EQ(a, c);
+
+    serial.Nearest(q, 10, a);
+    parallel.Nearest(q, 10, b);
+    EXPECT_EQ(a, b);
+  }
+  EXPECT_EQ(BruteNearest(points, queries.back(), 10), b);
+}
+
+/////////////////////////////////////////////////
+TEST(KdTreeTest, Approximate)
+{
+  math::Rand::Seed(9);
+  const std::vector<math::Vector3d> points = RandomPoints(5000, 10);
+  const math::KdTree tree(points);
+
+  const double epsilon = 0.5;
+  std::vector<std::size_t> indices;
+  for (const math::Vector3d &q : RandomPoints(50, 10))
+  {
+    const std::vector<std::size_t> exact = BruteNearest(points, q, 8);
+    EXPECT_TRUE(tree.Nearest(q, 8, indices, epsilon));
+    ASSERT_EQ(exact.size(), indices.size());
+    for (std::size_t i = 0; i < exact.size(); ++i)
+    {
+      EXPECT_LE(points[indices[i]].Distance(q),
+          (1 + epsilon) * points[exact[i]].Distance(q) + 1e-12);
+    }
+
+    // A negative tolerance is the exact search
+    EXPECT_TRUE(tree.Nearest(q, 8, indices, -1));
+    EXPECT_EQ(exact, indices);
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(KdTreeTest, NaN)
+{
+  const double nan = std::nan("");
+  std::vector<math::Vector3d> points = {
+    math::Vector3d(nan, 0, 0), math::Vector3d(0, 1, 0),
+    math::Vector3d(0, nan, nan), math::Vector3d(0, 0, 2)};
+  for (const math::Vector3d &p : RandomPoints(40, 5))
+    points.push_back(p + math::Vector3d(20, 0, 0));
+  points.push_back(math::Vector3d(nan, nan, nan));
+
+  const math::KdTree tree(points);
+  const auto closest = tree.Closest(math::Vector3d::Zero);
+  EXPECT_TRUE(std::get<0>(closest));
+  EXPECT_EQ(1u, std::get<2>(closest));
+
+  std::vector<std::size_t> indices;
+  EXPECT_TRUE(tree.Nearest(math::Vector3d::Zero, 2, indices));
+  EXPECT_EQ(std::vector<std::size_t>({1, 3}), indices);
+  EXPECT_TRUE(tree.Nearest(math::Vector3d::Zero, 100, indices));
+  EXPECT_EQ(points.size() - 3, indices.size());
+  EXPECT_TRUE(tree.InRadius(math::Vector3d::Zero, 1e6, indices));
+  EXPECT_EQ(points.size() - 3, indices.size());
+
+  // Nothing is found from a NaN position
+  EXPECT_FALSE(std::get<0>(tree.Closest(math::Vector3d(nan, 0, 0))));
+  EXPECT_FALSE(tree.Nearest(math::Vector3d(0, nan, 0), 2, indices));
+  EXPECT_TRUE(indices.empty());
+
+  // Same rule as SpatialHashGrid: infinite distances come last
+  const double inf = std::numeric_limits<double>::infinity();
+  const math::KdTree small({math::Vector3d::Zero, math::Vector3d(nan, 0, 0),
+      math::Vector3d(inf, 0, 0), math::Vector3d(1, 1, 1)});
+  EXPECT_TRUE(small.Nearest(math::Vector3d::Zero, 4, indices));
+  EXPECT_EQ(std::vector<std::size_t>({0, 3, 2}), indices);
+}
+
+/////////////////////////////////////////////////
+TEST(KdTreeTest, Copy)
+{
+  math::Rand::Seed(11);
+  const std::vector<math::Vector3d> points = RandomPoints(100, 1);
+  math::KdTree tree(points);
+  math::KdTree copy(tree);
+  tree.Build(std::vector<math::Vector3d>());
+  EXPECT_EQ(100u, copy.Size());
+  CheckQueries(copy, points, RandomPoints(3, 1));
+  tree = copy;
+  EXPECT_EQ(100u, tree.Size());
+}
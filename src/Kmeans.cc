@@ -16,6 +16,8 @@
 */
 
 #include <iostream>
+#include <tuple>
+#include <ignition/math/KdTree.hh>
 #include <ignition/math/Kmeans.hh>
 #include <ignition/math/Rand.hh>
 #include "KmeansPrivate.hh"
@@ -23,6 +25,10 @@
 using namespace ignition;
 using namespace math;
 
+/// \brief Number of clusters from which the closest centroids are found
+/// with a k-d tree.
+static const int kKdTreeClusters = 64;
+
 //////////////////////////////////////////////////
 Kmeans::Kmeans(const std::vector<Vector3d> &_obs)
 : dataPtr(new KmeansPrivate)
@@ -30,6 +36,13 @@ Kmeans::Kmeans(const std::vector<Vector3d> &_obs)
   this->Observations(_obs);
 }
 
+//////////////////////////////////////////////////
+Kmeans::Kmeans(const Vector3View<double> &_obs)
+: dataPtr(new KmeansPrivate)
+{
+  this->Observations(_obs);
+}
+
 //////////////////////////////////////////////////
 Kmeans::~Kmeans()
 {
@@ -56,6 +69,19 @@ bool Kmeans::Observations(const std::vector<Vector3d> &_obs)
   return true;
 }
 
+//////////////////////////////////////////////////
+bool Kmeans::Observations(const Vector3View<double> &_obs)
+{
+  if (_obs.Empty())
+  {
+    std::cerr << "Kmeans::SetObservations() error: Observations view is empty"
+              << std::endl;
+    return false;
+  }
+  this->dataPtr->obs.clear();
+  return this->AppendObservations(_obs);
+}
+
 //////////////////////////////////////////////////
 bool Kmeans::AppendObservations(const std::vector<Vector3d> &_obs)
 {
@@ -69,6 +95,21 @@ bool Kmeans::AppendObservations(const std::vector<Vector3d> &_obs)
   return true;
 }
 
+//////////////////////////////////////////////////
+bool Kmeans::AppendObservations(const Vector3View<double> &_obs)
+{
+  if (_obs.Empty())
+  {
+    std::cerr << "Kmeans::AppendObservations() error: input view is empty"
+              << std::endl;
+    return false;
+  }
+  this->dataPtr->obs.reserve(this->dataPtr->obs.size() + _obs.Size());
+  for (std::size_t i = 0; i < _obs.Size(); ++i)
+    this->dataPtr->obs.push_back(_obs[i]);
+  return true;
+}
+
 //////////////////////////////////////////////////
 bool Kmeans::Cluster(int _k,
                      std::vector<Vector3d> &_centroids,
@@ -127,10 +168,26 @@ bool Kmeans::Cluster(int _k,
     }
     changed = 0;
 
+    // With many clusters, a tree of the centroids avoids testing each of
+    // them. It returns the same centroid as ClosestCentroid().
+    KdTree tree;
+    if (_k >= kKdTreeClusters)
+      tree.Build(this->dataPtr->centroids);
+
     for (auto i = 0u; i < this->dataPtr->obs.size(); ++i)
     {
       // Update the labels containing the closest centroid for each point.
-      auto label = this->ClosestCentroid(this->dataPtr->obs[i]);
+      unsigned int label = 0;
+      if (_k >= kKdTreeClusters)
+      {
+        const auto closest = tree.Closest(this->dataPtr->obs[i]);
+        if (std::get<0>(closest))
+          label = static_cast<unsigned int>(std::get<2>(closest));
+      }
+      else
+      {
+        label = this->ClosestCentroid(this->dataPtr->obs[i]);
+      }
       if (this->dataPtr->labels[i] != label)
       {
         this->dataPtr->labels[i] = label;
@@ -140,3 +140,78 @@ TEST(KmeansTest, Append)
   std::vector<math::Vector3d> emptyVector;
   EXPECT_FALSE(kmeans.AppendObservations(emptyVector));
 }
+
+//////////////////////////////////////////////////
+TEST(KmeansTest, View)
+{
+  // Observations with an extra value after each point
+  const double data[] =
+  {
+    1.0, 1.0, 0.0, -1,
+    1.1, 1.0, 0.0, -1,
+    1.2, 1.0, 0.0, -1,
+    5.0, 1.0, 0.0, -1,
+    5.1, 1.0, 0.0, -1,
+    5.2, 1.0, 0.0, -1
+  };
+
+  math::Kmeans kmeans(math::Vector3Viewd(data, 3, 4));
+  std::vector<math::Vector3d> obs = kmeans.Observations();
+  ASSERT_EQ(3u, obs.size());
+  EXPECT_EQ(math::Vector3d(1.2, 1.0, 0.0), obs[2]);
+
+  EXPECT_TRUE(kmeans.AppendObservations(
+        math::Vector3Viewd(data + 12, 3, 4)));
+  obs = kmeans.Observations();
+  ASSERT_EQ(6u, obs.size());
+  EXPECT_EQ(math::Vector3d(5.0, 1.0, 0.0), obs[3]);
+
+  std::vector<math::Vector3d> centroids;
+  std::vector<unsigned int> labels;
+  EXPECT_TRUE(kmeans.Cluster(2, centroids, labels));
+  ASSERT_EQ(2u, centroids.size());
+  EXPECT_EQ(labels[0], labels[2]);
+  EXPECT_NE(labels[0], labels[3]);
+
+  EXPECT_TRUE(kmeans.Observations(math::Vector3Viewd(data, 2, 4)));
+  EXPECT_EQ(2u, kmeans.Observations().size());
+
+  // Empty views are rejected
+  EXPECT_FALSE(kmeans.Observations(math::Vector3Viewd()));
+  EXPECT_FALSE(kmeans.AppendObservations(math::Vector3Viewd()));
+  EXPECT_EQ(2u, kmeans.Observations().size());
+}
+
+//////////////////////////////////////////////////
+TEST(KmeansTest, ManyClusters)
+{
+  // Blobs on a 4x4x4 lattice, with one point of each blob first so that
+  // the initial centroids are in different blobs. This many clusters use
+  // a tree of the centroids.
+  const int blobCount = 64;
+  std::vector<math::Vector3d> centers;
+  for (int i = 0; i < blobCount; ++i)
+    centers.push_back(math::Vector3d(i % 4, (i / 4) % 4, i / 16) * 10);
+
+  std::vector<math::Vector3d> obs;
+  for (int j = 0; j < 5; ++j)
+  {
+    for (int i = 0; i < blobCount; ++i)
+    {
+      obs.push_back(centers[i] + math::Vector3d(0.1 * j, -0.2 * j,
+            0.05 * (j % 2)));
+    }
+  }
+
+  math::Kmeans kmeans(obs);
+  std::vector<math::Vector3d> centroids;
+  std::vector<unsigned int> labels;
+  EXPECT_TRUE(kmeans.Cluster(blobCount, centroids, labels));
+  ASSERT_EQ(static_cast<std::size_t>(blobCount), centroids.size());
+  ASSERT_EQ(obs.size(), labels.size());
+  for (std::size_t i = 0; i < obs.size(); ++i)
+  {
+    EXPECT_EQ(i % blobCount, labels[i]);
+    EXPECT_LT(centroids[labels[i]].Distance(centers[i % blobCount]), 1.0);
+  }
+}
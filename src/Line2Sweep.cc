@@ -0,0 +1,505 @@
+/*
+ * Copyright (C) 2018 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <set>
+#include <unordered_set>
+
+#include "ignition/math/Line2Sweep.hh"
+
+using namespace ignition;
+using namespace math;
+
+namespace
+{
+  /// \brief Distance, relative to the largest coordinate, below which two
+  /// points are merged
+  const double kTolerance = 1e-10;
+
+  /// \brief Id of the sweep point in the comparisons of the status
+  const uint32_t kProbe = std::numeric_limits<uint32_t>::max();
+
+  /// \brief A point of the sweep, compared by x then y
+  struct Point
+  {
+    /// \brief X coordinate
+    double x;
+
+    /// \brief Y coordinate
+    double y;
+  };
+
+  //////////////////////////////////////////////////
+  /// \brief Check if a point comes before another one in the sweep.
+  /// \param[in] _a First point.
+  /// \param[in] _b Second point.
+  /// \return True if _a has a smaller x, or the same x and a smaller y.
+  bool Before(const Point &_a, const Point &_b)
+  {
+    return _a.x < _b.x || (!(_b.x < _a.x) && _a.y < _b.y);
+  }
+
+  //////////////////////////////////////////////////
+  /// \brief Check if two points are identical.
+  /// \param[in] _a First point.
+  /// \param[in] _b Second point.
+  /// \return True if the coordinates are equal.
+  bool Same(const Point &_a, const Point &_b)
+  {
+    return !Before(_a, _b) && !Before(_b, _a);
+  }
+
+  /// \brief Order of the points in the event queue
+  struct PointLess
+  {
+    bool operator()(const Point &_a, const Point &_b) const
+    {
+      return Before(_a, _b);
+    }
+  };
+}  // namespace
+
+// Private data for Line2Sweep class
+class ignition::math::Line2SweepPrivate
+{
+  /// \brief Order of the segments along the sweep line, just after the
+  /// sweep point
+  public: struct StatusLess
+  {
+    /// \brief Compare two segments, or a segment and the sweep point.
+    /// \param[in] _a First id.
+    /// \param[in] _b Second id.
+    /// \return True if _a is below _b.
+    bool operator()(const uint32_t _a, const uint32_t _b) const
+    {
+      return this->sweep->Below(_a, _b);
+    }
+
+    /// \brief The sweep
+    const Line2SweepPrivate *sweep;
+  };
+
+  /// \brief Segments crossed by the sweep line, from bottom to top
+  public: typedef std::set<uint32_t, StatusLess> Status;
+
+  /// \brief Run the sweep.
+  /// \param[in] _lines The segments.
+  /// \param[out] _pairs Intersecting pairs.
+  /// \param[out] _shared Shared parts.
+  public: void Run(const std::vector<Line2d> &_lines,
+              std::vector<std::pair<std::size_t, std::size_t>> &_pairs,
+              std::vector<Line2d> &_shared);
+
+  /// \brief Get the y coordinate of a segment on the sweep line. A
+  /// vertical segment gives the y of the sweep point, clamped to the
+  /// segment.
+  /// \param[in] _id Id of the segment, or kProbe for the sweep point.
+  /// \return The y coordinate.
+  public: double YAt(const uint32_t _id) const;
+
+  /// \brief Compare two segments on the sweep line. Segments closer than
+  /// the tolerance are ordered as they are just after the sweep point, by
+  /// slope, then by id. The sweep point comes before the segments that go
+  /// through it.
+  /// \param[in] _a First id.
+  /// \param[in] _b Second id.
+  /// \return True if _a is below _b.
+  public: bool Below(const uint32_t _a, const uint32_t _b) const;
+
+  /// \brief Check if a segment goes through the sweep point.
+  /// \param[in] _id Id of the segment.
+  /// \return True if the segment is closer than the tolerance.
+  public: bool Through(const uint32_t _id) const;
+
+  /// \brief Add the crossing of two neighbor segments to the events if it
+  /// comes after the sweep point.
+  /// \param[in] _a Lower segment.
+  /// \param[in] _b Upper segment.
+  public: void Check(const uint32_t _a, const uint32_t _b);
+
+  /// \brief Report an intersection, unless the pair was reported already.
+  /// \param[in] _a First segment.
+  /// \param[in] _b Second segment.
+  /// \param[in] _p Intersection point.
+  public: void Report(const uint32_t _a, const uint32_t _b, const Point &_p);
+
+  /// \brief Left end point of each segment, the one with the smallest x,
+  /// then y
+  public: std::vector<Point> left;
+
+  /// \brief Right end point of each segment
+  public: std::vector<Point> right;
+
+  /// \brief Segments sorted by left end point
+  public: std::vector<uint32_t> byLeft;
+
+  /// \brief Segments sorted by right end point
+  public: std::vector<uint32_t> byRight;
+
+  /// \brief Crossings found ahead of the sweep point
+  public: std::set<Point, PointLess> crossings;
+
+  /// \brief Reported pairs, as the smallest id times 2^32 plus the other
+  /// id
+  public: std::unordered_set<uint64_t> reported;
+
+  /// \brief Segments that go through the event point
+  public: std::vector<uint32_t> group;
+
+  /// \brief Current event point
+  public: Point sweep = {0, 0};
+
+  /// \brief Distance below which points are merged
+  public: double tolerance = 0;
+
+  /// \brief Output pairs of the current run
+  public: std::vector<std::pair<std::size_t, std::size_t>> *pairs = nullptr;
+
+  /// \brief Output shared parts of the current run
+  public: std::vector<Line2d> *shared = nullptr;
+};
+
+//////////////////////////////////////////////////
+double Line2SweepPrivate::YAt(const uint32_t _id) const
+{
+  if (_id == kProbe)
+    return this->sweep.y;
+
+  const Point &l = this->left[_id];
+  const Point &r = this->right[_id];
+  if (!(l.x < r.x))
+    return std::min(std::max(this->sweep.y, l.y), r.y);
+  if (this->sweep.x <= l.x)
+    return l.y;
+  if (this->sweep.x >= r.x)
+    return r.y;
+  return l.y + (this->sweep.x - l.x) * (r.y - l.y) / (r.x - l.x);
+}
+
+//////////////////////////////////////////////////
+bool Line2SweepPrivate::Below(const uint32_t _a, const uint32_t _b) const
+{
+  if (_a == _b)
+    return false;
+
+  const double ya = this->YAt(_a);
+  const double yb = this->YAt(_b);
+  if (ya < yb - this->tolerance)
+    return true;
+  if (ya > yb + this->tolerance)
+    return false;
+
+  if (_a == kProbe)
+    return true;
+  if (_b == kProbe)
+    return false;
+
+  // Compare the slopes without dividing, the x extents are not negative.
+  // Vertical segments come last.
+  const double dxa = this->right[_a].x - this->left[_a].x;
+  const double dya = this->right[_a].y - this->left[_a].y;
+  const double dxb = this->right[_b].x - this->left[_b].x;
+  const double dyb = this->right[_b].y - this->left[_b].y;
+  const double lhs = dya * dxb;
+  const double rhs = dyb * dxa;
+  if (lhs < rhs)
+    return true;
+  if (rhs < lhs)
+    return false;
+  return _a < _b;
+}
+
+//////////////////////////////////////////////////
+bool Line2SweepPrivate::Through(const uint32_t _id) const
+{
+  return std::abs(this->YAt(_id) - this->sweep.y) <= this->tolerance;
+}
+
+//////////////////////////////////////////////////
+void Line2SweepPrivate::Check(const uint32_t _a, const uint32_t _b)
+{
+  const Point &la = this->left[_a];
+  const Point &lb = this->left[_b];
+  const double dxa = this->right[_a].x - la.x;
+  const double dya = this->right[_a].y - la.y;
+  const double dxb = this->right[_b].x - lb.x;
+  const double dyb = this->right[_b].y - lb.y;
+
+  // Parallel segments only share a part if they are collinear, which is
+  // found at the first end point of the overlap
+  const double denom = dxa * dyb - dya * dxb;
+  if (!(denom < 0) && !(denom > 0))
+    return;
+
+  const double rx = lb.x - la.x;
+  const double ry = lb.y - la.y;
+  const double t = (rx * dyb - ry * dxb) / denom;
+  const double u = (rx * dya - ry * dxa) / denom;
+  const double tolA = this->tolerance / std::sqrt(dxa * dxa + dya * dya);
+  const double tolB = this->tolerance / std::sqrt(dxb * dxb + dyb * dyb);
+  if (t < -tolA || t > 1 + tolA || u < -tolB || u > 1 + tolB)
+    return;
+
+  // Crossings at an end point are moved to the end point, so that they
+  // are the same event
+  Point p;
+  if (std::abs(u) <= tolB)
+    p = lb;
+  else if (std::abs(u - 1) <= tolB)
+    p = this->right[_b];
+  else if (std::abs(t) <= tolA)
+    p = la;
+  else if (std::abs(t - 1) <= tolA)
+    p = this->right[_a];
+  else
+    p = {la.x + t * dxa, la.y + t * dya};
+
+  if (Before(this->sweep, p))
+  {
+    this->crossings.insert(p);
+  }
+  else
+  {
+    // A crossing computed behind the sweep point was missed by the
+    // grouping. It is still reported, at its computed position.
+    this->Report(_a, _b, p);
+  }
+}
+
+//////////////////////////////////////////////////
+void Line2SweepPrivate::Report(const uint32_t _a, const uint32_t _b,
+    const Point &_p)
+{
+  const uint32_t a = std::min(_a, _b);
+  const uint32_t b = std::max(_a, _b);
+  if (!this->reported.insert((static_cast<uint64_t>(a) << 32) | b).second)
+    return;
+
+  this->pairs->push_back(std::make_pair(a, b));
+
+  // The overlap of collinear segments goes from the last left end point
+  // to the first right end point
+  Point start = _p;
+  Point end = _p;
+  const Point &la = this->left[a];
+  const Point &ra = this->right[a];
+  const Point &lb = this->left[b];
+  const Point &rb = this->right[b];
+  const double dxa = ra.x - la.x;
+  const double dya = ra.y - la.y;
+  const double length = std::sqrt(dxa * dxa + dya * dya);
+  if (length > 0 && !Same(lb, rb) &&
+      std::abs(dxa * (lb.y - la.y) - dya * (lb.x - la.x)) <=
+        this->tolerance * length &&
+      std::abs(dxa * (rb.y - la.y) - dya * (rb.x - la.x)) <=
+        this->tolerance * length)
+  {
+    const Point &first = Before(la, lb) ? lb : la;
+    const Point &last = Before(ra, rb) ? ra : rb;
+    if (Before(first, last))
+    {
+      start = first;
+      end = last;
+    }
+  }
+  this->shared->push_back(
+      Line2d(Vector2d(start.x, start.y), Vector2d(end.x, end.y)));
+}
+
+//////////////////////////////////////////////////
+void Line2SweepPrivate::Run(const std::vector<Line2d> &_lines,
+    std::vector<std::pair<std::size_t, std::size_t>> &_pairs,
+    std::vector<Line2d> &_shared)
+{
+  _pairs.clear();
+  _shared.clear();
+  this->pairs = &_pairs;
+  this->shared = &_shared;
+
+  const uint32_t n = static_cast<uint32_t>(_lines.size());
+  this->left.resize(n);
+  this->right.resize(n);
+  double largest = 0;
+  for (uint32_t i = 0; i < n; ++i)
+  {
+    Point a = {_lines[i][0].X(), _lines[i][0].Y()};
+    Point b = {_lines[i][1].X(), _lines[i][1].Y()};
+    if (Before(b, a))
+      std::swap(a, b);
+    this->left[i] = a;
+    this->right[i] = b;
+    largest = std::max(largest, std::max(std::max(std::abs(a.x),
+        std::abs(a.y)), std::max(std::abs(b.x), std::abs(b.y))));
+  }
+  this->tolerance = kTolerance * largest;
+
+  this->byLeft.resize(n);
+  this->byRight.resize(n);
+  for (uint32_t i = 0; i < n; ++i)
+  {
+    this->byLeft[i] = i;
+    this->byRight[i] = i;
+  }
+  std::sort(this->byLeft.begin(), this->byLeft.end(),
+      [this](const uint32_t _a, const uint32_t _b)
+      {
+        return Before(this->left[_a], this->left[_b]);
+      });
+  std::sort(this->byRight.begin(), this->byRight.end(),
+      [this](const uint32_t _a, const uint32_t _b)
+      {
+        return Before(this->right[_a], this->right[_b]);
+      });
+
+  this->crossings.clear();
+  this->reported.clear();
+  Status status(StatusLess{this});
+  std::size_t nextLeft = 0;
+  std::size_t nextRight = 0;
+  while (true)
+  {
+    // The next event is the first of the next left end point, the next
+    // right end point and the next crossing
+    bool found = false;
+    Point p = {0, 0};
+    auto consider = [&](const Point &_q)
+    {
+      if (!found || Before(_q, p))
+        p = _q;
+      found = true;
+    };
+    if (nextLeft < n)
+      consider(this->left[this->byLeft[nextLeft]]);
+    if (nextRight < n)
+      consider(this->right[this->byRight[nextRight]]);
+    if (!this->crossings.empty())
+      consider(*this->crossings.begin());
+    if (!found)
+      break;
+
+    this->sweep = p;
+    if (!this->crossings.empty() && Same(*this->crossings.begin(), p))
+      this->crossings.erase(this->crossings.begin());
+    while (nextRight < n && Same(this->right[this->byRight[nextRight]], p))
+      ++nextRight;
+
+    // Remove the segments that go through the event point, they are next
+    // to each other in the status
+    this->group.clear();
+    auto first = status.lower_bound(kProbe);
+    while (first != status.begin() && this->Through(*std::prev(first)))
+      --first;
+    auto last = first;
+    while (last != status.end() && this->Through(*last))
+      ++last;
+    this->group.insert(this->group.end(), first, last);
+    status.erase(first, last);
+
+    // Segments that start at the event point
+    while (nextLeft < n && Same(this->left[this->byLeft[nextLeft]], p))
+      this->group.push_back(this->byLeft[nextLeft++]);
+
+    for (std::size_t i = 0; i < this->group.size(); ++i)
+    {
+      for (std::size_t j = i + 1; j < this->group.size(); ++j)
+        this->Report(this->group[i], this->group[j], p);
+    }
+
+    // Put back the segments that continue after the event point, in their
+    // order just after it. Those that end at the event point, including
+    // the segments of zero length, are only reported.
+    std::size_t inserted = 0;
+    for (std::size_t i = 0; i < this->group.size(); ++i)
+    {
+      const uint32_t id = this->group[i];
+      if (!Same(this->right[id], p))
+      {
+        status.insert(id);
+        ++inserted;
+      }
+    }
+
+    // Check the new neighbors
+    auto lower = status.lower_bound(kProbe);
+    if (inserted == 0)
+    {
+      if (lower != status.begin() && lower != status.end())
+        this->Check(*std::prev(lower), *lower);
+      continue;
+    }
+    auto upper = lower;
+    std::advance(upper, inserted - 1);
+    if (lower != status.begin())
+      this->Check(*std::prev(lower), *lower);
+    if (std::next(upper) != status.end())
+      this->Check(*upper, *std::next(upper));
+  }
+
+  this->pairs = nullptr;
+  this->shared = nullptr;
+}
+
+//////////////////////////////////////////////////
+Line2Sweep::Line2Sweep()
+: dataPtr(new Line2SweepPrivate)
+{
+}
+
+//////////////////////////////////////////////////
+Line2Sweep::Line2Sweep(const Line2Sweep &_sweep)
+: dataPtr(new Line2SweepPrivate(*_sweep.dataPtr))
+{
+}
+
+//////////////////////////////////////////////////
+Line2Sweep::~Line2Sweep()
+{
+}
+
+//////////////////////////////////////////////////
+Line2Sweep &Line2Sweep::operator=(const Line2Sweep &_sweep)
+{
+  *this->dataPtr = *_sweep.dataPtr;
+  return *this;
+}
+
+//////////////////////////////////////////////////
+bool Line2Sweep::Intersect(const std::vector<Line2d> &_lines,
+    std::vector<std::pair<std::size_t, std::size_t>> &_pairs,
+    std::vector<Line2d> &_shared)
+{
+  this->dataPtr->Run(_lines, _pairs, _shared);
+  return !_pairs.empty();
+}
+
+//////////////////////////////////////////////////
+bool Line2Sweep::Intersect(const std::vector<Line2d> &_lines,
+    std::vector<std::pair<std::size_t, std::size_t>> &_pairs,
+    std::vector<Vector2d> &_points)
+{
+  std::vector<Line2d> shared;
+  this->dataPtr->Run(_lines, _pairs, shared);
+  _points.clear();
+  _points.reserve(shared.size());
+  for (const auto &line : shared)
+    _points.push_back(line[0]);
+  return !_pairs.empty();
+}
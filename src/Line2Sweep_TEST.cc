@@ -0,0 +1,316 @@
+/*
+ * Copyright (C) 2018 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <set>
+#include <utility>
+#include <vector>
+
+#include "ignition/math/Helpers.hh"
+#include "ignition/math/Line2Sweep.hh"
+#include "ignition/math/Rand.hh"
+
+using namespace ignition;
+
+/// \brief A pair of indices
+typedef std::pair<std::size_t, std::size_t> IndexPair;
+
+/////////////////////////////////////////////////
+/// \brief Side of a point relative to a line, exact for small integers.
+/// \return 1 on the left, -1 on the right, 0 if collinear.
+int Orientation(const math::Vector2d &_a, const math::Vector2d &_b,
+    const math::Vector2d &_c)
+{
+  const double cross = (_b.X() - _a.X()) * (_c.Y() - _a.Y()) -
+    (_b.Y() - _a.Y()) * (_c.X() - _a.X());
+  return (cross > 0) - (cross < 0);
+}
+
+/////////////////////////////////////////////////
+/// \brief Check if a point collinear with a segment lies on it.
+bool InBox(const math::Line2d &_line, const math::Vector2d &_p)
+{
+  return _p.X() >= std::min(_line[0].X(), _line[1].X()) &&
+    _p.X() <= std::max(_line[0].X(), _line[1].X()) &&
+    _p.Y() >= std::min(_line[0].Y(), _line[1].Y()) &&
+    _p.Y() <= std::max(_line[0].Y(), _line[1].Y());
+}
+
+/////////////////////////////////////////////////
+/// \brief Check if two segments share a point, with orientation tests.
+bool Touch(const math::Line2d &_a, const math::Line2d &_b)
+{
+  const int o1 = Orientation(_a[0], _a[1], _b[0]);
+  const int o2 = Orientation(_a[0], _a[1], _b[1]);
+  const int o3 = Orientation(_b[0], _b[1], _a[0]);
+  const int o4 = Orientation(_b[0], _b[1], _a[1]);
+  if (o1 * o2 < 0 && o3 * o4 < 0)
+    return true;
+  return (o1 == 0 && InBox(_a, _b[0])) || (o2 == 0 && InBox(_a, _b[1])) ||
+    (o3 == 0 && InBox(_b, _a[0])) || (o4 == 0 && InBox(_b, _a[1]));
+}
+
+/////////////////////////////////////////////////
+/// \brief Intersecting pairs, found by testing all the pairs.
+std::set<IndexPair> BrutePairs(const std::vector<math::Line2d> &_lines)
+{
+  std::set<IndexPair> pairs;
+  for (std::size_t i = 0; i < _lines.size(); ++i)
+  {
+    for (std::size_t j = i + 1; j < _lines.size(); ++j)
+    {
+      if (Touch(_lines[i], _lines[j]))
+        pairs.insert(IndexPair(i, j));
+    }
+  }
+  return pairs;
+}
+
+/////////////////////////////////////////////////
+TEST(Line2SweepTest, Empty)
+{
+  math::Line2Sweep sweep;
+  std::vector<IndexPair> pairs = {{1, 2}};
+  std::vector<math::Line2d> shared = {math::Line2d(0, 0, 1, 1)};
+  EXPECT_FALSE(sweep.Intersect({}, pairs, shared));
+  EXPECT_TRUE(pairs.empty());
+  EXPECT_TRUE(shared.empty());
+
+  EXPECT_FALSE(sweep.Intersect({math::Line2d(0, 0, 1, 1)}, pairs, shared));
+  EXPECT_FALSE(sweep.Intersect(
+        {math::Line2d(0, 0, 1, 1), math::Line2d(0, 1, 1, 2)}, pairs, shared));
+}
+
+/////////////////////////////////////////////////
+TEST(Line2SweepTest, Intersect)
+{
+  const std::vector<math::Line2d> lines = {
+    // Crossing
+    math::Line2d(0, 0, 2, 2),
+    math::Line2d(0, 2, 2, 0),
+    // Ends on the first segment
+    math::Line2d(1.5, 1.5, 3, 0),
+    // Shares an end point with the second segment
+    math::Line2d(2, 0, 4, 1),
+    // Parallel to the first segment
+    math::Line2d(1, 0, 3, 2),
+    // Zero length, on the fourth segment
+    math::Line2d(3, 0.5, 3, 0.5),
+    // Vertical, through the crossing of the first two segments
+    math::Line2d(1, -1, 1, 5)};
+
+  math::Line2Sweep sweep;
+  std::vector<IndexPair> pairs;
+  std::vector<math::Line2d> shared;
+  EXPECT_TRUE(sweep.Intersect(lines, pairs, shared));
+  ASSERT_EQ(pairs.size(), shared.size());
+
+  const std::set<IndexPair> expected = BrutePairs(lines);
+  EXPECT_EQ(expected, std::set<IndexPair>(pairs.begin(), pairs.end()));
+  EXPECT_EQ(expected.size(), pairs.size());
+  for (std::size_t k = 0; k < pairs.size(); ++k)
+  {
+    EXPECT_LT(pairs[k].first, pairs[k].second);
+    EXPECT_EQ(shared[k][0], shared[k][1]);
+    EXPECT_TRUE(lines[pairs[k].first].Within(shared[k][0]));
+    EXPECT_TRUE(lines[pairs[k].second].Within(shared[k][0]));
+  }
+
+  std::vector<math::Vector2d> points;
+  EXPECT_TRUE(sweep.Intersect(lines, pairs, points));
+  ASSERT_EQ(pairs.size(), points.size());
+  for (std::size_t k = 0; k < pairs.size(); ++k)
+  {
+    if (pairs[k] == IndexPair(0, 1) || pairs[k] == IndexPair(0, 6))
+    {
+      EXPECT_EQ(math::Vector2d(1, 1), points[k]);
+    }
+    else if (pairs[k] == IndexPair(0, 2))
+    {
+      EXPECT_EQ(math::Vector2d(1.5, 1.5), points[k]);
+    }
+    else if (pairs[k] == IndexPair(1, 3))
+    {
+      EXPECT_EQ(math::Vector2d(2, 0), points[k]);
+    }
+    else if (pairs[k] == IndexPair(3, 5))
+    {
+      EXPECT_EQ(math::Vector2d(3, 0.5), points[k]);
+    }
+  }
+
+  // A copy gives the same results
+  math::Line2Sweep copy(sweep);
+  std::vector<IndexPair> copyPairs;
+  EXPECT_TRUE(copy.Intersect(lines, copyPairs, points));
+  EXPECT_EQ(pairs, copyPairs);
+  math::Line2Sweep assigned;
+  assigned = sweep;
+  EXPECT_TRUE(assigned.Intersect(lines, copyPairs, points));
+  EXPECT_EQ(pairs, copyPairs);
+}
+
+/////////////////////////////////////////////////
+TEST(Line2SweepTest, Collinear)
+{
+  const std::vector<math::Line2d> lines = {
+    math::Line2d(0, 0, 2, 2),
+    math::Line2d(3, 3, 1, 1),
+    math::Line2d(3, 3, 5, 5),
+    math::Line2d(6, 6, 7, 7),
+    math::Line2d(0, 0, 7, 7),
+    // Vertical segments
+    math::Line2d(8, 0, 8, 2),
+    math::Line2d(8, 1, 8, 3),
+    math::Line2d(8, 3, 8, 4)};
+
+  math::Line2Sweep sweep;
+  std::vector<IndexPair> pairs;
+  std::vector<math::Line2d> shared;
+  EXPECT_TRUE(sweep.Intersect(lines, pairs, shared));
+
+  std::set<std::pair<IndexPair, std::vector<double>>> results;
+  for (std::size_t k = 0; k < pairs.size(); ++k)
+  {
+    results.insert(std::make_pair(pairs[k], std::vector<double>({
+          shared[k][0].X(), shared[k][0].Y(),
+          shared[k][1].X(), shared[k][1].Y()})));
+  }
+  const std::set<std::pair<IndexPair, std::vector<double>>> expected = {
+    {{0, 1}, {1, 1, 2, 2}},
+    {{0, 4}, {0, 0, 2, 2}},
+    {{1, 2}, {3, 3, 3, 3}},
+    {{1, 4}, {1, 1, 3, 3}},
+    {{2, 4}, {3, 3, 5, 5}},
+    {{3, 4}, {6, 6, 7, 7}},
+    {{5, 6}, {8, 1, 8, 2}},
+    {{6, 7}, {8, 3, 8, 3}}};
+  EXPECT_EQ(expected, results);
+  EXPECT_EQ(expected.size(), pairs.size());
+}
+
+/////////////////////////////////////////////////
+TEST(Line2SweepTest, CommonPoint)
+{
+  // Segments through the same point, and a grid of horizontal and
+  // vertical segments
+  std::vector<math::Line2d> lines;
+  for (int i = 0; i < 8; ++i)
+  {
+    const double angle = IGN_PI * i / 8;
+    lines.push_back(math::Line2d(-std::cos(angle), -std::sin(angle),
+          std::cos(angle), std::sin(angle)));
+  }
+  for (int i = 0; i < 10; ++i)
+  {
+    lines.push_back(math::Line2d(10 + i, 0, 10 + i, 9));
+    lines.push_back(math::Line2d(10, i, 19, i));
+  }
+
+  math::Line2Sweep sweep;
+  std::vector<IndexPair> pairs;
+  std::vector<math::Vector2d> points;
+  EXPECT_TRUE(sweep.Intersect(lines, pairs, points));
+  EXPECT_EQ(28u + 100u, pairs.size());
+  EXPECT_EQ(28u + 100u,
+      std::set<IndexPair>(pairs.begin(), pairs.end()).size());
+  for (std::size_t k = 0; k < pairs.size(); ++k)
+  {
+    if (pairs[k].second < 8)
+    {
+      EXPECT_NEAR(0, points[k].X(), 1e-12);
+      EXPECT_NEAR(0, points[k].Y(), 1e-12);
+    }
+    else
+    {
+      EXPECT_EQ(points[k], math::Vector2d(std::round(points[k].X()),
+            std::round(points[k].Y())));
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(Line2SweepTest, RandomIntegers)
+{
+  // Small integer coordinates give many shared end points, collinear
+  // overlaps, vertical and zero length segments
+  math::Rand::Seed(3);
+  math::Line2Sweep sweep;
+  for (int trial = 0; trial < 20; ++trial)
+  {
+    std::vector<math::Line2d> lines;
+    for (int i = 0; i < 150; ++i)
+    {
+      const int x = math::Rand::IntUniform(0, 12);
+      const int y = math::Rand::IntUniform(0, 12);
+      const int kind = math::Rand::IntUniform(0, 3);
+      const int dx = kind == 0 ? 0 : math::Rand::IntUniform(-4, 4);
+      const int dy = kind == 1 ? 0 : math::Rand::IntUniform(-4, 4);
+      lines.push_back(math::Line2d(x, y, x + dx, y + dy));
+    }
+
+    std::vector<IndexPair> pairs;
+    std::vector<math::Line2d> shared;
+    sweep.Intersect(lines, pairs, shared);
+    const std::set<IndexPair> expected = BrutePairs(lines);
+    EXPECT_EQ(expected, std::set<IndexPair>(pairs.begin(), pairs.end()));
+    EXPECT_EQ(expected.size(), pairs.size());
+    for (std::size_t k = 0; k < pairs.size(); ++k)
+    {
+      for (int e = 0; e < 2; ++e)
+      {
+        EXPECT_TRUE(lines[pairs[k].first].Within(shared[k][e], 1e-9));
+        EXPECT_TRUE(lines[pairs[k].second].Within(shared[k][e], 1e-9));
+      }
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(Line2SweepTest, Random)
+{
+  math::Rand::Seed(4);
+  std::vector<math::Line2d> lines;
+  for (int i = 0; i < 1000; ++i)
+  {
+    const math::Vector2d p(math::Rand::DblUniform(-100, 100),
+        math::Rand::DblUniform(-100, 100));
+    const math::Vector2d d(math::Rand::DblUniform(-10, 10),
+        math::Rand::DblUniform(-10, 10));
+    lines.push_back(math::Line2d(p, p + d));
+  }
+
+  math::Line2Sweep sweep;
+  std::vector<IndexPair> pairs;
+  std::vector<math::Vector2d> points;
+  EXPECT_TRUE(sweep.Intersect(lines, pairs, points));
+  const std::set<IndexPair> expected = BrutePairs(lines);
+  EXPECT_GT(expected.size(), 100u);
+  EXPECT_EQ(expected, std::set<IndexPair>(pairs.begin(), pairs.end()));
+  EXPECT_EQ(expected.size(), pairs.size());
+
+  for (std::size_t k = 0; k < pairs.size(); ++k)
+  {
+    math::Vector2d point;
+    EXPECT_TRUE(lines[pairs[k].first].Intersect(lines[pairs[k].second],
+          point));
+    EXPECT_NEAR(point.X(), points[k].X(), 1e-9);
+    EXPECT_NEAR(point.Y(), points[k].Y(), 1e-9);
+  }
+}
@@ -17,8 +17,11 @@
 
 #include <gtest/gtest.h>
 
+#include <vector>
+
 #include "ignition/math/Line3.hh"
 #include "ignition/math/Helpers.hh"
+#include "ignition/math/Rand.hh"
 
 using namespace ignition;
 
@@ -230,6 +233,272 @@ TEST(Line3Test, Distance)
   EXPECT_FALSE(line.Distance(math::Line3d(2, 0, 0, 2, 1, 0), result));
 }
 
+/////////////////////////////////////////////////
+/// \brief Closest points of pairs of segments with Line3::ClosestPoints.
+/// \param[in] _a First segments.
+/// \param[in] _b Second segments.
+/// \param[out] _pointsA Closest points on the first segments.
+/// \param[out] _pointsB Closest points on the second segments.
+/// \param[out] _sqDist Squared distances.
+template<typename T>
+void BatchClosestPoints(const std::vector<math::Line3<T>> &_a,
+    const std::vector<math::Line3<T>> &_b,
+    std::vector<math::Vector3<T>> &_pointsA,
+    std::vector<math::Vector3<T>> &_pointsB, std::vector<T> &_sqDist)
+{
+  math::Vector3Array<T> startA, endA, startB, endB;
+  for (std::size_t i = 0; i < _a.size(); ++i)
+  {
+    startA.PushBack(_a[i][0]);
+    endA.PushBack(_a[i][1]);
+    startB.PushBack(_b[i][0]);
+    endB.PushBack(_b[i][1]);
+  }
+  math::Vector3Array<T> outA, outB;
+  EXPECT_TRUE(math::Line3<T>::ClosestPoints(
+        startA, endA, startB, endB, outA, outB, _sqDist));
+  outA.ToVector(_pointsA);
+  outB.ToVector(_pointsB);
+}
+
+/////////////////////////////////////////////////
+/// \brief Squared distance between two segments, as the minimum over the
+/// critical point inside both segments, if any, and the four distances
+/// between an end point and the other segment.
+double ReferenceSqDistance(const math::Line3d &_a, const math::Line3d &_b)
+{
+  auto pointSegment = [](const math::Vector3d &_p, const math::Line3d &_l)
+  {
+    const math::Vector3d d = _l[1] - _l[0];
+    const double t = d.SquaredLength() > 0 ?
+      math::clamp((_p - _l[0]).Dot(d) / d.SquaredLength(), 0.0, 1.0) : 0.0;
+    return (_l[0] + d * t - _p).SquaredLength();
+  };
+
+  double best = std::min(
+      std::min(pointSegment(_a[0], _b), pointSegment(_a[1], _b)),
+      std::min(pointSegment(_b[0], _a), pointSegment(_b[1], _a)));
+
+  const math::Vector3d d1 = _a[1] - _a[0];
+  const math::Vector3d d2 = _b[1] - _b[0];
+  const math::Vector3d r = _a[0] - _b[0];
+  const double a = d1.Dot(d1);
+  const double b = d1.Dot(d2);
+  const double e = d2.Dot(d2);
+  const double denom = a * e - b * b;
+  if (denom > 1e-9 * a * e)
+  {
+    const double s = (b * d2.Dot(r) - d1.Dot(r) * e) / denom;
+    const double t = (b * s + d2.Dot(r)) / e;
+    if (s >= 0 && s <= 1 && t >= 0 && t <= 1)
+      best = std::min(best, (_a[0] + d1 * s - _b[0] - d2 * t).SquaredLength());
+  }
+  return best;
+}
+
+/////////////////////////////////////////////////
+TEST(Line3Test, ClosestPoints)
+{
+  math::Rand::Seed(11);
+  std::vector<math::Line3d> linesA, linesB;
+  for (int i = 0; i < 2000; ++i)
+  {
+    math::Vector3d p[4];
+    for (auto &v : p)
+    {
+      v.Set(math::Rand::DblUniform(-5, 5), math::Rand::DblUniform(-5, 5),
+          math::Rand::DblUniform(-5, 5));
+    }
+    linesA.push_back(math::Line3d(p[0], p[1]));
+    linesB.push_back(math::Line3d(p[2], p[3]));
+  }
+  // Crossing, touching and collinear segments
+  linesA.push_back(math::Line3d(0, 0, 0, 0, 1, 0));
+  linesB.push_back(math::Line3d(1, 0.5, 0, -1, 0.5, 0));
+  linesA.push_back(math::Line3d(0, 0, 0, 0, 1, 0));
+  linesB.push_back(math::Line3d(0, 1, 0, 3, 4, 5));
+  linesA.push_back(math::Line3d(0, 0, 0, 2, 0, 0));
+  linesB.push_back(math::Line3d(3, 0, 0, 5, 0, 0));
+
+  std::vector<math::Vector3d> pointsA, pointsB;
+  std::vector<double> sqDist;
+  BatchClosestPoints(linesA, linesB, pointsA, pointsB, sqDist);
+  ASSERT_EQ(linesA.size(), sqDist.size());
+
+  int interior = 0;
+  for (std::size_t i = 0; i < linesA.size(); ++i)
+  {
+    EXPECT_NEAR(ReferenceSqDistance(linesA[i], linesB[i]), sqDist[i], 1e-9);
+    EXPECT_NEAR((pointsA[i] - pointsB[i]).SquaredLength(), sqDist[i], 1e-12);
+    EXPECT_TRUE(linesA[i].Within(pointsA[i], 1e-12));
+    EXPECT_TRUE(linesB[i].Within(pointsB[i], 1e-12));
+
+    // Never farther than the scalar routine, and the same points when
+    // they are inside both segments
+    math::Line3d result;
+    EXPECT_TRUE(linesA[i].Distance(linesB[i], result));
+    EXPECT_LE(sqDist[i], result.Length() * result.Length() + 1e-9);
+    if (result[0] != linesA[i][0] && result[0] != linesA[i][1] &&
+        result[1] != linesB[i][0] && result[1] != linesB[i][1])
+    {
+      ++interior;
+      EXPECT_NEAR(result[0].Distance(pointsA[i]), 0, 1e-9);
+      EXPECT_NEAR(result[1].Distance(pointsB[i]), 0, 1e-9);
+    }
+  }
+  EXPECT_GT(interior, 100);
+
+  EXPECT_DOUBLE_EQ(0, sqDist[2000]);
+  EXPECT_EQ(math::Vector3d(0, 0.5, 0), pointsA[2000]);
+  EXPECT_EQ(math::Vector3d(0, 0.5, 0), pointsB[2000]);
+  EXPECT_DOUBLE_EQ(0, sqDist[2001]);
+  EXPECT_EQ(math::Vector3d(0, 1, 0), pointsA[2001]);
+  EXPECT_DOUBLE_EQ(1, sqDist[2002]);
+  EXPECT_EQ(math::Vector3d(2, 0, 0), pointsA[2002]);
+  EXPECT_EQ(math::Vector3d(3, 0, 0), pointsB[2002]);
+
+  // Mismatched sizes
+  math::Vector3Arrayd one(1), two(2), outA, outB;
+  EXPECT_FALSE(math::Line3d::ClosestPoints(
+        one, one, one, two, outA, outB, sqDist));
+  EXPECT_EQ(linesA.size(), sqDist.size());
+  EXPECT_TRUE(outA.Empty());
+
+  // Empty sets
+  EXPECT_TRUE(math::Line3d::ClosestPoints(
+        outA, outA, outA, outA, outA, outB, sqDist));
+  EXPECT_TRUE(sqDist.empty());
+}
+
+/////////////////////////////////////////////////
+TEST(Line3Test, ClosestPointsParallel)
+{
+  // Pairs of segments of length 10 at distance 1, with the second one
+  // turned by a small angle around its center
+  std::vector<math::Line3d> linesA, linesB;
+  const std::vector<double> angles = {0, 1e-12, 1e-9, 1e-6, 1e-3};
+  for (const double angle : angles)
+  {
+    const math::Vector3d half(5 * std::cos(angle), 5 * std::sin(angle), 0);
+    // Overlapping, crossing above the center of the first segment
+    linesA.push_back(math::Line3d(0, 0, 0, 10, 0, 0));
+    linesB.push_back(math::Line3d(
+          math::Vector3d(5, 0, 1) - half, math::Vector3d(5, 0, 1) + half));
+    // Overlapping, side by side in the same plane
+    linesA.push_back(math::Line3d(0, 0, 0, 10, 0, 0));
+    linesB.push_back(math::Line3d(
+          math::Vector3d(8, 1, 0) - half, math::Vector3d(8, 1, 0) + half));
+    // End to end, with a gap of 2
+    linesA.push_back(math::Line3d(0, 0, 0, 10, 0, 0));
+    linesB.push_back(math::Line3d(
+          math::Vector3d(17, 0, 0) - half, math::Vector3d(17, 0, 0) + half));
+    // The same segment in both directions
+    linesA.push_back(math::Line3d(0, 0, 0, 10, 0, 0));
+    linesB.push_back(math::Line3d(
+          math::Vector3d(5, 0, 0) + half, math::Vector3d(5, 0, 0) - half));
+  }
+
+  std::vector<math::Vector3d> pointsA, pointsB;
+  std::vector<double> sqDist;
+  BatchClosestPoints(linesA, linesB, pointsA, pointsB, sqDist);
+  for (std::size_t k = 0; k < angles.size(); ++k)
+  {
+    const double angle = angles[k];
+    const double c = std::cos(angle);
+    const double s = std::sin(angle);
+    const std::size_t i = k * 4;
+    EXPECT_NEAR(1, sqDist[i], 1e-12) << angle;
+    EXPECT_NEAR((1 - 5 * s) * (1 - 5 * s), sqDist[i + 1], 1e-12) << angle;
+    EXPECT_NEAR((7 - 5 * c) * (7 - 5 * c) + 25 * s * s, sqDist[i + 2],
+        1e-12) << angle;
+    EXPECT_NEAR(0, sqDist[i + 3], 1e-12) << angle;
+    EXPECT_NEAR((pointsA[i + 1] - pointsB[i + 1]).SquaredLength(),
+        sqDist[i + 1], 1e-12);
+    EXPECT_EQ(math::Vector3d(10, 0, 0), pointsA[i + 2]);
+
+    // The first segment runs along x, the closest points of the crossing
+    // segments are above each other
+    EXPECT_NEAR(pointsA[i].X(), pointsB[i].X(), 1e-9) << angle;
+
+    // The scalar routine picks end points for the almost parallel pairs,
+    // which are never closer
+    for (std::size_t j = i; j < i + 4; ++j)
+    {
+      math::Line3d result;
+      EXPECT_TRUE(linesA[j].Distance(linesB[j], result));
+      EXPECT_LE(sqDist[j], result.Length() * result.Length() + 1e-12);
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(Line3Test, ClosestPointsDegenerate)
+{
+  std::vector<math::Line3d> linesA = {
+    math::Line3d(1, 2, 3, 1, 2, 3),
+    math::Line3d(0, 0, 0, 4, 0, 0),
+    math::Line3d(0, 0, 0, 4, 0, 0),
+    math::Line3d(1, 1, 1, 1, 1, 1)};
+  std::vector<math::Line3d> linesB = {
+    math::Line3d(0, 0, 0, 0, 4, 0),
+    math::Line3d(1, 1, 0, 1, 1, 0),
+    math::Line3d(6, 0, 1, 6, 0, 1),
+    math::Line3d(1, 1, 3, 1, 1, 3)};
+
+  std::vector<math::Vector3d> pointsA, pointsB;
+  std::vector<double> sqDist;
+  BatchClosestPoints(linesA, linesB, pointsA, pointsB, sqDist);
+
+  // Point and segment
+  EXPECT_EQ(math::Vector3d(1, 2, 3), pointsA[0]);
+  EXPECT_EQ(math::Vector3d(0, 2, 0), pointsB[0]);
+  EXPECT_DOUBLE_EQ(10, sqDist[0]);
+  // Segment and point
+  EXPECT_EQ(math::Vector3d(1, 0, 0), pointsA[1]);
+  EXPECT_DOUBLE_EQ(1, sqDist[1]);
+  EXPECT_EQ(math::Vector3d(4, 0, 0), pointsA[2]);
+  EXPECT_DOUBLE_EQ(5, sqDist[2]);
+  // Two points
+  EXPECT_DOUBLE_EQ(4, sqDist[3]);
+  for (std::size_t i = 0; i < sqDist.size(); ++i)
+  {
+    EXPECT_DOUBLE_EQ(ReferenceSqDistance(linesA[i], linesB[i]), sqDist[i]);
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(Line3Test, ClosestPointsFloat)
+{
+  math::Rand::Seed(12);
+  std::vector<math::Line3f> linesA, linesB;
+  std::vector<math::Line3d> linesAd, linesBd;
+  for (int i = 0; i < 500; ++i)
+  {
+    math::Vector3f p[4];
+    for (auto &v : p)
+    {
+      v.Set(static_cast<float>(math::Rand::DblUniform(-5, 5)),
+          static_cast<float>(math::Rand::DblUniform(-5, 5)),
+          static_cast<float>(math::Rand::DblUniform(-5, 5)));
+    }
+    linesA.push_back(math::Line3f(p[0], p[1]));
+    linesB.push_back(math::Line3f(p[2], p[3]));
+    linesAd.push_back(math::Line3d(p[0][0], p[0][1], p[0][2],
+          p[1][0], p[1][1], p[1][2]));
+    linesBd.push_back(math::Line3d(p[2][0], p[2][1], p[2][2],
+          p[3][0], p[3][1], p[3][2]));
+  }
+
+  std::vector<math::Vector3f> pointsA, pointsB;
+  std::vector<float> sqDist;
+  BatchClosestPoints(linesA, linesB, pointsA, pointsB, sqDist);
+  for (std::size_t i = 0; i < linesA.size(); ++i)
+  {
+    EXPECT_NEAR(ReferenceSqDistance(linesAd[i], linesBd[i]), sqDist[i],
+        1e-3);
+  }
+}
+
 /////////////////////////////////////////////////
 TEST(Line3Test, Intersect)
 {
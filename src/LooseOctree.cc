@@ -0,0 +1,861 @@
+/*
+ * Copyright (C) 2018 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+
+#include "ignition/math/LooseOctree.hh"
+#include "BvhBuilder.hh"
+
+using namespace ignition;
+using namespace math;
+using namespace detail;
+
+namespace
+{
+  /// \brief Marks the absence of a node or a box
+  const uint32_t kNone = std::numeric_limits<uint32_t>::max();
+
+  /// \brief Largest allowed depth. The traversal stack holds 7 nodes per
+  /// level and 8 for the deepest one.
+  const unsigned int kMaxDepth = 16;
+
+  /// \brief Size of the traversal stack
+  const int kStackSize = 7 * kMaxDepth + 8;
+
+  /// \brief Number of boxes from which a node gets children for the
+  /// boxes small enough to go deeper. Keeping a few boxes in a node
+  /// rather than creating a path of nodes for each box makes the tree
+  /// smaller and the updates faster.
+  const uint32_t kSplitCount = 8;
+
+  /// \brief Relative tolerance of the tests of the nodes against the
+  /// planes of a frustum, so that rounding never culls a node whose boxes
+  /// are visible.
+  const double kPlaneTolerance = 1e-9;
+
+  /// \brief A node of the tree
+  struct Node
+  {
+    /// \brief Bounds of the cell enlarged to twice its size, which
+    /// contain the boxes of the node and of its descendants
+    BvhBounds loose;
+
+    /// \brief Center of the cell
+    double center[3];
+
+    /// \brief Half of the size of the cell
+    double half;
+
+    /// \brief Children, kNone for the missing ones
+    uint32_t children[8];
+
+    /// \brief Parent, kNone for the root. Next free node when the node
+    /// is in the free list.
+    uint32_t parent;
+
+    /// \brief Position of the node in the children of its parent
+    uint32_t slot;
+
+    /// \brief Depth of the node, 0 for the root
+    uint32_t depth;
+
+    /// \brief Number of children
+    uint32_t childCount;
+
+    /// \brief First box of the node, kNone if it has no box
+    uint32_t first;
+
+    /// \brief Number of boxes of the node
+    uint32_t count;
+  };
+
+  /// \brief A box stored in the tree
+  struct Object
+  {
+    /// \brief Bounds of the box
+    BvhBounds box;
+
+    /// \brief Node holding the box, kNone if the box is empty or unused
+    uint32_t node;
+
+    /// \brief Previous box of the node
+    uint32_t prev;
+
+    /// \brief Next box of the node. Next free box when the box is unused.
+    uint32_t next;
+
+    /// \brief Whether the id is in use
+    bool used;
+  };
+
+  //////////////////////////////////////////////////
+  /// \brief Get the bounds of a box.
+  /// \param[in] _box The box.
+  /// \return The bounds.
+  BvhBounds ToBounds(const AxisAlignedBox &_box)
+  {
+    BvhBounds b;
+    for (int a = 0; a < 3; ++a)
+    {
+      b.min[a] = _box.Min()[a];
+      b.max[a] = _box.Max()[a];
+    }
+    return b;
+  }
+
+  //////////////////////////////////////////////////
+  /// \brief Check if bounds are empty.
+  /// \param[in] _b The bounds.
+  /// \return True if the minimum is larger than the maximum along an axis.
+  bool IsEmpty(const BvhBounds &_b)
+  {
+    return _b.min[0] > _b.max[0] || _b.min[1] > _b.max[1] ||
+           _b.min[2] > _b.max[2];
+  }
+
+  //////////////////////////////////////////////////
+  /// \brief Get the child of a node whose cell holds the center of a box.
+  /// \param[in] _node The node.
+  /// \param[in] _b The box.
+  /// \return Position of the child in the children of _node.
+  uint32_t ChildSlot(const Node &_node, const BvhBounds &_b)
+  {
+    uint32_t slot = 0;
+    for (int a = 0; a < 3; ++a)
+    {
+      if (0.5 * _b.min[a] + 0.5 * _b.max[a] >= _node.center[a])
+        slot |= 1u << a;
+    }
+    return slot;
+  }
+
+  //////////////////////////////////////////////////
+  /// \brief Check if bounds contain others.
+  /// \param[in] _outer The containing bounds.
+  /// \param[in] _inner The contained bounds.
+  /// \return True if _inner lies inside _outer.
+  bool Encloses(const BvhBounds &_outer, const BvhBounds &_inner)
+  {
+    return _inner.min[0] >= _outer.min[0] && _inner.max[0] <= _outer.max[0] &&
+           _inner.min[1] >= _outer.min[1] && _inner.max[1] <= _outer.max[1] &&
+           _inner.min[2] >= _outer.min[2] && _inner.max[2] <= _outer.max[2];
+  }
+
+  /// \brief A plane of a frustum as plain values
+  struct FrustumPlaneData
+  {
+    /// \brief Normal
+    double normal[3];
+
+    /// \brief Offset
+    double d;
+  };
+
+  //////////////////////////////////////////////////
+  /// \brief Side of bounds against a plane, computed like
+  /// Plane::Side(const AxisAlignedBox &) const.
+  /// \param[in] _plane The plane.
+  /// \param[in] _b The bounds, not empty.
+  /// \param[out] _dist Distance from the center of the bounds to the
+  /// plane.
+  /// \param[out] _maxAbsDist Largest distance from the center of the
+  /// bounds to their corners along the normal.
+  void PlaneDistances(const FrustumPlaneData &_plane, const BvhBounds &_b,
+      double &_dist, double &_maxAbsDist)
+  {
+    double center[3];
+    double half[3];
+    for (int a = 0; a < 3; ++a)
+    {
+      center[a] = 0.5 * _b.min[a] + 0.5 * _b.max[a];
+      half[a] = std::max(0.0, _b.max[a] - _b.min[a]) / 2.0;
+    }
+    _dist = _plane.normal[0] * center[0] + _plane.normal[1] * center[1] +
+            _plane.normal[2] * center[2] - _plane.d;
+    _maxAbsDist = std::abs(_plane.normal[0] * half[0]) +
+                  std::abs(_plane.normal[1] * half[1]) +
+                  std::abs(_plane.normal[2] * half[2]);
+  }
+}  // namespace
+
+/// \brief Private data for LooseOctree
+class ignition::math::LooseOctreePrivate
+{
+  /// \brief Create the root node.
+  public: void Reset();
+
+  /// \brief Get a node from the free list, or a new one.
+  /// \param[in] _parent Parent of the node.
+  /// \param[in] _slot Position of the node in the children of _parent.
+  /// \return Index of the node.
+  public: uint32_t NewNode(const uint32_t _parent, const uint32_t _slot);
+
+  /// \brief Find the node that should hold a box, creating the missing
+  /// nodes on the way.
+  /// \param[in] _box The box, not empty.
+  /// \return Index of the node.
+  public: uint32_t FindNode(const BvhBounds &_box);
+
+  /// \brief Find the depth at which a box should be stored.
+  /// \param[in] _box The box, not empty.
+  /// \return The depth, 0 for the boxes stored in the root.
+  public: uint32_t Depth(const BvhBounds &_box) const;
+
+  /// \brief Add a box to the list of a node.
+  /// \param[in] _id Id of the box.
+  /// \param[in] _node Index of the node.
+  public: void Link(const uint32_t _id, const uint32_t _node);
+
+  /// \brief Remove a box from the list of its node, and free the nodes
+  /// left without boxes and children.
+  /// \param[in] _id Id of the box.
+  public: void Unlink(const uint32_t _id);
+
+  /// \brief Visit the boxes of the nodes that pass a test. The boxes of
+  /// the root are always visited, since the root also holds the boxes
+  /// outside of its bounds.
+  /// \param[in] _nodeTest Callable taking the loose bounds of a node and
+  /// returning whether to visit it.
+  /// \param[in] _boxVisit Callable taking the id of a box and returning
+  /// false to stop the traversal.
+  public: template<typename NodeTest, typename BoxVisit>
+          void Traverse(NodeTest _nodeTest, BoxVisit _boxVisit) const;
+
+  /// \brief Nodes, including those of the free list
+  public: std::vector<Node> nodes;
+
+  /// \brief First node of the free list
+  public: uint32_t freeNode = kNone;
+
+  /// \brief Number of nodes in use
+  public: std::size_t nodeCount = 0;
+
+  /// \brief Boxes, including those of the free list
+  public: std::vector<Object> objects;
+
+  /// \brief First box of the free list
+  public: uint32_t freeObject = kNone;
+
+  /// \brief Number of boxes in use
+  public: std::size_t size = 0;
+
+  /// \brief Center of the region
+  public: double center[3] = {0, 0, 0};
+
+  /// \brief Half of the size of the region
+  public: double half = 0.5;
+
+  /// \brief Maximum depth of the nodes
+  public: uint32_t maxDepth = 0;
+};
+
+//////////////////////////////////////////////////
+void LooseOctreePrivate::Reset()
+{
+  this->nodes.clear();
+  this->freeNode = kNone;
+  this->nodeCount = 0;
+  this->NewNode(kNone, 0);
+}
+
+//////////////////////////////////////////////////
+uint32_t LooseOctreePrivate::NewNode(const uint32_t _parent,
+    const uint32_t _slot)
+{
+  uint32_t index = this->freeNode;
+  if (index != kNone)
+  {
+    this->freeNode = this->nodes[index].parent;
+  }
+  else
+  {
+    index = static_cast<uint32_t>(this->nodes.size());
+    this->nodes.emplace_back();
+  }
+  ++this->nodeCount;
+
+  Node &node = this->nodes[index];
+  node.parent = _parent;
+  node.slot = _slot;
+  node.childCount = 0;
+  node.first = kNone;
+  node.count = 0;
+  std::fill(node.children, node.children + 8, kNone);
+  if (_parent == kNone)
+  {
+    node.depth = 0;
+    node.half = this->half;
+    std::copy(this->center, this->center + 3, node.center);
+  }
+  else
+  {
+    Node &parent = this->nodes[_parent];
+    node.depth = parent.depth + 1;
+    node.half = parent.half * 0.5;
+    for (int a = 0; a < 3; ++a)
+    {
+      const double sign = (_slot >> a) & 1 ? 1 : -1;
+      node.center[a] = parent.center[a] + sign * node.half;
+    }
+    parent.children[_slot] = index;
+    ++parent.childCount;
+  }
+  for (int a = 0; a < 3; ++a)
+  {
+    node.loose.min[a] = node.center[a] - 2 * node.half;
+    node.loose.max[a] = node.center[a] + 2 * node.half;
+  }
+  return index;
+}
+
+//////////////////////////////////////////////////
+uint32_t LooseOctreePrivate::Depth(const BvhBounds &_box) const
+{
+  double extent = 0;
+  for (int a = 0; a < 3; ++a)
+  {
+    const double boxCenter = 0.5 * _box.min[a] + 0.5 * _box.max[a];
+    // Also catches NaN
+    if (!(std::abs(boxCenter - this->center[a]) <= this->half))
+      return 0;
+    extent = std::max(extent, 0.5 * (_box.max[a] - _box.min[a]));
+  }
+
+  // The box fits in the loose bounds of the cell holding its center as
+  // long as its half size is at most the half size of the cell
+  uint32_t depth = 0;
+  double cellHalf = this->half;
+  while (depth < this->maxDepth && extent <= cellHalf * 0.5)
+  {
+    cellHalf *= 0.5;
+    ++depth;
+  }
+  return depth;
+}
+
+//////////////////////////////////////////////////
+uint32_t LooseOctreePrivate::FindNode(const BvhBounds &_box)
+{
+  const uint32_t depth = this->Depth(_box);
+  uint32_t index = 0;
+  for (uint32_t d = 0; d < depth; ++d)
+  {
+    const uint32_t slot = ChildSlot(this->nodes[index], _box);
+    uint32_t child = this->nodes[index].children[slot];
+    if (child == kNone)
+    {
+      // The box stays in a node with few boxes
+      if (this->nodes[index].count < kSplitCount)
+        break;
+      child = this->NewNode(index, slot);
+    }
+
+    // Rounding in the placement of the cells can leave the box slightly
+    // outside of the loose bounds, it then stays in the parent
+    if (!Encloses(this->nodes[child].loose, _box))
+    {
+      if (this->nodes[child].childCount == 0 &&
+          this->nodes[child].first == kNone)
+      {
+        this->nodes[index].children[slot] = kNone;
+        --this->nodes[index].childCount;
+        this->nodes[child].parent = this->freeNode;
+        this->freeNode = child;
+        --this->nodeCount;
+      }
+      break;
+    }
+    index = child;
+  }
+  return index;
+}
+
+//////////////////////////////////////////////////
+void LooseOctreePrivate::Link(const uint32_t _id, const uint32_t _node)
+{
+  Object &object = this->objects[_id];
+  Node &node = this->nodes[_node];
+  object.node = _node;
+  object.prev = kNone;
+  object.next = node.first;
+  if (node.first != kNone)
+    this->objects[node.first].prev = _id;
+  node.first = _id;
+  ++node.count;
+}
+
+//////////////////////////////////////////////////
+void LooseOctreePrivate::Unlink(const uint32_t _id)
+{
+  Object &object = this->objects[_id];
+  uint32_t index = object.node;
+  if (index == kNone)
+    return;
+
+  if (object.prev != kNone)
+    this->objects[object.prev].next = object.next;
+  else
+    this->nodes[index].first = object.next;
+  if (object.next != kNone)
+    this->objects[object.next].prev = object.prev;
+  object.node = kNone;
+  --this->nodes[index].count;
+
+  // Free the empty leaves up to the root
+  while (index != 0 && this->nodes[index].first == kNone &&
+         this->nodes[index].childCount == 0)
+  {
+    Node &node = this->nodes[index];
+    const uint32_t parent = node.parent;
+    this->nodes[parent].children[node.slot] = kNone;
+    --this->nodes[parent].childCount;
+    node.parent = this->freeNode;
+    this->freeNode = index;
+    --this->nodeCount;
+    index = parent;
+  }
+}
+
+//////////////////////////////////////////////////
+template<typename NodeTest, typename BoxVisit>
+void LooseOctreePrivate::Traverse(NodeTest _nodeTest,
+    BoxVisit _boxVisit) const
+{
+  uint32_t stack[kStackSize];
+  int top = 0;
+  stack[top++] = 0;
+  bool root = true;
+  while (top > 0)
+  {
+    const Node &node = this->nodes[stack[--top]];
+    if (!root && !_nodeTest(node.loose))
+      continue;
+    root = false;
+
+    for (uint32_t id = node.first; id != kNone; id = this->objects[id].next)
+    {
+      if (!_boxVisit(id))
+        return;
+    }
+    for (int c = 0; c < 8 && node.childCount > 0; ++c)
+    {
+      if (node.children[c] != kNone)
+        stack[top++] = node.children[c];
+    }
+  }
+}
+
+//////////////////////////////////////////////////
+LooseOctree::LooseOctree(const AxisAlignedBox &_region,
+    const unsigned int _maxDepth)
+: dataPtr(new LooseOctreePrivate)
+{
+  const BvhBounds region = ToBounds(_region);
+  if (!IsEmpty(region))
+  {
+    double half = 0;
+    for (int a = 0; a < 3; ++a)
+    {
+      this->dataPtr->center[a] = 0.5 * region.min[a] + 0.5 * region.max[a];
+      half = std::max(half, 0.5 * (region.max[a] - region.min[a]));
+    }
+    if (half > 0 && std::isfinite(half))
+      this->dataPtr->half = half;
+    else
+      std::fill(this->dataPtr->center, this->dataPtr->center + 3, 0.0);
+  }
+  this->dataPtr->maxDepth = std::min(_maxDepth, kMaxDepth);
+  this->dataPtr->Reset();
+}
+
+//////////////////////////////////////////////////
+LooseOctree::LooseOctree(const LooseOctree &_tree)
+: dataPtr(new LooseOctreePrivate(*_tree.dataPtr))
+{
+}
+
+//////////////////////////////////////////////////
+LooseOctree::~LooseOctree()
+{
+}
+
+//////////////////////////////////////////////////
+LooseOctree &LooseOctree::operator=(const LooseOctree &_tree)
+{
+  *this->dataPtr = *_tree.dataPtr;
+  return *this;
+}
+
+//////////////////////////////////////////////////
+AxisAlignedBox LooseOctree::Region() const
+{
+  const LooseOctreePrivate &d = *this->dataPtr;
+  const Vector3d center(d.center[0], d.center[1], d.center[2]);
+  const Vector3d half(d.half, d.half, d.half);
+  return AxisAlignedBox(center - half, center + half);
+}
+
+//////////////////////////////////////////////////
+unsigned int LooseOctree::MaxDepth() const
+{
+  return this->dataPtr->maxDepth;
+}
+
+//////////////////////////////////////////////////
+void LooseOctree::Reserve(const std::size_t _size)
+{
+  this->dataPtr->objects.reserve(_size);
+}
+
+//////////////////////////////////////////////////
+std::size_t LooseOctree::Insert(const AxisAlignedBox &_box)
+{
+  LooseOctreePrivate &d = *this->dataPtr;
+  uint32_t id = d.freeObject;
+  if (id != kNone)
+  {
+    d.freeObject = d.objects[id].next;
+  }
+  else
+  {
+    id = static_cast<uint32_t>(d.objects.size());
+    d.objects.emplace_back();
+  }
+  ++d.size;
+
+  Object &object = d.objects[id];
+  object.box = ToBounds(_box);
+  object.node = kNone;
+  object.prev = kNone;
+  object.next = kNone;
+  object.used = true;
+  if (!IsEmpty(object.box))
+    d.Link(id, d.FindNode(object.box));
+  return id;
+}
+
+//////////////////////////////////////////////////
+bool LooseOctree::Remove(const std::size_t _id)
+{
+  if (!this->Has(_id))
+    return false;
+
+  LooseOctreePrivate &d = *this->dataPtr;
+  const uint32_t id = static_cast<uint32_t>(_id);
+  d.Unlink(id);
+  d.objects[id].used = false;
+  d.objects[id].next = d.freeObject;
+  d.freeObject = id;
+  --d.size;
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool LooseOctree::Update(const std::size_t _id, const AxisAlignedBox &_box)
+{
+  if (!this->Has(_id))
+    return false;
+
+  LooseOctreePrivate &d = *this->dataPtr;
+  const uint32_t id = static_cast<uint32_t>(_id);
+  Object &object = d.objects[id];
+  object.box = ToBounds(_box);
+  if (IsEmpty(object.box))
+  {
+    d.Unlink(id);
+    return true;
+  }
+
+  // The box stays in its node while it fits in the loose bounds, is not
+  // too large for the node, and has no child node to go to, which is the
+  // common case of small moves
+  if (object.node != kNone)
+  {
+    const Node &node = d.nodes[object.node];
+    const uint32_t depth = d.Depth(object.box);
+    if (depth >= node.depth &&
+        (node.depth == 0 || Encloses(node.loose, object.box)) &&
+        (depth == node.depth ||
+         node.children[ChildSlot(node, object.box)] == kNone))
+    {
+      return true;
+    }
+  }
+
+  d.Unlink(id);
+  d.Link(id, d.FindNode(object.box));
+  return true;
+}
+
+//////////////////////////////////////////////////
+void LooseOctree::Clear()
+{
+  LooseOctreePrivate &d = *this->dataPtr;
+  d.objects.clear();
+  d.freeObject = kNone;
+  d.size = 0;
+  d.Reset();
+}
+
+//////////////////////////////////////////////////
+std::size_t LooseOctree::Size() const
+{
+  return this->dataPtr->size;
+}
+
+//////////////////////////////////////////////////
+std::size_t LooseOctree::NodeCount() const
+{
+  return this->dataPtr->nodeCount;
+}
+
+//////////////////////////////////////////////////
+bool LooseOctree::Has(const std::size_t _id) const
+{
+  return _id < this->dataPtr->objects.size() &&
+         this->dataPtr->objects[_id].used;
+}
+
+//////////////////////////////////////////////////
+AxisAlignedBox LooseOctree::Box(const std::size_t _id) const
+{
+  if (!this->Has(_id))
+    return AxisAlignedBox();
+
+  const BvhBounds &b = this->dataPtr->objects[_id].box;
+  if (IsEmpty(b))
+    return AxisAlignedBox();
+  return AxisAlignedBox(Vector3d(b.min[0], b.min[1], b.min[2]),
+                        Vector3d(b.max[0], b.max[1], b.max[2]));
+}
+
+//////////////////////////////////////////////////
+std::tuple<bool, double, std::size_t> LooseOctree::Intersect(
+    const Vector3d &_origin, const Vector3d &_dir, const double _min,
+    const double _max) const
+{
+  const BvhRay ray(_origin, _dir, _min, _max);
+  const LooseOctreePrivate &d = *this->dataPtr;
+
+  double best = _max;
+  uint32_t bestId = 0;
+  bool hit = false;
+
+  // Nearest node first, skipping the nodes farther than the closest hit
+  uint32_t stack[kStackSize];
+  double stackDist[kStackSize];
+  int top = 0;
+  stack[top] = 0;
+  stackDist[top++] = ray.tMin;
+  while (top > 0)
+  {
+    --top;
+    if (stackDist[top] > best)
+      continue;
+    const Node &node = d.nodes[stack[top]];
+
+    double t;
+    for (uint32_t id = node.first; id != kNone; id = d.objects[id].next)
+    {
+      if (!ray.Hit(d.objects[id].box, best, t))
+        continue;
+      if (!hit || t < best || (!(best < t) && id < bestId))
+      {
+        hit = true;
+        best = t;
+        bestId = id;
+      }
+    }
+
+    // Push the children hit by the ray, farthest first
+    const int first = top;
+    for (int c = 0; c < 8 && node.childCount > 0; ++c)
+    {
+      const uint32_t child = node.children[c];
+      if (child == kNone || !ray.HitNode(d.nodes[child].loose, best, t))
+        continue;
+      int i = top++;
+      while (i > first && stackDist[i - 1] < t)
+      {
+        stack[i] = stack[i - 1];
+        stackDist[i] = stackDist[i - 1];
+        --i;
+      }
+      stack[i] = child;
+      stackDist[i] = t;
+    }
+  }
+
+  if (!hit)
+    return std::make_tuple(false, 0.0, std::size_t(0));
+  return std::make_tuple(true, best - _min, std::size_t(bestId));
+}
+
+//////////////////////////////////////////////////
+bool LooseOctree::IntersectCheck(const Vector3d &_origin,
+    const Vector3d &_dir, const double _min, const double _max) const
+{
+  const BvhRay ray(_origin, _dir, _min, _max);
+  const LooseOctreePrivate &d = *this->dataPtr;
+  bool hit = false;
+  double t;
+  d.Traverse(
+      [&](const BvhBounds &_b) {return ray.HitNode(_b, ray.tMax, t);},
+      [&](const uint32_t _id)
+      {
+        hit = ray.Hit(d.objects[_id].box, ray.tMax, t);
+        return !hit;
+      });
+  return hit;
+}
+
+//////////////////////////////////////////////////
+bool LooseOctree::IntersectAll(const Vector3d &_origin,
+    const Vector3d &_dir, const double _min, const double _max,
+    std::vector<std::size_t> &_ids) const
+{
+  _ids.clear();
+  const BvhRay ray(_origin, _dir, _min, _max);
+  const LooseOctreePrivate &d = *this->dataPtr;
+  double t;
+  d.Traverse(
+      [&](const BvhBounds &_b) {return ray.HitNode(_b, ray.tMax, t);},
+      [&](const uint32_t _id)
+      {
+        if (ray.Hit(d.objects[_id].box, ray.tMax, t))
+          _ids.push_back(_id);
+        return true;
+      });
+  return !_ids.empty();
+}
+
+//////////////////////////////////////////////////
+bool LooseOctree::Overlap(const AxisAlignedBox &_box,
+    std::vector<std::size_t> &_ids) const
+{
+  _ids.clear();
+  const BvhBounds box = ToBounds(_box);
+  const LooseOctreePrivate &d = *this->dataPtr;
+  d.Traverse(
+      [&](const BvhBounds &_b) {return box.Intersects(_b);},
+      [&](const uint32_t _id)
+      {
+        if (box.Intersects(d.objects[_id].box))
+          _ids.push_back(_id);
+        return true;
+      });
+  return !_ids.empty();
+}
+
+//////////////////////////////////////////////////
+bool LooseOctree::Visible(const Frustum &_frustum,
+    std::vector<std::size_t> &_ids) const
+{
+  _ids.clear();
+  const LooseOctreePrivate &d = *this->dataPtr;
+
+  FrustumPlaneData planes[6];
+  for (int p = 0; p < 6; ++p)
+  {
+    const Planed plane =
+      _frustum.Plane(static_cast<Frustum::FrustumPlane>(p));
+    for (int a = 0; a < 3; ++a)
+      planes[p].normal[a] = plane.Normal()[a];
+    planes[p].d = plane.Offset();
+  }
+
+  // Each node is pushed with the planes crossed by its parent. The planes
+  // that a node lies in front of are not tested for its descendants.
+  uint32_t stack[kStackSize];
+  unsigned int stackPlanes[kStackSize];
+  int top = 0;
+  stack[top] = 0;
+  stackPlanes[top++] = 0x3f;
+  bool root = true;
+  while (top > 0)
+  {
+    --top;
+    const Node &node = d.nodes[stack[top]];
+    unsigned int mask = stackPlanes[top];
+
+    // The root also holds the boxes outside of its bounds, its boxes are
+    // tested against all the planes
+    if (!root)
+    {
+      bool culled = false;
+      for (int p = 0; p < 6 && !culled; ++p)
+      {
+        if (!(mask & (1u << p)))
+          continue;
+        double dist, maxAbsDist;
+        PlaneDistances(planes[p], node.loose, dist, maxAbsDist);
+        const double tolerance = kPlaneTolerance * (std::abs(planes[p].d) +
+            std::abs(planes[p].normal[0] * node.center[0]) +
+            std::abs(planes[p].normal[1] * node.center[1]) +
+            std::abs(planes[p].normal[2] * node.center[2]) + maxAbsDist);
+        if (dist < -maxAbsDist - tolerance)
+          culled = true;
+        else if (dist > maxAbsDist + tolerance)
+          mask &= ~(1u << p);
+      }
+      if (culled)
+        continue;
+    }
+    root = false;
+
+    for (uint32_t id = node.first; id != kNone; id = d.objects[id].next)
+    {
+      const BvhBounds &box = d.objects[id].box;
+      int overlapping = 0;
+      bool outside = false;
+      for (int p = 0; p < 6 && !outside; ++p)
+      {
+        if (!(mask & (1u << p)))
+          continue;
+        double dist, maxAbsDist;
+        PlaneDistances(planes[p], box, dist, maxAbsDist);
+        if (dist < -maxAbsDist)
+          outside = true;
+        else if (!(dist > maxAbsDist))
+          ++overlapping;
+      }
+      if (outside)
+        continue;
+
+      // Boxes crossing several planes can still be outside of the
+      // frustum, the frustum tests them exactly
+      if (overlapping < 2 || _frustum.Contains(AxisAlignedBox(
+              Vector3d(box.min[0], box.min[1], box.min[2]),
+              Vector3d(box.max[0], box.max[1], box.max[2]))))
+      {
+        _ids.push_back(id);
+      }
+    }
+
+    for (int c = 0; c < 8 && node.childCount > 0; ++c)
+    {
+      if (node.children[c] != kNone)
+      {
+        stack[top] = node.children[c];
+        stackPlanes[top++] = mask;
+      }
+    }
+  }
+  return !_ids.empty();
+}
@@ -0,0 +1,365 @@
+/*
+ * Copyright (C) 2018 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <tuple>
+#include <vector>
+
+#include "ignition/math/Bvh.hh"
+#include "ignition/math/Helpers.hh"
+#include "ignition/math/LooseOctree.hh"
+#include "ignition/math/Rand.hh"
+
+using namespace ignition;
+
+/////////////////////////////////////////////////
+/// \brief Random box of size up to _size with its minimum corner in a
+/// cube of side 2 * _range.
+math::AxisAlignedBox RandomBox(const double _range, const double _size)
+{
+  const math::Vector3d min(math::Rand::DblUniform(-_range, _range),
+      math::Rand::DblUniform(-_range, _range),
+      math::Rand::DblUniform(-_range, _range));
+  const math::Vector3d size(math::Rand::DblUniform(0, _size),
+      math::Rand::DblUniform(0, _size), math::Rand::DblUniform(0, _size));
+  return math::AxisAlignedBox(min, min + size);
+}
+
+/////////////////////////////////////////////////
+math::Vector3d RandomVector(const double _range)
+{
+  return math::Vector3d(math::Rand::DblUniform(-_range, _range),
+      math::Rand::DblUniform(-_range, _range),
+      math::Rand::DblUniform(-_range, _range));
+}
+
+/////////////////////////////////////////////////
+/// \brief Fill a tree with random boxes, some of them outside of its
+/// region or larger than it, then move and remove some of them.
+/// \param[in,out] _tree The tree.
+/// \param[out] _boxes Box of each id, default constructed for the removed
+/// ids.
+void RandomTree(math::LooseOctree &_tree,
+    std::vector<math::AxisAlignedBox> &_boxes)
+{
+  _boxes.clear();
+  for (int i = 0; i < 2000; ++i)
+  {
+    const double size = i % 10 == 0 ? 20 : 2;
+    _boxes.push_back(RandomBox(i % 50 == 0 ? 80 : 50, size));
+    EXPECT_EQ(_boxes.size() - 1, _tree.Insert(_boxes.back()));
+  }
+  _boxes.push_back(math::AxisAlignedBox(-200, -200, -200, 200, 200, 200));
+  _tree.Insert(_boxes.back());
+
+  for (std::size_t i = 0; i < _boxes.size(); i += 3)
+  {
+    const math::Vector3d offset = RandomVector(i % 2 == 0 ? 0.5 : 30);
+    _boxes[i] = math::AxisAlignedBox(_boxes[i].Min() + offset,
+        _boxes[i].Max() + offset);
+    EXPECT_TRUE(_tree.Update(i, _boxes[i]));
+  }
+  for (std::size_t i = 1; i < _boxes.size(); i += 7)
+  {
+    EXPECT_TRUE(_tree.Remove(i));
+    _boxes[i] = math::AxisAlignedBox();
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(LooseOctreeTest, Construct)
+{
+  math::LooseOctree tree(math::AxisAlignedBox(0, 0, 0, 4, 2, 1), 5);
+  EXPECT_EQ(math::AxisAlignedBox(0, -1, -1.5, 4, 3, 2.5), tree.Region());
+  EXPECT_EQ(5u, tree.MaxDepth());
+  EXPECT_EQ(0u, tree.Size());
+  EXPECT_EQ(1u, tree.NodeCount());
+
+  math::LooseOctree deep(math::AxisAlignedBox(0, 0, 0, 1, 1, 1), 100);
+  EXPECT_EQ(16u, deep.MaxDepth());
+
+  math::LooseOctree empty((math::AxisAlignedBox()));
+  EXPECT_EQ(math::AxisAlignedBox(-0.5, -0.5, -0.5, 0.5, 0.5, 0.5),
+      empty.Region());
+  EXPECT_EQ(8u, empty.MaxDepth());
+
+  std::vector<std::size_t> ids;
+  EXPECT_FALSE(tree.Overlap(tree.Region(), ids));
+  EXPECT_FALSE(tree.IntersectCheck(math::Vector3d(-1, 0, 0),
+        math::Vector3d::UnitX, 0, 10));
+  EXPECT_FALSE(std::get<0>(tree.Intersect(math::Vector3d(-1, 0, 0),
+        math::Vector3d::UnitX, 0, 10)));
+}
+
+/////////////////////////////////////////////////
+TEST(LooseOctreeTest, InsertRemove)
+{
+  math::LooseOctree tree(math::AxisAlignedBox(-8, -8, -8, 8, 8, 8), 4);
+  const math::AxisAlignedBox a(1, 1, 1, 1.5, 1.5, 1.5);
+  const math::AxisAlignedBox b(-3, -3, -3, 3, 3, 3);
+  const math::AxisAlignedBox c(20, 20, 20, 21, 21, 21);
+
+  EXPECT_EQ(0u, tree.Insert(a));
+  EXPECT_EQ(1u, tree.Insert(b));
+  EXPECT_EQ(2u, tree.Insert(c));
+  EXPECT_EQ(3u, tree.Size());
+  EXPECT_TRUE(tree.Has(2));
+  EXPECT_FALSE(tree.Has(3));
+  EXPECT_EQ(a, tree.Box(0));
+  EXPECT_EQ(c, tree.Box(2));
+  EXPECT_EQ(math::AxisAlignedBox(), tree.Box(3));
+
+  // A few boxes stay in the root
+  EXPECT_EQ(1u, tree.NodeCount());
+
+  std::vector<std::size_t> ids;
+  EXPECT_TRUE(tree.Overlap(math::AxisAlignedBox(1.2, 1.2, 1.2, 2, 2, 2),
+        ids));
+  std::sort(ids.begin(), ids.end());
+  EXPECT_EQ(std::vector<std::size_t>({0, 1}), ids);
+  EXPECT_TRUE(tree.Overlap(math::AxisAlignedBox(19, 19, 19, 20, 20, 20),
+        ids));
+  EXPECT_EQ(std::vector<std::size_t>({2}), ids);
+
+  // Moving the box out of its node moves it in the tree
+  const math::AxisAlignedBox moved(-6, 6, -6, -5.5, 6.5, -5.5);
+  EXPECT_TRUE(tree.Update(0, moved));
+  EXPECT_EQ(moved, tree.Box(0));
+  EXPECT_EQ(1u, tree.NodeCount());
+  EXPECT_TRUE(tree.Overlap(math::AxisAlignedBox(-6, 6, -6, -6, 6, -6),
+        ids));
+  EXPECT_EQ(std::vector<std::size_t>({0}), ids);
+  EXPECT_TRUE(tree.Overlap(math::AxisAlignedBox(1.2, 1.2, 1.2, 2, 2, 2),
+        ids));
+  EXPECT_EQ(std::vector<std::size_t>({1}), ids);
+
+  // Removed ids are reused
+  EXPECT_TRUE(tree.Remove(1));
+  EXPECT_FALSE(tree.Remove(1));
+  EXPECT_FALSE(tree.Update(1, a));
+  EXPECT_FALSE(tree.Has(1));
+  EXPECT_FALSE(tree.Remove(42));
+  EXPECT_EQ(2u, tree.Size());
+  EXPECT_EQ(1u, tree.Insert(b));
+  EXPECT_EQ(3u, tree.Size());
+
+  // Crowded nodes get children for the small boxes, down to the maximum
+  // depth
+  for (int i = 0; i < 40; ++i)
+  {
+    const double x = 5 + 0.01 * i;
+    EXPECT_EQ(3u + i, tree.Insert(
+          math::AxisAlignedBox(x, x, x, x + 0.1, x + 0.1, x + 0.1)));
+  }
+  EXPECT_EQ(43u, tree.Size());
+  EXPECT_EQ(5u, tree.NodeCount());
+  const math::AxisAlignedBox point(5.255, 5.255, 5.255, 5.255, 5.255, 5.255);
+  EXPECT_TRUE(tree.Overlap(point, ids));
+  std::sort(ids.begin(), ids.end());
+  EXPECT_EQ(std::vector<std::size_t>({19, 20, 21, 22, 23, 24, 25, 26, 27,
+        28}), ids);
+
+  // Removing all the boxes frees all the nodes but the root
+  for (std::size_t i = 0; i < 43; ++i)
+    EXPECT_TRUE(tree.Remove(i));
+  EXPECT_EQ(0u, tree.Size());
+  EXPECT_EQ(1u, tree.NodeCount());
+
+  tree.Insert(a);
+  tree.Clear();
+  EXPECT_EQ(0u, tree.Size());
+  EXPECT_EQ(1u, tree.NodeCount());
+  EXPECT_FALSE(tree.Has(0));
+}
+
+/////////////////////////////////////////////////
+TEST(LooseOctreeTest, EmptyBoxes)
+{
+  math::LooseOctree tree(math::AxisAlignedBox(-8, -8, -8, 8, 8, 8));
+  EXPECT_EQ(0u, tree.Insert(math::AxisAlignedBox()));
+  EXPECT_EQ(1u, tree.Insert(math::AxisAlignedBox(0, 0, 0, 1, 1, 1)));
+  EXPECT_EQ(2u, tree.Size());
+  EXPECT_EQ(math::AxisAlignedBox(), tree.Box(0));
+
+  std::vector<std::size_t> ids;
+  const math::AxisAlignedBox everything(-1e9, -1e9, -1e9, 1e9, 1e9, 1e9);
+  EXPECT_TRUE(tree.Overlap(everything, ids));
+  EXPECT_EQ(std::vector<std::size_t>({1}), ids);
+
+  // Boxes can become empty and back
+  EXPECT_TRUE(tree.Update(1, math::AxisAlignedBox()));
+  EXPECT_FALSE(tree.Overlap(everything, ids));
+  EXPECT_EQ(1u, tree.NodeCount());
+  EXPECT_TRUE(tree.Update(0, math::AxisAlignedBox(2, 2, 2, 3, 3, 3)));
+  EXPECT_TRUE(tree.Overlap(everything, ids));
+  EXPECT_EQ(std::vector<std::size_t>({0}), ids);
+}
+
+/////////////////////////////////////////////////
+TEST(LooseOctreeTest, Overlap)
+{
+  math::LooseOctree tree(math::AxisAlignedBox(-50, -50, -50, 50, 50, 50));
+  std::vector<math::AxisAlignedBox> boxes;
+  RandomTree(tree, boxes);
+
+  std::vector<std::size_t> ids;
+  for (int q = 0; q < 100; ++q)
+  {
+    const math::AxisAlignedBox query = RandomBox(60, q % 2 == 0 ? 5 : 40);
+    std::vector<std::size_t> expected;
+    for (std::size_t i = 0; i < boxes.size(); ++i)
+    {
+      if (tree.Has(i) && boxes[i].Intersects(query))
+        expected.push_back(i);
+    }
+
+    EXPECT_EQ(!expected.empty(), tree.Overlap(query, ids));
+    std::sort(ids.begin(), ids.end());
+    EXPECT_EQ(expected, ids);
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(LooseOctreeTest, Ray)
+{
+  // The same boxes in a tree and in a Bvh, ids and indices match
+  math::LooseOctree tree(math::AxisAlignedBox(-50, -50, -50, 50, 50, 50));
+  std::vector<math::AxisAlignedBox> boxes;
+  RandomTree(tree, boxes);
+  const math::Bvh bvh(boxes);
+
+  std::vector<std::size_t> ids;
+  std::vector<std::size_t> indices;
+  for (int q = 0; q < 300; ++q)
+  {
+    const math::Vector3d origin = RandomVector(70);
+    math::Vector3d dir = RandomVector(1);
+    if (q % 10 == 0)
+      dir.Set(0, 0, 1);
+    const double min = q % 3 == 0 ? 5 : 0;
+    const double max = q % 4 == 0 ? 30 : 200;
+
+    EXPECT_EQ(bvh.Intersect(origin, dir, min, max),
+        tree.Intersect(origin, dir, min, max));
+    EXPECT_EQ(bvh.IntersectCheck(origin, dir, min, max),
+        tree.IntersectCheck(origin, dir, min, max));
+
+    EXPECT_EQ(bvh.IntersectAll(origin, dir, min, max, indices),
+        tree.IntersectAll(origin, dir, min, max, ids));
+    std::sort(indices.begin(), indices.end());
+    std::sort(ids.begin(), ids.end());
+    EXPECT_EQ(indices, ids);
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(LooseOctreeTest, Visible)
+{
+  math::LooseOctree tree(math::AxisAlignedBox(-50, -50, -50, 50, 50, 50));
+  std::vector<math::AxisAlignedBox> boxes;
+  RandomTree(tree, boxes);
+
+  std::vector<std::size_t> ids;
+  for (int q = 0; q < 50; ++q)
+  {
+    const math::Pose3d pose(RandomVector(60),
+        math::Quaterniond(RandomVector(IGN_PI)));
+    const math::Frustum frustum(0.5, q % 2 == 0 ? 40 : 150,
+        math::Angle(IGN_DTOR(q % 3 == 0 ? 30 : 90)), 1.5, pose);
+
+    std::vector<std::size_t> expected;
+    for (std::size_t i = 0; i < boxes.size(); ++i)
+    {
+      if (tree.Has(i) && frustum.Contains(boxes[i]))
+        expected.push_back(i);
+    }
+
+    EXPECT_EQ(!expected.empty(), tree.Visible(frustum, ids));
+    std::sort(ids.begin(), ids.end());
+    EXPECT_EQ(expected, ids);
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(LooseOctreeTest, ManyUpdates)
+{
+  // Boxes moving in small steps, leaving and entering the region
+  math::LooseOctree tree(math::AxisAlignedBox(-10, -10, -10, 10, 10, 10), 6);
+  std::vector<math::AxisAlignedBox> boxes;
+  std::vector<math::Vector3d> vel;
+  for (int i = 0; i < 500; ++i)
+  {
+    boxes.push_back(RandomBox(10, 0.5));
+    vel.push_back(RandomVector(0.3));
+    tree.Insert(boxes.back());
+  }
+
+  std::vector<std::size_t> ids;
+  for (int step = 0; step < 100; ++step)
+  {
+    for (std::size_t i = 0; i < boxes.size(); ++i)
+    {
+      if (std::abs(boxes[i].Center().X()) > 12)
+        vel[i].X(-vel[i].X());
+      boxes[i] = math::AxisAlignedBox(boxes[i].Min() + vel[i],
+          boxes[i].Max() + vel[i]);
+      EXPECT_TRUE(tree.Update(i, boxes[i]));
+    }
+
+    const math::AxisAlignedBox query = RandomBox(10, 6);
+    std::vector<std::size_t> expected;
+    for (std::size_t i = 0; i < boxes.size(); ++i)
+    {
+      if (boxes[i].Intersects(query))
+        expected.push_back(i);
+    }
+    tree.Overlap(query, ids);
+    std::sort(ids.begin(), ids.end());
+    EXPECT_EQ(expected, ids);
+  }
+  EXPECT_EQ(boxes.size(), tree.Size());
+}
+
+/////////////////////////////////////////////////
+TEST(LooseOctreeTest, Copy)
+{
+  math::LooseOctree tree(math::AxisAlignedBox(-50, -50, -50, 50, 50, 50));
+  std::vector<math::AxisAlignedBox> boxes;
+  RandomTree(tree, boxes);
+
+  const math::LooseOctree copy(tree);
+  math::LooseOctree assigned(math::AxisAlignedBox(0, 0, 0, 1, 1, 1), 2);
+  assigned = tree;
+
+  // Changes to the original do not affect the copies
+  const math::AxisAlignedBox query(-10, -10, -10, 10, 10, 10);
+  std::vector<std::size_t> expected;
+  tree.Overlap(query, expected);
+  tree.Clear();
+
+  std::vector<std::size_t> ids;
+  EXPECT_FALSE(tree.Overlap(query, ids));
+  copy.Overlap(query, ids);
+  EXPECT_EQ(expected, ids);
+  assigned.Overlap(query, ids);
+  EXPECT_EQ(expected, ids);
+  EXPECT_EQ(copy.Size(), assigned.Size());
+  EXPECT_EQ(copy.NodeCount(), assigned.NodeCount());
+  EXPECT_EQ(copy.Region(), assigned.Region());
+}
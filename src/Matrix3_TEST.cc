@@ -398,3 +398,20 @@ TEST(Matrix3dTest, From2Axes)
   m1.From2Axes(v1, v2);
   EXPECT_EQ(math::Matrix3d::Zero - math::Matrix3d::Identity, m1);
 }
+
+/////////////////////////////////////////////////
+TEST(Matrix3dTest, Constexpr)
+{
+  const math::Matrix3d m1 = math::Matrix3d::Identity * 2.0;
+  const double det = m1.Determinant();
+  EXPECT_DOUBLE_EQ(det, 8.0);
+  EXPECT_EQ(m1.Inverse(), math::Matrix3d::Identity * 0.5);
+
+#ifdef IGNITION_MATH_POD_TYPES
+  constexpr math::Matrix3d m2 = math::Matrix3d::Identity * 2.0;
+  static_assert(static_cast<int>(m2.Determinant()) == 8, "");
+  static_assert(static_cast<int>((m2 * math::Vector3d(1, 2, 3)).Z()) == 6,
+      "");
+  static_assert(static_cast<int>(m2.Transposed()(1, 1)) == 2, "");
+#endif
+}
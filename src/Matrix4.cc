@@ -0,0 +1,327 @@
+/*
+ * Copyright (C) 2018 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <algorithm>
+
+#include "ignition/math/Matrix4.hh"
+#include "ignition/math/SimdDispatch.hh"
+#include "ignition/math/Vector3Array.hh"
+#include "Matrix4Kernels.hh"
+#include "SimdPack.hh"
+
+using namespace ignition;
+using namespace math;
+
+namespace
+{
+  //////////////////////////////////////////////////
+  template<typename T>
+  void MultiplyScalar(const T *_a, const T *_b, T *_out,
+      const std::size_t _stride, const std::size_t _n)
+  {
+    detail::Matrix4ScalarKernels<T>::MultiplyBatch(
+        reinterpret_cast<const T (*)[4]>(_a), _b, _out, _stride, _n);
+  }
+
+  //////////////////////////////////////////////////
+  template<typename T>
+  void InverseScalar(const T *_m, T *_out, const std::size_t _stride,
+      const std::size_t _n)
+  {
+    detail::Matrix4ScalarKernels<T>::InverseBatch(_m, _out, _stride, _n);
+  }
+
+  //////////////////////////////////////////////////
+  /// \brief Transform points with the SoA kernel of Vector3Array, which
+  /// uses the instruction sets enabled at compile time.
+  template<typename T>
+  void TransformPointsBaseline(const T *_m, const T *_x, const T *_y,
+      const T *_z, T *_outX, T *_outY, T *_outZ, const std::size_t _n)
+  {
+    const Matrix3<T> rot(_m[0], _m[1], _m[2],
+                         _m[4], _m[5], _m[6],
+                         _m[8], _m[9], _m[10]);
+    const Vector3<T> translation(_m[3], _m[7], _m[11]);
+    detail::Vector3ArrayKernels<T>::Transform({_x, _y, _z}, rot,
+        Vector3<T>::Zero, translation, {_outX, _outY, _outZ}, _n);
+  }
+
+#ifdef IGNITION_MATH_SIMD_SSE2
+  //////////////////////////////////////////////////
+  /// \brief Product of two float matrices with SSE. The sums are computed
+  /// in the same order as Matrix4ScalarKernels::Multiply, so the result is
+  /// the same. _b is read before _out is written.
+  void MultiplySse(const float *_a, const float *_b, float *_out)
+  {
+    const __m128 b0 = _mm_loadu_ps(_b);
+    const __m128 b1 = _mm_loadu_ps(_b + 4);
+    const __m128 b2 = _mm_loadu_ps(_b + 8);
+    const __m128 b3 = _mm_loadu_ps(_b + 12);
+    for (int i = 0; i < 16; i += 4)
+    {
+      __m128 r = _mm_mul_ps(_mm_set1_ps(_a[i]), b0);
+      r = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(_a[i + 1]), b1));
+      r = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(_a[i + 2]), b2));
+      r = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(_a[i + 3]), b3));
+      _mm_storeu_ps(_out + i, r);
+    }
+  }
+
+  //////////////////////////////////////////////////
+  /// \brief Product of two double matrices with SSE2, each row being
+  /// split in two registers. _b is read before _out is written.
+  void MultiplySse(const double *_a, const double *_b, double *_out)
+  {
+    __m128d b[8];
+    for (int k = 0; k < 8; ++k)
+      b[k] = _mm_loadu_pd(_b + 2 * k);
+
+    for (int i = 0; i < 16; i += 4)
+    {
+      __m128d lo = _mm_mul_pd(_mm_set1_pd(_a[i]), b[0]);
+      __m128d hi = _mm_mul_pd(_mm_set1_pd(_a[i]), b[1]);
+      for (int k = 1; k < 4; ++k)
+      {
+        const __m128d a = _mm_set1_pd(_a[i + k]);
+        lo = _mm_add_pd(lo, _mm_mul_pd(a, b[2 * k]));
+        hi = _mm_add_pd(hi, _mm_mul_pd(a, b[2 * k + 1]));
+      }
+      _mm_storeu_pd(_out + i, lo);
+      _mm_storeu_pd(_out + i + 2, hi);
+    }
+  }
+
+  //////////////////////////////////////////////////
+  /// \brief Apply a product kernel to a set of matrices. The kernel must
+  /// read the whole right hand side matrix before it writes the product.
+  /// _a is copied first, since it may be one of the products.
+  template<typename T>
+  void MultiplySseBatch(const T *_a, const T *_b, T *_out,
+      const std::size_t _stride, const std::size_t _n)
+  {
+    T a[16];
+    std::copy(_a, _a + 16, a);
+    for (std::size_t i = 0; i < _n; ++i)
+      MultiplySse(a, _b + i * _stride, _out + i * _stride);
+  }
+
+  //////////////////////////////////////////////////
+  /// \brief Permute the lanes of a register: lane k of the result is lane
+  /// Ik of _v.
+  template<int I0, int I1, int I2, int I3>
+  __m128 Permute(const __m128 _v)
+  {
+    return _mm_shuffle_ps(_v, _v, _MM_SHUFFLE(I3, I2, I1, I0));
+  }
+
+  //////////////////////////////////////////////////
+  /// \brief Inverse of a float matrix with SSE. The cofactors are grouped
+  /// so that each row of the adjugate matrix is computed with a few
+  /// register operations: with c_k the k-th column of the matrix, the
+  /// 2x2 minors are products of the permutations A_k = (c_k[2], c_k[2],
+  /// c_k[1], c_k[1]) and B_k = (c_k[3], c_k[3], c_k[3], c_k[2]).
+  void InverseSse(const float *_m, float *_out)
+  {
+    __m128 c0 = _mm_loadu_ps(_m);
+    __m128 c1 = _mm_loadu_ps(_m + 4);
+    __m128 c2 = _mm_loadu_ps(_m + 8);
+    __m128 c3 = _mm_loadu_ps(_m + 12);
+    _MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+
+    const __m128 a0 = Permute<2, 2, 1, 1>(c0);
+    const __m128 a1 = Permute<2, 2, 1, 1>(c1);
+    const __m128 a2 = Permute<2, 2, 1, 1>(c2);
+    const __m128 a3 = Permute<2, 2, 1, 1>(c3);
+    const __m128 b0 = Permute<3, 3, 3, 2>(c0);
+    const __m128 b1 = Permute<3, 3, 3, 2>(c1);
+    const __m128 b2 = Permute<3, 3, 3, 2>(c2);
+    const __m128 b3 = Permute<3, 3, 3, 2>(c3);
+
+    const __m128 f0 = _mm_sub_ps(_mm_mul_ps(a2, b3), _mm_mul_ps(b2, a3));
+    const __m128 f1 = _mm_sub_ps(_mm_mul_ps(a1, b3), _mm_mul_ps(b1, a3));
+    const __m128 f2 = _mm_sub_ps(_mm_mul_ps(a1, b2), _mm_mul_ps(b1, a2));
+    const __m128 f3 = _mm_sub_ps(_mm_mul_ps(a0, b3), _mm_mul_ps(b0, a3));
+    const __m128 f4 = _mm_sub_ps(_mm_mul_ps(a0, b2), _mm_mul_ps(b0, a2));
+    const __m128 f5 = _mm_sub_ps(_mm_mul_ps(a0, b1), _mm_mul_ps(b0, a1));
+
+    const __m128 v0 = Permute<1, 0, 0, 0>(c0);
+    const __m128 v1 = Permute<1, 0, 0, 0>(c1);
+    const __m128 v2 = Permute<1, 0, 0, 0>(c2);
+    const __m128 v3 = Permute<1, 0, 0, 0>(c3);
+
+    const __m128 signA = _mm_setr_ps(1, -1, 1, -1);
+    const __m128 signB = _mm_setr_ps(-1, 1, -1, 1);
+    const __m128 r0 = _mm_mul_ps(signA, _mm_add_ps(_mm_sub_ps(
+            _mm_mul_ps(v1, f0), _mm_mul_ps(v2, f1)), _mm_mul_ps(v3, f2)));
+    const __m128 r1 = _mm_mul_ps(signB, _mm_add_ps(_mm_sub_ps(
+            _mm_mul_ps(v0, f0), _mm_mul_ps(v2, f3)), _mm_mul_ps(v3, f4)));
+    const __m128 r2 = _mm_mul_ps(signA, _mm_add_ps(_mm_sub_ps(
+            _mm_mul_ps(v0, f1), _mm_mul_ps(v1, f3)), _mm_mul_ps(v3, f5)));
+    const __m128 r3 = _mm_mul_ps(signB, _mm_add_ps(_mm_sub_ps(
+            _mm_mul_ps(v0, f2), _mm_mul_ps(v1, f4)), _mm_mul_ps(v2, f5)));
+
+    // The determinant is the dot product of the first row of the adjugate
+    // and the first column of the matrix.
+    __m128 det = _mm_mul_ps(r0, c0);
+    det = _mm_add_ps(det, Permute<2, 3, 0, 1>(det));
+    det = _mm_add_ps(det, Permute<1, 0, 3, 2>(det));
+    const __m128 invDet = _mm_div_ps(_mm_set1_ps(1.0f), det);
+
+    _mm_storeu_ps(_out, _mm_mul_ps(r0, invDet));
+    _mm_storeu_ps(_out + 4, _mm_mul_ps(r1, invDet));
+    _mm_storeu_ps(_out + 8, _mm_mul_ps(r2, invDet));
+    _mm_storeu_ps(_out + 12, _mm_mul_ps(r3, invDet));
+  }
+
+  //////////////////////////////////////////////////
+  /// \brief Invert a set of float matrices with SSE. Each matrix is read
+  /// before its inverse is written.
+  void InverseSseBatch(const float *_m, float *_out,
+      const std::size_t _stride, const std::size_t _n)
+  {
+    for (std::size_t i = 0; i < _n; ++i)
+      InverseSse(_m + i * _stride, _out + i * _stride);
+  }
+#endif
+
+  //////////////////////////////////////////////////
+  /// \brief Kernels that only use the instruction sets enabled at compile
+  /// time.
+  template<typename T>
+  simd::Matrix4KernelTable<T> BaselineKernels()
+  {
+#ifdef IGNITION_MATH_SIMD_SSE2
+    return {MultiplySseBatch<T>, InverseScalar<T>,
+            TransformPointsBaseline<T>};
+#else
+    return {MultiplyScalar<T>, InverseScalar<T>, TransformPointsBaseline<T>};
+#endif
+  }
+
+  //////////////////////////////////////////////////
+  template<>
+  simd::Matrix4KernelTable<float> BaselineKernels<float>()
+  {
+#ifdef IGNITION_MATH_SIMD_SSE2
+    return {MultiplySseBatch<float>, InverseSseBatch,
+            TransformPointsBaseline<float>};
+#else
+    return {MultiplyScalar<float>, InverseScalar<float>,
+            TransformPointsBaseline<float>};
+#endif
+  }
+
+  //////////////////////////////////////////////////
+  /// \brief Number of values of SimdLevel
+  const int kLevelCount = static_cast<int>(SimdLevel::AVX512) + 1;
+
+  //////////////////////////////////////////////////
+  /// \brief Build the kernels of each level. Kernels that are not
+  /// provided by an instruction set fall back to the level below.
+  /// \param[in] _tables Output tables, indexed by SimdLevel.
+  template<typename T>
+  void FillTables(simd::Matrix4KernelTable<T> *_tables)
+  {
+    const int supported = static_cast<int>(SimdDispatch::SupportedLevel());
+
+    _tables[static_cast<int>(SimdLevel::SCALAR)] =
+      {MultiplyScalar<T>, InverseScalar<T>, TransformPointsBaseline<T>};
+    for (int i = 1; i < kLevelCount; ++i)
+      _tables[i] = _tables[i - 1];
+
+    const int sse2 = static_cast<int>(SimdLevel::SSE2);
+    if (sse2 <= supported)
+    {
+      for (int i = sse2; i < kLevelCount; ++i)
+        _tables[i] = BaselineKernels<T>();
+    }
+
+    const simd::Matrix4KernelTable<T> *avx2 = simd::Matrix4Avx2Kernels<T>();
+    if (avx2 && static_cast<int>(SimdLevel::AVX2) <= supported)
+    {
+      for (int i = static_cast<int>(SimdLevel::AVX2); i < kLevelCount; ++i)
+      {
+        if (avx2->multiply)
+          _tables[i].multiply = avx2->multiply;
+        if (avx2->inverse)
+          _tables[i].inverse = avx2->inverse;
+        if (avx2->transformPoints)
+          _tables[i].transformPoints = avx2->transformPoints;
+      }
+    }
+  }
+
+  //////////////////////////////////////////////////
+  /// \brief Kernels used by Matrix4Kernels, those of the level selected
+  /// by SimdDispatch.
+  template<typename T>
+  const simd::Matrix4KernelTable<T> &Kernels()
+  {
+    struct Tables
+    {
+      Tables() { FillTables<T>(this->level); }
+      simd::Matrix4KernelTable<T> level[kLevelCount];
+    };
+    static const Tables tables;
+    return tables.level[static_cast<int>(SimdDispatch::ActiveLevel())];
+  }
+}  // namespace
+
+//////////////////////////////////////////////////
+void detail::Matrix4Kernels<float>::MultiplyBatch(const float _a[4][4],
+    const float *_b, float *_out, const std::size_t _stride,
+    const std::size_t _n)
+{
+  Kernels<float>().multiply(_a[0], _b, _out, _stride, _n);
+}
+
+//////////////////////////////////////////////////
+void detail::Matrix4Kernels<float>::InverseBatch(const float *_m,
+    float *_out, const std::size_t _stride, const std::size_t _n)
+{
+  Kernels<float>().inverse(_m, _out, _stride, _n);
+}
+
+//////////////////////////////////////////////////
+void detail::Matrix4Kernels<float>::TransformPoints(const float _m[4][4],
+    ConstSoa3<float> _in, Soa3<float> _out, const std::size_t _n)
+{
+  Kernels<float>().transformPoints(_m[0], _in.x, _in.y, _in.z,
+      _out.x, _out.y, _out.z, _n);
+}
+
+//////////////////////////////////////////////////
+void detail::Matrix4Kernels<double>::MultiplyBatch(const double _a[4][4],
+    const double *_b, double *_out, const std::size_t _stride,
+    const std::size_t _n)
+{
+  Kernels<double>().multiply(_a[0], _b, _out, _stride, _n);
+}
+
+//////////////////////////////////////////////////
+void detail::Matrix4Kernels<double>::InverseBatch(const double *_m,
+    double *_out, const std::size_t _stride, const std::size_t _n)
+{
+  Kernels<double>().inverse(_m, _out, _stride, _n);
+}
+
+//////////////////////////////////////////////////
+void detail::Matrix4Kernels<double>::TransformPoints(const double _m[4][4],
+    ConstSoa3<double> _in, Soa3<double> _out, const std::size_t _n)
+{
+  Kernels<double>().transformPoints(_m[0], _in.x, _in.y, _in.z,
+      _out.x, _out.y, _out.z, _n);
+}
@@ -0,0 +1,266 @@
+/*
+ * Copyright (C) 2018 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+// This file is compiled with AVX2 and FMA enabled. Its kernels are only
+// called after checking that the CPU supports them, see Matrix4.cc.
+
+// MSVC enables FMA with /arch:AVX2 but does not define __FMA__
+#if defined(__AVX2__) && (defined(__FMA__) || defined(_MSC_VER))
+#define IGNITION_MATH_MATRIX4_AVX2
+#include <immintrin.h>
+#endif
+
+#include <cstddef>
+
+#include "Matrix4Kernels.hh"
+
+using namespace ignition;
+using namespace math;
+
+#ifdef IGNITION_MATH_MATRIX4_AVX2
+namespace
+{
+  //////////////////////////////////////////////////
+  /// \brief Product of two float matrices. _b is read before _out is
+  /// written.
+  void Multiply(const float *_a, const float *_b, float *_out)
+  {
+    const __m128 b0 = _mm_loadu_ps(_b);
+    const __m128 b1 = _mm_loadu_ps(_b + 4);
+    const __m128 b2 = _mm_loadu_ps(_b + 8);
+    const __m128 b3 = _mm_loadu_ps(_b + 12);
+    for (int i = 0; i < 16; i += 4)
+    {
+      __m128 r = _mm_mul_ps(_mm_set1_ps(_a[i]), b0);
+      r = _mm_fmadd_ps(_mm_set1_ps(_a[i + 1]), b1, r);
+      r = _mm_fmadd_ps(_mm_set1_ps(_a[i + 2]), b2, r);
+      r = _mm_fmadd_ps(_mm_set1_ps(_a[i + 3]), b3, r);
+      _mm_storeu_ps(_out + i, r);
+    }
+  }
+
+  //////////////////////////////////////////////////
+  /// \brief Product of two double matrices. _b is read before _out is
+  /// written.
+  void Multiply(const double *_a, const double *_b, double *_out)
+  {
+    const __m256d b0 = _mm256_loadu_pd(_b);
+    const __m256d b1 = _mm256_loadu_pd(_b + 4);
+    const __m256d b2 = _mm256_loadu_pd(_b + 8);
+    const __m256d b3 = _mm256_loadu_pd(_b + 12);
+    for (int i = 0; i < 16; i += 4)
+    {
+      __m256d r = _mm256_mul_pd(_mm256_set1_pd(_a[i]), b0);
+      r = _mm256_fmadd_pd(_mm256_set1_pd(_a[i + 1]), b1, r);
+      r = _mm256_fmadd_pd(_mm256_set1_pd(_a[i + 2]), b2, r);
+      r = _mm256_fmadd_pd(_mm256_set1_pd(_a[i + 3]), b3, r);
+      _mm256_storeu_pd(_out + i, r);
+    }
+  }
+
+  //////////////////////////////////////////////////
+  /// \brief Multiply a matrix by a set of matrices. _a is copied first,
+  /// since it may be one of the products.
+  template<typename T>
+  void MultiplyBatch(const T *_a, const T *_b, T *_out,
+      const std::size_t _stride, const std::size_t _n)
+  {
+    T a[16];
+    for (int k = 0; k < 16; ++k)
+      a[k] = _a[k];
+    for (std::size_t i = 0; i < _n; ++i)
+      Multiply(a, _b + i * _stride, _out + i * _stride);
+  }
+
+  //////////////////////////////////////////////////
+  /// \brief Permute the lanes of a register: lane k of the result is lane
+  /// Ik of _v.
+  template<int I0, int I1, int I2, int I3>
+  __m256d Permute(const __m256d _v)
+  {
+    return _mm256_permute4x64_pd(_v, _MM_SHUFFLE(I3, I2, I1, I0));
+  }
+
+  //////////////////////////////////////////////////
+  /// \brief Inverse of a double matrix, with the same algorithm as the
+  /// float SSE version in Matrix4.cc.
+  void InverseDouble(const double *_m, double *_out)
+  {
+    const __m256d m0 = _mm256_loadu_pd(_m);
+    const __m256d m1 = _mm256_loadu_pd(_m + 4);
+    const __m256d m2 = _mm256_loadu_pd(_m + 8);
+    const __m256d m3 = _mm256_loadu_pd(_m + 12);
+
+    // Transpose
+    const __m256d t0 = _mm256_unpacklo_pd(m0, m1);
+    const __m256d t1 = _mm256_unpackhi_pd(m0, m1);
+    const __m256d t2 = _mm256_unpacklo_pd(m2, m3);
+    const __m256d t3 = _mm256_unpackhi_pd(m2, m3);
+    const __m256d c0 = _mm256_permute2f128_pd(t0, t2, 0x20);
+    const __m256d c1 = _mm256_permute2f128_pd(t1, t3, 0x20);
+    const __m256d c2 = _mm256_permute2f128_pd(t0, t2, 0x31);
+    const __m256d c3 = _mm256_permute2f128_pd(t1, t3, 0x31);
+
+    const __m256d a0 = Permute<2, 2, 1, 1>(c0);
+    const __m256d a1 = Permute<2, 2, 1, 1>(c1);
+    const __m256d a2 = Permute<2, 2, 1, 1>(c2);
+    const __m256d a3 = Permute<2, 2, 1, 1>(c3);
+    const __m256d b0 = Permute<3, 3, 3, 2>(c0);
+    const __m256d b1 = Permute<3, 3, 3, 2>(c1);
+    const __m256d b2 = Permute<3, 3, 3, 2>(c2);
+    const __m256d b3 = Permute<3, 3, 3, 2>(c3);
+
+    const __m256d f0 = _mm256_fmsub_pd(a2, b3, _mm256_mul_pd(b2, a3));
+    const __m256d f1 = _mm256_fmsub_pd(a1, b3, _mm256_mul_pd(b1, a3));
+    const __m256d f2 = _mm256_fmsub_pd(a1, b2, _mm256_mul_pd(b1, a2));
+    const __m256d f3 = _mm256_fmsub_pd(a0, b3, _mm256_mul_pd(b0, a3));
+    const __m256d f4 = _mm256_fmsub_pd(a0, b2, _mm256_mul_pd(b0, a2));
+    const __m256d f5 = _mm256_fmsub_pd(a0, b1, _mm256_mul_pd(b0, a1));
+
+    const __m256d v0 = Permute<1, 0, 0, 0>(c0);
+    const __m256d v1 = Permute<1, 0, 0, 0>(c1);
+    const __m256d v2 = Permute<1, 0, 0, 0>(c2);
+    const __m256d v3 = Permute<1, 0, 0, 0>(c3);
+
+    const __m256d signA = _mm256_setr_pd(1, -1, 1, -1);
+    const __m256d signB = _mm256_setr_pd(-1, 1, -1, 1);
+    const __m256d r0 = _mm256_mul_pd(signA, _mm256_fmadd_pd(v3, f2,
+          _mm256_fnmadd_pd(v2, f1, _mm256_mul_pd(v1, f0))));
+    const __m256d r1 = _mm256_mul_pd(signB, _mm256_fmadd_pd(v3, f4,
+          _mm256_fnmadd_pd(v2, f3, _mm256_mul_pd(v0, f0))));
+    const __m256d r2 = _mm256_mul_pd(signA, _mm256_fmadd_pd(v3, f5,
+          _mm256_fnmadd_pd(v1, f3, _mm256_mul_pd(v0, f1))));
+    const __m256d r3 = _mm256_mul_pd(signB, _mm256_fmadd_pd(v2, f5,
+          _mm256_fnmadd_pd(v1, f4, _mm256_mul_pd(v0, f2))));
+
+    __m256d det = _mm256_mul_pd(r0, c0);
+    det = _mm256_add_pd(det, Permute<2, 3, 0, 1>(det));
+    det = _mm256_add_pd(det, Permute<1, 0, 3, 2>(det));
+    const __m256d invDet = _mm256_div_pd(_mm256_set1_pd(1.0), det);
+
+    _mm256_storeu_pd(_out, _mm256_mul_pd(r0, invDet));
+    _mm256_storeu_pd(_out + 4, _mm256_mul_pd(r1, invDet));
+    _mm256_storeu_pd(_out + 8, _mm256_mul_pd(r2, invDet));
+    _mm256_storeu_pd(_out + 12, _mm256_mul_pd(r3, invDet));
+  }
+
+  //////////////////////////////////////////////////
+  /// \brief Invert a set of double matrices. Each matrix is read before
+  /// its inverse is written.
+  void InverseDoubleBatch(const double *_m, double *_out,
+      const std::size_t _stride, const std::size_t _n)
+  {
+    for (std::size_t i = 0; i < _n; ++i)
+      InverseDouble(_m + i * _stride, _out + i * _stride);
+  }
+
+  //////////////////////////////////////////////////
+  void TransformPointsFloat(const float *_m, const float *_x,
+      const float *_y, const float *_z, float *_outX, float *_outY,
+      float *_outZ, const std::size_t _n)
+  {
+    __m256 m[12];
+    for (int k = 0; k < 12; ++k)
+      m[k] = _mm256_set1_ps(_m[k]);
+
+    std::size_t i = 0;
+    for (; i + 8 <= _n; i += 8)
+    {
+      const __m256 x = _mm256_loadu_ps(_x + i);
+      const __m256 y = _mm256_loadu_ps(_y + i);
+      const __m256 z = _mm256_loadu_ps(_z + i);
+      _mm256_storeu_ps(_outX + i, _mm256_fmadd_ps(m[0], x,
+            _mm256_fmadd_ps(m[1], y, _mm256_fmadd_ps(m[2], z, m[3]))));
+      _mm256_storeu_ps(_outY + i, _mm256_fmadd_ps(m[4], x,
+            _mm256_fmadd_ps(m[5], y, _mm256_fmadd_ps(m[6], z, m[7]))));
+      _mm256_storeu_ps(_outZ + i, _mm256_fmadd_ps(m[8], x,
+            _mm256_fmadd_ps(m[9], y, _mm256_fmadd_ps(m[10], z, m[11]))));
+    }
+
+    for (; i < _n; ++i)
+    {
+      const float x = _x[i];
+      const float y = _y[i];
+      const float z = _z[i];
+      _outX[i] = _m[0]*x + _m[1]*y + _m[2]*z + _m[3];
+      _outY[i] = _m[4]*x + _m[5]*y + _m[6]*z + _m[7];
+      _outZ[i] = _m[8]*x + _m[9]*y + _m[10]*z + _m[11];
+    }
+  }
+
+  //////////////////////////////////////////////////
+  void TransformPointsDouble(const double *_m, const double *_x,
+      const double *_y, const double *_z, double *_outX, double *_outY,
+      double *_outZ, const std::size_t _n)
+  {
+    __m256d m[12];
+    for (int k = 0; k < 12; ++k)
+      m[k] = _mm256_set1_pd(_m[k]);
+
+    std::size_t i = 0;
+    for (; i + 4 <= _n; i += 4)
+    {
+      const __m256d x = _mm256_loadu_pd(_x + i);
+      const __m256d y = _mm256_loadu_pd(_y + i);
+      const __m256d z = _mm256_loadu_pd(_z + i);
+      _mm256_storeu_pd(_outX + i, _mm256_fmadd_pd(m[0], x,
+            _mm256_fmadd_pd(m[1], y, _mm256_fmadd_pd(m[2], z, m[3]))));
+      _mm256_storeu_pd(_outY + i, _mm256_fmadd_pd(m[4], x,
+            _mm256_fmadd_pd(m[5], y, _mm256_fmadd_pd(m[6], z, m[7]))));
+      _mm256_storeu_pd(_outZ + i, _mm256_fmadd_pd(m[8], x,
+            _mm256_fmadd_pd(m[9], y, _mm256_fmadd_pd(m[10], z, m[11]))));
+    }
+
+    for (; i < _n; ++i)
+    {
+      const double x = _x[i];
+      const double y = _y[i];
+      const double z = _z[i];
+      _outX[i] = _m[0]*x + _m[1]*y + _m[2]*z + _m[3];
+      _outY[i] = _m[4]*x + _m[5]*y + _m[6]*z + _m[7];
+      _outZ[i] = _m[8]*x + _m[9]*y + _m[10]*z + _m[11];
+    }
+  }
+}  // namespace
+#endif
+
+//////////////////////////////////////////////////
+template<>
+const simd::Matrix4KernelTable<float> *simd::Matrix4Avx2Kernels<float>()
+{
+#ifdef IGNITION_MATH_MATRIX4_AVX2
+  // The SSE inverse of Matrix4.cc is used, it has no AVX2 version.
+  static const Matrix4KernelTable<float> table =
+      {MultiplyBatch<float>, nullptr, TransformPointsFloat};
+  return &table;
+#else
+  return nullptr;
+#endif
+}
+
+//////////////////////////////////////////////////
+template<>
+const simd::Matrix4KernelTable<double> *simd::Matrix4Avx2Kernels<double>()
+{
+#ifdef IGNITION_MATH_MATRIX4_AVX2
+  static const Matrix4KernelTable<double> table =
+      {MultiplyBatch<double>, InverseDoubleBatch, TransformPointsDouble};
+  return &table;
+#else
+  return nullptr;
+#endif
+}
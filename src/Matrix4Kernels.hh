@@ -0,0 +1,79 @@
+/*
+ * Copyright (C) 2018 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef IGNITION_MATH_MATRIX4KERNELS_HH_
+#define IGNITION_MATH_MATRIX4KERNELS_HH_
+
+#include <cstddef>
+
+#include <ignition/math/config.hh>
+
+// This header is included by translation units compiled with instruction
+// sets that are not always available at runtime. It must not include
+// headers that define inline functions, since the linker could otherwise
+// keep a copy of those functions that uses unsupported instructions.
+
+namespace ignition
+{
+  namespace math
+  {
+    inline namespace IGNITION_MATH_VERSION_NAMESPACE
+    {
+    namespace simd
+    {
+    /// \internal
+    /// \brief Set of Matrix4 kernels compiled for one instruction set.
+    /// Matrices are stored as 16 values in row-major order, and the
+    /// matrices of a set are _stride values apart. A null entry means that
+    /// the instruction set has no specific version of the kernel.
+    template<typename T>
+    struct Matrix4KernelTable
+    {
+      /// \brief _out[i] = _a * _b[i] for _n matrices. _out may be _b, and
+      /// _a may be one of the matrices of _out.
+      void (*multiply)(const T *_a, const T *_b, T *_out,
+          std::size_t _stride, std::size_t _n);
+
+      /// \brief _out[i] = inverse of _m[i] for _n matrices. _out may be
+      /// _m.
+      void (*inverse)(const T *_m, T *_out, std::size_t _stride,
+          std::size_t _n);
+
+      /// \brief Apply the upper three rows of _m to _n points stored as
+      /// arrays of x, y and z values. The output arrays may be the input
+      /// arrays.
+      void (*transformPoints)(const T *_m, const T *_x, const T *_y,
+          const T *_z, T *_outX, T *_outY, T *_outZ, std::size_t _n);
+    };
+
+    /// \internal
+    /// \brief Get the kernels compiled for AVX2 and FMA.
+    /// \return The kernels, or nullptr if the library was built without
+    /// them. The caller must check that the CPU supports AVX2 before
+    /// using them.
+    template<typename T>
+    const Matrix4KernelTable<T> *Matrix4Avx2Kernels();
+
+    template<>
+    const Matrix4KernelTable<float> *Matrix4Avx2Kernels<float>();
+
+    template<>
+    const Matrix4KernelTable<double> *Matrix4Avx2Kernels<double>();
+    }
+    }
+  }
+}
+#endif
@@ -17,10 +17,16 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
 #include "ignition/math/Pose3.hh"
 #include "ignition/math/Quaternion.hh"
 #include "ignition/math/Matrix4.hh"
+#include "ignition/math/Rand.hh"
 #include "ignition/math/Vector3.hh"
+#include "ignition/math/Vector3Array.hh"
 
 using namespace ignition;
 
@@ -658,3 +664,189 @@ TEST(Matrix4dTest, LookAt)
             math::Pose3d(1, 1, 1, IGN_PI_4, 0, IGN_PI));
 }
 
+
+/////////////////////////////////////////////////
+template<typename T>
+math::Matrix4<T> RandomMatrix4()
+{
+  math::Matrix4<T> mat;
+  for (int i = 0; i < 4; ++i)
+  {
+    for (int j = 0; j < 4; ++j)
+      mat(i, j) = static_cast<T>(math::Rand::DblUniform(-2, 2));
+  }
+  return mat;
+}
+
+/////////////////////////////////////////////////
+template<typename T>
+class Matrix4KernelsTest : public ::testing::Test
+{
+};
+
+typedef ::testing::Types<float, double> FloatTypes;
+TYPED_TEST_CASE(Matrix4KernelsTest, FloatTypes);
+
+/////////////////////////////////////////////////
+TYPED_TEST(Matrix4KernelsTest, MultiplyInverse)
+{
+  typedef TypeParam T;
+  const T tol = static_cast<T>(sizeof(T) == sizeof(float) ? 1e-4 : 1e-12);
+
+  // Skip badly conditioned matrices, where all the inverses are
+  // inaccurate
+  std::vector<math::Matrix4<T>> matrices;
+  while (matrices.size() < 100)
+  {
+    const math::Matrix4<T> mat = RandomMatrix4<T>();
+    if (std::abs(mat.Determinant()) >= 0.1)
+      matrices.push_back(mat);
+  }
+  const math::Matrix4<T> left = RandomMatrix4<T>();
+
+  // The batch functions use the SIMD kernels selected at runtime, see
+  // IGN_MATH_SIMD_LEVEL, and match the functions on a single matrix
+  std::vector<math::Matrix4<T>> products;
+  left.Multiply(matrices, products);
+  ASSERT_EQ(matrices.size(), products.size());
+  for (std::size_t i = 0; i < matrices.size(); ++i)
+    EXPECT_TRUE(products[i].Equal(left * matrices[i], tol));
+
+  std::vector<math::Matrix4<T>> inverses;
+  math::Matrix4<T>::Inverse(matrices, inverses);
+  ASSERT_EQ(matrices.size(), inverses.size());
+  for (std::size_t i = 0; i < matrices.size(); ++i)
+  {
+    // The rounding error grows with the magnitude of the inverse
+    const math::Matrix4<T> expected = matrices[i].Inverse();
+    T scale = 1;
+    for (int r = 0; r < 4; ++r)
+    {
+      for (int c = 0; c < 4; ++c)
+        scale = std::max(scale, std::abs(expected(r, c)));
+    }
+    EXPECT_TRUE(inverses[i].Equal(expected, tol * scale));
+    EXPECT_TRUE((matrices[i] * inverses[i]).Equal(
+          math::Matrix4<T>::Identity, tol * scale * 10));
+  }
+
+  // In place, with the left hand side among the products
+  std::vector<math::Matrix4<T>> inPlace = matrices;
+  inPlace[0] = left;
+  inPlace[0].Multiply(inPlace, inPlace);
+  EXPECT_TRUE(inPlace[0].Equal(left * left, tol));
+  for (std::size_t i = 1; i < matrices.size(); ++i)
+    EXPECT_TRUE(inPlace[i].Equal(products[i], tol));
+
+  inPlace = matrices;
+  math::Matrix4<T>::Inverse(inPlace, inPlace);
+  for (std::size_t i = 0; i < matrices.size(); ++i)
+  {
+    for (int r = 0; r < 4; ++r)
+    {
+      for (int c = 0; c < 4; ++c)
+        EXPECT_EQ(inverses[i](r, c), inPlace[i](r, c));
+    }
+  }
+
+  const std::vector<math::Matrix4<T>> empty;
+  left.Multiply(empty, products);
+  EXPECT_TRUE(products.empty());
+  math::Matrix4<T>::Inverse(empty, inverses);
+  EXPECT_TRUE(inverses.empty());
+}
+
+/////////////////////////////////////////////////
+TYPED_TEST(Matrix4KernelsTest, TransformPoints)
+{
+  typedef TypeParam T;
+  const T tol = static_cast<T>(sizeof(T) == sizeof(float) ? 1e-5 : 1e-12);
+
+  math::Matrix4<T> mat(math::Pose3<T>(1, -2, 3, 0.1, 0.2, 0.3));
+  mat = mat * math::Matrix4<T>(2, 0.5, 0, 0,
+                               0, 1, 0, 0,
+                               0, 0, 3, 0,
+                               0, 0, 0, 1);
+
+  // Use a size that is not a multiple of any SIMD width
+  std::vector<math::Vector3<T>> points;
+  for (int i = 0; i < 37; ++i)
+  {
+    points.push_back(math::Vector3<T>(
+          static_cast<T>(math::Rand::DblUniform(-1, 1)),
+          static_cast<T>(math::Rand::DblUniform(-1, 1)),
+          static_cast<T>(math::Rand::DblUniform(-1, 1))));
+  }
+
+  std::vector<math::Vector3<T>> out;
+  mat.TransformPoints(points, out);
+  ASSERT_EQ(points.size(), out.size());
+  for (std::size_t i = 0; i < points.size(); ++i)
+    EXPECT_EQ(mat * points[i], out[i]);
+
+  math::Vector3Array<T> array(points);
+  math::Vector3Array<T> arrayOut;
+  array.Transform(mat, arrayOut);
+  ASSERT_EQ(points.size(), arrayOut.Size());
+  for (std::size_t i = 0; i < points.size(); ++i)
+    EXPECT_TRUE(arrayOut[i].Equal(mat * points[i], tol));
+
+  // In place
+  array.Transform(mat, array);
+  for (std::size_t i = 0; i < points.size(); ++i)
+    EXPECT_TRUE(array[i].Equal(mat * points[i], tol));
+
+  math::Vector3Array<T> empty;
+  empty.Transform(mat, arrayOut);
+  EXPECT_TRUE(arrayOut.Empty());
+}
+
+/////////////////////////////////////////////////
+TYPED_TEST(Matrix4KernelsTest, Affine)
+{
+  typedef TypeParam T;
+  const T tol = static_cast<T>(sizeof(T) == sizeof(float) ? 1e-5 : 1e-12);
+
+  for (int n = 0; n < 100; ++n)
+  {
+    const math::Pose3<T> poseA(
+        static_cast<T>(math::Rand::DblUniform(-10, 10)),
+        static_cast<T>(math::Rand::DblUniform(-10, 10)),
+        static_cast<T>(math::Rand::DblUniform(-10, 10)),
+        static_cast<T>(math::Rand::DblUniform(-IGN_PI, IGN_PI)),
+        static_cast<T>(math::Rand::DblUniform(-IGN_PI, IGN_PI)),
+        static_cast<T>(math::Rand::DblUniform(-IGN_PI, IGN_PI)));
+    const math::Matrix4<T> rigidA(poseA);
+
+    // Affine matrix with a scale and a shear
+    math::Matrix4<T> affine = rigidA * math::Matrix4<T>(
+        static_cast<T>(math::Rand::DblUniform(0.5, 2)), 0.25, 0, 0,
+        0, static_cast<T>(math::Rand::DblUniform(0.5, 2)), 0, 0,
+        0, 0, static_cast<T>(math::Rand::DblUniform(0.5, 2)), 0,
+        0, 0, 0, 1);
+    ASSERT_TRUE(affine.IsAffine());
+
+    // Same results as the general inverse
+    const math::Matrix4<T> inverse = affine.Inverse();
+    const math::Matrix4<T> affineInverse = affine.InverseAffine();
+    for (int i = 0; i < 4; ++i)
+    {
+      for (int j = 0; j < 4; ++j)
+        EXPECT_EQ(inverse(i, j), affineInverse(i, j));
+    }
+
+    // The rigid inverse is exact for the rotation
+    const math::Matrix4<T> rigidInverse = rigidA.InverseRigid();
+    EXPECT_TRUE(rigidInverse.IsAffine());
+    EXPECT_TRUE(rigidInverse.Equal(rigidA.Inverse(), tol * 10));
+    EXPECT_TRUE((rigidInverse * rigidA).Equal(
+          math::Matrix4<T>::Identity, tol * 10));
+    EXPECT_TRUE(math::Matrix4<T>(poseA.Inverse()).Equal(rigidInverse,
+          tol * 10));
+    for (int i = 0; i < 3; ++i)
+    {
+      for (int j = 0; j < 3; ++j)
+        EXPECT_EQ(rigidA(j, i), rigidInverse(i, j));
+    }
+  }
+}
@@ -0,0 +1,195 @@
+/*
+ * Copyright (C) 2018 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include "ignition/math/Matrix3.hh"
+#include "ignition/math/OrientedBoxPacket.hh"
+#include "ignition/math/detail/AlignedAllocator.hh"
+#include "BatchKernels.hh"
+
+using namespace ignition;
+using namespace math;
+
+// Private data for OrientedBoxPacket class
+class ignition::math::OrientedBoxPacketPrivate
+{
+  /// \brief Storage of one component of a vector of the boxes
+  public: typedef std::vector<double, detail::AlignedAllocator<double>>
+          Storage;
+
+  /// \brief Centers of the boxes
+  public: Storage center[3];
+
+  /// \brief Axes of the boxes, which are the columns of their rotation
+  /// matrices. axes[i][k] holds component i of axis k.
+  public: Storage axes[3][3];
+
+  /// \brief Half sizes of the boxes
+  public: Storage half[3];
+
+  /// \brief Rotations of the boxes, as w, x, y and z
+  public: Storage rot[4];
+};
+
+//////////////////////////////////////////////////
+OrientedBoxPacket::OrientedBoxPacket()
+: dataPtr(new OrientedBoxPacketPrivate)
+{
+}
+
+//////////////////////////////////////////////////
+OrientedBoxPacket::OrientedBoxPacket(const std::vector<OrientedBoxd> &_boxes)
+: dataPtr(new OrientedBoxPacketPrivate)
+{
+  this->Assign(_boxes);
+}
+
+//////////////////////////////////////////////////
+OrientedBoxPacket::OrientedBoxPacket(const OrientedBoxPacket &_packet)
+: dataPtr(new OrientedBoxPacketPrivate(*_packet.dataPtr))
+{
+}
+
+//////////////////////////////////////////////////
+OrientedBoxPacket::~OrientedBoxPacket()
+{
+}
+
+//////////////////////////////////////////////////
+OrientedBoxPacket &OrientedBoxPacket::operator=(
+    const OrientedBoxPacket &_packet)
+{
+  *this->dataPtr = *_packet.dataPtr;
+  return *this;
+}
+
+//////////////////////////////////////////////////
+std::size_t OrientedBoxPacket::Size() const
+{
+  return this->dataPtr->center[0].size();
+}
+
+//////////////////////////////////////////////////
+bool OrientedBoxPacket::Empty() const
+{
+  return this->dataPtr->center[0].empty();
+}
+
+//////////////////////////////////////////////////
+void OrientedBoxPacket::Clear()
+{
+  for (int i = 0; i < 3; ++i)
+  {
+    this->dataPtr->center[i].clear();
+    this->dataPtr->half[i].clear();
+    for (int k = 0; k < 3; ++k)
+      this->dataPtr->axes[i][k].clear();
+  }
+  for (int i = 0; i < 4; ++i)
+    this->dataPtr->rot[i].clear();
+}
+
+//////////////////////////////////////////////////
+void OrientedBoxPacket::Reserve(const std::size_t _size)
+{
+  for (int i = 0; i < 3; ++i)
+  {
+    this->dataPtr->center[i].reserve(_size);
+    this->dataPtr->half[i].reserve(_size);
+    for (int k = 0; k < 3; ++k)
+      this->dataPtr->axes[i][k].reserve(_size);
+  }
+  for (int i = 0; i < 4; ++i)
+    this->dataPtr->rot[i].reserve(_size);
+}
+
+//////////////////////////////////////////////////
+void OrientedBoxPacket::PushBack(const OrientedBoxd &_box)
+{
+  const Quaterniond &q = _box.Pose().Rot();
+  const Matrix3d rot(q);
+  const Vector3d half = _box.Size() * 0.5;
+  for (int i = 0; i < 3; ++i)
+  {
+    this->dataPtr->center[i].push_back(_box.Pose().Pos()[i]);
+    this->dataPtr->half[i].push_back(half[i]);
+    for (int k = 0; k < 3; ++k)
+      this->dataPtr->axes[i][k].push_back(rot(i, k));
+  }
+  this->dataPtr->rot[0].push_back(q.W());
+  this->dataPtr->rot[1].push_back(q.X());
+  this->dataPtr->rot[2].push_back(q.Y());
+  this->dataPtr->rot[3].push_back(q.Z());
+}
+
+//////////////////////////////////////////////////
+void OrientedBoxPacket::Assign(const std::vector<OrientedBoxd> &_boxes)
+{
+  this->Clear();
+  this->Reserve(_boxes.size());
+  for (const auto &box : _boxes)
+    this->PushBack(box);
+}
+
+//////////////////////////////////////////////////
+OrientedBoxd OrientedBoxPacket::operator[](const std::size_t _index) const
+{
+  const auto &d = *this->dataPtr;
+  const Vector3d size(d.half[0][_index] * 2, d.half[1][_index] * 2,
+      d.half[2][_index] * 2);
+  const Pose3d pose(
+      Vector3d(d.center[0][_index], d.center[1][_index], d.center[2][_index]),
+      Quaterniond(d.rot[0][_index], d.rot[1][_index], d.rot[2][_index],
+        d.rot[3][_index]));
+  return OrientedBoxd(size, pose);
+}
+
+//////////////////////////////////////////////////
+std::size_t OrientedBoxPacket::Intersects(const OrientedBoxd &_box,
+    std::vector<bool> &_hits) const
+{
+  const Matrix3d rot(_box.Pose().Rot());
+  const Vector3d half = _box.Size() * 0.5;
+  double box[15];
+  for (int i = 0; i < 3; ++i)
+  {
+    box[i] = _box.Pose().Pos()[i];
+    for (int j = 0; j < 3; ++j)
+      box[3 + 3 * i + j] = rot(i, j);
+    box[12 + i] = half[i];
+  }
+
+  const auto &d = *this->dataPtr;
+  const std::size_t n = this->Size();
+  std::vector<double> hits(n);
+  simd::BatchKernels<double>().orientedBoxes(
+      {d.center[0].data(), d.center[1].data(), d.center[2].data()},
+      {d.axes[0][0].data(), d.axes[1][0].data(), d.axes[2][0].data()},
+      {d.axes[0][1].data(), d.axes[1][1].data(), d.axes[2][1].data()},
+      {d.axes[0][2].data(), d.axes[1][2].data(), d.axes[2][2].data()},
+      {d.half[0].data(), d.half[1].data(), d.half[2].data()},
+      box, hits.data(), n);
+
+  std::size_t count = 0;
+  _hits.resize(n);
+  for (std::size_t i = 0; i < n; ++i)
+  {
+    _hits[i] = hits[i] > 0;
+    if (_hits[i])
+      ++count;
+  }
+  return count;
+}
@@ -0,0 +1,138 @@
+/*
+ * Copyright (C) 2018 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "ignition/math/Helpers.hh"
+#include "ignition/math/OrientedBoxPacket.hh"
+#include "ignition/math/Rand.hh"
+
+using namespace ignition;
+
+/////////////////////////////////////////////////
+math::OrientedBoxd RandomBox(const double _range)
+{
+  return math::OrientedBoxd(
+      math::Vector3d(math::Rand::DblUniform(0.1, 2),
+        math::Rand::DblUniform(0.1, 2), math::Rand::DblUniform(0.1, 2)),
+      math::Pose3d(math::Rand::DblUniform(-_range, _range),
+        math::Rand::DblUniform(-_range, _range),
+        math::Rand::DblUniform(-_range, _range),
+        math::Rand::DblUniform(-IGN_PI, IGN_PI),
+        math::Rand::DblUniform(-IGN_PI, IGN_PI),
+        math::Rand::DblUniform(-IGN_PI, IGN_PI)));
+}
+
+/////////////////////////////////////////////////
+TEST(OrientedBoxPacketTest, Construction)
+{
+  math::OrientedBoxPacket packet;
+  EXPECT_TRUE(packet.Empty());
+  EXPECT_EQ(packet.Size(), 0u);
+
+  std::vector<bool> hits;
+  EXPECT_EQ(packet.Intersects(math::OrientedBoxd(math::Vector3d::One),
+        hits), 0u);
+  EXPECT_TRUE(hits.empty());
+
+  const math::OrientedBoxd box1(math::Vector3d(1, 2, 3),
+      math::Pose3d(1, 2, 3, 0.1, 0.2, 0.3));
+  const math::OrientedBoxd box2(math::Vector3d(0.5, 0.5, 0.5));
+  packet.PushBack(box1);
+  packet.PushBack(box2);
+  EXPECT_FALSE(packet.Empty());
+  ASSERT_EQ(packet.Size(), 2u);
+  EXPECT_EQ(packet[0], box1);
+  EXPECT_EQ(packet[1], box2);
+
+  math::OrientedBoxPacket copy(packet);
+  EXPECT_EQ(copy.Size(), 2u);
+  packet.Clear();
+  EXPECT_TRUE(packet.Empty());
+  EXPECT_EQ(copy[0], box1);
+
+  packet = copy;
+  EXPECT_EQ(packet.Size(), 2u);
+  packet.Assign({box2});
+  ASSERT_EQ(packet.Size(), 1u);
+  EXPECT_EQ(packet[0], box2);
+
+  const math::OrientedBoxPacket fromVector({box1, box2, box1});
+  EXPECT_EQ(fromVector.Size(), 3u);
+  EXPECT_EQ(fromVector[2], box1);
+}
+
+/////////////////////////////////////////////////
+TEST(OrientedBoxPacketTest, Intersects)
+{
+  const math::Vector3d size(2, 2, 2);
+  const math::OrientedBoxPacket packet({
+      math::OrientedBoxd(size, math::Pose3d(1.9, 0, 0, 0, 0, 0)),
+      math::OrientedBoxd(size, math::Pose3d(0, 0, 2.1, 0, 0, 0)),
+      math::OrientedBoxd(size, math::Pose3d(2.3, 0, 0, 0, 0, IGN_PI * 0.25)),
+      math::OrientedBoxd(size, math::Pose3d(2.5, 0, 0, 0, 0, IGN_PI * 0.25)),
+      math::OrientedBoxd(math::Vector3d(0.1, 0.1, 0.1))});
+
+  std::vector<bool> hits;
+  EXPECT_EQ(packet.Intersects(math::OrientedBoxd(size), hits), 3u);
+  EXPECT_EQ(hits, std::vector<bool>({true, false, true, false, true}));
+
+  // Only the cross product of the edges separates the boxes
+  const math::OrientedBoxd yaw(size,
+      math::Pose3d(0, 0, 0, 0, 0, IGN_PI * 0.25));
+  const double d = 2 * std::sqrt(2);
+  const math::OrientedBoxPacket pitch({
+      math::OrientedBoxd(size, math::Pose3d(d - 0.01, 0, 0, 0,
+            IGN_PI * 0.25, 0)),
+      math::OrientedBoxd(size, math::Pose3d(d + 0.01, 0, 0, 0,
+            IGN_PI * 0.25, 0))});
+  EXPECT_EQ(pitch.Intersects(yaw, hits), 1u);
+  EXPECT_EQ(hits, std::vector<bool>({true, false}));
+}
+
+/////////////////////////////////////////////////
+TEST(OrientedBoxPacketTest, MatchesOrientedBox)
+{
+  // Random boxes, with a size that is not a multiple of the SIMD width
+  math::Rand::Seed(5);
+  std::vector<math::OrientedBoxd> boxes;
+  for (int i = 0; i < 1003; ++i)
+    boxes.push_back(RandomBox(4));
+  const math::OrientedBoxPacket packet(boxes);
+
+  for (int q = 0; q < 20; ++q)
+  {
+    const math::OrientedBoxd box = RandomBox(2);
+    std::vector<bool> hits;
+    const std::size_t count = packet.Intersects(box, hits);
+    ASSERT_EQ(hits.size(), boxes.size());
+
+    std::size_t expectedCount = 0;
+    for (std::size_t i = 0; i < boxes.size(); ++i)
+    {
+      EXPECT_EQ(hits[i], box.Intersects(boxes[i])) << i;
+      EXPECT_EQ(hits[i], boxes[i].Intersects(box)) << i;
+      if (hits[i])
+        ++expectedCount;
+    }
+    EXPECT_EQ(count, expectedCount);
+    EXPECT_GT(count, 0u);
+    EXPECT_LT(count, boxes.size());
+  }
+}
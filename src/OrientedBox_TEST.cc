@@ -19,6 +19,8 @@
 
 #include "ignition/math/Angle.hh"
 #include "ignition/math/OrientedBox.hh"
+#include "ignition/math/Rand.hh"
+#include "ignition/math/Vector3Array.hh"
 
 using namespace ignition;
 using namespace math;
@@ -374,3 +376,111 @@ TEST(OrientedBoxTest, Mass)
   EXPECT_EQ(expectedMassMat, massMat);
   EXPECT_DOUBLE_EQ(expectedMassMat.Mass(), massMat.Mass());
 }
+
+//////////////////////////////////////////////////
+TEST(OrientedBoxTest, Intersects)
+{
+  const Vector3d size(2, 2, 2);
+  OrientedBoxd box(size);
+  EXPECT_TRUE(box.Intersects(box));
+  EXPECT_TRUE(box.Intersects(OrientedBoxd(Vector3d(0.1, 0.1, 0.1))));
+
+  // Separated along an axis of the boxes
+  EXPECT_TRUE(box.Intersects(OrientedBoxd(size, Pose3d(1.9, 0, 0, 0, 0, 0))));
+  EXPECT_TRUE(box.Intersects(OrientedBoxd(size, Pose3d(0, -2, 0, 0, 0, 0))));
+  EXPECT_FALSE(box.Intersects(
+        OrientedBoxd(size, Pose3d(0, 0, 2.1, 0, 0, 0))));
+
+  // Rotated box whose corner reaches the box
+  const OrientedBoxd rotated(size, Pose3d(2.3, 0, 0, 0, 0, IGN_PI * 0.25));
+  EXPECT_TRUE(box.Intersects(rotated));
+  EXPECT_TRUE(rotated.Intersects(box));
+  EXPECT_FALSE(box.Intersects(
+        OrientedBoxd(size, Pose3d(2.5, 0, 0, 0, 0, IGN_PI * 0.25))));
+
+  // Boxes turned by 45 degrees about z and y, whose edges cross at
+  // x = sqrt(2). Only the cross product of these edges separates them.
+  const OrientedBoxd yaw(size, Pose3d(0, 0, 0, 0, 0, IGN_PI * 0.25));
+  const double d = 2 * std::sqrt(2);
+  EXPECT_TRUE(yaw.Intersects(
+        OrientedBoxd(size, Pose3d(d - 0.01, 0, 0, 0, IGN_PI * 0.25, 0))));
+  EXPECT_FALSE(yaw.Intersects(
+        OrientedBoxd(size, Pose3d(d + 0.01, 0, 0, 0, IGN_PI * 0.25, 0))));
+  EXPECT_FALSE(OrientedBoxd(size, Pose3d(d + 0.01, 0, 0, 0, IGN_PI * 0.25,
+          0)).Intersects(yaw));
+
+  // Thin boxes with parallel axes
+  const OrientedBoxd plate(Vector3d(10, 10, 0.01),
+      Pose3d(0, 0, 0, 0.3, 0.2, 0.1));
+  EXPECT_TRUE(plate.Intersects(plate));
+  EXPECT_FALSE(plate.Intersects(OrientedBoxd(Vector3d(10, 10, 0.01),
+          Pose3d(plate.Pose().Rot().RotateVector(Vector3d(0, 0, 0.02)),
+            plate.Pose().Rot()))));
+}
+
+//////////////////////////////////////////////////
+TEST(OrientedBoxTest, ContainsPoints)
+{
+  const OrientedBoxd box(Vector3d(1, 2, 3),
+      Pose3d(0.5, -1, 2, 0.3, -0.7, 1.1));
+
+  // Random points around the box, its vertices and its center. The count
+  // is not a multiple of the chunk size.
+  Vector3Arrayd points;
+  for (int i = 0; i < 1000; ++i)
+  {
+    points.PushBack(Vector3d(Rand::DblUniform(-1.5, 2.5),
+          Rand::DblUniform(-3, 1), Rand::DblUniform(0, 4)));
+  }
+  for (double x : {-0.5, 0.5})
+  {
+    for (double y : {-1.0, 1.0})
+    {
+      for (double z : {-1.5, 1.5})
+        points.PushBack(box.Pose().CoordPositionAdd(Vector3d(x, y, z)));
+    }
+  }
+  points.PushBack(box.Pose().Pos());
+
+  std::vector<bool> inside;
+  std::vector<std::size_t> indices;
+  const std::size_t count = box.Contains(points, inside);
+  EXPECT_EQ(count, box.Contains(points, indices));
+  ASSERT_EQ(points.Size(), inside.size());
+  EXPECT_EQ(count, indices.size());
+  EXPECT_GT(count, 0u);
+  EXPECT_LT(count, points.Size());
+
+  std::size_t next = 0;
+  for (std::size_t i = 0; i < points.Size(); ++i)
+  {
+    EXPECT_EQ(box.Contains(points[i]), inside[i]) << i;
+    if (inside[i])
+    {
+      ASSERT_LT(next, indices.size());
+      EXPECT_EQ(i, indices[next++]);
+    }
+  }
+  EXPECT_TRUE(inside.back());
+
+  // Indices left from a previous call are discarded
+  EXPECT_EQ(0u, OrientedBoxd(Vector3d(1, 1, 1),
+        Pose3d(10, 0, 0, 0, 0, 0)).Contains(points, indices));
+  EXPECT_TRUE(indices.empty());
+
+  // Empty set
+  EXPECT_EQ(0u, box.Contains(Vector3Arrayd(), inside));
+  EXPECT_TRUE(inside.empty());
+
+  // Float box, rotated PI/2 about +x: swap Z and Y
+  const OrientedBoxf boxf(Vector3f(1, 2, 3),
+      Pose3f(0, 0, 0, static_cast<float>(IGN_PI * 0.5), 0, 0));
+  Vector3Arrayf pointsf;
+  pointsf.PushBack(Vector3f(0.4f, 1.4f, 0.9f));
+  pointsf.PushBack(Vector3f(0.4f, 0.9f, 1.4f));
+  pointsf.PushBack(Vector3f(-0.4f, -1.4f, -0.9f));
+  EXPECT_EQ(2u, boxf.Contains(pointsf, indices));
+  ASSERT_EQ(2u, indices.size());
+  EXPECT_EQ(0u, indices[0]);
+  EXPECT_EQ(2u, indices[1]);
+}
@@ -0,0 +1,104 @@
+/*
+ * Copyright (C) 2018 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "ignition/math/PoseView.hh"
+
+using namespace ignition;
+
+/////////////////////////////////////////////////
+TEST(PoseViewTest, Empty)
+{
+  const math::PoseViewd view;
+  EXPECT_TRUE(view.Empty());
+  EXPECT_EQ(0u, view.Size());
+  EXPECT_EQ(7u, view.Stride());
+  EXPECT_EQ(nullptr, view.Data());
+}
+
+/////////////////////////////////////////////////
+TEST(PoseViewTest, Access)
+{
+  const math::Quaterniond q1(0.1, 0.2, 0.3);
+  const math::Quaterniond q2(-0.4, 0.5, 1.2);
+
+  // x, y, z, qw, qx, qy, qz and a timestamp for each pose
+  const double data[] =
+  {
+    1, 2, 3, q1.W(), q1.X(), q1.Y(), q1.Z(), 10,
+    4, 5, 6, q2.W(), q2.X(), q2.Y(), q2.Z(), 11
+  };
+  const math::PoseViewd view(data, 2, 8);
+  EXPECT_FALSE(view.Empty());
+  EXPECT_EQ(2u, view.Size());
+  EXPECT_EQ(8u, view.Stride());
+  EXPECT_EQ(data, view.Data());
+
+  EXPECT_EQ(math::Pose3d(math::Vector3d(1, 2, 3), q1), view[0]);
+  EXPECT_EQ(math::Pose3d(math::Vector3d(4, 5, 6), q2), view[1]);
+  EXPECT_EQ(math::Vector3d(4, 5, 6), view.Pos(1));
+  EXPECT_EQ(q2, view.Rot(1));
+
+  const math::Vector3Viewd positions = view.Positions();
+  EXPECT_EQ(2u, positions.Size());
+  EXPECT_EQ(8u, positions.Stride());
+  EXPECT_EQ(math::Vector3d(4, 5, 6), positions[1]);
+}
+
+/////////////////////////////////////////////////
+TEST(PoseViewTest, TransformPoses)
+{
+  const math::Pose3d pose(1.5, -2.0, 0.25, 0.3, -0.7, 2.1);
+
+  std::vector<float> data;
+  for (int i = 0; i < 5; ++i)
+  {
+    const math::Quaternionf q(0.1f * i, -0.2f, 0.3f * i);
+    const float values[] = {0.5f * i, 1.0f - i, 2.0f, q.W(), q.X(), q.Y(),
+                            q.Z()};
+    data.insert(data.end(), values, values + 7);
+  }
+  const math::PoseViewf view(data.data(), 5);
+
+  std::vector<math::Pose3f> world;
+  const math::Pose3f posef(math::Vector3f(1.5f, -2.0f, 0.25f),
+      math::Quaternionf(0.3f, -0.7f, 2.1f));
+  view.Transform(posef, world);
+  ASSERT_EQ(5u, world.size());
+  for (std::size_t i = 0; i < world.size(); ++i)
+  {
+    const math::Pose3f expected = view[i] + posef;
+    EXPECT_NEAR(expected.Pos().X(), world[i].Pos().X(), 1e-5);
+    EXPECT_NEAR(expected.Pos().Y(), world[i].Pos().Y(), 1e-5);
+    EXPECT_NEAR(expected.Pos().Z(), world[i].Pos().Z(), 1e-5);
+    EXPECT_NEAR(expected.Rot().W(), world[i].Rot().W(), 1e-6);
+    EXPECT_NEAR(expected.Rot().X(), world[i].Rot().X(), 1e-6);
+    EXPECT_NEAR(expected.Rot().Y(), world[i].Rot().Y(), 1e-6);
+    EXPECT_NEAR(expected.Rot().Z(), world[i].Rot().Z(), 1e-6);
+  }
+
+  // Double version, compared with the pose operators
+  const double d[] = {1, 2, 3, 1, 0, 0, 0, -1, 0.5, 2, 0, 0, 0, 1};
+  std::vector<math::Pose3d> out;
+  math::PoseViewd(d, 2).Transform(pose, out);
+  ASSERT_EQ(2u, out.size());
+  EXPECT_EQ(math::Pose3d(1, 2, 3, 1, 0, 0, 0) + pose, out[0]);
+  EXPECT_EQ(math::Pose3d(-1, 0.5, 2, 0, 0, 0, 1) + pose, out[1]);
+}
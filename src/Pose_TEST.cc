@@ -17,8 +17,11 @@
 
 #include <gtest/gtest.h>
 
+#include <vector>
+
 #include "ignition/math/Helpers.hh"
 #include "ignition/math/Pose3.hh"
+#include "ignition/math/Vector3Array.hh"
 
 using namespace ignition;
 
@@ -155,3 +158,117 @@ TEST(PoseTest, OperatorStreamOut)
   EXPECT_EQ(stream.str(), "0.1 1.2 2.3 0 0.1 1");
 }
 
+
+/////////////////////////////////////////////////
+TEST(PoseTest, TransformPoints)
+{
+  const math::Pose3d pose(1.5, -2.0, 0.25, 0.3, -0.7, 2.1);
+
+  std::vector<math::Vector3d> points;
+  for (int i = 0; i < 23; ++i)
+    points.push_back(math::Vector3d(i * 0.5, 3.0 - i, i * i * 0.1));
+
+  // Array of Vector3
+  std::vector<math::Vector3d> world;
+  pose.TransformPoints(points, world);
+  ASSERT_EQ(points.size(), world.size());
+  for (std::size_t i = 0; i < points.size(); ++i)
+  {
+    EXPECT_TRUE(world[i].Equal(pose.CoordPositionAdd(points[i]), 1e-12));
+    EXPECT_TRUE(world[i].Equal(pose.Pos() + pose.Rot().RotateVector(
+            points[i]), 1e-12));
+  }
+
+  std::vector<math::Vector3d> local;
+  pose.InverseTransformPoints(world, local);
+  ASSERT_EQ(points.size(), local.size());
+  for (std::size_t i = 0; i < points.size(); ++i)
+  {
+    EXPECT_TRUE(local[i].Equal(points[i], 1e-12));
+    EXPECT_TRUE(local[i].Equal(math::Pose3d(world[i],
+            math::Quaterniond::Identity).CoordPositionSub(pose), 1e-12));
+  }
+
+  // In place
+  std::vector<math::Vector3d> inPlace = points;
+  pose.TransformPoints(inPlace.data(), inPlace.data(), inPlace.size());
+  for (std::size_t i = 0; i < points.size(); ++i)
+    EXPECT_EQ(world[i], inPlace[i]);
+
+  // Structure of arrays
+  math::Vector3Arrayd array(points);
+  math::Vector3Arrayd arrayWorld;
+  array.Transform(pose, arrayWorld);
+  ASSERT_EQ(points.size(), arrayWorld.Size());
+  for (std::size_t i = 0; i < points.size(); ++i)
+    EXPECT_TRUE(arrayWorld[i].Equal(world[i], 1e-12));
+
+  arrayWorld.InverseTransform(pose, arrayWorld);
+  for (std::size_t i = 0; i < points.size(); ++i)
+    EXPECT_TRUE(arrayWorld[i].Equal(points[i], 1e-12));
+
+  // Empty input
+  std::vector<math::Vector3d> empty;
+  pose.TransformPoints(empty, world);
+  EXPECT_TRUE(world.empty());
+}
+
+/////////////////////////////////////////////////
+TEST(PoseTest, TransformPointsFloat)
+{
+  const math::Pose3f pose(-4.0f, 2.5f, 1.0f, -1.2f, 0.4f, 0.9f);
+
+  math::Vector3Arrayf array;
+  for (int i = 0; i < 19; ++i)
+    array.PushBack(math::Vector3f(i * 0.25f, -1.0f * i, 2.0f));
+
+  math::Vector3Arrayf world;
+  array.Transform(pose, world);
+  ASSERT_EQ(array.Size(), world.Size());
+  for (std::size_t i = 0; i < array.Size(); ++i)
+    EXPECT_TRUE(world[i].Equal(pose.CoordPositionAdd(array[i]), 1e-4f));
+
+  math::Vector3Arrayf local;
+  world.InverseTransform(pose, local);
+  for (std::size_t i = 0; i < array.Size(); ++i)
+    EXPECT_TRUE(local[i].Equal(array[i], 1e-4f));
+}
+
+/////////////////////////////////////////////////
+TEST(PoseTest, TransformPointsView)
+{
+  const math::Pose3d pose(1.5, -2.0, 0.25, 0.3, -0.7, 2.1);
+
+  // x, y, z and intensity of each point
+  std::vector<double> buffer;
+  std::vector<math::Vector3d> points;
+  for (int i = 0; i < 23; ++i)
+  {
+    points.push_back(math::Vector3d(i * 0.5, 3.0 - i, i * i * 0.1));
+    buffer.insert(buffer.end(), {points.back().X(), points.back().Y(),
+        points.back().Z(), 0.5});
+  }
+  const math::Vector3Viewd view(buffer.data(), points.size(), 4);
+
+  std::vector<math::Vector3d> expected, world;
+  pose.TransformPoints(points, expected);
+  pose.TransformPoints(view, world);
+  ASSERT_EQ(points.size(), world.size());
+  for (std::size_t i = 0; i < points.size(); ++i)
+    EXPECT_EQ(expected[i], world[i]);
+
+  math::Vector3Arrayd worldArray(view);
+  worldArray.Transform(pose, worldArray);
+  ASSERT_EQ(points.size(), worldArray.Size());
+  for (std::size_t i = 0; i < points.size(); ++i)
+    EXPECT_EQ(expected[i], worldArray[i]);
+
+  pose.InverseTransformPoints(points, expected);
+  pose.InverseTransformPoints(view, world);
+  math::Vector3Arrayd(view).InverseTransform(pose, worldArray);
+  for (std::size_t i = 0; i < points.size(); ++i)
+  {
+    EXPECT_EQ(expected[i], world[i]);
+    EXPECT_EQ(expected[i], worldArray[i]);
+  }
+}
@@ -0,0 +1,182 @@
+/*
+ * Copyright (C) 2018 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include "ignition/math/QuaternionArray.hh"
+#include "BatchKernels.hh"
+
+using namespace ignition;
+using namespace math;
+
+namespace
+{
+  using detail::ConstSoa3;
+  using detail::ConstSoa4;
+  using detail::Soa3;
+  using detail::Soa4;
+
+  //////////////////////////////////////////////////
+  template<typename T>
+  void MultiplyImpl(ConstSoa4<T> _a, ConstSoa4<T> _b, Soa4<T> _out,
+      const std::size_t _n)
+  {
+    simd::BatchKernels<T>().quaternionMultiply(_a, _b, _out, _n);
+  }
+
+  //////////////////////////////////////////////////
+  template<typename T>
+  void MultiplyImpl(ConstSoa4<T> _a, const Quaternion<T> &_q, Soa4<T> _out,
+      const std::size_t _n)
+  {
+    const T q[4] = {_q.W(), _q.X(), _q.Y(), _q.Z()};
+    simd::BatchKernels<T>().quaternionMultiplyOne(_a, q, _out, _n);
+  }
+
+  //////////////////////////////////////////////////
+  template<typename T>
+  void NormalizeImpl(ConstSoa4<T> _a, Soa4<T> _out, const std::size_t _n)
+  {
+    simd::BatchKernels<T>().quaternionNormalize(_a, _out, _n);
+  }
+
+  //////////////////////////////////////////////////
+  template<typename T>
+  void RotateImpl(ConstSoa4<T> _q, ConstSoa3<T> _v, Soa3<T> _out,
+      const T _sign, const std::size_t _n)
+  {
+    simd::BatchKernels<T>().quaternionRotate(_q, _v, _out, _sign, _n);
+  }
+
+  //////////////////////////////////////////////////
+  template<typename T, bool Spherical>
+  void InterpolateImpl(ConstSoa4<T> _a, ConstSoa4<T> _b, const T *_t,
+      const std::size_t _tStride, const bool _shortestPath, Soa4<T> _out,
+      const std::size_t _n)
+  {
+    const simd::BatchKernelTable<T> &kernels = simd::BatchKernels<T>();
+    (Spherical ? kernels.quaternionSlerp : kernels.quaternionNlerp)(
+        _a, _b, _t, _tStride, _shortestPath, _out, _n);
+  }
+}  // namespace
+
+//////////////////////////////////////////////////
+void detail::QuaternionArrayKernels<float>::Multiply(ConstSoa4<float> _a,
+    ConstSoa4<float> _b, Soa4<float> _out, const std::size_t _n)
+{
+  MultiplyImpl(_a, _b, _out, _n);
+}
+
+//////////////////////////////////////////////////
+void detail::QuaternionArrayKernels<float>::Multiply(ConstSoa4<float> _a,
+    const Quaternion<float> &_q, Soa4<float> _out, const std::size_t _n)
+{
+  MultiplyImpl(_a, _q, _out, _n);
+}
+
+//////////////////////////////////////////////////
+void detail::QuaternionArrayKernels<float>::Normalize(ConstSoa4<float> _a,
+    Soa4<float> _out, const std::size_t _n)
+{
+  NormalizeImpl(_a, _out, _n);
+}
+
+//////////////////////////////////////////////////
+void detail::QuaternionArrayKernels<float>::RotateVector(
+    ConstSoa4<float> _q, ConstSoa3<float> _v, Soa3<float> _out,
+    const std::size_t _n)
+{
+  RotateImpl(_q, _v, _out, 1.0f, _n);
+}
+
+//////////////////////////////////////////////////
+void detail::QuaternionArrayKernels<float>::RotateVectorReverse(
+    ConstSoa4<float> _q, ConstSoa3<float> _v, Soa3<float> _out,
+    const std::size_t _n)
+{
+  RotateImpl(_q, _v, _out, -1.0f, _n);
+}
+
+//////////////////////////////////////////////////
+void detail::QuaternionArrayKernels<float>::Nlerp(ConstSoa4<float> _a,
+    ConstSoa4<float> _b, const float *_t, const std::size_t _tStride,
+    const bool _shortestPath, Soa4<float> _out, const std::size_t _n)
+{
+  InterpolateImpl<float, false>(_a, _b, _t, _tStride, _shortestPath, _out,
+      _n);
+}
+
+//////////////////////////////////////////////////
+void detail::QuaternionArrayKernels<float>::Slerp(ConstSoa4<float> _a,
+    ConstSoa4<float> _b, const float *_t, const std::size_t _tStride,
+    const bool _shortestPath, Soa4<float> _out, const std::size_t _n)
+{
+  InterpolateImpl<float, true>(_a, _b, _t, _tStride, _shortestPath, _out,
+      _n);
+}
+
+//////////////////////////////////////////////////
+void detail::QuaternionArrayKernels<double>::Multiply(ConstSoa4<double> _a,
+    ConstSoa4<double> _b, Soa4<double> _out, const std::size_t _n)
+{
+  MultiplyImpl(_a, _b, _out, _n);
+}
+
+//////////////////////////////////////////////////
+void detail::QuaternionArrayKernels<double>::Multiply(ConstSoa4<double> _a,
+    const Quaternion<double> &_q, Soa4<double> _out, const std::size_t _n)
+{
+  MultiplyImpl(_a, _q, _out, _n);
+}
+
+//////////////////////////////////////////////////
+void detail::QuaternionArrayKernels<double>::Normalize(ConstSoa4<double> _a,
+    Soa4<double> _out, const std::size_t _n)
+{
+  NormalizeImpl(_a, _out, _n);
+}
+
+//////////////////////////////////////////////////
+void detail::QuaternionArrayKernels<double>::RotateVector(
+    ConstSoa4<double> _q, ConstSoa3<double> _v, Soa3<double> _out,
+    const std::size_t _n)
+{
+  RotateImpl(_q, _v, _out, 1.0, _n);
+}
+
+//////////////////////////////////////////////////
+void detail::QuaternionArrayKernels<double>::RotateVectorReverse(
+    ConstSoa4<double> _q, ConstSoa3<double> _v, Soa3<double> _out,
+    const std::size_t _n)
+{
+  RotateImpl(_q, _v, _out, -1.0, _n);
+}
+
+//////////////////////////////////////////////////
+void detail::QuaternionArrayKernels<double>::Nlerp(ConstSoa4<double> _a,
+    ConstSoa4<double> _b, const double *_t, const std::size_t _tStride,
+    const bool _shortestPath, Soa4<double> _out, const std::size_t _n)
+{
+  InterpolateImpl<double, false>(_a, _b, _t, _tStride, _shortestPath, _out,
+      _n);
+}
+
+//////////////////////////////////////////////////
+void detail::QuaternionArrayKernels<double>::Slerp(ConstSoa4<double> _a,
+    ConstSoa4<double> _b, const double *_t, const std::size_t _tStride,
+    const bool _shortestPath, Soa4<double> _out, const std::size_t _n)
+{
+  InterpolateImpl<double, true>(_a, _b, _t, _tStride, _shortestPath, _out,
+      _n);
+}
@@ -0,0 +1,323 @@
+/*
+ * Copyright (C) 2018 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include "ignition/math/QuaternionArray.hh"
+#include "ignition/math/Rand.hh"
+
+using namespace ignition;
+
+/////////////////////////////////////////////////
+template<typename T>
+std::vector<math::Quaternion<T>> RandomQuaternions(const std::size_t _n)
+{
+  std::vector<math::Quaternion<T>> quats;
+  for (std::size_t i = 0; i < _n; ++i)
+  {
+    quats.push_back(math::Quaternion<T>(
+          static_cast<T>(math::Rand::DblUniform(-1, 1)),
+          static_cast<T>(math::Rand::DblUniform(-1, 1)),
+          static_cast<T>(math::Rand::DblUniform(-1, 1)),
+          static_cast<T>(math::Rand::DblUniform(-1, 1))));
+    quats.back().Normalize();
+  }
+  return quats;
+}
+
+/////////////////////////////////////////////////
+template<typename T>
+class QuaternionArrayTest : public ::testing::Test
+{
+  /// \brief Accuracy bound documented in QuaternionArray.hh
+  public: T Tol() const
+  {
+    return static_cast<T>(sizeof(T) == sizeof(float) ? 1e-5 : 1e-12);
+  }
+
+  /// \brief Check that every component of two quaternions differs by
+  /// less than the documented bound.
+  public: void ExpectNear(const math::Quaternion<T> &_expected,
+                          const math::Quaternion<T> &_actual) const
+  {
+    EXPECT_NEAR(_expected.W(), _actual.W(), this->Tol());
+    EXPECT_NEAR(_expected.X(), _actual.X(), this->Tol());
+    EXPECT_NEAR(_expected.Y(), _actual.Y(), this->Tol());
+    EXPECT_NEAR(_expected.Z(), _actual.Z(), this->Tol());
+  }
+};
+
+/////////////////////////////////////////////////
+/// \brief Check whether the documented bound applies to the interpolation
+/// of two quaternions. It does not for nearly opposite quaternions when the
+/// shortest path is not taken.
+template<typename T>
+bool InterpolationBounded(const math::Quaternion<T> &_a,
+    const math::Quaternion<T> &_b, const bool _shortestPath)
+{
+  return _shortestPath || _a.Dot(_b) >= static_cast<T>(-0.99);
+}
+
+typedef ::testing::Types<float, double> FloatTypes;
+TYPED_TEST_CASE(QuaternionArrayTest, FloatTypes);
+
+/////////////////////////////////////////////////
+TYPED_TEST(QuaternionArrayTest, Construct)
+{
+  typedef TypeParam T;
+
+  math::QuaternionArray<T> empty;
+  EXPECT_TRUE(empty.Empty());
+  EXPECT_EQ(0u, empty.Size());
+
+  math::QuaternionArray<T> identities(5);
+  EXPECT_EQ(5u, identities.Size());
+  for (std::size_t i = 0; i < identities.Size(); ++i)
+    EXPECT_EQ(math::Quaternion<T>::Identity, identities[i]);
+
+  auto quats = RandomQuaternions<T>(37);
+  math::QuaternionArray<T> array(quats);
+  EXPECT_EQ(0u, reinterpret_cast<std::uintptr_t>(array.W()) % 32);
+  EXPECT_EQ(0u, reinterpret_cast<std::uintptr_t>(array.X()) % 32);
+  EXPECT_EQ(0u, reinterpret_cast<std::uintptr_t>(array.Y()) % 32);
+  EXPECT_EQ(0u, reinterpret_cast<std::uintptr_t>(array.Z()) % 32);
+
+  ASSERT_EQ(quats.size(), array.Size());
+  auto copy = array.ToVector();
+  ASSERT_EQ(quats.size(), copy.size());
+  for (std::size_t i = 0; i < quats.size(); ++i)
+  {
+    EXPECT_EQ(quats[i], array[i]);
+    EXPECT_EQ(quats[i], copy[i]);
+    EXPECT_EQ(quats[i].W(), array.W()[i]);
+  }
+
+  array.Set(3, math::Quaternion<T>(0, 1, 0, 0));
+  EXPECT_EQ(math::Quaternion<T>(0, 1, 0, 0), array[3]);
+
+  array.PushBack(math::Quaternion<T>(0, 0, 1, 0));
+  EXPECT_EQ(38u, array.Size());
+  EXPECT_EQ(math::Quaternion<T>(0, 0, 1, 0), array[37]);
+
+  array.Resize(40);
+  EXPECT_EQ(math::Quaternion<T>::Identity, array[39]);
+
+  array.Clear();
+  EXPECT_TRUE(array.Empty());
+}
+
+/////////////////////////////////////////////////
+TYPED_TEST(QuaternionArrayTest, Multiply)
+{
+  typedef TypeParam T;
+
+  // Use a size that is not a multiple of any SIMD width
+  const std::size_t n = 103;
+  auto a = RandomQuaternions<T>(n);
+  auto b = RandomQuaternions<T>(n);
+  const math::Quaternion<T> q(0.5, -0.5, 0.5, 0.5);
+
+  math::QuaternionArray<T> arrayA(a);
+  math::QuaternionArray<T> arrayB(b);
+
+  math::QuaternionArray<T> product;
+  EXPECT_TRUE(arrayA.Multiply(arrayB, product));
+  ASSERT_EQ(n, product.Size());
+  for (std::size_t i = 0; i < n; ++i)
+    this->ExpectNear(a[i] * b[i], product[i]);
+
+  // In place, on the right hand side
+  product = arrayB;
+  EXPECT_TRUE(arrayA.Multiply(product, product));
+  for (std::size_t i = 0; i < n; ++i)
+    this->ExpectNear(a[i] * b[i], product[i]);
+
+  arrayA.Multiply(q, product);
+  for (std::size_t i = 0; i < n; ++i)
+    this->ExpectNear(a[i] * q, product[i]);
+
+  math::QuaternionArray<T> small(3);
+  EXPECT_FALSE(arrayA.Multiply(small, product));
+}
+
+/////////////////////////////////////////////////
+TYPED_TEST(QuaternionArrayTest, Normalize)
+{
+  typedef TypeParam T;
+
+  const std::size_t n = 71;
+  std::vector<math::Quaternion<T>> quats;
+  for (auto q : RandomQuaternions<T>(n))
+    quats.push_back(q * static_cast<T>(math::Rand::DblUniform(0.1, 10)));
+  // Quaternions of length zero become the identity
+  quats[5].Set(0, 0, 0, 0);
+  quats[n - 1].Set(0, 0, 0, 0);
+
+  math::QuaternionArray<T> array(quats);
+  array.Normalize();
+  for (std::size_t i = 0; i < n; ++i)
+  {
+    math::Quaternion<T> expected = quats[i];
+    expected.Normalize();
+    this->ExpectNear(expected, array[i]);
+  }
+  EXPECT_EQ(math::Quaternion<T>::Identity, array[5]);
+  EXPECT_EQ(math::Quaternion<T>::Identity, array[n - 1]);
+}
+
+/////////////////////////////////////////////////
+TYPED_TEST(QuaternionArrayTest, RotateVector)
+{
+  typedef TypeParam T;
+
+  const std::size_t n = 53;
+  auto quats = RandomQuaternions<T>(n);
+  // Non unit quaternions rotate like their normalized version
+  quats[7] = quats[7] * static_cast<T>(3);
+  quats[8] = quats[8] * static_cast<T>(0.25);
+  // Quaternion of length zero
+  quats[9].Set(0, 0, 0, 0);
+
+  std::vector<math::Vector3<T>> vecs;
+  for (std::size_t i = 0; i < n; ++i)
+  {
+    vecs.push_back(math::Vector3<T>(
+          static_cast<T>(math::Rand::DblUniform(-1, 1)),
+          static_cast<T>(math::Rand::DblUniform(-1, 1)),
+          static_cast<T>(math::Rand::DblUniform(-1, 1))));
+  }
+
+  math::QuaternionArray<T> array(quats);
+  math::Vector3Array<T> vecArray(vecs);
+
+  math::Vector3Array<T> rotated;
+  EXPECT_TRUE(array.RotateVector(vecArray, rotated));
+  ASSERT_EQ(n, rotated.Size());
+  for (std::size_t i = 0; i < n; ++i)
+    EXPECT_TRUE(rotated[i].Equal(quats[i].RotateVector(vecs[i]), this->Tol()));
+
+  EXPECT_TRUE(array.RotateVectorReverse(vecArray, rotated));
+  for (std::size_t i = 0; i < n; ++i)
+  {
+    EXPECT_TRUE(rotated[i].Equal(quats[i].RotateVectorReverse(vecs[i]),
+          this->Tol()));
+  }
+
+  // Reverse rotation in place undoes the rotation
+  EXPECT_TRUE(array.RotateVector(vecArray, rotated));
+  EXPECT_TRUE(array.RotateVectorReverse(rotated, rotated));
+  for (std::size_t i = 0; i < n; ++i)
+  {
+    if (i != 9)
+    {
+      EXPECT_TRUE(rotated[i].Equal(vecs[i], this->Tol()));
+    }
+  }
+
+  math::Vector3Array<T> small(3);
+  EXPECT_FALSE(array.RotateVector(small, rotated));
+  EXPECT_FALSE(array.RotateVectorReverse(small, rotated));
+}
+
+/////////////////////////////////////////////////
+TYPED_TEST(QuaternionArrayTest, Slerp)
+{
+  typedef TypeParam T;
+  math::Rand::Seed(11);
+
+  const std::size_t n = 301;
+  auto a = RandomQuaternions<T>(n);
+  auto b = RandomQuaternions<T>(n);
+
+  // Nearly parallel and nearly opposite quaternions, on both sides of the
+  // threshold where Quaternion::Slerp() switches to linear interpolation.
+  const T eps[] = {0, 1e-4f, 0.02f, 0.04f, 0.05f, 0.1f};
+  std::size_t k = 0;
+  for (const T e : eps)
+  {
+    b[k] = a[k] * math::Quaternion<T>(math::Vector3<T>(1, 0, 0), e);
+    b[k + 1] = -b[k];
+    k += 2;
+  }
+  b[k] = a[k];
+  b[k + 1] = -a[k + 1];
+
+  math::QuaternionArray<T> arrayA(a);
+  math::QuaternionArray<T> arrayB(b);
+
+  std::vector<T> ts;
+  for (std::size_t i = 0; i < n; ++i)
+    ts.push_back(static_cast<T>(math::Rand::DblUniform(0, 1)));
+
+  for (const bool shortest : {false, true})
+  {
+    math::QuaternionArray<T> result;
+    for (const T t : {T(0), T(0.1), T(0.5), T(0.75), T(1)})
+    {
+      EXPECT_TRUE(arrayA.Slerp(arrayB, t, result, shortest));
+      ASSERT_EQ(n, result.Size());
+      for (std::size_t i = 0; i < n; ++i)
+      {
+        if (!InterpolationBounded(a[i], b[i], shortest))
+          continue;
+        this->ExpectNear(
+            math::Quaternion<T>::Slerp(t, a[i], b[i], shortest), result[i]);
+      }
+    }
+
+    EXPECT_TRUE(arrayA.Slerp(arrayB, ts, result, shortest));
+    for (std::size_t i = 0; i < n; ++i)
+    {
+      if (!InterpolationBounded(a[i], b[i], shortest))
+        continue;
+      this->ExpectNear(
+          math::Quaternion<T>::Slerp(ts[i], a[i], b[i], shortest), result[i]);
+    }
+
+    // Nlerp matches the linear fallback of Quaternion::Slerp()
+    EXPECT_TRUE(arrayA.Nlerp(arrayB, ts, result, shortest));
+    for (std::size_t i = 0; i < n; ++i)
+    {
+      if (!InterpolationBounded(a[i], b[i], shortest))
+        continue;
+      math::Quaternion<T> end = b[i];
+      if (shortest && a[i].Dot(b[i]) < 0)
+        end = -end;
+      math::Quaternion<T> expected = a[i] * (1 - ts[i]) + end * ts[i];
+      expected.Normalize();
+      this->ExpectNear(expected, result[i]);
+    }
+  }
+
+  // Output may alias an input
+  math::QuaternionArray<T> result = arrayA;
+  EXPECT_TRUE(result.Slerp(arrayB, T(0.3), result));
+  for (std::size_t i = 0; i < n; ++i)
+  {
+    if (InterpolationBounded(a[i], b[i], false))
+      this->ExpectNear(math::Quaternion<T>::Slerp(0.3, a[i], b[i]), result[i]);
+  }
+
+  math::QuaternionArray<T> small(3);
+  EXPECT_FALSE(arrayA.Slerp(small, T(0.5), result));
+  EXPECT_FALSE(arrayA.Nlerp(small, T(0.5), result));
+  EXPECT_FALSE(arrayA.Slerp(arrayB, std::vector<T>(3), result));
+}
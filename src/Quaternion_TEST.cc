@@ -566,3 +566,20 @@ TEST(QuaterniondTest, From2Axes)
   EXPECT_TRUE(math::equal(q2.Z(), 0.0));
 }
 
+/////////////////////////////////////////////////
+TEST(QuaternionTest, Constexpr)
+{
+  const math::Quaterniond q1(1, 2, 3, 4);
+  const math::Quaterniond q2 = q1 * math::Quaterniond::Identity + q1;
+  EXPECT_EQ(q2, math::Quaterniond(2, 4, 6, 8));
+  const double dot = q1.Dot(q1);
+  EXPECT_DOUBLE_EQ(dot, 30.0);
+
+  // Quaternion has no virtual destructor, it is a literal type in both
+  // builds
+  constexpr math::Quaterniond q3 = math::Quaterniond(1, 2, 3, 4) * 2.0;
+  static_assert(static_cast<int>(q3.W()) == 2 &&
+      static_cast<int>(q3.Z()) == 8, "");
+  static_assert(static_cast<int>((math::Quaterniond::Identity *
+        math::Quaterniond(0, 1, 0, 0)).X()) == 1, "");
+}
@@ -0,0 +1,210 @@
+/*
+ * Copyright (C) 2018 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include "ignition/math/RayPacket.hh"
+#include "ignition/math/detail/AlignedAllocator.hh"
+#include "BatchKernels.hh"
+
+using namespace ignition;
+using namespace math;
+
+// Private data for RayPacket class
+class ignition::math::RayPacketPrivate
+{
+  /// \brief Storage of one component of the rays
+  public: typedef std::vector<double, detail::AlignedAllocator<double>>
+          Storage;
+
+  /// \brief Get the start of the rays.
+  /// \return Pointers to the x, y and z components.
+  public: detail::ConstSoa3<double> StartSoa() const
+  {
+    return {this->start[0].data(), this->start[1].data(),
+            this->start[2].data()};
+  }
+
+  /// \brief Get the inverse directions of the rays.
+  /// \return Pointers to the x, y and z components.
+  public: detail::ConstSoa3<double> InvDirSoa() const
+  {
+    return {this->invDir[0].data(), this->invDir[1].data(),
+            this->invDir[2].data()};
+  }
+
+  /// \brief Start of the rays, origin + min * dir
+  public: Storage start[3];
+
+  /// \brief Unit directions of the rays
+  public: Storage dir[3];
+
+  /// \brief Inverse of the unit directions of the rays
+  public: Storage invDir[3];
+
+  /// \brief Length of the rays, max - min
+  public: Storage length;
+};
+
+//////////////////////////////////////////////////
+RayPacket::RayPacket()
+: dataPtr(new RayPacketPrivate)
+{
+}
+
+//////////////////////////////////////////////////
+RayPacket::RayPacket(const std::vector<Vector3d> &_origins,
+    const std::vector<Vector3d> &_dirs, const double _min, const double _max)
+: dataPtr(new RayPacketPrivate)
+{
+  this->Assign(_origins, _dirs, _min, _max);
+}
+
+//////////////////////////////////////////////////
+RayPacket::RayPacket(const RayPacket &_packet)
+: dataPtr(new RayPacketPrivate(*_packet.dataPtr))
+{
+}
+
+//////////////////////////////////////////////////
+RayPacket::~RayPacket()
+{
+}
+
+//////////////////////////////////////////////////
+RayPacket &RayPacket::operator=(const RayPacket &_packet)
+{
+  *this->dataPtr = *_packet.dataPtr;
+  return *this;
+}
+
+//////////////////////////////////////////////////
+std::size_t RayPacket::Size() const
+{
+  return this->dataPtr->length.size();
+}
+
+//////////////////////////////////////////////////
+bool RayPacket::Empty() const
+{
+  return this->dataPtr->length.empty();
+}
+
+//////////////////////////////////////////////////
+void RayPacket::Clear()
+{
+  for (int a = 0; a < 3; ++a)
+  {
+    this->dataPtr->start[a].clear();
+    this->dataPtr->dir[a].clear();
+    this->dataPtr->invDir[a].clear();
+  }
+  this->dataPtr->length.clear();
+}
+
+//////////////////////////////////////////////////
+void RayPacket::Reserve(const std::size_t _size)
+{
+  for (int a = 0; a < 3; ++a)
+  {
+    this->dataPtr->start[a].reserve(_size);
+    this->dataPtr->dir[a].reserve(_size);
+    this->dataPtr->invDir[a].reserve(_size);
+  }
+  this->dataPtr->length.reserve(_size);
+}
+
+//////////////////////////////////////////////////
+void RayPacket::PushBack(const Vector3d &_origin, const Vector3d &_dir,
+    const double _min, const double _max)
+{
+  // Same start point as AxisAlignedBox::Intersect
+  const Vector3d dir = _dir.Normalized();
+  const Vector3d start = _origin + dir * _min;
+  for (int a = 0; a < 3; ++a)
+  {
+    this->dataPtr->start[a].push_back(start[a]);
+    this->dataPtr->dir[a].push_back(dir[a]);
+    // Infinite for the axes parallel to the ray, which the kernels handle
+    this->dataPtr->invDir[a].push_back(1 / dir[a]);
+  }
+  this->dataPtr->length.push_back(_max - _min);
+}
+
+//////////////////////////////////////////////////
+bool RayPacket::Assign(const std::vector<Vector3d> &_origins,
+    const std::vector<Vector3d> &_dirs, const double _min, const double _max)
+{
+  if (_origins.size() != _dirs.size())
+    return false;
+
+  this->Clear();
+  this->Reserve(_origins.size());
+  for (std::size_t i = 0; i < _origins.size(); ++i)
+    this->PushBack(_origins[i], _dirs[i], _min, _max);
+  return true;
+}
+
+//////////////////////////////////////////////////
+Vector3d RayPacket::Start(const std::size_t _index) const
+{
+  return Vector3d(this->dataPtr->start[0][_index],
+      this->dataPtr->start[1][_index], this->dataPtr->start[2][_index]);
+}
+
+//////////////////////////////////////////////////
+Vector3d RayPacket::Direction(const std::size_t _index) const
+{
+  return Vector3d(this->dataPtr->dir[0][_index],
+      this->dataPtr->dir[1][_index], this->dataPtr->dir[2][_index]);
+}
+
+//////////////////////////////////////////////////
+double RayPacket::Length(const std::size_t _index) const
+{
+  return this->dataPtr->length[_index];
+}
+
+//////////////////////////////////////////////////
+std::size_t RayPacket::Intersect(const AxisAlignedBox &_box,
+    std::vector<bool> &_hits, std::vector<double> &_dists) const
+{
+  const std::size_t n = this->Size();
+  const double box[6] = {_box.Min().X(), _box.Min().Y(), _box.Min().Z(),
+                         _box.Max().X(), _box.Max().Y(), _box.Max().Z()};
+  _dists.resize(n);
+  simd::BatchKernels<double>().rayBox(this->dataPtr->StartSoa(),
+      this->dataPtr->InvDirSoa(), this->dataPtr->length.data(), box,
+      _dists.data(), n);
+
+  std::size_t count = 0;
+  _hits.resize(n);
+  for (std::size_t i = 0; i < n; ++i)
+  {
+    _hits[i] = _dists[i] >= 0;
+    if (_hits[i])
+      ++count;
+    else
+      _dists[i] = 0;
+  }
+  return count;
+}
+
+//////////////////////////////////////////////////
+std::size_t RayPacket::IntersectCheck(const AxisAlignedBox &_box,
+    std::vector<bool> &_hits) const
+{
+  std::vector<double> dists;
+  return this->Intersect(_box, _hits, dists);
+}
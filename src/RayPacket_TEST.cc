@@ -0,0 +1,168 @@
+/*
+ * Copyright (C) 2018 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <tuple>
+#include <vector>
+
+#include "ignition/math/Rand.hh"
+#include "ignition/math/RayPacket.hh"
+
+using namespace ignition;
+
+/////////////////////////////////////////////////
+TEST(RayPacketTest, Construction)
+{
+  math::RayPacket packet;
+  EXPECT_TRUE(packet.Empty());
+  EXPECT_EQ(packet.Size(), 0u);
+
+  std::vector<bool> hits;
+  std::vector<double> dists;
+  EXPECT_EQ(packet.Intersect(math::AxisAlignedBox(
+          math::Vector3d::Zero, math::Vector3d::One), hits, dists), 0u);
+  EXPECT_TRUE(hits.empty());
+  EXPECT_TRUE(dists.empty());
+
+  packet.PushBack(math::Vector3d(1, 2, 3), math::Vector3d(0, 0, 2), 1, 5);
+  EXPECT_EQ(packet.Size(), 1u);
+  EXPECT_EQ(packet.Start(0), math::Vector3d(1, 2, 4));
+  EXPECT_EQ(packet.Direction(0), math::Vector3d::UnitZ);
+  EXPECT_DOUBLE_EQ(packet.Length(0), 4);
+
+  const std::vector<math::Vector3d> origins = {math::Vector3d::Zero,
+    math::Vector3d::One};
+  const std::vector<math::Vector3d> dirs = {math::Vector3d::UnitX};
+  EXPECT_FALSE(packet.Assign(origins, dirs, 0, 1));
+  EXPECT_EQ(packet.Size(), 1u);
+
+  math::RayPacket packet2(origins, {math::Vector3d::UnitX,
+      math::Vector3d::UnitY}, 0, 1);
+  EXPECT_EQ(packet2.Size(), 2u);
+
+  math::RayPacket packet3(packet2);
+  EXPECT_EQ(packet3.Direction(1), math::Vector3d::UnitY);
+  packet3 = packet;
+  EXPECT_EQ(packet3.Size(), 1u);
+
+  packet3.Clear();
+  EXPECT_TRUE(packet3.Empty());
+  EXPECT_EQ(packet.Size(), 1u);
+}
+
+/////////////////////////////////////////////////
+TEST(RayPacketTest, Intersect)
+{
+  const math::AxisAlignedBox box(math::Vector3d(1, 1, 1),
+      math::Vector3d(2, 2, 2));
+
+  math::RayPacket packet;
+  // Hits the box at distance 1
+  packet.PushBack(math::Vector3d(0, 1.5, 1.5), math::Vector3d(1, 0, 0),
+      0, 10);
+  // Misses the box
+  packet.PushBack(math::Vector3d(0, 3, 1.5), math::Vector3d(1, 0, 0),
+      0, 10);
+  // Too short
+  packet.PushBack(math::Vector3d(0, 1.5, 1.5), math::Vector3d(1, 0, 0),
+      0, 0.5);
+  // Starts inside the box
+  packet.PushBack(math::Vector3d(0, 1.5, 1.5), math::Vector3d(1, 0, 0),
+      1.5, 10);
+  // Points away from the box
+  packet.PushBack(math::Vector3d(0, 1.5, 1.5), math::Vector3d(-1, 0, 0),
+      0, 10);
+  // Lies on the faces of the box
+  packet.PushBack(math::Vector3d(0, 2, 1), math::Vector3d(5, 0, 0), 0, 10);
+  packet.PushBack(math::Vector3d(0, 1, 2), math::Vector3d(1, 0, 0), 0, 10);
+  // Diagonal through a corner
+  packet.PushBack(math::Vector3d(0, 0, 0), math::Vector3d(1, 1, 1), 0, 10);
+
+  std::vector<bool> hits;
+  std::vector<double> dists;
+  EXPECT_EQ(packet.Intersect(box, hits, dists), 5u);
+  ASSERT_EQ(hits.size(), packet.Size());
+  ASSERT_EQ(dists.size(), packet.Size());
+
+  const std::vector<bool> expectedHits = {true, false, false, true, false,
+    true, true, true};
+  const std::vector<double> expectedDists = {1, 0, 0, 0, 0, 1, 1,
+    std::sqrt(3)};
+  for (std::size_t i = 0; i < packet.Size(); ++i)
+  {
+    EXPECT_EQ(hits[i], expectedHits[i]) << i;
+    EXPECT_NEAR(dists[i], expectedDists[i], 1e-12) << i;
+  }
+
+  std::vector<bool> checks;
+  EXPECT_EQ(packet.IntersectCheck(box, checks), 5u);
+  EXPECT_EQ(checks, hits);
+}
+
+/////////////////////////////////////////////////
+TEST(RayPacketTest, MatchesAxisAlignedBox)
+{
+  math::Rand::Seed(42);
+  const int rayCount = 67;
+
+  std::vector<math::Vector3d> origins;
+  std::vector<math::Vector3d> dirs;
+  for (int i = 0; i < rayCount; ++i)
+  {
+    origins.push_back(math::Vector3d(math::Rand::DblUniform(-5, 5),
+          math::Rand::DblUniform(-5, 5), math::Rand::DblUniform(-5, 5)));
+    math::Vector3d dir(math::Rand::DblUniform(-1, 1),
+        math::Rand::DblUniform(-1, 1), math::Rand::DblUniform(-1, 1));
+    // Some rays are parallel to one or two axes
+    if (i % 5 == 0)
+      dir.Z(0);
+    if (i % 7 == 0)
+      dir.X(0);
+    dirs.push_back(dir);
+  }
+  const math::RayPacket packet(origins, dirs, 0.5, 8);
+
+  std::vector<bool> hits;
+  std::vector<double> dists;
+  int hitCount = 0;
+  for (int b = 0; b < 50; ++b)
+  {
+    const math::Vector3d corner(math::Rand::DblUniform(-3, 3),
+        math::Rand::DblUniform(-3, 3), math::Rand::DblUniform(-3, 3));
+    const math::AxisAlignedBox box(corner, corner + math::Vector3d(
+          math::Rand::DblUniform(0.1, 3), math::Rand::DblUniform(0.1, 3),
+          math::Rand::DblUniform(0.1, 3)));
+
+    const std::size_t count = packet.Intersect(box, hits, dists);
+    std::size_t expectedCount = 0;
+    for (int i = 0; i < rayCount; ++i)
+    {
+      bool hit;
+      double dist;
+      std::tie(hit, dist) = box.IntersectDist(origins[i], dirs[i], 0.5, 8);
+      EXPECT_EQ(hits[i], hit) << b << " " << i;
+      EXPECT_NEAR(dists[i], dist, 1e-9) << b << " " << i;
+      if (hit)
+        ++expectedCount;
+    }
+    EXPECT_EQ(count, expectedCount);
+    hitCount += static_cast<int>(count);
+  }
+  EXPECT_GT(hitCount, 0);
+}
@@ -0,0 +1,133 @@
+/*
+ * Copyright (C) 2018 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+#include "ignition/math/SimdDispatch.hh"
+#include "BatchKernels.hh"
+#include "CpuFeatures.hh"
+
+using namespace ignition;
+using namespace math;
+
+namespace
+{
+  /// \brief Names of the levels, indexed by SimdLevel
+  const char *const kLevelNames[] =
+  {
+    "scalar", "sse2", "sse4.2", "avx2", "avx512"
+  };
+
+  /// \brief Number of values of SimdLevel
+  const int kLevelCount = static_cast<int>(SimdLevel::AVX512) + 1;
+
+  //////////////////////////////////////////////////
+  /// \brief Get the highest level for which the library has kernels.
+  /// \return The highest level built.
+  SimdLevel BuiltLevel()
+  {
+    if (simd::BatchKernelsAvx512<float>())
+      return SimdLevel::AVX512;
+    if (simd::BatchKernelsAvx2<float>())
+      return SimdLevel::AVX2;
+    if (simd::BatchKernelsSse42<float>())
+      return SimdLevel::SSE4_2;
+    if (simd::BatchKernelsSse2<float>())
+      return SimdLevel::SSE2;
+    return SimdLevel::SCALAR;
+  }
+
+  //////////////////////////////////////////////////
+  /// \brief Get the initial level: the supported level, unless the
+  /// IGN_MATH_SIMD_LEVEL environment variable selects a lower one.
+  /// \return The initial level.
+  int InitialLevel()
+  {
+    const int supported = static_cast<int>(SimdDispatch::SupportedLevel());
+
+    const char *env = std::getenv("IGN_MATH_SIMD_LEVEL");
+    if (!env || env[0] == '\0')
+      return supported;
+
+    for (int i = 0; i < kLevelCount; ++i)
+    {
+      if (std::string(env) != kLevelNames[i])
+        continue;
+
+      if (i > supported)
+      {
+        std::cerr << "IGN_MATH_SIMD_LEVEL [" << env << "] is not supported, "
+                  << "using [" << kLevelNames[supported] << "] instead.\n";
+        return supported;
+      }
+      return i;
+    }
+
+    std::cerr << "IGN_MATH_SIMD_LEVEL [" << env << "] is invalid, "
+              << "using [" << kLevelNames[supported] << "] instead.\n";
+    return supported;
+  }
+
+  //////////////////////////////////////////////////
+  /// \brief Get the active level, initialized on first use.
+  /// \return The active level.
+  std::atomic<int> &Active()
+  {
+    static std::atomic<int> level(InitialLevel());
+    return level;
+  }
+}  // namespace
+
+//////////////////////////////////////////////////
+SimdLevel SimdDispatch::SupportedLevel()
+{
+  static const SimdLevel level = static_cast<SimdLevel>(std::min(
+        static_cast<int>(simd::CpuSimdLevel()),
+        static_cast<int>(BuiltLevel())));
+  return level;
+}
+
+//////////////////////////////////////////////////
+SimdLevel SimdDispatch::ActiveLevel()
+{
+  return static_cast<SimdLevel>(Active().load(std::memory_order_relaxed));
+}
+
+//////////////////////////////////////////////////
+bool SimdDispatch::SetActiveLevel(const SimdLevel _level)
+{
+  if (static_cast<int>(_level) < 0 ||
+      static_cast<int>(_level) > static_cast<int>(SupportedLevel()))
+  {
+    return false;
+  }
+
+  Active().store(static_cast<int>(_level), std::memory_order_relaxed);
+  return true;
+}
+
+//////////////////////////////////////////////////
+std::string SimdDispatch::LevelName(const SimdLevel _level)
+{
+  const int index = static_cast<int>(_level);
+  if (index < 0 || index >= kLevelCount)
+    return "";
+  return kLevelNames[index];
+}
@@ -0,0 +1,274 @@
+/*
+ * Copyright (C) 2018 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <cstdlib>
+#include <vector>
+
+#include "ignition/math/Matrix4.hh"
+#include "ignition/math/QuaternionArray.hh"
+#include "ignition/math/Rand.hh"
+#include "ignition/math/SimdDispatch.hh"
+#include "ignition/math/Vector3Array.hh"
+
+using namespace ignition;
+
+/// \brief Number of elements processed by the kernels, chosen so that
+/// every pack width leaves a remainder.
+static const std::size_t kCount = 37;
+
+/////////////////////////////////////////////////
+/// \brief Outputs of every batch kernel for one level.
+template<typename T>
+struct KernelOutputs
+{
+  /// \brief Vector outputs, one array per kernel
+  std::vector<std::vector<T>> vectors;
+
+  /// \brief Matrix outputs
+  std::vector<T> matrices;
+};
+
+/////////////////////////////////////////////////
+/// \brief Random values in [_min, _max].
+template<typename T>
+std::vector<T> RandomValues(const std::size_t _n, const double _min,
+    const double _max)
+{
+  std::vector<T> values(_n);
+  for (T &v : values)
+    v = static_cast<T>(math::Rand::DblUniform(_min, _max));
+  return values;
+}
+
+/////////////////////////////////////////////////
+/// \brief Inputs shared by all levels.
+template<typename T>
+struct KernelInputs
+{
+  KernelInputs()
+  {
+    for (auto &v : this->a)
+      v = RandomValues<T>(kCount, -10, 10);
+    for (auto &v : this->b)
+      v = RandomValues<T>(kCount, -10, 10);
+    for (auto &v : this->q)
+      v = RandomValues<T>(kCount, -1, 1);
+    for (auto &v : this->r)
+      v = RandomValues<T>(kCount, -1, 1);
+    this->t = RandomValues<T>(kCount, 0, 1);
+  }
+
+  /// \brief Vectors
+  std::vector<T> a[3], b[3];
+
+  /// \brief Quaternions, w, x, y, z
+  std::vector<T> q[4], r[4];
+
+  /// \brief Interpolation parameters
+  std::vector<T> t;
+};
+
+/////////////////////////////////////////////////
+/// \brief Run every batch kernel with the active level.
+template<typename T>
+KernelOutputs<T> RunKernels(const KernelInputs<T> &_in)
+{
+  typedef math::detail::Vector3ArrayKernels<T> V;
+  typedef math::detail::QuaternionArrayKernels<T> Q;
+  typedef math::detail::ConstSoa3<T> C3;
+  typedef math::detail::ConstSoa4<T> C4;
+
+  KernelOutputs<T> out;
+  auto vec3 = [&]() -> math::detail::Soa3<T>
+  {
+    for (int k = 0; k < 3; ++k)
+      out.vectors.emplace_back(kCount);
+    const std::size_t s = out.vectors.size();
+    return {out.vectors[s - 3].data(), out.vectors[s - 2].data(),
+            out.vectors[s - 1].data()};
+  };
+  auto vec4 = [&]() -> math::detail::Soa4<T>
+  {
+    for (int k = 0; k < 4; ++k)
+      out.vectors.emplace_back(kCount);
+    const std::size_t s = out.vectors.size();
+    return {out.vectors[s - 4].data(), out.vectors[s - 3].data(),
+            out.vectors[s - 2].data(), out.vectors[s - 1].data()};
+  };
+  auto scalar = [&]() -> T*
+  {
+    out.vectors.emplace_back(kCount);
+    return out.vectors.back().data();
+  };
+
+  const C3 a = {_in.a[0].data(), _in.a[1].data(), _in.a[2].data()};
+  const C3 b = {_in.b[0].data(), _in.b[1].data(), _in.b[2].data()};
+  const C4 q = {_in.q[0].data(), _in.q[1].data(), _in.q[2].data(),
+                _in.q[3].data()};
+  const C4 r = {_in.r[0].data(), _in.r[1].data(), _in.r[2].data(),
+                _in.r[3].data()};
+  const math::Vector3<T> v(1, -2, 3);
+  const math::Matrix3<T> rot(math::Quaternion<T>(0.1, 0.2, 0.3));
+  const math::Quaternion<T> q0(0.3, -0.2, 0.5);
+
+  V::Add(a, b, vec3(), kCount);
+  V::Add(a, v, vec3(), kCount);
+  V::Scale(a, 0.5, vec3(), kCount);
+  V::Dot(a, b, scalar(), kCount);
+  V::Dot(a, v, scalar(), kCount);
+  V::Cross(a, b, vec3(), kCount);
+  V::Length(a, scalar(), kCount);
+  V::Normalize(a, vec3(), kCount);
+  V::Distance(a, v, scalar(), kCount);
+  V::Transform(a, rot, v, -v, vec3(), kCount);
+  math::Vector3<T> min, max;
+  V::MinMax(a, kCount, min, max);
+  out.vectors.push_back({min.X(), min.Y(), min.Z(), max.X(), max.Y(),
+      max.Z()});
+
+  Q::Multiply(q, r, vec4(), kCount);
+  Q::Multiply(q, q0, vec4(), kCount);
+  const math::detail::Soa4<T> unit = vec4();
+  Q::Normalize(q, unit, kCount);
+  Q::RotateVector(unit, a, vec3(), kCount);
+  Q::RotateVectorReverse(unit, a, vec3(), kCount);
+  Q::Nlerp(unit, r, _in.t.data(), 1, true, vec4(), kCount);
+  Q::Slerp(unit, q, _in.t.data(), 0, false, vec4(), kCount);
+
+  const math::Matrix4<T> m1(math::Pose3<T>(1, 2, 3, 0.1, 0.2, 0.3));
+  const math::Matrix4<T> m2(2, 1, 0, 1, 0, 3, 1, 0, 1, 0, 4, 2, 0, 1, 0, 1);
+  const math::Matrix4<T> product = m1 * m2;
+  const math::Matrix4<T> inverse = m2.Inverse();
+  for (int i = 0; i < 4; ++i)
+  {
+    for (int j = 0; j < 4; ++j)
+    {
+      out.matrices.push_back(product(i, j));
+      out.matrices.push_back(inverse(i, j));
+    }
+  }
+
+  std::vector<math::Vector3<T>> points, transformed(kCount);
+  for (std::size_t i = 0; i < kCount; ++i)
+    points.emplace_back(_in.a[0][i], _in.a[1][i], _in.a[2][i]);
+  m1.TransformPoints(points.data(), transformed.data(), kCount);
+  for (const auto &p : transformed)
+  {
+    out.matrices.push_back(p.X());
+    out.matrices.push_back(p.Y());
+    out.matrices.push_back(p.Z());
+  }
+
+  return out;
+}
+
+/////////////////////////////////////////////////
+/// \brief Check that every supported level computes the same results as
+/// the scalar level, up to the rounding differences of fused
+/// multiply-add and of the polynomial approximations.
+template<typename T>
+void CheckLevels(const double _tol)
+{
+  const math::SimdLevel active = math::SimdDispatch::ActiveLevel();
+  const KernelInputs<T> in;
+
+  ASSERT_TRUE(math::SimdDispatch::SetActiveLevel(math::SimdLevel::SCALAR));
+  const KernelOutputs<T> expected = RunKernels(in);
+
+  const int supported =
+    static_cast<int>(math::SimdDispatch::SupportedLevel());
+  for (int level = 1; level <= supported; ++level)
+  {
+    const math::SimdLevel l = static_cast<math::SimdLevel>(level);
+    SCOPED_TRACE(math::SimdDispatch::LevelName(l));
+    ASSERT_TRUE(math::SimdDispatch::SetActiveLevel(l));
+    EXPECT_EQ(l, math::SimdDispatch::ActiveLevel());
+
+    const KernelOutputs<T> out = RunKernels(in);
+    ASSERT_EQ(expected.vectors.size(), out.vectors.size());
+    for (std::size_t k = 0; k < out.vectors.size(); ++k)
+    {
+      ASSERT_EQ(expected.vectors[k].size(), out.vectors[k].size());
+      for (std::size_t i = 0; i < out.vectors[k].size(); ++i)
+        EXPECT_NEAR(expected.vectors[k][i], out.vectors[k][i], _tol) << k;
+    }
+    ASSERT_EQ(expected.matrices.size(), out.matrices.size());
+    for (std::size_t i = 0; i < out.matrices.size(); ++i)
+      EXPECT_NEAR(expected.matrices[i], out.matrices[i], _tol) << i;
+  }
+
+  EXPECT_TRUE(math::SimdDispatch::SetActiveLevel(active));
+}
+
+/////////////////////////////////////////////////
+// This test must run first, before the level is read from the
+// environment.
+TEST(SimdDispatchTest, EnvironmentVariable)
+{
+#ifndef _WIN32
+  setenv("IGN_MATH_SIMD_LEVEL", "scalar", 1);
+  EXPECT_EQ(math::SimdLevel::SCALAR, math::SimdDispatch::ActiveLevel());
+  unsetenv("IGN_MATH_SIMD_LEVEL");
+
+  // The variable is only read once
+  EXPECT_EQ(math::SimdLevel::SCALAR, math::SimdDispatch::ActiveLevel());
+#endif
+  EXPECT_TRUE(math::SimdDispatch::SetActiveLevel(
+        math::SimdDispatch::SupportedLevel()));
+}
+
+/////////////////////////////////////////////////
+TEST(SimdDispatchTest, Levels)
+{
+  const math::SimdLevel supported = math::SimdDispatch::SupportedLevel();
+  EXPECT_EQ(supported, math::SimdDispatch::ActiveLevel());
+
+  EXPECT_TRUE(math::SimdDispatch::SetActiveLevel(math::SimdLevel::SCALAR));
+  EXPECT_EQ(math::SimdLevel::SCALAR, math::SimdDispatch::ActiveLevel());
+
+  // Levels above the supported one are rejected
+  for (int level = static_cast<int>(supported) + 1;
+       level <= static_cast<int>(math::SimdLevel::AVX512); ++level)
+  {
+    EXPECT_FALSE(math::SimdDispatch::SetActiveLevel(
+          static_cast<math::SimdLevel>(level)));
+    EXPECT_EQ(math::SimdLevel::SCALAR, math::SimdDispatch::ActiveLevel());
+  }
+
+  EXPECT_TRUE(math::SimdDispatch::SetActiveLevel(supported));
+  EXPECT_EQ(supported, math::SimdDispatch::ActiveLevel());
+
+  EXPECT_EQ("scalar", math::SimdDispatch::LevelName(math::SimdLevel::SCALAR));
+  EXPECT_EQ("sse2", math::SimdDispatch::LevelName(math::SimdLevel::SSE2));
+  EXPECT_EQ("sse4.2", math::SimdDispatch::LevelName(math::SimdLevel::SSE4_2));
+  EXPECT_EQ("avx2", math::SimdDispatch::LevelName(math::SimdLevel::AVX2));
+  EXPECT_EQ("avx512", math::SimdDispatch::LevelName(math::SimdLevel::AVX512));
+}
+
+/////////////////////////////////////////////////
+TEST(SimdDispatchTest, KernelsFloat)
+{
+  CheckLevels<float>(1e-4);
+}
+
+/////////////////////////////////////////////////
+TEST(SimdDispatchTest, KernelsDouble)
+{
+  CheckLevels<double>(1e-10);
+}
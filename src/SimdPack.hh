@@ -0,0 +1,531 @@
+/*
+ * Copyright (C) 2018 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef IGNITION_MATH_SIMDPACK_HH_
+#define IGNITION_MATH_SIMDPACK_HH_
+
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define IGNITION_MATH_SIMD_SSE2 1
+#include <emmintrin.h>
+#endif
+
+#if defined(__SSE4_1__)
+#define IGNITION_MATH_SIMD_SSE4 1
+#include <smmintrin.h>
+#endif
+
+#if defined(__AVX2__)
+#define IGNITION_MATH_SIMD_AVX2 1
+#endif
+
+#if defined(__AVX512F__)
+#define IGNITION_MATH_SIMD_AVX512 1
+#endif
+
+#if defined(__AVX2__) || defined(__AVX512F__)
+#include <immintrin.h>
+#endif
+
+// The packs are compiled with the instruction sets of each translation
+// unit that includes this header. They are placed in a namespace named
+// after the instruction set, so that the linker cannot merge the inline
+// functions of units compiled with different instruction sets.
+#ifndef IGNITION_MATH_SIMD_TARGET
+#define IGNITION_MATH_SIMD_TARGET baseline
+#endif
+
+#include <cmath>
+#include <cstddef>
+
+#include <ignition/math/config.hh>
+
+namespace ignition
+{
+  namespace math
+  {
+    inline namespace IGNITION_MATH_VERSION_NAMESPACE
+    {
+    namespace simd
+    {
+    namespace IGNITION_MATH_SIMD_TARGET
+    {
+    /// \internal
+    /// \brief A "pack" wraps one SIMD register holding Width values of
+    /// type T, together with the handful of operations needed by the batch
+    /// kernels. Kernels are written once against this interface and
+    /// instantiated for each instruction set. Loads and stores are
+    /// unaligned, so kernels can be used on any buffer.
+    ///
+    /// ScalarPack is the portable fallback, and is also used to process
+    /// the remaining elements that do not fill a complete register. It
+    /// avoids the inline functions of the standard library, which could
+    /// be shared with other translation units.
+    template<typename T>
+    struct ScalarPack
+    {
+      /// \brief Register type
+      typedef T Reg;
+
+      /// \brief Comparison result type
+      typedef bool Mask;
+
+      /// \brief Number of values in a register
+      static const std::size_t Width = 1;
+
+      static Reg Load(const T *_p) { return *_p; }
+      static void Store(T *_p, const Reg _v) { *_p = _v; }
+      static Reg Set1(const T _v) { return _v; }
+      static Reg Add(const Reg _a, const Reg _b) { return _a + _b; }
+      static Reg Sub(const Reg _a, const Reg _b) { return _a - _b; }
+      static Reg Mul(const Reg _a, const Reg _b) { return _a * _b; }
+      static Reg Div(const Reg _a, const Reg _b) { return _a / _b; }
+      static Reg Sqrt(const Reg _a)
+      {
+        // The double overload is the C library function. Rounding its
+        // result to float gives the correctly rounded float square root.
+        return static_cast<T>(std::sqrt(static_cast<double>(_a)));
+      }
+      static Reg Min(const Reg _a, const Reg _b) { return _b < _a ? _b : _a; }
+      static Reg Max(const Reg _a, const Reg _b) { return _a < _b ? _b : _a; }
+      static Mask Gt(const Reg _a, const Reg _b) { return _a > _b; }
+      static Reg Select(const Mask _m, const Reg _a, const Reg _b)
+      {
+        return _m ? _a : _b;
+      }
+      static T ReduceMin(const Reg _a) { return _a; }
+      static T ReduceMax(const Reg _a) { return _a; }
+    };
+
+    /// \internal
+    /// \brief Get the minimum of an array of values.
+    /// \param[in] _v The values.
+    /// \param[in] _n Number of values, greater than zero.
+    /// \return The minimum.
+    template<typename T>
+    T MinOf(const T *_v, const std::size_t _n)
+    {
+      T r = _v[0];
+      for (std::size_t i = 1; i < _n; ++i)
+        r = ScalarPack<T>::Min(r, _v[i]);
+      return r;
+    }
+
+    /// \internal
+    /// \brief Get the maximum of an array of values.
+    /// \param[in] _v The values.
+    /// \param[in] _n Number of values, greater than zero.
+    /// \return The maximum.
+    template<typename T>
+    T MaxOf(const T *_v, const std::size_t _n)
+    {
+      T r = _v[0];
+      for (std::size_t i = 1; i < _n; ++i)
+        r = ScalarPack<T>::Max(r, _v[i]);
+      return r;
+    }
+
+#ifdef IGNITION_MATH_SIMD_SSE2
+    /// \internal
+    /// \brief SSE2 packs
+    template<typename T>
+    struct Sse2Pack;
+
+    /// \internal
+    /// \brief Four floats in an SSE2 register
+    template<>
+    struct Sse2Pack<float>
+    {
+      typedef __m128 Reg;
+      typedef __m128 Mask;
+      static const std::size_t Width = 4;
+
+      static Reg Load(const float *_p) { return _mm_loadu_ps(_p); }
+      static void Store(float *_p, const Reg _v) { _mm_storeu_ps(_p, _v); }
+      static Reg Set1(const float _v) { return _mm_set1_ps(_v); }
+      static Reg Add(const Reg _a, const Reg _b) { return _mm_add_ps(_a, _b); }
+      static Reg Sub(const Reg _a, const Reg _b) { return _mm_sub_ps(_a, _b); }
+      static Reg Mul(const Reg _a, const Reg _b) { return _mm_mul_ps(_a, _b); }
+      static Reg Div(const Reg _a, const Reg _b) { return _mm_div_ps(_a, _b); }
+      static Reg Sqrt(const Reg _a) { return _mm_sqrt_ps(_a); }
+      static Reg Min(const Reg _a, const Reg _b) { return _mm_min_ps(_a, _b); }
+      static Reg Max(const Reg _a, const Reg _b) { return _mm_max_ps(_a, _b); }
+      static Mask Gt(const Reg _a, const Reg _b)
+      {
+        return _mm_cmpgt_ps(_a, _b);
+      }
+      static Reg Select(const Mask _m, const Reg _a, const Reg _b)
+      {
+#ifdef IGNITION_MATH_SIMD_SSE4
+        return _mm_blendv_ps(_b, _a, _m);
+#else
+        return _mm_or_ps(_mm_and_ps(_m, _a), _mm_andnot_ps(_m, _b));
+#endif
+      }
+      static float ReduceMin(const Reg _a)
+      {
+        float v[Width];
+        _mm_storeu_ps(v, _a);
+        return MinOf(v, Width);
+      }
+      static float ReduceMax(const Reg _a)
+      {
+        float v[Width];
+        _mm_storeu_ps(v, _a);
+        return MaxOf(v, Width);
+      }
+    };
+
+    /// \internal
+    /// \brief Two doubles in an SSE2 register
+    template<>
+    struct Sse2Pack<double>
+    {
+      typedef __m128d Reg;
+      typedef __m128d Mask;
+      static const std::size_t Width = 2;
+
+      static Reg Load(const double *_p) { return _mm_loadu_pd(_p); }
+      static void Store(double *_p, const Reg _v) { _mm_storeu_pd(_p, _v); }
+      static Reg Set1(const double _v) { return _mm_set1_pd(_v); }
+      static Reg Add(const Reg _a, const Reg _b) { return _mm_add_pd(_a, _b); }
+      static Reg Sub(const Reg _a, const Reg _b) { return _mm_sub_pd(_a, _b); }
+      static Reg Mul(const Reg _a, const Reg _b) { return _mm_mul_pd(_a, _b); }
+      static Reg Div(const Reg _a, const Reg _b) { return _mm_div_pd(_a, _b); }
+      static Reg Sqrt(const Reg _a) { return _mm_sqrt_pd(_a); }
+      static Reg Min(const Reg _a, const Reg _b) { return _mm_min_pd(_a, _b); }
+      static Reg Max(const Reg _a, const Reg _b) { return _mm_max_pd(_a, _b); }
+      static Mask Gt(const Reg _a, const Reg _b)
+      {
+        return _mm_cmpgt_pd(_a, _b);
+      }
+      static Reg Select(const Mask _m, const Reg _a, const Reg _b)
+      {
+#ifdef IGNITION_MATH_SIMD_SSE4
+        return _mm_blendv_pd(_b, _a, _m);
+#else
+        return _mm_or_pd(_mm_and_pd(_m, _a), _mm_andnot_pd(_m, _b));
+#endif
+      }
+      static double ReduceMin(const Reg _a)
+      {
+        double v[Width];
+        _mm_storeu_pd(v, _a);
+        return MinOf(v, Width);
+      }
+      static double ReduceMax(const Reg _a)
+      {
+        double v[Width];
+        _mm_storeu_pd(v, _a);
+        return MaxOf(v, Width);
+      }
+    };
+#endif
+
+#ifdef IGNITION_MATH_SIMD_AVX2
+    /// \internal
+    /// \brief AVX2 packs
+    template<typename T>
+    struct Avx2Pack;
+
+    /// \internal
+    /// \brief Eight floats in an AVX register
+    template<>
+    struct Avx2Pack<float>
+    {
+      typedef __m256 Reg;
+      typedef __m256 Mask;
+      static const std::size_t Width = 8;
+
+      static Reg Load(const float *_p) { return _mm256_loadu_ps(_p); }
+      static void Store(float *_p, const Reg _v) { _mm256_storeu_ps(_p, _v); }
+      static Reg Set1(const float _v) { return _mm256_set1_ps(_v); }
+      static Reg Add(const Reg _a, const Reg _b)
+      {
+        return _mm256_add_ps(_a, _b);
+      }
+      static Reg Sub(const Reg _a, const Reg _b)
+      {
+        return _mm256_sub_ps(_a, _b);
+      }
+      static Reg Mul(const Reg _a, const Reg _b)
+      {
+        return _mm256_mul_ps(_a, _b);
+      }
+      static Reg Div(const Reg _a, const Reg _b)
+      {
+        return _mm256_div_ps(_a, _b);
+      }
+      static Reg Sqrt(const Reg _a) { return _mm256_sqrt_ps(_a); }
+      static Reg Min(const Reg _a, const Reg _b)
+      {
+        return _mm256_min_ps(_a, _b);
+      }
+      static Reg Max(const Reg _a, const Reg _b)
+      {
+        return _mm256_max_ps(_a, _b);
+      }
+      static Mask Gt(const Reg _a, const Reg _b)
+      {
+        return _mm256_cmp_ps(_a, _b, _CMP_GT_OQ);
+      }
+      static Reg Select(const Mask _m, const Reg _a, const Reg _b)
+      {
+        return _mm256_blendv_ps(_b, _a, _m);
+      }
+      static float ReduceMin(const Reg _a)
+      {
+        float v[Width];
+        _mm256_storeu_ps(v, _a);
+        return MinOf(v, Width);
+      }
+      static float ReduceMax(const Reg _a)
+      {
+        float v[Width];
+        _mm256_storeu_ps(v, _a);
+        return MaxOf(v, Width);
+      }
+    };
+
+    /// \internal
+    /// \brief Four doubles in an AVX register
+    template<>
+    struct Avx2Pack<double>
+    {
+      typedef __m256d Reg;
+      typedef __m256d Mask;
+      static const std::size_t Width = 4;
+
+      static Reg Load(const double *_p) { return _mm256_loadu_pd(_p); }
+      static void Store(double *_p, const Reg _v)
+      {
+        _mm256_storeu_pd(_p, _v);
+      }
+      static Reg Set1(const double _v) { return _mm256_set1_pd(_v); }
+      static Reg Add(const Reg _a, const Reg _b)
+      {
+        return _mm256_add_pd(_a, _b);
+      }
+      static Reg Sub(const Reg _a, const Reg _b)
+      {
+        return _mm256_sub_pd(_a, _b);
+      }
+      static Reg Mul(const Reg _a, const Reg _b)
+      {
+        return _mm256_mul_pd(_a, _b);
+      }
+      static Reg Div(const Reg _a, const Reg _b)
+      {
+        return _mm256_div_pd(_a, _b);
+      }
+      static Reg Sqrt(const Reg _a) { return _mm256_sqrt_pd(_a); }
+      static Reg Min(const Reg _a, const Reg _b)
+      {
+        return _mm256_min_pd(_a, _b);
+      }
+      static Reg Max(const Reg _a, const Reg _b)
+      {
+        return _mm256_max_pd(_a, _b);
+      }
+      static Mask Gt(const Reg _a, const Reg _b)
+      {
+        return _mm256_cmp_pd(_a, _b, _CMP_GT_OQ);
+      }
+      static Reg Select(const Mask _m, const Reg _a, const Reg _b)
+      {
+        return _mm256_blendv_pd(_b, _a, _m);
+      }
+      static double ReduceMin(const Reg _a)
+      {
+        double v[Width];
+        _mm256_storeu_pd(v, _a);
+        return MinOf(v, Width);
+      }
+      static double ReduceMax(const Reg _a)
+      {
+        double v[Width];
+        _mm256_storeu_pd(v, _a);
+        return MaxOf(v, Width);
+      }
+    };
+#endif
+
+#ifdef IGNITION_MATH_SIMD_AVX512
+    /// \internal
+    /// \brief AVX-512 packs
+    template<typename T>
+    struct Avx512Pack;
+
+    /// \internal
+    /// \brief Sixteen floats in an AVX-512 register
+    template<>
+    struct Avx512Pack<float>
+    {
+      typedef __m512 Reg;
+      typedef __mmask16 Mask;
+      static const std::size_t Width = 16;
+
+      static Mask AllLanes() { return static_cast<Mask>(0xFFFF); }
+
+      static Reg Load(const float *_p) { return _mm512_loadu_ps(_p); }
+      static void Store(float *_p, const Reg _v) { _mm512_storeu_ps(_p, _v); }
+      static Reg Set1(const float _v) { return _mm512_set1_ps(_v); }
+      static Reg Add(const Reg _a, const Reg _b)
+      {
+        return _mm512_add_ps(_a, _b);
+      }
+      static Reg Sub(const Reg _a, const Reg _b)
+      {
+        return _mm512_sub_ps(_a, _b);
+      }
+      static Reg Mul(const Reg _a, const Reg _b)
+      {
+        return _mm512_mul_ps(_a, _b);
+      }
+      static Reg Div(const Reg _a, const Reg _b)
+      {
+        return _mm512_div_ps(_a, _b);
+      }
+      // The masked forms with all lanes set compile to the same
+      // instructions. The unmasked ones pass an undefined register to the
+      // builtin, on which GCC 12 reports -Wmaybe-uninitialized.
+      static Reg Sqrt(const Reg _a)
+      {
+        return _mm512_mask_sqrt_ps(_a, AllLanes(), _a);
+      }
+      static Reg Min(const Reg _a, const Reg _b)
+      {
+        return _mm512_mask_min_ps(_a, AllLanes(), _a, _b);
+      }
+      static Reg Max(const Reg _a, const Reg _b)
+      {
+        return _mm512_mask_max_ps(_a, AllLanes(), _a, _b);
+      }
+      static Mask Gt(const Reg _a, const Reg _b)
+      {
+        return _mm512_cmp_ps_mask(_a, _b, _CMP_GT_OQ);
+      }
+      static Reg Select(const Mask _m, const Reg _a, const Reg _b)
+      {
+        return _mm512_mask_blend_ps(_m, _b, _a);
+      }
+      static float ReduceMin(const Reg _a)
+      {
+        float v[Width];
+        _mm512_storeu_ps(v, _a);
+        return MinOf(v, Width);
+      }
+      static float ReduceMax(const Reg _a)
+      {
+        float v[Width];
+        _mm512_storeu_ps(v, _a);
+        return MaxOf(v, Width);
+      }
+    };
+
+    /// \internal
+    /// \brief Eight doubles in an AVX-512 register
+    template<>
+    struct Avx512Pack<double>
+    {
+      typedef __m512d Reg;
+      typedef __mmask8 Mask;
+      static const std::size_t Width = 8;
+
+      static Mask AllLanes() { return static_cast<Mask>(0xFF); }
+
+      static Reg Load(const double *_p) { return _mm512_loadu_pd(_p); }
+      static void Store(double *_p, const Reg _v)
+      {
+        _mm512_storeu_pd(_p, _v);
+      }
+      static Reg Set1(const double _v) { return _mm512_set1_pd(_v); }
+      static Reg Add(const Reg _a, const Reg _b)
+      {
+        return _mm512_add_pd(_a, _b);
+      }
+      static Reg Sub(const Reg _a, const Reg _b)
+      {
+        return _mm512_sub_pd(_a, _b);
+      }
+      static Reg Mul(const Reg _a, const Reg _b)
+      {
+        return _mm512_mul_pd(_a, _b);
+      }
+      static Reg Div(const Reg _a, const Reg _b)
+      {
+        return _mm512_div_pd(_a, _b);
+      }
+      // The masked forms with all lanes set compile to the same
+      // instructions. The unmasked ones pass an undefined register to the
+      // builtin, on which GCC 12 reports -Wmaybe-uninitialized.
+      static Reg Sqrt(const Reg _a)
+      {
+        return _mm512_mask_sqrt_pd(_a, AllLanes(), _a);
+      }
+      static Reg Min(const Reg _a, const Reg _b)
+      {
+        return _mm512_mask_min_pd(_a, AllLanes(), _a, _b);
+      }
+      static Reg Max(const Reg _a, const Reg _b)
+      {
+        return _mm512_mask_max_pd(_a, AllLanes(), _a, _b);
+      }
+      static Mask Gt(const Reg _a, const Reg _b)
+      {
+        return _mm512_cmp_pd_mask(_a, _b, _CMP_GT_OQ);
+      }
+      static Reg Select(const Mask _m, const Reg _a, const Reg _b)
+      {
+        return _mm512_mask_blend_pd(_m, _b, _a);
+      }
+      static double ReduceMin(const Reg _a)
+      {
+        double v[Width];
+        _mm512_storeu_pd(v, _a);
+        return MinOf(v, Width);
+      }
+      static double ReduceMax(const Reg _a)
+      {
+        double v[Width];
+        _mm512_storeu_pd(v, _a);
+        return MaxOf(v, Width);
+      }
+    };
+#endif
+
+    /// \internal
+    /// \brief Call _body(pack, i) for i = 0 to _n - 1, in steps of the
+    /// width of pack P. The elements that do not fill a complete register
+    /// are processed with ScalarPack.
+    /// \param[in] _n Number of elements.
+    /// \param[in] _body Generic callable taking a pack instance, used only
+    /// for its type, and the index of the first element to process.
+    template<typename T, typename P, typename Body>
+    void ForEach(const std::size_t _n, Body _body)
+    {
+      std::size_t i = 0;
+      for (; i + P::Width <= _n; i += P::Width)
+        _body(P(), i);
+      for (; i < _n; ++i)
+        _body(ScalarPack<T>(), i);
+    }
+    }
+    }
+    }
+  }
+}
+#endif
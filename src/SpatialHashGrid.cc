@@ -0,0 +1,602 @@
+/*
+ * Copyright (C) 2018 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <initializer_list>
+#include <limits>
+#include <utility>
+
+#include "ignition/math/SpatialHashGrid.hh"
+
+using namespace ignition;
+using namespace math;
+
+namespace
+{
+  /// \brief Largest cell coordinate. Points further away are put in the
+  /// border cells, which keeps the coordinates of the cells searched by
+  /// the queries from overflowing.
+  const double kMaxCell = 1e15;
+
+  /// \brief Integer coordinates of a cell
+  struct Cell
+  {
+    /// \brief Coordinates along x, y and z
+    std::int64_t c[3];
+  };
+
+  //////////////////////////////////////////////////
+  /// \brief Get the coordinate of the cell that holds a value.
+  /// \param[in] _v The value.
+  /// \param[in] _invCellSize Inverse of the cell size.
+  /// \return The cell coordinate.
+  std::int64_t CellCoord(const double _v, const double _invCellSize)
+  {
+    double v = _v * _invCellSize;
+    // Also replaces NaN
+    if (!(v >= -kMaxCell))
+      v = -kMaxCell;
+    if (!(v <= kMaxCell))
+      v = kMaxCell;
+
+    // Rounding toward minus infinity, without the call to std::floor that
+    // compilers make when SSE4.1 is not enabled
+    const std::int64_t c = static_cast<std::int64_t>(v);
+    return c - (static_cast<double>(c) > v);
+  }
+
+  //////////////////////////////////////////////////
+  /// \brief Get the cell that holds a point.
+  /// \param[in] _p The point.
+  /// \param[in] _invCellSize Inverse of the cell size.
+  /// \return The cell.
+  Cell CellOf(const Vector3d &_p, const double _invCellSize)
+  {
+    return {{CellCoord(_p.X(), _invCellSize),
+             CellCoord(_p.Y(), _invCellSize),
+             CellCoord(_p.Z(), _invCellSize)}};
+  }
+
+  //////////////////////////////////////////////////
+  /// \brief Check if two cells are the same.
+  /// \param[in] _a First cell.
+  /// \param[in] _b Second cell.
+  /// \return True if the cells are the same.
+  bool SameCell(const Cell &_a, const Cell &_b)
+  {
+    return _a.c[0] == _b.c[0] && _a.c[1] == _b.c[1] && _a.c[2] == _b.c[2];
+  }
+
+  //////////////////////////////////////////////////
+  /// \brief Get the bucket of a cell.
+  /// \param[in] _cell The cell.
+  /// \param[in] _mask Number of buckets minus one, the number of buckets
+  /// is a power of two.
+  /// \return The bucket.
+  std::size_t Bucket(const Cell &_cell, const std::size_t _mask)
+  {
+    // Primes of Teschner et al., Optimized Spatial Hashing for Collision
+    // Detection of Deformable Objects, followed by the finalizer of
+    // SplitMix64 so that the low bits depend on all the coordinates.
+    std::uint64_t h = static_cast<std::uint64_t>(_cell.c[0]) * 73856093u +
+                      static_cast<std::uint64_t>(_cell.c[1]) * 19349663u +
+                      static_cast<std::uint64_t>(_cell.c[2]) * 83492791u;
+    h = (h ^ (h >> 30)) * 0xbf58476d1ce4e5b9ull;
+    h = (h ^ (h >> 27)) * 0x94d049bb133111ebull;
+    h ^= h >> 31;
+    return static_cast<std::size_t>(h) & _mask;
+  }
+
+  //////////////////////////////////////////////////
+  /// \brief Check if a cell size is valid.
+  /// \param[in] _cellSize The cell size.
+  /// \return True if _cellSize is a positive finite number.
+  bool ValidCellSize(const double _cellSize)
+  {
+    return _cellSize > 0 &&
+        _cellSize <= std::numeric_limits<double>::max();
+  }
+}  // namespace
+
+/// \brief Private data for SpatialHashGrid
+class ignition::math::SpatialHashGridPrivate
+{
+  /// \brief Build the grid of a set of points.
+  /// \param[in] _points Function that returns a point from its index.
+  /// \param[in] _n Number of points.
+  public: template<typename Points>
+  void Build(const Points &_points, const std::size_t _n);
+
+  /// \brief Move the points of the grid.
+  /// \param[in] _points Function that returns a point from its index.
+  /// \param[in] _n Number of points.
+  /// \return Number of points that changed bucket.
+  public: template<typename Points>
+  std::size_t Update(const Points &_points, const std::size_t _n);
+
+  /// \brief Compute the bucket of each point, and the bounds of the
+  /// cells.
+  /// \param[in] _points Function that returns a point from its index.
+  /// \param[in] _n Number of points.
+  /// \return Number of points whose bucket changed.
+  public: template<typename Points>
+  std::size_t ComputeBuckets(const Points &_points, const std::size_t _n);
+
+  /// \brief Sort the points by bucket, with the buckets of the points
+  /// already computed.
+  /// \param[in] _points Function that returns a point from its index.
+  public: template<typename Points>
+  void Sort(const Points &_points);
+
+  /// \brief Call a function for each point of a cell.
+  /// \param[in] _cell The cell.
+  /// \param[in] _func Function called with the position in points of
+  /// each point of the cell.
+  public: template<typename Func>
+  void ForEachInCell(const Cell &_cell, Func _func) const;
+
+  /// \brief Size of the cells
+  public: double cellSize = 1;
+
+  /// \brief Inverse of the size of the cells
+  public: double invCellSize = 1;
+
+  /// \brief Number of buckets minus one
+  public: std::size_t mask = 0;
+
+  /// \brief Positions of the points, sorted by bucket
+  public: std::vector<Vector3d> points;
+
+  /// \brief Index in the input of each element of points
+  public: std::vector<std::size_t> indices;
+
+  /// \brief Position in points of each input point
+  public: std::vector<std::size_t> slots;
+
+  /// \brief Bucket of each input point
+  public: std::vector<std::size_t> buckets;
+
+  /// \brief Position in points of the first point of each bucket. The
+  /// last element is the number of points.
+  public: std::vector<std::size_t> starts;
+
+  /// \brief Smallest coordinates of the cells that hold points
+  public: Cell minCell = {{0, 0, 0}};
+
+  /// \brief Largest coordinates of the cells that hold points
+  public: Cell maxCell = {{-1, -1, -1}};
+};
+
+//////////////////////////////////////////////////
+template<typename Points>
+void SpatialHashGridPrivate::Build(const Points &_points,
+    const std::size_t _n)
+{
+  std::size_t bucketCount = 1;
+  while (bucketCount < _n)
+    bucketCount *= 2;
+  this->mask = bucketCount - 1;
+
+  this->buckets.assign(_n, 0);
+  this->ComputeBuckets(_points, _n);
+  this->Sort(_points);
+}
+
+//////////////////////////////////////////////////
+template<typename Points>
+std::size_t SpatialHashGridPrivate::Update(const Points &_points,
+    const std::size_t _n)
+{
+  if (_n != this->slots.size())
+  {
+    this->Build(_points, _n);
+    return _n;
+  }
+
+  const std::size_t moved = this->ComputeBuckets(_points, _n);
+  if (moved > 0)
+  {
+    this->Sort(_points);
+    return moved;
+  }
+
+  // Same order, only the positions change
+  for (std::size_t i = 0; i < _n; ++i)
+    this->points[this->slots[i]] = _points(i);
+  return 0;
+}
+
+//////////////////////////////////////////////////
+template<typename Points>
+std::size_t SpatialHashGridPrivate::ComputeBuckets(const Points &_points,
+    const std::size_t _n)
+{
+  this->minCell = {{0, 0, 0}};
+  this->maxCell = {{-1, -1, -1}};
+  std::size_t changed = 0;
+  for (std::size_t i = 0; i < _n; ++i)
+  {
+    const Cell cell = CellOf(_points(i), this->invCellSize);
+    const std::size_t bucket = Bucket(cell, this->mask);
+    changed += bucket != this->buckets[i];
+    this->buckets[i] = bucket;
+
+    for (int a = 0; a < 3; ++a)
+    {
+      if (i == 0 || cell.c[a] < this->minCell.c[a])
+        this->minCell.c[a] = cell.c[a];
+      if (i == 0 || cell.c[a] > this->maxCell.c[a])
+        this->maxCell.c[a] = cell.c[a];
+    }
+  }
+  return changed;
+}
+
+//////////////////////////////////////////////////
+template<typename Points>
+void SpatialHashGridPrivate::Sort(const Points &_points)
+{
+  const std::size_t n = this->buckets.size();
+
+  // Counting sort, stable so that the points of a bucket keep the order
+  // of the input
+  this->starts.assign(this->mask + 2, 0);
+  for (std::size_t i = 0; i < n; ++i)
+    ++this->starts[this->buckets[i] + 1];
+  for (std::size_t b = 1; b < this->starts.size(); ++b)
+    this->starts[b] += this->starts[b - 1];
+
+  this->points.resize(n);
+  this->indices.resize(n);
+  this->slots.resize(n);
+  for (std::size_t i = 0; i < n; ++i)
+  {
+    // starts[b] is used as the insertion position of bucket b, and ends
+    // as the start of bucket b + 1
+    const std::size_t slot = this->starts[this->buckets[i]]++;
+    this->points[slot] = _points(i);
+    this->indices[slot] = i;
+    this->slots[i] = slot;
+  }
+
+  // Shift the insertion positions back to the starts of the buckets
+  for (std::size_t b = this->starts.size() - 1; b > 0; --b)
+    this->starts[b] = this->starts[b - 1];
+  this->starts[0] = 0;
+}
+
+//////////////////////////////////////////////////
+template<typename Func>
+void SpatialHashGridPrivate::ForEachInCell(const Cell &_cell,
+    Func _func) const
+{
+  // Other cells may share the bucket, their points are filtered out by
+  // _func or by the cell check
+  const std::size_t bucket = Bucket(_cell, this->mask);
+  for (std::size_t j = this->starts[bucket]; j < this->starts[bucket + 1];
+       ++j)
+  {
+    _func(j);
+  }
+}
+
+//////////////////////////////////////////////////
+SpatialHashGrid::SpatialHashGrid()
+: dataPtr(new SpatialHashGridPrivate)
+{
+}
+
+//////////////////////////////////////////////////
+SpatialHashGrid::SpatialHashGrid(const double _cellSize)
+: dataPtr(new SpatialHashGridPrivate)
+{
+  if (ValidCellSize(_cellSize))
+  {
+    this->dataPtr->cellSize = _cellSize;
+    this->dataPtr->invCellSize = 1.0 / _cellSize;
+  }
+}
+
+//////////////////////////////////////////////////
+SpatialHashGrid::SpatialHashGrid(const std::vector<Vector3d> &_points,
+    const double _cellSize)
+: SpatialHashGrid(_cellSize)
+{
+  this->Build(_points);
+}
+
+//////////////////////////////////////////////////
+SpatialHashGrid::SpatialHashGrid(const SpatialHashGrid &_grid)
+: dataPtr(new SpatialHashGridPrivate(*_grid.dataPtr))
+{
+}
+
+//////////////////////////////////////////////////
+SpatialHashGrid::~SpatialHashGrid()
+{
+}
+
+//////////////////////////////////////////////////
+SpatialHashGrid &SpatialHashGrid::operator=(const SpatialHashGrid &_grid)
+{
+  *this->dataPtr = *_grid.dataPtr;
+  return *this;
+}
+
+//////////////////////////////////////////////////
+double SpatialHashGrid::CellSize() const
+{
+  return this->dataPtr->cellSize;
+}
+
+//////////////////////////////////////////////////
+bool SpatialHashGrid::SetCellSize(const double _cellSize)
+{
+  if (!ValidCellSize(_cellSize))
+    return false;
+
+  this->dataPtr->cellSize = _cellSize;
+  this->dataPtr->invCellSize = 1.0 / _cellSize;
+
+  // Rebuild from the input order, since points is overwritten
+  std::vector<Vector3d> points(this->dataPtr->slots.size());
+  for (std::size_t i = 0; i < points.size(); ++i)
+    points[i] = this->dataPtr->points[this->dataPtr->slots[i]];
+  this->Build(points);
+  return true;
+}
+
+//////////////////////////////////////////////////
+void SpatialHashGrid::Build(const std::vector<Vector3d> &_points)
+{
+  this->dataPtr->Build([&](const std::size_t _i)
+  {
+    return _points[_i];
+  }, _points.size());
+}
+
+//////////////////////////////////////////////////
+void SpatialHashGrid::Build(const Vector3View<double> &_points)
+{
+  this->dataPtr->Build([&](const std::size_t _i)
+  {
+    return _points[_i];
+  }, _points.Size());
+}
+
+//////////////////////////////////////////////////
+std::size_t SpatialHashGrid::Update(const std::vector<Vector3d> &_points)
+{
+  return this->dataPtr->Update([&](const std::size_t _i)
+  {
+    return _points[_i];
+  }, _points.size());
+}
+
+//////////////////////////////////////////////////
+std::size_t SpatialHashGrid::Update(const Vector3View<double> &_points)
+{
+  return this->dataPtr->Update([&](const std::size_t _i)
+  {
+    return _points[_i];
+  }, _points.Size());
+}
+
+//////////////////////////////////////////////////
+std::size_t SpatialHashGrid::Size() const
+{
+  return this->dataPtr->slots.size();
+}
+
+//////////////////////////////////////////////////
+Vector3d SpatialHashGrid::Point(const std::size_t _index) const
+{
+  if (_index >= this->dataPtr->slots.size())
+    return Vector3d::Zero;
+  return this->dataPtr->points[this->dataPtr->slots[_index]];
+}
+
+//////////////////////////////////////////////////
+bool SpatialHashGrid::InRadius(const Vector3d &_center, const double _radius,
+    std::vector<std::size_t> &_indices) const
+{
+  _indices.clear();
+  const SpatialHashGridPrivate &d = *this->dataPtr;
+  if (d.points.empty() || !(_radius >= 0))
+    return false;
+
+  const double r2 = _radius * _radius;
+  const Vector3d offset(_radius, _radius, _radius);
+  Cell lo = CellOf(_center - offset, d.invCellSize);
+  Cell hi = CellOf(_center + offset, d.invCellSize);
+  double cellCount = 1;
+  for (int a = 0; a < 3; ++a)
+  {
+    lo.c[a] = std::max(lo.c[a], d.minCell.c[a]);
+    hi.c[a] = std::min(hi.c[a], d.maxCell.c[a]);
+    if (lo.c[a] > hi.c[a])
+      return false;
+    cellCount *= static_cast<double>(hi.c[a] - lo.c[a] + 1);
+  }
+
+  // Test every point when there are more cells than buckets
+  if (cellCount > static_cast<double>(d.mask + 1))
+  {
+    for (std::size_t j = 0; j < d.points.size(); ++j)
+    {
+      if ((d.points[j] - _center).SquaredLength() <= r2)
+        _indices.push_back(d.indices[j]);
+    }
+    return !_indices.empty();
+  }
+
+  Cell cell;
+  for (cell.c[0] = lo.c[0]; cell.c[0] <= hi.c[0]; ++cell.c[0])
+  {
+    for (cell.c[1] = lo.c[1]; cell.c[1] <= hi.c[1]; ++cell.c[1])
+    {
+      for (cell.c[2] = lo.c[2]; cell.c[2] <= hi.c[2]; ++cell.c[2])
+      {
+        d.ForEachInCell(cell, [&](const std::size_t _j)
+        {
+          if ((d.points[_j] - _center).SquaredLength() <= r2 &&
+              SameCell(CellOf(d.points[_j], d.invCellSize), cell))
+          {
+            _indices.push_back(d.indices[_j]);
+          }
+        });
+      }
+    }
+  }
+  return !_indices.empty();
+}
+
+//////////////////////////////////////////////////
+bool SpatialHashGrid::Nearest(const Vector3d &_point, const std::size_t _k,
+    std::vector<std::size_t> &_indices) const
+{
+  _indices.clear();
+  const SpatialHashGridPrivate &d = *this->dataPtr;
+  if (d.points.empty() || _k == 0)
+    return false;
+
+  // Max-heap of the closest points found so far, as squared distance and
+  // index
+  typedef std::pair<double, std::size_t> Candidate;
+  const std::size_t k = std::min(_k, d.points.size());
+  std::vector<Candidate> best;
+  best.reserve(k);
+  auto consider = [&](const std::size_t _j)
+  {
+    const Candidate c((d.points[_j] - _point).SquaredLength(), d.indices[_j]);
+    if (std::isnan(c.first))
+      return;
+    if (best.size() < k)
+    {
+      best.push_back(c);
+      std::push_heap(best.begin(), best.end());
+    }
+    else if (c < best.front())
+    {
+      std::pop_heap(best.begin(), best.end());
+      best.back() = c;
+      std::push_heap(best.begin(), best.end());
+    }
+  };
+
+  // Visit the cells by rings of increasing Chebyshev distance to the cell
+  // of _point, starting at the first ring that reaches the points
+  const Cell center = CellOf(_point, d.invCellSize);
+  std::int64_t ring = 0;
+  for (int a = 0; a < 3; ++a)
+  {
+    ring = std::max(ring, d.minCell.c[a] - center.c[a]);
+    ring = std::max(ring, center.c[a] - d.maxCell.c[a]);
+  }
+
+  for (;; ++ring)
+  {
+    Cell lo, hi, clampedLo, clampedHi;
+    double cellCount = 1;
+    bool coversAll = true;
+    for (int a = 0; a < 3; ++a)
+    {
+      lo.c[a] = center.c[a] - ring;
+      hi.c[a] = center.c[a] + ring;
+      clampedLo.c[a] = std::max(lo.c[a], d.minCell.c[a]);
+      clampedHi.c[a] = std::min(hi.c[a], d.maxCell.c[a]);
+      cellCount *= static_cast<double>(clampedHi.c[a] - clampedLo.c[a] + 1);
+      coversAll = coversAll && lo.c[a] <= d.minCell.c[a] &&
+                  hi.c[a] >= d.maxCell.c[a];
+    }
+
+    // Test every point when the cells visited so far outnumber the
+    // buckets
+    if (cellCount > static_cast<double>(d.mask + 1))
+    {
+      best.clear();
+      for (std::size_t j = 0; j < d.points.size(); ++j)
+        consider(j);
+      break;
+    }
+
+    Cell cell;
+    for (cell.c[0] = clampedLo.c[0]; cell.c[0] <= clampedHi.c[0];
+         ++cell.c[0])
+    {
+      for (cell.c[1] = clampedLo.c[1]; cell.c[1] <= clampedHi.c[1];
+           ++cell.c[1])
+      {
+        auto visit = [&]()
+        {
+          d.ForEachInCell(cell, [&](const std::size_t _j)
+          {
+            if (SameCell(CellOf(d.points[_j], d.invCellSize), cell))
+              consider(_j);
+          });
+        };
+
+        if (cell.c[0] == lo.c[0] || cell.c[0] == hi.c[0] ||
+            cell.c[1] == lo.c[1] || cell.c[1] == hi.c[1])
+        {
+          for (cell.c[2] = clampedLo.c[2]; cell.c[2] <= clampedHi.c[2];
+               ++cell.c[2])
+          {
+            visit();
+          }
+        }
+        else
+        {
+          // Only the top and bottom cells of the inner columns are on the
+          // ring
+          for (const std::int64_t z : {lo.c[2], hi.c[2]})
+          {
+            cell.c[2] = z;
+            if (z >= clampedLo.c[2] && z <= clampedHi.c[2])
+              visit();
+          }
+        }
+      }
+    }
+
+    if (coversAll)
+      break;
+
+    // The points of the next rings are further than the faces of the
+    // cube of cells visited so far
+    if (best.size() == k)
+    {
+      double margin = std::numeric_limits<double>::max();
+      for (int a = 0; a < 3; ++a)
+      {
+        margin = std::min(margin, _point[a] -
+            static_cast<double>(lo.c[a]) * d.cellSize);
+        margin = std::min(margin,
+            static_cast<double>(hi.c[a] + 1) * d.cellSize - _point[a]);
+      }
+      if (margin >= 0 && best.front().first <= margin * margin)
+        break;
+    }
+  }
+
+  std::sort_heap(best.begin(), best.end());
+  _indices.reserve(best.size());
+  for (const Candidate &c : best)
+    _indices.push_back(c.second);
+  return !_indices.empty();
+}
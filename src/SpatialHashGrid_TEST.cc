@@ -0,0 +1,285 @@
+/*
+ * Copyright (C) 2018 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "ignition/math/Rand.hh"
+#include "ignition/math/SpatialHashGrid.hh"
+
+using namespace ignition;
+
+/////////////////////////////////////////////////
+/// \brief Random points in a cube of side 2 * _range.
+std::vector<math::Vector3d> RandomPoints(const std::size_t _n,
+    const double _range)
+{
+  std::vector<math::Vector3d> points;
+  for (std::size_t i = 0; i < _n; ++i)
+  {
+    points.push_back(math::Vector3d(math::Rand::DblUniform(-_range, _range),
+        math::Rand::DblUniform(-_range, _range),
+        math::Rand::DblUniform(-_range, _range)));
+  }
+  return points;
+}
+
+/////////////////////////////////////////////////
+/// \brief Find the points within a radius by testing every point.
+std::vector<std::size_t> BruteInRadius(
+    const std::vector<math::Vector3d> &_points, const math::Vector3d &_center,
+    const double _radius)
+{
+  std::vector<std::size_t> indices;
+  for (std::size_t i = 0; i < _points.size(); ++i)
+  {
+    if ((_points[i] - _center).SquaredLength() <= _radius * _radius)
+      indices.push_back(i);
+  }
+  return indices;
+}
+
+/////////////////////////////////////////////////
+/// \brief Find the closest points by testing every point.
+std::vector<std::size_t> BruteNearest(
+    const std::vector<math::Vector3d> &_points, const math::Vector3d &_point,
+    const std::size_t _k)
+{
+  std::vector<std::pair<double, std::size_t>> all;
+  for (std::size_t i = 0; i < _points.size(); ++i)
+    all.push_back(std::make_pair((_points[i] - _point).SquaredLength(), i));
+  std::sort(all.begin(), all.end());
+
+  std::vector<std::size_t> indices;
+  for (std::size_t i = 0; i < std::min(_k, all.size()); ++i)
+    indices.push_back(all[i].second);
+  return indices;
+}
+
+/////////////////////////////////////////////////
+/// \brief Check the queries of a grid against the brute force versions.
+void CheckQueries(const math::SpatialHashGrid &_grid,
+    const std::vector<math::Vector3d> &_points,
+    const std::vector<math::Vector3d> &_queries)
+{
+  std::vector<std::size_t> indices;
+  for (const math::Vector3d &q : _queries)
+  {
+    for (const double radius : {0.0, 0.3, 1.0, 4.0, 100.0})
+    {
+      const std::vector<std::size_t> expected =
+        BruteInRadius(_points, q, radius);
+      EXPECT_EQ(!expected.empty(), _grid.InRadius(q, radius, indices));
+      std::sort(indices.begin(), indices.end());
+      EXPECT_EQ(expected, indices) << q << " " << radius;
+    }
+
+    for (const std::size_t k : {1u, 5u, 40u, 2000u})
+    {
+      EXPECT_TRUE(_grid.Nearest(q, k, indices));
+      EXPECT_EQ(BruteNearest(_points, q, k), indices) << q << " " << k;
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(SpatialHashGridTest, Empty)
+{
+  math::SpatialHashGrid grid;
+  EXPECT_EQ(0u, grid.Size());
+  EXPECT_DOUBLE_EQ(1.0, grid.CellSize());
+  EXPECT_EQ(math::Vector3d::Zero, grid.Point(0));
+
+  std::vector<std::size_t> indices = {1, 2};
+  EXPECT_FALSE(grid.InRadius(math::Vector3d::Zero, 10, indices));
+  EXPECT_TRUE(indices.empty());
+  indices = {1, 2};
+  EXPECT_FALSE(grid.Nearest(math::Vector3d::Zero, 3, indices));
+  EXPECT_TRUE(indices.empty());
+
+  grid.Build(std::vector<math::Vector3d>());
+  EXPECT_EQ(0u, grid.Size());
+  EXPECT_FALSE(grid.Nearest(math::Vector3d::Zero, 3, indices));
+}
+
+/////////////////////////////////////////////////
+TEST(SpatialHashGridTest, CellSize)
+{
+  EXPECT_DOUBLE_EQ(0.5, math::SpatialHashGrid(0.5).CellSize());
+  EXPECT_DOUBLE_EQ(1.0, math::SpatialHashGrid(0).CellSize());
+  EXPECT_DOUBLE_EQ(1.0, math::SpatialHashGrid(-2).CellSize());
+  EXPECT_DOUBLE_EQ(1.0, math::SpatialHashGrid(std::nan("")).CellSize());
+
+  const std::vector<math::Vector3d> points = {
+    math::Vector3d(0, 0, 0), math::Vector3d(1, 0, 0),
+    math::Vector3d(0, 3, 0)};
+  math::SpatialHashGrid grid(points, 2);
+  EXPECT_EQ(3u, grid.Size());
+  EXPECT_EQ(points[2], grid.Point(2));
+  EXPECT_EQ(math::Vector3d::Zero, grid.Point(3));
+
+  EXPECT_FALSE(grid.SetCellSize(0));
+  EXPECT_FALSE(grid.SetCellSize(math::INF_D));
+  EXPECT_DOUBLE_EQ(2.0, grid.CellSize());
+
+  // The points are kept
+  EXPECT_TRUE(grid.SetCellSize(0.1));
+  EXPECT_DOUBLE_EQ(0.1, grid.CellSize());
+  EXPECT_EQ(3u, grid.Size());
+  std::vector<std::size_t> indices;
+  EXPECT_TRUE(grid.InRadius(math::Vector3d(0.5, 0, 0), 0.5, indices));
+  std::sort(indices.begin(), indices.end());
+  EXPECT_EQ(std::vector<std::size_t>({0, 1}), indices);
+  EXPECT_TRUE(grid.Nearest(math::Vector3d(0, 2, 0), 2, indices));
+  EXPECT_EQ(std::vector<std::size_t>({2, 0}), indices);
+}
+
+/////////////////////////////////////////////////
+TEST(SpatialHashGridTest, Queries)
+{
+  math::Rand::Seed(7);
+  const std::vector<math::Vector3d> points = RandomPoints(1000, 5);
+  std::vector<math::Vector3d> queries = RandomPoints(20, 6);
+  queries.push_back(points[3]);
+  // Far from the points
+  queries.push_back(math::Vector3d(1000, -500, 20));
+
+  for (const double cellSize : {0.2, 1.0, 30.0})
+  {
+    math::SpatialHashGrid grid(points, cellSize);
+    EXPECT_EQ(points.size(), grid.Size());
+    CheckQueries(grid, points, queries);
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(SpatialHashGridTest, Clusters)
+{
+  // Dense clusters far apart, and duplicated points
+  math::Rand::Seed(3);
+  std::vector<math::Vector3d> points;
+  for (const math::Vector3d &center : {math::Vector3d(-100, 0, 0),
+        math::Vector3d(100, 50, -20), math::Vector3d(0, 0, 1e6)})
+  {
+    for (const math::Vector3d &p : RandomPoints(200, 1))
+      points.push_back(center + p);
+  }
+  points.push_back(points[10]);
+  points.push_back(points[10]);
+
+  math::SpatialHashGrid grid(points, 0.5);
+  CheckQueries(grid, points, {math::Vector3d(-100, 0, 0),
+      math::Vector3d(0, 0, 0), points[10], math::Vector3d(0, 0, 1e6 + 3)});
+
+  // Ties are sorted by index
+  std::vector<std::size_t> indices;
+  EXPECT_TRUE(grid.Nearest(points[10], 3, indices));
+  EXPECT_EQ(std::vector<std::size_t>({10, 600, 601}), indices);
+}
+
+/////////////////////////////////////////////////
+TEST(SpatialHashGridTest, Update)
+{
+  math::Rand::Seed(5);
+  std::vector<math::Vector3d> points = RandomPoints(500, 4);
+  math::SpatialHashGrid grid(points, 1);
+
+  // Small motions inside the cells keep the order
+  std::vector<math::Vector3d> moved;
+  for (const math::Vector3d &p : points)
+  {
+    moved.push_back(math::Vector3d(std::floor(p.X()) + 0.5,
+          std::floor(p.Y()) + 0.5, std::floor(p.Z()) + 0.5));
+  }
+  grid.Build(moved);
+  for (math::Vector3d &p : moved)
+    p += math::Vector3d(0.1, -0.2, 0.3);
+  EXPECT_EQ(0u, grid.Update(moved));
+  EXPECT_EQ(moved[7], grid.Point(7));
+  CheckQueries(grid, moved, RandomPoints(5, 5));
+
+  // Larger motions move points to other cells
+  for (math::Vector3d &p : moved)
+    p += RandomPoints(1, 2)[0];
+  EXPECT_LT(0u, grid.Update(moved));
+  EXPECT_EQ(moved[7], grid.Point(7));
+  CheckQueries(grid, moved, RandomPoints(5, 5));
+
+  // A different number of points builds the grid again
+  moved.resize(100);
+  EXPECT_EQ(100u, grid.Update(moved));
+  EXPECT_EQ(100u, grid.Size());
+  CheckQueries(grid, moved, RandomPoints(5, 5));
+}
+
+/////////////////////////////////////////////////
+TEST(SpatialHashGridTest, NaN)
+{
+  const double nan = std::nan("");
+  const double inf = std::numeric_limits<double>::infinity();
+  const math::SpatialHashGrid grid({math::Vector3d::Zero,
+      math::Vector3d(nan, 0, 0), math::Vector3d(inf, 0, 0),
+      math::Vector3d(1, 1, 1)}, 0.5);
+
+  // Same rule as KdTree: NaN distances are skipped, infinite ones come
+  // last
+  std::vector<std::size_t> indices;
+  EXPECT_TRUE(grid.Nearest(math::Vector3d::Zero, 4, indices));
+  EXPECT_EQ(std::vector<std::size_t>({0, 3, 2}), indices);
+  EXPECT_TRUE(grid.Nearest(math::Vector3d::Zero, 2, indices));
+  EXPECT_EQ(std::vector<std::size_t>({0, 3}), indices);
+  EXPECT_TRUE(grid.InRadius(math::Vector3d::Zero, 1e6, indices));
+  EXPECT_EQ(2u, indices.size());
+
+  // Nothing is found from a NaN position
+  EXPECT_FALSE(grid.Nearest(math::Vector3d(0, nan, 0), 2, indices));
+  EXPECT_TRUE(indices.empty());
+  EXPECT_FALSE(grid.InRadius(math::Vector3d(0, nan, 0), 1e6, indices));
+}
+
+/////////////////////////////////////////////////
+TEST(SpatialHashGridTest, View)
+{
+  math::Rand::Seed(9);
+  const std::vector<math::Vector3d> points = RandomPoints(300, 3);
+
+  // Interleaved with a fourth value
+  std::vector<double> buffer;
+  for (const math::Vector3d &p : points)
+  {
+    buffer.insert(buffer.end(), {p.X(), p.Y(), p.Z(), 0.0});
+  }
+  const math::Vector3View<double> view(buffer.data(), points.size(), 4);
+
+  math::SpatialHashGrid grid(0.7);
+  grid.Build(view);
+  CheckQueries(grid, points, RandomPoints(5, 4));
+  EXPECT_EQ(0u, grid.Update(view));
+
+  // Copies are independent
+  math::SpatialHashGrid copy(grid);
+  grid.Build(std::vector<math::Vector3d>());
+  EXPECT_EQ(300u, copy.Size());
+  CheckQueries(copy, points, RandomPoints(5, 4));
+  grid = copy;
+  EXPECT_EQ(300u, grid.Size());
+}
@@ -0,0 +1,555 @@
+/*
+ * Copyright (C) 2018 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <unordered_set>
+
+#include "ignition/math/SweepAndPrune.hh"
+#include "BvhBuilder.hh"
+
+using namespace ignition;
+using namespace math;
+using namespace detail;
+
+namespace
+{
+  /// \brief Number of boxes inserted or removed since the last sort above
+  /// which the endpoints are sorted from scratch rather than moved one by
+  /// one across the arrays
+  const std::size_t kMaxIncrementalChanges = 8;
+
+  /// \brief A minimum or maximum of a box along an axis
+  struct Endpoint
+  {
+    /// \brief Coordinate along the axis
+    double value;
+
+    /// \brief Id of the box times 2, plus 1 for a maximum
+    uint32_t code;
+  };
+
+  /// \brief State of an id
+  enum class IdState : uint8_t
+  {
+    /// \brief The id is free
+    FREE,
+
+    /// \brief The id is the id of a box
+    USED,
+
+    /// \brief The box was removed, and its endpoints are still in the
+    /// arrays
+    REMOVED
+  };
+
+  //////////////////////////////////////////////////
+  /// \brief Order of the endpoints. For equal coordinates, minimums come
+  /// first, so that boxes that touch intersect like in
+  /// AxisAlignedBox::Intersects().
+  /// \param[in] _a First endpoint.
+  /// \param[in] _b Second endpoint.
+  /// \return True if _a comes before _b.
+  bool Less(const Endpoint &_a, const Endpoint &_b)
+  {
+    return _a.value < _b.value ||
+           (!(_b.value < _a.value) && (_a.code & 1) < (_b.code & 1));
+  }
+
+  //////////////////////////////////////////////////
+  /// \brief Get the key of a pair of ids.
+  /// \param[in] _a First id.
+  /// \param[in] _b Second id.
+  /// \return The smallest id in the high bits, the largest in the low bits.
+  uint64_t PairKey(const uint32_t _a, const uint32_t _b)
+  {
+    return (static_cast<uint64_t>(std::min(_a, _b)) << 32) |
+           std::max(_a, _b);
+  }
+
+  //////////////////////////////////////////////////
+  /// \brief Get the pairs of ids of a list of keys.
+  /// \param[in] _keys The keys.
+  /// \param[out] _pairs The pairs, appended.
+  void AppendPairs(const std::vector<uint64_t> &_keys,
+      std::vector<std::pair<std::size_t, std::size_t>> &_pairs)
+  {
+    for (const uint64_t key : _keys)
+      _pairs.push_back(std::make_pair(key >> 32, key & 0xffffffff));
+  }
+}  // namespace
+
+/// \brief Private data for SweepAndPrune
+class ignition::math::SweepAndPrunePrivate
+{
+  /// \brief Check if a box can be paired.
+  /// \param[in] _id Id of the box.
+  /// \return True if the box is in use and not empty.
+  public: bool Active(const uint32_t _id) const
+  {
+    return this->state[_id] == IdState::USED && this->nonEmpty[_id];
+  }
+
+  /// \brief Get the axes whose endpoints are kept.
+  /// \param[out] _first First axis.
+  /// \param[out] _end One past the last axis.
+  public: void Axes(int &_first, int &_end) const
+  {
+    _first = this->multiAxis ? 0 : this->sortAxis;
+    _end = this->multiAxis ? 3 : this->sortAxis + 1;
+  }
+
+  /// \brief Update the coordinates of the endpoints of an axis from the
+  /// boxes. The endpoints of the boxes that cannot be paired move to the
+  /// end of the axis.
+  /// \param[in] _axis The axis.
+  public: void Refresh(const int _axis);
+
+  /// \brief Sort the endpoints of an axis by insertion. In multi-axis
+  /// mode, the pairs of boxes whose minimum and maximum endpoints are
+  /// swapped are tested again.
+  /// \param[in] _axis The axis.
+  /// \param[in] _events Whether to test the swapped pairs.
+  public: void InsertionSort(const int _axis, const bool _events);
+
+  /// \brief Find the intersecting pairs by sweeping the sorted endpoints
+  /// of an axis.
+  /// \param[in] _axis The axis.
+  /// \param[out] _keys Sorted keys of the pairs.
+  public: void Sweep(const int _axis, std::vector<uint64_t> &_keys);
+
+  /// \brief Remove the endpoints of the removed boxes and free their ids.
+  public: void Purge();
+
+  /// \brief Bounds of each box
+  public: std::vector<BvhBounds> boxes;
+
+  /// \brief State of each id
+  public: std::vector<IdState> state;
+
+  /// \brief Whether each box is not empty
+  public: std::vector<bool> nonEmpty;
+
+  /// \brief Free ids
+  public: std::vector<uint32_t> freeIds;
+
+  /// \brief Ids of the boxes removed since the last UpdatePairs()
+  public: std::vector<uint32_t> removedIds;
+
+  /// \brief Number of boxes
+  public: std::size_t size = 0;
+
+  /// \brief Endpoints along each axis. Only the sort axis is used in
+  /// single axis mode.
+  public: std::vector<Endpoint> endpoints[3];
+
+  /// \brief Number of boxes inserted since the last UpdatePairs()
+  public: std::size_t inserted = 0;
+
+  /// \brief Whether the endpoints must be sorted from scratch
+  public: bool resort = false;
+
+  /// \brief Whether the endpoints are sorted along the three axes
+  public: bool multiAxis = false;
+
+  /// \brief Sort axis of the single axis mode
+  public: int sortAxis = 0;
+
+  /// \brief Intersecting pairs, kept up to date by the swaps in
+  /// multi-axis mode
+  public: std::unordered_set<uint64_t> current;
+
+  /// \brief Pairs whose state changed since the last UpdatePairs(), in
+  /// multi-axis mode
+  public: std::vector<uint64_t> touched;
+
+  /// \brief Sorted pairs as of the last UpdatePairs()
+  public: std::vector<uint64_t> reported;
+
+  /// \brief Pairs being computed by UpdatePairs()
+  public: std::vector<uint64_t> scratch;
+
+  /// \brief Pairs added or removed by UpdatePairs()
+  public: std::vector<uint64_t> diff;
+
+  /// \brief Boxes overlapping the sweep position
+  public: std::vector<uint32_t> sweepActive;
+};
+
+//////////////////////////////////////////////////
+void SweepAndPrunePrivate::Refresh(const int _axis)
+{
+  for (Endpoint &e : this->endpoints[_axis])
+  {
+    const uint32_t id = e.code >> 1;
+    if (!this->Active(id))
+      e.value = std::numeric_limits<double>::max();
+    else if (e.code & 1)
+      e.value = this->boxes[id].max[_axis];
+    else
+      e.value = this->boxes[id].min[_axis];
+  }
+}
+
+//////////////////////////////////////////////////
+void SweepAndPrunePrivate::InsertionSort(const int _axis, const bool _events)
+{
+  std::vector<Endpoint> &e = this->endpoints[_axis];
+  for (std::size_t i = 1; i < e.size(); ++i)
+  {
+    const Endpoint moving = e[i];
+    std::size_t j = i;
+    for (; j > 0 && Less(moving, e[j - 1]); --j)
+    {
+      const Endpoint &passed = e[j - 1];
+      e[j] = passed;
+
+      // A minimum passing a maximum, or the reverse, is the only way for
+      // two boxes to start or stop overlapping along the axis. The pair
+      // is tested along all the axes with the final coordinates.
+      if (!_events || (passed.code & 1) == (moving.code & 1))
+        continue;
+      const uint32_t a = moving.code >> 1;
+      const uint32_t b = passed.code >> 1;
+      if (a == b)
+        continue;
+      const uint64_t key = PairKey(a, b);
+      if (this->Active(a) && this->Active(b) &&
+          this->boxes[a].Intersects(this->boxes[b]))
+      {
+        if (this->current.insert(key).second)
+          this->touched.push_back(key);
+      }
+      else if (this->current.erase(key) > 0)
+      {
+        this->touched.push_back(key);
+      }
+    }
+    e[j] = moving;
+  }
+}
+
+//////////////////////////////////////////////////
+void SweepAndPrunePrivate::Sweep(const int _axis,
+    std::vector<uint64_t> &_keys)
+{
+  _keys.clear();
+  this->sweepActive.clear();
+  for (const Endpoint &e : this->endpoints[_axis])
+  {
+    const uint32_t id = e.code >> 1;
+    if (!this->Active(id))
+      continue;
+
+    if (e.code & 1)
+    {
+      auto it = std::find(this->sweepActive.begin(),
+          this->sweepActive.end(), id);
+      *it = this->sweepActive.back();
+      this->sweepActive.pop_back();
+      continue;
+    }
+
+    const BvhBounds &box = this->boxes[id];
+    for (const uint32_t other : this->sweepActive)
+    {
+      if (box.Intersects(this->boxes[other]))
+        _keys.push_back(PairKey(id, other));
+    }
+    this->sweepActive.push_back(id);
+  }
+  std::sort(_keys.begin(), _keys.end());
+}
+
+//////////////////////////////////////////////////
+void SweepAndPrunePrivate::Purge()
+{
+  if (this->removedIds.empty())
+    return;
+
+  int first, end;
+  this->Axes(first, end);
+  for (int a = first; a < end; ++a)
+  {
+    auto &e = this->endpoints[a];
+    e.erase(std::remove_if(e.begin(), e.end(), [this](const Endpoint &_e)
+        {
+          return this->state[_e.code >> 1] == IdState::REMOVED;
+        }), e.end());
+  }
+  for (const uint32_t id : this->removedIds)
+  {
+    this->state[id] = IdState::FREE;
+    this->freeIds.push_back(id);
+  }
+  this->removedIds.clear();
+}
+
+//////////////////////////////////////////////////
+SweepAndPrune::SweepAndPrune(const bool _multiAxis)
+: dataPtr(new SweepAndPrunePrivate)
+{
+  this->dataPtr->multiAxis = _multiAxis;
+}
+
+//////////////////////////////////////////////////
+SweepAndPrune::SweepAndPrune(const SweepAndPrune &_sap)
+: dataPtr(new SweepAndPrunePrivate(*_sap.dataPtr))
+{
+}
+
+//////////////////////////////////////////////////
+SweepAndPrune::~SweepAndPrune()
+{
+}
+
+//////////////////////////////////////////////////
+SweepAndPrune &SweepAndPrune::operator=(const SweepAndPrune &_sap)
+{
+  *this->dataPtr = *_sap.dataPtr;
+  return *this;
+}
+
+//////////////////////////////////////////////////
+bool SweepAndPrune::MultiAxis() const
+{
+  return this->dataPtr->multiAxis;
+}
+
+//////////////////////////////////////////////////
+int SweepAndPrune::SortAxis() const
+{
+  return this->dataPtr->sortAxis;
+}
+
+//////////////////////////////////////////////////
+bool SweepAndPrune::SetSortAxis(const int _axis)
+{
+  if (_axis < 0 || _axis > 2)
+    return false;
+
+  SweepAndPrunePrivate &d = *this->dataPtr;
+  if (_axis == d.sortAxis)
+    return true;
+
+  if (!d.multiAxis)
+  {
+    d.endpoints[_axis].swap(d.endpoints[d.sortAxis]);
+    d.endpoints[d.sortAxis].clear();
+    d.resort = true;
+  }
+  d.sortAxis = _axis;
+  return true;
+}
+
+//////////////////////////////////////////////////
+std::size_t SweepAndPrune::Insert(const AxisAlignedBox &_box)
+{
+  SweepAndPrunePrivate &d = *this->dataPtr;
+  uint32_t id;
+  if (!d.freeIds.empty())
+  {
+    id = d.freeIds.back();
+    d.freeIds.pop_back();
+  }
+  else
+  {
+    id = static_cast<uint32_t>(d.boxes.size());
+    d.boxes.emplace_back();
+    d.state.push_back(IdState::FREE);
+    d.nonEmpty.push_back(false);
+  }
+  d.state[id] = IdState::USED;
+  ++d.size;
+  ++d.inserted;
+  this->Update(id, _box);
+
+  // The endpoints start at the end of the arrays and are sorted into
+  // place by the next UpdatePairs()
+  int first, end;
+  d.Axes(first, end);
+  for (int a = first; a < end; ++a)
+  {
+    d.endpoints[a].push_back({std::numeric_limits<double>::max(), id << 1});
+    d.endpoints[a].push_back(
+        {std::numeric_limits<double>::max(), (id << 1) | 1});
+  }
+  return id;
+}
+
+//////////////////////////////////////////////////
+bool SweepAndPrune::Remove(const std::size_t _id)
+{
+  if (!this->Has(_id))
+    return false;
+
+  SweepAndPrunePrivate &d = *this->dataPtr;
+  const uint32_t id = static_cast<uint32_t>(_id);
+  d.state[id] = IdState::REMOVED;
+  d.removedIds.push_back(id);
+  --d.size;
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool SweepAndPrune::Update(const std::size_t _id, const AxisAlignedBox &_box)
+{
+  if (!this->Has(_id))
+    return false;
+
+  SweepAndPrunePrivate &d = *this->dataPtr;
+  BvhBounds &b = d.boxes[_id];
+  bool nonEmpty = true;
+  for (int a = 0; a < 3; ++a)
+  {
+    b.min[a] = _box.Min()[a];
+    b.max[a] = _box.Max()[a];
+    // Also catches NaN
+    nonEmpty = nonEmpty && b.min[a] <= b.max[a];
+  }
+  d.nonEmpty[_id] = nonEmpty;
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool SweepAndPrune::UpdatePairs(
+    std::vector<std::pair<std::size_t, std::size_t>> &_added,
+    std::vector<std::pair<std::size_t, std::size_t>> &_removed)
+{
+  SweepAndPrunePrivate &d = *this->dataPtr;
+  _added.clear();
+  _removed.clear();
+
+  int first, end;
+  d.Axes(first, end);
+  for (int a = first; a < end; ++a)
+    d.Refresh(a);
+
+  // Moving many new or removed endpoints across the arrays one swap at a
+  // time costs more than sorting from scratch
+  const bool fromScratch = d.resort ||
+    d.inserted + d.removedIds.size() > kMaxIncrementalChanges;
+  std::vector<uint64_t> &keys = d.scratch;
+  if (fromScratch)
+  {
+    for (int a = first; a < end; ++a)
+    {
+      std::sort(d.endpoints[a].begin(), d.endpoints[a].end(), Less);
+    }
+    d.Purge();
+    d.Sweep(first, keys);
+    if (d.multiAxis)
+    {
+      d.current.clear();
+      d.current.insert(keys.begin(), keys.end());
+      d.touched.clear();
+    }
+  }
+  else
+  {
+    for (int a = first; a < end; ++a)
+      d.InsertionSort(a, d.multiAxis);
+    d.Purge();
+
+    if (d.multiAxis)
+    {
+      std::sort(d.touched.begin(), d.touched.end());
+      d.touched.erase(std::unique(d.touched.begin(), d.touched.end()),
+          d.touched.end());
+      // Start from the reported pairs and apply the changes. Both lists
+      // are sorted: keep the reported keys that are not touched and the
+      // touched keys that overlap now.
+      keys.clear();
+      auto it = d.reported.begin();
+      for (const uint64_t key : d.touched)
+      {
+        for (; it != d.reported.end() && *it < key; ++it)
+          keys.push_back(*it);
+        if (it != d.reported.end() && *it == key)
+          ++it;
+        if (d.current.count(key) > 0)
+          keys.push_back(key);
+      }
+      keys.insert(keys.end(), it, d.reported.end());
+      d.touched.clear();
+    }
+    else
+    {
+      d.Sweep(first, keys);
+    }
+  }
+  d.inserted = 0;
+  d.resort = false;
+
+  // Compare the sorted pairs with the previous ones
+  std::vector<uint64_t> &diff = d.diff;
+  diff.clear();
+  std::set_difference(keys.begin(), keys.end(), d.reported.begin(),
+      d.reported.end(), std::back_inserter(diff));
+  AppendPairs(diff, _added);
+  diff.clear();
+  std::set_difference(d.reported.begin(), d.reported.end(), keys.begin(),
+      keys.end(), std::back_inserter(diff));
+  AppendPairs(diff, _removed);
+  d.reported.swap(keys);
+
+  return !_added.empty() || !_removed.empty();
+}
+
+//////////////////////////////////////////////////
+void SweepAndPrune::Pairs(
+    std::vector<std::pair<std::size_t, std::size_t>> &_pairs) const
+{
+  _pairs.clear();
+  AppendPairs(this->dataPtr->reported, _pairs);
+}
+
+//////////////////////////////////////////////////
+void SweepAndPrune::Clear()
+{
+  SweepAndPrunePrivate &d = *this->dataPtr;
+  const bool multiAxis = d.multiAxis;
+  const int sortAxis = d.sortAxis;
+  d = SweepAndPrunePrivate();
+  d.multiAxis = multiAxis;
+  d.sortAxis = sortAxis;
+}
+
+//////////////////////////////////////////////////
+std::size_t SweepAndPrune::Size() const
+{
+  return this->dataPtr->size;
+}
+
+//////////////////////////////////////////////////
+bool SweepAndPrune::Has(const std::size_t _id) const
+{
+  return _id < this->dataPtr->state.size() &&
+         this->dataPtr->state[_id] == IdState::USED;
+}
+
+//////////////////////////////////////////////////
+AxisAlignedBox SweepAndPrune::Box(const std::size_t _id) const
+{
+  if (!this->Has(_id) || !this->dataPtr->nonEmpty[_id])
+    return AxisAlignedBox();
+
+  const BvhBounds &b = this->dataPtr->boxes[_id];
+  return AxisAlignedBox(Vector3d(b.min[0], b.min[1], b.min[2]),
+                        Vector3d(b.max[0], b.max[1], b.max[2]));
+}
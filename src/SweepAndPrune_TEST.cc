@@ -0,0 +1,241 @@
+/*
+ * Copyright (C) 2018 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <set>
+#include <utility>
+#include <vector>
+
+#include "ignition/math/Rand.hh"
+#include "ignition/math/SweepAndPrune.hh"
+
+using namespace ignition;
+
+/// \brief A pair of ids
+typedef std::pair<std::size_t, std::size_t> IdPair;
+
+/////////////////////////////////////////////////
+/// \brief Random box of size up to _size with its minimum corner in a
+/// cube of side 2 * _range.
+math::AxisAlignedBox RandomBox(const double _range, const double _size)
+{
+  const math::Vector3d min(math::Rand::DblUniform(-_range, _range),
+      math::Rand::DblUniform(-_range, _range),
+      math::Rand::DblUniform(-_range, _range));
+  const math::Vector3d size(math::Rand::DblUniform(0, _size),
+      math::Rand::DblUniform(0, _size), math::Rand::DblUniform(0, _size));
+  return math::AxisAlignedBox(min, min + size);
+}
+
+/////////////////////////////////////////////////
+math::Vector3d RandomVector(const double _range)
+{
+  return math::Vector3d(math::Rand::DblUniform(-_range, _range),
+      math::Rand::DblUniform(-_range, _range),
+      math::Rand::DblUniform(-_range, _range));
+}
+
+/////////////////////////////////////////////////
+/// \brief Intersecting pairs, found by testing all the pairs.
+std::vector<IdPair> BrutePairs(const math::SweepAndPrune &_sap,
+    const std::vector<math::AxisAlignedBox> &_boxes)
+{
+  std::vector<IdPair> pairs;
+  for (std::size_t i = 0; i < _boxes.size(); ++i)
+  {
+    for (std::size_t j = i + 1; j < _boxes.size(); ++j)
+    {
+      if (_sap.Has(i) && _sap.Has(j) && _boxes[i].Intersects(_boxes[j]))
+        pairs.push_back(IdPair(i, j));
+    }
+  }
+  return pairs;
+}
+
+/////////////////////////////////////////////////
+TEST(SweepAndPruneTest, Construct)
+{
+  math::SweepAndPrune sap;
+  EXPECT_FALSE(sap.MultiAxis());
+  EXPECT_EQ(0, sap.SortAxis());
+  EXPECT_EQ(0u, sap.Size());
+  EXPECT_FALSE(sap.Has(0));
+
+  EXPECT_TRUE(sap.SetSortAxis(2));
+  EXPECT_EQ(2, sap.SortAxis());
+  EXPECT_FALSE(sap.SetSortAxis(3));
+  EXPECT_FALSE(sap.SetSortAxis(-1));
+  EXPECT_EQ(2, sap.SortAxis());
+
+  math::SweepAndPrune multi(true);
+  EXPECT_TRUE(multi.MultiAxis());
+
+  std::vector<IdPair> added, removed;
+  EXPECT_FALSE(sap.UpdatePairs(added, removed));
+  EXPECT_FALSE(multi.UpdatePairs(added, removed));
+}
+
+/////////////////////////////////////////////////
+TEST(SweepAndPruneTest, Pairs)
+{
+  for (const bool multiAxis : {false, true})
+  {
+    math::SweepAndPrune sap(multiAxis);
+    EXPECT_EQ(0u, sap.Insert(math::AxisAlignedBox(0, 0, 0, 2, 2, 2)));
+    EXPECT_EQ(1u, sap.Insert(math::AxisAlignedBox(1, 1, 1, 3, 3, 3)));
+    // Touching boxes intersect
+    EXPECT_EQ(2u, sap.Insert(math::AxisAlignedBox(3, 0, 0, 4, 1, 1)));
+    EXPECT_EQ(3u, sap.Insert(math::AxisAlignedBox()));
+    EXPECT_EQ(4u, sap.Size());
+    EXPECT_EQ(math::AxisAlignedBox(1, 1, 1, 3, 3, 3), sap.Box(1));
+    EXPECT_EQ(math::AxisAlignedBox(), sap.Box(3));
+
+    std::vector<IdPair> added, removed, pairs;
+    EXPECT_TRUE(sap.UpdatePairs(added, removed));
+    EXPECT_EQ(std::vector<IdPair>({{0, 1}, {1, 2}}), added);
+    EXPECT_TRUE(removed.empty());
+    sap.Pairs(pairs);
+    EXPECT_EQ(added, pairs);
+
+    // Nothing changes without updates
+    EXPECT_FALSE(sap.UpdatePairs(added, removed));
+
+    EXPECT_TRUE(sap.Update(2, math::AxisAlignedBox(5, 0, 0, 6, 1, 1)));
+    EXPECT_TRUE(sap.Update(3, math::AxisAlignedBox(1.5, 0, 0, 5, 1, 1)));
+    EXPECT_TRUE(sap.UpdatePairs(added, removed));
+    EXPECT_EQ(std::vector<IdPair>({{0, 3}, {1, 3}, {2, 3}}), added);
+    EXPECT_EQ(std::vector<IdPair>({{1, 2}}), removed);
+
+    // Removed boxes lose their pairs, and their id is reused after the
+    // next update
+    EXPECT_TRUE(sap.Remove(1));
+    EXPECT_FALSE(sap.Remove(1));
+    EXPECT_FALSE(sap.Update(1, math::AxisAlignedBox(0, 0, 0, 1, 1, 1)));
+    EXPECT_FALSE(sap.Has(1));
+    EXPECT_EQ(4u, sap.Insert(math::AxisAlignedBox(0, 0, 0, 1, 1, 1)));
+    EXPECT_TRUE(sap.UpdatePairs(added, removed));
+    EXPECT_EQ(std::vector<IdPair>({{0, 4}}), added);
+    EXPECT_EQ(std::vector<IdPair>({{0, 1}, {1, 3}}), removed);
+    EXPECT_EQ(1u, sap.Insert(math::AxisAlignedBox(9, 9, 9, 9, 9, 9)));
+
+    sap.Clear();
+    EXPECT_EQ(0u, sap.Size());
+    EXPECT_FALSE(sap.Has(0));
+    EXPECT_EQ(multiAxis, sap.MultiAxis());
+    sap.Pairs(pairs);
+    EXPECT_TRUE(pairs.empty());
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(SweepAndPruneTest, CoherentMotion)
+{
+  for (const bool multiAxis : {false, true})
+  {
+    math::SweepAndPrune sap(multiAxis);
+    std::vector<math::AxisAlignedBox> boxes;
+    std::vector<math::Vector3d> vel;
+    for (int i = 0; i < 400; ++i)
+    {
+      boxes.push_back(RandomBox(15, 3));
+      vel.push_back(RandomVector(0.2));
+      sap.Insert(boxes.back());
+    }
+
+    std::vector<IdPair> added, removed, pairs;
+    std::set<IdPair> known;
+    for (int step = 0; step < 60; ++step)
+    {
+      for (std::size_t i = 0; i < boxes.size(); ++i)
+      {
+        if (!sap.Has(i))
+          continue;
+        boxes[i] = math::AxisAlignedBox(boxes[i].Min() + vel[i],
+            boxes[i].Max() + vel[i]);
+        EXPECT_TRUE(sap.Update(i, boxes[i]));
+      }
+
+      // A few insertions and removals are sorted incrementally, many
+      // are sorted from scratch
+      const int changes = step % 20 == 10 ? 30 : 2;
+      if (step % 5 == 2)
+      {
+        for (int c = 0; c < changes; ++c)
+        {
+          const std::size_t id = (step * 7 + c * 13) % boxes.size();
+          if (sap.Has(id))
+          {
+            EXPECT_TRUE(sap.Remove(id));
+          }
+        }
+      }
+      if (step % 5 == 3)
+      {
+        for (int c = 0; c < changes; ++c)
+        {
+          const math::AxisAlignedBox box = RandomBox(15, 3);
+          const std::size_t id = sap.Insert(box);
+          if (id == boxes.size())
+          {
+            boxes.push_back(box);
+            vel.push_back(RandomVector(0.2));
+          }
+          boxes[id] = box;
+        }
+      }
+      if (step == 40)
+      {
+        EXPECT_TRUE(sap.SetSortAxis(1));
+      }
+
+      sap.UpdatePairs(added, removed);
+      for (const auto &p : removed)
+        EXPECT_EQ(1u, known.erase(p));
+      for (const auto &p : added)
+        EXPECT_TRUE(known.insert(p).second);
+
+      const std::vector<IdPair> expected = BrutePairs(sap, boxes);
+      EXPECT_EQ(expected, std::vector<IdPair>(known.begin(), known.end()));
+      sap.Pairs(pairs);
+      EXPECT_EQ(expected, pairs);
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(SweepAndPruneTest, Copy)
+{
+  math::SweepAndPrune sap(true);
+  for (int i = 0; i < 100; ++i)
+    sap.Insert(RandomBox(10, 3));
+  std::vector<IdPair> added, removed, pairs;
+  sap.UpdatePairs(added, removed);
+
+  const math::SweepAndPrune copy(sap);
+  math::SweepAndPrune assigned;
+  assigned = sap;
+  sap.Clear();
+
+  copy.Pairs(pairs);
+  EXPECT_EQ(added, pairs);
+  assigned.Pairs(pairs);
+  EXPECT_EQ(added, pairs);
+  EXPECT_TRUE(assigned.MultiAxis());
+  EXPECT_EQ(100u, copy.Size());
+  EXPECT_EQ(0u, sap.Size());
+}
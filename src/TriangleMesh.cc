@@ -0,0 +1,410 @@
+/*
+ * Copyright (C) 2018 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+#include "ignition/math/TriangleMesh.hh"
+#include "ignition/math/detail/AlignedAllocator.hh"
+#include "BatchKernels.hh"
+#include "BvhBuilder.hh"
+
+using namespace ignition;
+using namespace math;
+using namespace detail;
+
+namespace
+{
+  /// \brief Number of triangles given to the kernel at once, at least the
+  /// size of the leaves
+  const uint32_t kChunkSize = 16;
+
+  /// \brief A ray, prepared for the watertight triangle test.
+  struct TriangleRay
+  {
+    /// \brief Constructor.
+    /// \param[in] _ray The ray, with a normalized direction.
+    explicit TriangleRay(const BvhRay &_ray)
+    {
+      // The z axis is the largest component of the direction, and x and
+      // y are swapped to preserve the winding of the triangles
+      int kz = 0;
+      for (int a = 1; a < 3; ++a)
+      {
+        if (std::abs(_ray.dir[a]) > std::abs(_ray.dir[kz]))
+          kz = a;
+      }
+      int kx = (kz + 1) % 3;
+      int ky = (kx + 1) % 3;
+      if (_ray.dir[kz] < 0)
+        std::swap(kx, ky);
+
+      this->axes[0] = kx;
+      this->axes[1] = ky;
+      this->axes[2] = kz;
+      for (int a = 0; a < 3; ++a)
+        this->origin[a] = _ray.origin[this->axes[a]];
+      this->shear[0] = _ray.dir[kx] / _ray.dir[kz];
+      this->shear[1] = _ray.dir[ky] / _ray.dir[kz];
+      this->shear[2] = 1 / _ray.dir[kz];
+    }
+
+    /// \brief Axes of the original coordinates, in the order x, y, z of
+    /// the sheared coordinates
+    int axes[3];
+
+    /// \brief Origin of the ray, permuted
+    double origin[3];
+
+    /// \brief Shear and scale constants
+    double shear[3];
+  };
+}  // namespace
+
+// Private data for TriangleMesh class
+class ignition::math::TriangleMeshPrivate
+{
+  /// \brief Storage of one component of the corners
+  public: typedef std::vector<double, detail::AlignedAllocator<double>>
+          Storage;
+
+  /// \brief Build the hierarchy of the triangles in vertices and
+  /// indices.
+  public: void Build()
+  {
+    const std::size_t count = this->indices.size() / 3;
+    std::vector<BvhBuildBox> boxes(count);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+      BvhBuildBox &b = boxes[i];
+      for (int c = 0; c < 3; ++c)
+      {
+        const Vector3d &v = this->vertices[this->indices[3 * i + c]];
+        const double p[3] = {v.X(), v.Y(), v.Z()};
+        b.bounds.Grow(p);
+      }
+      for (int a = 0; a < 3; ++a)
+        b.centroid[a] = 0.5 * (b.bounds.min[a] + b.bounds.max[a]);
+      b.index = i;
+    }
+
+    this->nodes.clear();
+    this->order.clear();
+    for (int c = 0; c < 3; ++c)
+    {
+      for (int a = 0; a < 3; ++a)
+        this->corners[c][a].clear();
+    }
+    if (boxes.empty())
+      return;
+
+    BvhBuilder::Build(boxes, this->nodes);
+
+    this->order.reserve(count);
+    for (int c = 0; c < 3; ++c)
+    {
+      for (int a = 0; a < 3; ++a)
+        this->corners[c][a].reserve(count);
+    }
+    for (const BvhBuildBox &b : boxes)
+    {
+      this->order.push_back(b.index);
+      for (int c = 0; c < 3; ++c)
+      {
+        const Vector3d &v = this->vertices[this->indices[3 * b.index + c]];
+        for (int a = 0; a < 3; ++a)
+          this->corners[c][a].push_back(v[a]);
+      }
+    }
+  }
+
+  /// \brief Test a ray against consecutive triangles.
+  /// \param[in] _ray The ray.
+  /// \param[in] _triRay The ray, prepared for the triangle test.
+  /// \param[in] _first Position of the first triangle, in leaf order.
+  /// \param[in] _count Number of triangles, at most kChunkSize.
+  /// \param[in] _tMax Maximum distance of interest.
+  /// \param[out] _dist Distance to each triangle, or -1 if it is missed.
+  public: void TestTriangles(const BvhRay &_ray, const TriangleRay &_triRay,
+              const uint32_t _first, const uint32_t _count,
+              const double _tMax, double *_dist) const
+  {
+    const int *axes = _triRay.axes;
+    auto corner = [&](const int _c) -> ConstSoa3<double>
+    {
+      return {this->corners[_c][axes[0]].data() + _first,
+              this->corners[_c][axes[1]].data() + _first,
+              this->corners[_c][axes[2]].data() + _first};
+    };
+    simd::BatchKernels<double>().rayTriangle(corner(0), corner(1),
+        corner(2), _triRay.origin, _triRay.shear, _ray.tMin, _tMax, _dist,
+        _count);
+  }
+
+  /// \brief Find the closest triangle hit by a ray.
+  /// \param[in] _ray The ray.
+  /// \param[out] _dist Distance to the closest hit.
+  /// \param[out] _index Index of the closest triangle.
+  /// \return True if the ray hits a triangle.
+  public: bool Closest(const BvhRay &_ray, double &_dist,
+              std::size_t &_index) const
+  {
+    const TriangleRay triRay(_ray);
+    double best = _ray.tMax;
+    bool hit = false;
+    BvhTraverseNearest(this->nodes, _ray, best,
+        [&](const uint32_t _first, const uint32_t _count)
+        {
+          double dist[kChunkSize];
+          for (uint32_t i = _first; i < _first + _count; i += kChunkSize)
+          {
+            const uint32_t n = std::min(kChunkSize, _first + _count - i);
+            this->TestTriangles(_ray, triRay, i, n, best, dist);
+            for (uint32_t j = 0; j < n; ++j)
+            {
+              const std::size_t index = this->order[i + j];
+              if (dist[j] >= 0 && (!hit || dist[j] < best ||
+                    (!(best < dist[j]) && index < _index)))
+              {
+                hit = true;
+                best = dist[j];
+                _index = index;
+              }
+            }
+          }
+        });
+    _dist = best;
+    return hit;
+  }
+
+  /// \brief Check if a ray hits any triangle.
+  /// \param[in] _ray The ray.
+  /// \return True if the ray hits a triangle.
+  public: bool Any(const BvhRay &_ray) const
+  {
+    const TriangleRay triRay(_ray);
+    bool hit = false;
+    double t;
+    BvhTraverse(this->nodes,
+        [&](const BvhBounds &_b) {return _ray.HitNode(_b, _ray.tMax, t);},
+        [&](const uint32_t _first, const uint32_t _count)
+        {
+          double dist[kChunkSize];
+          for (uint32_t i = _first; i < _first + _count && !hit;
+               i += kChunkSize)
+          {
+            const uint32_t n = std::min(kChunkSize, _first + _count - i);
+            this->TestTriangles(_ray, triRay, i, n, _ray.tMax, dist);
+            for (uint32_t j = 0; j < n; ++j)
+              hit = hit || dist[j] >= 0;
+          }
+          return !hit;
+        });
+    return hit;
+  }
+
+  /// \brief Nodes in depth-first order
+  public: std::vector<BvhNode> nodes;
+
+  /// \brief Components of the corners of the triangles, in the order of
+  /// the leaves, indexed by corner then axis
+  public: Storage corners[3][3];
+
+  /// \brief Index of the triangle at each position in the leaf order
+  public: std::vector<std::size_t> order;
+
+  /// \brief Vertices of the mesh
+  public: std::vector<Vector3d> vertices;
+
+  /// \brief Indices of the corners of the triangles
+  public: std::vector<unsigned int> indices;
+};
+
+//////////////////////////////////////////////////
+TriangleMesh::TriangleMesh()
+: dataPtr(new TriangleMeshPrivate)
+{
+}
+
+//////////////////////////////////////////////////
+TriangleMesh::TriangleMesh(const std::vector<Vector3d> &_vertices,
+    const std::vector<unsigned int> &_indices)
+: dataPtr(new TriangleMeshPrivate)
+{
+  this->Build(_vertices, _indices);
+}
+
+//////////////////////////////////////////////////
+TriangleMesh::TriangleMesh(const std::vector<Triangle3d> &_triangles)
+: dataPtr(new TriangleMeshPrivate)
+{
+  this->Build(_triangles);
+}
+
+//////////////////////////////////////////////////
+TriangleMesh::TriangleMesh(const TriangleMesh &_mesh)
+: dataPtr(new TriangleMeshPrivate(*_mesh.dataPtr))
+{
+}
+
+//////////////////////////////////////////////////
+TriangleMesh::~TriangleMesh()
+{
+}
+
+//////////////////////////////////////////////////
+TriangleMesh &TriangleMesh::operator=(const TriangleMesh &_mesh)
+{
+  *this->dataPtr = *_mesh.dataPtr;
+  return *this;
+}
+
+//////////////////////////////////////////////////
+bool TriangleMesh::Build(const std::vector<Vector3d> &_vertices,
+    const std::vector<unsigned int> &_indices)
+{
+  bool valid = _indices.size() % 3 == 0;
+  for (std::size_t i = 0; i < _indices.size() && valid; ++i)
+    valid = _indices[i] < _vertices.size();
+
+  if (valid)
+  {
+    this->dataPtr->vertices = _vertices;
+    this->dataPtr->indices = _indices;
+  }
+  else
+  {
+    this->dataPtr->vertices.clear();
+    this->dataPtr->indices.clear();
+  }
+  this->dataPtr->Build();
+  return valid;
+}
+
+//////////////////////////////////////////////////
+void TriangleMesh::Build(const std::vector<Triangle3d> &_triangles)
+{
+  this->dataPtr->vertices.clear();
+  this->dataPtr->indices.clear();
+  this->dataPtr->vertices.reserve(3 * _triangles.size());
+  this->dataPtr->indices.reserve(3 * _triangles.size());
+  for (const Triangle3d &tri : _triangles)
+  {
+    for (unsigned int c = 0; c < 3; ++c)
+    {
+      this->dataPtr->indices.push_back(
+          static_cast<unsigned int>(this->dataPtr->vertices.size()));
+      this->dataPtr->vertices.push_back(tri[c]);
+    }
+  }
+  this->dataPtr->Build();
+}
+
+//////////////////////////////////////////////////
+std::size_t TriangleMesh::TriangleCount() const
+{
+  return this->dataPtr->indices.size() / 3;
+}
+
+//////////////////////////////////////////////////
+Triangle3d TriangleMesh::Triangle(const std::size_t _index) const
+{
+  const auto &v = this->dataPtr->vertices;
+  const auto &i = this->dataPtr->indices;
+  return Triangle3d(v[i[3 * _index]], v[i[3 * _index + 1]],
+      v[i[3 * _index + 2]]);
+}
+
+//////////////////////////////////////////////////
+AxisAlignedBox TriangleMesh::Bounds() const
+{
+  if (this->dataPtr->nodes.empty())
+    return AxisAlignedBox();
+
+  const auto &b = this->dataPtr->nodes[0].bounds;
+  return AxisAlignedBox(Vector3d(b.min[0], b.min[1], b.min[2]),
+                        Vector3d(b.max[0], b.max[1], b.max[2]));
+}
+
+//////////////////////////////////////////////////
+std::tuple<bool, double, std::size_t> TriangleMesh::Intersect(
+    const Vector3d &_origin, const Vector3d &_dir, const double _min,
+    const double _max) const
+{
+  // Distances are measured from the start of the ray
+  const Vector3d dir = _dir.Normalized();
+  const BvhRay ray(_origin + dir * _min, dir, 0, _max - _min);
+  double dist;
+  std::size_t index = 0;
+  if (!this->dataPtr->Closest(ray, dist, index))
+    return std::make_tuple(false, 0.0, std::size_t(0));
+  return std::make_tuple(true, dist, index);
+}
+
+//////////////////////////////////////////////////
+bool TriangleMesh::IntersectCheck(const Vector3d &_origin,
+    const Vector3d &_dir, const double _min, const double _max) const
+{
+  const Vector3d dir = _dir.Normalized();
+  return this->dataPtr->Any(BvhRay(_origin + dir * _min, dir, 0,
+        _max - _min));
+}
+
+//////////////////////////////////////////////////
+std::size_t TriangleMesh::Intersect(const RayPacket &_rays,
+    std::vector<bool> &_hits, std::vector<double> &_dists,
+    std::vector<std::size_t> &_triangles) const
+{
+  const std::size_t n = _rays.Size();
+  _hits.assign(n, false);
+  _dists.assign(n, 0.0);
+  _triangles.assign(n, 0);
+
+  std::size_t count = 0;
+  for (std::size_t i = 0; i < n; ++i)
+  {
+    const BvhRay ray(_rays.Start(i), _rays.Direction(i), 0, _rays.Length(i));
+    double dist;
+    std::size_t index = 0;
+    if (this->dataPtr->Closest(ray, dist, index))
+    {
+      _hits[i] = true;
+      _dists[i] = dist;
+      _triangles[i] = index;
+      ++count;
+    }
+  }
+  return count;
+}
+
+//////////////////////////////////////////////////
+std::size_t TriangleMesh::IntersectCheck(const RayPacket &_rays,
+    std::vector<bool> &_hits) const
+{
+  const std::size_t n = _rays.Size();
+  _hits.assign(n, false);
+
+  std::size_t count = 0;
+  for (std::size_t i = 0; i < n; ++i)
+  {
+    const BvhRay ray(_rays.Start(i), _rays.Direction(i), 0, _rays.Length(i));
+    _hits[i] = this->dataPtr->Any(ray);
+    if (_hits[i])
+      ++count;
+  }
+  return count;
+}
@@ -0,0 +1,274 @@
+/*
+ * Copyright (C) 2018 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <tuple>
+#include <vector>
+
+#include "ignition/math/Rand.hh"
+#include "ignition/math/TriangleMesh.hh"
+
+using namespace ignition;
+
+/////////////////////////////////////////////////
+/// \brief Reference Moller-Trumbore intersection of a ray and a triangle.
+/// \param[in] _tri The triangle.
+/// \param[in] _start Start of the ray.
+/// \param[in] _dir Normalized direction of the ray.
+/// \param[in] _length Length of the ray.
+/// \param[out] _dist Distance to the hit.
+/// \return True if the ray hits the triangle.
+bool RayTriangle(const math::Triangle3d &_tri, const math::Vector3d &_start,
+    const math::Vector3d &_dir, const double _length, double &_dist)
+{
+  const math::Vector3d e1 = _tri[1] - _tri[0];
+  const math::Vector3d e2 = _tri[2] - _tri[0];
+  const math::Vector3d p = _dir.Cross(e2);
+  const double det = e1.Dot(p);
+  if (std::abs(det) < 1e-12)
+    return false;
+  const math::Vector3d s = _start - _tri[0];
+  const double u = s.Dot(p) / det;
+  const math::Vector3d q = s.Cross(e1);
+  const double v = _dir.Dot(q) / det;
+  if (u < 0 || v < 0 || u + v > 1)
+    return false;
+  _dist = e2.Dot(q) / det;
+  return _dist >= 0 && _dist <= _length;
+}
+
+/////////////////////////////////////////////////
+/// \brief Create a grid of squares in the plane z = _z, each made of
+/// two triangles.
+/// \param[in] _size Number of squares along x and y.
+/// \param[in] _z Height of the grid.
+/// \param[out] _vertices Vertices of the grid.
+/// \param[out] _indices Indices of the triangles.
+void Grid(const unsigned int _size, const double _z,
+    std::vector<math::Vector3d> &_vertices,
+    std::vector<unsigned int> &_indices)
+{
+  for (unsigned int y = 0; y <= _size; ++y)
+  {
+    for (unsigned int x = 0; x <= _size; ++x)
+      _vertices.push_back(math::Vector3d(x, y, _z));
+  }
+  for (unsigned int y = 0; y < _size; ++y)
+  {
+    for (unsigned int x = 0; x < _size; ++x)
+    {
+      const unsigned int i = y * (_size + 1) + x;
+      const unsigned int j = i + _size + 1;
+      _indices.insert(_indices.end(), {i, i + 1, j + 1, i, j + 1, j});
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(TriangleMeshTest, Construction)
+{
+  math::TriangleMesh mesh;
+  EXPECT_EQ(mesh.TriangleCount(), 0u);
+  EXPECT_EQ(mesh.Bounds(), math::AxisAlignedBox());
+  EXPECT_FALSE(mesh.IntersectCheck(math::Vector3d::Zero,
+        math::Vector3d::UnitX, 0, 10));
+  EXPECT_FALSE(std::get<0>(mesh.Intersect(math::Vector3d::Zero,
+        math::Vector3d::UnitX, 0, 10)));
+
+  const std::vector<math::Vector3d> vertices = {
+    math::Vector3d(0, 0, 0), math::Vector3d(1, 0, 0),
+    math::Vector3d(0, 1, 0), math::Vector3d(0, 0, 1)};
+  EXPECT_TRUE(mesh.Build(vertices, {0, 1, 2, 0, 1, 3}));
+  EXPECT_EQ(mesh.TriangleCount(), 2u);
+  EXPECT_EQ(mesh.Triangle(1)[2], math::Vector3d(0, 0, 1));
+  EXPECT_EQ(mesh.Bounds(), math::AxisAlignedBox(math::Vector3d::Zero,
+        math::Vector3d::One));
+
+  // Invalid indices
+  EXPECT_FALSE(mesh.Build(vertices, {0, 1, 2, 0}));
+  EXPECT_EQ(mesh.TriangleCount(), 0u);
+  EXPECT_FALSE(mesh.Build(vertices, {0, 1, 4}));
+  EXPECT_EQ(mesh.TriangleCount(), 0u);
+
+  const math::TriangleMesh mesh2({math::Triangle3d(math::Vector3d(1, 2, 3),
+        math::Vector3d(4, 5, 6), math::Vector3d(7, 8, 10))});
+  EXPECT_EQ(mesh2.TriangleCount(), 1u);
+  EXPECT_EQ(mesh2.Triangle(0)[1], math::Vector3d(4, 5, 6));
+
+  math::TriangleMesh mesh3(mesh2);
+  EXPECT_EQ(mesh3.TriangleCount(), 1u);
+  mesh3 = mesh;
+  EXPECT_EQ(mesh3.TriangleCount(), 0u);
+}
+
+/////////////////////////////////////////////////
+TEST(TriangleMeshTest, Intersect)
+{
+  std::vector<math::Vector3d> vertices;
+  std::vector<unsigned int> indices;
+  Grid(4, 0, vertices, indices);
+  Grid(4, 2, vertices, indices);
+  for (std::size_t i = indices.size() / 2; i < indices.size(); ++i)
+    indices[i] += static_cast<unsigned int>(vertices.size() / 2);
+  const math::TriangleMesh mesh(vertices, indices);
+  ASSERT_EQ(mesh.TriangleCount(), 64u);
+
+  // Downwards, hits the upper grid first
+  bool hit;
+  double dist;
+  std::size_t index;
+  std::tie(hit, dist, index) = mesh.Intersect(math::Vector3d(0.7, 0.2, 5),
+      -math::Vector3d::UnitZ, 0, 10);
+  EXPECT_TRUE(hit);
+  EXPECT_DOUBLE_EQ(dist, 3);
+  EXPECT_EQ(index, 32u);
+
+  // Starting between the grids
+  std::tie(hit, dist, index) = mesh.Intersect(math::Vector3d(0.7, 0.2, 5),
+      -math::Vector3d::UnitZ, 3.5, 10);
+  EXPECT_TRUE(hit);
+  EXPECT_DOUBLE_EQ(dist, 1.5);
+  EXPECT_EQ(index, 0u);
+
+  // Too short, and outside the grids
+  EXPECT_FALSE(mesh.IntersectCheck(math::Vector3d(0.7, 0.2, 5),
+        -math::Vector3d::UnitZ, 0, 2.5));
+  EXPECT_FALSE(mesh.IntersectCheck(math::Vector3d(5.5, 0.2, 5),
+        -math::Vector3d::UnitZ, 0, 10));
+  EXPECT_TRUE(mesh.IntersectCheck(math::Vector3d(0.7, 0.2, 5),
+        -math::Vector3d::UnitZ, 0, 10));
+
+  // Parallel to the grids
+  EXPECT_FALSE(mesh.IntersectCheck(math::Vector3d(-1, 0.5, 1),
+        math::Vector3d::UnitX, 0, 10));
+
+  // Upwards, with an unnormalized direction
+  std::tie(hit, dist, index) = mesh.Intersect(math::Vector3d(3.2, 3.9, -1),
+      math::Vector3d(0, 0, 3), 0, 10);
+  EXPECT_TRUE(hit);
+  EXPECT_DOUBLE_EQ(dist, 1);
+  EXPECT_EQ(index, 31u);
+}
+
+/////////////////////////////////////////////////
+TEST(TriangleMeshTest, Watertight)
+{
+  std::vector<math::Vector3d> vertices;
+  std::vector<unsigned int> indices;
+  Grid(8, 1, vertices, indices);
+  const math::TriangleMesh mesh(vertices, indices);
+
+  // Rays through the shared edges and vertices of the grid never fall in
+  // a gap between the triangles
+  math::RayPacket rays;
+  for (int y = 1; y < 16; ++y)
+  {
+    for (int x = 1; x < 16; ++x)
+    {
+      const math::Vector3d target(x * 0.5, y * 0.5, 1);
+      rays.PushBack(math::Vector3d::Zero, target, 0, 20);
+      rays.PushBack(math::Vector3d(x * 0.5, y * 0.5, 3),
+          -math::Vector3d::UnitZ, 0, 10);
+    }
+  }
+  // Along the diagonals of the squares
+  for (int i = 1; i < 20; ++i)
+  {
+    const double d = i * 0.4;
+    rays.PushBack(math::Vector3d(d, d, 5), math::Vector3d(0, 0, -1), 0, 10);
+    rays.PushBack(math::Vector3d(d, d, 5), math::Vector3d(1e-3, 2e-3, -1),
+        0, 10);
+  }
+
+  std::vector<bool> hits;
+  EXPECT_EQ(mesh.IntersectCheck(rays, hits), rays.Size());
+
+  std::vector<double> dists;
+  std::vector<std::size_t> triangles;
+  EXPECT_EQ(mesh.Intersect(rays, hits, dists, triangles), rays.Size());
+}
+
+/////////////////////////////////////////////////
+TEST(TriangleMeshTest, BruteForce)
+{
+  math::Rand::Seed(11);
+  auto random = [](const double _range)
+  {
+    return math::Vector3d(math::Rand::DblUniform(-_range, _range),
+        math::Rand::DblUniform(-_range, _range),
+        math::Rand::DblUniform(-_range, _range));
+  };
+
+  std::vector<math::Triangle3d> triangles;
+  for (int i = 0; i < 1500; ++i)
+  {
+    const math::Vector3d center = random(10);
+    triangles.push_back(math::Triangle3d(center + random(1),
+          center + random(1), center + random(1)));
+  }
+  const math::TriangleMesh mesh(triangles);
+
+  math::RayPacket rays;
+  for (int r = 0; r < 300; ++r)
+    rays.PushBack(random(12), random(1), 0.5, 30);
+
+  std::vector<bool> hits;
+  std::vector<double> dists;
+  std::vector<std::size_t> indices;
+  const std::size_t count = mesh.Intersect(rays, hits, dists, indices);
+
+  std::size_t expectedCount = 0;
+  for (std::size_t r = 0; r < rays.Size(); ++r)
+  {
+    bool expectedHit = false;
+    double expectedDist = 0;
+    std::size_t expectedIndex = 0;
+    for (std::size_t t = 0; t < triangles.size(); ++t)
+    {
+      double d;
+      if (RayTriangle(triangles[t], rays.Start(r), rays.Direction(r),
+            rays.Length(r), d) && (!expectedHit || d < expectedDist))
+      {
+        expectedHit = true;
+        expectedDist = d;
+        expectedIndex = t;
+      }
+    }
+    EXPECT_EQ(hits[r], expectedHit) << r;
+    EXPECT_NEAR(dists[r], expectedDist, 1e-9) << r;
+    EXPECT_EQ(indices[r], expectedIndex) << r;
+    if (expectedHit)
+      ++expectedCount;
+
+    // Single ray queries agree with the packet
+    bool hit;
+    double dist;
+    std::size_t index;
+    std::tie(hit, dist, index) = mesh.Intersect(
+        rays.Start(r) - rays.Direction(r) * 0.5, rays.Direction(r), 0.5,
+        30);
+    EXPECT_EQ(hit, expectedHit) << r;
+    EXPECT_NEAR(dist, expectedDist, 1e-9) << r;
+    EXPECT_EQ(mesh.IntersectCheck(rays.Start(r), rays.Direction(r), 0,
+          rays.Length(r)), expectedHit) << r;
+  }
+  EXPECT_EQ(count, expectedCount);
+  EXPECT_GT(count, 0u);
+  EXPECT_LT(count, rays.Size());
+}
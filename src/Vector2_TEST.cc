@@ -302,3 +302,18 @@ TEST(Vector2dTest, Length)
   EXPECT_DOUBLE_EQ(v.SquaredLength(), 17.65);
 }
 
+/////////////////////////////////////////////////
+TEST(Vector2Test, Constexpr)
+{
+  const math::Vector2d v1 = math::Vector2d(1, 2) * 3.0 - math::Vector2d::One;
+  EXPECT_EQ(v1, math::Vector2d(2, 5));
+  EXPECT_DOUBLE_EQ(v1.Dot(math::Vector2d::One), 7.0);
+
+#ifdef IGNITION_MATH_POD_TYPES
+  constexpr math::Vector2d v2 =
+      math::Vector2d(1, 2) * 3.0 - math::Vector2d::One;
+  static_assert(static_cast<int>(v2.X()) == 2 &&
+      static_cast<int>(v2.Y()) == 5, "");
+  static_assert(static_cast<int>(v2.Dot(math::Vector2d::One)) == 7, "");
+#endif
+}
@@ -0,0 +1,342 @@
+/*
+ * Copyright (C) 2018 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include "ignition/math/Vector3Array.hh"
+#include "BatchKernels.hh"
+
+using namespace ignition;
+using namespace math;
+
+namespace
+{
+  using detail::ConstSoa3;
+  using detail::Soa3;
+
+  //////////////////////////////////////////////////
+  template<typename T>
+  void AddImpl(ConstSoa3<T> _a, ConstSoa3<T> _b, Soa3<T> _out,
+      const std::size_t _n)
+  {
+    simd::BatchKernels<T>().add(_a, _b, _out, _n);
+  }
+
+  //////////////////////////////////////////////////
+  template<typename T>
+  void AddImpl(ConstSoa3<T> _a, const Vector3<T> &_v, Soa3<T> _out,
+      const std::size_t _n)
+  {
+    const T v[3] = {_v.X(), _v.Y(), _v.Z()};
+    simd::BatchKernels<T>().addVector(_a, v, _out, _n);
+  }
+
+  //////////////////////////////////////////////////
+  template<typename T>
+  void ScaleImpl(ConstSoa3<T> _a, const T _s, Soa3<T> _out,
+      const std::size_t _n)
+  {
+    simd::BatchKernels<T>().scale(_a, _s, _out, _n);
+  }
+
+  //////////////////////////////////////////////////
+  template<typename T>
+  void DotImpl(ConstSoa3<T> _a, ConstSoa3<T> _b, T *_out,
+      const std::size_t _n)
+  {
+    simd::BatchKernels<T>().dot(_a, _b, _out, _n);
+  }
+
+  //////////////////////////////////////////////////
+  template<typename T>
+  void DotImpl(ConstSoa3<T> _a, const Vector3<T> &_v, T *_out,
+      const std::size_t _n)
+  {
+    const T v[3] = {_v.X(), _v.Y(), _v.Z()};
+    simd::BatchKernels<T>().dotVector(_a, v, _out, _n);
+  }
+
+  //////////////////////////////////////////////////
+  template<typename T>
+  void CrossImpl(ConstSoa3<T> _a, ConstSoa3<T> _b, Soa3<T> _out,
+      const std::size_t _n)
+  {
+    simd::BatchKernels<T>().cross(_a, _b, _out, _n);
+  }
+
+  //////////////////////////////////////////////////
+  template<typename T>
+  void LengthImpl(ConstSoa3<T> _a, T *_out, const std::size_t _n)
+  {
+    simd::BatchKernels<T>().length(_a, _out, _n);
+  }
+
+  //////////////////////////////////////////////////
+  template<typename T>
+  void NormalizeImpl(ConstSoa3<T> _a, Soa3<T> _out, const std::size_t _n)
+  {
+    simd::BatchKernels<T>().normalize(_a, _out, _n);
+  }
+
+  //////////////////////////////////////////////////
+  template<typename T>
+  void DistanceImpl(ConstSoa3<T> _a, const Vector3<T> &_pt, T *_out,
+      const std::size_t _n)
+  {
+    const T pt[3] = {_pt.X(), _pt.Y(), _pt.Z()};
+    simd::BatchKernels<T>().distance(_a, pt, _out, _n);
+  }
+
+  //////////////////////////////////////////////////
+  template<typename T>
+  void TransformImpl(ConstSoa3<T> _a, const Matrix3<T> &_rot,
+      const Vector3<T> &_pre, const Vector3<T> &_post, Soa3<T> _out,
+      const std::size_t _n)
+  {
+    const T rot[9] = {_rot(0, 0), _rot(0, 1), _rot(0, 2),
+                      _rot(1, 0), _rot(1, 1), _rot(1, 2),
+                      _rot(2, 0), _rot(2, 1), _rot(2, 2)};
+    const T pre[3] = {_pre.X(), _pre.Y(), _pre.Z()};
+    const T post[3] = {_post.X(), _post.Y(), _post.Z()};
+    simd::BatchKernels<T>().transform(_a, rot, pre, post, _out, _n);
+  }
+
+  //////////////////////////////////////////////////
+  template<typename T>
+  void MinMaxImpl(ConstSoa3<T> _a, const std::size_t _n,
+      Vector3<T> &_min, Vector3<T> &_max)
+  {
+    T min[3], max[3];
+    simd::BatchKernels<T>().minMax(_a, _n, min, max);
+    _min.Set(min[0], min[1], min[2]);
+    _max.Set(max[0], max[1], max[2]);
+  }
+
+  //////////////////////////////////////////////////
+  template<typename T>
+  void InBoxImpl(ConstSoa3<T> _a, const Matrix3<T> &_rot,
+      const Vector3<T> &_pre, const Vector3<T> &_half, T *_inside,
+      const std::size_t _n)
+  {
+    const T rot[9] = {_rot(0, 0), _rot(0, 1), _rot(0, 2),
+                      _rot(1, 0), _rot(1, 1), _rot(1, 2),
+                      _rot(2, 0), _rot(2, 1), _rot(2, 2)};
+    const T pre[3] = {_pre.X(), _pre.Y(), _pre.Z()};
+    const T half[3] = {_half.X(), _half.Y(), _half.Z()};
+    simd::BatchKernels<T>().pointsInBox(_a, rot, pre, half, _inside, _n);
+  }
+
+  //////////////////////////////////////////////////
+  template<typename T>
+  void SegmentClosestPointsImpl(ConstSoa3<T> _startA, ConstSoa3<T> _endA,
+      ConstSoa3<T> _startB, ConstSoa3<T> _endB, Soa3<T> _pointA,
+      Soa3<T> _pointB, T *_sqDist, const std::size_t _n)
+  {
+    simd::BatchKernels<T>().segments(_startA, _endA, _startB, _endB,
+        _pointA, _pointB, _sqDist, _n);
+  }
+}  // namespace
+
+//////////////////////////////////////////////////
+void detail::Vector3ArrayKernels<float>::Add(ConstSoa3<float> _a,
+    ConstSoa3<float> _b, Soa3<float> _out, const std::size_t _n)
+{
+  AddImpl(_a, _b, _out, _n);
+}
+
+//////////////////////////////////////////////////
+void detail::Vector3ArrayKernels<float>::Add(ConstSoa3<float> _a,
+    const Vector3<float> &_v, Soa3<float> _out, const std::size_t _n)
+{
+  AddImpl(_a, _v, _out, _n);
+}
+
+//////////////////////////////////////////////////
+void detail::Vector3ArrayKernels<float>::Scale(ConstSoa3<float> _a,
+    const float _s, Soa3<float> _out, const std::size_t _n)
+{
+  ScaleImpl(_a, _s, _out, _n);
+}
+
+//////////////////////////////////////////////////
+void detail::Vector3ArrayKernels<float>::Dot(ConstSoa3<float> _a,
+    ConstSoa3<float> _b, float *_out, const std::size_t _n)
+{
+  DotImpl(_a, _b, _out, _n);
+}
+
+//////////////////////////////////////////////////
+void detail::Vector3ArrayKernels<float>::Dot(ConstSoa3<float> _a,
+    const Vector3<float> &_v, float *_out, const std::size_t _n)
+{
+  DotImpl(_a, _v, _out, _n);
+}
+
+//////////////////////////////////////////////////
+void detail::Vector3ArrayKernels<float>::Cross(ConstSoa3<float> _a,
+    ConstSoa3<float> _b, Soa3<float> _out, const std::size_t _n)
+{
+  CrossImpl(_a, _b, _out, _n);
+}
+
+//////////////////////////////////////////////////
+void detail::Vector3ArrayKernels<float>::Length(ConstSoa3<float> _a,
+    float *_out, const std::size_t _n)
+{
+  LengthImpl(_a, _out, _n);
+}
+
+//////////////////////////////////////////////////
+void detail::Vector3ArrayKernels<float>::Normalize(ConstSoa3<float> _a,
+    Soa3<float> _out, const std::size_t _n)
+{
+  NormalizeImpl(_a, _out, _n);
+}
+
+//////////////////////////////////////////////////
+void detail::Vector3ArrayKernels<float>::Distance(ConstSoa3<float> _a,
+    const Vector3<float> &_pt, float *_out, const std::size_t _n)
+{
+  DistanceImpl(_a, _pt, _out, _n);
+}
+
+//////////////////////////////////////////////////
+void detail::Vector3ArrayKernels<float>::Transform(ConstSoa3<float> _a,
+    const Matrix3<float> &_rot, const Vector3<float> &_pre,
+    const Vector3<float> &_post, Soa3<float> _out, const std::size_t _n)
+{
+  TransformImpl(_a, _rot, _pre, _post, _out, _n);
+}
+
+//////////////////////////////////////////////////
+void detail::Vector3ArrayKernels<float>::MinMax(ConstSoa3<float> _a,
+    const std::size_t _n, Vector3<float> &_min, Vector3<float> &_max)
+{
+  MinMaxImpl(_a, _n, _min, _max);
+}
+
+//////////////////////////////////////////////////
+void detail::Vector3ArrayKernels<float>::InBox(ConstSoa3<float> _a,
+    const Matrix3<float> &_rot, const Vector3<float> &_pre,
+    const Vector3<float> &_half, float *_inside, const std::size_t _n)
+{
+  InBoxImpl(_a, _rot, _pre, _half, _inside, _n);
+}
+
+//////////////////////////////////////////////////
+void detail::Vector3ArrayKernels<float>::SegmentClosestPoints(
+    ConstSoa3<float> _startA, ConstSoa3<float> _endA, ConstSoa3<float> _startB,
+    ConstSoa3<float> _endB, Soa3<float> _pointA, Soa3<float> _pointB,
+    float *_sqDist, const std::size_t _n)
+{
+  SegmentClosestPointsImpl(_startA, _endA, _startB, _endB, _pointA, _pointB,
+      _sqDist, _n);
+}
+
+//////////////////////////////////////////////////
+void detail::Vector3ArrayKernels<double>::Add(ConstSoa3<double> _a,
+    ConstSoa3<double> _b, Soa3<double> _out, const std::size_t _n)
+{
+  AddImpl(_a, _b, _out, _n);
+}
+
+//////////////////////////////////////////////////
+void detail::Vector3ArrayKernels<double>::Add(ConstSoa3<double> _a,
+    const Vector3<double> &_v, Soa3<double> _out, const std::size_t _n)
+{
+  AddImpl(_a, _v, _out, _n);
+}
+
+//////////////////////////////////////////////////
+void detail::Vector3ArrayKernels<double>::Scale(ConstSoa3<double> _a,
+    const double _s, Soa3<double> _out, const std::size_t _n)
+{
+  ScaleImpl(_a, _s, _out, _n);
+}
+
+//////////////////////////////////////////////////
+void detail::Vector3ArrayKernels<double>::Dot(ConstSoa3<double> _a,
+    ConstSoa3<double> _b, double *_out, const std::size_t _n)
+{
+  DotImpl(_a, _b, _out, _n);
+}
+
+//////////////////////////////////////////////////
+void detail::Vector3ArrayKernels<double>::Dot(ConstSoa3<double> _a,
+    const Vector3<double> &_v, double *_out, const std::size_t _n)
+{
+  DotImpl(_a, _v, _out, _n);
+}
+
+//////////////////////////////////////////////////
+void detail::Vector3ArrayKernels<double>::Cross(ConstSoa3<double> _a,
+    ConstSoa3<double> _b, Soa3<double> _out, const std::size_t _n)
+{
+  CrossImpl(_a, _b, _out, _n);
+}
+
+//////////////////////////////////////////////////
+void detail::Vector3ArrayKernels<double>::Length(ConstSoa3<double> _a,
+    double *_out, const std::size_t _n)
+{
+  LengthImpl(_a, _out, _n);
+}
+
+//////////////////////////////////////////////////
+void detail::Vector3ArrayKernels<double>::Normalize(ConstSoa3<double> _a,
+    Soa3<double> _out, const std::size_t _n)
+{
+  NormalizeImpl(_a, _out, _n);
+}
+
+//////////////////////////////////////////////////
+void detail::Vector3ArrayKernels<double>::Distance(ConstSoa3<double> _a,
+    const Vector3<double> &_pt, double *_out, const std::size_t _n)
+{
+  DistanceImpl(_a, _pt, _out, _n);
+}
+
+//////////////////////////////////////////////////
+void detail::Vector3ArrayKernels<double>::Transform(ConstSoa3<double> _a,
+    const Matrix3<double> &_rot, const Vector3<double> &_pre,
+    const Vector3<double> &_post, Soa3<double> _out, const std::size_t _n)
+{
+  TransformImpl(_a, _rot, _pre, _post, _out, _n);
+}
+
+//////////////////////////////////////////////////
+void detail::Vector3ArrayKernels<double>::MinMax(ConstSoa3<double> _a,
+    const std::size_t _n, Vector3<double> &_min, Vector3<double> &_max)
+{
+  MinMaxImpl(_a, _n, _min, _max);
+}
+
+//////////////////////////////////////////////////
+void detail::Vector3ArrayKernels<double>::InBox(ConstSoa3<double> _a,
+    const Matrix3<double> &_rot, const Vector3<double> &_pre,
+    const Vector3<double> &_half, double *_inside, const std::size_t _n)
+{
+  InBoxImpl(_a, _rot, _pre, _half, _inside, _n);
+}
+
+//////////////////////////////////////////////////
+void detail::Vector3ArrayKernels<double>::SegmentClosestPoints(
+    ConstSoa3<double> _startA, ConstSoa3<double> _endA,
+    ConstSoa3<double> _startB, ConstSoa3<double> _endB,
+    Soa3<double> _pointA, Soa3<double> _pointB, double *_sqDist,
+    const std::size_t _n)
+{
+  SegmentClosestPointsImpl(_startA, _endA, _startB, _endB, _pointA, _pointB,
+      _sqDist, _n);
+}
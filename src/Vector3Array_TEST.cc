@@ -0,0 +1,251 @@
+/*
+ * Copyright (C) 2018 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <vector>
+
+#include "ignition/math/Rand.hh"
+#include "ignition/math/Vector3Array.hh"
+
+using namespace ignition;
+
+/////////////////////////////////////////////////
+template<typename T>
+std::vector<math::Vector3<T>> RandomPoints(const std::size_t _n)
+{
+  std::vector<math::Vector3<T>> points;
+  for (std::size_t i = 0; i < _n; ++i)
+  {
+    points.push_back(math::Vector3<T>(
+          static_cast<T>(math::Rand::DblUniform(-10, 10)),
+          static_cast<T>(math::Rand::DblUniform(-10, 10)),
+          static_cast<T>(math::Rand::DblUniform(-10, 10))));
+  }
+  return points;
+}
+
+/////////////////////////////////////////////////
+template<typename T>
+class Vector3ArrayTest : public ::testing::Test
+{
+  /// \brief Tolerance used to compare batch and scalar results
+  public: T Tol() const
+  {
+    return static_cast<T>(sizeof(T) == sizeof(float) ? 1e-5 : 1e-12);
+  }
+};
+
+typedef ::testing::Types<float, double> FloatTypes;
+TYPED_TEST_CASE(Vector3ArrayTest, FloatTypes);
+
+/////////////////////////////////////////////////
+TYPED_TEST(Vector3ArrayTest, Construct)
+{
+  typedef TypeParam T;
+  const T tol = this->Tol();
+
+  math::Vector3Array<T> empty;
+  EXPECT_TRUE(empty.Empty());
+  EXPECT_EQ(0u, empty.Size());
+
+  math::Vector3Array<T> zeros(5);
+  EXPECT_EQ(5u, zeros.Size());
+  for (std::size_t i = 0; i < zeros.Size(); ++i)
+    EXPECT_EQ(math::Vector3<T>::Zero, zeros[i]);
+
+  // Component arrays are aligned for SIMD access
+  auto points = RandomPoints<T>(37);
+  math::Vector3Array<T> array(points);
+  EXPECT_EQ(0u, reinterpret_cast<std::uintptr_t>(array.X()) % 32);
+  EXPECT_EQ(0u, reinterpret_cast<std::uintptr_t>(array.Y()) % 32);
+  EXPECT_EQ(0u, reinterpret_cast<std::uintptr_t>(array.Z()) % 32);
+
+  // Round trip through std::vector
+  ASSERT_EQ(points.size(), array.Size());
+  auto copy = array.ToVector();
+  ASSERT_EQ(points.size(), copy.size());
+  for (std::size_t i = 0; i < points.size(); ++i)
+  {
+    EXPECT_EQ(points[i], array[i]);
+    EXPECT_EQ(points[i], copy[i]);
+    EXPECT_NEAR(points[i].X(), array.X()[i], tol);
+    EXPECT_NEAR(points[i].Y(), array.Y()[i], tol);
+    EXPECT_NEAR(points[i].Z(), array.Z()[i], tol);
+  }
+
+  array.Set(3, math::Vector3<T>(1, 2, 3));
+  EXPECT_EQ(math::Vector3<T>(1, 2, 3), array[3]);
+
+  array.PushBack(math::Vector3<T>(4, 5, 6));
+  EXPECT_EQ(38u, array.Size());
+  EXPECT_EQ(math::Vector3<T>(4, 5, 6), array[37]);
+
+  array.Resize(2);
+  EXPECT_EQ(2u, array.Size());
+
+  array.Clear();
+  EXPECT_TRUE(array.Empty());
+}
+
+/////////////////////////////////////////////////
+TYPED_TEST(Vector3ArrayTest, Arithmetic)
+{
+  typedef TypeParam T;
+  const T tol = this->Tol();
+
+  // Use a size that is not a multiple of any SIMD width
+  const std::size_t n = 103;
+  auto a = RandomPoints<T>(n);
+  auto b = RandomPoints<T>(n);
+  const math::Vector3<T> v(1.5, -2.5, 3.25);
+
+  math::Vector3Array<T> arrayA(a);
+  math::Vector3Array<T> arrayB(b);
+
+  // Add
+  math::Vector3Array<T> sum = arrayA;
+  EXPECT_TRUE(sum.Add(arrayB));
+  for (std::size_t i = 0; i < n; ++i)
+    EXPECT_TRUE(sum[i].Equal(a[i] + b[i], tol));
+
+  // Add a vector
+  sum = arrayA;
+  sum.Add(v);
+  for (std::size_t i = 0; i < n; ++i)
+    EXPECT_TRUE(sum[i].Equal(a[i] + v, tol));
+
+  // Scale
+  math::Vector3Array<T> scaled = arrayA;
+  scaled.Scale(static_cast<T>(-0.75));
+  for (std::size_t i = 0; i < n; ++i)
+    EXPECT_TRUE(scaled[i].Equal(a[i] * static_cast<T>(-0.75), tol));
+
+  // Dot
+  std::vector<T> dots;
+  EXPECT_TRUE(arrayA.Dot(arrayB, dots));
+  ASSERT_EQ(n, dots.size());
+  for (std::size_t i = 0; i < n; ++i)
+    EXPECT_NEAR(a[i].Dot(b[i]), dots[i], tol * 100);
+
+  arrayA.Dot(v, dots);
+  ASSERT_EQ(n, dots.size());
+  for (std::size_t i = 0; i < n; ++i)
+    EXPECT_NEAR(a[i].Dot(v), dots[i], tol * 100);
+
+  // Cross, including in place
+  math::Vector3Array<T> cross;
+  EXPECT_TRUE(arrayA.Cross(arrayB, cross));
+  ASSERT_EQ(n, cross.Size());
+  for (std::size_t i = 0; i < n; ++i)
+    EXPECT_TRUE(cross[i].Equal(a[i].Cross(b[i]), tol * 100));
+
+  cross = arrayA;
+  EXPECT_TRUE(cross.Cross(arrayB, cross));
+  for (std::size_t i = 0; i < n; ++i)
+    EXPECT_TRUE(cross[i].Equal(a[i].Cross(b[i]), tol * 100));
+
+  // Size mismatch
+  math::Vector3Array<T> small(3);
+  EXPECT_FALSE(sum.Add(small));
+  EXPECT_FALSE(arrayA.Dot(small, dots));
+  EXPECT_FALSE(arrayA.Cross(small, cross));
+}
+
+/////////////////////////////////////////////////
+TYPED_TEST(Vector3ArrayTest, LengthNormalizeDistance)
+{
+  typedef TypeParam T;
+  const T tol = this->Tol();
+
+  const std::size_t n = 71;
+  auto a = RandomPoints<T>(n);
+  // Zero vectors are left unchanged by Normalize
+  a[5] = math::Vector3<T>::Zero;
+  a[n - 1] = math::Vector3<T>::Zero;
+  const math::Vector3<T> pt(-3, 0.5, 7);
+
+  math::Vector3Array<T> array(a);
+
+  std::vector<T> lengths;
+  array.Length(lengths);
+  ASSERT_EQ(n, lengths.size());
+  for (std::size_t i = 0; i < n; ++i)
+    EXPECT_NEAR(a[i].Length(), lengths[i], tol * 10);
+
+  std::vector<T> distances;
+  array.Distance(pt, distances);
+  ASSERT_EQ(n, distances.size());
+  for (std::size_t i = 0; i < n; ++i)
+    EXPECT_NEAR(a[i].Distance(pt), distances[i], tol * 10);
+
+  array.Normalize();
+  for (std::size_t i = 0; i < n; ++i)
+    EXPECT_TRUE(array[i].Equal(a[i].Normalized(), tol));
+  EXPECT_EQ(math::Vector3<T>::Zero, array[5]);
+  EXPECT_EQ(math::Vector3<T>::Zero, array[n - 1]);
+}
+
+/////////////////////////////////////////////////
+TYPED_TEST(Vector3ArrayTest, MinMax)
+{
+  typedef TypeParam T;
+
+  math::Vector3<T> min, max;
+  math::Vector3Array<T> empty;
+  EXPECT_FALSE(empty.MinMax(min, max));
+
+  for (std::size_t n : {1u, 2u, 7u, 8u, 9u, 250u})
+  {
+    auto a = RandomPoints<T>(n);
+    math::Vector3Array<T> array(a);
+
+    math::Vector3<T> expectedMin = a[0];
+    math::Vector3<T> expectedMax = a[0];
+    for (auto const &p : a)
+    {
+      expectedMin.Min(p);
+      expectedMax.Max(p);
+    }
+
+    EXPECT_TRUE(array.MinMax(min, max));
+    EXPECT_EQ(expectedMin, min);
+    EXPECT_EQ(expectedMax, max);
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(Vector3ArrayTest, Integer)
+{
+  // Types other than float and double use the scalar fallback
+  std::vector<math::Vector3i> points = {{1, 2, 3}, {-4, 5, 6}, {7, -8, 9}};
+  math::Vector3Array<int> array(points);
+
+  math::Vector3Array<int> other(points);
+  EXPECT_TRUE(array.Add(other));
+  EXPECT_EQ(math::Vector3i(-8, 10, 12), array[1]);
+
+  std::vector<int> dots;
+  EXPECT_TRUE(other.Dot(other, dots));
+  EXPECT_EQ(14, dots[0]);
+
+  math::Vector3i min, max;
+  EXPECT_TRUE(other.MinMax(min, max));
+  EXPECT_EQ(math::Vector3i(-4, -8, 3), min);
+  EXPECT_EQ(math::Vector3i(7, 5, 9), max);
+}
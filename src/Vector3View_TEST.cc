@@ -0,0 +1,83 @@
+/*
+ * Copyright (C) 2018 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "ignition/math/Vector3Array.hh"
+#include "ignition/math/Vector3View.hh"
+
+using namespace ignition;
+
+/////////////////////////////////////////////////
+TEST(Vector3ViewTest, Empty)
+{
+  const math::Vector3Viewd view;
+  EXPECT_TRUE(view.Empty());
+  EXPECT_EQ(0u, view.Size());
+  EXPECT_EQ(3u, view.Stride());
+  EXPECT_EQ(nullptr, view.Data());
+}
+
+/////////////////////////////////////////////////
+TEST(Vector3ViewTest, Packed)
+{
+  const double data[] = {1, 2, 3, 4, 5, 6};
+  const math::Vector3Viewd view(data, 2);
+  EXPECT_FALSE(view.Empty());
+  EXPECT_EQ(2u, view.Size());
+  EXPECT_EQ(data, view.Data());
+  EXPECT_EQ(math::Vector3d(1, 2, 3), view[0]);
+  EXPECT_EQ(math::Vector3d(4, 5, 6), view[1]);
+}
+
+/////////////////////////////////////////////////
+TEST(Vector3ViewTest, Stride)
+{
+  // x, y, z and intensity of each point
+  const float data[] = {1, 2, 3, 0.5f, 4, 5, 6, 0.7f, 7, 8, 9, 0.9f};
+  const math::Vector3Viewf view(data, 3, 4);
+  EXPECT_EQ(3u, view.Size());
+  EXPECT_EQ(4u, view.Stride());
+  EXPECT_EQ(math::Vector3f(1, 2, 3), view[0]);
+  EXPECT_EQ(math::Vector3f(4, 5, 6), view[1]);
+  EXPECT_EQ(math::Vector3f(7, 8, 9), view[2]);
+
+  // The view does not copy the buffer
+  std::vector<float> buffer(data, data + 12);
+  const math::Vector3Viewf bufferView(buffer.data(), 3, 4);
+  buffer[5] = -1;
+  EXPECT_EQ(math::Vector3f(4, -1, 6), bufferView[1]);
+}
+
+/////////////////////////////////////////////////
+TEST(Vector3ViewTest, Vector3Array)
+{
+  const double data[] = {1, 2, 3, 0, 4, 5, 6, 0, 7, 8, 9, 0};
+  const math::Vector3Viewd view(data, 3, 4);
+
+  const math::Vector3Arrayd array(view);
+  ASSERT_EQ(3u, array.Size());
+  for (std::size_t i = 0; i < view.Size(); ++i)
+    EXPECT_EQ(view[i], array[i]);
+
+  math::Vector3Arrayd other(10);
+  other.Assign(math::Vector3Viewd(data, 2, 4));
+  ASSERT_EQ(2u, other.Size());
+  EXPECT_EQ(math::Vector3d(4, 5, 6), other[1]);
+}
@@ -17,6 +17,12 @@
 
 #include <gtest/gtest.h>
 
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+#include "ignition/math/Angle.hh"
+#include "ignition/math/Pose3.hh"
 #include "ignition/math/Vector3.hh"
 #include "ignition/math/Helpers.hh"
 
@@ -416,3 +422,71 @@ TEST(Vector3dTest, NoException)
   EXPECT_DOUBLE_EQ(v[3], 3.0);
 }
 
+
+/////////////////////////////////////////////////
+TEST(Vector3dTest, Copy)
+{
+  math::Vector3d v1(1, 2, 3);
+  math::Vector3d v2(v1);
+  EXPECT_EQ(v1, v2);
+
+  math::Vector3d v3;
+  v3 = v1;
+  EXPECT_EQ(v1, v3);
+
+  EXPECT_TRUE(std::is_copy_constructible<math::Vector3d>::value);
+  EXPECT_TRUE(std::is_copy_assignable<math::Vector3d>::value);
+}
+
+#ifdef IGNITION_MATH_POD_TYPES
+/////////////////////////////////////////////////
+TEST(Vector3dTest, PodLayout)
+{
+  std::vector<math::Vector3d> points;
+  for (int i = 0; i < 10; ++i)
+    points.push_back(math::Vector3d(i, i * 2.0, i * 3.0));
+
+  // An array of vectors can be accessed as a flat buffer of doubles
+  const double *raw = reinterpret_cast<const double *>(points.data());
+  for (int i = 0; i < 10; ++i)
+  {
+    EXPECT_DOUBLE_EQ(raw[i*3 + 0], i);
+    EXPECT_DOUBLE_EQ(raw[i*3 + 1], i * 2.0);
+    EXPECT_DOUBLE_EQ(raw[i*3 + 2], i * 3.0);
+  }
+
+  // And bulk copied with memcpy
+  std::vector<math::Vector3d> copy(points.size());
+  std::memcpy(copy.data(), points.data(),
+      points.size() * sizeof(math::Vector3d));
+  for (std::size_t i = 0; i < points.size(); ++i)
+    EXPECT_EQ(points[i], copy[i]);
+
+  EXPECT_TRUE(std::is_trivially_copyable<math::Pose3d>::value);
+  EXPECT_TRUE(std::is_trivially_copyable<math::Angle>::value);
+  EXPECT_EQ(sizeof(math::Pose3d), 7 * sizeof(double));
+}
+#endif
+
+/////////////////////////////////////////////////
+TEST(Vector3dTest, Constexpr)
+{
+  const math::Vector3d v1(1, 2, 3);
+  const math::Vector3d v2 = v1 * 2.0 + math::Vector3d(1, 1, 1);
+  const double dot = v1.Dot(v2);
+  EXPECT_EQ(v2, math::Vector3d(3, 5, 7));
+  EXPECT_DOUBLE_EQ(dot, 34.0);
+  EXPECT_DOUBLE_EQ(math::clamp(v1.Z(), 0.0, 2.5), 2.5);
+
+#ifdef IGNITION_MATH_POD_TYPES
+  // In POD mode the vector and its constants are literal types and can be
+  // used in constant expressions
+  constexpr math::Vector3d v3(1, 2, 3);
+  constexpr math::Vector3d v4 = v3 * 2.0 + math::Vector3d::One;
+  static_assert(static_cast<int>(v4.X()) == 3 &&
+      static_cast<int>(v4.Y()) == 5 && static_cast<int>(v4.Z()) == 7, "");
+  static_assert(static_cast<int>(v3.Cross(math::Vector3d::UnitX).Z()) == -2,
+      "");
+  static_assert(static_cast<int>(math::Vector3d::UnitZ.Z()) == 1, "");
+#endif
+}
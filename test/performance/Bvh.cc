@@ -0,0 +1,206 @@
+/*
+ * Copyright (C) 2018 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <iostream>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "ignition/math/Bvh.hh"
+#include "ignition/math/Rand.hh"
+
+#include "TimeMs.hh"
+
+using namespace ignition;
+
+/// \brief Number of boxes in the scene
+static const std::size_t kBoxCount = 100000;
+
+/// \brief Number of rays
+static const int kRayCount = 200;
+
+/////////////////////////////////////////////////
+void Report(const std::string &_name, const double _bruteMs,
+    const double _bvhMs)
+{
+  std::cout << _name << ": brute force " << _bruteMs << " ms, bvh "
+            << _bvhMs << " ms, speed-up " << _bruteMs / _bvhMs << std::endl;
+}
+
+/////////////////////////////////////////////////
+math::Vector3d RandomVector(const double _range)
+{
+  return math::Vector3d(math::Rand::DblUniform(-_range, _range),
+      math::Rand::DblUniform(-_range, _range),
+      math::Rand::DblUniform(-_range, _range));
+}
+
+/////////////////////////////////////////////////
+class BvhBenchmark : public ::testing::Test
+{
+  /// \brief Create random boxes and rays.
+  protected: void SetUp() override
+  {
+    math::Rand::Seed(1);
+    for (std::size_t i = 0; i < kBoxCount; ++i)
+    {
+      const math::Vector3d min = RandomVector(500);
+      this->boxes.push_back(math::AxisAlignedBox(min,
+            min + math::Vector3d(math::Rand::DblUniform(0.5, 5),
+              math::Rand::DblUniform(0.5, 5),
+              math::Rand::DblUniform(0.5, 5))));
+    }
+    for (int i = 0; i < kRayCount; ++i)
+    {
+      this->origins.push_back(RandomVector(600));
+      this->dirs.push_back(RandomVector(1));
+    }
+
+    const double buildMs = TimeMs([&]()
+    {
+      this->bvh.Build(this->boxes);
+    });
+    std::cout << "Build of " << kBoxCount << " boxes: " << buildMs
+              << " ms, " << this->bvh.NodeCount() << " nodes" << std::endl;
+  }
+
+  /// \brief Boxes of the scene
+  protected: std::vector<math::AxisAlignedBox> boxes;
+
+  /// \brief Ray origins
+  protected: std::vector<math::Vector3d> origins;
+
+  /// \brief Ray directions
+  protected: std::vector<math::Vector3d> dirs;
+
+  /// \brief Hierarchy of the boxes
+  protected: math::Bvh bvh;
+};
+
+/////////////////////////////////////////////////
+TEST_F(BvhBenchmark, ClosestHit)
+{
+  std::vector<double> bruteDist(kRayCount, -1);
+  const double bruteMs = TimeMs([&]()
+  {
+    for (int r = 0; r < kRayCount; ++r)
+    {
+      for (const auto &box : this->boxes)
+      {
+        bool hit;
+        double dist;
+        math::Vector3d point;
+        std::tie(hit, dist, point) = box.Intersect(this->origins[r],
+            this->dirs[r], 0, 2000);
+        if (hit && (bruteDist[r] < 0 || dist < bruteDist[r]))
+          bruteDist[r] = dist;
+      }
+    }
+  });
+
+  std::vector<double> bvhDist(kRayCount, -1);
+  const double bvhMs = TimeMs([&]()
+  {
+    for (int r = 0; r < kRayCount; ++r)
+    {
+      bool hit;
+      double dist;
+      std::size_t index;
+      std::tie(hit, dist, index) = this->bvh.Intersect(this->origins[r],
+          this->dirs[r], 0, 2000);
+      if (hit)
+        bvhDist[r] = dist;
+    }
+  });
+
+  for (int r = 0; r < kRayCount; ++r)
+    EXPECT_NEAR(bruteDist[r], bvhDist[r], 1e-6);
+
+  Report("Closest hit", bruteMs, bvhMs);
+}
+
+/////////////////////////////////////////////////
+TEST_F(BvhBenchmark, AllHits)
+{
+  std::size_t bruteCount = 0;
+  const double bruteMs = TimeMs([&]()
+  {
+    for (int r = 0; r < kRayCount; ++r)
+    {
+      for (const auto &box : this->boxes)
+      {
+        if (box.IntersectCheck(this->origins[r], this->dirs[r], 0, 2000))
+          ++bruteCount;
+      }
+    }
+  });
+
+  std::size_t bvhCount = 0;
+  std::vector<std::size_t> hits;
+  const double bvhMs = TimeMs([&]()
+  {
+    for (int r = 0; r < kRayCount; ++r)
+    {
+      this->bvh.IntersectAll(this->origins[r], this->dirs[r], 0, 2000, hits);
+      bvhCount += hits.size();
+    }
+  });
+  EXPECT_EQ(bruteCount, bvhCount);
+
+  Report("All hits", bruteMs, bvhMs);
+}
+
+/////////////////////////////////////////////////
+TEST_F(BvhBenchmark, Overlap)
+{
+  std::vector<math::AxisAlignedBox> queries;
+  for (int i = 0; i < kRayCount; ++i)
+  {
+    const math::Vector3d min = RandomVector(500);
+    queries.push_back(math::AxisAlignedBox(min,
+          min + math::Vector3d(20, 20, 20)));
+  }
+
+  std::size_t bruteCount = 0;
+  const double bruteMs = TimeMs([&]()
+  {
+    for (const auto &query : queries)
+    {
+      for (const auto &box : this->boxes)
+      {
+        if (query.Intersects(box))
+          ++bruteCount;
+      }
+    }
+  });
+
+  std::size_t bvhCount = 0;
+  std::vector<std::size_t> hits;
+  const double bvhMs = TimeMs([&]()
+  {
+    for (const auto &query : queries)
+    {
+      this->bvh.Overlap(query, hits);
+      bvhCount += hits.size();
+    }
+  });
+  EXPECT_EQ(bruteCount, bvhCount);
+
+  Report("Overlap", bruteMs, bvhMs);
+}
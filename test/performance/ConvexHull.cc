@@ -0,0 +1,135 @@
+/*
+ * Copyright (C) 2018 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include "ignition/math/ConvexHull.hh"
+#include "ignition/math/Rand.hh"
+
+#include "TimeMs.hh"
+
+using namespace ignition;
+
+/// \brief Number of meshes
+static const int kMeshCount = 2000;
+
+/// \brief Largest number of vertices of the simplified hulls
+static const std::size_t kMaxVertices = 32;
+
+/////////////////////////////////////////////////
+/// \brief Create the vertices of a mesh, either a bumpy ellipsoid or a box
+/// with vertices on its faces, like the meshes of the props of a world.
+/// \param[in] _index Index of the mesh.
+/// \return The vertices.
+std::vector<math::Vector3d> Mesh(const int _index)
+{
+  const math::Vector3d size(math::Rand::DblUniform(0.2, 2),
+      math::Rand::DblUniform(0.2, 2), math::Rand::DblUniform(0.2, 2));
+  const int count = math::Rand::IntUniform(200, 3000);
+  std::vector<math::Vector3d> vertices;
+  for (int i = 0; i < count; ++i)
+  {
+    math::Vector3d p(math::Rand::DblUniform(-1, 1),
+        math::Rand::DblUniform(-1, 1), math::Rand::DblUniform(-1, 1));
+    if (_index % 2 == 0)
+    {
+      p = p.Normalized() * math::Rand::DblUniform(0.95, 1);
+    }
+    else
+    {
+      // Snap one coordinate to a face, on a grid
+      const int axis = i % 3;
+      p[axis] = p[axis] < 0 ? -1 : 1;
+      p = (p * 8).Round() / 8;
+    }
+    vertices.push_back(p * size);
+  }
+  return vertices;
+}
+
+/////////////////////////////////////////////////
+TEST(ConvexHullBenchmark, Meshes)
+{
+  math::Rand::Seed(1);
+  std::vector<std::vector<math::Vector3d>> meshes;
+  std::size_t vertexCount = 0;
+  for (int i = 0; i < kMeshCount; ++i)
+  {
+    meshes.push_back(Mesh(i));
+    vertexCount += meshes.back().size();
+  }
+
+  // A new hull for each mesh
+  std::size_t triangles = 0;
+  const double newMs = TimeMs([&]()
+  {
+    for (const auto &mesh : meshes)
+    {
+      math::ConvexHull hull;
+      hull.Build(mesh);
+      triangles += hull.TriangleCount();
+    }
+  });
+
+  // The pools of one hull reused for all meshes
+  math::ConvexHull reused;
+  const double reusedMs = TimeMs([&]()
+  {
+    for (const auto &mesh : meshes)
+      reused.Build(mesh);
+  });
+
+  std::vector<math::ConvexHull> hulls;
+  const double oneThreadMs = TimeMs([&]()
+  {
+    math::ConvexHull::BuildMany(meshes, hulls, 0, 1);
+  });
+  const double manyMs = TimeMs([&]()
+  {
+    EXPECT_EQ(meshes.size(), math::ConvexHull::BuildMany(meshes, hulls));
+  });
+
+  std::size_t manyTriangles = 0;
+  for (const auto &hull : hulls)
+    manyTriangles += hull.TriangleCount();
+  EXPECT_EQ(triangles, manyTriangles);
+
+  std::size_t simplified = 0;
+  const double simplifiedMs = TimeMs([&]()
+  {
+    math::ConvexHull::BuildMany(meshes, hulls, kMaxVertices);
+  });
+  for (const auto &hull : hulls)
+  {
+    EXPECT_LE(hull.Vertices().size(), kMaxVertices);
+    simplified += hull.TriangleCount();
+  }
+
+  std::cout << kMeshCount << " meshes, " << vertexCount << " vertices, "
+            << triangles << " hull triangles" << std::endl;
+  std::cout << "New hull per mesh " << newMs << " ms, reused hull "
+            << reusedMs << " ms, BuildMany with 1 thread " << oneThreadMs
+            << " ms, with " << std::thread::hardware_concurrency()
+            << " threads " << manyMs << " ms" << std::endl;
+  std::cout << "At most " << kMaxVertices << " vertices: " << simplified
+            << " triangles in " << simplifiedMs << " ms" << std::endl;
+}
@@ -0,0 +1,179 @@
+/*
+ * Copyright (C) 2018 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <iostream>
+#include <utility>
+#include <vector>
+
+#include "ignition/math/DynamicBvh.hh"
+#include "ignition/math/Rand.hh"
+
+#include "TimeMs.hh"
+
+using namespace ignition;
+
+/// \brief Number of bodies
+static const std::size_t kBodyCount = 10000;
+
+/// \brief Number of simulation steps
+static const int kSteps = 200;
+
+/// \brief Number of steps timed for the brute force, which is slow
+static const int kBruteSteps = 3;
+
+/// \brief Half size of the scene
+static const double kRange = 30;
+
+/// \brief Time step
+static const double kDt = 0.01;
+
+/// \brief A pair of ids
+typedef std::pair<std::size_t, std::size_t> IdPair;
+
+/////////////////////////////////////////////////
+math::Vector3d RandomVector(const double _range)
+{
+  return math::Vector3d(math::Rand::DblUniform(-_range, _range),
+      math::Rand::DblUniform(-_range, _range),
+      math::Rand::DblUniform(-_range, _range));
+}
+
+/////////////////////////////////////////////////
+class DynamicBvhBenchmark : public ::testing::Test
+{
+  /// \brief Create random bodies.
+  protected: void SetUp() override
+  {
+    math::Rand::Seed(1);
+    for (std::size_t i = 0; i < kBodyCount; ++i)
+    {
+      const math::Vector3d min = RandomVector(kRange);
+      this->boxes.push_back(math::AxisAlignedBox(min,
+            min + math::Vector3d(math::Rand::DblUniform(0.5, 2),
+              math::Rand::DblUniform(0.5, 2),
+              math::Rand::DblUniform(0.5, 2))));
+      this->vel.push_back(RandomVector(3));
+    }
+  }
+
+  /// \brief Move the bodies one step, bouncing on the sides of the scene.
+  protected: void Step()
+  {
+    for (std::size_t i = 0; i < kBodyCount; ++i)
+    {
+      const math::Vector3d center = this->boxes[i].Center();
+      for (int a = 0; a < 3; ++a)
+      {
+        if (std::abs(center[a]) > kRange)
+          this->vel[i][a] = -this->vel[i][a];
+      }
+      const math::Vector3d offset = this->vel[i] * kDt;
+      this->boxes[i] = math::AxisAlignedBox(
+          this->boxes[i].Min() + offset, this->boxes[i].Max() + offset);
+    }
+  }
+
+  /// \brief Find the overlapping pairs by testing all the pairs.
+  /// \param[out] _pairs The pairs.
+  protected: void BrutePairs(std::vector<IdPair> &_pairs) const
+  {
+    _pairs.clear();
+    for (std::size_t i = 0; i < kBodyCount; ++i)
+    {
+      for (std::size_t j = i + 1; j < kBodyCount; ++j)
+      {
+        if (this->boxes[i].Intersects(this->boxes[j]))
+          _pairs.push_back(IdPair(i, j));
+      }
+    }
+  }
+
+  /// \brief Bounding boxes of the bodies
+  protected: std::vector<math::AxisAlignedBox> boxes;
+
+  /// \brief Velocity of each body
+  protected: std::vector<math::Vector3d> vel;
+};
+
+/////////////////////////////////////////////////
+TEST_F(DynamicBvhBenchmark, Broadphase)
+{
+  const std::vector<math::AxisAlignedBox> start = this->boxes;
+  const std::vector<math::Vector3d> startVel = this->vel;
+
+  std::vector<IdPair> brute;
+  double bruteMs = 0;
+  for (int s = 0; s < kBruteSteps; ++s)
+  {
+    this->Step();
+    bruteMs += TimeMs([&]()
+    {
+      this->BrutePairs(brute);
+    });
+  }
+  bruteMs /= kBruteSteps;
+
+  this->boxes = start;
+  this->vel = startVel;
+  math::DynamicBvh bvh(0.05);
+  std::vector<IdPair> added, removed;
+  const double buildMs = TimeMs([&]()
+  {
+    for (const auto &box : this->boxes)
+      bvh.Insert(box);
+    bvh.UpdatePairs(added, removed);
+  });
+
+  std::size_t changes = 0;
+  double bvhMs = 0;
+  for (int s = 0; s < kSteps; ++s)
+  {
+    this->Step();
+    bvhMs += TimeMs([&]()
+    {
+      for (std::size_t i = 0; i < kBodyCount; ++i)
+        bvh.Update(i, this->boxes[i], this->vel[i] * kDt);
+      bvh.UpdatePairs(added, removed);
+    });
+    changes += added.size() + removed.size();
+  }
+  bvhMs /= kSteps;
+
+  // The pairs of fat boxes contain the pairs of boxes
+  std::vector<IdPair> pairs;
+  bvh.Pairs(pairs);
+  std::vector<IdPair> tight;
+  for (const auto &p : pairs)
+  {
+    if (this->boxes[p.first].Intersects(this->boxes[p.second]))
+      tight.push_back(p);
+  }
+  this->BrutePairs(brute);
+  EXPECT_EQ(brute, tight);
+
+  std::cout << kBodyCount << " bodies, " << brute.size()
+            << " overlapping pairs, " << pairs.size() << " fat pairs, "
+            << static_cast<double>(changes) / kSteps
+            << " pair changes per step, height " << bvh.Height()
+            << std::endl;
+  std::cout << "Insert: " << buildMs << " ms" << std::endl;
+  std::cout << "Step: brute force " << bruteMs << " ms, dynamic bvh "
+            << bvhMs << " ms, speed-up " << bruteMs / bvhMs << std::endl;
+}
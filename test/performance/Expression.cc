@@ -0,0 +1,226 @@
+/*
+ * Copyright (C) 2018 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "ignition/math/Expression.hh"
+#include "ignition/math/Rand.hh"
+
+#include "TimeMs.hh"
+
+using namespace ignition;
+
+/// \brief Number of bodies updated in each pass
+static const std::size_t kBodyCount = 10000;
+
+/// \brief Number of passes over the bodies
+static const int kIterations = 500;
+
+/// \brief Time step
+static const double kDt = 0.001;
+
+/////////////////////////////////////////////////
+void Report(const std::string &_name, const double _operatorMs,
+    const double _exprMs)
+{
+  std::cout << _name << ": operators " << _operatorMs << " ms, expressions "
+            << _exprMs << " ms, speed-up " << _operatorMs / _exprMs
+            << std::endl;
+}
+
+/////////////////////////////////////////////////
+math::Vector3d RandomVector()
+{
+  return math::Vector3d(math::Rand::DblUniform(-1, 1),
+      math::Rand::DblUniform(-1, 1), math::Rand::DblUniform(-1, 1));
+}
+
+/////////////////////////////////////////////////
+class ExpressionBenchmark : public ::testing::Test
+{
+  /// \brief Create random bodies.
+  protected: void SetUp() override
+  {
+    for (std::size_t i = 0; i < kBodyCount; ++i)
+    {
+      this->pos.push_back(RandomVector());
+      this->vel.push_back(RandomVector());
+      this->force.push_back(RandomVector());
+      this->angVel.push_back(RandomVector());
+      this->torque.push_back(RandomVector());
+      this->invMass.push_back(math::Rand::DblUniform(0.5, 2));
+
+      const math::Vector3d d = RandomVector();
+      this->inertia.push_back(math::Matrix3d(
+            2 + d.X(), 0.1, 0.2,
+            0.1, 2 + d.Y(), 0.3,
+            0.2, 0.3, 2 + d.Z()));
+      this->invInertia.push_back(this->inertia.back().Inverse());
+    }
+  }
+
+  /// \brief Positions
+  protected: std::vector<math::Vector3d> pos;
+
+  /// \brief Linear velocities
+  protected: std::vector<math::Vector3d> vel;
+
+  /// \brief Forces
+  protected: std::vector<math::Vector3d> force;
+
+  /// \brief Angular velocities
+  protected: std::vector<math::Vector3d> angVel;
+
+  /// \brief Torques
+  protected: std::vector<math::Vector3d> torque;
+
+  /// \brief Inverse masses
+  protected: std::vector<double> invMass;
+
+  /// \brief Inertia matrices
+  protected: std::vector<math::Matrix3d> inertia;
+
+  /// \brief Inverse inertia matrices
+  protected: std::vector<math::Matrix3d> invInertia;
+};
+
+/////////////////////////////////////////////////
+TEST_F(ExpressionBenchmark, LinearUpdate)
+{
+  const math::Vector3d gravity(0, 0, -9.8);
+  std::vector<math::Vector3d> outVel(kBodyCount);
+  std::vector<math::Vector3d> outPos(kBodyCount);
+
+  // Semi-implicit Euler step
+  const double operatorMs = TimeMs([&]()
+  {
+    for (int k = 0; k < kIterations; ++k)
+    {
+      for (std::size_t i = 0; i < kBodyCount; ++i)
+      {
+        outVel[i] = this->vel[i] +
+          (this->force[i] * this->invMass[i] + gravity) * kDt;
+        outPos[i] = this->pos[i] + outVel[i] * kDt;
+      }
+    }
+  });
+  const math::Vector3d operatorPos = outPos.back();
+
+  const double exprMs = TimeMs([&]()
+  {
+    for (int k = 0; k < kIterations; ++k)
+    {
+      for (std::size_t i = 0; i < kBodyCount; ++i)
+      {
+        outVel[i] = math::expr::Eval(math::expr::Ref(this->vel[i]) +
+            (math::expr::Ref(this->force[i]) * this->invMass[i] + gravity) *
+            kDt);
+        outPos[i] = math::expr::Eval(
+            math::expr::Ref(this->pos[i]) + math::expr::Ref(outVel[i]) * kDt);
+      }
+    }
+  });
+  EXPECT_EQ(operatorPos, outPos.back());
+
+  Report("Linear update", operatorMs, exprMs);
+}
+
+/////////////////////////////////////////////////
+TEST_F(ExpressionBenchmark, AngularUpdate)
+{
+  std::vector<math::Vector3d> out(kBodyCount);
+
+  // Euler's equations: w' = w + I^-1 (tau - w x (I w)) dt
+  const double operatorMs = TimeMs([&]()
+  {
+    for (int k = 0; k < kIterations; ++k)
+    {
+      for (std::size_t i = 0; i < kBodyCount; ++i)
+      {
+        const math::Vector3d &w = this->angVel[i];
+        out[i] = w + this->invInertia[i] *
+          (this->torque[i] - w.Cross(this->inertia[i] * w)) * kDt;
+      }
+    }
+  });
+  const math::Vector3d operatorOut = out.back();
+
+  const double exprMs = TimeMs([&]()
+  {
+    for (int k = 0; k < kIterations; ++k)
+    {
+      for (std::size_t i = 0; i < kBodyCount; ++i)
+      {
+        const math::Vector3d &w = this->angVel[i];
+        // The inertia product is evaluated once, since Cross reads each
+        // element of its operands twice
+        const math::Vector3d momentum =
+          math::expr::Eval(math::expr::Ref(this->inertia[i]) * w);
+        out[i] = math::expr::Eval(math::expr::Ref(w) +
+            math::expr::Ref(this->invInertia[i]) *
+            (math::expr::Ref(this->torque[i]) -
+             math::expr::Cross(w, momentum)) * kDt);
+      }
+    }
+  });
+  EXPECT_EQ(operatorOut, out.back());
+
+  Report("Angular update", operatorMs, exprMs);
+}
+
+/////////////////////////////////////////////////
+TEST_F(ExpressionBenchmark, SpringDamper)
+{
+  const double stiffness = 100;
+  const double damping = 0.5;
+  std::vector<math::Vector3d> out(kBodyCount);
+
+  // Force between consecutive bodies
+  const double operatorMs = TimeMs([&]()
+  {
+    for (int k = 0; k < kIterations; ++k)
+    {
+      for (std::size_t i = 1; i < kBodyCount; ++i)
+      {
+        out[i] = (this->pos[i] - this->pos[i - 1]) * stiffness -
+          (this->vel[i] - this->vel[i - 1]) * damping;
+      }
+    }
+  });
+  const math::Vector3d operatorOut = out.back();
+
+  const double exprMs = TimeMs([&]()
+  {
+    for (int k = 0; k < kIterations; ++k)
+    {
+      for (std::size_t i = 1; i < kBodyCount; ++i)
+      {
+        out[i] = math::expr::Eval(
+            (math::expr::Ref(this->pos[i]) - this->pos[i - 1]) * stiffness -
+            (math::expr::Ref(this->vel[i]) - this->vel[i - 1]) * damping);
+      }
+    }
+  });
+  EXPECT_EQ(operatorOut, out.back());
+
+  Report("Spring damper", operatorMs, exprMs);
+}
@@ -0,0 +1,127 @@
+/*
+ * Copyright (C) 2018 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <iostream>
+#include <vector>
+
+#include "ignition/math/BoxPacket.hh"
+#include "ignition/math/Frustum.hh"
+#include "ignition/math/Helpers.hh"
+#include "ignition/math/Rand.hh"
+
+#include "TimeMs.hh"
+
+using namespace ignition;
+
+/// \brief Number of objects culled by each camera
+static const std::size_t kObjectCount = 50000;
+
+/// \brief Number of cameras
+static const int kCameraCount = 20;
+
+/////////////////////////////////////////////////
+TEST(FrustumBenchmark, Cull)
+{
+  math::Rand::Seed(1);
+  std::vector<math::AxisAlignedBox> boxes;
+  for (std::size_t i = 0; i < kObjectCount; ++i)
+  {
+    const math::Vector3d center(math::Rand::DblUniform(-100, 100),
+        math::Rand::DblUniform(-100, 100), math::Rand::DblUniform(0, 20));
+    const math::Vector3d half(math::Rand::DblUniform(0.1, 2),
+        math::Rand::DblUniform(0.1, 2), math::Rand::DblUniform(0.1, 2));
+    boxes.push_back(math::AxisAlignedBox(center - half, center + half));
+  }
+  const math::BoxPacket packet(boxes);
+
+  std::vector<math::Frustum> cameras;
+  for (int c = 0; c < kCameraCount; ++c)
+  {
+    cameras.push_back(math::Frustum(0.1, 60, IGN_DTOR(80), 16.0 / 9.0,
+          math::Pose3d(math::Rand::DblUniform(-50, 50),
+            math::Rand::DblUniform(-50, 50), 2, 0, 0.1,
+            math::Rand::DblUniform(-IGN_PI, IGN_PI))));
+  }
+
+  std::size_t boxCount = 0;
+  const double boxMs = TimeMs([&]()
+  {
+    for (const auto &camera : cameras)
+    {
+      for (const auto &box : boxes)
+      {
+        if (camera.Contains(box))
+          ++boxCount;
+      }
+    }
+  });
+
+  std::size_t packetCount = 0;
+  std::vector<bool> visible;
+  const double packetMs = TimeMs([&]()
+  {
+    for (const auto &camera : cameras)
+      packetCount += camera.Contains(packet, visible);
+  });
+  EXPECT_EQ(boxCount, packetCount);
+
+  std::cout << kCameraCount << " cameras, " << kObjectCount
+            << " boxes: Contains(AxisAlignedBox) " << boxMs
+            << " ms, Contains(BoxPacket) " << packetMs << " ms, speed-up "
+            << boxMs / packetMs << ", " << packetCount << " visible"
+            << std::endl;
+}
+
+/////////////////////////////////////////////////
+TEST(FrustumBenchmark, PoseUpdate)
+{
+  const int iterations = 1000000;
+  math::Frustum frustum(0.1, 60, IGN_DTOR(80), 16.0 / 9.0);
+  const math::Vector3d point(20, 0, 2);
+
+  // Camera that moves every tick
+  std::size_t poseCount = 0;
+  const double poseMs = TimeMs([&]()
+  {
+    for (int i = 0; i < iterations; ++i)
+    {
+      frustum.SetPose(math::Pose3d(i * 1e-6, 0, 2, 0, 0, i * 1e-7));
+      if (frustum.Contains(point))
+        ++poseCount;
+    }
+  });
+
+  // Camera that also zooms every tick
+  std::size_t zoomCount = 0;
+  const double zoomMs = TimeMs([&]()
+  {
+    for (int i = 0; i < iterations; ++i)
+    {
+      frustum.SetFOV(IGN_DTOR(80) + i * 1e-9);
+      frustum.SetPose(math::Pose3d(i * 1e-6, 0, 2, 0, 0, i * 1e-7));
+      if (frustum.Contains(point))
+        ++zoomCount;
+    }
+  });
+  EXPECT_EQ(poseCount, zoomCount);
+
+  std::cout << iterations << " updates: pose " << poseMs
+            << " ms, field of view and pose " << zoomMs << " ms"
+            << std::endl;
+}
@@ -0,0 +1,178 @@
+/*
+ * Copyright (C) 2018 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "ignition/math/KdTree.hh"
+#include "ignition/math/Rand.hh"
+
+#include "TimeMs.hh"
+
+using namespace ignition;
+
+/// \brief Number of points of the tree
+static const std::size_t kPointCount = 2000000;
+
+/// \brief Number of queries
+static const std::size_t kQueryCount = 100000;
+
+/// \brief Number of queries answered by testing every point
+static const std::size_t kBruteQueryCount = 100;
+
+/// \brief Number of observations of the closest centroid benchmark
+static const std::size_t kObservationCount = 200000;
+
+/////////////////////////////////////////////////
+/// \brief Random points in a cube of side 2 * _range.
+std::vector<math::Vector3d> RandomPoints(const std::size_t _n,
+    const double _range)
+{
+  std::vector<math::Vector3d> points;
+  points.reserve(_n);
+  for (std::size_t i = 0; i < _n; ++i)
+  {
+    points.push_back(math::Vector3d(math::Rand::DblUniform(-_range, _range),
+        math::Rand::DblUniform(-_range, _range),
+        math::Rand::DblUniform(-_range, _range)));
+  }
+  return points;
+}
+
+/////////////////////////////////////////////////
+TEST(KdTreeBenchmark, Nearest)
+{
+  math::Rand::Seed(1);
+  const std::vector<math::Vector3d> points = RandomPoints(kPointCount, 100);
+  const std::vector<math::Vector3d> queries = RandomPoints(kQueryCount, 100);
+
+  math::KdTree tree;
+  const double serialMs = TimeMs([&]()
+  {
+    tree.Build(points);
+  });
+  const double parallelMs = TimeMs([&]()
+  {
+    tree.Build(points, 0);
+  });
+  std::cout << "Build, " << kPointCount << " points: 1 thread " << serialMs
+            << " ms, all threads " << parallelMs << " ms" << std::endl;
+
+  const std::size_t k = 8;
+  std::vector<std::size_t> bruteLast;
+  std::vector<std::pair<double, std::size_t>> all(points.size());
+  const double bruteMs = TimeMs([&]()
+  {
+    for (std::size_t q = 0; q < kBruteQueryCount; ++q)
+    {
+      for (std::size_t i = 0; i < points.size(); ++i)
+        all[i] = std::make_pair((points[i] - queries[q]).SquaredLength(), i);
+      std::partial_sort(all.begin(), all.begin() + k, all.end());
+    }
+  });
+  for (std::size_t i = 0; i < k; ++i)
+    bruteLast.push_back(all[i].second);
+
+  std::vector<std::size_t> indices;
+  tree.Nearest(queries[kBruteQueryCount - 1], k, indices);
+  EXPECT_EQ(bruteLast, indices);
+
+  std::size_t checksum = 0;
+  const double exactMs = TimeMs([&]()
+  {
+    for (const math::Vector3d &q : queries)
+    {
+      tree.Nearest(q, k, indices);
+      checksum += indices[0];
+    }
+  });
+  const double approxMs = TimeMs([&]()
+  {
+    for (const math::Vector3d &q : queries)
+    {
+      tree.Nearest(q, k, indices, 0.5);
+      checksum += indices[0];
+    }
+  });
+  const double closestMs = TimeMs([&]()
+  {
+    for (const math::Vector3d &q : queries)
+      checksum += std::get<2>(tree.Closest(q));
+  });
+  EXPECT_NE(0u, checksum);
+
+  const double perBruteQuery = bruteMs / kBruteQueryCount;
+  std::cout << "Nearest " << k << ", " << kQueryCount << " queries in "
+            << kPointCount << " points: brute force (estimated) "
+            << perBruteQuery * kQueryCount << " ms, exact " << exactMs
+            << " ms, epsilon 0.5 " << approxMs << " ms, Closest "
+            << closestMs << " ms, speed-up "
+            << perBruteQuery * kQueryCount / exactMs << std::endl;
+}
+
+/////////////////////////////////////////////////
+TEST(KdTreeBenchmark, ClosestCentroid)
+{
+  // The assignment step of Kmeans::Cluster
+  math::Rand::Seed(2);
+  const std::vector<math::Vector3d> obs = RandomPoints(kObservationCount, 1);
+
+  for (const std::size_t clusters : {8u, 16u, 32u, 64u, 256u, 4096u})
+  {
+    const std::vector<math::Vector3d> centroids = RandomPoints(clusters, 1);
+
+    std::size_t bruteSum = 0;
+    const double bruteMs = TimeMs([&]()
+    {
+      for (const math::Vector3d &p : obs)
+      {
+        double min = HUGE_VAL;
+        std::size_t minIdx = 0;
+        for (std::size_t i = 0; i < centroids.size(); ++i)
+        {
+          const double d = p.Distance(centroids[i]);
+          if (d < min)
+          {
+            min = d;
+            minIdx = i;
+          }
+        }
+        bruteSum += minIdx;
+      }
+    });
+
+    std::size_t treeSum = 0;
+    const double treeMs = TimeMs([&]()
+    {
+      const math::KdTree tree(centroids);
+      for (const math::Vector3d &p : obs)
+        treeSum += std::get<2>(tree.Closest(p));
+    });
+    EXPECT_EQ(bruteSum, treeSum);
+
+    std::cout << "Closest centroid, " << clusters << " clusters, "
+              << kObservationCount << " observations: brute force "
+              << bruteMs << " ms, tree " << treeMs << " ms, speed-up "
+              << bruteMs / treeMs << std::endl;
+  }
+}
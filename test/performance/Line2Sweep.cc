@@ -0,0 +1,175 @@
+/*
+ * Copyright (C) 2018 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <utility>
+#include <vector>
+
+#include "ignition/math/Line2Sweep.hh"
+#include "ignition/math/Rand.hh"
+
+#include "TimeMs.hh"
+
+using namespace ignition;
+
+/// \brief Number of segments compared with the brute force search
+static const std::size_t kSmallCount = 20000;
+
+/// \brief Number of segments of the full map
+static const std::size_t kLargeCount = 200000;
+
+/// \brief Number of segments in each wall
+static const int kWallLength = 8;
+
+/// \brief A pair of indices
+typedef std::pair<std::size_t, std::size_t> IndexPair;
+
+/////////////////////////////////////////////////
+/// \brief Side of a point relative to a line.
+double Orientation(const math::Vector2d &_a, const math::Vector2d &_b,
+    const math::Vector2d &_c)
+{
+  return (_b.X() - _a.X()) * (_c.Y() - _a.Y()) -
+    (_b.Y() - _a.Y()) * (_c.X() - _a.X());
+}
+
+/////////////////////////////////////////////////
+/// \brief Check if two segments in general position share a point.
+bool Touch(const math::Line2d &_a, const math::Line2d &_b)
+{
+  if (std::max(_a[0].X(), _a[1].X()) < std::min(_b[0].X(), _b[1].X()) ||
+      std::max(_b[0].X(), _b[1].X()) < std::min(_a[0].X(), _a[1].X()) ||
+      std::max(_a[0].Y(), _a[1].Y()) < std::min(_b[0].Y(), _b[1].Y()) ||
+      std::max(_b[0].Y(), _b[1].Y()) < std::min(_a[0].Y(), _a[1].Y()))
+  {
+    return false;
+  }
+
+  // Walls share their end points exactly
+  if (_a[0] == _b[0] || _a[0] == _b[1] || _a[1] == _b[0] || _a[1] == _b[1])
+    return true;
+
+  const double o1 = Orientation(_a[0], _a[1], _b[0]);
+  const double o2 = Orientation(_a[0], _a[1], _b[1]);
+  const double o3 = Orientation(_b[0], _b[1], _a[0]);
+  const double o4 = Orientation(_b[0], _b[1], _a[1]);
+  return ((o1 > 0 && o2 < 0) || (o1 < 0 && o2 > 0)) &&
+    ((o3 > 0 && o4 < 0) || (o3 < 0 && o4 > 0));
+}
+
+/////////////////////////////////////////////////
+/// \brief Create a map of roads and walls over a square whose side grows
+/// with the number of segments, so that the density stays the same.
+/// \param[in] _count Number of segments.
+/// \return The segments.
+std::vector<math::Line2d> Map(const std::size_t _count)
+{
+  const double side = std::sqrt(static_cast<double>(_count)) * 10;
+  std::vector<math::Line2d> lines;
+  while (lines.size() < _count)
+  {
+    math::Vector2d p(math::Rand::DblUniform(0, side),
+        math::Rand::DblUniform(0, side));
+    if (math::Rand::IntUniform(0, 1) == 0)
+    {
+      // A road piece, mostly along x or y
+      const double length = math::Rand::DblUniform(5, 40);
+      const double skew = math::Rand::DblUniform(-0.05, 0.05);
+      const math::Vector2d dir = math::Rand::IntUniform(0, 1) == 0 ?
+        math::Vector2d(1, skew) : math::Vector2d(skew, 1);
+      lines.push_back(math::Line2d(p, p + dir * length));
+      continue;
+    }
+
+    // A wall, made of short segments that share their end points
+    for (int i = 0; i < kWallLength && lines.size() < _count; ++i)
+    {
+      const math::Vector2d next = p + math::Vector2d(
+          math::Rand::DblUniform(-3, 3), math::Rand::DblUniform(-3, 3));
+      lines.push_back(math::Line2d(p, next));
+      p = next;
+    }
+  }
+  return lines;
+}
+
+/////////////////////////////////////////////////
+TEST(Line2SweepBenchmark, BruteForce)
+{
+  math::Rand::Seed(1);
+  const std::vector<math::Line2d> lines = Map(kSmallCount);
+
+  std::vector<IndexPair> brute;
+  const double bruteMs = TimeMs([&]()
+  {
+    for (std::size_t i = 0; i < lines.size(); ++i)
+    {
+      for (std::size_t j = i + 1; j < lines.size(); ++j)
+      {
+        if (Touch(lines[i], lines[j]))
+          brute.push_back(IndexPair(i, j));
+      }
+    }
+  });
+
+  math::Line2Sweep sweep;
+  std::vector<IndexPair> pairs;
+  std::vector<math::Vector2d> points;
+  const double sweepMs = TimeMs([&]()
+  {
+    sweep.Intersect(lines, pairs, points);
+  });
+
+  std::sort(pairs.begin(), pairs.end());
+  EXPECT_EQ(brute, pairs);
+
+  std::cout << lines.size() << " segments, " << pairs.size()
+            << " intersections: brute force " << bruteMs << " ms, sweep "
+            << sweepMs << " ms" << std::endl;
+}
+
+/////////////////////////////////////////////////
+TEST(Line2SweepBenchmark, Map)
+{
+  math::Rand::Seed(2);
+  const std::vector<math::Line2d> lines = Map(kLargeCount);
+
+  math::Line2Sweep sweep;
+  std::vector<IndexPair> pairs;
+  std::vector<math::Vector2d> points;
+  const double firstMs = TimeMs([&]()
+  {
+    sweep.Intersect(lines, pairs, points);
+  });
+  EXPECT_EQ(pairs.size(), points.size());
+
+  // The second search reuses the memory of the first one
+  const std::size_t count = pairs.size();
+  const double secondMs = TimeMs([&]()
+  {
+    sweep.Intersect(lines, pairs, points);
+  });
+  EXPECT_EQ(count, pairs.size());
+
+  std::cout << lines.size() << " segments, " << pairs.size()
+            << " intersections: sweep " << firstMs << " ms, again "
+            << secondMs << " ms" << std::endl;
+}
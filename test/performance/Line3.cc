@@ -0,0 +1,110 @@
+/*
+ * Copyright (C) 2018 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <iostream>
+#include <vector>
+
+#include "ignition/math/Line3.hh"
+#include "ignition/math/Rand.hh"
+#include "ignition/math/SimdDispatch.hh"
+#include "ignition/math/Vector3Array.hh"
+
+#include "TimeMs.hh"
+
+using namespace ignition;
+
+/// \brief Number of pairs of segments
+static const std::size_t kPairCount = 50000;
+
+/// \brief Number of passes over the pairs
+static const int kIterations = 50;
+
+/////////////////////////////////////////////////
+math::Vector3d RandomVector(const double _range)
+{
+  return math::Vector3d(math::Rand::DblUniform(-_range, _range),
+      math::Rand::DblUniform(-_range, _range),
+      math::Rand::DblUniform(-_range, _range));
+}
+
+/////////////////////////////////////////////////
+TEST(Line3Benchmark, ClosestPoints)
+{
+  // Short segments of cables close to each other, as given by a
+  // broadphase
+  math::Rand::Seed(1);
+  std::vector<math::Line3d> linesA, linesB;
+  math::Vector3Arrayd startA, endA, startB, endB;
+  for (std::size_t i = 0; i < kPairCount; ++i)
+  {
+    const math::Vector3d p = RandomVector(10);
+    const math::Vector3d q = p + RandomVector(0.3);
+    linesA.push_back(math::Line3d(p, p + RandomVector(0.2)));
+    linesB.push_back(math::Line3d(q, q + RandomVector(0.2)));
+    startA.PushBack(linesA.back()[0]);
+    endA.PushBack(linesA.back()[1]);
+    startB.PushBack(linesB.back()[0]);
+    endB.PushBack(linesB.back()[1]);
+  }
+
+  double scalarSum = 0;
+  math::Line3d result;
+  const double scalarMs = TimeMs([&]()
+  {
+    for (int k = 0; k < kIterations; ++k)
+    {
+      for (std::size_t i = 0; i < kPairCount; ++i)
+      {
+        linesA[i].Distance(linesB[i], result);
+        scalarSum += result.Length();
+      }
+    }
+  });
+  EXPECT_GT(scalarSum, 0);
+  std::cout << kIterations << " x " << kPairCount
+            << " pairs: Line3::Distance " << scalarMs << " ms" << std::endl;
+
+  const math::SimdLevel active = math::SimdDispatch::ActiveLevel();
+  math::Vector3Arrayd pointsA, pointsB;
+  std::vector<double> sqDist;
+  for (int level = 0;
+       level <= static_cast<int>(math::SimdDispatch::SupportedLevel());
+       ++level)
+  {
+    EXPECT_TRUE(math::SimdDispatch::SetActiveLevel(
+          static_cast<math::SimdLevel>(level)));
+    double batchSum = 0;
+    const double batchMs = TimeMs([&]()
+    {
+      for (int k = 0; k < kIterations; ++k)
+      {
+        math::Line3d::ClosestPoints(startA, endA, startB, endB,
+            pointsA, pointsB, sqDist);
+        batchSum += sqDist.back();
+      }
+    });
+    EXPECT_EQ(kPairCount, sqDist.size());
+    EXPECT_GE(batchSum, 0);
+
+    std::cout << "Line3::ClosestPoints (" << math::SimdDispatch::LevelName(
+        math::SimdDispatch::ActiveLevel()) << ") " << batchMs
+              << " ms, speed-up " << scalarMs / batchMs << std::endl;
+  }
+  math::SimdDispatch::SetActiveLevel(active);
+}
@@ -0,0 +1,216 @@
+/*
+ * Copyright (C) 2018 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "ignition/math/Bvh.hh"
+#include "ignition/math/LooseOctree.hh"
+#include "ignition/math/Rand.hh"
+
+#include "TimeMs.hh"
+
+using namespace ignition;
+
+/// \brief Number of moving boxes
+static const std::size_t kBoxCount = 20000;
+
+/// \brief Number of simulation steps
+static const int kSteps = 100;
+
+/// \brief Number of box queries in each step
+static const int kQueryCount = 50;
+
+/// \brief Half size of the scene
+static const double kRange = 500;
+
+/////////////////////////////////////////////////
+void Report(const std::string &_name, const double _bvhMs,
+    const double _octreeMs)
+{
+  std::cout << _name << ": bvh rebuild " << _bvhMs << " ms, octree "
+            << _octreeMs << " ms, speed-up " << _bvhMs / _octreeMs
+            << std::endl;
+}
+
+/////////////////////////////////////////////////
+math::Vector3d RandomVector(const double _range)
+{
+  return math::Vector3d(math::Rand::DblUniform(-_range, _range),
+      math::Rand::DblUniform(-_range, _range),
+      math::Rand::DblUniform(-_range, _range));
+}
+
+/////////////////////////////////////////////////
+class LooseOctreeBenchmark : public ::testing::Test
+{
+  /// \brief Create random boxes, velocities and queries.
+  protected: void SetUp() override
+  {
+    math::Rand::Seed(1);
+    for (std::size_t i = 0; i < kBoxCount; ++i)
+    {
+      // Mostly small robots and debris, and a few large objects
+      const double size = i % 100 == 0 ? 40 : math::Rand::DblUniform(0.5, 5);
+      const math::Vector3d min = RandomVector(kRange);
+      this->boxes.push_back(math::AxisAlignedBox(min,
+            min + math::Vector3d(size, size, size)));
+      this->vel.push_back(RandomVector(2));
+    }
+    for (int i = 0; i < kQueryCount; ++i)
+    {
+      const math::Vector3d min = RandomVector(kRange);
+      this->queries.push_back(math::AxisAlignedBox(min,
+            min + math::Vector3d(30, 30, 30)));
+    }
+  }
+
+  /// \brief Move the boxes one step, bouncing on the sides of the scene.
+  protected: void Step()
+  {
+    for (std::size_t i = 0; i < kBoxCount; ++i)
+    {
+      const math::Vector3d center = this->boxes[i].Center();
+      for (int a = 0; a < 3; ++a)
+      {
+        if (std::abs(center[a]) > kRange)
+          this->vel[i][a] = -this->vel[i][a];
+      }
+      this->boxes[i] = math::AxisAlignedBox(
+          this->boxes[i].Min() + this->vel[i],
+          this->boxes[i].Max() + this->vel[i]);
+    }
+  }
+
+  /// \brief Boxes
+  protected: std::vector<math::AxisAlignedBox> boxes;
+
+  /// \brief Velocity of each box
+  protected: std::vector<math::Vector3d> vel;
+
+  /// \brief Box queries of each step
+  protected: std::vector<math::AxisAlignedBox> queries;
+};
+
+/////////////////////////////////////////////////
+TEST_F(LooseOctreeBenchmark, Update)
+{
+  const std::vector<math::AxisAlignedBox> start = this->boxes;
+  const std::vector<math::Vector3d> startVel = this->vel;
+
+  math::Bvh bvh;
+  double bvhMs = 0;
+  for (int s = 0; s < kSteps; ++s)
+  {
+    this->Step();
+    bvhMs += TimeMs([&]()
+    {
+      bvh.Build(this->boxes);
+    });
+  }
+
+  this->boxes = start;
+  this->vel = startVel;
+  const math::AxisAlignedBox region(-kRange, -kRange, -kRange,
+      kRange, kRange, kRange);
+  math::LooseOctree octree(region);
+  for (const auto &box : this->boxes)
+    octree.Insert(box);
+  double octreeMs = 0;
+  for (int s = 0; s < kSteps; ++s)
+  {
+    this->Step();
+    octreeMs += TimeMs([&]()
+    {
+      for (std::size_t i = 0; i < kBoxCount; ++i)
+        octree.Update(i, this->boxes[i]);
+    });
+  }
+  std::cout << "Octree of " << kBoxCount << " boxes: "
+            << octree.NodeCount() << " nodes" << std::endl;
+
+  Report("Update of " + std::to_string(kSteps) + " steps", bvhMs, octreeMs);
+}
+
+/////////////////////////////////////////////////
+TEST_F(LooseOctreeBenchmark, Frame)
+{
+  // Each step moves the boxes, then runs box, ray and frustum queries
+  const std::vector<math::AxisAlignedBox> start = this->boxes;
+  const std::vector<math::Vector3d> startVel = this->vel;
+  const math::Frustum frustum(1, 300, math::Angle(IGN_DTOR(60)), 1.5,
+      math::Pose3d(0, 0, 0, 0, 0.3, 0.5));
+  std::vector<std::size_t> ids;
+
+  math::Bvh bvh;
+  std::size_t bvhCount = 0;
+  double bvhMs = 0;
+  for (int s = 0; s < kSteps; ++s)
+  {
+    this->Step();
+    bvhMs += TimeMs([&]()
+    {
+      bvh.Build(this->boxes);
+      for (const auto &query : this->queries)
+      {
+        bvh.Overlap(query, ids);
+        bvhCount += ids.size();
+        bvhCount += std::get<0>(bvh.Intersect(query.Min(),
+              query.Max(), 0, 2000));
+      }
+      // The Bvh has no frustum query, the boxes are tested one by one
+      for (const auto &box : this->boxes)
+        bvhCount += frustum.Contains(box);
+    });
+  }
+
+  this->boxes = start;
+  this->vel = startVel;
+  const math::AxisAlignedBox region(-kRange, -kRange, -kRange,
+      kRange, kRange, kRange);
+  math::LooseOctree octree(region);
+  for (const auto &box : this->boxes)
+    octree.Insert(box);
+  std::size_t octreeCount = 0;
+  double octreeMs = 0;
+  for (int s = 0; s < kSteps; ++s)
+  {
+    this->Step();
+    octreeMs += TimeMs([&]()
+    {
+      for (std::size_t i = 0; i < kBoxCount; ++i)
+        octree.Update(i, this->boxes[i]);
+      for (const auto &query : this->queries)
+      {
+        octree.Overlap(query, ids);
+        octreeCount += ids.size();
+        octreeCount += std::get<0>(octree.Intersect(query.Min(),
+              query.Max(), 0, 2000));
+      }
+      octree.Visible(frustum, ids);
+      octreeCount += ids.size();
+    });
+  }
+  EXPECT_EQ(bvhCount, octreeCount);
+
+  Report("Frame of " + std::to_string(kSteps) + " steps", bvhMs, octreeMs);
+}
@@ -0,0 +1,246 @@
+/*
+ * Copyright (C) 2018 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "ignition/math/Matrix4.hh"
+#include "ignition/math/Pose3.hh"
+#include "ignition/math/Rand.hh"
+#include "ignition/math/Vector3Array.hh"
+
+#include "TimeMs.hh"
+
+using namespace ignition;
+
+/// \brief Number of matrices in each benchmark
+static const std::size_t kMatrixCount = 1000;
+
+/// \brief Number of passes over the matrices
+static const int kIterations = 2000;
+
+/// \brief Number of points transformed in each pass
+static const std::size_t kPointCount = 100000;
+
+/////////////////////////////////////////////////
+void Report(const std::string &_name, const double _scalarMs,
+    const double _simdMs, const std::string &_baseLabel = "scalar",
+    const std::string &_fastLabel = "SIMD")
+{
+  std::cout << _name << ": " << _baseLabel << " " << _scalarMs << " ms, "
+            << _fastLabel << " " << _simdMs << " ms, speed-up "
+            << _scalarMs / _simdMs << std::endl;
+}
+
+/////////////////////////////////////////////////
+template<typename T>
+class Matrix4Benchmark : public ::testing::Test
+{
+  /// \brief Fill the input matrices with random values.
+  protected: void SetUp() override
+  {
+    this->matrices.resize(kMatrixCount);
+    for (auto &mat : this->matrices)
+    {
+      for (int i = 0; i < 4; ++i)
+      {
+        for (int j = 0; j < 4; ++j)
+          mat(i, j) = static_cast<T>(math::Rand::DblUniform(-1, 1));
+      }
+      // Keep the matrices well conditioned
+      for (int i = 0; i < 4; ++i)
+        mat(i, i) += 4;
+    }
+  }
+
+  /// \brief Input matrices
+  protected: std::vector<math::Matrix4<T>> matrices;
+};
+
+typedef ::testing::Types<float, double> FloatTypes;
+TYPED_TEST_CASE(Matrix4Benchmark, FloatTypes);
+
+/////////////////////////////////////////////////
+TYPED_TEST(Matrix4Benchmark, Multiply)
+{
+  typedef TypeParam T;
+  const std::vector<math::Matrix4<T>> &mats = this->matrices;
+
+  std::vector<math::Matrix4<T>> out(kMatrixCount);
+  T sum = 0;
+  auto run = [&](auto _multiply)
+  {
+    const double ms = TimeMs([&]()
+    {
+      for (int k = 0; k < kIterations; ++k)
+        _multiply();
+    });
+    sum += out[kMatrixCount - 1](0, 0);
+    return ms;
+  };
+
+  const double operatorMs = run([&]()
+  {
+    for (std::size_t i = 1; i < kMatrixCount; ++i)
+      out[i] = mats[0] * mats[i];
+  });
+  const double batchMs = run([&]()
+  {
+    mats[0].Multiply(mats.data() + 1, out.data() + 1, kMatrixCount - 1);
+  });
+  EXPECT_TRUE(std::isfinite(sum));
+
+  const std::string name = sizeof(T) == sizeof(float) ? "Matrix4f" :
+      "Matrix4d";
+  Report(name + " multiply", operatorMs, batchMs, "operator*", "batch");
+}
+
+/////////////////////////////////////////////////
+TYPED_TEST(Matrix4Benchmark, Inverse)
+{
+  typedef TypeParam T;
+  const std::vector<math::Matrix4<T>> &mats = this->matrices;
+
+  std::vector<math::Matrix4<T>> out(kMatrixCount);
+  T sum = 0;
+  auto run = [&](auto _inverse)
+  {
+    const double ms = TimeMs([&]()
+    {
+      for (int k = 0; k < kIterations; ++k)
+        _inverse();
+    });
+    sum += out[kMatrixCount - 1](0, 0);
+    return ms;
+  };
+
+  const double publicMs = run([&]()
+  {
+    for (std::size_t i = 0; i < kMatrixCount; ++i)
+      out[i] = mats[i].Inverse();
+  });
+  const double batchMs = run([&]()
+  {
+    math::Matrix4<T>::Inverse(mats, out);
+  });
+  EXPECT_TRUE(std::isfinite(sum));
+
+  const std::string name = sizeof(T) == sizeof(float) ? "Matrix4f" :
+      "Matrix4d";
+  Report(name + " inverse", publicMs, batchMs, "Inverse()", "batch");
+}
+
+/////////////////////////////////////////////////
+TYPED_TEST(Matrix4Benchmark, TransformPoints)
+{
+  typedef TypeParam T;
+
+  math::Vector3Array<T> points(kPointCount);
+  for (std::size_t i = 0; i < kPointCount; ++i)
+  {
+    points.Set(i, math::Vector3<T>(
+          static_cast<T>(math::Rand::DblUniform(-1, 1)),
+          static_cast<T>(math::Rand::DblUniform(-1, 1)),
+          static_cast<T>(math::Rand::DblUniform(-1, 1))));
+  }
+  math::Vector3Array<T> out(kPointCount);
+
+  T mat[4][4];
+  for (int i = 0; i < 4; ++i)
+  {
+    for (int j = 0; j < 4; ++j)
+      mat[i][j] = this->matrices[0](i, j);
+  }
+  auto run = [&](auto _transform)
+  {
+    return TimeMs([&]()
+    {
+      for (int k = 0; k < kIterations / 20; ++k)
+        _transform(mat, points.Data(), out.Data(), kPointCount);
+    });
+  };
+
+  const double scalarMs = run(
+      math::detail::Matrix4ScalarKernels<T>::TransformPoints);
+  const double simdMs = run(math::detail::Matrix4Kernels<T>::TransformPoints);
+  EXPECT_TRUE(std::isfinite(out[kPointCount - 1].X()));
+
+  Report(sizeof(T) == sizeof(float) ? "Matrix4f transform points" :
+      "Matrix4d transform points", scalarMs, simdMs);
+}
+
+/////////////////////////////////////////////////
+TYPED_TEST(Matrix4Benchmark, Affine)
+{
+  typedef TypeParam T;
+
+  std::vector<math::Matrix4<T>> transforms;
+  for (std::size_t i = 0; i < kMatrixCount; ++i)
+  {
+    transforms.push_back(math::Matrix4<T>(math::Pose3<T>(
+          static_cast<T>(math::Rand::DblUniform(-1, 1)),
+          static_cast<T>(math::Rand::DblUniform(-1, 1)),
+          static_cast<T>(math::Rand::DblUniform(-1, 1)),
+          static_cast<T>(math::Rand::DblUniform(-IGN_PI, IGN_PI)),
+          static_cast<T>(math::Rand::DblUniform(-IGN_PI, IGN_PI)),
+          static_cast<T>(math::Rand::DblUniform(-IGN_PI, IGN_PI)))));
+  }
+
+  std::vector<math::Matrix4<T>> out(kMatrixCount);
+  T sum = 0;
+  auto run = [&](auto _func)
+  {
+    const double ms = TimeMs([&]()
+    {
+      for (int k = 0; k < kIterations; ++k)
+      {
+        for (std::size_t i = 1; i < kMatrixCount; ++i)
+          out[i] = _func(transforms[i - 1], transforms[i]);
+      }
+    });
+    sum += out[kMatrixCount - 1](0, 3);
+    return ms;
+  };
+
+  const double generalInverseMs = run(
+      [](const math::Matrix4<T> &_a, const math::Matrix4<T> &)
+      {
+        return _a.Inverse();
+      });
+  const double affineInverseMs = run(
+      [](const math::Matrix4<T> &_a, const math::Matrix4<T> &)
+      {
+        return _a.InverseAffine();
+      });
+  const double rigidInverseMs = run(
+      [](const math::Matrix4<T> &_a, const math::Matrix4<T> &)
+      {
+        return _a.InverseRigid();
+      });
+  EXPECT_TRUE(std::isfinite(sum));
+
+  const std::string name = sizeof(T) == sizeof(float) ? "Matrix4f" :
+      "Matrix4d";
+  Report(name + " affine inverse", generalInverseMs, affineInverseMs,
+      "general", "affine");
+  Report(name + " rigid inverse", generalInverseMs, rigidInverseMs,
+      "general", "rigid");
+}
@@ -0,0 +1,184 @@
+/*
+ * Copyright (C) 2018 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "ignition/math/Helpers.hh"
+#include "ignition/math/OrientedBoxPacket.hh"
+#include "ignition/math/Rand.hh"
+#include "ignition/math/Vector3Array.hh"
+
+#include "TimeMs.hh"
+
+using namespace ignition;
+
+/// \brief Number of boxes in the packet
+static const std::size_t kBoxCount = 100000;
+
+/// \brief Number of boxes tested against the packet
+static const int kQueryCount = 100;
+
+/// \brief Number of points of the point cloud
+static const std::size_t kPointCount = 1000000;
+
+/// \brief Number of boxes tested against the point cloud
+static const int kCropCount = 10;
+
+/////////////////////////////////////////////////
+/// \brief Create a random box.
+/// \param[in] _range Range of the coordinates of the center.
+/// \return The box.
+math::OrientedBoxd RandomBox(const double _range)
+{
+  return math::OrientedBoxd(
+      math::Vector3d(math::Rand::DblUniform(0.1, 2),
+        math::Rand::DblUniform(0.1, 2), math::Rand::DblUniform(0.1, 2)),
+      math::Pose3d(math::Rand::DblUniform(-_range, _range),
+        math::Rand::DblUniform(-_range, _range),
+        math::Rand::DblUniform(-_range, _range),
+        math::Rand::DblUniform(-IGN_PI, IGN_PI),
+        math::Rand::DblUniform(-IGN_PI, IGN_PI),
+        math::Rand::DblUniform(-IGN_PI, IGN_PI)));
+}
+
+/////////////////////////////////////////////////
+/// \brief Test random queries against a packet of random boxes.
+/// \param[in] _name Name of the test case.
+/// \param[in] _range Range of the coordinates of the centers.
+void Compare(const std::string &_name, const double _range)
+{
+  math::Rand::Seed(1);
+  std::vector<math::OrientedBoxd> boxes;
+  for (std::size_t i = 0; i < kBoxCount; ++i)
+    boxes.push_back(RandomBox(_range));
+  std::vector<math::OrientedBoxd> queries;
+  for (int i = 0; i < kQueryCount; ++i)
+    queries.push_back(RandomBox(_range));
+
+  std::size_t boxCount = 0;
+  const double boxMs = TimeMs([&]()
+  {
+    for (const auto &query : queries)
+    {
+      for (const auto &box : boxes)
+      {
+        if (query.Intersects(box))
+          ++boxCount;
+      }
+    }
+  });
+
+  math::OrientedBoxPacket packet;
+  const double buildMs = TimeMs([&]()
+  {
+    packet.Assign(boxes);
+  });
+
+  std::size_t packetCount = 0;
+  std::vector<bool> hits;
+  const double packetMs = TimeMs([&]()
+  {
+    for (const auto &query : queries)
+      packetCount += packet.Intersects(query, hits);
+  });
+  EXPECT_EQ(boxCount, packetCount);
+
+  std::cout << _name << ", " << kQueryCount << " x " << kBoxCount
+            << " boxes: OrientedBox::Intersects " << boxMs
+            << " ms, OrientedBoxPacket::Intersects " << packetMs
+            << " ms (build " << buildMs << " ms), speed-up "
+            << boxMs / packetMs << ", " << packetCount << " overlaps"
+            << std::endl;
+}
+
+/////////////////////////////////////////////////
+TEST(OrientedBoxBenchmark, Scattered)
+{
+  // Most boxes are far apart, and separated by the first axes
+  Compare("Scattered", 20);
+}
+
+/////////////////////////////////////////////////
+TEST(OrientedBoxBenchmark, Candidates)
+{
+  // Boxes close to each other, as given by a broadphase
+  Compare("Candidates", 1.5);
+}
+
+/////////////////////////////////////////////////
+TEST(OrientedBoxBenchmark, PointCloud)
+{
+  // Crop boxes applied to a point cloud
+  math::Rand::Seed(1);
+  std::vector<math::Vector3d> cloud;
+  for (std::size_t i = 0; i < kPointCount; ++i)
+  {
+    cloud.push_back(math::Vector3d(math::Rand::DblUniform(-5, 5),
+          math::Rand::DblUniform(-5, 5), math::Rand::DblUniform(-5, 5)));
+  }
+  std::vector<math::OrientedBoxd> boxes;
+  for (int i = 0; i < kCropCount; ++i)
+    boxes.push_back(RandomBox(3));
+
+  std::size_t pointCount = 0;
+  const double pointMs = TimeMs([&]()
+  {
+    for (const auto &box : boxes)
+    {
+      for (const auto &point : cloud)
+      {
+        if (box.Contains(point))
+          ++pointCount;
+      }
+    }
+  });
+
+  math::Vector3Arrayd points;
+  const double buildMs = TimeMs([&]()
+  {
+    points.Assign(cloud);
+  });
+
+  std::size_t maskCount = 0;
+  std::vector<bool> inside;
+  const double maskMs = TimeMs([&]()
+  {
+    for (const auto &box : boxes)
+      maskCount += box.Contains(points, inside);
+  });
+  EXPECT_EQ(pointCount, maskCount);
+
+  std::size_t indexCount = 0;
+  std::vector<std::size_t> indices;
+  const double indexMs = TimeMs([&]()
+  {
+    for (const auto &box : boxes)
+      indexCount += box.Contains(points, indices);
+  });
+  EXPECT_EQ(pointCount, indexCount);
+
+  std::cout << "Point cloud, " << kCropCount << " x " << kPointCount
+            << " points: OrientedBox::Contains " << pointMs
+            << " ms, with a mask " << maskMs << " ms, with indices "
+            << indexMs << " ms (build " << buildMs << " ms), speed-up "
+            << pointMs / indexMs << ", " << indexCount << " points inside"
+            << std::endl;
+}
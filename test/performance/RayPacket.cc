@@ -0,0 +1,150 @@
+/*
+ * Copyright (C) 2018 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <iostream>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "ignition/math/BoxPacket.hh"
+#include "ignition/math/Rand.hh"
+#include "ignition/math/RayPacket.hh"
+#include "ignition/math/SimdDispatch.hh"
+
+#include "TimeMs.hh"
+
+using namespace ignition;
+
+/// \brief Number of rays, as in one sweep of a range sensor
+static const std::size_t kRayCount = 100000;
+
+/// \brief Number of boxes
+static const std::size_t kBoxCount = 64;
+
+/////////////////////////////////////////////////
+void Report(const std::string &_name, const double _scalarMs,
+    const double _packetMs)
+{
+  std::cout << _name << " (" << math::SimdDispatch::LevelName(
+      math::SimdDispatch::ActiveLevel()) << "): scalar " << _scalarMs
+            << " ms, packet " << _packetMs << " ms, speed-up "
+            << _scalarMs / _packetMs << std::endl;
+}
+
+/////////////////////////////////////////////////
+math::Vector3d RandomVector(const double _range)
+{
+  return math::Vector3d(math::Rand::DblUniform(-_range, _range),
+      math::Rand::DblUniform(-_range, _range),
+      math::Rand::DblUniform(-_range, _range));
+}
+
+/////////////////////////////////////////////////
+class RayPacketBenchmark : public ::testing::Test
+{
+  /// \brief Create a sweep of rays and random boxes.
+  protected: void SetUp() override
+  {
+    math::Rand::Seed(1);
+    for (std::size_t i = 0; i < kRayCount; ++i)
+      this->dirs.push_back(RandomVector(1));
+    for (std::size_t i = 0; i < kBoxCount; ++i)
+    {
+      const math::Vector3d min = RandomVector(20);
+      this->boxes.push_back(math::AxisAlignedBox(min,
+            min + math::Vector3d(1, 2, 3)));
+    }
+  }
+
+  /// \brief Origin of the rays
+  protected: math::Vector3d origin = math::Vector3d(0.5, 0.2, 1);
+
+  /// \brief Directions of the rays
+  protected: std::vector<math::Vector3d> dirs;
+
+  /// \brief The boxes
+  protected: std::vector<math::AxisAlignedBox> boxes;
+};
+
+/////////////////////////////////////////////////
+TEST_F(RayPacketBenchmark, RaysAgainstBox)
+{
+  std::size_t scalarCount = 0;
+  const double scalarMs = TimeMs([&]()
+  {
+    for (const auto &box : this->boxes)
+    {
+      for (const auto &dir : this->dirs)
+      {
+        bool hit;
+        double dist;
+        std::tie(hit, dist) = box.IntersectDist(this->origin, dir, 0, 100);
+        if (hit)
+          ++scalarCount;
+      }
+    }
+  });
+
+  std::size_t packetCount = 0;
+  std::vector<bool> hits;
+  std::vector<double> dists;
+  const double packetMs = TimeMs([&]()
+  {
+    const std::vector<math::Vector3d> origins(kRayCount, this->origin);
+    const math::RayPacket packet(origins, this->dirs, 0, 100);
+    for (const auto &box : this->boxes)
+      packetCount += packet.Intersect(box, hits, dists);
+  });
+  EXPECT_EQ(scalarCount, packetCount);
+
+  Report("Rays against one box", scalarMs, packetMs);
+}
+
+/////////////////////////////////////////////////
+TEST_F(RayPacketBenchmark, RayAgainstBoxes)
+{
+  std::size_t scalarCount = 0;
+  const double scalarMs = TimeMs([&]()
+  {
+    for (const auto &dir : this->dirs)
+    {
+      for (const auto &box : this->boxes)
+      {
+        bool hit;
+        double dist;
+        std::tie(hit, dist) = box.IntersectDist(this->origin, dir, 0, 100);
+        if (hit)
+          ++scalarCount;
+      }
+    }
+  });
+
+  std::size_t packetCount = 0;
+  std::vector<bool> hits;
+  std::vector<double> dists;
+  const double packetMs = TimeMs([&]()
+  {
+    const math::BoxPacket packet(this->boxes);
+    for (const auto &dir : this->dirs)
+      packetCount += packet.Intersect(this->origin, dir, 0, 100, hits, dists);
+  });
+  EXPECT_EQ(scalarCount, packetCount);
+
+  Report("One ray against boxes", scalarMs, packetMs);
+}
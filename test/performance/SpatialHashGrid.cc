@@ -0,0 +1,186 @@
+/*
+ * Copyright (C) 2018 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <iostream>
+#include <utility>
+#include <vector>
+
+#include "ignition/math/Rand.hh"
+#include "ignition/math/SpatialHashGrid.hh"
+
+#include "TimeMs.hh"
+
+using namespace ignition;
+
+/// \brief Number of particles
+static const std::size_t kPointCount = 200000;
+
+/// \brief Number of queries
+static const std::size_t kQueryCount = 2000;
+
+/// \brief Number of simulation steps of the update benchmark
+static const int kStepCount = 20;
+
+/////////////////////////////////////////////////
+/// \brief Particles with a density of about 8 per unit volume.
+class SpatialHashGridBenchmark : public ::testing::Test
+{
+  /// \brief Create random particles.
+  protected: void SetUp() override
+  {
+    math::Rand::Seed(1);
+    for (std::size_t i = 0; i < kPointCount; ++i)
+    {
+      this->points.push_back(math::Vector3d(math::Rand::DblUniform(0, 30),
+            math::Rand::DblUniform(0, 30), math::Rand::DblUniform(0, 30)));
+    }
+  }
+
+  /// \brief Positions of the particles
+  protected: std::vector<math::Vector3d> points;
+};
+
+/////////////////////////////////////////////////
+TEST_F(SpatialHashGridBenchmark, InRadius)
+{
+  const double radius = 1;
+  std::size_t bruteCount = 0;
+  const double bruteMs = TimeMs([&]()
+  {
+    for (std::size_t q = 0; q < kQueryCount; ++q)
+    {
+      for (const math::Vector3d &p : this->points)
+      {
+        if ((p - this->points[q]).SquaredLength() <= radius * radius)
+          ++bruteCount;
+      }
+    }
+  });
+
+  math::SpatialHashGrid grid(radius);
+  const double buildMs = TimeMs([&]()
+  {
+    grid.Build(this->points);
+  });
+
+  std::size_t gridCount = 0;
+  std::vector<std::size_t> indices;
+  const double gridMs = TimeMs([&]()
+  {
+    for (std::size_t q = 0; q < kQueryCount; ++q)
+    {
+      grid.InRadius(this->points[q], radius, indices);
+      gridCount += indices.size();
+    }
+  });
+  EXPECT_EQ(bruteCount, gridCount);
+
+  std::cout << "Radius, " << kQueryCount << " queries in " << kPointCount
+            << " points: brute force " << bruteMs << " ms, grid " << gridMs
+            << " ms (build " << buildMs << " ms), speed-up "
+            << bruteMs / gridMs << ", " << gridCount << " neighbors"
+            << std::endl;
+}
+
+/////////////////////////////////////////////////
+TEST_F(SpatialHashGridBenchmark, Nearest)
+{
+  const std::size_t k = 16;
+  std::vector<std::size_t> bruteLast;
+  std::vector<std::pair<double, std::size_t>> all(this->points.size());
+  const double bruteMs = TimeMs([&]()
+  {
+    for (std::size_t q = 0; q < kQueryCount; ++q)
+    {
+      for (std::size_t i = 0; i < this->points.size(); ++i)
+      {
+        all[i] = std::make_pair(
+            (this->points[i] - this->points[q]).SquaredLength(), i);
+      }
+      std::partial_sort(all.begin(), all.begin() + k, all.end());
+    }
+  });
+  for (std::size_t i = 0; i < k; ++i)
+    bruteLast.push_back(all[i].second);
+
+  const math::SpatialHashGrid grid(this->points, 1);
+  std::vector<std::size_t> indices;
+  const double gridMs = TimeMs([&]()
+  {
+    for (std::size_t q = 0; q < kQueryCount; ++q)
+      grid.Nearest(this->points[q], k, indices);
+  });
+  EXPECT_EQ(bruteLast, indices);
+
+  std::cout << "Nearest " << k << ", " << kQueryCount << " queries in "
+            << kPointCount << " points: brute force " << bruteMs
+            << " ms, grid " << gridMs << " ms, speed-up "
+            << bruteMs / gridMs << std::endl;
+}
+
+/////////////////////////////////////////////////
+TEST_F(SpatialHashGridBenchmark, Update)
+{
+  // Particles that move by a tenth of a cell at each step
+  std::vector<math::Vector3d> velocities;
+  for (std::size_t i = 0; i < kPointCount; ++i)
+  {
+    velocities.push_back(math::Vector3d(math::Rand::DblUniform(-0.1, 0.1),
+          math::Rand::DblUniform(-0.1, 0.1),
+          math::Rand::DblUniform(-0.1, 0.1)));
+  }
+
+  std::vector<math::Vector3d> moving = this->points;
+  math::SpatialHashGrid built(moving, 1);
+  const double buildMs = TimeMs([&]()
+  {
+    for (int s = 0; s < kStepCount; ++s)
+    {
+      for (std::size_t i = 0; i < kPointCount; ++i)
+        moving[i] += velocities[i];
+      built.Build(moving);
+    }
+  });
+
+  moving = this->points;
+  math::SpatialHashGrid updated(moving, 1);
+  std::size_t moved = 0;
+  const double updateMs = TimeMs([&]()
+  {
+    for (int s = 0; s < kStepCount; ++s)
+    {
+      for (std::size_t i = 0; i < kPointCount; ++i)
+        moving[i] += velocities[i];
+      moved += updated.Update(moving);
+    }
+  });
+
+  std::vector<std::size_t> a, b;
+  built.InRadius(moving[0], 1, a);
+  updated.InRadius(moving[0], 1, b);
+  std::sort(a.begin(), a.end());
+  std::sort(b.begin(), b.end());
+  EXPECT_EQ(a, b);
+
+  std::cout << "Update, " << kStepCount << " steps of " << kPointCount
+            << " points: Build " << buildMs << " ms, Update " << updateMs
+            << " ms, " << moved / kStepCount << " points change bucket at"
+            << " each step" << std::endl;
+}
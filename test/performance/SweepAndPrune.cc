@@ -0,0 +1,178 @@
+/*
+ * Copyright (C) 2018 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "ignition/math/DynamicBvh.hh"
+#include "ignition/math/Rand.hh"
+#include "ignition/math/SweepAndPrune.hh"
+
+#include "TimeMs.hh"
+
+using namespace ignition;
+
+/// \brief Number of parcels
+static const std::size_t kBodyCount = 10000;
+
+/// \brief Number of simulation steps
+static const int kSteps = 200;
+
+/// \brief Number of conveyor belts
+static const int kBelts = 50;
+
+/// \brief Length of the conveyor belts
+static const double kLength = 200;
+
+/// \brief Time step
+static const double kDt = 0.01;
+
+/// \brief A pair of ids
+typedef std::pair<std::size_t, std::size_t> IdPair;
+
+/////////////////////////////////////////////////
+/// \brief Parcels on parallel conveyor belts along x, all resting on the
+/// floor, so that every box overlaps most of the others along z.
+class SweepAndPruneBenchmark : public ::testing::Test
+{
+  /// \brief Create random parcels.
+  protected: void SetUp() override
+  {
+    math::Rand::Seed(1);
+    for (std::size_t i = 0; i < kBodyCount; ++i)
+    {
+      const int belt = static_cast<int>(i % kBelts);
+      const math::Vector3d min(math::Rand::DblUniform(0, kLength),
+          belt * 1.2 + math::Rand::DblUniform(0, 0.3), 0);
+      this->boxes.push_back(math::AxisAlignedBox(min,
+            min + math::Vector3d(math::Rand::DblUniform(0.3, 1),
+              math::Rand::DblUniform(0.3, 0.9),
+              math::Rand::DblUniform(0.2, 0.8))));
+      this->vel.push_back(math::Vector3d(
+            (belt % 2 ? 1 : -1) * math::Rand::DblUniform(0.8, 1.2),
+            math::Rand::DblUniform(-0.05, 0.05), 0));
+    }
+  }
+
+  /// \brief Move the parcels one step, wrapping around the end of the
+  /// belts.
+  protected: void Step()
+  {
+    for (std::size_t i = 0; i < kBodyCount; ++i)
+    {
+      math::Vector3d offset = this->vel[i] * kDt;
+      const double x = this->boxes[i].Min().X() + offset.X();
+      if (x < 0)
+        offset.X() += kLength;
+      else if (x > kLength)
+        offset.X() -= kLength;
+      this->boxes[i] = math::AxisAlignedBox(
+          this->boxes[i].Min() + offset, this->boxes[i].Max() + offset);
+    }
+  }
+
+  /// \brief Run the simulation with a sweep and prune.
+  /// \param[in] _name Name of the mode.
+  /// \param[in] _sap The sweep and prune.
+  /// \param[out] _pairs Overlapping pairs at the end of the simulation.
+  /// \return Average time of a step in milliseconds.
+  protected: double RunSap(const std::string &_name,
+      math::SweepAndPrune &_sap, std::vector<IdPair> &_pairs)
+  {
+    const std::vector<math::AxisAlignedBox> start = this->boxes;
+    std::vector<IdPair> added, removed;
+    const double buildMs = TimeMs([&]()
+    {
+      for (const auto &box : this->boxes)
+        _sap.Insert(box);
+      _sap.UpdatePairs(added, removed);
+    });
+
+    double stepMs = 0;
+    for (int s = 0; s < kSteps; ++s)
+    {
+      this->Step();
+      stepMs += TimeMs([&]()
+      {
+        for (std::size_t i = 0; i < kBodyCount; ++i)
+          _sap.Update(i, this->boxes[i]);
+        _sap.UpdatePairs(added, removed);
+      });
+    }
+    _sap.Pairs(_pairs);
+    this->boxes = start;
+
+    std::cout << _name << ": insert " << buildMs << " ms" << std::endl;
+    return stepMs / kSteps;
+  }
+
+  /// \brief Bounding boxes of the parcels
+  protected: std::vector<math::AxisAlignedBox> boxes;
+
+  /// \brief Velocity of each parcel
+  protected: std::vector<math::Vector3d> vel;
+};
+
+/////////////////////////////////////////////////
+TEST_F(SweepAndPruneBenchmark, Conveyor)
+{
+  std::vector<IdPair> singlePairs, multiPairs;
+  math::SweepAndPrune single;
+  const double singleMs = this->RunSap("single axis", single, singlePairs);
+  math::SweepAndPrune multi(true);
+  const double multiMs = this->RunSap("three axes", multi, multiPairs);
+  EXPECT_EQ(singlePairs, multiPairs);
+
+  math::DynamicBvh bvh(0.05);
+  std::vector<IdPair> added, removed;
+  for (const auto &box : this->boxes)
+    bvh.Insert(box);
+  bvh.UpdatePairs(added, removed);
+  double bvhMs = 0;
+  for (int s = 0; s < kSteps; ++s)
+  {
+    this->Step();
+    bvhMs += TimeMs([&]()
+    {
+      for (std::size_t i = 0; i < kBodyCount; ++i)
+        bvh.Update(i, this->boxes[i], this->vel[i] * kDt);
+      bvh.UpdatePairs(added, removed);
+    });
+  }
+  bvhMs /= kSteps;
+
+  // The pairs of fat boxes contain the pairs of boxes
+  std::vector<IdPair> pairs, tight;
+  bvh.Pairs(pairs);
+  for (const auto &p : pairs)
+  {
+    if (this->boxes[p.first].Intersects(this->boxes[p.second]))
+      tight.push_back(p);
+  }
+  EXPECT_EQ(singlePairs, tight);
+
+  std::cout << kBodyCount << " parcels, " << singlePairs.size()
+            << " overlapping pairs" << std::endl;
+  std::cout << "Step: dynamic bvh " << bvhMs << " ms, single axis "
+            << singleMs << " ms, three axes " << multiMs << " ms"
+            << std::endl;
+}
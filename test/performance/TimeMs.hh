@@ -0,0 +1,39 @@
+/*
+ * Copyright (C) 2018 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef IGNITION_MATH_TEST_PERFORMANCE_TIMEMS_HH_
+#define IGNITION_MATH_TEST_PERFORMANCE_TIMEMS_HH_
+
+#include <chrono>
+
+#include "ignition/math/Stopwatch.hh"
+
+/////////////////////////////////////////////////
+/// \brief Run a function and return the elapsed time in milliseconds.
+/// \param[in] _func Function to run.
+/// \return Elapsed time in milliseconds.
+template<typename Func>
+double TimeMs(Func _func)
+{
+  ignition::math::Stopwatch watch;
+  watch.Start();
+  _func();
+  watch.Stop();
+  return std::chrono::duration<double, std::milli>(
+      watch.ElapsedRunTime()).count();
+}
+
+#endif
@@ -0,0 +1,173 @@
+/*
+ * Copyright (C) 2018 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "ignition/math/Helpers.hh"
+#include "ignition/math/Rand.hh"
+#include "ignition/math/SimdDispatch.hh"
+#include "ignition/math/TriangleMesh.hh"
+
+#include "TimeMs.hh"
+
+using namespace ignition;
+
+/////////////////////////////////////////////////
+/// \brief Create a sphere of radius 1 centered at the origin.
+/// \param[in] _rings Number of rings, the sphere has about 4 _rings^2
+/// triangles.
+/// \param[out] _vertices Vertices of the sphere.
+/// \param[out] _indices Indices of the triangles.
+void Sphere(const unsigned int _rings, std::vector<math::Vector3d> &_vertices,
+    std::vector<unsigned int> &_indices)
+{
+  const unsigned int segments = 2 * _rings;
+  for (unsigned int r = 0; r <= _rings; ++r)
+  {
+    const double theta = IGN_PI * r / _rings;
+    for (unsigned int s = 0; s <= segments; ++s)
+    {
+      const double phi = 2 * IGN_PI * s / segments;
+      _vertices.push_back(math::Vector3d(std::sin(theta) * std::cos(phi),
+            std::sin(theta) * std::sin(phi), std::cos(theta)));
+    }
+  }
+  for (unsigned int r = 0; r < _rings; ++r)
+  {
+    for (unsigned int s = 0; s < segments; ++s)
+    {
+      const unsigned int i = r * (segments + 1) + s;
+      const unsigned int j = i + segments + 1;
+      _indices.insert(_indices.end(), {i, j, i + 1, i + 1, j, j + 1});
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+/// \brief Create rays from a sensor outside of the sphere, aimed at it.
+/// \param[in] _count Number of rays.
+/// \return The rays.
+math::RayPacket SensorRays(const std::size_t _count)
+{
+  math::Rand::Seed(1);
+  const math::Vector3d origin(0.2, -0.3, 3);
+  math::RayPacket rays;
+  rays.Reserve(_count);
+  for (std::size_t i = 0; i < _count; ++i)
+  {
+    const math::Vector3d target(math::Rand::DblUniform(-1.2, 1.2),
+        math::Rand::DblUniform(-1.2, 1.2), 0);
+    rays.PushBack(origin, target - origin, 0, 10);
+  }
+  return rays;
+}
+
+/////////////////////////////////////////////////
+TEST(TriangleMeshBenchmark, BruteForce)
+{
+  std::vector<math::Vector3d> vertices;
+  std::vector<unsigned int> indices;
+  Sphere(24, vertices, indices);
+  const math::TriangleMesh mesh(vertices, indices);
+  const math::RayPacket rays = SensorRays(2000);
+
+  // Closest hit over all the triangles with Triangle3::Intersects. It
+  // only finds the supporting plane, so only the count of hits of the
+  // mesh is checked.
+  std::size_t bruteCount = 0;
+  const double bruteMs = TimeMs([&]()
+  {
+    for (std::size_t r = 0; r < rays.Size(); ++r)
+    {
+      const math::Line3d line(rays.Start(r),
+          rays.Start(r) + rays.Direction(r) * rays.Length(r));
+      math::Vector3d point;
+      for (std::size_t t = 0; t < mesh.TriangleCount(); ++t)
+      {
+        if (mesh.Triangle(t).Intersects(line, point))
+          ++bruteCount;
+      }
+    }
+  });
+
+  std::vector<bool> hits;
+  std::vector<double> dists;
+  std::vector<std::size_t> triangles;
+  std::size_t meshCount = 0;
+  const double meshMs = TimeMs([&]()
+  {
+    meshCount = mesh.Intersect(rays, hits, dists, triangles);
+  });
+  EXPECT_GT(meshCount, 0u);
+  EXPECT_GT(bruteCount, 0u);
+
+  std::cout << mesh.TriangleCount() << " triangles, " << rays.Size()
+            << " rays: Triangle3 loop " << bruteMs << " ms, TriangleMesh "
+            << meshMs << " ms, speed-up " << bruteMs / meshMs << std::endl;
+}
+
+/////////////////////////////////////////////////
+TEST(TriangleMeshBenchmark, LargeMesh)
+{
+  std::vector<math::Vector3d> vertices;
+  std::vector<unsigned int> indices;
+  // About 1M triangles
+  Sphere(500, vertices, indices);
+
+  math::TriangleMesh mesh;
+  const double buildMs = TimeMs([&]()
+  {
+    mesh.Build(vertices, indices);
+  });
+
+  const math::RayPacket rays = SensorRays(1000000);
+  std::vector<bool> hits;
+  std::vector<double> dists;
+  std::vector<std::size_t> triangles;
+  std::size_t count = 0;
+  const double closestMs = TimeMs([&]()
+  {
+    count = mesh.Intersect(rays, hits, dists, triangles);
+  });
+  std::size_t occludedCount = 0;
+  const double occlusionMs = TimeMs([&]()
+  {
+    occludedCount = mesh.IntersectCheck(rays, hits);
+  });
+  EXPECT_EQ(count, occludedCount);
+  for (std::size_t i = 0; i < rays.Size(); ++i)
+  {
+    if (hits[i])
+    {
+      const math::Vector3d p = rays.Start(i) + rays.Direction(i) * dists[i];
+      EXPECT_NEAR(p.Length(), 1, 1e-3);
+    }
+  }
+
+  std::cout << mesh.TriangleCount() << " triangles ("
+            << math::SimdDispatch::LevelName(
+                math::SimdDispatch::ActiveLevel())
+            << "): build " << buildMs << " ms, " << rays.Size()
+            << " rays, closest hit " << closestMs << " ms, occlusion "
+            << occlusionMs << " ms, " << count << " hits" << std::endl;
+}